@@ -191,7 +191,7 @@ npn_manager::npn_classifier_t make_classifier()
  ******************************************************************************/
 
 xmg_minlib_manager::xmg_minlib_manager( const properties::ptr& settings )
-  : npn( 4096, make_classifier() )
+  : npn( 4096, make_classifier(), get( settings, "npn_cache", false ) ? shared_npn_cache( "exact5_lucky" ) : npn_cache::ptr() )
 {
   timeout = get( settings, "timeout", timeout );
   verbose = get( settings, "verbose", verbose );
@@ -199,6 +199,11 @@ xmg_minlib_manager::xmg_minlib_manager( const properties::ptr& settings )
 
 xmg_minlib_manager::~xmg_minlib_manager()
 {
+  if ( npn.cache() )
+  {
+    npn.cache()->persist();
+  }
+
   if ( auto_update )
   {
     update_out.close();
@@ -55,6 +55,7 @@ namespace cirkit
 class xmg_minlib_manager
 {
 public:
+  /* if the setting npn_cache is true, the shared NPN cache is used and persisted in $CIRKIT_HOME */
   xmg_minlib_manager( const properties::ptr& settings = properties::ptr() );
   ~xmg_minlib_manager();
 
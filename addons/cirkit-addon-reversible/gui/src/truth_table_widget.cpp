@@ -22,7 +22,6 @@
 
 #include <reversible/truth_table.hpp>
 #include <reversible/functions/circuit_to_truth_table.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 
 using namespace cirkit;
 
@@ -30,7 +29,7 @@ TruthTableWidget::TruthTableWidget( const circuit& circ, QWidget * parent )
   : QTableWidget( (1u << circ.lines() ), 2u * circ.lines(), parent )
 {
   binary_truth_table spec;
-  circuit_to_truth_table( circ, spec, simple_simulation_func() );
+  circuit_to_truth_table( circ, spec );
 
   QStringList hlabels, vlabels;
 
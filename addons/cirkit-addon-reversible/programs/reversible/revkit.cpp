@@ -64,6 +64,7 @@
 #include <cli/commands/perm.hpp>
 #include <cli/commands/pos.hpp>
 #include <cli/commands/print_io.hpp>
+#include <cli/commands/profile.hpp>
 #include <cli/commands/propagate.hpp>
 #include <cli/commands/qbs.hpp>
 #include <cli/commands/qec.hpp>
@@ -199,6 +200,7 @@ ALICE_BEGIN(revkit)
   ADD_COMMAND( gates );
   ADD_COMMAND( perm );
   ADD_COMMAND( print_io );
+  ADD_COMMAND( profile );
   ADD_COMMAND( random_circuit );
   ADD_COMMAND( spectral );
   ADD_COMMAND( tt );
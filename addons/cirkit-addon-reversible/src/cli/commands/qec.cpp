@@ -26,17 +26,13 @@
 
 #include "qec.hpp"
 
-#include <cmath>
 #include <iostream>
 
 #include <boost/program_options.hpp>
 
-#include <xtensor/xio.hpp>
-#include <xtensor/xmath.hpp>
-#include <xtensor-blas/xlinalg.hpp>
-
+#include <core/utils/program_options.hpp>
 #include <cli/reversible_stores.hpp>
-#include <reversible/utils/matrix_utils.hpp>
+#include <reversible/verification/quantum_equivalence_check.hpp>
 
 namespace cirkit
 {
@@ -50,6 +46,11 @@ qec_command::qec_command( const environment::ptr& env )
     ( "qid,q",     value( &qids )->composing(), "value of a quantum circuit" )
     ( "rid,r",     value( &rids )->composing(), "value of a reversible circuit" )
     ( "ancilla,a",                              "add ancilla (to the end) if necessary" )
+    ( "basis",     value_with_default( &basis ),   "check all basis states for circuits with up to this many lines, otherwise random states" )
+    ( "samples",   value_with_default( &samples ), "number of random states" )
+    ( "seed",      value_with_default( &seed ),    "random seed" )
+    ( "threads",   value_with_default( &threads ), "number of threads (0: number of cores)" )
+    ( "no_stabilizer",                          "do not use stabilizer tableaus for Clifford circuits" )
     ( "progress,p",                             "show progress" )
     ( "quiet",                                  "do not print result" )
     ;
@@ -82,59 +83,49 @@ bool qec_command::execute()
 {
   const auto& circuits = env->store<circuit>();
 
-  std::vector<std::pair<xt::xarray<complex_t>, unsigned>> matrices;
-
-  for ( auto id : qids )
-  {
-    matrices.push_back( {matrix_from_clifford_t_circuit( circuits[id], is_set( "progress" ) ), circuits[id].lines()} );
-  }
-  for ( auto id : rids )
-  {
-    matrices.push_back( {matrix_from_reversible_circuit( circuits[id] ), circuits[id].lines()} );
-  }
+  std::vector<unsigned> ids( qids );
+  ids.insert( ids.end(), rids.begin(), rids.end() );
+  qids.clear();
+  rids.clear();
 
-  assert( matrices.size() == 2u );
+  assert( ids.size() == 2u );
+  const auto& circ1 = circuits[ids[0u]];
+  const auto& circ2 = circuits[ids[1u]];
 
-  /* add ancillas if necessary */
-  if ( matrices[0u].second != matrices[1u].second )
+  /* the smaller circuit acts as identity on the additional lines */
+  if ( circ1.lines() != circ2.lines() && !is_set( "ancilla" ) )
   {
-    if ( is_set( "ancilla" ) )
-    {
-      const auto d0 = matrices[0u].second;
-      const auto d1 = matrices[1u].second;
-
-      if ( d0 < d1 )
-      {
-        /* make first matrix larger */
-        matrices[0u].first = xt::linalg::kron( identity( 1 << ( d1 - d0 ) ), matrices[0u].first );
-      }
-      else
-      {
-        /* make first matrix larger */
-        matrices[1u].first = xt::linalg::kron( identity( 1 << ( d0 - d1 ) ), matrices[1u].first );
-      }
-    }
-    else
-    {
-      std::cout << "[e] matrices have different dimensions, use ancilla option to adjust." << std::endl;
-      return true;
-    }
+    std::cout << "[e] circuits have different number of lines, use ancilla option to adjust." << std::endl;
+    return true;
   }
 
-  result = complex_allclose( matrices[0u].first, matrices[1u].first );
+  auto settings = make_settings();
+  settings->set( "max_basis_lines", basis );
+  settings->set( "samples", samples );
+  settings->set( "seed", seed );
+  settings->set( "num_threads", threads );
+  settings->set( "stabilizer", !is_set( "no_stabilizer" ) );
+  settings->set( "progress", is_set( "progress" ) );
+  result = quantum_equivalence_check( circ1, circ2, settings, statistics );
+
   if ( is_set( "quiet" ) ) return true;
 
   if ( result )
   {
-    std::cout << "[i] circuits are \033[1;32mequivalent\033[0m" << std::endl;
+    std::cout << "[i] circuits are \033[1;32mequivalent\033[0m";
+    if ( statistics->get<bool>( "up_to_global_phase" ) )
+    {
+      std::cout << " (up to global phase)";
+    }
+    std::cout << std::endl;
   }
   else
   {
     std::cout << "[i] circuits are \033[1;31mnot equivalent\033[0m" << std::endl;
   }
 
-  qids.clear();
-  rids.clear();
+  std::cout << "[i] method: " << statistics->get<std::string>( "method" ) << std::endl;
+  print_runtime();
 
   return true;
 }
@@ -142,7 +133,9 @@ bool qec_command::execute()
 command::log_opt_t qec_command::log() const
 {
   return log_map_t( {
-      {"result", result}
+      {"result", result},
+      {"method", statistics->get<std::string>( "method" )},
+      {"runtime", statistics->get<double>( "runtime" )}
     } );
 }
 
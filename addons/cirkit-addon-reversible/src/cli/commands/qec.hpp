@@ -58,6 +58,10 @@ public:
 private:
   bool result = false;
   std::vector<unsigned> rids, qids;
+  unsigned basis = 10u;
+  unsigned samples = 4u;
+  unsigned seed = 0u;
+  unsigned threads = 1u;
 };
 
 }
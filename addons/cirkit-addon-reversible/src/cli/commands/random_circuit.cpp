@@ -33,11 +33,10 @@
 
 #include <alice/rules.hpp>
 
-#include <core/utils/bitset_utils.hpp>
 #include <core/utils/program_options.hpp>
 #include <reversible/circuit.hpp>
 #include <reversible/gate.hpp>
-#include <reversible/target_tags.hpp>
+#include <reversible/functions/random_circuit.hpp>
 #include <cli/reversible_stores.hpp>
 
 using boost::program_options::value;
@@ -53,27 +52,6 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
-void create_random_gate( gate& g, unsigned lines, bool negative, std::default_random_engine& generator )
-{
-  std::uniform_int_distribution<unsigned> dist( 0u, lines - 1u );
-  std::uniform_int_distribution<unsigned> bdist( 0u, 1u );
-
-  auto controls = random_bitset( lines, generator );
-  auto target   = dist( generator );
-
-  g.set_type( toffoli_tag() );
-  g.add_target( target );
-  auto pos = controls.find_first();
-  while ( pos != controls.npos )
-  {
-    if ( pos != target )
-    {
-      g.add_control( make_var( pos, negative ? ( bdist( generator ) == 1u ) : true ) );
-    }
-    pos = controls.find_next( pos );
-  }
-}
-
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -117,11 +95,7 @@ bool random_circuit_command::execute()
   }
   else
   {
-    circuit circ( lines );
-    for ( auto i = 0u; i < gates; ++i )
-    {
-      create_random_gate( circ.append_gate(), lines, negative, generator );
-    }
+    const auto circ = random_circuit( lines, gates, negative, generator );
 
     if ( circuits.empty() || is_set( "new" ) )
     {
@@ -31,8 +31,9 @@
 
 #include <alice/rules.hpp>
 #include <cli/reversible_stores.hpp>
+#include <core/utils/bitset_utils.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
 #include <reversible/simulation/partial_simulation.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 
 using namespace boost::program_options;
 
@@ -45,6 +46,7 @@ revsim_command::revsim_command( const environment::ptr& env )
   opts.add_options()
     ( "partial,r",                    "use partial simulation" )
     ( "pattern,p", value( &pattern ), "simulation pattern" )
+    ( "all,a",                        "simulate all input patterns and print the truth table" )
     ;
   add_positional_option( "pattern" );
 }
@@ -66,7 +68,9 @@ command::rules_t revsim_command::validity_rules() const
         }
         return true;
       }, "pattern must consists of 0s and 1s" },
-    {[this]() { return pattern == "0*" ||
+    {[this]() { return !is_set( "all" ) || ( !is_set( "partial" ) && env->store<circuit>().current().lines() <= max_all_lines ); }, "all patterns only for non-partial simulation and up to 20 lines" },
+    {[this]() { return is_set( "all" ) ||
+                       pattern == "0*" ||
                        pattern == "1*" ||
                        ( is_set( "partial" ) || env->store<circuit>().current().lines() == pattern.size() ); }, "pattern bits must equal number of lines" }
   };
@@ -76,6 +80,23 @@ bool revsim_command::execute()
 {
   const auto& circuits = env->store<circuit>();
 
+  if ( is_set( "all" ) )
+  {
+    const auto& circ = circuits.current();
+
+    auto patterns = create_exhaustive_patterns( circ.lines() );
+    bitsliced_simulation( patterns, circ );
+
+    boost::dynamic_bitset<> input( circ.lines() );
+    for ( std::uint64_t p = 0u; p < ( 1ull << circ.lines() ); ++p )
+    {
+      std::cout << input << " -> " << bitsliced_pattern( patterns, p ) << std::endl;
+      inc( input );
+    }
+
+    return true;
+  }
+
   /* prepare pattern */
   if ( pattern == "0*" || pattern == "1*" )
   {
@@ -91,7 +112,7 @@ bool revsim_command::execute()
   }
   else
   {
-    simple_simulation( output, circuits.current(), input );
+    bitsliced_simulation( output, circuits.current(), input );
   }
 
   std::cout << "[i] result: " << output << std::endl;
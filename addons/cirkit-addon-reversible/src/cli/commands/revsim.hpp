@@ -53,6 +53,8 @@ protected:
   bool execute();
 
 private:
+  static constexpr unsigned max_all_lines = 20u;
+
   std::string pattern;
 };
 
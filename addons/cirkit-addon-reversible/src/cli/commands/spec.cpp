@@ -37,7 +37,6 @@
 #include <cli/reversible_stores.hpp>
 #include <reversible/functions/circuit_to_truth_table.hpp>
 #include <reversible/functions/permutation_to_truth_table.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 
 using namespace boost::program_options;
 
@@ -90,7 +89,7 @@ bool spec_command::execute()
     const auto& circ = circuits.current();
 
     binary_truth_table spec;
-    circuit_to_truth_table( circ, spec, simple_simulation_func() );
+    circuit_to_truth_table( circ, spec );
 
     specs.current() = spec;
   }
@@ -37,6 +37,7 @@
 #include <cli/reversible_stores.hpp>
 #include <reversible/synthesis/symbolic_transformation_based_synthesis.hpp>
 #include <reversible/synthesis/transformation_based_synthesis.hpp>
+#include <reversible/utils/permutation.hpp>
 
 namespace cirkit
 {
@@ -59,9 +60,10 @@ tbs_command::tbs_command( const environment::ptr& env )
   add_new_option();
   be_verbose();
 
-  boost::program_options::options_description tt_opts( "Explicit truth table based" );
+  boost::program_options::options_description tt_opts( "Explicit truth table based (works on truth tables and circuits (-c))" );
   tt_opts.add_options()
     ( "bidirectional",    value_with_default( &bidirectional ), "bidirectional synthesis" )
+    ( "multidirectional,m",                                     "multidirectional synthesis (not with `fredkin')" )
     ( "fredkin,f",                                              "use Fredkin gates" )
     ( "fredkin_lookback",                                       "optimized Fredkin gate insertation (only with `fredkin' enabled)" )
     ;
@@ -93,7 +95,9 @@ command::rules_t tbs_command::validity_rules() const
   return {
     { [&]() { return !this->is_set( "bdd" ) || env->store<rcbdd>().current_index() >= 0; }, "symbolid BDD method requires RCBDD in store" },
     { [&]() { return !this->is_set( "sat" ) || env->store<rcbdd>().current_index() >= 0 || env->store<circuit>().current_index() >= 0 || env->store<aig_graph>().current_index() >= 0; }, "symbolid SAT method requires RCBDDor circuit in store" },
-    { [&]() { return this->is_set( "bdd" ) || this->is_set( "sat" ) || env->store<binary_truth_table>().current_index() >= 0; }, "no truth table in store" },
+    { [&]() { return this->is_set( "bdd" ) || this->is_set( "sat" ) || this->is_set( "circuit" ) || env->store<binary_truth_table>().current_index() >= 0; }, "no truth table in store" },
+    { [&]() { return !this->is_set( "circuit" ) || env->store<circuit>().current_index() >= 0; }, "no circuit in store" },
+    { [&]() { return !this->is_set( "circuit" ) || this->is_set( "sat" ) || !this->is_set( "fredkin" ); }, "option fredkin requires a truth table" },
     { [&]() { return static_cast<int>( this->is_set( "bdd" ) ) + static_cast<int>( this->is_set( "sat" ) ) <= 1; }, "options bdd and sat cannot be set at the same time" }
   };
 }
@@ -146,7 +150,15 @@ bool tbs_command::execute()
     settings->set( "bidirectional",    bidirectional );
     settings->set( "fredkin",          is_set( "fredkin" ) );
     settings->set( "fredkin_lookback", is_set( "fredkin_lookback" ) );
-    transformation_based_synthesis( circ, specs.current(), settings, statistics );
+    settings->set( "multidirectional", is_set( "multidirectional" ) );
+    if ( is_set( "circuit" ) )
+    {
+      transformation_based_synthesis( circ, circuit_to_permutation( circuits.current() ), settings, statistics );
+    }
+    else
+    {
+      transformation_based_synthesis( circ, specs.current(), settings, statistics );
+    }
   }
 
   extend_if_new( circuits );
@@ -168,6 +180,7 @@ command::log_opt_t tbs_command::log() const
       {"runtime", statistics->get<double>( "runtime" )},
       {"bdd", is_set( "bdd" )},
       {"sat", is_set( "sat" )},
+      {"multidirectional", is_set( "multidirectional" )},
       {"aig_from_cnf", is_set( "aig_from_cnf" )},
       {"optimize_aig", is_set( "optimize_aig" )},
       {"sorting_network", is_set( "sorting_network" )}
@@ -32,13 +32,17 @@
 #include <cli/reversible_stores.hpp>
 #include <reversible/io/read_qc.hpp>
 #include <reversible/io/write_qc.hpp>
+#include <reversible/optimization/tpar_optimization.hpp>
 
 namespace cirkit
 {
 
 tpar_command::tpar_command( const environment::ptr& env )
-  : cirkit_command( env, "Runs Matthew Amy's T-par algorithm", "Polynomial-time T-depth Optimization of Clifford+T circuits via Matroid Partitioning (arXiv:1303.2042)\ninstall with ./utils/tools.py install tpar" )
+  : cirkit_command( env, "Runs Matthew Amy's T-par algorithm", "Polynomial-time T-depth Optimization of Clifford+T circuits via Matroid Partitioning (arXiv:1303.2042)\nthe external implementation can be installed with ./utils/tools.py install tpar" )
 {
+  opts.add_options()
+    ( "external,e", "call external t-par binary instead of native implementation" )
+    ;
   add_new_option();
 }
 
@@ -51,12 +55,22 @@ bool tpar_command::execute()
 {
   auto& circuits = env->store<circuit>();
 
-  temporary_filename filename_in( "/tmp/tpar-%d-in.qc" );
-  temporary_filename filename_out( "/tmp/tpar-%d-out.qc" );
+  circuit circ;
 
-  write_qc( circuits.current(), filename_in.name(), true );
-  execute_and_omit( boost::str( boost::format( "t-par < %s > %s" ) % filename_in.name() % filename_out.name() ) );
-  const auto circ = read_qc( filename_out.name() );
+  if ( is_set( "external" ) )
+  {
+    temporary_filename filename_in( "/tmp/tpar-%d-in.qc" );
+    temporary_filename filename_out( "/tmp/tpar-%d-out.qc" );
+
+    write_qc( circuits.current(), filename_in.name(), true );
+    execute_and_omit( boost::str( boost::format( "t-par < %s > %s" ) % filename_in.name() % filename_out.name() ) );
+    circ = read_qc( filename_out.name() );
+  }
+  else
+  {
+    circ = tpar_optimization( circuits.current(), make_settings(), statistics );
+    print_runtime();
+  }
 
   extend_if_new( circuits );
   circuits.current() = circ;
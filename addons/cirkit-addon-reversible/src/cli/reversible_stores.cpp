@@ -32,6 +32,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 
+#include <core/utils/binary_io.hpp>
 #include <core/utils/string_utils.hpp>
 #include <core/utils/system_utils.hpp>
 #include <core/utils/temporary_filename.hpp>
@@ -47,6 +48,7 @@
 #include <reversible/io/read_qc.hpp>
 #include <reversible/io/read_realization.hpp>
 #include <reversible/io/read_specification.hpp>
+#include <reversible/io/snapshot.hpp>
 #include <reversible/io/write_liquid.hpp>
 #include <reversible/io/write_numpy.hpp>
 #include <reversible/io/write_pla.hpp>
@@ -58,7 +60,6 @@
 #include <reversible/io/write_quipper.hpp>
 #include <reversible/io/write_realization.hpp>
 #include <reversible/io/write_specification.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 #include <reversible/utils/circuit_utils.hpp>
 #include <reversible/utils/costs.hpp>
 
@@ -131,6 +132,20 @@ aig_graph store_convert<circuit, aig_graph>( const circuit& circ )
   return circuit_to_aig( circ );
 }
 
+template<>
+void store_save_session<circuit>( std::ostream& os, const circuit& circ )
+{
+  binary_writer writer( os );
+  write_snapshot( writer, circ );
+}
+
+template<>
+void store_load_session<circuit>( const char* data, std::size_t size, circuit& circ )
+{
+  binary_reader reader( data, size );
+  read_snapshot( reader, circ );
+}
+
 template<>
 binary_truth_table store_convert<expression_t::ptr, binary_truth_table>( const expression_t::ptr& expr )
 {
@@ -407,7 +422,7 @@ template<>
 binary_truth_table store_convert<circuit, binary_truth_table>( const circuit& circ )
 {
   binary_truth_table spec;
-  circuit_to_truth_table( circ, spec, simple_simulation_func() );
+  circuit_to_truth_table( circ, spec );
   return spec;
 }
 
@@ -105,6 +105,15 @@ inline bool store_can_convert<circuit, aig_graph>() { return true; }
 template<>
 aig_graph store_convert<circuit, aig_graph>( const circuit& circ );
 
+template<>
+inline bool store_can_save_session<circuit>() { return true; }
+
+template<>
+void store_save_session<circuit>( std::ostream& os, const circuit& circ );
+
+template<>
+void store_load_session<circuit>( const char* data, std::size_t size, circuit& circ );
+
 template<>
 bool store_can_write_io_type<circuit, io_qpic_tag_t>( command& cmd );
 
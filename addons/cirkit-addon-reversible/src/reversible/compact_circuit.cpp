@@ -0,0 +1,214 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "compact_circuit.hpp"
+
+#include <boost/format.hpp>
+
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace detail
+{
+
+/* tags of the kinds that are not kept in the side table */
+static const boost::any toffoli_type = toffoli_tag();
+static const boost::any fredkin_type = fredkin_tag();
+static const boost::any peres_type   = peres_tag();
+
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+const boost::any& compact_gate::type() const
+{
+  switch ( kind() )
+  {
+  case gate_kind::toffoli: return detail::toffoli_type;
+  case gate_kind::fredkin: return detail::fredkin_type;
+  case gate_kind::peres:   return detail::peres_type;
+  default:                 return circ->tags.at( _index );
+  }
+}
+
+compact_circuit::compact_circuit( unsigned lines )
+  : _lines( 0u )
+{
+  set_lines( lines );
+}
+
+void compact_circuit::set_lines( unsigned lines )
+{
+  _inputs.resize( lines );
+  _outputs.resize( lines );
+  for ( auto i = _lines; i < lines; ++i )
+  {
+    _inputs[i] = boost::str( boost::format( "i%d" ) % i );
+    _outputs[i] = boost::str( boost::format( "o%d" ) % i );
+  }
+  _constants.resize( lines, constant() );
+  _garbage.resize( lines, false );
+  _lines = lines;
+}
+
+void compact_circuit::append_gate( const gate& g )
+{
+  append_gate( get_gate_kind( g ), g.controls(), g.targets(), g.type() );
+}
+
+void compact_circuit::append_toffoli( const gate::control_container& controls, unsigned target )
+{
+  append_gate( gate_kind::toffoli, controls, std::vector<unsigned>{target} );
+}
+
+void compact_circuit::reserve( unsigned num_gates, unsigned num_controls, unsigned num_targets )
+{
+  kinds.reserve( num_gates );
+  control_begin.reserve( num_gates + 1u );
+  target_begin.reserve( num_gates + 1u );
+  control_arena.reserve( num_controls );
+  target_arena.reserve( num_targets );
+}
+
+void compact_circuit::set_inputs( const std::vector<std::string>& inputs )
+{
+  _inputs = inputs;
+  _inputs.resize( _lines, "i" );
+}
+
+void compact_circuit::set_outputs( const std::vector<std::string>& outputs )
+{
+  _outputs = outputs;
+  _outputs.resize( _lines, "o" );
+}
+
+void compact_circuit::set_constants( const std::vector<constant>& constants )
+{
+  _constants = constants;
+  _constants.resize( _lines, constant() );
+}
+
+void compact_circuit::set_garbage( const std::vector<bool>& garbage )
+{
+  _garbage = garbage;
+  _garbage.resize( _lines, false );
+}
+
+void compact_circuit::add_module( const std::string& name, const std::shared_ptr<circuit>& module )
+{
+  _modules[name] = module;
+}
+
+std::size_t compact_circuit::memory() const
+{
+  return kinds.capacity() * sizeof( gate_kind ) +
+         ( control_begin.capacity() + target_begin.capacity() ) * sizeof( std::uint32_t ) +
+         control_arena.capacity() * sizeof( variable ) +
+         target_arena.capacity() * sizeof( unsigned );
+}
+
+gate_kind get_gate_kind( const gate& g )
+{
+  if ( is_toffoli( g ) )      { return gate_kind::toffoli; }
+  else if ( is_fredkin( g ) ) { return gate_kind::fredkin; }
+  else if ( is_peres( g ) )   { return gate_kind::peres; }
+  else if ( is_module( g ) )  { return gate_kind::module; }
+  else if ( is_stg( g ) )     { return gate_kind::stg; }
+  else                        { return gate_kind::other; }
+}
+
+compact_circuit circuit_to_compact_circuit( const circuit& circ )
+{
+  compact_circuit compact( circ.lines() );
+
+  auto num_controls = 0u, num_targets = 0u;
+  for ( const auto& g : circ )
+  {
+    num_controls += g.controls().size();
+    num_targets += g.targets().size();
+  }
+  compact.reserve( circ.num_gates(), num_controls, num_targets );
+
+  for ( const auto& g : circ )
+  {
+    compact.append_gate( g );
+  }
+
+  compact.set_inputs( circ.inputs() );
+  compact.set_outputs( circ.outputs() );
+  compact.set_constants( circ.constants() );
+  compact.set_garbage( circ.garbage() );
+  for ( const auto& m : circ.modules() )
+  {
+    compact.add_module( m.first, m.second );
+  }
+
+  return compact;
+}
+
+circuit compact_circuit_to_circuit( const compact_circuit& compact )
+{
+  circuit circ( compact.lines() );
+
+  for ( const auto& g : compact )
+  {
+    auto& new_g = circ.append_gate();
+    new_g.controls().assign( g.controls().begin(), g.controls().end() );
+    new_g.targets().assign( g.targets().begin(), g.targets().end() );
+    new_g.set_type( g.type() );
+  }
+
+  circ.set_inputs( compact.inputs() );
+  circ.set_outputs( compact.outputs() );
+  circ.set_constants( compact.constants() );
+  circ.set_garbage( compact.garbage() );
+  for ( const auto& m : compact.modules() )
+  {
+    circ.add_module( m.first, m.second );
+  }
+
+  return circ;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
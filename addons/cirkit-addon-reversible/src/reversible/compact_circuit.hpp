@@ -0,0 +1,234 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file compact_circuit.hpp
+ *
+ * @brief Flat structure-of-arrays storage for reversible circuits
+ *
+ * Gates are stored in parallel arrays: a one byte gate kind and offsets
+ * into two arenas which hold the control variables and target lines of
+ * all gates back to back.  Toffoli, Fredkin, and Peres gates need no
+ * further data, all other target tags (modules, single-target gates,
+ * ...) are kept in a side table indexed by gate.  Appending a gate does
+ * not allocate besides the amortized growth of the arrays.
+ *
+ * compact_gate is a view on one gate with the same read interface as
+ * gate, such that algorithms templated on the gate type run over both
+ * representations without creating gate objects.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef COMPACT_CIRCUIT_HPP
+#define COMPACT_CIRCUIT_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/any.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/gate.hpp>
+#include <reversible/variable.hpp>
+
+namespace cirkit
+{
+
+enum class gate_kind : std::uint8_t { toffoli, fredkin, peres, module, stg, other };
+
+class compact_circuit;
+
+/**
+ * @brief Read-only view on a gate of a compact_circuit
+ */
+class compact_gate
+{
+public:
+  using control_range = boost::iterator_range<const variable*>;
+  using target_range  = boost::iterator_range<const unsigned*>;
+
+  compact_gate( const compact_circuit& circ, unsigned index ) : circ( &circ ), _index( index ) {}
+
+  inline unsigned index() const { return _index; }
+
+  gate_kind kind() const;
+  control_range controls() const;
+  target_range targets() const;
+  unsigned size() const;
+
+  /* target tag, as gate::type() */
+  const boost::any& type() const;
+
+private:
+  const compact_circuit* circ;
+  unsigned               _index;
+};
+
+class compact_circuit
+{
+private:
+  struct gate_at
+  {
+    const compact_circuit* circ;
+    compact_gate operator()( unsigned index ) const { return compact_gate( *circ, index ); }
+  };
+
+public:
+  using const_iterator = boost::transform_iterator<gate_at, boost::counting_iterator<unsigned>, compact_gate, compact_gate>;
+
+  explicit compact_circuit( unsigned lines = 0u );
+
+  /* lines */
+  inline unsigned lines() const { return _lines; }
+  void set_lines( unsigned lines );
+
+  /* gates */
+  inline unsigned num_gates() const { return kinds.size(); }
+  inline compact_gate operator[]( unsigned index ) const { return compact_gate( *this, index ); }
+
+  inline const_iterator begin() const { return const_iterator( boost::counting_iterator<unsigned>( 0u ), gate_at{this} ); }
+  inline const_iterator end() const   { return const_iterator( boost::counting_iterator<unsigned>( num_gates() ), gate_at{this} ); }
+
+  /**
+   * @brief Appends a gate
+   *
+   * `type' is only stored for kinds other than Toffoli, Fredkin, and
+   * Peres, for those it must hold the target tag.
+   */
+  template<typename Controls, typename Targets>
+  void append_gate( gate_kind kind, const Controls& controls, const Targets& targets, const boost::any& type = boost::any() )
+  {
+    kinds.push_back( kind );
+    control_arena.insert( control_arena.end(), std::begin( controls ), std::end( controls ) );
+    target_arena.insert( target_arena.end(), std::begin( targets ), std::end( targets ) );
+    control_begin.push_back( control_arena.size() );
+    target_begin.push_back( target_arena.size() );
+
+    if ( kind == gate_kind::module || kind == gate_kind::stg || kind == gate_kind::other )
+    {
+      assert( !type.empty() );
+      tags[kinds.size() - 1u] = type;
+    }
+  }
+
+  void append_gate( const gate& g );
+  void append_toffoli( const gate::control_container& controls, unsigned target );
+
+  /* reserves space for gates, the sum of their controls, and the sum of their targets */
+  void reserve( unsigned num_gates, unsigned num_controls, unsigned num_targets );
+
+  /* meta data */
+  inline const std::vector<std::string>& inputs() const  { return _inputs; }
+  inline const std::vector<std::string>& outputs() const { return _outputs; }
+  inline const std::vector<constant>& constants() const  { return _constants; }
+  inline const std::vector<bool>& garbage() const        { return _garbage; }
+  inline const std::map<std::string, std::shared_ptr<circuit>>& modules() const { return _modules; }
+
+  void set_inputs( const std::vector<std::string>& inputs );
+  void set_outputs( const std::vector<std::string>& outputs );
+  void set_constants( const std::vector<constant>& constants );
+  void set_garbage( const std::vector<bool>& garbage );
+  void add_module( const std::string& name, const std::shared_ptr<circuit>& module );
+
+  /* bytes used by the gate arrays, without meta data and tags */
+  std::size_t memory() const;
+
+private:
+  friend class compact_gate;
+
+  unsigned                                       _lines;
+
+  std::vector<gate_kind>                         kinds;
+  std::vector<std::uint32_t>                     control_begin = {0u}; /* controls of gate i are [control_begin[i], control_begin[i + 1]) */
+  std::vector<std::uint32_t>                     target_begin = {0u};
+  std::vector<variable>                          control_arena;
+  std::vector<unsigned>                          target_arena;
+  std::unordered_map<unsigned, boost::any>       tags;
+
+  std::vector<std::string>                       _inputs;
+  std::vector<std::string>                       _outputs;
+  std::vector<constant>                          _constants;
+  std::vector<bool>                              _garbage;
+  std::map<std::string, std::shared_ptr<circuit>> _modules;
+};
+
+/******************************************************************************
+ * compact_gate                                                               *
+ ******************************************************************************/
+
+inline gate_kind compact_gate::kind() const
+{
+  return circ->kinds[_index];
+}
+
+inline compact_gate::control_range compact_gate::controls() const
+{
+  const auto* base = circ->control_arena.data();
+  return control_range( base + circ->control_begin[_index], base + circ->control_begin[_index + 1u] );
+}
+
+inline compact_gate::target_range compact_gate::targets() const
+{
+  const auto* base = circ->target_arena.data();
+  return target_range( base + circ->target_begin[_index], base + circ->target_begin[_index + 1u] );
+}
+
+inline unsigned compact_gate::size() const
+{
+  return ( circ->control_begin[_index + 1u] - circ->control_begin[_index] ) + ( circ->target_begin[_index + 1u] - circ->target_begin[_index] );
+}
+
+/* gate type predicates, as the ones in target_tags.hpp */
+inline bool is_toffoli( const compact_gate& g ) { return g.kind() == gate_kind::toffoli; }
+inline bool is_fredkin( const compact_gate& g ) { return g.kind() == gate_kind::fredkin; }
+inline bool is_peres( const compact_gate& g )   { return g.kind() == gate_kind::peres; }
+inline bool is_module( const compact_gate& g )  { return g.kind() == gate_kind::module; }
+inline bool is_stg( const compact_gate& g )     { return g.kind() == gate_kind::stg; }
+
+gate_kind get_gate_kind( const gate& g );
+
+compact_circuit circuit_to_compact_circuit( const circuit& circ );
+circuit compact_circuit_to_circuit( const compact_circuit& circ );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
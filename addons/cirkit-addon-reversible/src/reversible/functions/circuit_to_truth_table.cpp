@@ -30,6 +30,7 @@
 
 #include <core/properties.hpp>
 #include <core/utils/bitset_utils.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
 
 namespace cirkit
 {
@@ -77,6 +78,31 @@ namespace cirkit
     return true;
   }
 
+  bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec )
+  {
+    auto patterns = create_exhaustive_patterns( circ.lines() );
+    bitsliced_simulator( circ ).simulate( patterns );
+
+    binary_truth_table::cube_type in_cube( circ.lines() ), out_cube( circ.lines() );
+    for ( std::uint64_t p = 0u; p < ( 1ull << circ.lines() ); ++p )
+    {
+      for ( auto i = 0u; i < circ.lines(); ++i )
+      {
+        in_cube[i]  = ( p >> i ) & 1u;
+        out_cube[i] = ( patterns[i][p >> 6u] >> ( p & 63u ) ) & 1u;
+      }
+      spec.add_entry( in_cube, out_cube );
+    }
+
+    // metadata
+    spec.set_inputs( circ.inputs() );
+    spec.set_outputs( circ.outputs() );
+    spec.set_constants( circ.constants() );
+    spec.set_garbage( circ.garbage() );
+
+    return true;
+  }
+
 }
 
 // Local Variables:
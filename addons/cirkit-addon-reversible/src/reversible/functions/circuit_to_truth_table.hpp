@@ -62,6 +62,23 @@ namespace cirkit
    */
   bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec, const functor<bool(boost::dynamic_bitset<>&, const circuit&, const boost::dynamic_bitset<>&)>& simulation );
 
+  /**
+   * @brief Generates a truth table from a circuit using bit-sliced simulation
+   *
+   * All 2^n input patterns are simulated at once with
+   * \ref cirkit::bitsliced_simulation "bitsliced_simulation".
+   * The entries are the same as for the simulation based version
+   * with a non-partial simulation function.
+   *
+   * @param circ Circuit to be simulated
+   * @param spec Empty truth table to be constructed
+   *
+   * @return true on success, false otherwise
+   *
+   * @since  2.4
+   */
+  bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec );
+
 }
 
 #endif /* CIRCUIT_TO_TRUTH_TABLE_HPP */
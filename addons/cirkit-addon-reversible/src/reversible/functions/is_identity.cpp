@@ -30,11 +30,49 @@
 #include <boost/range/numeric.hpp>
 
 #include <reversible/rcbdd.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
 
 namespace cirkit
 {
 
-bool is_identity( const circuit& circ )
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* up to this many lines all patterns are simulated, otherwise BDDs are used */
+constexpr unsigned simulation_max_lines = 24u;
+
+/* words simulated at once, chunks are compared before the next one is created */
+constexpr std::uint64_t simulation_chunk_words = 1ull << 14u;
+
+bool is_identity_simulation( const circuit& circ )
+{
+  const bitsliced_simulator sim( circ );
+  const std::uint64_t num_words = circ.lines() <= 6u ? 1ull : ( 1ull << ( circ.lines() - 6u ) );
+  const auto mask = circ.lines() < 6u ? ( ( 1ull << ( 1u << circ.lines() ) ) - 1ull ) : ~0ull;
+
+  for ( std::uint64_t first = 0u; first < num_words; first += simulation_chunk_words )
+  {
+    const auto inputs = create_exhaustive_patterns( circ.lines(), first, simulation_chunk_words );
+    auto outputs = inputs;
+    sim.simulate( outputs );
+
+    for ( auto i = 0u; i < circ.lines(); ++i )
+    {
+      for ( auto w = 0u; w < inputs[i].size(); ++w )
+      {
+        if ( ( inputs[i][w] ^ outputs[i][w] ) & mask )
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+bool is_identity_bdd( const circuit& circ )
 {
   rcbdd mgr;
   mgr.initialize_manager();
@@ -51,6 +89,15 @@ bool is_identity( const circuit& circ )
   return f == identity;
 }
 
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bool is_identity( const circuit& circ )
+{
+  return circ.lines() <= simulation_max_lines ? is_identity_simulation( circ ) : is_identity_bdd( circ );
+}
+
 }
 
 // Local Variables:
@@ -41,6 +41,12 @@
 namespace cirkit
 {
 
+/**
+ * @brief Checks whether a circuit represents the identity
+ *
+ * Circuits with up to 24 lines are checked by bit-sliced simulation
+ * of all input patterns, larger ones using BDDs.
+ */
 bool is_identity( const circuit& circ );
 
 }
@@ -0,0 +1,84 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "random_circuit.hpp"
+
+#include <core/utils/bitset_utils.hpp>
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void create_random_gate( gate& g, unsigned lines, bool negative, std::default_random_engine& generator )
+{
+  std::uniform_int_distribution<unsigned> dist( 0u, lines - 1u );
+  std::uniform_int_distribution<unsigned> bdist( 0u, 1u );
+
+  auto controls = random_bitset( lines, generator );
+  auto target   = dist( generator );
+
+  g.set_type( toffoli_tag() );
+  g.add_target( target );
+  auto pos = controls.find_first();
+  while ( pos != controls.npos )
+  {
+    if ( pos != target )
+    {
+      g.add_control( make_var( pos, negative ? ( bdist( generator ) == 1u ) : true ) );
+    }
+    pos = controls.find_next( pos );
+  }
+}
+
+circuit random_circuit( unsigned lines, unsigned gates, bool negative, std::default_random_engine& generator )
+{
+  circuit circ( lines );
+  for ( auto i = 0u; i < gates; ++i )
+  {
+    create_random_gate( circ.append_gate(), lines, negative, generator );
+  }
+  return circ;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
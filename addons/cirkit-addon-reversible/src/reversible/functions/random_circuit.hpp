@@ -0,0 +1,68 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file random_circuit.hpp
+ *
+ * @brief Random reversible circuits
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef REVERSIBLE_RANDOM_CIRCUIT_HPP
+#define REVERSIBLE_RANDOM_CIRCUIT_HPP
+
+#include <random>
+
+#include <reversible/circuit.hpp>
+#include <reversible/gate.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @brief Turns g into a random Toffoli gate
+ *
+ * Each line is a control with probability 1/2.  If negative is true,
+ * each control has a random polarity.
+ */
+void create_random_gate( gate& g, unsigned lines, bool negative, std::default_random_engine& generator );
+
+/**
+ * @brief Creates a random circuit of Toffoli gates
+ */
+circuit random_circuit( unsigned lines, unsigned gates, bool negative, std::default_random_engine& generator );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
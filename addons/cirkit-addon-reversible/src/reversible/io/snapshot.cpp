@@ -0,0 +1,283 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "snapshot.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+#include <reversible/gate.hpp>
+#include <reversible/pauli_tags.hpp>
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+enum class snapshot_gate_type : std::uint8_t { toffoli, fredkin, peres, pauli, hadamard, stg };
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+void write_buses( binary_writer& writer, const bus_collection& buses )
+{
+  writer.write<std::uint32_t>( buses.buses().size() );
+  for ( const auto& p : buses.buses() )
+  {
+    writer.write_string( p.first );
+    writer.write_vector( p.second );
+
+    const auto init = buses.initial_value( p.first );
+    writer.write<std::uint8_t>( init ? 1u : 0u );
+    writer.write<std::uint32_t>( init ? *init : 0u );
+  }
+}
+
+void read_buses( binary_reader& reader, bus_collection& buses )
+{
+  const auto count = reader.read<std::uint32_t>();
+  for ( auto i = 0u; i < count; ++i )
+  {
+    const auto name = reader.read_string();
+    const auto lines = reader.read_vector<unsigned>();
+    const auto has_init = reader.read<std::uint8_t>();
+    const auto init = reader.read<std::uint32_t>();
+
+    buses.add( name, lines, has_init ? boost::optional<unsigned>( init ) : boost::none );
+  }
+}
+
+void write_gate( binary_writer& writer, const gate& g )
+{
+  if ( is_toffoli( g ) )
+  {
+    writer.write( snapshot_gate_type::toffoli );
+  }
+  else if ( is_fredkin( g ) )
+  {
+    writer.write( snapshot_gate_type::fredkin );
+  }
+  else if ( is_peres( g ) )
+  {
+    writer.write( snapshot_gate_type::peres );
+  }
+  else if ( is_pauli( g ) )
+  {
+    const auto& tag = boost::any_cast<pauli_tag>( g.type() );
+    writer.write( snapshot_gate_type::pauli );
+    writer.write<std::uint8_t>( static_cast<std::uint8_t>( tag.axis ) );
+    writer.write<std::uint32_t>( tag.root );
+    writer.write<std::uint8_t>( tag.adjoint ? 1u : 0u );
+  }
+  else if ( is_hadamard( g ) )
+  {
+    writer.write( snapshot_gate_type::hadamard );
+  }
+  else if ( is_stg( g ) )
+  {
+    const auto& tag = boost::any_cast<stg_tag>( g.type() );
+    writer.write( snapshot_gate_type::stg );
+    writer.write_bitset( tag.function );
+    writer.write_bitset( tag.affine_class );
+  }
+  else
+  {
+    throw std::runtime_error( "unsupported gate type in snapshot" );
+  }
+
+  /* controls as literals (line << 1 | polarity) */
+  std::vector<std::uint32_t> controls;
+  controls.reserve( g.controls().size() );
+  for ( const auto& c : g.controls() )
+  {
+    controls.push_back( ( c.line() << 1u ) | ( c.polarity() ? 1u : 0u ) );
+  }
+  writer.write_vector( controls );
+  writer.write_vector( g.targets() );
+}
+
+void read_gate( binary_reader& reader, gate& g, unsigned lines )
+{
+  const auto type = reader.read<snapshot_gate_type>();
+  switch ( type )
+  {
+  case snapshot_gate_type::toffoli:
+    g.set_type( toffoli_tag() );
+    break;
+  case snapshot_gate_type::fredkin:
+    g.set_type( fredkin_tag() );
+    break;
+  case snapshot_gate_type::peres:
+    g.set_type( peres_tag() );
+    break;
+  case snapshot_gate_type::pauli:
+    {
+      const auto axis = reader.read<std::uint8_t>();
+      const auto root = reader.read<std::uint32_t>();
+      const auto adjoint = reader.read<std::uint8_t>();
+      if ( axis > static_cast<std::uint8_t>( pauli_axis::Z ) ) { throw std::runtime_error( "invalid Pauli axis in snapshot" ); }
+      g.set_type( pauli_tag( static_cast<pauli_axis>( axis ), root, adjoint != 0u ) );
+    } break;
+  case snapshot_gate_type::hadamard:
+    g.set_type( hadamard_tag() );
+    break;
+  case snapshot_gate_type::stg:
+    {
+      stg_tag tag;
+      tag.function = reader.read_bitset();
+      tag.affine_class = reader.read_bitset();
+      g.set_type( tag );
+    } break;
+  default:
+    throw std::runtime_error( boost::str( boost::format( "unknown gate type %d in snapshot" ) % static_cast<unsigned>( type ) ) );
+  }
+
+  for ( auto literal : reader.read_array<std::uint32_t>() )
+  {
+    if ( ( literal >> 1u ) >= lines ) { throw std::runtime_error( "snapshot refers to non-existing line" ); }
+    g.add_control( make_var( literal >> 1u, literal & 1u ) );
+  }
+  for ( auto target : reader.read_array<std::uint32_t>() )
+  {
+    if ( target >= lines ) { throw std::runtime_error( "snapshot refers to non-existing line" ); }
+    g.add_target( target );
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void write_snapshot( binary_writer& writer, const circuit& circ )
+{
+  if ( !circ.modules().empty() )
+  {
+    throw std::runtime_error( "circuits with modules are not supported in snapshots" );
+  }
+
+  writer.write<std::uint32_t>( circ.lines() );
+  writer.write<std::uint32_t>( circ.num_gates() );
+  writer.write_string( circ.circuit_name() );
+
+  for ( const auto& name : circ.inputs() ) { writer.write_string( name ); }
+  for ( const auto& name : circ.outputs() ) { writer.write_string( name ); }
+
+  /* constants: 0 = none, 1 = false, 2 = true */
+  std::vector<std::uint8_t> constants;
+  constants.reserve( circ.lines() );
+  for ( const auto& c : circ.constants() )
+  {
+    constants.push_back( c ? ( *c ? 2u : 1u ) : 0u );
+  }
+  writer.write_vector( constants );
+
+  std::vector<std::uint8_t> garbage( circ.garbage().begin(), circ.garbage().end() );
+  writer.write_vector( garbage );
+
+  write_buses( writer, circ.inputbuses() );
+  write_buses( writer, circ.outputbuses() );
+  write_buses( writer, circ.statesignals() );
+
+  for ( const auto& g : circ )
+  {
+    write_gate( writer, g );
+
+    const auto annotations = circ.annotations( g );
+    writer.write<std::uint32_t>( annotations ? annotations->size() : 0u );
+    if ( annotations )
+    {
+      for ( const auto& p : *annotations )
+      {
+        writer.write_string( p.first );
+        writer.write_string( p.second );
+      }
+    }
+  }
+}
+
+void read_snapshot( binary_reader& reader, circuit& circ )
+{
+  const auto lines = reader.read<std::uint32_t>();
+  const auto num_gates = reader.read<std::uint32_t>();
+
+  circuit result;
+  result.set_lines( lines );
+  result.set_circuit_name( reader.read_string() );
+
+  std::vector<std::string> names( lines );
+  for ( auto& name : names ) { name = reader.read_string(); }
+  result.set_inputs( names );
+  for ( auto& name : names ) { name = reader.read_string(); }
+  result.set_outputs( names );
+
+  const auto constants = reader.read_array<std::uint8_t>();
+  const auto garbage = reader.read_array<std::uint8_t>();
+  if ( constants.size() != lines || garbage.size() != lines )
+  {
+    throw std::runtime_error( "inconsistent number of lines in snapshot" );
+  }
+
+  std::vector<constant> cs( lines );
+  for ( auto i = 0u; i < lines; ++i )
+  {
+    if ( constants[i] != 0u ) { cs[i] = constants[i] == 2u; }
+  }
+  result.set_constants( cs );
+  result.set_garbage( std::vector<bool>( garbage.begin(), garbage.end() ) );
+
+  read_buses( reader, result.inputbuses() );
+  read_buses( reader, result.outputbuses() );
+  read_buses( reader, result.statesignals() );
+
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    auto& g = result.append_gate();
+    read_gate( reader, g, lines );
+
+    const auto num_annotations = reader.read<std::uint32_t>();
+    for ( auto j = 0u; j < num_annotations; ++j )
+    {
+      const auto key = reader.read_string();
+      result.annotate( g, key, reader.read_string() );
+    }
+  }
+
+  circ = result;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -39,6 +39,7 @@
 #include <core/version.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 #include <reversible/circuit.hpp>
+#include <reversible/compact_circuit.hpp>
 #include <reversible/target_tags.hpp>
 
 using namespace boost::assign;
@@ -80,7 +81,54 @@ namespace cirkit
   {
   }
 
-  std::string write_realization_settings::type_label( const gate& g ) const
+  void write_buses( const circuit& circ, std::ostream& os )
+  {
+    for ( const auto& bus : circ.inputbuses().buses() )
+    {
+      std::vector<std::string> lines;
+      std::transform( bus.second.begin(), bus.second.end(), std::back_inserter( lines ), line_to_variable() );
+      os << ".inputbus " << bus.first << " " << boost::algorithm::join( lines, " " ) << std::endl;
+    }
+
+    for ( const auto& bus : circ.outputbuses().buses() )
+    {
+      std::vector<std::string> lines;
+      std::transform( bus.second.begin(), bus.second.end(), std::back_inserter( lines ), line_to_variable() );
+      os << ".outputbus " << bus.first << " " << boost::algorithm::join( lines, " " ) << std::endl;
+    }
+
+    for ( const auto& bus : circ.statesignals().buses() )
+    {
+      std::vector<std::string> lines;
+      std::transform( bus.second.begin(), bus.second.end(), std::back_inserter( lines ), line_to_variable() );
+      os << ".state " << bus.first << " " << boost::algorithm::join( lines, " " ) << std::endl;
+    }
+  }
+
+  void write_buses( const compact_circuit& circ, std::ostream& os )
+  {
+  }
+
+  void write_annotations( const circuit& circ, const gate& g, std::ostream& os )
+  {
+    boost::optional<const std::map<std::string, std::string>&> annotations = circ.annotations( g );
+    if ( annotations )
+    {
+      std::string sannotations;
+      for ( const auto& p : *annotations )
+      {
+        sannotations += boost::str( boost::format( " %s=\"%s\"" ) % p.first % p.second );
+      }
+      os << " #@" << sannotations;
+    }
+  }
+
+  void write_annotations( const compact_circuit& circ, const compact_gate& g, std::ostream& os )
+  {
+  }
+
+  template<typename Gate>
+  std::string type_label_impl( const Gate& g )
   {
     if ( is_toffoli( g ) )
     {
@@ -109,7 +157,8 @@ namespace cirkit
     }
   }
 
-  void write_realization( const circuit& circ, std::ostream& os, const write_realization_settings& settings )
+  template<typename Circuit>
+  void write_realization_impl( const Circuit& circ, std::ostream& os, const write_realization_settings& settings )
   {
     unsigned oldsize = 0;
 
@@ -189,26 +238,7 @@ namespace cirkit
     os << ".constants " << _constants << std::endl
        << ".garbage " << _garbage << std::endl;
 
-    for ( const auto& bus : circ.inputbuses().buses() )
-    {
-      std::vector<std::string> lines;
-      std::transform( bus.second.begin(), bus.second.end(), std::back_inserter( lines ), line_to_variable() );
-      os << ".inputbus " << bus.first << " " << boost::algorithm::join( lines, " " ) << std::endl;
-    }
-
-    for ( const auto& bus : circ.outputbuses().buses() )
-    {
-      std::vector<std::string> lines;
-      std::transform( bus.second.begin(), bus.second.end(), std::back_inserter( lines ), line_to_variable() );
-      os << ".outputbus " << bus.first << " " << boost::algorithm::join( lines, " " ) << std::endl;
-    }
-
-    for ( const auto& bus : circ.statesignals().buses() )
-    {
-      std::vector<std::string> lines;
-      std::transform( bus.second.begin(), bus.second.end(), std::back_inserter( lines ), line_to_variable() );
-      os << ".state " << bus.first << " " << boost::algorithm::join( lines, " " ) << std::endl;
-    }
+    write_buses( circ, os );
 
     for ( const auto& module : circ.modules() )
     {
@@ -236,16 +266,7 @@ namespace cirkit
 
       os << cmd << " " << boost::algorithm::join( lines, " " );
 
-      boost::optional<const std::map<std::string, std::string>&> annotations = circ.annotations( g );
-      if ( annotations )
-      {
-        std::string sannotations;
-        for ( const auto& p : *annotations )
-        {
-          sannotations += boost::str( boost::format( " %s=\"%s\"" ) % p.first % p.second );
-        }
-        os << " #@" << sannotations;
-      }
+      write_annotations( circ, g, os );
 
       os << std::endl;
     }
@@ -253,6 +274,26 @@ namespace cirkit
     os << ".end" << std::endl;
   }
 
+  std::string write_realization_settings::type_label( const gate& g ) const
+  {
+    return type_label_impl( g );
+  }
+
+  std::string write_realization_settings::type_label( const compact_gate& g ) const
+  {
+    return type_label_impl( g );
+  }
+
+  void write_realization( const circuit& circ, std::ostream& os, const write_realization_settings& settings )
+  {
+    write_realization_impl( circ, os, settings );
+  }
+
+  void write_realization( const compact_circuit& circ, std::ostream& os, const write_realization_settings& settings )
+  {
+    write_realization_impl( circ, os, settings );
+  }
+
   bool write_realization( const circuit& circ, const std::string& filename, const write_realization_settings& settings, std::string* error )
   {
     std::filebuf fb;
@@ -40,6 +40,7 @@
 #include <string>
 
 #include <reversible/circuit.hpp>
+#include <reversible/compact_circuit.hpp>
 
 namespace cirkit
 {
@@ -94,6 +95,13 @@ namespace cirkit
     std::string header;
 
     virtual std::string type_label( const gate& g ) const;
+
+    /**
+     * @brief Returns the string for the gate type of a compact gate view
+     *
+     * @since  2.4
+     */
+    virtual std::string type_label( const compact_gate& g ) const;
   };
 
   /**
@@ -171,6 +179,16 @@ namespace cirkit
    */
   bool write_realization( const circuit& circ, const std::string& filename, const write_realization_settings& settings = write_realization_settings(), std::string* error = 0 );
 
+  /**
+   * @brief Writes a compact circuit to a RevLib realization file
+   *
+   * The gates are written from their views without creating gate
+   * objects.  Compact circuits have no buses and annotations.
+   *
+   * @since  2.4
+   */
+  void write_realization( const compact_circuit& circ, std::ostream& os, const write_realization_settings& settings = write_realization_settings() );
+
 }
 
 #endif /* WRITE_REALIZATION_HPP */
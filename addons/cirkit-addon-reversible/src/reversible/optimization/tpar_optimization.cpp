@@ -0,0 +1,685 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "tpar_optimization.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/utils/timer.hpp>
+#include <reversible/gate.hpp>
+#include <reversible/pauli_tags.hpp>
+#include <reversible/target_tags.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/copy_metadata.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+namespace detail
+{
+
+/* one bit per path variable */
+using parity_t = boost::dynamic_bitset<>;
+
+/* value of a line, a parity of path variables possibly negated */
+struct affine_parity
+{
+  parity_t lin;
+  bool     affine;
+};
+
+/* echelon basis which remembers for each row which inserted vectors it
+ * is composed of */
+class parity_basis
+{
+public:
+  explicit parity_basis( unsigned capacity ) : capacity( capacity ) {}
+
+  /* inserts v if it is independent of all inserted vectors and there
+   * is capacity left */
+  bool insert( const parity_t& v )
+  {
+    if ( count == capacity ) { return false; }
+
+    boost::dynamic_bitset<> combination( capacity );
+    combination.set( count++ );
+
+    auto r = v;
+    reduce_in_place( r, combination );
+    if ( r.none() )
+    {
+      --count;
+      return false;
+    }
+
+    pivots.push_back( r.find_first() );
+    rows.push_back( r );
+    combinations.push_back( combination );
+    return true;
+  }
+
+  /* returns true if v is in the span, combination is the set of
+   * inserted vectors (by insertion index) that add up to v */
+  bool reduce( const parity_t& v, boost::dynamic_bitset<>& combination ) const
+  {
+    combination.resize( capacity );
+    combination.reset();
+
+    auto r = v;
+    reduce_in_place( r, combination );
+    return r.none();
+  }
+
+  bool contains( const parity_t& v ) const
+  {
+    boost::dynamic_bitset<> combination;
+    return reduce( v, combination );
+  }
+
+private:
+  void reduce_in_place( parity_t& r, boost::dynamic_bitset<>& combination ) const
+  {
+    for ( auto i = 0u; i < rows.size(); ++i )
+    {
+      if ( r.test( pivots[i] ) )
+      {
+        r ^= rows[i];
+        combination ^= combinations[i];
+      }
+    }
+  }
+
+  unsigned                             capacity;
+  unsigned                             count = 0u;
+  std::vector<parity_t>                rows;
+  std::vector<boost::dynamic_bitset<>> combinations;
+  std::vector<std::size_t>             pivots;
+};
+
+enum class tpar_gate_t { x, cnot, swap, phase, y, hadamard, barrier };
+
+tpar_gate_t tpar_gate_type( const gate& g, unsigned& exponent )
+{
+  if ( is_toffoli( g ) )
+  {
+    switch ( g.controls().size() )
+    {
+    case 0u: return tpar_gate_t::x;
+    case 1u: return tpar_gate_t::cnot;
+    default: return tpar_gate_t::barrier;
+    }
+  }
+  else if ( is_fredkin( g ) )
+  {
+    return g.controls().empty() ? tpar_gate_t::swap : tpar_gate_t::barrier;
+  }
+  else if ( is_hadamard( g ) )
+  {
+    return g.controls().empty() ? tpar_gate_t::hadamard : tpar_gate_t::barrier;
+  }
+  else if ( is_pauli( g ) && g.controls().empty() )
+  {
+    const auto& tag = boost::any_cast<pauli_tag>( g.type() );
+
+    if ( tag.axis == pauli_axis::Z && ( tag.root == 1u || tag.root == 2u || tag.root == 4u ) )
+    {
+      /* in multiples of pi/4 */
+      exponent = 4u / tag.root;
+      if ( tag.adjoint )
+      {
+        exponent = ( 8u - exponent ) % 8u;
+      }
+      return tpar_gate_t::phase;
+    }
+    else if ( tag.root == 1u )
+    {
+      return tag.axis == pauli_axis::X ? tpar_gate_t::x : tpar_gate_t::y;
+    }
+  }
+
+  return tpar_gate_t::barrier;
+}
+
+class tpar_manager
+{
+public:
+  explicit tpar_manager( const circuit& circ )
+    : circ( circ ),
+      n( circ.lines() ),
+      out( circ.lines() )
+  {
+    copy_metadata( circ, out );
+
+    /* every Hadamard gate and every target of a barrier gate introduces a fresh variable */
+    auto num_vars = n;
+    for ( const auto& g : circ )
+    {
+      unsigned exponent;
+      const auto type = tpar_gate_type( g, exponent );
+      if ( type == tpar_gate_t::hadamard )
+      {
+        ++num_vars;
+      }
+      else if ( type == tpar_gate_t::barrier )
+      {
+        num_vars += g.targets().size();
+      }
+    }
+
+    for ( auto i = 0u; i < n; ++i )
+    {
+      wires.push_back( {parity_t( num_vars ), false} );
+      wires.back().lin.set( i );
+    }
+    cur = wires;
+    next_var = n;
+  }
+
+  circuit run()
+  {
+    for ( const auto& g : circ )
+    {
+      unsigned exponent = 0u;
+      switch ( tpar_gate_type( g, exponent ) )
+      {
+      case tpar_gate_t::x:
+        wires[g.targets().front()].affine ^= true;
+        break;
+
+      case tpar_gate_t::cnot:
+        {
+          const auto& c = g.controls().front();
+          auto& w = wires[g.targets().front()];
+          w.lin ^= wires[c.line()].lin;
+          w.affine ^= wires[c.line()].affine ^ !c.polarity();
+        }
+        break;
+
+      case tpar_gate_t::swap:
+        std::swap( wires[g.targets()[0u]], wires[g.targets()[1u]] );
+        break;
+
+      case tpar_gate_t::phase:
+        add_phase( g.targets().front(), exponent );
+        break;
+
+      case tpar_gate_t::y:
+        /* Y = i X Z */
+        add_phase( g.targets().front(), 4u );
+        wires[g.targets().front()].affine ^= true;
+        global = ( global + 2u ) % 8u;
+        break;
+
+      case tpar_gate_t::hadamard:
+        {
+          const auto target = g.targets().front();
+          flush( target, false );
+          append_hadamard( out, target );
+          fresh_variable( target );
+        }
+        break;
+
+      case tpar_gate_t::barrier:
+        flush( n, false );
+        out.append_gate() = g;
+        for ( const auto& t : g.targets() )
+        {
+          fresh_variable( t );
+        }
+        break;
+      }
+    }
+
+    flush( n, true );
+    correct_global_phase();
+
+    return out;
+  }
+
+  inline unsigned num_partitions() const { return _num_partitions; }
+
+private:
+  void fresh_variable( unsigned line )
+  {
+    wires[line].lin.reset();
+    wires[line].lin.set( next_var++ );
+    wires[line].affine = false;
+    cur[line] = wires[line];
+  }
+
+  /* phase w^k on a line with value p is w^k p if not negated, and
+   * w^k w^{-k p} otherwise, w = e^{i pi/4} */
+  void add_phase( unsigned line, unsigned k )
+  {
+    const auto& w = wires[line];
+
+    if ( w.affine )
+    {
+      global = ( global + k ) % 8u;
+      k = ( 8u - k ) % 8u;
+    }
+    if ( w.lin.none() ) { return; }
+
+    auto& e = terms[w.lin];
+    e = ( e + k ) % 8u;
+  }
+
+  /* synthesizes the pending terms that cannot be computed anymore after
+   * a Hadamard gate on `line' (all terms if line = n), and afterwards
+   * restores the lines to their logical values */
+  void flush( unsigned line, bool final )
+  {
+    std::vector<std::pair<parity_t, unsigned>> now;
+
+    parity_basis remaining( n );
+    if ( line < n )
+    {
+      for ( auto j = 0u; j < n; ++j )
+      {
+        if ( j != line )
+        {
+          remaining.insert( wires[j].lin );
+        }
+      }
+    }
+
+    for ( auto it = terms.begin(); it != terms.end(); )
+    {
+      if ( it->second == 0u )
+      {
+        it = terms.erase( it );
+      }
+      else if ( line == n || !remaining.contains( it->first ) )
+      {
+        now.push_back( *it );
+        it = terms.erase( it );
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    /* an odd global phase can be avoided by synthesizing one odd term on the negated parity */
+    auto negate = now.size();
+    if ( final && ( ( global + 8u - emitted_global ) % 8u ) % 2u == 1u )
+    {
+      for ( auto i = 0u; i < now.size(); ++i )
+      {
+        if ( now[i].second % 2u == 1u )
+        {
+          negate = i;
+          break;
+        }
+      }
+    }
+
+    for ( const auto& partition : partition_terms( now ) )
+    {
+      std::vector<parity_t> parities;
+      for ( auto i : partition )
+      {
+        parities.push_back( now[i].first );
+      }
+      const auto placement = place( parities );
+
+      for ( auto j = 0u; j < partition.size(); ++j )
+      {
+        const auto i = partition[j];
+        const auto target = placement[j];
+        if ( i == negate )
+        {
+          append_not( out, target );
+          emit_phase( target, ( 8u - now[i].second ) % 8u );
+          emitted_global = ( emitted_global + 8u - now[i].second ) % 8u;
+          append_not( out, target );
+        }
+        else
+        {
+          emit_phase( target, now[i].second );
+        }
+      }
+    }
+
+    synthesize( wires );
+  }
+
+  /* Edmonds' matroid partitioning: each partition is a set of linearly
+   * independent parities that are synthesized in one layer.  An element
+   * is inserted by a shortest augmenting path of exchanges.  Only terms
+   * with an odd exponent require T gates, terms with an even exponent
+   * are added greedily afterwards. */
+  std::vector<std::vector<unsigned>> partition_terms( const std::vector<std::pair<parity_t, unsigned>>& elems )
+  {
+    std::vector<std::vector<unsigned>> partitions;
+
+    const auto circuit_in = [&]( const std::vector<unsigned>& partition, unsigned e, std::vector<unsigned>& circuit ) {
+      parity_basis basis( partition.size() );
+      for ( auto p : partition )
+      {
+        basis.insert( elems[p].first );
+      }
+
+      boost::dynamic_bitset<> combination;
+      if ( !basis.reduce( elems[e].first, combination ) )
+      {
+        return false;
+      }
+
+      circuit.clear();
+      for ( auto pos = combination.find_first(); pos != boost::dynamic_bitset<>::npos; pos = combination.find_next( pos ) )
+      {
+        circuit.push_back( partition[pos] );
+      }
+      return true;
+    };
+
+    std::vector<unsigned> owner( elems.size(), static_cast<unsigned>( -1 ) );
+    const auto none = static_cast<unsigned>( -1 );
+
+    for ( auto x = 0u; x < elems.size(); ++x )
+    {
+      if ( elems[x].second % 2u == 0u ) { continue; }
+
+      /* parent[y] = (e, i): e is moved into partition i and replaces y */
+      std::vector<std::pair<unsigned, unsigned>> parent( elems.size(), {none, none} );
+      std::vector<bool> visited( elems.size(), false );
+      std::deque<unsigned> queue{x};
+      visited[x] = true;
+
+      auto found = false;
+      std::vector<unsigned> circuit;
+      while ( !queue.empty() && !found )
+      {
+        const auto e = queue.front();
+        queue.pop_front();
+
+        for ( auto i = 0u; i < partitions.size() && !found; ++i )
+        {
+          if ( owner[e] == i ) { continue; }
+
+          if ( !circuit_in( partitions[i], e, circuit ) )
+          {
+            /* augment along the path */
+            auto elem = e;
+            auto into = i;
+            while ( true )
+            {
+              if ( owner[elem] != none )
+              {
+                auto& from = partitions[owner[elem]];
+                from.erase( std::find( from.begin(), from.end(), elem ) );
+              }
+              partitions[into].push_back( elem );
+              const auto moved = parent[elem];
+              owner[elem] = into;
+              if ( moved.first == none ) { break; }
+
+              /* the element that displaced elem takes its place */
+              into = moved.second;
+              elem = moved.first;
+            }
+            found = true;
+          }
+          else
+          {
+            for ( auto y : circuit )
+            {
+              if ( !visited[y] )
+              {
+                visited[y] = true;
+                parent[y] = {e, i};
+                queue.push_back( y );
+              }
+            }
+          }
+        }
+      }
+
+      if ( !found )
+      {
+        owner[x] = partitions.size();
+        partitions.push_back( {x} );
+      }
+    }
+
+    _num_partitions += partitions.size();
+
+    for ( auto x = 0u; x < elems.size(); ++x )
+    {
+      if ( elems[x].second % 2u == 1u ) { continue; }
+
+      std::vector<unsigned> circuit;
+      auto i = 0u;
+      for ( ; i < partitions.size(); ++i )
+      {
+        if ( !circuit_in( partitions[i], x, circuit ) )
+        {
+          partitions[i].push_back( x );
+          break;
+        }
+      }
+      if ( i == partitions.size() )
+      {
+        partitions.push_back( {x} );
+      }
+    }
+
+    return partitions;
+  }
+
+  /* moves the independent parities onto lines and returns for each
+   * parity its line, the other lines keep their value if possible */
+  std::vector<unsigned> place( const std::vector<parity_t>& parities )
+  {
+    std::vector<unsigned> placement( parities.size(), n );
+    std::vector<bool> assigned( n, false );
+    auto target = cur;
+
+    parity_basis basis( n );
+    for ( auto j = 0u; j < parities.size(); ++j )
+    {
+      basis.insert( parities[j] );
+      for ( auto l = 0u; l < n; ++l )
+      {
+        if ( !assigned[l] && cur[l].lin == parities[j] )
+        {
+          assigned[l] = true;
+          placement[j] = l;
+          break;
+        }
+      }
+    }
+
+    for ( auto l = 0u; l < n; ++l )
+    {
+      if ( !assigned[l] && basis.insert( cur[l].lin ) )
+      {
+        assigned[l] = true;
+      }
+    }
+
+    auto l = 0u;
+    for ( auto j = 0u; j < parities.size(); ++j )
+    {
+      if ( placement[j] != n ) { continue; }
+      while ( assigned[l] ) { ++l; }
+      assigned[l] = true;
+      placement[j] = l;
+    }
+
+    for ( auto j = 0u; j < parities.size(); ++j )
+    {
+      target[placement[j]] = {parities[j], false};
+    }
+
+    synthesize( target );
+    return placement;
+  }
+
+  /* CNOT and NOT gates that transform the current line values into
+   * `target', by Gauss-Jordan elimination of the current values
+   * expressed in the basis of the target values */
+  void synthesize( const std::vector<affine_parity>& target )
+  {
+    parity_basis basis( n );
+    for ( const auto& t : target )
+    {
+      basis.insert( t.lin );
+    }
+
+    std::vector<boost::dynamic_bitset<>> matrix( n );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      basis.reduce( cur[i].lin, matrix[i] );
+    }
+
+    const auto cnot = [this, &matrix]( unsigned control, unsigned t ) {
+      matrix[t] ^= matrix[control];
+      cur[t].lin ^= cur[control].lin;
+      cur[t].affine ^= cur[control].affine;
+      append_cnot( out, control, t );
+    };
+
+    for ( auto col = 0u; col < n; ++col )
+    {
+      if ( !matrix[col].test( col ) )
+      {
+        auto r = col + 1u;
+        while ( !matrix[r].test( col ) ) { ++r; }
+        cnot( r, col );
+      }
+
+      for ( auto i = 0u; i < n; ++i )
+      {
+        if ( i != col && matrix[i].test( col ) )
+        {
+          cnot( col, i );
+        }
+      }
+    }
+
+    for ( auto i = 0u; i < n; ++i )
+    {
+      if ( cur[i].affine != target[i].affine )
+      {
+        append_not( out, i );
+        cur[i].affine = target[i].affine;
+      }
+    }
+  }
+
+  void emit_phase( unsigned line, unsigned e )
+  {
+    switch ( e % 8u )
+    {
+    case 1u: append_pauli( out, line, pauli_axis::Z, 4u ); break;
+    case 2u: append_pauli( out, line, pauli_axis::Z, 2u ); break;
+    case 3u: append_pauli( out, line, pauli_axis::Z, 2u ); append_pauli( out, line, pauli_axis::Z, 4u ); break;
+    case 4u: append_pauli( out, line, pauli_axis::Z ); break;
+    case 5u: append_pauli( out, line, pauli_axis::Z ); append_pauli( out, line, pauli_axis::Z, 4u ); break;
+    case 6u: append_pauli( out, line, pauli_axis::Z, 2u, true ); break;
+    case 7u: append_pauli( out, line, pauli_axis::Z, 4u, true ); break;
+    }
+  }
+
+  /* X P X P = diag(p, p) for a diagonal P = diag(1, p) */
+  void correct_global_phase()
+  {
+    auto delta = ( global + 8u - emitted_global ) % 8u;
+    if ( delta == 0u || n == 0u ) { return; }
+
+    if ( delta % 2u == 1u )
+    {
+      for ( auto i = 0u; i < 2u; ++i )
+      {
+        append_not( out, 0u );
+        emit_phase( 0u, 1u );
+      }
+      delta -= 1u;
+    }
+
+    if ( delta != 0u )
+    {
+      for ( auto i = 0u; i < 2u; ++i )
+      {
+        append_not( out, 0u );
+        emit_phase( 0u, delta );
+      }
+    }
+  }
+
+private:
+  const circuit& circ;
+  unsigned       n;
+  circuit        out;
+
+  std::vector<affine_parity>   wires;               /* logical value of each line */
+  std::vector<affine_parity>   cur;                 /* value of each line in out */
+  std::map<parity_t, unsigned> terms;               /* pending phase polynomial */
+  unsigned                     global = 0u;         /* global phase of circ so far */
+  unsigned                     emitted_global = 0u; /* global phase of out so far */
+  unsigned                     next_var;
+  unsigned                     _num_partitions = 0u;
+};
+
+}
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+circuit tpar_optimization( const circuit& circ, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  properties_timer t( statistics );
+
+  detail::tpar_manager mgr( circ );
+  const auto result = mgr.run();
+
+  set( statistics, "num_partitions", mgr.num_partitions() );
+
+  return result;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
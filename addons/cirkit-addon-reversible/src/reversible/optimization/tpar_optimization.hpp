@@ -0,0 +1,89 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file tpar_optimization.hpp
+ *
+ * @brief T-depth optimization via matroid partitioning
+ *
+ * Based on [M. Amy, D. Maslov, and M. Mosca, IEEE TCAD 33(10), 2014].
+ * The CNOT, X, and phase gates between two Hadamard gates are read into
+ * a phase polynomial over parities of path variables.  Equal parities
+ * are merged, and the terms are resynthesized in layers of linearly
+ * independent parities, each layer needs T-depth 1.  Terms are only
+ * synthesized before a Hadamard gate if their parity cannot be computed
+ * anymore after it.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef TPAR_OPTIMIZATION_HPP
+#define TPAR_OPTIMIZATION_HPP
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @brief Optimizes T-count and T-depth of a Clifford+T circuit
+ *
+ * Supported are Hadamard gates, NOT and CNOT gates (Toffoli gates with
+ * at most one control of any polarity), uncontrolled SWAP gates, X, Y,
+ * Z, S, and T gates and their adjoints.  All other gates are kept in
+ * place and treated as barriers for the phase polynomial.  The result
+ * realizes the same unitary including the global phase.
+ *
+ * @param statistics <table border="0" width="100%">
+ *   <tr>
+ *     <td class="indexkey">Information</td>
+ *     <td class="indexkey">Type</td>
+ *     <td class="indexkey">Description</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">num_partitions</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">Number of layers with at least one T gate.</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">runtime</td>
+ *     <td class="indexvalue">double</td>
+ *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+ *   </tr>
+ * </table>
+ */
+circuit tpar_optimization( const circuit& circ, const properties::ptr& settings = properties::ptr(), const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
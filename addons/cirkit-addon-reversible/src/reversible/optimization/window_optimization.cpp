@@ -34,7 +34,6 @@
 #include <reversible/functions/expand_circuit.hpp>
 #include <reversible/functions/find_lines.hpp>
 #include <reversible/io/print_circuit.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 #include <reversible/synthesis/transformation_based_synthesis.hpp>
 
 namespace cirkit
@@ -155,15 +154,21 @@ namespace cirkit
   }
 
   resynthesis_optimization::resynthesis_optimization()
-    : synthesis( transformation_based_synthesis_func() ),
-      simulation( simple_simulation_func() )
+    : synthesis( transformation_based_synthesis_func() )
   {
   }
 
   bool resynthesis_optimization::operator()( circuit& new_window, const circuit& old_window ) const
   {
     binary_truth_table spec;
-    circuit_to_truth_table( old_window, spec, simulation );
+    if ( simulation )
+    {
+      circuit_to_truth_table( old_window, spec, simulation );
+    }
+    else
+    {
+      circuit_to_truth_table( old_window, spec );
+    }
     return synthesis( new_window, spec );
   }
 
@@ -231,7 +231,8 @@ namespace cirkit
     /**
      * @brief Simulation method for creating the truth table
      *
-     * Default value is \b revkit::simple_simulation_func
+     * If empty (default), all patterns are simulated at once using
+     * \b cirkit::bitsliced_simulation
      *
      * @since  1.0
      */
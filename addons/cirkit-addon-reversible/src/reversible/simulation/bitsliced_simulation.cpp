@@ -0,0 +1,370 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bitsliced_simulation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <numeric>
+#include <thread>
+
+#include <core/utils/timer.hpp>
+#include <reversible/gate.hpp>
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace detail
+{
+
+/* projection of variable i for i < 6 */
+static const std::uint64_t projections[] = {
+  0xaaaaaaaaaaaaaaaaull, 0xccccccccccccccccull, 0xf0f0f0f0f0f0f0f0ull,
+  0xff00ff00ff00ff00ull, 0xffff0000ffff0000ull, 0xffffffff00000000ull
+};
+
+/* words processed together by a kernel */
+constexpr unsigned lanes = 4u;
+
+inline std::uint64_t num_words_for_lines( unsigned lines )
+{
+  return lines <= 6u ? 1ull : ( 1ull << ( lines - 6u ) );
+}
+
+}
+
+template<typename Circuit>
+void bitsliced_simulator::compile( const Circuit& circ, const std::vector<unsigned>& line_map, const std::vector<std::pair<unsigned, std::uint64_t>>& enable )
+{
+  for ( const auto& g : circ )
+  {
+    kernel k;
+    k.controls = enable;
+    if ( !is_stg( g ) )
+    {
+      for ( const auto& c : g.controls() )
+      {
+        k.controls.push_back( {line_map[c.line()], c.polarity() ? 0ull : ~0ull} );
+      }
+    }
+    for ( const auto& t : g.targets() )
+    {
+      k.targets.push_back( line_map[t] );
+    }
+
+    if ( is_toffoli( g ) )
+    {
+      k.type = kernel_t::toffoli;
+      kernels.push_back( k );
+    }
+    else if ( is_fredkin( g ) )
+    {
+      k.type = kernel_t::fredkin;
+      kernels.push_back( k );
+    }
+    else if ( is_peres( g ) )
+    {
+      /* t2 ^= c & t1, then t1 ^= c */
+      k.type = kernel_t::toffoli;
+      const auto t1 = k.targets[0u], t2 = k.targets[1u];
+      k.targets = {t2};
+      k.controls.push_back( {t1, 0ull} );
+      kernels.push_back( k );
+
+      k.controls.pop_back();
+      k.targets = {t1};
+      kernels.push_back( k );
+    }
+    else if ( is_stg( g ) )
+    {
+      const auto& function = boost::any_cast<stg_tag>( g.type() ).function;
+
+      k.type = kernel_t::stg;
+      for ( const auto& c : g.controls() )
+      {
+        k.inputs.push_back( line_map[c.line()] );
+      }
+      for ( auto m = 0u; m < function.size(); ++m )
+      {
+        if ( function.test( m ) )
+        {
+          k.minterms.push_back( m );
+        }
+      }
+      kernels.push_back( k );
+    }
+    else if ( is_module( g ) )
+    {
+      const auto* tag = boost::any_cast<module_tag>( &g.type() );
+
+      std::vector<unsigned> inner_map;
+      for ( const auto& t : g.targets() )
+      {
+        inner_map.push_back( line_map[t] );
+      }
+      compile( *tag->reference, inner_map, k.controls );
+    }
+    else
+    {
+      assert( false );
+    }
+  }
+}
+
+/* applies kernel k to the words [w, w + N); the words are kept in a
+ * local buffer of fixed size such that the loops over j vectorize */
+template<unsigned N>
+inline void bitsliced_simulator::apply_kernel( const kernel& k, bitsliced_patterns& patterns, std::uint64_t w )
+{
+  constexpr auto n = N;
+
+  std::uint64_t enable[N];
+  for ( auto j = 0u; j < n; ++j ) { enable[j] = ~0ull; }
+
+  for ( const auto& c : k.controls )
+  {
+    const auto* line = patterns[c.first].data() + w;
+    for ( auto j = 0u; j < n; ++j ) { enable[j] &= line[j] ^ c.second; }
+  }
+
+  switch ( k.type )
+  {
+  case kernel_t::toffoli:
+    {
+      auto* t = patterns[k.targets.front()].data() + w;
+      for ( auto j = 0u; j < n; ++j ) { t[j] ^= enable[j]; }
+    }
+    break;
+
+  case kernel_t::fredkin:
+    {
+      auto* t1 = patterns[k.targets[0u]].data() + w;
+      auto* t2 = patterns[k.targets[1u]].data() + w;
+      for ( auto j = 0u; j < n; ++j )
+      {
+        const auto diff = ( t1[j] ^ t2[j] ) & enable[j];
+        t1[j] ^= diff;
+        t2[j] ^= diff;
+      }
+    }
+    break;
+
+  case kernel_t::stg:
+    {
+      std::uint64_t value[N], term[N];
+      for ( auto j = 0u; j < n; ++j ) { value[j] = 0ull; }
+
+      for ( auto m : k.minterms )
+      {
+        for ( auto j = 0u; j < n; ++j ) { term[j] = ~0ull; }
+        for ( auto i = 0u; i < k.inputs.size(); ++i )
+        {
+          const auto* line = patterns[k.inputs[i]].data() + w;
+          const auto mask = ( ( m >> i ) & 1u ) ? 0ull : ~0ull;
+          for ( auto j = 0u; j < n; ++j ) { term[j] &= line[j] ^ mask; }
+        }
+        for ( auto j = 0u; j < n; ++j ) { value[j] |= term[j]; }
+      }
+
+      auto* t = patterns[k.targets.front()].data() + w;
+      for ( auto j = 0u; j < n; ++j ) { t[j] ^= value[j] & enable[j]; }
+    }
+    break;
+  }
+}
+
+void bitsliced_simulator::simulate_block( bitsliced_patterns& patterns, std::uint64_t begin, std::uint64_t end ) const
+{
+  for ( const auto& k : kernels )
+  {
+    auto w = begin;
+    for ( ; w + detail::lanes <= end; w += detail::lanes )
+    {
+      apply_kernel<detail::lanes>( k, patterns, w );
+    }
+    for ( ; w < end; ++w )
+    {
+      apply_kernel<1u>( k, patterns, w );
+    }
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bitsliced_patterns create_exhaustive_patterns( unsigned lines, std::uint64_t first_word, std::uint64_t num_words )
+{
+  const auto total = detail::num_words_for_lines( lines );
+  assert( first_word < total );
+  if ( num_words == 0u || first_word + num_words > total )
+  {
+    num_words = total - first_word;
+  }
+
+  bitsliced_patterns patterns( lines, std::vector<std::uint64_t>( num_words ) );
+  for ( auto i = 0u; i < lines; ++i )
+  {
+    for ( auto w = 0u; w < num_words; ++w )
+    {
+      patterns[i][w] = i < 6u ? detail::projections[i] : ( ( ( ( first_word + w ) >> ( i - 6u ) ) & 1u ) ? ~0ull : 0ull );
+    }
+  }
+  return patterns;
+}
+
+bitsliced_patterns create_bitsliced_patterns( const std::vector<boost::dynamic_bitset<>>& patterns, unsigned lines )
+{
+  bitsliced_patterns result( lines, std::vector<std::uint64_t>( ( patterns.size() + 63u ) >> 6u ) );
+  for ( auto p = 0u; p < patterns.size(); ++p )
+  {
+    assert( patterns[p].size() == lines );
+    for ( auto i = patterns[p].find_first(); i != boost::dynamic_bitset<>::npos; i = patterns[p].find_next( i ) )
+    {
+      result[i][p >> 6u] |= 1ull << ( p & 63u );
+    }
+  }
+  return result;
+}
+
+boost::dynamic_bitset<> bitsliced_pattern( const bitsliced_patterns& patterns, std::uint64_t index )
+{
+  boost::dynamic_bitset<> pattern( patterns.size() );
+  for ( auto i = 0u; i < patterns.size(); ++i )
+  {
+    pattern[i] = ( patterns[i][index >> 6u] >> ( index & 63u ) ) & 1u;
+  }
+  return pattern;
+}
+
+bitsliced_simulator::bitsliced_simulator( const circuit& circ )
+  : _lines( circ.lines() )
+{
+  std::vector<unsigned> line_map( circ.lines() );
+  std::iota( line_map.begin(), line_map.end(), 0u );
+  compile( circ, line_map, {} );
+}
+
+bitsliced_simulator::bitsliced_simulator( const compact_circuit& circ )
+  : _lines( circ.lines() )
+{
+  std::vector<unsigned> line_map( circ.lines() );
+  std::iota( line_map.begin(), line_map.end(), 0u );
+  compile( circ, line_map, {} );
+}
+
+void bitsliced_simulator::simulate( bitsliced_patterns& patterns, unsigned num_threads, unsigned block_size ) const
+{
+  assert( patterns.size() == _lines );
+  if ( patterns.empty() || kernels.empty() ) { return; }
+
+  const std::uint64_t num_words = patterns.front().size();
+  const std::uint64_t num_blocks = ( num_words + block_size - 1u ) / block_size;
+
+  if ( num_threads == 0u )
+  {
+    num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+  }
+  num_threads = static_cast<unsigned>( std::min<std::uint64_t>( num_threads, num_blocks ) );
+
+  std::atomic<std::uint64_t> next_block( 0u );
+  const auto work = [&]() {
+    std::uint64_t block;
+    while ( ( block = next_block++ ) < num_blocks )
+    {
+      simulate_block( patterns, block * block_size, std::min<std::uint64_t>( ( block + 1u ) * block_size, num_words ) );
+    }
+  };
+
+  if ( num_threads <= 1u )
+  {
+    work();
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  for ( auto i = 0u; i < num_threads; ++i )
+  {
+    threads.emplace_back( work );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+}
+
+bool bitsliced_simulation( bitsliced_patterns& patterns, const circuit& circ,
+                           const properties::ptr& settings,
+                           const properties::ptr& statistics )
+{
+  const auto num_threads = get( settings, "num_threads", 1u );
+  const auto block_size  = get( settings, "block_size",  256u );
+
+  properties_timer t( statistics );
+
+  bitsliced_simulator( circ ).simulate( patterns, num_threads, block_size );
+  return true;
+}
+
+bool bitsliced_simulation( boost::dynamic_bitset<>& output, const circuit& circ, const boost::dynamic_bitset<>& input,
+                           const properties::ptr& settings,
+                           const properties::ptr& statistics )
+{
+  auto patterns = create_bitsliced_patterns( {input}, circ.lines() );
+  if ( !bitsliced_simulation( patterns, circ, settings, statistics ) )
+  {
+    return false;
+  }
+  output = bitsliced_pattern( patterns, 0u );
+  return true;
+}
+
+simulation_func bitsliced_simulation_func( properties::ptr settings, properties::ptr statistics )
+{
+  simulation_func f = [settings, statistics]( boost::dynamic_bitset<>& output, const circuit& circ, const boost::dynamic_bitset<>& input ) {
+    return bitsliced_simulation( output, circ, input, settings, statistics );
+  };
+  f.init( settings, statistics );
+  return f;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
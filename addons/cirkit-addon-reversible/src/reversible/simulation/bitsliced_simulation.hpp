@@ -0,0 +1,183 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file bitsliced_simulation.hpp
+ *
+ * @brief Bit-sliced simulation of many patterns at once
+ *
+ * Each line is stored as a vector of 64-bit words, bit p of word w
+ * holds the value of the line for pattern 64w + p.  A Toffoli gate
+ * then becomes target ^= AND(controls) over the words.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef BITSLICED_SIMULATION_HPP
+#define BITSLICED_SIMULATION_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/compact_circuit.hpp>
+#include <reversible/simulation/simulation.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @brief Bit-sliced patterns, one vector of words per line
+ */
+using bitsliced_patterns = std::vector<std::vector<std::uint64_t>>;
+
+/**
+ * @brief Exhaustive patterns for `lines' lines
+ *
+ * Pattern p assigns bit i of p to line i.  Only the words starting at
+ * `first_word' are created, `num_words' = 0 means all remaining
+ * words.  For fewer than 6 lines there is a single word in which only
+ * the lowest 2^lines bits are meaningful.
+ */
+bitsliced_patterns create_exhaustive_patterns( unsigned lines, std::uint64_t first_word = 0u, std::uint64_t num_words = 0u );
+
+/**
+ * @brief Transposes a list of patterns (each with one bit per line)
+ */
+bitsliced_patterns create_bitsliced_patterns( const std::vector<boost::dynamic_bitset<>>& patterns, unsigned lines );
+
+/**
+ * @brief Extracts pattern `index' as a bitset with one bit per line
+ */
+boost::dynamic_bitset<> bitsliced_pattern( const bitsliced_patterns& patterns, std::uint64_t index );
+
+/**
+ * @brief Circuit compiled into word-level kernels
+ *
+ * Gate types are dispatched once at construction, Peres gates are
+ * split into two Toffoli kernels, and modules are inlined with their
+ * controls added to every inner kernel.
+ */
+class bitsliced_simulator
+{
+public:
+  explicit bitsliced_simulator( const circuit& circ );
+  explicit bitsliced_simulator( const compact_circuit& circ );
+
+  /**
+   * @brief Simulates the patterns in place
+   *
+   * Words are processed in blocks of `block_size' words which pass
+   * through all gates before the next block is loaded, and blocks are
+   * distributed to `num_threads' threads (0: number of cores).
+   */
+  void simulate( bitsliced_patterns& patterns, unsigned num_threads = 1u, unsigned block_size = 256u ) const;
+
+  inline unsigned lines() const { return _lines; }
+
+private:
+  enum class kernel_t { toffoli, fredkin, stg };
+
+  struct kernel
+  {
+    kernel_t                                           type;
+    std::vector<std::pair<unsigned, std::uint64_t>>    controls;  /* line and mask to invert negative controls */
+    std::vector<unsigned>                              targets;
+    std::vector<unsigned>                              inputs;    /* STG function inputs */
+    std::vector<std::uint64_t>                         minterms;  /* STG on-set */
+  };
+
+  template<typename Circuit>
+  void compile( const Circuit& circ, const std::vector<unsigned>& line_map, const std::vector<std::pair<unsigned, std::uint64_t>>& enable );
+  void simulate_block( bitsliced_patterns& patterns, std::uint64_t begin, std::uint64_t end ) const;
+  template<unsigned N>
+  static void apply_kernel( const kernel& k, bitsliced_patterns& patterns, std::uint64_t w );
+
+  unsigned            _lines;
+  std::vector<kernel> kernels;
+};
+
+/**
+ * @brief Bit-sliced simulation of a circuit
+ *
+ * @param patterns Patterns as created by create_exhaustive_patterns or
+ *                 create_bitsliced_patterns, overwritten with the outputs
+ * @param settings <table border="0" width="100%">
+ *   <tr>
+ *     <td class="indexkey">Setting</td>
+ *     <td class="indexkey">Type</td>
+ *     <td class="indexkey">Default Value</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">num_threads</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">1u</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">block_size</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">256u</td>
+ *   </tr>
+ * </table>
+ * @param statistics <table border="0" width="100%">
+ *   <tr>
+ *     <td class="indexkey">Information</td>
+ *     <td class="indexkey">Type</td>
+ *     <td class="indexkey">Description</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">runtime</td>
+ *     <td class="indexvalue">double</td>
+ *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+ *   </tr>
+ * </table>
+ */
+bool bitsliced_simulation( bitsliced_patterns& patterns, const circuit& circ,
+                           const properties::ptr& settings = properties::ptr(),
+                           const properties::ptr& statistics = properties::ptr() );
+
+/**
+ * @brief Single pattern version, compatible with simulation_func
+ */
+bool bitsliced_simulation( boost::dynamic_bitset<>& output, const circuit& circ, const boost::dynamic_bitset<>& input,
+                           const properties::ptr& settings = properties::ptr(),
+                           const properties::ptr& statistics = properties::ptr() );
+
+simulation_func bitsliced_simulation_func( properties::ptr settings = std::make_shared<properties>(), properties::ptr statistics = std::make_shared<properties>() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
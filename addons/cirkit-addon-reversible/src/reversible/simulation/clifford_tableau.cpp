@@ -0,0 +1,248 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "clifford_tableau.hpp"
+
+#include <functional>
+
+#include <reversible/pauli_tags.hpp>
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bool is_clifford_gate( const gate& g )
+{
+  const auto num_controls = g.controls().size();
+
+  if ( is_toffoli( g ) )
+  {
+    return num_controls <= 1u;
+  }
+  else if ( is_fredkin( g ) )
+  {
+    return num_controls == 0u;
+  }
+  else if ( is_hadamard( g ) )
+  {
+    return num_controls == 0u;
+  }
+  else if ( is_pauli( g ) )
+  {
+    const auto& tag = boost::any_cast<pauli_tag>( g.type() );
+    if ( tag.root == 1u )
+    {
+      return num_controls == 0u || ( num_controls == 1u && tag.axis != pauli_axis::Y );
+    }
+    return num_controls == 0u && tag.axis == pauli_axis::Z && tag.root == 2u;
+  }
+
+  return false;
+}
+
+bool is_clifford_circuit( const circuit& circ )
+{
+  for ( const auto& g : circ )
+  {
+    if ( !is_clifford_gate( g ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+clifford_tableau::clifford_tableau( unsigned qubits )
+  : xs( qubits, boost::dynamic_bitset<>( 2u * qubits ) ),
+    zs( qubits, boost::dynamic_bitset<>( 2u * qubits ) ),
+    r( 2u * qubits )
+{
+  for ( auto i = 0u; i < qubits; ++i )
+  {
+    xs[i].set( i );
+    zs[i].set( qubits + i );
+  }
+}
+
+void clifford_tableau::h( unsigned a )
+{
+  r ^= xs[a] & zs[a];
+  xs[a].swap( zs[a] );
+}
+
+void clifford_tableau::s( unsigned a )
+{
+  r ^= xs[a] & zs[a];
+  zs[a] ^= xs[a];
+}
+
+void clifford_tableau::sdg( unsigned a )
+{
+  /* S^dagger = Z S */
+  s( a );
+  z( a );
+}
+
+void clifford_tableau::x( unsigned a )
+{
+  r ^= zs[a];
+}
+
+void clifford_tableau::y( unsigned a )
+{
+  r ^= xs[a] ^ zs[a];
+}
+
+void clifford_tableau::z( unsigned a )
+{
+  r ^= xs[a];
+}
+
+void clifford_tableau::cx( unsigned control, unsigned target )
+{
+  r ^= xs[control] & zs[target] & ~( xs[target] ^ zs[control] );
+  xs[target] ^= xs[control];
+  zs[control] ^= zs[target];
+}
+
+bool clifford_tableau::apply( const gate& g, bool adjoint )
+{
+  if ( !is_clifford_gate( g ) )
+  {
+    return false;
+  }
+
+  const auto target = g.targets().front();
+
+  /* gates with a single control, negative controls are conjugated with X */
+  const auto controlled = [this, &g]( std::function<void(unsigned)>&& f ) {
+    const auto& c = g.controls().front();
+    if ( !c.polarity() ) { x( c.line() ); }
+    f( c.line() );
+    if ( !c.polarity() ) { x( c.line() ); }
+  };
+
+  if ( is_toffoli( g ) )
+  {
+    if ( g.controls().empty() )
+    {
+      x( target );
+    }
+    else
+    {
+      controlled( [this, target]( unsigned c ) { cx( c, target ); } );
+    }
+  }
+  else if ( is_fredkin( g ) )
+  {
+    const auto other = g.targets()[1u];
+    cx( target, other );
+    cx( other, target );
+    cx( target, other );
+  }
+  else if ( is_hadamard( g ) )
+  {
+    h( target );
+  }
+  else
+  {
+    const auto& tag = boost::any_cast<pauli_tag>( g.type() );
+
+    if ( tag.root == 2u )
+    {
+      if ( tag.adjoint != adjoint )
+      {
+        sdg( target );
+      }
+      else
+      {
+        s( target );
+      }
+    }
+    else if ( g.controls().empty() )
+    {
+      switch ( tag.axis )
+      {
+      case pauli_axis::X: x( target ); break;
+      case pauli_axis::Y: y( target ); break;
+      case pauli_axis::Z: z( target ); break;
+      }
+    }
+    else if ( tag.axis == pauli_axis::X )
+    {
+      controlled( [this, target]( unsigned c ) { cx( c, target ); } );
+    }
+    else
+    {
+      controlled( [this, target]( unsigned c ) { h( target ); cx( c, target ); h( target ); } );
+    }
+  }
+
+  return true;
+}
+
+bool clifford_tableau::apply( const circuit& circ, bool adjoint )
+{
+  if ( adjoint )
+  {
+    for ( auto it = circ.rbegin(); it != circ.rend(); ++it )
+    {
+      if ( !apply( *it, true ) ) { return false; }
+    }
+  }
+  else
+  {
+    for ( const auto& g : circ )
+    {
+      if ( !apply( g, false ) ) { return false; }
+    }
+  }
+  return true;
+}
+
+bool clifford_tableau::operator==( const clifford_tableau& other ) const
+{
+  return xs == other.xs && zs == other.zs && r == other.r;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,114 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file clifford_tableau.hpp
+ *
+ * @brief Stabilizer tableau of Clifford circuits
+ *
+ * Based on [S. Aaronson and D. Gottesman, Phys. Rev. A 70, 2004].
+ * The tableau stores the images of X_i and Z_i under conjugation with
+ * the circuit, two circuits have the same tableau if and only if they
+ * are equal up to a global phase.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef CLIFFORD_TABLEAU_HPP
+#define CLIFFORD_TABLEAU_HPP
+
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/gate.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @brief Checks whether a gate is one of X, Y, Z, H, S, S^dagger, CNOT
+ *        (with any control polarity), CZ, or SWAP
+ */
+bool is_clifford_gate( const gate& g );
+
+/**
+ * @brief Checks whether all gates in a circuit are Clifford gates
+ */
+bool is_clifford_circuit( const circuit& circ );
+
+/**
+ * @brief Tableau with one column of bits per qubit and one bit per row
+ *
+ * Rows 0, ..., n - 1 are the destabilizers X_i and rows n, ..., 2n - 1
+ * the stabilizers Z_i.  Since each column is a bitset over all 2n rows,
+ * a gate is applied to all rows with a few word operations.
+ */
+class clifford_tableau
+{
+public:
+  explicit clifford_tableau( unsigned qubits );
+
+  void h( unsigned a );
+  void s( unsigned a );
+  void sdg( unsigned a );
+  void x( unsigned a );
+  void y( unsigned a );
+  void z( unsigned a );
+  void cx( unsigned control, unsigned target );
+
+  /**
+   * @brief Applies a gate, returns false if it is not a Clifford gate
+   */
+  bool apply( const gate& g, bool adjoint = false );
+
+  /**
+   * @brief Applies a circuit (or its adjoint), returns false if it
+   *        contains a gate that is not a Clifford gate
+   */
+  bool apply( const circuit& circ, bool adjoint = false );
+
+  inline unsigned qubits() const { return xs.size(); }
+
+  bool operator==( const clifford_tableau& other ) const;
+  inline bool operator!=( const clifford_tableau& other ) const { return !( *this == other ); }
+
+private:
+  std::vector<boost::dynamic_bitset<>> xs;
+  std::vector<boost::dynamic_bitset<>> zs;
+  boost::dynamic_bitset<>              r;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -28,13 +28,16 @@
 
 #include <core/utils/timer.hpp>
 
+#include <reversible/compact_circuit.hpp>
 #include <reversible/gate.hpp>
 #include <reversible/target_tags.hpp>
 
 namespace cirkit
 {
 
-  boost::dynamic_bitset<>& core_gate_simulation::operator()( const gate& g, boost::dynamic_bitset<>& input ) const
+  /* shared by gate and compact_gate */
+  template<typename Gate>
+  boost::dynamic_bitset<>& simulate_core_gate( const Gate& g, boost::dynamic_bitset<>& input )
   {
     if ( is_toffoli( g ) )
     {
@@ -69,8 +72,8 @@ namespace cirkit
       if ( c_mask.none() || ( ( input & c_mask ) == c_mask ) )
       {
         // get both positions and values
-        unsigned t1 = g.targets().at( 0u );
-        unsigned t2 = g.targets().at( 1u );
+        unsigned t1 = g.targets()[0u];
+        unsigned t2 = g.targets()[1u];
 
         bool t1v = input.test( t1 );
         bool t2v = input.test( t2 );
@@ -90,8 +93,8 @@ namespace cirkit
       if ( input.test( g.controls().front().line() ) ) // is single control set
       {
         // get both positions and value of t1
-        unsigned t1 = g.targets().at( 0u );
-        unsigned t2 = g.targets().at( 1u );
+        unsigned t1 = g.targets()[0u];
+        unsigned t2 = g.targets()[1u];
 
         bool t1v = input.test( t1 );
 
@@ -166,6 +169,16 @@ namespace cirkit
     }
   }
 
+  boost::dynamic_bitset<>& core_gate_simulation::operator()( const gate& g, boost::dynamic_bitset<>& input ) const
+  {
+    return simulate_core_gate( g, input );
+  }
+
+  boost::dynamic_bitset<>& core_gate_simulation::operator()( const compact_gate& g, boost::dynamic_bitset<>& input ) const
+  {
+    return simulate_core_gate( g, input );
+  }
+
   bool simple_simulation( boost::dynamic_bitset<>& output, const gate& g, const boost::dynamic_bitset<>& input,
                           properties::ptr settings,
                           properties::ptr statistics )
@@ -213,6 +226,21 @@ namespace cirkit
     return simple_simulation( output, circ.begin(), circ.end(), input, settings, statistics );
   }
 
+  bool simple_simulation( boost::dynamic_bitset<>& output, const compact_circuit& circ, const boost::dynamic_bitset<>& input,
+                          properties::ptr statistics )
+  {
+    properties_timer t( statistics );
+
+    core_gate_simulation core_simulation;
+
+    output = input;
+    for ( const auto& g : circ )
+    {
+      core_simulation( g, output );
+    }
+    return true;
+  }
+
   simulation_func simple_simulation_func( properties::ptr settings, properties::ptr statistics )
   {
     simulation_func f = [&settings, &statistics]( boost::dynamic_bitset<>& output, const circuit& circ, const boost::dynamic_bitset<>& input ) {
@@ -47,6 +47,8 @@ namespace cirkit
 {
 
   class gate;
+  class compact_circuit;
+  class compact_gate;
 
   /**
    * @brief Functor for gate-wise simulation, used as a setting for \ref revkit::simple_simulation "simple_simulation"
@@ -146,6 +148,13 @@ namespace cirkit
      * @since 1.0
      */
     boost::dynamic_bitset<>& operator()( const gate& g, boost::dynamic_bitset<>& input ) const;
+
+    /**
+     * @brief Simulation for a gate view of a compact_circuit
+     *
+     * @since 2.4
+     */
+    boost::dynamic_bitset<>& operator()( const compact_gate& g, boost::dynamic_bitset<>& input ) const;
   };
 
   /**
@@ -333,6 +342,24 @@ namespace cirkit
    *
    * @since  1.0
    */
+  /**
+   * @brief Simple Simulation function for a compact circuit
+   *
+   * Gates are simulated on their views using
+   * \ref cirkit::core_gate_simulation "core_gate_simulation", no gate
+   * objects are created.
+   *
+   * @param output Output pattern. The index of the pattern corresponds to the line index.
+   * @param circ Circuit to be simulated
+   * @param input Input pattern. The index of the pattern corresponds to the line index.
+   * @param statistics Statistics (see \ref revkit::simple_simulation "simple_simulation")
+   * @return true on success
+   *
+   * @since  2.4
+   */
+  bool simple_simulation( boost::dynamic_bitset<>& output, const compact_circuit& circ, const boost::dynamic_bitset<>& input,
+                          properties::ptr statistics = properties::ptr() );
+
   simulation_func simple_simulation_func( properties::ptr settings = std::make_shared<properties>(), properties::ptr statistics = std::make_shared<properties>() );
 
 }
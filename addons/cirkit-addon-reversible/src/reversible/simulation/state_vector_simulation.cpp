@@ -0,0 +1,434 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "state_vector_simulation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include <reversible/gate.hpp>
+#include <reversible/pauli_tags.hpp>
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace detail
+{
+
+/* std::complex multiplication checks for NaN and infinity, which keeps
+ * the kernels from being vectorized */
+inline amplitude_t mul( const amplitude_t& a, const amplitude_t& b )
+{
+  return amplitude_t( a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real() );
+}
+
+/* states with fewer amplitudes are simulated in the calling thread */
+constexpr unsigned min_parallel_bits = 16u;
+
+template<typename Fn>
+void parallel_for( std::uint64_t num_tasks, unsigned num_threads, Fn&& fn )
+{
+  num_threads = static_cast<unsigned>( std::min<std::uint64_t>( num_threads, num_tasks ) );
+
+  if ( num_threads <= 1u )
+  {
+    for ( std::uint64_t task = 0u; task < num_tasks; ++task )
+    {
+      fn( task );
+    }
+    return;
+  }
+
+  std::atomic<std::uint64_t> next_task( 0u );
+  const auto work = [&]() {
+    std::uint64_t task;
+    while ( ( task = next_task++ ) < num_tasks )
+    {
+      fn( task );
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for ( auto i = 0u; i < num_threads; ++i )
+  {
+    threads.emplace_back( work );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+}
+
+/* U^{1/root} for a Pauli U, with eigenvalue -1 mapped to e^{i pi/root} */
+void pauli_root_matrix( pauli_axis axis, unsigned root, bool adjoint, amplitude_t* u )
+{
+  const amplitude_t I( 0.0, 1.0 );
+  amplitude_t p[4];
+  switch ( axis )
+  {
+  case pauli_axis::X: p[0] = 0.0; p[1] = 1.0; p[2] = 1.0;  p[3] = 0.0;  break;
+  case pauli_axis::Y: p[0] = 0.0; p[1] = -I;  p[2] = I;    p[3] = 0.0;  break;
+  case pauli_axis::Z: p[0] = 1.0; p[1] = 0.0; p[2] = 0.0;  p[3] = -1.0; break;
+  }
+
+  /* (I + P)/2 + w (I - P)/2 */
+  auto w = std::polar( 1.0, M_PI / root );
+  if ( adjoint )
+  {
+    w = std::conj( w );
+  }
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    const amplitude_t id = ( i == 0u || i == 3u ) ? 1.0 : 0.0;
+    u[i] = 0.5 * ( id + p[i] ) + w * 0.5 * ( id - p[i] );
+  }
+
+  /* keep exact zeros and ones, e.g., for S and T */
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    if ( std::abs( u[i].real() ) < 1e-15 ) { u[i].real( 0.0 ); }
+    if ( std::abs( u[i].imag() ) < 1e-15 ) { u[i].imag( 0.0 ); }
+  }
+}
+
+}
+
+void state_vector_simulator::compile( const circuit& circ, const std::vector<unsigned>& line_map, std::uint64_t control_mask, std::uint64_t control_value, std::vector<kernel>& out ) const
+{
+  for ( const auto& g : circ )
+  {
+    auto mask = control_mask, value = control_value;
+    if ( !is_stg( g ) )
+    {
+      for ( const auto& c : g.controls() )
+      {
+        const auto bit = 1ull << line_map[c.line()];
+        mask |= bit;
+        if ( c.polarity() )
+        {
+          value |= bit;
+        }
+      }
+    }
+
+    const auto x = [&]( unsigned target, std::uint64_t m, std::uint64_t v ) {
+      kernel k;
+      k.type = kernel_t::x;
+      k.target = target;
+      k.control_mask = m;
+      k.control_value = v;
+      out.push_back( k );
+    };
+
+    if ( is_toffoli( g ) )
+    {
+      x( line_map[g.targets().front()], mask, value );
+    }
+    else if ( is_fredkin( g ) )
+    {
+      /* swap(a, b) = CNOT(b, a) CNOT(a, b) CNOT(b, a), only the middle one needs the controls */
+      const auto a = line_map[g.targets()[0u]], b = line_map[g.targets()[1u]];
+      x( a, control_mask | ( 1ull << b ), control_value | ( 1ull << b ) );
+      x( b, mask | ( 1ull << a ), value | ( 1ull << a ) );
+      x( a, control_mask | ( 1ull << b ), control_value | ( 1ull << b ) );
+    }
+    else if ( is_peres( g ) )
+    {
+      /* t2 ^= c & t1, then t1 ^= c */
+      const auto t1 = line_map[g.targets()[0u]], t2 = line_map[g.targets()[1u]];
+      x( t2, mask | ( 1ull << t1 ), value | ( 1ull << t1 ) );
+      x( t1, mask, value );
+    }
+    else if ( is_stg( g ) )
+    {
+      const auto& function = boost::any_cast<stg_tag>( g.type() ).function;
+      for ( auto m = 0u; m < function.size(); ++m )
+      {
+        if ( !function.test( m ) ) { continue; }
+
+        auto mm = mask, mv = value;
+        for ( auto i = 0u; i < g.controls().size(); ++i )
+        {
+          const auto bit = 1ull << line_map[g.controls()[i].line()];
+          mm |= bit;
+          if ( ( m >> i ) & 1u )
+          {
+            mv |= bit;
+          }
+        }
+        x( line_map[g.targets().front()], mm, mv );
+      }
+    }
+    else if ( is_module( g ) )
+    {
+      const auto* tag = boost::any_cast<module_tag>( &g.type() );
+
+      std::vector<unsigned> inner_map;
+      for ( const auto& t : g.targets() )
+      {
+        inner_map.push_back( line_map[t] );
+      }
+      compile( *tag->reference, inner_map, mask, value, out );
+    }
+    else if ( is_hadamard( g ) )
+    {
+      kernel k;
+      k.type = kernel_t::unitary;
+      k.target = line_map[g.targets().front()];
+      k.control_mask = mask;
+      k.control_value = value;
+      k.u[0] = k.u[1] = k.u[2] = M_SQRT1_2;
+      k.u[3] = -M_SQRT1_2;
+      out.push_back( k );
+    }
+    else if ( is_pauli( g ) )
+    {
+      const auto& tag = boost::any_cast<pauli_tag>( g.type() );
+
+      if ( tag.axis == pauli_axis::X && tag.root == 1u )
+      {
+        x( line_map[g.targets().front()], mask, value );
+        continue;
+      }
+
+      kernel k;
+      k.type = tag.axis == pauli_axis::Z ? kernel_t::diagonal : kernel_t::unitary;
+      k.target = line_map[g.targets().front()];
+      k.control_mask = mask;
+      k.control_value = value;
+      detail::pauli_root_matrix( tag.axis, tag.root, tag.adjoint, k.u );
+      out.push_back( k );
+    }
+    else
+    {
+      std::cout << "[w] unsupported gate" << std::endl;
+    }
+  }
+}
+
+/* applies k to the amplitude pairs with indexes [begin, end), pair p
+ * consists of amplitudes i and i + 2^target where i is p with a zero
+ * inserted at bit target */
+void state_vector_simulator::apply_kernel( const kernel& k, amplitude_t* amplitudes, std::uint64_t begin, std::uint64_t end )
+{
+  const std::uint64_t stride = 1ull << k.target;
+  const auto low_mask  = k.control_mask & ( stride - 1u );
+  const auto high_mask = k.control_mask & ~( stride - 1u );
+  const auto u0 = k.u[0], u1 = k.u[1], u2 = k.u[2], u3 = k.u[3];
+
+  for ( auto p = begin; p < end; )
+  {
+    const auto offset = p & ( stride - 1u );
+    const auto i0     = ( ( p >> k.target ) << ( k.target + 1u ) ) | offset;
+    const auto run    = std::min( end - p, stride - offset );
+    p += run;
+
+    /* controls above the target are the same for the whole run */
+    if ( ( i0 & high_mask ) != ( k.control_value & high_mask ) ) { continue; }
+
+    auto* lo = amplitudes + i0;
+    auto* hi = lo + stride;
+
+    const auto enabled = [&]( std::uint64_t j ) {
+      return low_mask == 0u || ( ( i0 + j ) & low_mask ) == ( k.control_value & low_mask );
+    };
+
+    switch ( k.type )
+    {
+    case kernel_t::x:
+      for ( std::uint64_t j = 0u; j < run; ++j )
+      {
+        if ( enabled( j ) ) { std::swap( lo[j], hi[j] ); }
+      }
+      break;
+
+    case kernel_t::diagonal:
+      for ( std::uint64_t j = 0u; j < run; ++j )
+      {
+        if ( enabled( j ) )
+        {
+          lo[j] = detail::mul( u0, lo[j] );
+          hi[j] = detail::mul( u3, hi[j] );
+        }
+      }
+      break;
+
+    case kernel_t::unitary:
+      for ( std::uint64_t j = 0u; j < run; ++j )
+      {
+        if ( enabled( j ) )
+        {
+          const auto a = lo[j], b = hi[j];
+          lo[j] = detail::mul( u0, a ) + detail::mul( u1, b );
+          hi[j] = detail::mul( u2, a ) + detail::mul( u3, b );
+        }
+      }
+      break;
+    }
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+state_vector create_basis_state( unsigned qubits, std::uint64_t index )
+{
+  state_vector state( 1ull << qubits );
+  state[index] = 1.0;
+  return state;
+}
+
+state_vector create_random_state( unsigned qubits, std::mt19937& gen )
+{
+  std::normal_distribution<double> dist;
+
+  state_vector state( 1ull << qubits );
+  auto norm = 0.0;
+  for ( auto& a : state )
+  {
+    a = amplitude_t( dist( gen ), dist( gen ) );
+    norm += std::norm( a );
+  }
+
+  norm = 1.0 / std::sqrt( norm );
+  for ( auto& a : state )
+  {
+    a *= norm;
+  }
+  return state;
+}
+
+state_vector_simulator::state_vector_simulator( const circuit& circ, bool adjoint )
+{
+  append( circ, adjoint );
+}
+
+void state_vector_simulator::append( const circuit& circ, bool adjoint )
+{
+  _lines = std::max( _lines, circ.lines() );
+
+  std::vector<unsigned> line_map( circ.lines() );
+  std::iota( line_map.begin(), line_map.end(), 0u );
+
+  std::vector<kernel> gate_kernels;
+  compile( circ, line_map, 0u, 0u, gate_kernels );
+
+  if ( adjoint )
+  {
+    /* reverse order and take the adjoint of every kernel, X is self-inverse */
+    std::reverse( gate_kernels.begin(), gate_kernels.end() );
+    for ( auto& k : gate_kernels )
+    {
+      const auto u1 = k.u[1];
+      k.u[0] = std::conj( k.u[0] );
+      k.u[1] = std::conj( k.u[2] );
+      k.u[2] = std::conj( u1 );
+      k.u[3] = std::conj( k.u[3] );
+    }
+  }
+
+  kernels.insert( kernels.end(), gate_kernels.begin(), gate_kernels.end() );
+}
+
+void state_vector_simulator::simulate( state_vector& state, unsigned num_threads, unsigned block_bits ) const
+{
+  assert( !state.empty() && ( state.size() & ( state.size() - 1u ) ) == 0u );
+  assert( state.size() >= ( 1ull << _lines ) );
+
+  const auto qubits = static_cast<unsigned>( std::log2( state.size() ) );
+  if ( qubits == 0u || kernels.empty() ) { return; }
+
+  block_bits = std::max( 1u, std::min( block_bits, qubits ) );
+  const std::uint64_t pairs_per_block = 1ull << ( block_bits - 1u );
+  const std::uint64_t num_blocks      = 1ull << ( qubits - block_bits );
+
+  if ( num_threads == 0u )
+  {
+    num_threads = std::max( 1u, std::thread::hardware_concurrency() );
+  }
+  if ( qubits < detail::min_parallel_bits )
+  {
+    num_threads = 1u;
+  }
+
+  auto* amplitudes = state.data();
+
+  /* runs kernels [first, last) block by block; kernels with a target
+   * outside the block are run on their own over all pairs */
+  const auto run_kernels = [&]( std::size_t first, std::size_t last ) {
+    detail::parallel_for( num_blocks, num_threads, [&]( std::uint64_t block ) {
+        for ( auto i = first; i < last; ++i )
+        {
+          apply_kernel( kernels[i], amplitudes, block * pairs_per_block, ( block + 1u ) * pairs_per_block );
+        }
+      } );
+  };
+
+  std::size_t first = 0u;
+  for ( std::size_t i = 0u; i < kernels.size(); ++i )
+  {
+    if ( kernels[i].target >= block_bits )
+    {
+      if ( first < i )
+      {
+        run_kernels( first, i );
+      }
+      run_kernels( i, i + 1u );
+      first = i + 1u;
+    }
+  }
+  if ( first < kernels.size() )
+  {
+    run_kernels( first, kernels.size() );
+  }
+}
+
+void state_vector_simulation( state_vector& state, const circuit& circ, unsigned num_threads )
+{
+  state_vector_simulator( circ ).simulate( state, num_threads );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
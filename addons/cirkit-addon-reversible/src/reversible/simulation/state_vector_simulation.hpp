@@ -0,0 +1,133 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file state_vector_simulation.hpp
+ *
+ * @brief In-place state vector simulation of quantum circuits
+ *
+ * Amplitude i belongs to the basis state in which line j has the value
+ * of bit j of i.  Every gate is compiled into kernels that update pairs
+ * of amplitudes which differ in the target bit; the pairs are visited in
+ * contiguous runs of length 2^target.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef STATE_VECTOR_SIMULATION_HPP
+#define STATE_VECTOR_SIMULATION_HPP
+
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+using amplitude_t  = std::complex<double>;
+using state_vector = std::vector<amplitude_t>;
+
+/**
+ * @brief State |index> on `qubits' qubits
+ */
+state_vector create_basis_state( unsigned qubits, std::uint64_t index );
+
+/**
+ * @brief Normalized state with Gaussian distributed amplitudes
+ */
+state_vector create_random_state( unsigned qubits, std::mt19937& gen );
+
+/**
+ * @brief Circuits compiled into amplitude kernels
+ *
+ * Supported are Toffoli, Fredkin, Peres, STG, and module gates as well
+ * as Hadamard and Pauli(-root) gates, all with arbitrary (mixed
+ * polarity) controls.  Fredkin gates are compiled into three controlled
+ * NOTs, STG gates into one controlled NOT per minterm, and modules are
+ * inlined.  Other gates are skipped with a warning.
+ */
+class state_vector_simulator
+{
+public:
+  state_vector_simulator() {}
+  explicit state_vector_simulator( const circuit& circ, bool adjoint = false );
+
+  /**
+   * @brief Appends the gates of `circ' (or of its adjoint) to the end
+   */
+  void append( const circuit& circ, bool adjoint = false );
+
+  /**
+   * @brief Applies all gates to `state' in place
+   *
+   * The size of `state' must be a power of two and cover all lines.
+   * Consecutive kernels whose target is below `block_bits' are applied
+   * block by block to slices of 2^block_bits amplitudes, such that a
+   * slice stays in cache for the whole run.  Blocks are distributed to
+   * `num_threads' threads (0: number of cores) if the state is large
+   * enough.
+   */
+  void simulate( state_vector& state, unsigned num_threads = 1u, unsigned block_bits = 14u ) const;
+
+  inline unsigned lines() const { return _lines; }
+  inline std::size_t num_kernels() const { return kernels.size(); }
+
+private:
+  enum class kernel_t { x, diagonal, unitary };
+
+  struct kernel
+  {
+    kernel_t      type;
+    unsigned      target;
+    std::uint64_t control_mask;
+    std::uint64_t control_value;
+    amplitude_t   u[4];          /* row-major 2x2 matrix */
+  };
+
+  void compile( const circuit& circ, const std::vector<unsigned>& line_map, std::uint64_t control_mask, std::uint64_t control_value, std::vector<kernel>& out ) const;
+  static void apply_kernel( const kernel& k, amplitude_t* amplitudes, std::uint64_t begin, std::uint64_t end );
+
+  unsigned            _lines = 0u;
+  std::vector<kernel> kernels;
+};
+
+/**
+ * @brief Applies `circ' to `state' in place
+ */
+void state_vector_simulation( state_vector& state, const circuit& circ, unsigned num_threads = 1u );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -27,6 +27,11 @@
 #include "lhrs.hpp"
 
 #include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
@@ -40,6 +45,7 @@
 #include <core/utils/range_utils.hpp>
 #include <core/utils/temporary_filename.hpp>
 #include <core/utils/terminal.hpp>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/linear_classification.hpp>
 #include <classical/functions/spectral_canonization.hpp>
@@ -48,6 +54,7 @@
 #include <classical/utils/truth_table_utils.hpp>
 #include <classical/xmg/xmg_cover.hpp>
 #include <classical/xmg/xmg_extract.hpp>
+#include <classical/xmg/xmg_simulate.hpp>
 #include <reversible/gate.hpp>
 #include <reversible/target_tags.hpp>
 #include <reversible/functions/add_circuit.hpp>
@@ -56,6 +63,8 @@
 #include <reversible/functions/circuit_from_string.hpp>
 #include <reversible/functions/clear_circuit.hpp>
 #include <reversible/io/print_circuit.hpp>
+#include <reversible/synthesis/optimal_quantum_circuits.hpp>
+#include <reversible/synthesis/lhrs/lut_circuit_cache.hpp>
 #include <reversible/synthesis/lhrs/stg_map_esop.hpp>
 #include <reversible/synthesis/lhrs/stg_map_precomp.hpp>
 #include <reversible/utils/circuit_utils.hpp>
@@ -417,8 +426,13 @@ public:
       params( params ),
       stats( stats ),
       order_heuristic( std::make_shared<defer_lut_order_heuristic>( xmg, params.additional_ancilla ) ),
-      pbar( "[i] step %5d/%5d   dd = %5d   ld = %5d   cvr = %6.2f   esop = %6.2f   map = %6.2f   clsfy = %6.2f   total = %6.2f", params.progress )
+      pbar( "[i] step %5d/%5d   dd = %5d   ld = %5d   cvr = %6.2f   esop = %6.2f   map = %6.2f   clsfy = %6.2f   total = %6.2f", params.progress ),
+      esop_params( params.map_esop_params )
   {
+    if ( params.use_cache )
+    {
+      cache = shared_lut_circuit_cache( "luts" );
+    }
   }
 
   bool run()
@@ -427,6 +441,7 @@ public:
 
     const auto lines = order_heuristic->compute_steps();
     circ.set_lines( lines );
+    num_lines = lines;
 
     std::vector<std::string> inputs( lines, "0" );
     std::vector<std::string> outputs( lines, "0" );
@@ -435,6 +450,24 @@ public:
 
     std::unordered_map<unsigned, lut_order_heuristic::step_type> orig_step_type; /* first step type of an output */
 
+    /* LUTs are synthesized ahead in a thread pool and appended in step order */
+    std::unique_ptr<thread_pool> pool;
+    if ( use_jobs() )
+    {
+      prepare_jobs();
+
+      const auto num_threads = params.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : params.num_threads;
+      if ( num_threads > 1u && jobs.size() > 1u )
+      {
+        esop_params.progress = false;
+        pool.reset( new thread_pool( num_threads ) );
+        for ( auto i = 0u; i < jobs.size(); ++i )
+        {
+          job_futures[i] = pool->enqueue( [this, i]() { return run_job( jobs[i] ); } );
+        }
+      }
+    }
+
     auto step_index = 0u;
     pbar.keep_last();
     for ( const auto& step : order_heuristic->steps() )
@@ -493,21 +526,18 @@ public:
         break;
 
       case lut_order_heuristic::compute:
-        if ( !params.onlylines )
-        {
-          synthesize_node( step.node, false, step.clean_ancilla );
-        }
-        break;
-
       case lut_order_heuristic::uncompute:
         if ( !params.onlylines )
         {
-          synthesize_node( step.node, true, step.clean_ancilla );
+          synthesize_node( step_index - 1u, step );
         }
         break;
       }
     }
 
+    pool.reset();
+    merge_job_stats();
+
     circ.set_inputs( inputs );
     circ.set_outputs( outputs );
     circ.set_constants( constants );
@@ -517,6 +547,208 @@ public:
   }
 
 private:
+  /* a LUT function to synthesize, shared by all steps with the same function */
+  struct lut_job
+  {
+    xmg_graph   lut;
+    unsigned    num_ancilla;
+    std::string key;
+    bool        cached = false; /* circuit was taken from the cache */
+  };
+
+  /* LUTs are synthesized independently of the circuit, except for the Shannon
+     strategy which uses dirty ancillae, and the debug options that write files */
+  inline bool use_jobs() const
+  {
+    return !params.onlylines && params.mapping_strategy != lhrs_mapping_strategy::shannon &&
+           params.map_esop_params.dumpfile.empty() && !params.map_esop_params.nocollapse;
+  }
+
+  /* small LUTs are mapped directly into single-target gates, then the circuit
+     does not depend on the number of clean ancillae */
+  bool uses_ancilla( const xmg_graph& lut ) const
+  {
+    const auto num_inputs = lut.inputs().size();
+
+    switch ( params.mapping_strategy )
+    {
+    case lhrs_mapping_strategy::lut_based_min_db:
+    case lhrs_mapping_strategy::lut_based_best_fit:
+      return static_cast<int>( num_inputs ) > lut_based_max_cut_size();
+    case lhrs_mapping_strategy::lut_based_pick_best:
+      return num_inputs > 4u;
+    default:
+      return false;
+    }
+  }
+
+  /* costs of candidates depend on the number of lines, therefore a LUT is
+     synthesized into a circuit with as many lines as the whole circuit */
+  inline unsigned job_lines( unsigned num_inputs, unsigned num_ancilla ) const
+  {
+    return std::max( num_lines, num_inputs + 1u + num_ancilla );
+  }
+
+  std::string lut_key( const xmg_graph& lut, unsigned num_ancilla ) const
+  {
+    xmg_tt_simulator sim;
+    const auto func = simulate_xmg_function( lut, lut.outputs().front().first, sim );
+    const unsigned num_inputs = lut.inputs().size();
+
+    return boost::str( boost::format( "%s:%d:%d:%s:%d:%d:%d:%d:%d:%d:%d:%s" )
+                       % params.mapping_strategy % params.max_func_size % params.map_precomp_params.class_method
+                       % params.map_esop_params.script % params.map_esop_params.optimize_postesop
+                       % params.map_luts_params.satlut % params.map_luts_params.area_iters % params.map_luts_params.flow_iters
+                       % num_inputs % num_ancilla % job_lines( num_inputs, num_ancilla ) % tt_to_hex( func ) );
+  }
+
+  void prepare_jobs()
+  {
+    const auto& steps = order_heuristic->steps();
+    std::unordered_map<std::string, unsigned> key_to_job;
+
+    step_to_job.assign( steps.size(), -1 );
+
+    for ( const auto& p : index( steps ) )
+    {
+      const auto& step = p.value;
+      if ( step.type != lut_order_heuristic::compute && step.type != lut_order_heuristic::uncompute ) continue;
+
+      auto lut = xmg_extract_lut( xmg, step.node );
+      const auto num_ancilla = uses_ancilla( lut ) ? static_cast<unsigned>( step.clean_ancilla.size() ) : 0u;
+
+      std::string key;
+      if ( cache )
+      {
+        key = lut_key( lut, num_ancilla );
+
+        const auto it = key_to_job.find( key );
+        if ( it != key_to_job.end() )
+        {
+          step_to_job[p.index] = it->second;
+          continue;
+        }
+        key_to_job.insert( {key, jobs.size()} );
+      }
+
+      step_to_job[p.index] = jobs.size();
+      jobs.push_back( {std::move( lut ), num_ancilla, key} );
+    }
+
+    job_futures.resize( jobs.size() );
+    job_results.resize( jobs.size() );
+  }
+
+  lut_circuit_cache::entry_t run_job( lut_job& job )
+  {
+    if ( cache )
+    {
+      if ( const auto entry = cache->lookup( job.key ) )
+      {
+        job.cached = true;
+        job.lut = xmg_graph();
+        return entry;
+      }
+    }
+
+    /* synthesize into local lines: LUT inputs, target, and ancillae */
+    const unsigned num_inputs = job.lut.inputs().size();
+    std::vector<unsigned> line_map( num_inputs + 1u ), ancillas( job.num_ancilla );
+    std::iota( line_map.begin(), line_map.end(), 0u );
+    std::iota( ancillas.begin(), ancillas.end(), num_inputs + 1u );
+
+    const auto entry = std::make_shared<lut_circuit>();
+    entry->circ = get_fast_circuit( job_lines( num_inputs, job.num_ancilla ) );
+
+    auto* local_stats = acquire_job_stats();
+    entry->decomposed = synthesize_lut( entry->circ, job.lut, line_map, ancillas, *local_stats );
+    release_job_stats( local_stats );
+
+    job.lut = xmg_graph();
+    return cache ? cache->insert( job.key, entry ) : entry;
+  }
+
+  const lut_circuit& job_result( unsigned index )
+  {
+    auto& result = job_results[index];
+    if ( result )
+    {
+      ++stats.num_luts_reused;
+      return *result;
+    }
+
+    if ( job_futures[index].valid() )
+    {
+      result = job_futures[index].get();
+    }
+    else
+    {
+      const auto sp = pbar.subprogress();
+      result = run_job( jobs[index] );
+    }
+
+    if ( jobs[index].cached )
+    {
+      ++stats.num_luts_reused;
+    }
+    else
+    {
+      ++stats.num_luts_synthesized;
+    }
+    return *result;
+  }
+
+  lhrs_stats* acquire_job_stats()
+  {
+    std::lock_guard<std::mutex> lock( job_stats_mutex );
+    if ( free_job_stats.empty() )
+    {
+      job_stats.emplace_back( new lhrs_stats() );
+      return job_stats.back().get();
+    }
+
+    const auto local_stats = free_job_stats.back();
+    free_job_stats.pop_back();
+    return local_stats;
+  }
+
+  void release_job_stats( lhrs_stats* local_stats )
+  {
+    std::lock_guard<std::mutex> lock( job_stats_mutex );
+    free_job_stats.push_back( local_stats );
+  }
+
+  /* class counters are not merged, since they are counted when circuits are appended */
+  void merge_job_stats()
+  {
+    for ( const auto& local_stats : job_stats )
+    {
+      stats.map_esop_stats.cover_runtime += local_stats->map_esop_stats.cover_runtime;
+      stats.map_esop_stats.exorcism_runtime += local_stats->map_esop_stats.exorcism_runtime;
+      stats.map_luts_stats.mapping_runtime += local_stats->map_luts_stats.mapping_runtime;
+      stats.map_precomp_stats.class_runtime += local_stats->map_precomp_stats.class_runtime;
+
+      for ( const auto& p : index( local_stats->map_precomp_stats.class_hash ) )
+      {
+        stats.map_precomp_stats.class_hash[p.index].insert( p.value.begin(), p.value.end() );
+      }
+    }
+    job_stats.clear();
+    free_job_stats.clear();
+  }
+
+  void count_classes( const circuit& lut_circ )
+  {
+    for ( const auto& g : lut_circ )
+    {
+      if ( !is_stg( g ) ) continue;
+
+      const auto num_vars = g.controls().size();
+      const auto cfunc = boost::any_cast<stg_tag>( g.type() ).affine_class.to_ulong();
+      ++stats.map_precomp_stats.class_counter[num_vars - 2u][optimal_quantum_circuits::spectral_classification_index[num_vars - 2u].at( cfunc )];
+    }
+  }
+
   boost::dynamic_bitset<> get_affected_lines( unsigned begin, unsigned end )
   {
     boost::dynamic_bitset<> mask( circ.lines() );
@@ -529,27 +761,30 @@ private:
     return mask;
   }
 
-  inline void synthesize_node( int index, bool lookup, const std::vector<unsigned>& clean_ancilla )
+  void synthesize_node( unsigned step_index, const lut_order_heuristic::step& step )
   {
     /* track costs */
     const auto begin = circ.num_gates();
-    const auto line_map = order_heuristic->compute_line_map( index );
+    const auto line_map = order_heuristic->compute_line_map( step.node );
 
-    switch ( params.mapping_strategy )
+    if ( use_jobs() )
     {
-    case lhrs_mapping_strategy::direct:
-      synthesize_node_direct( index, lookup, line_map, clean_ancilla );
-      break;
-    case lhrs_mapping_strategy::lut_based_min_db:
-    case lhrs_mapping_strategy::lut_based_best_fit:
-      synthesize_node_lut_based( index, lookup, line_map, clean_ancilla );
-      break;
-    case lhrs_mapping_strategy::lut_based_pick_best:
-      synthesize_node_pick_best( index, lookup, line_map, clean_ancilla );
-      break;
-    case lhrs_mapping_strategy::shannon:
-      synthesize_node_shannon( index, lookup, line_map, clean_ancilla );
-      break;
+      const auto& result = job_result( step_to_job[step_index] );
+      append_lut_circuit( circ, result.circ, line_map, step.clean_ancilla );
+      count_classes( result.circ );
+      if ( result.decomposed )
+      {
+        ++stats.num_decomp_lut;
+      }
+    }
+    else
+    {
+      const auto lut = xmg_extract_lut( xmg, step.node );
+      const auto sp = pbar.subprogress();
+      if ( synthesize_lut( circ, lut, line_map, step.clean_ancilla, stats ) )
+      {
+        ++stats.num_decomp_lut;
+      }
     }
 
     /* track costs */
@@ -559,89 +794,116 @@ private:
       stats.gate_costs.push_back( costs( circ, begin, end, costs_by_gate_func( t_costs() ) ) );
       stats.line_maps.push_back( line_map );
       stats.affected_lines.push_back( get_index_vector( get_affected_lines( begin, end ) ) );
-      stats.clean_ancillas.push_back( clean_ancilla );
+      stats.clean_ancillas.push_back( step.clean_ancilla );
     }
   }
 
-  void synthesize_node_direct( int index, bool lookup, const std::vector<unsigned>& line_map, const std::vector<unsigned>& clean_ancilla )
+  /* synthesizes lut into lcirc, returns true if the LUT was decomposed into smaller LUTs */
+  bool synthesize_lut( circuit& lcirc, const xmg_graph& lut, const std::vector<unsigned>& line_map, const std::vector<unsigned>& clean_ancilla, lhrs_stats& lstats ) const
   {
-    const auto lut = xmg_extract_lut( xmg, index );
+    switch ( params.mapping_strategy )
+    {
+    case lhrs_mapping_strategy::direct:
+      stg_map_esop( lcirc, lut, line_map, esop_params, lstats.map_esop_stats );
+      return false;
+    case lhrs_mapping_strategy::lut_based_min_db:
+    case lhrs_mapping_strategy::lut_based_best_fit:
+      synthesize_lut_lut_based( lcirc, lut, line_map, clean_ancilla, lstats );
+      return false;
+    case lhrs_mapping_strategy::lut_based_pick_best:
+      return synthesize_lut_pick_best( lcirc, lut, line_map, clean_ancilla, lstats );
+    case lhrs_mapping_strategy::shannon:
+      {
+        const auto map_luts_params = get_map_luts_params();
+        const stg_map_shannon_params map_shannon_params( map_luts_params );
+        stg_map_shannon( lcirc, lut, line_map, clean_ancilla, map_shannon_params, lstats.map_shannon_stats );
+      }
+      return false;
+    }
 
-    const auto sp = pbar.subprogress();
-    stg_map_esop( circ, lut, line_map, params.map_esop_params, stats.map_esop_stats );
+    return false;
   }
 
-  void synthesize_node_lut_based( int index, bool lookup, const std::vector<unsigned>& line_map, const std::vector<unsigned>& clean_ancilla )
+  /* LUT mapping parameters refer to the (possibly modified) ESOP parameters of this manager */
+  stg_map_luts_params get_map_luts_params() const
   {
-    const auto lut = xmg_extract_lut( xmg, index );
+    stg_map_luts_params map_luts_params( esop_params, params.map_precomp_params );
+    map_luts_params.max_cut_size = params.map_luts_params.max_cut_size;
+    map_luts_params.strategy     = params.map_luts_params.strategy;
+    map_luts_params.satlut       = params.map_luts_params.satlut;
+    map_luts_params.area_iters   = params.map_luts_params.area_iters;
+    map_luts_params.flow_iters   = params.map_luts_params.flow_iters;
+    return map_luts_params;
+  }
 
+  inline int lut_based_max_cut_size() const
+  {
     if ( params.max_func_size == 0u )
     {
-      params.map_luts_params.max_cut_size = params.map_precomp_params.class_method == 0u ? 5 : 4;
+      return params.map_precomp_params.class_method == 0u ? 5 : 4;
     }
     else
     {
-      params.map_luts_params.max_cut_size = params.max_func_size;
+      return params.max_func_size;
     }
+  }
+
+  void synthesize_lut_lut_based( circuit& lcirc, const xmg_graph& lut, const std::vector<unsigned>& line_map, const std::vector<unsigned>& clean_ancilla, lhrs_stats& lstats ) const
+  {
+    auto map_luts_params = get_map_luts_params();
+    map_luts_params.max_cut_size = lut_based_max_cut_size();
 
-    const auto sp = pbar.subprogress();
-    stg_map_luts( circ, lut, line_map, clean_ancilla, params.map_luts_params, stats.map_luts_stats );
+    stg_map_luts( lcirc, lut, line_map, clean_ancilla, map_luts_params, lstats.map_luts_stats );
   }
 
-  inline void append_circuit_fast( const circuit& src )
+  inline void append_circuit_fast( circuit& dest, const circuit& src ) const
   {
-    auto& dest_s = boost::get<standard_circuit>( static_cast<circuit_variant&>( circ ) );
+    auto& dest_s = boost::get<standard_circuit>( static_cast<circuit_variant&>( dest ) );
     const auto& src_s = boost::get<standard_circuit>( static_cast<const circuit_variant&>( src ) );
 
     boost::push_back( dest_s.gates, src_s.gates );
   }
 
-  inline circuit get_fast_circuit() const
+  inline circuit get_fast_circuit( unsigned lines ) const
   {
     standard_circuit c;
-    c.lines = circ.lines();
+    c.lines = lines;
     return c;
   }
 
-  void synthesize_node_pick_best( int index, bool lookup, const std::vector<unsigned>& line_map, const std::vector<unsigned>& clean_ancilla )
+  bool synthesize_lut_pick_best( circuit& lcirc, const xmg_graph& lut, const std::vector<unsigned>& line_map, const std::vector<unsigned>& clean_ancilla, lhrs_stats& lstats ) const
   {
     using candidate_t = std::pair<circuit, cost_t>;
     std::vector<candidate_t> candidates;
 
-    const auto lut = xmg_extract_lut( xmg, index );
-
-    const auto sp = pbar.subprogress();
-
-    const auto old_strategy = params.map_luts_params.strategy;
+    auto map_luts_params = get_map_luts_params();
     for ( const auto& strategy : {stg_map_luts_params::mapping_strategy::mindb, stg_map_luts_params::mapping_strategy::bestfit} )
     {
       /* cut size 4 */
-      params.map_luts_params.strategy = strategy;
+      map_luts_params.strategy = strategy;
       {
-        auto lcirc = get_fast_circuit();
-        params.map_luts_params.max_cut_size = 4;
-        stg_map_luts( lcirc, lut, line_map, clean_ancilla, params.map_luts_params, stats.map_luts_stats );
-        if ( lcirc.num_gates() )
+        auto ccirc = get_fast_circuit( lcirc.lines() );
+        map_luts_params.max_cut_size = 4;
+        stg_map_luts( ccirc, lut, line_map, clean_ancilla, map_luts_params, lstats.map_luts_stats );
+        if ( ccirc.num_gates() )
         {
-          candidates.push_back( {lcirc, costs( lcirc, costs_by_gate_func( t_costs() ) )} );
+          candidates.push_back( {ccirc, costs( ccirc, costs_by_gate_func( t_costs() ) )} );
         }
       }
 
       /* cut size 5 */
       if ( params.map_precomp_params.class_method == 0u )
       {
-        auto lcirc = get_fast_circuit();
-        params.map_luts_params.max_cut_size = 5;
-        stg_map_luts( lcirc, lut, line_map, clean_ancilla, params.map_luts_params, stats.map_luts_stats );
-        if ( lcirc.num_gates() )
+        auto ccirc = get_fast_circuit( lcirc.lines() );
+        map_luts_params.max_cut_size = 5;
+        stg_map_luts( ccirc, lut, line_map, clean_ancilla, map_luts_params, lstats.map_luts_stats );
+        if ( ccirc.num_gates() )
         {
-          candidates.push_back( {lcirc, costs( lcirc, costs_by_gate_func( t_costs() ) )} );
+          candidates.push_back( {ccirc, costs( ccirc, costs_by_gate_func( t_costs() ) )} );
         }
       }
     }
 
-    params.map_luts_params.strategy = old_strategy;
-
     if ( !candidates.empty() )
     {
       const auto best_candidate = std::min_element( candidates.begin(), candidates.end(),
@@ -649,23 +911,14 @@ private:
                                                       return c1.second < c2.second;
                                                     } );
 
-      append_circuit_fast( best_candidate->first );
-      ++stats.num_decomp_lut;
-      return;
+      append_circuit_fast( lcirc, best_candidate->first );
+      return true;
     }
 
-    stg_map_esop( circ, lut, line_map, params.map_esop_params, stats.map_esop_stats );
-  }
-
-  void synthesize_node_shannon( int index, bool lookup, const std::vector<unsigned>& line_map, const std::vector<unsigned>& clean_ancilla )
-  {
-    const auto lut = xmg_extract_lut( xmg, index );
-
-    const auto sp = pbar.subprogress();
-    stg_map_shannon( circ, lut, line_map, clean_ancilla, params.map_shannon_params, stats.map_shannon_stats );
+    stg_map_esop( lcirc, lut, line_map, esop_params, lstats.map_esop_stats );
+    return false;
   }
 
-
 private:
   circuit& circ;
   const xmg_graph& xmg;
@@ -673,11 +926,23 @@ private:
   const lhrs_params& params;
   lhrs_stats& stats;
 
-  std::unordered_map<unsigned, circuit> computed_circuits;
-
   std::shared_ptr<lut_order_heuristic> order_heuristic;
 
   progress_line pbar;
+
+  stg_map_esop_params esop_params;
+  unsigned num_lines = 0u;
+
+  /* LUT jobs */
+  lut_circuit_cache::ptr                                   cache;
+  std::vector<lut_job>                                     jobs;
+  std::vector<int>                                         step_to_job;
+  std::vector<std::future<lut_circuit_cache::entry_t>>     job_futures;
+  std::vector<lut_circuit_cache::entry_t>                  job_results;
+
+  std::mutex                                               job_stats_mutex;
+  std::vector<std::unique_ptr<lhrs_stats>>                 job_stats;
+  std::vector<lhrs_stats*>                                 free_job_stats;
 };
 
 /******************************************************************************
@@ -692,6 +957,11 @@ bool lut_based_synthesis( circuit& circ, const xmg_graph& xmg, const lhrs_params
   lut_based_synthesis_manager mgr( circ, xmg, params, stats );
   const auto result = mgr.run();
 
+  if ( params.use_cache )
+  {
+    shared_lut_circuit_cache( "luts" )->persist();
+  }
+
   return result;
 }
 
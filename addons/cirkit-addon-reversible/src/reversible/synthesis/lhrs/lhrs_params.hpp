@@ -80,6 +80,9 @@ struct lhrs_params
   mutable stg_map_luts_params map_luts_params;
   stg_map_shannon_params      map_shannon_params;
 
+  unsigned               num_threads        = 0u;                                          /* threads to synthesize LUTs ahead, 0u: hardware concurrency */
+  bool                   use_cache          = false;                                       /* reuse circuits of LUTs with equal functions, also across runs if CIRKIT_HOME is set */
+
   bool                   progress           = false;                                       /* show progress line */
   bool                   verbose            = false;                                       /* be verbose */
 
@@ -118,6 +121,9 @@ struct lhrs_stats
   unsigned num_decomp_default = 0u;
   unsigned num_decomp_lut     = 0u;
 
+  unsigned num_luts_synthesized = 0u;
+  unsigned num_luts_reused      = 0u;
+
   stg_map_esop_stats    map_esop_stats;
   stg_map_precomp_stats map_precomp_stats;
   stg_map_luts_stats    map_luts_stats;
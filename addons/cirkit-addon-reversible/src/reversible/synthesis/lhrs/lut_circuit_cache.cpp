@@ -0,0 +1,352 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "lut_circuit_cache.hpp"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/format.hpp>
+
+#include <classical/utils/truth_table_utils.hpp>
+#include <reversible/gate.hpp>
+#include <reversible/target_tags.hpp>
+#include <reversible/variable.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+const std::string lut_circuit_cache_magic = "lhrs-lut-cache-1";
+
+bool lut_circuit_is_serializable( const circuit& circ )
+{
+  for ( const auto& g : circ )
+  {
+    if ( !is_toffoli( g ) && !is_stg( g ) ) { return false; }
+  }
+  return true;
+}
+
+/* one gate per line: type, targets, controls (line + 1, negative if negated),
+   and for single-target gates the function and the affine class */
+void write_lut_circuit_gate( const gate& g, std::ostream& os )
+{
+  os << ( is_stg( g ) ? 'S' : 'T' ) << " " << g.targets().size();
+  for ( const auto& t : g.targets() )
+  {
+    os << " " << t;
+  }
+  os << " " << g.controls().size();
+  for ( const auto& c : g.controls() )
+  {
+    os << " " << ( c.polarity() ? 1 : -1 ) * static_cast<int>( c.line() + 1u );
+  }
+
+  if ( is_stg( g ) )
+  {
+    const auto& stg = boost::any_cast<stg_tag>( g.type() );
+    os << " " << stg.function << " ";
+    if ( stg.affine_class.empty() )
+    {
+      os << "-";
+    }
+    else
+    {
+      os << stg.affine_class;
+    }
+  }
+  os << std::endl;
+}
+
+bool read_lut_circuit_gate( circuit& circ, const std::string& line )
+{
+  std::istringstream is( line );
+
+  char type;
+  unsigned num_targets, num_controls;
+
+  if ( !( is >> type >> num_targets ) || ( type != 'T' && type != 'S' ) ) { return false; }
+
+  auto& g = circ.append_gate();
+  for ( auto i = 0u; i < num_targets; ++i )
+  {
+    unsigned t;
+    if ( !( is >> t ) ) { return false; }
+    g.add_target( t );
+  }
+
+  if ( !( is >> num_controls ) ) { return false; }
+  for ( auto i = 0u; i < num_controls; ++i )
+  {
+    int c;
+    if ( !( is >> c ) || c == 0 ) { return false; }
+    g.add_control( make_var( std::abs( c ) - 1, c > 0 ) );
+  }
+
+  if ( type == 'T' )
+  {
+    g.set_type( toffoli_tag() );
+  }
+  else
+  {
+    std::string function, affine_class;
+    if ( !( is >> function >> affine_class ) ) { return false; }
+
+    stg_tag stg;
+    stg.function = boost::dynamic_bitset<>( function );
+    if ( affine_class != "-" )
+    {
+      stg.affine_class = boost::dynamic_bitset<>( affine_class );
+    }
+    g.set_type( stg );
+  }
+
+  return true;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+lut_circuit_cache::lut_circuit_cache( const std::string& filename )
+  : filename( filename )
+{
+  if ( !filename.empty() )
+  {
+    load( filename );
+  }
+}
+
+lut_circuit_cache::entry_t lut_circuit_cache::lookup( const std::string& key ) const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+
+  const auto it = entries.find( key );
+  if ( it == entries.end() )
+  {
+    ++cache_miss;
+    return nullptr;
+  }
+
+  ++cache_hit;
+  return it->second;
+}
+
+lut_circuit_cache::entry_t lut_circuit_cache::insert( const std::string& key, const entry_t& entry )
+{
+  std::lock_guard<std::mutex> lock( mutex );
+
+  const auto p = entries.insert( {key, entry} );
+  if ( p.second )
+  {
+    ++num_added;
+  }
+  return p.first->second;
+}
+
+void lut_circuit_cache::load( const std::string& filename )
+{
+  std::ifstream is( filename.c_str(), std::ifstream::in );
+  if ( !is ) { return; }
+
+  std::string line;
+  if ( !std::getline( is, line ) || line != lut_circuit_cache_magic )
+  {
+    std::cout << "[w] " << filename << " is no LUT circuit cache" << std::endl;
+    return;
+  }
+
+  std::string key;
+  while ( std::getline( is, key ) && std::getline( is, line ) )
+  {
+    std::istringstream header( line );
+    unsigned lines, num_gates;
+    bool decomposed;
+
+    if ( !( header >> lines >> num_gates >> decomposed ) ) { break; }
+
+    const auto entry = std::make_shared<lut_circuit>();
+    entry->circ.set_lines( lines );
+    entry->decomposed = decomposed;
+
+    auto ok = true;
+    for ( auto i = 0u; ok && i < num_gates; ++i )
+    {
+      ok = std::getline( is, line ) && read_lut_circuit_gate( entry->circ, line );
+    }
+
+    if ( !ok )
+    {
+      std::cout << "[w] LUT circuit cache " << filename << " is corrupt, ignore remaining entries" << std::endl;
+      break;
+    }
+
+    entries.insert( {key, entry} );
+  }
+
+  num_loaded = entries.size();
+}
+
+void lut_circuit_cache::save( const std::string& filename ) const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+
+  /* write to a temporary file first, such that concurrent runs never read a partial cache */
+  const auto tmpname = boost::str( boost::format( "%s.%d.tmp" ) % filename % getpid() );
+  {
+    std::ofstream os( tmpname.c_str(), std::ofstream::out );
+    os << lut_circuit_cache_magic << std::endl;
+
+    for ( const auto& p : entries )
+    {
+      const auto& circ = p.second->circ;
+      if ( !lut_circuit_is_serializable( circ ) ) { continue; }
+
+      os << p.first << std::endl
+         << circ.lines() << " " << circ.num_gates() << " " << p.second->decomposed << std::endl;
+      for ( const auto& g : circ )
+      {
+        write_lut_circuit_gate( g, os );
+      }
+    }
+
+    if ( !os )
+    {
+      std::cout << "[w] cannot write LUT circuit cache " << filename << std::endl;
+      std::remove( tmpname.c_str() );
+      return;
+    }
+  }
+  std::rename( tmpname.c_str(), filename.c_str() );
+}
+
+bool lut_circuit_cache::persist() const
+{
+  {
+    std::lock_guard<std::mutex> lock( mutex );
+    if ( filename.empty() || num_added == 0u ) { return false; }
+  }
+
+  save( filename );
+  return true;
+}
+
+std::size_t lut_circuit_cache::size() const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+  return entries.size();
+}
+
+unsigned long lut_circuit_cache::hits() const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+  return cache_hit;
+}
+
+unsigned long lut_circuit_cache::misses() const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+  return cache_miss;
+}
+
+void lut_circuit_cache::print_statistics( std::ostream& os ) const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+  os << boost::format( "[i] LUT circuit cache: size = %d (%d from file)   cache hits = %d   cache misses = %d" ) % entries.size() % num_loaded % cache_hit % cache_miss << std::endl;
+}
+
+lut_circuit_cache::ptr shared_lut_circuit_cache( const std::string& name )
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, lut_circuit_cache::ptr> caches;
+
+  std::lock_guard<std::mutex> lock( mutex );
+
+  auto& cache = caches[name];
+  if ( !cache )
+  {
+    std::string filename;
+    if ( const auto* path = std::getenv( "CIRKIT_HOME" ) )
+    {
+      filename = boost::str( boost::format( "%s/lhrs_%s.cache" ) % path % name );
+    }
+    cache = std::make_shared<lut_circuit_cache>( filename );
+  }
+  return cache;
+}
+
+void append_lut_circuit( circuit& circ, const circuit& lut_circ,
+                         const std::vector<unsigned>& line_map,
+                         const std::vector<unsigned>& ancillas )
+{
+  const auto map_line = [&line_map, &ancillas]( unsigned line ) {
+    return line < line_map.size() ? line_map[line] : ancillas[line - line_map.size()];
+  };
+
+  for ( const auto& g : lut_circ )
+  {
+    auto& ng = circ.append_gate();
+    for ( const auto& c : g.controls() )
+    {
+      ng.add_control( make_var( map_line( c.line() ), c.polarity() ) );
+    }
+    for ( const auto& t : g.targets() )
+    {
+      ng.add_target( map_line( t ) );
+    }
+    ng.set_type( g.type() );
+
+    if ( is_stg( ng ) )
+    {
+      const auto& stg = boost::any_cast<stg_tag>( ng.type() );
+      if ( !stg.affine_class.empty() )
+      {
+        circ.annotate( ng, "affine", tt_to_hex( stg.affine_class ) );
+      }
+    }
+  }
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
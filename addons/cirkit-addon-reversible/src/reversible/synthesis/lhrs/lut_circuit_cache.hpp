@@ -0,0 +1,136 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file lut_circuit_cache.hpp
+ *
+ * @brief Cache for the circuits of single-target gates in LHRS
+ *
+ * A cached circuit realizes one LUT in local line numbering: lines 0 to k - 1
+ * are the LUT inputs, line k is the target, and all further lines are clean
+ * ancillae.  Entries are keyed by strings, which are derived from the LUT
+ * truth table and the mapping parameters by the caller.  The cache can be
+ * shared by several threads and be backed by a file, which is read when the
+ * cache is created and rewritten by persist().
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef LUT_CIRCUIT_CACHE_HPP
+#define LUT_CIRCUIT_CACHE_HPP
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+struct lut_circuit
+{
+  circuit circ;
+  bool    decomposed = false; /* LUT was mapped into smaller LUTs */
+};
+
+class lut_circuit_cache
+{
+public:
+  using ptr     = std::shared_ptr<lut_circuit_cache>;
+  using entry_t = std::shared_ptr<const lut_circuit>;
+
+  /* if filename is given and exists, its entries are loaded */
+  explicit lut_circuit_cache( const std::string& filename = std::string() );
+
+  lut_circuit_cache( const lut_circuit_cache& ) = delete;
+  lut_circuit_cache& operator=( const lut_circuit_cache& ) = delete;
+
+  /* returns nullptr if key is not cached */
+  entry_t lookup( const std::string& key ) const;
+
+  /* if key is already cached, the cached entry is kept and returned */
+  entry_t insert( const std::string& key, const entry_t& entry );
+
+  /* writes all entries into filename, entries with gates other than Toffoli
+     gates and single-target gates are skipped */
+  void save( const std::string& filename ) const;
+
+  /* saves to the file given in the constructor if new entries were added */
+  bool persist() const;
+
+  std::size_t size() const;
+  unsigned long hits() const;
+  unsigned long misses() const;
+
+  void print_statistics( std::ostream& os = std::cout ) const;
+
+private:
+  void load( const std::string& filename );
+
+private:
+  mutable std::mutex                         mutex;
+  std::unordered_map<std::string, entry_t>   entries;
+
+  std::string                                filename;
+  std::size_t                                num_loaded = 0u;
+  std::size_t                                num_added  = 0u;
+
+  mutable unsigned long                      cache_hit  = 0ul;
+  mutable unsigned long                      cache_miss = 0ul;
+};
+
+/**
+ * @brief Process-wide LUT circuit cache called `name'
+ *
+ * All calls with the same name return the same cache.  If CIRKIT_HOME is
+ * set, the cache is backed by the file $CIRKIT_HOME/lhrs_<name>.cache.
+ */
+lut_circuit_cache::ptr shared_lut_circuit_cache( const std::string& name );
+
+/**
+ * @brief Appends a cached LUT circuit to circ
+ *
+ * Line i < k of the LUT circuit is mapped to line_map[i], line k to
+ * line_map[k], and line k + 1 + j to ancillas[j].
+ */
+void append_lut_circuit( circuit& circ, const circuit& lut_circ,
+                         const std::vector<unsigned>& line_map,
+                         const std::vector<unsigned>& ancillas );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
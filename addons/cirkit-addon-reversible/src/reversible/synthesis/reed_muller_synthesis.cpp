@@ -370,7 +370,7 @@ namespace cirkit
 
   truth_table_synthesis_func reed_muller_synthesis_func( properties::ptr settings, properties::ptr statistics )
   {
-    truth_table_synthesis_func f = [&settings, &statistics]( circuit& circ, const binary_truth_table& spec ) {
+    truth_table_synthesis_func f = [settings, statistics]( circuit& circ, const binary_truth_table& spec ) {
       return reed_muller_synthesis( circ, spec, settings, statistics );
     };
     f.init( settings, statistics );
@@ -27,6 +27,7 @@
 #include "transformation_based_synthesis.hpp"
 
 #include <boost/assign/std/vector.hpp>
+#include <boost/format.hpp>
 #include <boost/range/algorithm.hpp>
 
 #include <core/utils/bitset_utils.hpp>
@@ -247,6 +248,219 @@ void print_current_state( unsigned index, const circuit& circ, const bitset_pair
   std::cout << std::endl;
 }
 
+/* Toffoli gate on permutation values, controls and target as bit masks */
+using permutation_gate_t = std::pair<unsigned, unsigned>;
+
+class permutation_tbs_manager
+{
+public:
+  permutation_tbs_manager( unsigned num_vars, const permutation_t& perm, const permutation_t& inv, bool verbose )
+    : num_vars( num_vars ),
+      perm( perm ),
+      inv( inv ),
+      verbose( verbose )
+  {
+  }
+
+  void run( bool bidirectional, bool multidirectional )
+  {
+    /* Step 1 */
+    if ( !bidirectional && !multidirectional )
+    {
+      if ( verbose )
+      {
+        print_state( 0u );
+      }
+
+      for ( auto rest = perm[0u]; rest; rest &= rest - 1u )
+      {
+        apply_gate( 0u, rest & -rest, direction_back );
+      }
+      row = 1u;
+    }
+
+    /* Step 2 */
+    for ( ; row < perm.size(); ++row )
+    {
+      if ( verbose )
+      {
+        print_state( row );
+      }
+
+      if ( perm[row] == row ) { continue; }
+
+      /* the row to move into the current one at the inputs */
+      auto other = row;
+      auto best = hamming( row, perm[row] );
+
+      const auto front_cost = hamming( inv[row], row );
+      if ( ( bidirectional || multidirectional ) && front_cost < best )
+      {
+        other = inv[row];
+        best = front_cost;
+      }
+
+      if ( multidirectional )
+      {
+        for ( auto bit = 1u; bit < perm.size(); bit <<= 1u )
+        {
+          if ( row & bit ) { continue; }
+
+          const auto neighbor = row | bit;
+          if ( 1u + hamming( perm[neighbor], row ) < best )
+          {
+            other = neighbor;
+            best = 1u + hamming( perm[neighbor], row );
+          }
+          if ( hamming( inv[neighbor], row ) + 1u < best )
+          {
+            other = inv[neighbor];
+            best = hamming( inv[neighbor], row ) + 1u;
+          }
+        }
+      }
+
+      if ( verbose )
+      {
+        std::cout << boost::format( "[i] adjust row %d using row %d (cost: %d)" ) % row % other % best << std::endl;
+      }
+
+      if ( other != row )
+      {
+        adjust( other, row, direction_front );
+      }
+      if ( perm[row] != row )
+      {
+        adjust( perm[row], row, direction_back );
+      }
+      assert( perm[row] == row );
+    }
+  }
+
+  void create_circuit( circuit& circ ) const
+  {
+    for ( const auto& g : front_gates )
+    {
+      append_toffoli( circ, controls_from_mask( g.first ), target_from_mask( g.second ) );
+    }
+    for ( auto it = back_gates.rbegin(); it != back_gates.rend(); ++it )
+    {
+      append_toffoli( circ, controls_from_mask( it->first ), target_from_mask( it->second ) );
+    }
+  }
+
+private:
+  inline static unsigned hamming( unsigned a, unsigned b )
+  {
+    return __builtin_popcount( a ^ b );
+  }
+
+  /* same output as in the truth table based variant */
+  void print_state( unsigned index ) const
+  {
+    circuit circ( num_vars );
+    create_circuit( circ );
+
+    bitset_pair_vector_t tt;
+    for ( auto x = 0u; x < perm.size(); ++x )
+    {
+      tt.emplace_back( boost::dynamic_bitset<>( num_vars, x ), boost::dynamic_bitset<>( num_vars, perm[x] ) );
+    }
+
+    print_current_state( index, circ, tt );
+  }
+
+  /* transforms `from' into `to' with the gate cascade of [MMD03] */
+  void adjust( unsigned from, unsigned to, direction_t dir )
+  {
+    auto mask = from;
+
+    /* change 0 -> 1 */
+    for ( auto p = ( from ^ to ) & to; p; p &= p - 1u )
+    {
+      const auto bit = p & -p;
+      apply_gate( mask, bit, dir );
+      mask |= bit;
+    }
+
+    /* change 1 -> 0 */
+    for ( auto q = ( from ^ to ) & from; q; q &= q - 1u )
+    {
+      const auto bit = q & -q;
+      mask &= ~bit;
+      apply_gate( mask, bit, dir );
+    }
+  }
+
+  /* A gate at the outputs changes the values of the permutation and the
+     indexes of its inverse; a gate at the inputs the other way round.
+     Rows before the current one are never affected. */
+  void apply_gate( unsigned controls, unsigned target, direction_t dir )
+  {
+    if ( dir == direction_back )
+    {
+      flip_values( perm, controls, target );
+      swap_indexes( inv, controls, target );
+      back_gates.push_back( {controls, target} );
+    }
+    else
+    {
+      swap_indexes( perm, controls, target );
+      flip_values( inv, controls, target );
+      front_gates.push_back( {controls, target} );
+    }
+  }
+
+  void flip_values( permutation_t& values, unsigned controls, unsigned target ) const
+  {
+    /* branch-free such that the loop is vectorized */
+    auto* v = values.data();
+    const auto size = static_cast<unsigned>( values.size() );
+    for ( auto x = row; x < size; ++x )
+    {
+      v[x] ^= target & -static_cast<unsigned>( ( v[x] & controls ) == controls );
+    }
+  }
+
+  void swap_indexes( permutation_t& values, unsigned controls, unsigned target ) const
+  {
+    /* enumerate all indexes that contain the controls but not the target */
+    const auto free = ( static_cast<unsigned>( values.size() ) - 1u ) & ~controls & ~target;
+    auto rest = 0u;
+    do
+    {
+      const auto x = controls | rest;
+      std::swap( values[x], values[x | target] );
+      rest = ( rest - free ) & free;
+    } while ( rest );
+  }
+
+  gate::control_container controls_from_mask( unsigned mask ) const
+  {
+    gate::control_container controls;
+    for ( ; mask; mask &= mask - 1u )
+    {
+      controls += make_var( target_from_mask( mask & -mask ) );
+    }
+    return controls;
+  }
+
+  inline unsigned target_from_mask( unsigned mask ) const
+  {
+    return num_vars - 1u - __builtin_ctz( mask );
+  }
+
+private:
+  unsigned num_vars;
+  permutation_t perm;
+  permutation_t inv;
+  bool verbose;
+
+  unsigned row = 0u;
+  std::vector<permutation_gate_t> front_gates;
+  std::vector<permutation_gate_t> back_gates;
+};
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -259,6 +473,7 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
   const auto bidirectional    = get( settings, "bidirectional",    true  );
   const auto fredkin          = get( settings, "fredkin",          false );
   const auto fredkin_lookback = get( settings, "fredkin_lookback", false );
+  const auto multidirectional = get( settings, "multidirectional", false );
   const auto verbose          = get( settings, "verbose",          false );
 
   /* Warning */
@@ -266,6 +481,10 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
   {
     std::cout << "[w] fredkin_lookback option has no effect since fredkin option is disabled." << std::endl;
   }
+  if ( fredkin && multidirectional && verbose )
+  {
+    std::cout << "[w] multidirectional option has no effect since fredkin option is enabled." << std::endl;
+  }
 
   properties_timer t( statistics );
 
@@ -289,6 +508,22 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
   /* copy metadata */
   copy_metadata( spec, circ );
 
+  /* without Fredkin gates the permutation based variant is used */
+  if ( !fredkin )
+  {
+    permutation_t perm( tt.size() ), inv( tt.size() );
+    for ( auto i = 0u; i < tt.size(); ++i )
+    {
+      perm[i] = tt[i].second.to_ulong();
+      inv[perm[i]] = i;
+    }
+
+    permutation_tbs_manager mgr( bw, perm, inv, verbose );
+    mgr.run( bidirectional, multidirectional );
+    mgr.create_circuit( circ );
+    return true;
+  }
+
   /* Step 1 */
   if ( !bidirectional )
   {
@@ -342,10 +577,54 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
   return true;
 }
 
+bool transformation_based_synthesis( circuit& circ, const permutation_t& perm,
+                                     const properties::ptr& settings,
+                                     const properties::ptr& statistics )
+{
+  /* Settings */
+  const auto bidirectional    = get( settings, "bidirectional",    true  );
+  const auto multidirectional = get( settings, "multidirectional", false );
+  const auto verbose          = get( settings, "verbose",          false );
+
+  properties_timer t( statistics );
+
+  /* circuit has to be empty */
+  clear_circuit( circ );
+
+  /* size has to be a power of two */
+  auto num_vars = 0u;
+  while ( ( 1ull << num_vars ) < perm.size() ) { ++num_vars; }
+  if ( perm.empty() || ( 1ull << num_vars ) != perm.size() || num_vars >= 32u )
+  {
+    set_error_message( statistics, "size of permutation `perm' is not a power of two." );
+    return false;
+  }
+
+  /* inverse, which also checks that `perm' is a permutation */
+  permutation_t inv( perm.size(), static_cast<unsigned>( perm.size() ) );
+  for ( auto i = 0u; i < perm.size(); ++i )
+  {
+    if ( perm[i] >= perm.size() || inv[perm[i]] != perm.size() )
+    {
+      set_error_message( statistics, "`perm' is not a permutation." );
+      return false;
+    }
+    inv[perm[i]] = i;
+  }
+
+  circ.set_lines( num_vars );
+
+  permutation_tbs_manager mgr( num_vars, perm, inv, verbose );
+  mgr.run( bidirectional, multidirectional );
+  mgr.create_circuit( circ );
+
+  return true;
+}
+
 truth_table_synthesis_func transformation_based_synthesis_func( const properties::ptr& settings,
                                                                 const properties::ptr& statistics )
 {
-  truth_table_synthesis_func f = [&settings, &statistics]( circuit& circ, const binary_truth_table& spec ) {
+  truth_table_synthesis_func f = [settings, statistics]( circuit& circ, const binary_truth_table& spec ) {
     return transformation_based_synthesis( circ, spec, settings, statistics );
   };
   f.init( settings, statistics );
@@ -39,6 +39,7 @@
 #include <core/properties.hpp>
 #include <reversible/circuit.hpp>
 #include <reversible/truth_table.hpp>
+#include <reversible/utils/permutation.hpp>
 
 #include <reversible/synthesis/synthesis.hpp>
 
@@ -66,6 +67,14 @@ namespace cirkit
  *   <tr>
  *     <td colspan="2" class="indexvalue">Use the bidirectional approach as described in [\ref MMD03].</td>
  *   </tr>
+ *   <tr>
+ *     <td rowspan="2" class="indexvalue">multidirectional</td>
+ *     <td class="indexvalue">bool</td>
+ *     <td class="indexvalue">false</td>
+ *   </tr>
+ *   <tr>
+ *     <td colspan="2" class="indexvalue">Use the multidirectional approach of the permutation based variant (no effect together with <i>fredkin</i>).</td>
+ *   </tr>
  * </table>
  * @param statistics <table border="0" width="100%">
  *   <tr>
@@ -88,6 +97,64 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
                                      const properties::ptr& settings = properties::ptr(),
                                      const properties::ptr& statistics = properties::ptr() );
 
+/**
+ * @brief Synthesizes a circuit from a permutation using the Transformation Based approach
+ *
+ * The permutation over \f$2^n\f$ elements is kept together with its
+ * inverse in two flat arrays, where line 0 corresponds to the most
+ * significant bit as in truth_table_to_permutation.  Each chosen
+ * Toffoli gate is applied to all remaining rows in one branch-free pass
+ * over the value array and in one pass over the rows selected by its
+ * controls in the index array.  This allows synthesizing functions with
+ * more than 20 variables without a truth table in memory.  Fredkin
+ * gates are not supported in this variant.
+ *
+ * @param circ       Empty Circuit
+ * @param perm       Permutation, its size must be a power of two
+ * @param settings <table border="0" width="100%">
+ *   <tr>
+ *     <td class="indexkey">Setting</td>
+ *     <td class="indexkey">Type</td>
+ *     <td class="indexkey">Default Value</td>
+ *   </tr>
+ *   <tr>
+ *     <td rowspan="2" class="indexvalue">bidirectional</td>
+ *     <td class="indexvalue">bool</td>
+ *     <td class="indexvalue">true</td>
+ *   </tr>
+ *   <tr>
+ *     <td colspan="2" class="indexvalue">Use the bidirectional approach as described in [\ref MMD03].</td>
+ *   </tr>
+ *   <tr>
+ *     <td rowspan="2" class="indexvalue">multidirectional</td>
+ *     <td class="indexvalue">bool</td>
+ *     <td class="indexvalue">false</td>
+ *   </tr>
+ *   <tr>
+ *     <td colspan="2" class="indexvalue">Also consider moving a row in Hamming distance one to the current row by gates at the inputs and fixing its output by gates at the outputs; the cheapest alternative is chosen.  Implies bidirectional.</td>
+ *   </tr>
+ * </table>
+ * @param statistics <table border="0" width="100%">
+ *   <tr>
+ *     <td class="indexkey">Information</td>
+ *     <td class="indexkey">Type</td>
+ *     <td class="indexkey">Description</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">runtime</td>
+ *     <td class="indexvalue">double</td>
+ *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+ *   </tr>
+ * </table>
+ *
+ * @return true if successful, false otherwise
+ *
+ * @since  2.4
+ */
+bool transformation_based_synthesis( circuit& circ, const permutation_t& perm,
+                                     const properties::ptr& settings = properties::ptr(),
+                                     const properties::ptr& statistics = properties::ptr() );
+
 /**
  * @brief Functor for the \ref revkit::transformation_based_synthesis "transformation_based_synthesis" algorithm
  *
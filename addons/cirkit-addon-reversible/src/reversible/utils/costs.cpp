@@ -30,6 +30,7 @@
 #include <boost/dynamic_bitset.hpp>
 #include <boost/integer/integer_log2.hpp>
 
+#include <reversible/compact_circuit.hpp>
 #include <reversible/pauli_tags.hpp>
 #include <reversible/target_tags.hpp>
 #include <reversible/functions/flatten_circuit.hpp>
@@ -39,22 +40,15 @@
 namespace cirkit
 {
 
-cost_t gate_costs::operator()( const circuit& circ ) const
-{
-  return circ.num_gates();
-}
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
 
-cost_t line_costs::operator()( const circuit& circ ) const
-{
-  return circ.lines();
-}
-
-cost_t transistor_costs::operator()( const gate& g, unsigned lines ) const
-{
-  return 8ull * g.controls().size();
-}
+/* the cost functions are shared by circuit and compact_circuit (and by gate
+ * and compact_gate respectively) */
 
-cost_t depth_costs::operator()( const circuit& circ ) const
+template<typename Circuit>
+cost_t depth_costs_impl( const Circuit& circ )
 {
   auto mask = ~boost::dynamic_bitset<>( circ.lines() );
   auto depth = 0;
@@ -79,7 +73,8 @@ cost_t depth_costs::operator()( const circuit& circ ) const
   return depth;
 }
 
-cost_t sk2013_quantum_costs::operator()( const gate& g, unsigned lines ) const
+template<typename Gate>
+cost_t sk2013_quantum_costs_impl( const Gate& g )
 {
   unsigned ac = g.controls().size();
   unsigned nc = boost::count_if( g.controls(), []( const variable& v ) { return !v.polarity(); } );
@@ -109,7 +104,8 @@ cost_t toffoli_gates( unsigned controls, unsigned lines )
   }
 }
 
-inline unsigned all_negative( const gate& g, unsigned lines )
+template<typename Gate>
+inline unsigned all_negative( const Gate& g, unsigned lines )
 {
   bool ng = boost::find_if( g.controls(), []( const variable& v ) { return v.polarity(); } ) == g.controls().end();
   if ( ng )
@@ -117,24 +113,22 @@ inline unsigned all_negative( const gate& g, unsigned lines )
   return 0;
 }
 
-cost_t ncv_quantum_costs::operator()( const gate& g, unsigned lines ) const
+template<typename Gate>
+cost_t ncv_quantum_costs_impl( const Gate& g, unsigned lines )
 {
   unsigned ac = g.controls().size();
   return ((ac < 2) ? 1ull : 5ull * toffoli_gates( ac, lines ) + all_negative( g, lines ) );
 }
 
-cost_t clifford_t_quantum_costs::operator()( const gate& g, unsigned lines ) const
+template<typename Gate>
+cost_t clifford_t_quantum_costs_impl( const Gate& g, unsigned lines )
 {
   unsigned ac = g.controls().size();
   return ((ac < 2) ? 1ull : 16ull * toffoli_gates( ac, lines ) + all_negative( g, lines ) );
 }
 
-cost_t t_depth_costs::operator()( const gate& g, unsigned lines ) const
-{
-  return cost_invalid();
-}
-
-cost_t t_costs::operator()( const gate& g, unsigned lines ) const
+template<typename Gate>
+cost_t t_costs_impl( const Gate& g, unsigned lines )
 {
   /* the following computation is based on
    * [D. Maslov, Phys Rev A 93, 022311, 2016.
@@ -163,11 +157,11 @@ cost_t t_costs::operator()( const gate& g, unsigned lines ) const
       }
     }
   }
-  else if ( is_hadamard( g ) )
+  else if ( is_type<hadamard_tag>( g.type() ) )
   {
     return 0ull;
   }
-  else if ( is_pauli( g ) )
+  else if ( is_type<pauli_tag>( g.type() ) )
   {
     const auto& tag = boost::any_cast<pauli_tag>( g.type() );
     return ( tag.axis == pauli_axis::Z && tag.root == 4u ) ? 1ull : 0ull;
@@ -210,13 +204,118 @@ cost_t t_costs::operator()( const gate& g, unsigned lines ) const
   }
 }
 
-cost_t h_costs::operator()( const gate& g, unsigned lines ) const
+template<typename Gate>
+cost_t h_costs_impl( const Gate& g, unsigned lines )
 {
   unsigned ac = g.controls().size();
   if ( ac == 0u ) return 2ull;
   return ((ac < 2) ? 0ull : 2ull * toffoli_gates( ac, lines ) );
 }
 
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+cost_t gate_costs::operator()( const circuit& circ ) const
+{
+  return circ.num_gates();
+}
+
+cost_t gate_costs::operator()( const compact_circuit& circ ) const
+{
+  return circ.num_gates();
+}
+
+cost_t line_costs::operator()( const circuit& circ ) const
+{
+  return circ.lines();
+}
+
+cost_t line_costs::operator()( const compact_circuit& circ ) const
+{
+  return circ.lines();
+}
+
+cost_t transistor_costs::operator()( const gate& g, unsigned lines ) const
+{
+  return 8ull * g.controls().size();
+}
+
+cost_t transistor_costs::operator()( const compact_gate& g, unsigned lines ) const
+{
+  return 8ull * g.controls().size();
+}
+
+cost_t depth_costs::operator()( const circuit& circ ) const
+{
+  return depth_costs_impl( circ );
+}
+
+cost_t depth_costs::operator()( const compact_circuit& circ ) const
+{
+  return depth_costs_impl( circ );
+}
+
+cost_t sk2013_quantum_costs::operator()( const gate& g, unsigned lines ) const
+{
+  return sk2013_quantum_costs_impl( g );
+}
+
+cost_t sk2013_quantum_costs::operator()( const compact_gate& g, unsigned lines ) const
+{
+  return sk2013_quantum_costs_impl( g );
+}
+
+cost_t ncv_quantum_costs::operator()( const gate& g, unsigned lines ) const
+{
+  return ncv_quantum_costs_impl( g, lines );
+}
+
+cost_t ncv_quantum_costs::operator()( const compact_gate& g, unsigned lines ) const
+{
+  return ncv_quantum_costs_impl( g, lines );
+}
+
+cost_t clifford_t_quantum_costs::operator()( const gate& g, unsigned lines ) const
+{
+  return clifford_t_quantum_costs_impl( g, lines );
+}
+
+cost_t clifford_t_quantum_costs::operator()( const compact_gate& g, unsigned lines ) const
+{
+  return clifford_t_quantum_costs_impl( g, lines );
+}
+
+cost_t t_depth_costs::operator()( const gate& g, unsigned lines ) const
+{
+  return cost_invalid();
+}
+
+cost_t t_depth_costs::operator()( const compact_gate& g, unsigned lines ) const
+{
+  return cost_invalid();
+}
+
+cost_t t_costs::operator()( const gate& g, unsigned lines ) const
+{
+  return t_costs_impl( g, lines );
+}
+
+cost_t t_costs::operator()( const compact_gate& g, unsigned lines ) const
+{
+  return t_costs_impl( g, lines );
+}
+
+cost_t h_costs::operator()( const gate& g, unsigned lines ) const
+{
+  return h_costs_impl( g, lines );
+}
+
+cost_t h_costs::operator()( const compact_gate& g, unsigned lines ) const
+{
+  return h_costs_impl( g, lines );
+}
+
 struct costs_visitor : public boost::static_visitor<cost_t>
 {
   explicit costs_visitor( const circuit& circ ) : circ( circ ) {}
@@ -43,6 +43,8 @@
 #include <boost/variant.hpp>
 
 #include <reversible/circuit.hpp>
+#include <reversible/compact_circuit.hpp>
+#include <reversible/target_tags.hpp>
 
 namespace cirkit
 {
@@ -111,6 +113,7 @@ struct gate_costs
    * @since  1.0
    */
   cost_t operator()( const circuit& circ ) const;
+  cost_t operator()( const compact_circuit& circ ) const;
 };
 
 /**
@@ -136,6 +139,7 @@ struct line_costs
    * @since  1.0
    */
   cost_t operator()( const circuit& circ ) const;
+  cost_t operator()( const compact_circuit& circ ) const;
 };
 
 /**
@@ -162,6 +166,7 @@ struct transistor_costs
    * @since  1.0
    */
   cost_t operator()( const gate& g, unsigned lines ) const;
+  cost_t operator()( const compact_gate& g, unsigned lines ) const;
 };
 
 /**
@@ -170,6 +175,7 @@ struct transistor_costs
 struct depth_costs
 {
   cost_t operator()( const circuit& circ ) const;
+  cost_t operator()( const compact_circuit& circ ) const;
 };
 
 /**
@@ -182,6 +188,7 @@ struct depth_costs
 struct sk2013_quantum_costs
 {
   cost_t operator()( const gate& g, unsigned lines ) const;
+  cost_t operator()( const compact_gate& g, unsigned lines ) const;
 };
 
 /**
@@ -196,6 +203,7 @@ struct sk2013_quantum_costs
  */
 struct ncv_quantum_costs {
   cost_t operator()(const gate& g, unsigned lines) const;
+  cost_t operator()( const compact_gate& g, unsigned lines ) const;
 };
 
 /**
@@ -209,6 +217,7 @@ struct ncv_quantum_costs {
  */
 struct clifford_t_quantum_costs {
   cost_t operator()(const gate& g, unsigned lines) const;
+  cost_t operator()( const compact_gate& g, unsigned lines ) const;
 };
 
 /**
@@ -222,6 +231,7 @@ struct clifford_t_quantum_costs {
  */
 struct t_depth_costs {
   cost_t operator()(const gate& g, unsigned lines) const;
+  cost_t operator()( const compact_gate& g, unsigned lines ) const;
 };
 
 /**
@@ -235,6 +245,7 @@ struct t_depth_costs {
  */
 struct t_costs {
   cost_t operator()(const gate& g, unsigned lines) const;
+  cost_t operator()( const compact_gate& g, unsigned lines ) const;
 };
 
 /**
@@ -248,6 +259,7 @@ struct t_costs {
  */
 struct h_costs {
   cost_t operator()(const gate& g, unsigned lines) const;
+  cost_t operator()( const compact_gate& g, unsigned lines ) const;
 };
 
 /**
@@ -276,6 +288,53 @@ cost_t costs( const circuit& circ, const cost_function& f );
  */
 cost_t costs( const circuit& circ, unsigned begin, unsigned end, const costs_by_gate_func& f );
 
+namespace detail
+{
+
+template<typename F>
+auto compact_costs( const compact_circuit& circ, const F& f, int ) -> decltype( f( circ ) )
+{
+  return f( circ );
+}
+
+template<typename F>
+cost_t compact_costs( const compact_circuit& circ, const F& f, long )
+{
+  cost_t sum = 0ull, tmp{};
+  for ( const auto& g : circ )
+  {
+    if ( is_module( g ) )
+    {
+      tmp = costs( *boost::any_cast<module_tag>( g.type() ).reference, costs_by_gate_func( f ) );
+    }
+    else
+    {
+      tmp = ( circ.lines() == g.controls().size() + 1 ) ? f( g, circ.lines() + 1 ) : f( g, circ.lines() );
+    }
+
+    if ( tmp == cost_invalid() )
+    {
+      return tmp;
+    }
+    sum += tmp;
+  }
+  return sum;
+}
+
+}
+
+/**
+ * @brief Costs of a compact circuit
+ *
+ * `f' is one of the cost functors above, i.e., it is either called
+ * with the whole circuit or summed up over the gate views.
+ */
+template<typename F>
+cost_t costs( const compact_circuit& circ, const F& f )
+{
+  return detail::compact_costs( circ, f, 0 );
+}
+
 }
 
 #endif /* COSTS_HPP */
@@ -33,19 +33,15 @@
 #include <boost/format.hpp>
 
 #include <xtensor/xio.hpp>
-#include <xtensor-blas/xlinalg.hpp>
 
 #include <core/utils/bitset_utils.hpp>
 #include <core/utils/terminal.hpp>
-#include <reversible/pauli_tags.hpp>
-#include <reversible/target_tags.hpp>
 #include <reversible/simulation/simple_simulation.hpp>
+#include <reversible/simulation/state_vector_simulation.hpp>
 
 namespace cirkit
 {
 
-using namespace std::complex_literals;
-
 /******************************************************************************
  * Types                                                                      *
  ******************************************************************************/
@@ -54,29 +50,9 @@ using namespace std::complex_literals;
  * Private functions                                                          *
  ******************************************************************************/
 
-xt::xarray<complex_t> get_2by2_matrix( complex_t a, complex_t b, complex_t c, complex_t d )
-{
-  xt::xarray<complex_t> matrix(std::vector<size_t>{2, 2});
-  matrix[{0,0}] = a;
-  matrix[{0,1}] = b;
-  matrix[{1,0}] = c;
-  matrix[{1,1}] = d;
-  return matrix;
-}
-
-xt::xarray<complex_t> kron( const std::vector<xt::xarray<complex_t>>& ms )
-{
-  assert( !ms.empty() );
-
-  auto r = ms[0u];
-
-  for ( auto i = 1u; i < ms.size(); ++i )
-  {
-    r = xt::linalg::kron( r, ms[i] );
-  }
-
-  return r;
-}
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
 
 xt::xarray<complex_t> identity( unsigned dimension )
 {
@@ -88,135 +64,29 @@ xt::xarray<complex_t> identity( unsigned dimension )
   return matrix;
 }
 
-xt::xarray<complex_t> identity_padding( const xt::xarray<complex_t>& matrix, unsigned from, unsigned to, unsigned lines )
-{
-  std::vector<xt::xarray<complex_t>> ms;
-
-  if ( to + 1u < lines )
-  {
-    ms.push_back( identity( 1 << ( lines - to - 1u ) ) );
-  }
-
-  ms.push_back( matrix );
-
-  if ( from > 0u )
-  {
-    ms.push_back( identity( 1 << from ) );
-  }
-
-  return kron( ms );
-}
-
-/******************************************************************************
- * Public functions                                                           *
- ******************************************************************************/
-
 xt::xarray<complex_t> matrix_from_clifford_t_circuit( const circuit& circ, bool progress )
 {
-  xt::xarray<complex_t> matrix_X = get_2by2_matrix( 0.0, 1.0, 1.0, 0.0 );
-  xt::xarray<complex_t> matrix_H = 1.0 / sqrt( 2.0 ) * get_2by2_matrix( 1.0, 1.0, 1.0, -1.0 );
-  xt::xarray<complex_t> matrix_Z = get_2by2_matrix( 1.0, 0.0, 0.0, -1.0 );
-  xt::xarray<complex_t> matrix_S = get_2by2_matrix( 1.0, 0.0, 0.0, 1i );
-  xt::xarray<complex_t> matrix_Sdag = get_2by2_matrix( 1.0, 0.0, 0.0, -1i );
-  xt::xarray<complex_t> matrix_T = get_2by2_matrix( 1.0, 0.0, 0.0, exp( 1i * M_PI / 4.0 ) );
-  xt::xarray<complex_t> matrix_Tdag = get_2by2_matrix( 1.0, 0.0, 0.0, exp( -1i * M_PI / 4.0 ) );
-  xt::xarray<complex_t> matrix_zc = get_2by2_matrix( 1.0, 0.0, 0.0, 0.0 );
-  xt::xarray<complex_t> matrix_oc = get_2by2_matrix( 0.0, 0.0, 0.0, 1.0 );
-
-  const auto n = circ.lines();
+  const std::uint64_t N = 1ull << circ.lines();
+  const state_vector_simulator sim( circ );
 
-  std::vector<xt::xarray<complex_t>> gates;
+  progress_line pline( boost::str( boost::format( "[i] (matrix_from_clifford_t_circuit) column %%d / %d" ) % N ), progress );
 
-  for ( const auto& g : circ )
+  /* row i is the image of |i>, i.e., the transposed unitary as in
+   * matrix_from_reversible_circuit */
+  xt::xarray<complex_t> matrix(std::vector<size_t>{N, N});
+  for ( std::uint64_t i = 0u; i < N; ++i )
   {
-    const auto target = g.targets().front();
+    pline( i + 1u );
 
-    if ( is_toffoli( g ) && g.controls().size() == 0u )
-    {
-      gates.push_back( identity_padding( matrix_X, target, target, n ) );
-    }
-    else if ( is_toffoli( g ) && g.controls().size() == 1u && g.controls().front().polarity() )
-    {
-      const auto control = g.controls().front().line();
-
-      if ( control < target )
-      {
-        const auto act = target - control;
-        const auto gate = xt::linalg::kron( identity( 1 << act ), matrix_zc ) + kron( {matrix_X, identity( 1 << ( act - 1 ) ), matrix_oc} );
-        gates.push_back( identity_padding( gate, control, target, n ) );
-      }
-      else
-      {
-        const auto act = control - target;
-        const auto gate = xt::linalg::kron( matrix_zc, identity( 1 << act ) ) + kron( {matrix_oc, identity( 1 << ( act - 1 ) ), matrix_X} );
-        gates.push_back( identity_padding( gate, target, control, n ) );
-      }
-    }
-    else if ( is_hadamard( g ) )
-    {
-      gates.push_back( identity_padding( matrix_H, target, target, n ) );
-    }
-    else if ( is_pauli( g ) )
-    {
-      const auto pauli = boost::any_cast<pauli_tag>( g.type() );
-      switch ( pauli.axis )
-      {
-      case pauli_axis::X:
-        if ( pauli.root == 1u )
-        {
-          gates.push_back( identity_padding( matrix_X, target, target, n ) );
-        }
-        else
-        {
-          std::cout << "[w] unsupported X gate" << std::endl;
-        }
-        break;
-      case pauli_axis::Z:
-        if ( pauli.root == 1u )
-        {
-          gates.push_back( identity_padding( matrix_Z, target, target, n ) );
-        }
-        else if ( pauli.root == 2u )
-        {
-          gates.push_back( identity_padding( pauli.adjoint ? matrix_Sdag : matrix_S, target, target, n ) );
-        }
-        else if ( pauli.root == 4u )
-        {
-          gates.push_back( identity_padding( pauli.adjoint ? matrix_Tdag : matrix_T, target, target, n ) );
-        }
-        else
-        {
-          std::cout << "[w] unsupported Z gate with root " << pauli.root << std::endl;
-        }
-        break;
-      default:
-        std::cout << "[w] unsupported Pauli gate" << std::endl;
-        break;
-      }
-    }
-    else
+    auto state = create_basis_state( circ.lines(), i );
+    sim.simulate( state );
+    for ( std::uint64_t j = 0u; j < N; ++j )
     {
-      std::cout << "[w] unsupported gate" << std::endl;
+      matrix[{i, j}] = state[j];
     }
   }
 
-  if ( gates.empty() )
-  {
-    return identity( 1 << n );
-  }
-  else
-  {
-    progress_line pline( boost::str( boost::format( "[i] (matrix_from_clifford_t_circuit) gate %%d / %d" ) % gates.size() ), progress );
-
-    auto r = gates.front();
-    for ( auto i = 1u; i < gates.size(); ++i )
-    {
-      pline( i + 1u );
-      r = xt::linalg::dot( r, gates[i] );
-    }
-
-    return r;
-  }
+  return matrix;
 }
 
 xt::xarray<complex_t> matrix_from_reversible_circuit( const circuit& circ )
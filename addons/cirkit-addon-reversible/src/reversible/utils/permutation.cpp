@@ -37,8 +37,7 @@
 #include <boost/range/algorithm_ext/push_back.hpp>
 
 #include <core/utils/range_utils.hpp>
-#include <reversible/functions/circuit_to_truth_table.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
 
 using namespace boost::assign;
 using boost::adaptors::transformed;
@@ -71,9 +70,27 @@ permutation_t truth_table_to_permutation( const binary_truth_table& spec )
 
 permutation_t circuit_to_permutation( const circuit& circ )
 {
-  binary_truth_table spec;
-  circuit_to_truth_table( circ, spec, simple_simulation_func() );
-  return truth_table_to_permutation( spec );
+  const auto n = circ.lines();
+  assert( n < 32u );
+
+  auto patterns = create_exhaustive_patterns( n );
+  bitsliced_simulator( circ ).simulate( patterns );
+
+  /* pattern p assigns bit i to line i, whereas line 0 is the most
+     significant bit in the permutation */
+  permutation_t perm( 1u << n );
+  for ( auto p = 0u; p < perm.size(); ++p )
+  {
+    auto from = 0u, to = 0u;
+    for ( auto i = 0u; i < n; ++i )
+    {
+      from |= ( ( p >> i ) & 1u ) << ( n - 1u - i );
+      to   |= static_cast<unsigned>( ( patterns[i][p >> 6u] >> ( p & 63u ) ) & 1u ) << ( n - 1u - i );
+    }
+    perm[from] = to;
+  }
+
+  return perm;
 }
 
 cycles_t permutation_to_cycles( const permutation_t& perm, bool sort )
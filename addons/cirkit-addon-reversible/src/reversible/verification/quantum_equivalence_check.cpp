@@ -0,0 +1,182 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "quantum_equivalence_check.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include <boost/format.hpp>
+
+#include <core/utils/terminal.hpp>
+#include <core/utils/timer.hpp>
+#include <reversible/simulation/clifford_tableau.hpp>
+#include <reversible/simulation/state_vector_simulation.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace detail
+{
+
+/* tolerance for accumulated rounding errors */
+constexpr double qec_tolerance = 1e-6;
+
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bool quantum_equivalence_check( const circuit& circ1, const circuit& circ2,
+                                const properties::ptr& settings,
+                                const properties::ptr& statistics )
+{
+  /* settings */
+  const auto max_basis_lines = get( settings, "max_basis_lines", 10u );
+  const auto samples         = get( settings, "samples",         4u );
+  const auto seed            = get( settings, "seed",            0u );
+  const auto stabilizer      = get( settings, "stabilizer",      true );
+  const auto max_phase_lines = get( settings, "max_phase_lines", 24u );
+  const auto num_threads     = get( settings, "num_threads",     1u );
+  const auto progress        = get( settings, "progress",        false );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  const auto lines = std::max( circ1.lines(), circ2.lines() );
+  std::string method;
+  auto up_to_global_phase = false;
+
+  const auto result = [&]( bool equivalent ) {
+    set( statistics, "method", method );
+    set( statistics, "up_to_global_phase", up_to_global_phase );
+    return equivalent;
+  };
+
+  /* C2^dagger C1 */
+  const auto miter = [&]() {
+    state_vector_simulator sim( circ1 );
+    sim.append( circ2, true );
+    return sim;
+  };
+
+  if ( stabilizer && is_clifford_circuit( circ1 ) && is_clifford_circuit( circ2 ) )
+  {
+    method = "stabilizer";
+
+    clifford_tableau t1( lines ), t2( lines );
+    t1.apply( circ1 );
+    t2.apply( circ2 );
+
+    if ( t1 != t2 )
+    {
+      return result( false );
+    }
+
+    if ( lines > max_phase_lines )
+    {
+      up_to_global_phase = true;
+      return result( true );
+    }
+
+    /* circuits are equal up to a global phase, which one state reveals */
+    auto state = create_basis_state( lines, 0u );
+    miter().simulate( state, num_threads );
+    return result( std::abs( state[0u] - 1.0 ) <= detail::qec_tolerance );
+  }
+
+  const auto sim = miter();
+
+  if ( lines <= max_basis_lines )
+  {
+    method = "basis";
+
+    const std::uint64_t num_states = 1ull << lines;
+    progress_line pline( boost::str( boost::format( "[i] (quantum_equivalence_check) basis state %%d / %d" ) % num_states ), progress );
+
+    for ( std::uint64_t i = 0u; i < num_states; ++i )
+    {
+      pline( i + 1u );
+
+      /* the state is normalized, so amplitude 1 at i implies |i> */
+      auto state = create_basis_state( lines, i );
+      sim.simulate( state, num_threads );
+      if ( std::abs( state[i] - 1.0 ) > detail::qec_tolerance )
+      {
+        return result( false );
+      }
+    }
+  }
+  else
+  {
+    method = "random";
+
+    std::mt19937 gen( seed );
+    progress_line pline( boost::str( boost::format( "[i] (quantum_equivalence_check) random state %%d / %d" ) % samples ), progress );
+
+    for ( auto i = 0u; i < samples; ++i )
+    {
+      pline( i + 1u );
+
+      const auto state = create_random_state( lines, gen );
+      auto image = state;
+      sim.simulate( image, num_threads );
+
+      /* a difference in a few basis states changes the overlap <state|image>
+         by only about 2^-lines, therefore the squared distance is compared
+         relative to the average squared amplitude 2^-lines */
+      auto distance = 0.0;
+      for ( std::uint64_t j = 0u; j < state.size(); ++j )
+      {
+        distance += std::norm( image[j] - state[j] );
+      }
+      if ( distance > detail::qec_tolerance * std::ldexp( 1.0, -static_cast<int>( lines ) ) )
+      {
+        return result( false );
+      }
+    }
+  }
+
+  return result( true );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
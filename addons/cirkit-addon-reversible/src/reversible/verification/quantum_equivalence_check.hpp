@@ -0,0 +1,138 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * @file quantum_equivalence_check.hpp
+ *
+ * @brief Equivalence check of quantum circuits by simulation
+ *
+ * The miter C2^dagger C1 is applied to a set of states, the circuits
+ * are equivalent if every state is mapped to itself.  For all basis
+ * states the check is exact, for random states a non-equivalence is
+ * detected with probability one.  If both circuits are Clifford
+ * circuits, their stabilizer tableaus are compared instead.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef QUANTUM_EQUIVALENCE_CHECK_HPP
+#define QUANTUM_EQUIVALENCE_CHECK_HPP
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @brief Checks whether two circuits realize the same unitary
+ *
+ * If the circuits have a different number of lines, the smaller one is
+ * padded with identity on the upper lines.
+ *
+ * @param settings <table border="0" width="100%">
+ *   <tr>
+ *     <td class="indexkey">Setting</td>
+ *     <td class="indexkey">Type</td>
+ *     <td class="indexkey">Default Value</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">max_basis_lines</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">10u</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">samples</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">4u</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">seed</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">0u</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">stabilizer</td>
+ *     <td class="indexvalue">bool</td>
+ *     <td class="indexvalue">true</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">max_phase_lines</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">24u</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">num_threads</td>
+ *     <td class="indexvalue">unsigned</td>
+ *     <td class="indexvalue">1u</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">progress</td>
+ *     <td class="indexvalue">bool</td>
+ *     <td class="indexvalue">false</td>
+ *   </tr>
+ * </table>
+ * All basis states are checked if the circuits have at most
+ * max_basis_lines lines, otherwise `samples' random states.  Clifford
+ * circuits with the same tableau differ at most in a global phase,
+ * which is checked by simulating one state if there are at most
+ * max_phase_lines lines.
+ * @param statistics <table border="0" width="100%">
+ *   <tr>
+ *     <td class="indexkey">Information</td>
+ *     <td class="indexkey">Type</td>
+ *     <td class="indexkey">Description</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">method</td>
+ *     <td class="indexvalue">std::string</td>
+ *     <td class="indexvalue">One of stabilizer, basis, or random.</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">up_to_global_phase</td>
+ *     <td class="indexvalue">bool</td>
+ *     <td class="indexvalue">True, if the global phase of equivalent circuits has not been checked.</td>
+ *   </tr>
+ *   <tr>
+ *     <td class="indexvalue">runtime</td>
+ *     <td class="indexvalue">double</td>
+ *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+ *   </tr>
+ * </table>
+ */
+bool quantum_equivalence_check( const circuit& circ1, const circuit& circ2,
+                                const properties::ptr& settings = properties::ptr(),
+                                const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
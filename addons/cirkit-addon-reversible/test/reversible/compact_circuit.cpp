@@ -0,0 +1,133 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE compact_circuit
+
+#include <random>
+#include <sstream>
+
+#define timer timer_class
+#include <boost/test/unit_test.hpp>
+#undef timer
+
+#include <core/utils/bitset_utils.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/compact_circuit.hpp>
+#include <reversible/target_tags.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/random_circuit.hpp>
+#include <reversible/io/write_realization.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
+#include <reversible/utils/costs.hpp>
+
+using namespace cirkit;
+
+circuit mixed_circuit( unsigned lines, unsigned gates, std::default_random_engine& gen )
+{
+  circuit circ( lines );
+
+  for ( auto i = 0u; i < gates; ++i )
+  {
+    const auto t1 = gen() % lines, t2 = ( t1 + 1u ) % lines, c = ( t1 + 2u ) % lines;
+    switch ( gen() % 4u )
+    {
+    case 0u:
+      create_random_gate( circ.append_gate(), lines, true, gen );
+      break;
+    case 1u:
+      append_fredkin( circ, gate::control_container{make_var( c )}, t1, t2 );
+      break;
+    case 2u:
+      append_peres( circ, make_var( c ), t1, t2 );
+      break;
+    case 3u:
+      {
+        auto& g = circ.append_gate();
+        g.set_type( stg_tag( boost::dynamic_bitset<>( 4u, gen() % 16u ) ) );
+        g.add_control( make_var( c ) );
+        g.add_control( make_var( t2 ) );
+        g.add_target( t1 );
+      }
+      break;
+    }
+  }
+
+  return circ;
+}
+
+BOOST_AUTO_TEST_CASE(roundtrip)
+{
+  std::default_random_engine gen( 11 );
+  const auto circ = mixed_circuit( 6u, 40u, gen );
+  const auto compact = circuit_to_compact_circuit( circ );
+
+  BOOST_CHECK( compact.lines() == circ.lines() );
+  BOOST_CHECK( compact.num_gates() == circ.num_gates() );
+
+  std::stringstream s1, s2, s3;
+  write_realization( circ, s1 );
+  write_realization( compact, s2 );
+  write_realization( compact_circuit_to_circuit( compact ), s3 );
+
+  BOOST_CHECK( s1.str() == s2.str() );
+  BOOST_CHECK( s1.str() == s3.str() );
+}
+
+BOOST_AUTO_TEST_CASE(simulation)
+{
+  std::default_random_engine gen( 5 );
+  const auto circ = mixed_circuit( 6u, 40u, gen );
+  const auto compact = circuit_to_compact_circuit( circ );
+
+  boost::dynamic_bitset<> input( 6u );
+  do
+  {
+    boost::dynamic_bitset<> o1, o2;
+    simple_simulation( o1, circ, input );
+    simple_simulation( o2, compact, input );
+    BOOST_CHECK( o1 == o2 );
+  } while ( !inc( input ).none() );
+}
+
+BOOST_AUTO_TEST_CASE(costs_match)
+{
+  std::default_random_engine gen( 9 );
+  const auto circ = random_circuit( 8u, 50u, true, gen );
+  const auto compact = circuit_to_compact_circuit( circ );
+
+  BOOST_CHECK( costs( circ, gate_costs() ) == costs( compact, gate_costs() ) );
+  BOOST_CHECK( costs( circ, depth_costs() ) == costs( compact, depth_costs() ) );
+  BOOST_CHECK( costs( circ, transistor_costs() ) == costs( compact, transistor_costs() ) );
+  BOOST_CHECK( costs( circ, ncv_quantum_costs() ) == costs( compact, ncv_quantum_costs() ) );
+  BOOST_CHECK( costs( circ, t_costs() ) == costs( compact, t_costs() ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,120 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE lhrs
+
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/xmg/xmg.hpp>
+#include <classical/xmg/xmg_flow_map.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/io/write_realization.hpp>
+#include <reversible/synthesis/lhrs/lhrs.hpp>
+
+using namespace cirkit;
+
+xmg_graph random_xmg( unsigned num_inputs, unsigned num_gates, unsigned num_outputs, std::mt19937& gen )
+{
+  xmg_graph xmg;
+
+  std::vector<xmg_function> fs;
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    fs.push_back( xmg.create_pi( "x" + std::to_string( i ) ) );
+  }
+
+  for ( auto k = 0u; k < num_gates; ++k )
+  {
+    auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+    if ( gen() & 1u ) { a = !a; }
+    if ( gen() & 1u ) { b = !b; }
+    fs.push_back( ( gen() % 3u == 0u ) ? xmg.create_xor( a, b ) : xmg.create_and( a, b ) );
+  }
+
+  for ( auto o = 0u; o < num_outputs; ++o )
+  {
+    xmg.create_po( fs[fs.size() - 1u - gen() % ( num_gates / 2u )], "y" + std::to_string( o ) );
+  }
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "cut_size", 4u );
+  xmg_flow_map( xmg, settings );
+
+  return xmg;
+}
+
+std::string synthesize( const xmg_graph& xmg, unsigned num_threads, bool use_cache, unsigned additional_ancilla = 0u )
+{
+  lhrs_params params;
+  lhrs_stats stats;
+  params.num_threads = num_threads;
+  params.use_cache = use_cache;
+  params.additional_ancilla = additional_ancilla;
+
+  circuit circ;
+  BOOST_REQUIRE( lut_based_synthesis( circ, xmg, params, stats ) );
+
+  std::stringstream s;
+  write_realization( circ, s );
+  return s.str();
+}
+
+BOOST_AUTO_TEST_CASE( cache_and_threads )
+{
+  /* do not read or write a persistent cache */
+  unsetenv( "CIRKIT_HOME" );
+
+  std::mt19937 gen( 42 );
+
+  for ( auto i = 0u; i < 5u; ++i )
+  {
+    const auto xmg = random_xmg( 10u, 80u, 4u, gen );
+
+    const auto expected = synthesize( xmg, 1u, false );
+    BOOST_CHECK_EQUAL( synthesize( xmg, 4u, false ), expected );
+    BOOST_CHECK_EQUAL( synthesize( xmg, 1u, true ), expected );
+    BOOST_CHECK_EQUAL( synthesize( xmg, 4u, true ), expected ); /* all LUTs are cached now */
+
+    /* the cache must not return circuits for a different number of lines */
+    for ( auto ancilla : {1u, 3u} )
+    {
+      BOOST_CHECK_EQUAL( synthesize( xmg, 4u, true, ancilla ), synthesize( xmg, 1u, false, ancilla ) );
+    }
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,138 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE simulation
+
+#include <random>
+
+#define timer timer_class
+#include <boost/test/unit_test.hpp>
+#undef timer
+
+#include <core/utils/bitset_utils.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/target_tags.hpp>
+#include <reversible/functions/add_circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/circuit_to_truth_table.hpp>
+#include <reversible/functions/is_identity.hpp>
+#include <reversible/functions/random_circuit.hpp>
+#include <reversible/functions/reverse_circuit.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
+#include <reversible/utils/permutation.hpp>
+
+using namespace cirkit;
+
+circuit mixed_circuit( unsigned lines, unsigned gates, std::default_random_engine& gen )
+{
+  circuit circ( lines );
+  std::uniform_int_distribution<unsigned> dist( 0u, lines - 1u );
+
+  for ( auto i = 0u; i < gates; ++i )
+  {
+    const auto t1 = dist( gen ), t2 = ( t1 + 1u ) % lines, c = ( t1 + 2u ) % lines;
+    switch ( gen() % 4u )
+    {
+    case 0u:
+      create_random_gate( circ.append_gate(), lines, true, gen );
+      break;
+    case 1u:
+      append_fredkin( circ, gate::control_container{make_var( c )}, t1, t2 );
+      break;
+    case 2u:
+      append_peres( circ, make_var( c ), t1, t2 );
+      break;
+    case 3u:
+      {
+        auto& g = circ.append_gate();
+        g.set_type( stg_tag( boost::dynamic_bitset<>( 4u, gen() % 16u ) ) );
+        g.add_control( make_var( c ) );
+        g.add_control( make_var( t2 ) );
+        g.add_target( t1 );
+      }
+      break;
+    }
+  }
+
+  return circ;
+}
+
+BOOST_AUTO_TEST_CASE(compare_with_simple_simulation)
+{
+  std::default_random_engine gen( 42 );
+
+  for ( auto lines : {3u, 6u, 9u} )
+  {
+    const auto circ = mixed_circuit( lines, 50u, gen );
+
+    auto patterns = create_exhaustive_patterns( lines );
+    bitsliced_simulator( circ ).simulate( patterns, 2u, 1u );
+
+    boost::dynamic_bitset<> input( lines );
+    for ( auto p = 0u; p < ( 1u << lines ); ++p, inc( input ) )
+    {
+      boost::dynamic_bitset<> output;
+      simple_simulation( output, circ, input );
+      BOOST_CHECK( bitsliced_pattern( patterns, p ) == output );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(identity)
+{
+  std::default_random_engine gen( 7 );
+
+  for ( auto lines : {4u, 12u} )
+  {
+    auto circ = random_circuit( lines, 20u, true, gen );
+    circuit inv;
+    reverse_circuit( circ, inv );
+    BOOST_CHECK( !is_identity( circ ) );
+
+    append_circuit( circ, inv );
+    BOOST_CHECK( is_identity( circ ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(to_truth_table)
+{
+  std::default_random_engine gen( 3 );
+  const auto circ = mixed_circuit( 5u, 30u, gen );
+
+  binary_truth_table spec1, spec2;
+  circuit_to_truth_table( circ, spec1, simple_simulation_func() );
+  circuit_to_truth_table( circ, spec2 );
+
+  BOOST_CHECK( truth_table_to_permutation( spec1 ) == truth_table_to_permutation( spec2 ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
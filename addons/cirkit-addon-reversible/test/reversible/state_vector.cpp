@@ -0,0 +1,232 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE state_vector
+
+#include <cmath>
+#include <random>
+
+#define timer timer_class
+#include <boost/test/unit_test.hpp>
+#undef timer
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/pauli_tags.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/random_circuit.hpp>
+#include <reversible/simulation/clifford_tableau.hpp>
+#include <reversible/simulation/state_vector_simulation.hpp>
+#include <reversible/verification/quantum_equivalence_check.hpp>
+
+using namespace cirkit;
+
+circuit clifford_t_toffoli()
+{
+  circuit circ( 3u );
+  append_hadamard( circ, 2u );
+  append_cnot( circ, 1u, 2u );
+  append_pauli( circ, 2u, pauli_axis::Z, 4u, true );
+  append_cnot( circ, 0u, 2u );
+  append_pauli( circ, 2u, pauli_axis::Z, 4u );
+  append_cnot( circ, 1u, 2u );
+  append_pauli( circ, 2u, pauli_axis::Z, 4u, true );
+  append_cnot( circ, 0u, 2u );
+  append_pauli( circ, 1u, pauli_axis::Z, 4u );
+  append_pauli( circ, 2u, pauli_axis::Z, 4u );
+  append_hadamard( circ, 2u );
+  append_cnot( circ, 0u, 1u );
+  append_pauli( circ, 0u, pauli_axis::Z, 4u );
+  append_pauli( circ, 1u, pauli_axis::Z, 4u, true );
+  append_cnot( circ, 0u, 1u );
+  return circ;
+}
+
+BOOST_AUTO_TEST_CASE(single_qubit_gates)
+{
+  circuit circ( 1u );
+  append_hadamard( circ, 0u );
+  append_pauli( circ, 0u, pauli_axis::Z, 4u );
+
+  auto state = create_basis_state( 1u, 1u );
+  state_vector_simulation( state, circ );
+
+  BOOST_CHECK_SMALL( std::abs( state[0u] - amplitude_t( M_SQRT1_2, 0.0 ) ), 1e-12 );
+  BOOST_CHECK_SMALL( std::abs( state[1u] + std::polar( M_SQRT1_2, M_PI / 4.0 ) ), 1e-12 );
+
+  /* square root of X twice is X */
+  circuit sqrt_x( 1u );
+  append_pauli( sqrt_x, 0u, pauli_axis::X, 2u );
+  append_pauli( sqrt_x, 0u, pauli_axis::X, 2u );
+
+  state = create_basis_state( 1u, 0u );
+  state_vector_simulation( state, sqrt_x );
+  BOOST_CHECK_SMALL( std::abs( state[1u] - 1.0 ), 1e-12 );
+}
+
+BOOST_AUTO_TEST_CASE(toffoli_decomposition)
+{
+  circuit toffoli( 3u );
+  append_toffoli( toffoli )( 0u, 1u )( 2u );
+
+  auto settings = std::make_shared<properties>();
+  auto statistics = std::make_shared<properties>();
+  BOOST_CHECK( quantum_equivalence_check( clifford_t_toffoli(), toffoli, settings, statistics ) );
+  BOOST_CHECK_EQUAL( statistics->get<std::string>( "method" ), "basis" );
+
+  settings->set( "max_basis_lines", 0u );
+  BOOST_CHECK( quantum_equivalence_check( clifford_t_toffoli(), toffoli, settings, statistics ) );
+  BOOST_CHECK_EQUAL( statistics->get<std::string>( "method" ), "random" );
+
+  circuit cnot( 3u );
+  append_cnot( cnot, 0u, 2u );
+  BOOST_CHECK( !quantum_equivalence_check( clifford_t_toffoli(), cnot, settings ) );
+
+  /* identity on an additional line */
+  circuit wide( 4u );
+  append_toffoli( wide )( 0u, 1u )( 2u );
+  BOOST_CHECK( quantum_equivalence_check( clifford_t_toffoli(), wide ) );
+}
+
+BOOST_AUTO_TEST_CASE(wide_toffoli_difference)
+{
+  /* the circuits differ in only two of 2^24 basis states, which changes the
+     overlap of a random state with its image by less than the tolerance */
+  const auto lines = 24u;
+
+  circuit id( lines ), mct( lines );
+  gate::control_container controls;
+  for ( auto i = 0u; i + 1u < lines; ++i )
+  {
+    controls.push_back( make_var( i ) );
+  }
+  append_toffoli( mct, controls, lines - 1u );
+
+  auto settings = std::make_shared<properties>();
+  auto statistics = std::make_shared<properties>();
+  settings->set( "num_threads", 4u );
+  BOOST_CHECK( !quantum_equivalence_check( mct, id, settings, statistics ) );
+  BOOST_CHECK_EQUAL( statistics->get<std::string>( "method" ), "random" );
+
+  /* the same gate twice is the identity */
+  auto mct2 = mct;
+  append_toffoli( mct2, controls, lines - 1u );
+  BOOST_CHECK( quantum_equivalence_check( mct2, id, settings ) );
+}
+
+BOOST_AUTO_TEST_CASE(clifford_circuits)
+{
+  /* CNOT(0, 1) = H H CNOT(1, 0) H H */
+  circuit c1( 2u ), c2( 2u );
+  append_cnot( c1, 0u, 1u );
+  append_hadamard( c2, 0u );
+  append_hadamard( c2, 1u );
+  append_cnot( c2, 1u, 0u );
+  append_hadamard( c2, 0u );
+  append_hadamard( c2, 1u );
+
+  BOOST_CHECK( is_clifford_circuit( c1 ) && is_clifford_circuit( c2 ) );
+  BOOST_CHECK( is_clifford_circuit( clifford_t_toffoli() ) == false );
+
+  auto statistics = std::make_shared<properties>();
+  BOOST_CHECK( quantum_equivalence_check( c1, c2, properties::ptr(), statistics ) );
+  BOOST_CHECK_EQUAL( statistics->get<std::string>( "method" ), "stabilizer" );
+
+  /* S S = Z, but S != S^dagger */
+  circuit ss( 1u ), z( 1u ), sdg( 1u );
+  append_pauli( ss, 0u, pauli_axis::Z, 2u );
+  append_pauli( ss, 0u, pauli_axis::Z, 2u );
+  append_pauli( z, 0u, pauli_axis::Z );
+  append_pauli( sdg, 0u, pauli_axis::Z, 2u, true );
+  BOOST_CHECK( quantum_equivalence_check( ss, z ) );
+
+  clifford_tableau t1( 1u ), t2( 1u );
+  t1.apply( ss, true );
+  t2.apply( sdg );
+  BOOST_CHECK( t1 != t2 );
+  t2.apply( sdg );
+  BOOST_CHECK( t1 == t2 );
+
+  /* XZ = -ZX, same tableau but different global phase */
+  circuit xz( 1u ), zx( 1u );
+  append_pauli( xz, 0u, pauli_axis::X );
+  append_pauli( xz, 0u, pauli_axis::Z );
+  append_pauli( zx, 0u, pauli_axis::Z );
+  append_pauli( zx, 0u, pauli_axis::X );
+  BOOST_CHECK( !quantum_equivalence_check( xz, zx, properties::ptr(), statistics ) );
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "max_phase_lines", 0u );
+  BOOST_CHECK( quantum_equivalence_check( xz, zx, settings, statistics ) );
+  BOOST_CHECK( statistics->get<bool>( "up_to_global_phase" ) );
+}
+
+BOOST_AUTO_TEST_CASE(threads_and_blocks)
+{
+  std::default_random_engine gen( 42 );
+
+  circuit circ( 17u );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    create_random_gate( circ.append_gate(), circ.lines(), true, gen );
+    append_hadamard( circ, gen() % circ.lines() );
+    append_pauli( circ, gen() % circ.lines(), pauli_axis::Z, 4u );
+  }
+
+  std::mt19937 mt( 1u );
+  const auto state = create_random_state( circ.lines(), mt );
+
+  auto s1 = state;
+  state_vector_simulator( circ ).simulate( s1, 1u );
+  auto s2 = state;
+  state_vector_simulator( circ ).simulate( s2, 2u, 4u );
+
+  auto diff = 0.0;
+  for ( auto i = 0u; i < state.size(); ++i )
+  {
+    diff = std::max( diff, std::abs( s1[i] - s2[i] ) );
+  }
+  BOOST_CHECK_SMALL( diff, 1e-12 );
+
+  /* C^dagger C = id */
+  state_vector_simulator sim( circ );
+  sim.append( circ, true );
+  auto s3 = state;
+  sim.simulate( s3, 2u );
+  diff = 0.0;
+  for ( auto i = 0u; i < state.size(); ++i )
+  {
+    diff = std::max( diff, std::abs( s3[i] - state[i] ) );
+  }
+  BOOST_CHECK_SMALL( diff, 1e-10 );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
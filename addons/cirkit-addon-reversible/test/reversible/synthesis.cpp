@@ -27,7 +27,9 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE truth_table
 
+#include <algorithm>
 #include <cmath>
+#include <random>
 #include <vector>
 
 #include <boost/assign/std/vector.hpp>
@@ -43,6 +45,7 @@
 #include <reversible/synthesis/reed_muller_synthesis.hpp>
 #include <reversible/synthesis/transformation_based_synthesis.hpp>
 #include <reversible/synthesis/transposition_based_synthesis.hpp>
+#include <reversible/utils/permutation.hpp>
 
 using namespace cirkit;
 
@@ -97,6 +100,53 @@ BOOST_AUTO_TEST_CASE(simple)
   }
 }
 
+BOOST_AUTO_TEST_CASE(permutation_based)
+{
+  std::mt19937 gen( 42u );
+
+  for ( auto n = 1u; n <= 7u; ++n )
+  {
+    auto perm = identity_permutation( 1u << n );
+    std::shuffle( perm.begin(), perm.end(), gen );
+
+    binary_truth_table spec;
+    add_entries_from_permutation( spec, perm );
+
+    for ( auto mode = 0u; mode < 3u; ++mode )
+    {
+      auto settings = std::make_shared<properties>();
+      settings->set( "bidirectional", mode != 0u );
+      settings->set( "multidirectional", mode == 2u );
+
+      circuit circ, circ_spec;
+      BOOST_CHECK( transformation_based_synthesis( circ, perm, settings ) );
+      BOOST_CHECK( circuit_to_permutation( circ ) == perm );
+
+      BOOST_CHECK( transformation_based_synthesis( circ_spec, spec, settings ) );
+      BOOST_CHECK( circuit_to_permutation( circ_spec ) == perm );
+
+      binary_truth_table new_spec;
+      circuit_to_truth_table( circ, new_spec, simple_simulation_func() );
+      BOOST_CHECK( truth_table_to_permutation( new_spec ) == perm );
+    }
+  }
+
+  /* few swapped rows in a larger permutation */
+  auto perm = identity_permutation( 1u << 16u );
+  std::uniform_int_distribution<unsigned> dist( 0u, perm.size() - 1u );
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    std::swap( perm[dist( gen )], perm[dist( gen )] );
+  }
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "multidirectional", true );
+
+  circuit circ;
+  BOOST_CHECK( transformation_based_synthesis( circ, perm, settings ) );
+  BOOST_CHECK( circuit_to_permutation( circ ) == perm );
+}
+
 // Local Variables:
 // c-basic-offset: 2
 // eval: (c-set-offset 'substatement-open 0)
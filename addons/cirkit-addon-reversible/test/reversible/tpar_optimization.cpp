@@ -0,0 +1,119 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE tpar_optimization
+
+#include <random>
+
+#define timer timer_class
+#include <boost/test/unit_test.hpp>
+#undef timer
+
+#include <reversible/circuit.hpp>
+#include <reversible/pauli_tags.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/optimization/tpar_optimization.hpp>
+#include <reversible/verification/quantum_equivalence_check.hpp>
+
+using namespace cirkit;
+
+unsigned t_count( const circuit& circ )
+{
+  auto count = 0u;
+  for ( const auto& g : circ )
+  {
+    if ( is_pauli( g ) && boost::any_cast<pauli_tag>( g.type() ).root == 4u )
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+BOOST_AUTO_TEST_CASE(merge_phases)
+{
+  /* T on x0 ^ x1 twice with a NOT in between: T X T = w X */
+  circuit circ( 2u );
+  append_cnot( circ, 0u, 1u );
+  append_pauli( circ, 1u, pauli_axis::Z, 4u );
+  append_cnot( circ, 0u, 1u );
+  append_not( circ, 0u );
+  append_cnot( circ, 1u, 0u );
+  append_pauli( circ, 0u, pauli_axis::Z, 4u, true );
+  append_cnot( circ, 1u, 0u );
+  append_pauli( circ, 1u, pauli_axis::Z, 4u );
+  append_pauli( circ, 1u, pauli_axis::Z, 4u );
+
+  const auto opt = tpar_optimization( circ );
+  BOOST_CHECK( quantum_equivalence_check( circ, opt ) );
+  BOOST_CHECK( t_count( opt ) < t_count( circ ) );
+}
+
+BOOST_AUTO_TEST_CASE(random_clifford_t)
+{
+  std::default_random_engine gen( 7 );
+
+  for ( auto k = 0u; k < 20u; ++k )
+  {
+    const auto lines = 2u + gen() % 4u;
+    circuit circ( lines );
+
+    for ( auto i = 0u; i < 60u; ++i )
+    {
+      const auto a = gen() % lines, b = ( a + 1u + gen() % ( lines - 1u ) ) % lines;
+      switch ( gen() % 9u )
+      {
+      case 0u: append_hadamard( circ, a ); break;
+      case 1u:
+      case 2u: append_cnot( circ, a, b ); break;
+      case 3u: append_cnot( circ, make_var( a, false ), b ); break;
+      case 4u: append_not( circ, a ); break;
+      case 5u: append_pauli( circ, a, pauli_axis::Z, 4u, gen() % 2u ); break;
+      case 6u: append_pauli( circ, a, pauli_axis::Z, 2u, gen() % 2u ); break;
+      case 7u: append_pauli( circ, a, pauli_axis::Y ); break;
+      case 8u:
+        if ( lines > 2u )
+        {
+          auto c = 0u;
+          while ( c == a || c == b ) { ++c; }
+          append_toffoli( circ )( a, b )( c );
+        }
+        break;
+      }
+    }
+
+    const auto opt = tpar_optimization( circ );
+    BOOST_CHECK( quantum_equivalence_check( circ, opt ) );
+    BOOST_CHECK( t_count( opt ) <= t_count( circ ) + 2u );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
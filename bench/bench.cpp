@@ -0,0 +1,317 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <core/properties.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/generators/npn_circuit.hpp>
+#include <classical/generators/transparent_arithmetic.hpp>
+#include <classical/io/read_verilog.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using boost::format;
+using boost::property_tree::ptree;
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* transparent arithmetic circuits are generated with a fixed seed per
+   bitwidth, so that the checked-in files can be recreated exactly */
+void generate_trans_arith( unsigned bitwidth, std::ostream& os )
+{
+  auto settings = std::make_shared<properties>();
+  settings->set( "seed",        42u + bitwidth );
+  settings->set( "bitwidth",    bitwidth );
+  settings->set( "min_words",   6u );
+  settings->set( "max_words",   12u );
+  settings->set( "max_rounds",  6u );
+  settings->set( "operators",   std::vector<std::string>( {"+", "-", "*"} ) );
+  settings->set( "module_name", str( format( "trans_arith_%d" ) % bitwidth ) );
+  generate_transparent_arithmetic_circuit( os, settings );
+}
+
+double median( std::vector<double> times )
+{
+  std::sort( times.begin(), times.end() );
+  const auto n = times.size();
+  return ( n % 2u == 1u ) ? times[n / 2u] : 0.5 * ( times[n / 2u - 1u] + times[n / 2u] );
+}
+
+std::string json_escape( const std::string& s )
+{
+  std::string r;
+  for ( auto c : s )
+  {
+    if ( c == '"' || c == '\\' ) { r += '\\'; }
+    r += c;
+  }
+  return r;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void bench_suite::add( const std::string& benchmark, const std::string& circuit, unsigned threads,
+                       const std::function<run_func()>& setup )
+{
+  cases.push_back( {benchmark, circuit, threads, setup} );
+}
+
+std::vector<bench_result> bench_suite::run( const bench_config& config, std::ostream& os ) const
+{
+  std::vector<bench_result> results;
+  const std::regex filter( config.filter.empty() ? ".*" : config.filter );
+
+  for ( const auto& c : cases )
+  {
+    if ( !std::regex_search( c.benchmark + "/" + c.circuit, filter ) )
+    {
+      continue;
+    }
+
+    const auto f = c.setup();
+
+    bench_result result{c.benchmark, c.circuit, c.threads, 0.0, 0.0, 0.0, 0u};
+    auto first = true;
+    const auto check = [&]( std::uint64_t checksum ) {
+      if ( first )
+      {
+        result.checksum = checksum;
+        first = false;
+      }
+      else if ( checksum != result.checksum )
+      {
+        result.deterministic = false;
+      }
+    };
+
+    for ( auto i = 0u; i < config.warmup; ++i )
+    {
+      check( f() );
+    }
+
+    std::vector<double> times;
+    for ( auto i = 0u; i < std::max( config.repetitions, 1u ); ++i )
+    {
+      double runtime = 0.0;
+      std::uint64_t checksum;
+      {
+        reference_timer t( &runtime );
+        checksum = f();
+      }
+      check( checksum );
+      times.push_back( runtime );
+    }
+
+    result.median = median( times );
+    result.min    = *std::min_element( times.begin(), times.end() );
+    result.max    = *std::max_element( times.begin(), times.end() );
+
+    os << format( "[i] %-24s %-16s %2d thread(s) %8.3f secs (min: %.3f, max: %.3f, checksum: %d)" ) % c.benchmark % c.circuit % c.threads % result.median % result.min % result.max % result.checksum << std::endl;
+    if ( !result.deterministic )
+    {
+      os << "[w] checksum differs between runs" << std::endl;
+    }
+
+    results.push_back( result );
+  }
+
+  return results;
+}
+
+std::vector<std::string> bench_circuit_names()
+{
+  return {"trans_arith_4", "trans_arith_8", "trans_arith_16", "trans_arith_32", "npn_3", "npn_4"};
+}
+
+void generate_bench_circuit( const std::string& name, std::ostream& os )
+{
+  unsigned n;
+  if ( std::sscanf( name.c_str(), "trans_arith_%u", &n ) == 1 )
+  {
+    generate_trans_arith( n, os );
+  }
+  else if ( std::sscanf( name.c_str(), "npn_%u", &n ) == 1 )
+  {
+    generate_npn_circuit( os, n );
+  }
+  else
+  {
+    throw std::invalid_argument( "unknown benchmark circuit " + name );
+  }
+}
+
+void generate_bench_circuits( const std::string& dir )
+{
+  boost::filesystem::create_directories( dir );
+  for ( const auto& name : bench_circuit_names() )
+  {
+    std::ofstream os( ( boost::filesystem::path( dir ) / ( name + ".v" ) ).string() );
+    generate_bench_circuit( name, os );
+  }
+}
+
+/* circuits that are not checked in (because they are too large) are
+   generated in memory */
+std::vector<bench_circuit> read_bench_circuits( const bench_config& config )
+{
+  std::vector<bench_circuit> circuits;
+
+  for ( const auto& name : bench_circuit_names() )
+  {
+    const auto filename = ( boost::filesystem::path( config.circuit_dir ) / ( name + ".v" ) ).string();
+
+    aig_graph aig;
+    if ( boost::filesystem::exists( filename ) )
+    {
+      aig = read_verilog_with_abc( filename );
+    }
+    else
+    {
+      std::stringstream s;
+      generate_bench_circuit( name, s );
+      aig = read_verilog_string_with_abc( s.str() );
+    }
+
+    const unsigned num_inputs = aig_info( aig ).inputs.size();
+    const unsigned num_gates  = boost::num_vertices( aig ) - num_inputs - 1u;
+    circuits.push_back( {name, aig, num_inputs, num_gates} );
+  }
+
+  return circuits;
+}
+
+void write_bench_results( const std::vector<bench_result>& results, const bench_config& config, std::ostream& os )
+{
+  os << "{" << std::endl
+     << "  \"repetitions\": " << config.repetitions << "," << std::endl
+     << "  \"results\": [";
+
+  auto first = true;
+  for ( const auto& r : results )
+  {
+    os << ( first ? "" : "," ) << std::endl
+       << format( "    {\"benchmark\": \"%s\", \"circuit\": \"%s\", \"threads\": %d, \"median\": %.6f, \"min\": %.6f, \"max\": %.6f, \"checksum\": %d, \"deterministic\": %s}" )
+          % json_escape( r.benchmark ) % json_escape( r.circuit ) % r.threads % r.median % r.min % r.max % r.checksum % ( r.deterministic ? "true" : "false" );
+    first = false;
+  }
+
+  os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+std::vector<bench_result> read_bench_results( const std::string& filename )
+{
+  ptree pt;
+  read_json( filename, pt );
+
+  std::vector<bench_result> results;
+  for ( const auto& v : pt.get_child( "results" ) )
+  {
+    const auto& r = v.second;
+    results.push_back( {r.get<std::string>( "benchmark" ), r.get<std::string>( "circuit" ), r.get<unsigned>( "threads" ),
+                        r.get<double>( "median" ), r.get<double>( "min" ), r.get<double>( "max" ),
+                        r.get<std::uint64_t>( "checksum" ), r.get<bool>( "deterministic", true )} );
+  }
+  return results;
+}
+
+unsigned compare_bench_results( const std::vector<bench_result>& results, const std::vector<bench_result>& baseline,
+                                double tolerance, double min_delta, std::ostream& os )
+{
+  using key_t = std::tuple<std::string, std::string, unsigned>;
+
+  std::map<key_t, const bench_result*> base;
+  for ( const auto& r : baseline )
+  {
+    base[std::make_tuple( r.benchmark, r.circuit, r.threads )] = &r;
+  }
+
+  auto regressions = 0u;
+  for ( const auto& r : results )
+  {
+    const auto it = base.find( std::make_tuple( r.benchmark, r.circuit, r.threads ) );
+    if ( it == base.end() )
+    {
+      os << format( "[i] %-24s %-16s %2d thread(s) not in baseline" ) % r.benchmark % r.circuit % r.threads << std::endl;
+      continue;
+    }
+
+    const auto& b = *it->second;
+    const auto ratio = b.median > 0.0 ? r.median / b.median : 1.0;
+
+    std::string verdict = "ok";
+    if ( r.checksum != b.checksum && r.deterministic && b.deterministic )
+    {
+      verdict = str( format( "CHANGED (checksum %d, baseline %d)" ) % r.checksum % b.checksum );
+      ++regressions;
+    }
+    else if ( r.median > b.median * ( 1.0 + tolerance ) && r.median - b.median > min_delta )
+    {
+      verdict = "SLOWER";
+      ++regressions;
+    }
+    else if ( r.median < b.median * ( 1.0 - tolerance ) && b.median - r.median > min_delta )
+    {
+      verdict = "faster";
+    }
+
+    os << format( "[i] %-24s %-16s %2d thread(s) %8.3f secs vs. %8.3f secs (%5.2fx) %s" ) % r.benchmark % r.circuit % r.threads % r.median % b.median % ratio % verdict << std::endl;
+  }
+
+  return regressions;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,145 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file bench.hpp
+ *
+ * @brief Reproducible benchmark suite for the core algorithms
+ *
+ * A benchmark case runs an algorithm on one input with a fixed
+ * number of threads and returns a checksum of its result (e.g., the
+ * number of gates).  Cases are timed over several repetitions, and
+ * the results can be written as JSON and compared against a stored
+ * baseline to detect runtime regressions and changed results.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <classical/aig.hpp>
+
+namespace cirkit
+{
+
+struct bench_config
+{
+  std::string           circuit_dir;          /* directory with the checked-in circuits */
+  std::string           filter;               /* regular expression on "benchmark/circuit" */
+  std::vector<unsigned> threads = {1u, 2u, 4u}; /* thread counts for parallel algorithms */
+  unsigned              repetitions = 3u;     /* timed runs per case */
+  unsigned              warmup      = 1u;     /* untimed runs per case */
+  unsigned              seed        = 42u;    /* seed for random inputs */
+  bool                  lhrs_cache  = false;  /* reuse LUT circuits in LHRS across runs */
+};
+
+struct bench_circuit
+{
+  std::string name;
+  aig_graph   aig;
+  unsigned    num_inputs;
+  unsigned    num_gates;
+};
+
+struct bench_result
+{
+  std::string   benchmark;
+  std::string   circuit;
+  unsigned      threads;
+  double        median;
+  double        min;
+  double        max;
+  std::uint64_t checksum;
+  bool          deterministic = true; /* checksum equal in all runs */
+};
+
+class bench_suite
+{
+public:
+  using run_func = std::function<std::uint64_t()>;
+
+  /* adds a case; setup is called once before the runs, outside the timed region */
+  void add( const std::string& benchmark, const std::string& circuit, unsigned threads,
+            const std::function<run_func()>& setup );
+
+  std::vector<bench_result> run( const bench_config& config, std::ostream& os = std::cout ) const;
+
+private:
+  struct bench_case
+  {
+    std::string                benchmark;
+    std::string                circuit;
+    unsigned                   threads;
+    std::function<run_func()>  setup;
+  };
+
+  std::vector<bench_case> cases;
+};
+
+/* circuits */
+std::vector<std::string> bench_circuit_names();
+void generate_bench_circuit( const std::string& name, std::ostream& os );
+void generate_bench_circuits( const std::string& dir );
+std::vector<bench_circuit> read_bench_circuits( const bench_config& config );
+
+/* benchmark cases, one function per algorithm library */
+void add_classical_benchmarks( bench_suite& suite, const std::vector<bench_circuit>& circuits, const bench_config& config );
+void add_reversible_benchmarks( bench_suite& suite, const std::vector<bench_circuit>& circuits, const bench_config& config );
+
+/* results */
+void write_bench_results( const std::vector<bench_result>& results, const bench_config& config, std::ostream& os );
+std::vector<bench_result> read_bench_results( const std::string& filename );
+
+/**
+ * @brief Compares results against a baseline
+ *
+ * A case regresses if its median runtime exceeds the baseline median by
+ * more than the relative tolerance and by more than min_delta seconds
+ * (so that noise on very short cases is ignored), or if its checksum
+ * differs from the baseline.
+ *
+ * @return Number of regressions
+ */
+unsigned compare_bench_results( const std::vector<bench_result>& results, const std::vector<bench_result>& baseline,
+                                double tolerance, double min_delta, std::ostream& os = std::cout );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
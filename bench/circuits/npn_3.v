@@ -0,0 +1,822 @@
+module npn_0_1_2_3_4_5_6_7( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[0];
+  assign Fo[1] = F[1];
+  assign Fo[2] = F[2];
+  assign Fo[3] = F[3];
+  assign Fo[4] = F[4];
+  assign Fo[5] = F[5];
+  assign Fo[6] = F[6];
+  assign Fo[7] = F[7];
+endmodule
+
+module npn_0_1_4_5_2_3_6_7( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[0];
+  assign Fo[1] = F[1];
+  assign Fo[2] = F[4];
+  assign Fo[3] = F[5];
+  assign Fo[4] = F[2];
+  assign Fo[5] = F[3];
+  assign Fo[6] = F[6];
+  assign Fo[7] = F[7];
+endmodule
+
+module npn_0_4_1_5_2_6_3_7( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[0];
+  assign Fo[1] = F[4];
+  assign Fo[2] = F[1];
+  assign Fo[3] = F[5];
+  assign Fo[4] = F[2];
+  assign Fo[5] = F[6];
+  assign Fo[6] = F[3];
+  assign Fo[7] = F[7];
+endmodule
+
+module npn_0_4_2_6_1_5_3_7( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[0];
+  assign Fo[1] = F[4];
+  assign Fo[2] = F[2];
+  assign Fo[3] = F[6];
+  assign Fo[4] = F[1];
+  assign Fo[5] = F[5];
+  assign Fo[6] = F[3];
+  assign Fo[7] = F[7];
+endmodule
+
+module npn_0_2_4_6_1_3_5_7( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[0];
+  assign Fo[1] = F[2];
+  assign Fo[2] = F[4];
+  assign Fo[3] = F[6];
+  assign Fo[4] = F[1];
+  assign Fo[5] = F[3];
+  assign Fo[6] = F[5];
+  assign Fo[7] = F[7];
+endmodule
+
+module npn_0_2_1_3_4_6_5_7( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[0];
+  assign Fo[1] = F[2];
+  assign Fo[2] = F[1];
+  assign Fo[3] = F[3];
+  assign Fo[4] = F[4];
+  assign Fo[5] = F[6];
+  assign Fo[6] = F[5];
+  assign Fo[7] = F[7];
+endmodule
+
+module npn_1_0_3_2_5_4_7_6( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[1];
+  assign Fo[1] = F[0];
+  assign Fo[2] = F[3];
+  assign Fo[3] = F[2];
+  assign Fo[4] = F[5];
+  assign Fo[5] = F[4];
+  assign Fo[6] = F[7];
+  assign Fo[7] = F[6];
+endmodule
+
+module npn_1_0_5_4_3_2_7_6( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[1];
+  assign Fo[1] = F[0];
+  assign Fo[2] = F[5];
+  assign Fo[3] = F[4];
+  assign Fo[4] = F[3];
+  assign Fo[5] = F[2];
+  assign Fo[6] = F[7];
+  assign Fo[7] = F[6];
+endmodule
+
+module npn_1_5_0_4_3_7_2_6( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[1];
+  assign Fo[1] = F[5];
+  assign Fo[2] = F[0];
+  assign Fo[3] = F[4];
+  assign Fo[4] = F[3];
+  assign Fo[5] = F[7];
+  assign Fo[6] = F[2];
+  assign Fo[7] = F[6];
+endmodule
+
+module npn_1_5_3_7_0_4_2_6( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[1];
+  assign Fo[1] = F[5];
+  assign Fo[2] = F[3];
+  assign Fo[3] = F[7];
+  assign Fo[4] = F[0];
+  assign Fo[5] = F[4];
+  assign Fo[6] = F[2];
+  assign Fo[7] = F[6];
+endmodule
+
+module npn_1_3_5_7_0_2_4_6( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[1];
+  assign Fo[1] = F[3];
+  assign Fo[2] = F[5];
+  assign Fo[3] = F[7];
+  assign Fo[4] = F[0];
+  assign Fo[5] = F[2];
+  assign Fo[6] = F[4];
+  assign Fo[7] = F[6];
+endmodule
+
+module npn_1_3_0_2_5_7_4_6( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[1];
+  assign Fo[1] = F[3];
+  assign Fo[2] = F[0];
+  assign Fo[3] = F[2];
+  assign Fo[4] = F[5];
+  assign Fo[5] = F[7];
+  assign Fo[6] = F[4];
+  assign Fo[7] = F[6];
+endmodule
+
+module npn_3_2_1_0_7_6_5_4( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[3];
+  assign Fo[1] = F[2];
+  assign Fo[2] = F[1];
+  assign Fo[3] = F[0];
+  assign Fo[4] = F[7];
+  assign Fo[5] = F[6];
+  assign Fo[6] = F[5];
+  assign Fo[7] = F[4];
+endmodule
+
+module npn_3_2_7_6_1_0_5_4( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[3];
+  assign Fo[1] = F[2];
+  assign Fo[2] = F[7];
+  assign Fo[3] = F[6];
+  assign Fo[4] = F[1];
+  assign Fo[5] = F[0];
+  assign Fo[6] = F[5];
+  assign Fo[7] = F[4];
+endmodule
+
+module npn_3_7_2_6_1_5_0_4( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[3];
+  assign Fo[1] = F[7];
+  assign Fo[2] = F[2];
+  assign Fo[3] = F[6];
+  assign Fo[4] = F[1];
+  assign Fo[5] = F[5];
+  assign Fo[6] = F[0];
+  assign Fo[7] = F[4];
+endmodule
+
+module npn_3_7_1_5_2_6_0_4( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[3];
+  assign Fo[1] = F[7];
+  assign Fo[2] = F[1];
+  assign Fo[3] = F[5];
+  assign Fo[4] = F[2];
+  assign Fo[5] = F[6];
+  assign Fo[6] = F[0];
+  assign Fo[7] = F[4];
+endmodule
+
+module npn_3_1_7_5_2_0_6_4( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[3];
+  assign Fo[1] = F[1];
+  assign Fo[2] = F[7];
+  assign Fo[3] = F[5];
+  assign Fo[4] = F[2];
+  assign Fo[5] = F[0];
+  assign Fo[6] = F[6];
+  assign Fo[7] = F[4];
+endmodule
+
+module npn_3_1_2_0_7_5_6_4( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[3];
+  assign Fo[1] = F[1];
+  assign Fo[2] = F[2];
+  assign Fo[3] = F[0];
+  assign Fo[4] = F[7];
+  assign Fo[5] = F[5];
+  assign Fo[6] = F[6];
+  assign Fo[7] = F[4];
+endmodule
+
+module npn_2_3_0_1_6_7_4_5( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[2];
+  assign Fo[1] = F[3];
+  assign Fo[2] = F[0];
+  assign Fo[3] = F[1];
+  assign Fo[4] = F[6];
+  assign Fo[5] = F[7];
+  assign Fo[6] = F[4];
+  assign Fo[7] = F[5];
+endmodule
+
+module npn_2_3_6_7_0_1_4_5( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[2];
+  assign Fo[1] = F[3];
+  assign Fo[2] = F[6];
+  assign Fo[3] = F[7];
+  assign Fo[4] = F[0];
+  assign Fo[5] = F[1];
+  assign Fo[6] = F[4];
+  assign Fo[7] = F[5];
+endmodule
+
+module npn_2_6_3_7_0_4_1_5( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[2];
+  assign Fo[1] = F[6];
+  assign Fo[2] = F[3];
+  assign Fo[3] = F[7];
+  assign Fo[4] = F[0];
+  assign Fo[5] = F[4];
+  assign Fo[6] = F[1];
+  assign Fo[7] = F[5];
+endmodule
+
+module npn_2_6_0_4_3_7_1_5( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[2];
+  assign Fo[1] = F[6];
+  assign Fo[2] = F[0];
+  assign Fo[3] = F[4];
+  assign Fo[4] = F[3];
+  assign Fo[5] = F[7];
+  assign Fo[6] = F[1];
+  assign Fo[7] = F[5];
+endmodule
+
+module npn_2_0_6_4_3_1_7_5( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[2];
+  assign Fo[1] = F[0];
+  assign Fo[2] = F[6];
+  assign Fo[3] = F[4];
+  assign Fo[4] = F[3];
+  assign Fo[5] = F[1];
+  assign Fo[6] = F[7];
+  assign Fo[7] = F[5];
+endmodule
+
+module npn_2_0_3_1_6_4_7_5( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[2];
+  assign Fo[1] = F[0];
+  assign Fo[2] = F[3];
+  assign Fo[3] = F[1];
+  assign Fo[4] = F[6];
+  assign Fo[5] = F[4];
+  assign Fo[6] = F[7];
+  assign Fo[7] = F[5];
+endmodule
+
+module npn_6_7_4_5_2_3_0_1( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[6];
+  assign Fo[1] = F[7];
+  assign Fo[2] = F[4];
+  assign Fo[3] = F[5];
+  assign Fo[4] = F[2];
+  assign Fo[5] = F[3];
+  assign Fo[6] = F[0];
+  assign Fo[7] = F[1];
+endmodule
+
+module npn_6_7_2_3_4_5_0_1( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[6];
+  assign Fo[1] = F[7];
+  assign Fo[2] = F[2];
+  assign Fo[3] = F[3];
+  assign Fo[4] = F[4];
+  assign Fo[5] = F[5];
+  assign Fo[6] = F[0];
+  assign Fo[7] = F[1];
+endmodule
+
+module npn_6_2_7_3_4_0_5_1( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[6];
+  assign Fo[1] = F[2];
+  assign Fo[2] = F[7];
+  assign Fo[3] = F[3];
+  assign Fo[4] = F[4];
+  assign Fo[5] = F[0];
+  assign Fo[6] = F[5];
+  assign Fo[7] = F[1];
+endmodule
+
+module npn_6_2_4_0_7_3_5_1( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[6];
+  assign Fo[1] = F[2];
+  assign Fo[2] = F[4];
+  assign Fo[3] = F[0];
+  assign Fo[4] = F[7];
+  assign Fo[5] = F[3];
+  assign Fo[6] = F[5];
+  assign Fo[7] = F[1];
+endmodule
+
+module npn_6_4_2_0_7_5_3_1( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[6];
+  assign Fo[1] = F[4];
+  assign Fo[2] = F[2];
+  assign Fo[3] = F[0];
+  assign Fo[4] = F[7];
+  assign Fo[5] = F[5];
+  assign Fo[6] = F[3];
+  assign Fo[7] = F[1];
+endmodule
+
+module npn_6_4_7_5_2_0_3_1( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[6];
+  assign Fo[1] = F[4];
+  assign Fo[2] = F[7];
+  assign Fo[3] = F[5];
+  assign Fo[4] = F[2];
+  assign Fo[5] = F[0];
+  assign Fo[6] = F[3];
+  assign Fo[7] = F[1];
+endmodule
+
+module npn_7_6_5_4_3_2_1_0( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[7];
+  assign Fo[1] = F[6];
+  assign Fo[2] = F[5];
+  assign Fo[3] = F[4];
+  assign Fo[4] = F[3];
+  assign Fo[5] = F[2];
+  assign Fo[6] = F[1];
+  assign Fo[7] = F[0];
+endmodule
+
+module npn_7_6_3_2_5_4_1_0( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[7];
+  assign Fo[1] = F[6];
+  assign Fo[2] = F[3];
+  assign Fo[3] = F[2];
+  assign Fo[4] = F[5];
+  assign Fo[5] = F[4];
+  assign Fo[6] = F[1];
+  assign Fo[7] = F[0];
+endmodule
+
+module npn_7_3_6_2_5_1_4_0( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[7];
+  assign Fo[1] = F[3];
+  assign Fo[2] = F[6];
+  assign Fo[3] = F[2];
+  assign Fo[4] = F[5];
+  assign Fo[5] = F[1];
+  assign Fo[6] = F[4];
+  assign Fo[7] = F[0];
+endmodule
+
+module npn_7_3_5_1_6_2_4_0( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[7];
+  assign Fo[1] = F[3];
+  assign Fo[2] = F[5];
+  assign Fo[3] = F[1];
+  assign Fo[4] = F[6];
+  assign Fo[5] = F[2];
+  assign Fo[6] = F[4];
+  assign Fo[7] = F[0];
+endmodule
+
+module npn_7_5_3_1_6_4_2_0( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[7];
+  assign Fo[1] = F[5];
+  assign Fo[2] = F[3];
+  assign Fo[3] = F[1];
+  assign Fo[4] = F[6];
+  assign Fo[5] = F[4];
+  assign Fo[6] = F[2];
+  assign Fo[7] = F[0];
+endmodule
+
+module npn_7_5_6_4_3_1_2_0( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[7];
+  assign Fo[1] = F[5];
+  assign Fo[2] = F[6];
+  assign Fo[3] = F[4];
+  assign Fo[4] = F[3];
+  assign Fo[5] = F[1];
+  assign Fo[6] = F[2];
+  assign Fo[7] = F[0];
+endmodule
+
+module npn_5_4_7_6_1_0_3_2( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[5];
+  assign Fo[1] = F[4];
+  assign Fo[2] = F[7];
+  assign Fo[3] = F[6];
+  assign Fo[4] = F[1];
+  assign Fo[5] = F[0];
+  assign Fo[6] = F[3];
+  assign Fo[7] = F[2];
+endmodule
+
+module npn_5_4_1_0_7_6_3_2( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[5];
+  assign Fo[1] = F[4];
+  assign Fo[2] = F[1];
+  assign Fo[3] = F[0];
+  assign Fo[4] = F[7];
+  assign Fo[5] = F[6];
+  assign Fo[6] = F[3];
+  assign Fo[7] = F[2];
+endmodule
+
+module npn_5_1_4_0_7_3_6_2( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[5];
+  assign Fo[1] = F[1];
+  assign Fo[2] = F[4];
+  assign Fo[3] = F[0];
+  assign Fo[4] = F[7];
+  assign Fo[5] = F[3];
+  assign Fo[6] = F[6];
+  assign Fo[7] = F[2];
+endmodule
+
+module npn_5_1_7_3_4_0_6_2( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[5];
+  assign Fo[1] = F[1];
+  assign Fo[2] = F[7];
+  assign Fo[3] = F[3];
+  assign Fo[4] = F[4];
+  assign Fo[5] = F[0];
+  assign Fo[6] = F[6];
+  assign Fo[7] = F[2];
+endmodule
+
+module npn_5_7_1_3_4_6_0_2( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[5];
+  assign Fo[1] = F[7];
+  assign Fo[2] = F[1];
+  assign Fo[3] = F[3];
+  assign Fo[4] = F[4];
+  assign Fo[5] = F[6];
+  assign Fo[6] = F[0];
+  assign Fo[7] = F[2];
+endmodule
+
+module npn_5_7_4_6_1_3_0_2( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[5];
+  assign Fo[1] = F[7];
+  assign Fo[2] = F[4];
+  assign Fo[3] = F[6];
+  assign Fo[4] = F[1];
+  assign Fo[5] = F[3];
+  assign Fo[6] = F[0];
+  assign Fo[7] = F[2];
+endmodule
+
+module npn_4_5_6_7_0_1_2_3( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[4];
+  assign Fo[1] = F[5];
+  assign Fo[2] = F[6];
+  assign Fo[3] = F[7];
+  assign Fo[4] = F[0];
+  assign Fo[5] = F[1];
+  assign Fo[6] = F[2];
+  assign Fo[7] = F[3];
+endmodule
+
+module npn_4_5_0_1_6_7_2_3( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[4];
+  assign Fo[1] = F[5];
+  assign Fo[2] = F[0];
+  assign Fo[3] = F[1];
+  assign Fo[4] = F[6];
+  assign Fo[5] = F[7];
+  assign Fo[6] = F[2];
+  assign Fo[7] = F[3];
+endmodule
+
+module npn_4_0_5_1_6_2_7_3( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[4];
+  assign Fo[1] = F[0];
+  assign Fo[2] = F[5];
+  assign Fo[3] = F[1];
+  assign Fo[4] = F[6];
+  assign Fo[5] = F[2];
+  assign Fo[6] = F[7];
+  assign Fo[7] = F[3];
+endmodule
+
+module npn_4_0_6_2_5_1_7_3( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[4];
+  assign Fo[1] = F[0];
+  assign Fo[2] = F[6];
+  assign Fo[3] = F[2];
+  assign Fo[4] = F[5];
+  assign Fo[5] = F[1];
+  assign Fo[6] = F[7];
+  assign Fo[7] = F[3];
+endmodule
+
+module npn_4_6_0_2_5_7_1_3( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[4];
+  assign Fo[1] = F[6];
+  assign Fo[2] = F[0];
+  assign Fo[3] = F[2];
+  assign Fo[4] = F[5];
+  assign Fo[5] = F[7];
+  assign Fo[6] = F[1];
+  assign Fo[7] = F[3];
+endmodule
+
+module npn_4_6_5_7_0_2_1_3( F, Fo );
+  input  [7:0] F;
+  output [7:0] Fo;
+  assign Fo[0] = F[4];
+  assign Fo[1] = F[6];
+  assign Fo[2] = F[5];
+  assign Fo[3] = F[7];
+  assign Fo[4] = F[0];
+  assign Fo[5] = F[2];
+  assign Fo[6] = F[1];
+  assign Fo[7] = F[3];
+endmodule
+
+module npn_circuit( F, Fr );
+  input  [7:0] F;
+  output [7:0] Fr;
+  wire   [7:0] F_0_1_2_3_4_5_6_7_pos, F_0_1_2_3_4_5_6_7_neg, F_0_1_4_5_2_3_6_7_pos, F_0_1_4_5_2_3_6_7_neg, F_0_4_1_5_2_6_3_7_pos, F_0_4_1_5_2_6_3_7_neg, F_0_4_2_6_1_5_3_7_pos, F_0_4_2_6_1_5_3_7_neg, F_0_2_4_6_1_3_5_7_pos, F_0_2_4_6_1_3_5_7_neg, F_0_2_1_3_4_6_5_7_pos, F_0_2_1_3_4_6_5_7_neg, F_1_0_3_2_5_4_7_6_pos, F_1_0_3_2_5_4_7_6_neg, F_1_0_5_4_3_2_7_6_pos, F_1_0_5_4_3_2_7_6_neg, F_1_5_0_4_3_7_2_6_pos, F_1_5_0_4_3_7_2_6_neg, F_1_5_3_7_0_4_2_6_pos, F_1_5_3_7_0_4_2_6_neg, F_1_3_5_7_0_2_4_6_pos, F_1_3_5_7_0_2_4_6_neg, F_1_3_0_2_5_7_4_6_pos, F_1_3_0_2_5_7_4_6_neg, F_3_2_1_0_7_6_5_4_pos, F_3_2_1_0_7_6_5_4_neg, F_3_2_7_6_1_0_5_4_pos, F_3_2_7_6_1_0_5_4_neg, F_3_7_2_6_1_5_0_4_pos, F_3_7_2_6_1_5_0_4_neg, F_3_7_1_5_2_6_0_4_pos, F_3_7_1_5_2_6_0_4_neg, F_3_1_7_5_2_0_6_4_pos, F_3_1_7_5_2_0_6_4_neg, F_3_1_2_0_7_5_6_4_pos, F_3_1_2_0_7_5_6_4_neg, F_2_3_0_1_6_7_4_5_pos, F_2_3_0_1_6_7_4_5_neg, F_2_3_6_7_0_1_4_5_pos, F_2_3_6_7_0_1_4_5_neg, F_2_6_3_7_0_4_1_5_pos, F_2_6_3_7_0_4_1_5_neg, F_2_6_0_4_3_7_1_5_pos, F_2_6_0_4_3_7_1_5_neg, F_2_0_6_4_3_1_7_5_pos, F_2_0_6_4_3_1_7_5_neg, F_2_0_3_1_6_4_7_5_pos, F_2_0_3_1_6_4_7_5_neg, F_6_7_4_5_2_3_0_1_pos, F_6_7_4_5_2_3_0_1_neg, F_6_7_2_3_4_5_0_1_pos, F_6_7_2_3_4_5_0_1_neg, F_6_2_7_3_4_0_5_1_pos, F_6_2_7_3_4_0_5_1_neg, F_6_2_4_0_7_3_5_1_pos, F_6_2_4_0_7_3_5_1_neg, F_6_4_2_0_7_5_3_1_pos, F_6_4_2_0_7_5_3_1_neg, F_6_4_7_5_2_0_3_1_pos, F_6_4_7_5_2_0_3_1_neg, F_7_6_5_4_3_2_1_0_pos, F_7_6_5_4_3_2_1_0_neg, F_7_6_3_2_5_4_1_0_pos, F_7_6_3_2_5_4_1_0_neg, F_7_3_6_2_5_1_4_0_pos, F_7_3_6_2_5_1_4_0_neg, F_7_3_5_1_6_2_4_0_pos, F_7_3_5_1_6_2_4_0_neg, F_7_5_3_1_6_4_2_0_pos, F_7_5_3_1_6_4_2_0_neg, F_7_5_6_4_3_1_2_0_pos, F_7_5_6_4_3_1_2_0_neg, F_5_4_7_6_1_0_3_2_pos, F_5_4_7_6_1_0_3_2_neg, F_5_4_1_0_7_6_3_2_pos, F_5_4_1_0_7_6_3_2_neg, F_5_1_4_0_7_3_6_2_pos, F_5_1_4_0_7_3_6_2_neg, F_5_1_7_3_4_0_6_2_pos, F_5_1_7_3_4_0_6_2_neg, F_5_7_1_3_4_6_0_2_pos, F_5_7_1_3_4_6_0_2_neg, F_5_7_4_6_1_3_0_2_pos, F_5_7_4_6_1_3_0_2_neg, F_4_5_6_7_0_1_2_3_pos, F_4_5_6_7_0_1_2_3_neg, F_4_5_0_1_6_7_2_3_pos, F_4_5_0_1_6_7_2_3_neg, F_4_0_5_1_6_2_7_3_pos, F_4_0_5_1_6_2_7_3_neg, F_4_0_6_2_5_1_7_3_pos, F_4_0_6_2_5_1_7_3_neg, F_4_6_0_2_5_7_1_3_pos, F_4_6_0_2_5_7_1_3_neg, F_4_6_5_7_0_2_1_3_pos, F_4_6_5_7_0_2_1_3_neg, w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15, w16, w17, w18, w19, w20, w21, w22, w23, w24, w25, w26, w27, w28, w29, w30, w31, w32, w33, w34, w35, w36, w37, w38, w39, w40, w41, w42, w43, w44, w45, w46, w47, w48, w49, w50, w51, w52, w53, w54, w55, w56, w57, w58, w59, w60, w61, w62, w63, w64, w65, w66, w67, w68, w69, w70, w71, w72, w73, w74, w75, w76, w77, w78, w79, w80, w81, w82, w83, w84, w85, w86, w87, w88, w89, w90, w91, w92, w93, w94;  npn_0_1_2_3_4_5_6_7 inst_0_1_2_3_4_5_6_7_pos(  F, F_0_1_2_3_4_5_6_7_pos );
+  npn_0_1_2_3_4_5_6_7 inst_0_1_2_3_4_5_6_7_neg( ~F, F_0_1_2_3_4_5_6_7_neg );
+  npn_0_1_4_5_2_3_6_7 inst_0_1_4_5_2_3_6_7_pos(  F, F_0_1_4_5_2_3_6_7_pos );
+  npn_0_1_4_5_2_3_6_7 inst_0_1_4_5_2_3_6_7_neg( ~F, F_0_1_4_5_2_3_6_7_neg );
+  npn_0_4_1_5_2_6_3_7 inst_0_4_1_5_2_6_3_7_pos(  F, F_0_4_1_5_2_6_3_7_pos );
+  npn_0_4_1_5_2_6_3_7 inst_0_4_1_5_2_6_3_7_neg( ~F, F_0_4_1_5_2_6_3_7_neg );
+  npn_0_4_2_6_1_5_3_7 inst_0_4_2_6_1_5_3_7_pos(  F, F_0_4_2_6_1_5_3_7_pos );
+  npn_0_4_2_6_1_5_3_7 inst_0_4_2_6_1_5_3_7_neg( ~F, F_0_4_2_6_1_5_3_7_neg );
+  npn_0_2_4_6_1_3_5_7 inst_0_2_4_6_1_3_5_7_pos(  F, F_0_2_4_6_1_3_5_7_pos );
+  npn_0_2_4_6_1_3_5_7 inst_0_2_4_6_1_3_5_7_neg( ~F, F_0_2_4_6_1_3_5_7_neg );
+  npn_0_2_1_3_4_6_5_7 inst_0_2_1_3_4_6_5_7_pos(  F, F_0_2_1_3_4_6_5_7_pos );
+  npn_0_2_1_3_4_6_5_7 inst_0_2_1_3_4_6_5_7_neg( ~F, F_0_2_1_3_4_6_5_7_neg );
+  npn_1_0_3_2_5_4_7_6 inst_1_0_3_2_5_4_7_6_pos(  F, F_1_0_3_2_5_4_7_6_pos );
+  npn_1_0_3_2_5_4_7_6 inst_1_0_3_2_5_4_7_6_neg( ~F, F_1_0_3_2_5_4_7_6_neg );
+  npn_1_0_5_4_3_2_7_6 inst_1_0_5_4_3_2_7_6_pos(  F, F_1_0_5_4_3_2_7_6_pos );
+  npn_1_0_5_4_3_2_7_6 inst_1_0_5_4_3_2_7_6_neg( ~F, F_1_0_5_4_3_2_7_6_neg );
+  npn_1_5_0_4_3_7_2_6 inst_1_5_0_4_3_7_2_6_pos(  F, F_1_5_0_4_3_7_2_6_pos );
+  npn_1_5_0_4_3_7_2_6 inst_1_5_0_4_3_7_2_6_neg( ~F, F_1_5_0_4_3_7_2_6_neg );
+  npn_1_5_3_7_0_4_2_6 inst_1_5_3_7_0_4_2_6_pos(  F, F_1_5_3_7_0_4_2_6_pos );
+  npn_1_5_3_7_0_4_2_6 inst_1_5_3_7_0_4_2_6_neg( ~F, F_1_5_3_7_0_4_2_6_neg );
+  npn_1_3_5_7_0_2_4_6 inst_1_3_5_7_0_2_4_6_pos(  F, F_1_3_5_7_0_2_4_6_pos );
+  npn_1_3_5_7_0_2_4_6 inst_1_3_5_7_0_2_4_6_neg( ~F, F_1_3_5_7_0_2_4_6_neg );
+  npn_1_3_0_2_5_7_4_6 inst_1_3_0_2_5_7_4_6_pos(  F, F_1_3_0_2_5_7_4_6_pos );
+  npn_1_3_0_2_5_7_4_6 inst_1_3_0_2_5_7_4_6_neg( ~F, F_1_3_0_2_5_7_4_6_neg );
+  npn_3_2_1_0_7_6_5_4 inst_3_2_1_0_7_6_5_4_pos(  F, F_3_2_1_0_7_6_5_4_pos );
+  npn_3_2_1_0_7_6_5_4 inst_3_2_1_0_7_6_5_4_neg( ~F, F_3_2_1_0_7_6_5_4_neg );
+  npn_3_2_7_6_1_0_5_4 inst_3_2_7_6_1_0_5_4_pos(  F, F_3_2_7_6_1_0_5_4_pos );
+  npn_3_2_7_6_1_0_5_4 inst_3_2_7_6_1_0_5_4_neg( ~F, F_3_2_7_6_1_0_5_4_neg );
+  npn_3_7_2_6_1_5_0_4 inst_3_7_2_6_1_5_0_4_pos(  F, F_3_7_2_6_1_5_0_4_pos );
+  npn_3_7_2_6_1_5_0_4 inst_3_7_2_6_1_5_0_4_neg( ~F, F_3_7_2_6_1_5_0_4_neg );
+  npn_3_7_1_5_2_6_0_4 inst_3_7_1_5_2_6_0_4_pos(  F, F_3_7_1_5_2_6_0_4_pos );
+  npn_3_7_1_5_2_6_0_4 inst_3_7_1_5_2_6_0_4_neg( ~F, F_3_7_1_5_2_6_0_4_neg );
+  npn_3_1_7_5_2_0_6_4 inst_3_1_7_5_2_0_6_4_pos(  F, F_3_1_7_5_2_0_6_4_pos );
+  npn_3_1_7_5_2_0_6_4 inst_3_1_7_5_2_0_6_4_neg( ~F, F_3_1_7_5_2_0_6_4_neg );
+  npn_3_1_2_0_7_5_6_4 inst_3_1_2_0_7_5_6_4_pos(  F, F_3_1_2_0_7_5_6_4_pos );
+  npn_3_1_2_0_7_5_6_4 inst_3_1_2_0_7_5_6_4_neg( ~F, F_3_1_2_0_7_5_6_4_neg );
+  npn_2_3_0_1_6_7_4_5 inst_2_3_0_1_6_7_4_5_pos(  F, F_2_3_0_1_6_7_4_5_pos );
+  npn_2_3_0_1_6_7_4_5 inst_2_3_0_1_6_7_4_5_neg( ~F, F_2_3_0_1_6_7_4_5_neg );
+  npn_2_3_6_7_0_1_4_5 inst_2_3_6_7_0_1_4_5_pos(  F, F_2_3_6_7_0_1_4_5_pos );
+  npn_2_3_6_7_0_1_4_5 inst_2_3_6_7_0_1_4_5_neg( ~F, F_2_3_6_7_0_1_4_5_neg );
+  npn_2_6_3_7_0_4_1_5 inst_2_6_3_7_0_4_1_5_pos(  F, F_2_6_3_7_0_4_1_5_pos );
+  npn_2_6_3_7_0_4_1_5 inst_2_6_3_7_0_4_1_5_neg( ~F, F_2_6_3_7_0_4_1_5_neg );
+  npn_2_6_0_4_3_7_1_5 inst_2_6_0_4_3_7_1_5_pos(  F, F_2_6_0_4_3_7_1_5_pos );
+  npn_2_6_0_4_3_7_1_5 inst_2_6_0_4_3_7_1_5_neg( ~F, F_2_6_0_4_3_7_1_5_neg );
+  npn_2_0_6_4_3_1_7_5 inst_2_0_6_4_3_1_7_5_pos(  F, F_2_0_6_4_3_1_7_5_pos );
+  npn_2_0_6_4_3_1_7_5 inst_2_0_6_4_3_1_7_5_neg( ~F, F_2_0_6_4_3_1_7_5_neg );
+  npn_2_0_3_1_6_4_7_5 inst_2_0_3_1_6_4_7_5_pos(  F, F_2_0_3_1_6_4_7_5_pos );
+  npn_2_0_3_1_6_4_7_5 inst_2_0_3_1_6_4_7_5_neg( ~F, F_2_0_3_1_6_4_7_5_neg );
+  npn_6_7_4_5_2_3_0_1 inst_6_7_4_5_2_3_0_1_pos(  F, F_6_7_4_5_2_3_0_1_pos );
+  npn_6_7_4_5_2_3_0_1 inst_6_7_4_5_2_3_0_1_neg( ~F, F_6_7_4_5_2_3_0_1_neg );
+  npn_6_7_2_3_4_5_0_1 inst_6_7_2_3_4_5_0_1_pos(  F, F_6_7_2_3_4_5_0_1_pos );
+  npn_6_7_2_3_4_5_0_1 inst_6_7_2_3_4_5_0_1_neg( ~F, F_6_7_2_3_4_5_0_1_neg );
+  npn_6_2_7_3_4_0_5_1 inst_6_2_7_3_4_0_5_1_pos(  F, F_6_2_7_3_4_0_5_1_pos );
+  npn_6_2_7_3_4_0_5_1 inst_6_2_7_3_4_0_5_1_neg( ~F, F_6_2_7_3_4_0_5_1_neg );
+  npn_6_2_4_0_7_3_5_1 inst_6_2_4_0_7_3_5_1_pos(  F, F_6_2_4_0_7_3_5_1_pos );
+  npn_6_2_4_0_7_3_5_1 inst_6_2_4_0_7_3_5_1_neg( ~F, F_6_2_4_0_7_3_5_1_neg );
+  npn_6_4_2_0_7_5_3_1 inst_6_4_2_0_7_5_3_1_pos(  F, F_6_4_2_0_7_5_3_1_pos );
+  npn_6_4_2_0_7_5_3_1 inst_6_4_2_0_7_5_3_1_neg( ~F, F_6_4_2_0_7_5_3_1_neg );
+  npn_6_4_7_5_2_0_3_1 inst_6_4_7_5_2_0_3_1_pos(  F, F_6_4_7_5_2_0_3_1_pos );
+  npn_6_4_7_5_2_0_3_1 inst_6_4_7_5_2_0_3_1_neg( ~F, F_6_4_7_5_2_0_3_1_neg );
+  npn_7_6_5_4_3_2_1_0 inst_7_6_5_4_3_2_1_0_pos(  F, F_7_6_5_4_3_2_1_0_pos );
+  npn_7_6_5_4_3_2_1_0 inst_7_6_5_4_3_2_1_0_neg( ~F, F_7_6_5_4_3_2_1_0_neg );
+  npn_7_6_3_2_5_4_1_0 inst_7_6_3_2_5_4_1_0_pos(  F, F_7_6_3_2_5_4_1_0_pos );
+  npn_7_6_3_2_5_4_1_0 inst_7_6_3_2_5_4_1_0_neg( ~F, F_7_6_3_2_5_4_1_0_neg );
+  npn_7_3_6_2_5_1_4_0 inst_7_3_6_2_5_1_4_0_pos(  F, F_7_3_6_2_5_1_4_0_pos );
+  npn_7_3_6_2_5_1_4_0 inst_7_3_6_2_5_1_4_0_neg( ~F, F_7_3_6_2_5_1_4_0_neg );
+  npn_7_3_5_1_6_2_4_0 inst_7_3_5_1_6_2_4_0_pos(  F, F_7_3_5_1_6_2_4_0_pos );
+  npn_7_3_5_1_6_2_4_0 inst_7_3_5_1_6_2_4_0_neg( ~F, F_7_3_5_1_6_2_4_0_neg );
+  npn_7_5_3_1_6_4_2_0 inst_7_5_3_1_6_4_2_0_pos(  F, F_7_5_3_1_6_4_2_0_pos );
+  npn_7_5_3_1_6_4_2_0 inst_7_5_3_1_6_4_2_0_neg( ~F, F_7_5_3_1_6_4_2_0_neg );
+  npn_7_5_6_4_3_1_2_0 inst_7_5_6_4_3_1_2_0_pos(  F, F_7_5_6_4_3_1_2_0_pos );
+  npn_7_5_6_4_3_1_2_0 inst_7_5_6_4_3_1_2_0_neg( ~F, F_7_5_6_4_3_1_2_0_neg );
+  npn_5_4_7_6_1_0_3_2 inst_5_4_7_6_1_0_3_2_pos(  F, F_5_4_7_6_1_0_3_2_pos );
+  npn_5_4_7_6_1_0_3_2 inst_5_4_7_6_1_0_3_2_neg( ~F, F_5_4_7_6_1_0_3_2_neg );
+  npn_5_4_1_0_7_6_3_2 inst_5_4_1_0_7_6_3_2_pos(  F, F_5_4_1_0_7_6_3_2_pos );
+  npn_5_4_1_0_7_6_3_2 inst_5_4_1_0_7_6_3_2_neg( ~F, F_5_4_1_0_7_6_3_2_neg );
+  npn_5_1_4_0_7_3_6_2 inst_5_1_4_0_7_3_6_2_pos(  F, F_5_1_4_0_7_3_6_2_pos );
+  npn_5_1_4_0_7_3_6_2 inst_5_1_4_0_7_3_6_2_neg( ~F, F_5_1_4_0_7_3_6_2_neg );
+  npn_5_1_7_3_4_0_6_2 inst_5_1_7_3_4_0_6_2_pos(  F, F_5_1_7_3_4_0_6_2_pos );
+  npn_5_1_7_3_4_0_6_2 inst_5_1_7_3_4_0_6_2_neg( ~F, F_5_1_7_3_4_0_6_2_neg );
+  npn_5_7_1_3_4_6_0_2 inst_5_7_1_3_4_6_0_2_pos(  F, F_5_7_1_3_4_6_0_2_pos );
+  npn_5_7_1_3_4_6_0_2 inst_5_7_1_3_4_6_0_2_neg( ~F, F_5_7_1_3_4_6_0_2_neg );
+  npn_5_7_4_6_1_3_0_2 inst_5_7_4_6_1_3_0_2_pos(  F, F_5_7_4_6_1_3_0_2_pos );
+  npn_5_7_4_6_1_3_0_2 inst_5_7_4_6_1_3_0_2_neg( ~F, F_5_7_4_6_1_3_0_2_neg );
+  npn_4_5_6_7_0_1_2_3 inst_4_5_6_7_0_1_2_3_pos(  F, F_4_5_6_7_0_1_2_3_pos );
+  npn_4_5_6_7_0_1_2_3 inst_4_5_6_7_0_1_2_3_neg( ~F, F_4_5_6_7_0_1_2_3_neg );
+  npn_4_5_0_1_6_7_2_3 inst_4_5_0_1_6_7_2_3_pos(  F, F_4_5_0_1_6_7_2_3_pos );
+  npn_4_5_0_1_6_7_2_3 inst_4_5_0_1_6_7_2_3_neg( ~F, F_4_5_0_1_6_7_2_3_neg );
+  npn_4_0_5_1_6_2_7_3 inst_4_0_5_1_6_2_7_3_pos(  F, F_4_0_5_1_6_2_7_3_pos );
+  npn_4_0_5_1_6_2_7_3 inst_4_0_5_1_6_2_7_3_neg( ~F, F_4_0_5_1_6_2_7_3_neg );
+  npn_4_0_6_2_5_1_7_3 inst_4_0_6_2_5_1_7_3_pos(  F, F_4_0_6_2_5_1_7_3_pos );
+  npn_4_0_6_2_5_1_7_3 inst_4_0_6_2_5_1_7_3_neg( ~F, F_4_0_6_2_5_1_7_3_neg );
+  npn_4_6_0_2_5_7_1_3 inst_4_6_0_2_5_7_1_3_pos(  F, F_4_6_0_2_5_7_1_3_pos );
+  npn_4_6_0_2_5_7_1_3 inst_4_6_0_2_5_7_1_3_neg( ~F, F_4_6_0_2_5_7_1_3_neg );
+  npn_4_6_5_7_0_2_1_3 inst_4_6_5_7_0_2_1_3_pos(  F, F_4_6_5_7_0_2_1_3_pos );
+  npn_4_6_5_7_0_2_1_3 inst_4_6_5_7_0_2_1_3_neg( ~F, F_4_6_5_7_0_2_1_3_neg );
+
+  assign w0 = F_0_1_2_3_4_5_6_7_pos < F_0_1_2_3_4_5_6_7_neg ? F_0_1_2_3_4_5_6_7_pos : F_0_1_2_3_4_5_6_7_neg;
+  assign w1 = F_0_1_4_5_2_3_6_7_pos < F_0_1_4_5_2_3_6_7_neg ? F_0_1_4_5_2_3_6_7_pos : F_0_1_4_5_2_3_6_7_neg;
+  assign w2 = F_0_4_1_5_2_6_3_7_pos < F_0_4_1_5_2_6_3_7_neg ? F_0_4_1_5_2_6_3_7_pos : F_0_4_1_5_2_6_3_7_neg;
+  assign w3 = F_0_4_2_6_1_5_3_7_pos < F_0_4_2_6_1_5_3_7_neg ? F_0_4_2_6_1_5_3_7_pos : F_0_4_2_6_1_5_3_7_neg;
+  assign w4 = F_0_2_4_6_1_3_5_7_pos < F_0_2_4_6_1_3_5_7_neg ? F_0_2_4_6_1_3_5_7_pos : F_0_2_4_6_1_3_5_7_neg;
+  assign w5 = F_0_2_1_3_4_6_5_7_pos < F_0_2_1_3_4_6_5_7_neg ? F_0_2_1_3_4_6_5_7_pos : F_0_2_1_3_4_6_5_7_neg;
+  assign w6 = F_1_0_3_2_5_4_7_6_pos < F_1_0_3_2_5_4_7_6_neg ? F_1_0_3_2_5_4_7_6_pos : F_1_0_3_2_5_4_7_6_neg;
+  assign w7 = F_1_0_5_4_3_2_7_6_pos < F_1_0_5_4_3_2_7_6_neg ? F_1_0_5_4_3_2_7_6_pos : F_1_0_5_4_3_2_7_6_neg;
+  assign w8 = F_1_5_0_4_3_7_2_6_pos < F_1_5_0_4_3_7_2_6_neg ? F_1_5_0_4_3_7_2_6_pos : F_1_5_0_4_3_7_2_6_neg;
+  assign w9 = F_1_5_3_7_0_4_2_6_pos < F_1_5_3_7_0_4_2_6_neg ? F_1_5_3_7_0_4_2_6_pos : F_1_5_3_7_0_4_2_6_neg;
+  assign w10 = F_1_3_5_7_0_2_4_6_pos < F_1_3_5_7_0_2_4_6_neg ? F_1_3_5_7_0_2_4_6_pos : F_1_3_5_7_0_2_4_6_neg;
+  assign w11 = F_1_3_0_2_5_7_4_6_pos < F_1_3_0_2_5_7_4_6_neg ? F_1_3_0_2_5_7_4_6_pos : F_1_3_0_2_5_7_4_6_neg;
+  assign w12 = F_3_2_1_0_7_6_5_4_pos < F_3_2_1_0_7_6_5_4_neg ? F_3_2_1_0_7_6_5_4_pos : F_3_2_1_0_7_6_5_4_neg;
+  assign w13 = F_3_2_7_6_1_0_5_4_pos < F_3_2_7_6_1_0_5_4_neg ? F_3_2_7_6_1_0_5_4_pos : F_3_2_7_6_1_0_5_4_neg;
+  assign w14 = F_3_7_2_6_1_5_0_4_pos < F_3_7_2_6_1_5_0_4_neg ? F_3_7_2_6_1_5_0_4_pos : F_3_7_2_6_1_5_0_4_neg;
+  assign w15 = F_3_7_1_5_2_6_0_4_pos < F_3_7_1_5_2_6_0_4_neg ? F_3_7_1_5_2_6_0_4_pos : F_3_7_1_5_2_6_0_4_neg;
+  assign w16 = F_3_1_7_5_2_0_6_4_pos < F_3_1_7_5_2_0_6_4_neg ? F_3_1_7_5_2_0_6_4_pos : F_3_1_7_5_2_0_6_4_neg;
+  assign w17 = F_3_1_2_0_7_5_6_4_pos < F_3_1_2_0_7_5_6_4_neg ? F_3_1_2_0_7_5_6_4_pos : F_3_1_2_0_7_5_6_4_neg;
+  assign w18 = F_2_3_0_1_6_7_4_5_pos < F_2_3_0_1_6_7_4_5_neg ? F_2_3_0_1_6_7_4_5_pos : F_2_3_0_1_6_7_4_5_neg;
+  assign w19 = F_2_3_6_7_0_1_4_5_pos < F_2_3_6_7_0_1_4_5_neg ? F_2_3_6_7_0_1_4_5_pos : F_2_3_6_7_0_1_4_5_neg;
+  assign w20 = F_2_6_3_7_0_4_1_5_pos < F_2_6_3_7_0_4_1_5_neg ? F_2_6_3_7_0_4_1_5_pos : F_2_6_3_7_0_4_1_5_neg;
+  assign w21 = F_2_6_0_4_3_7_1_5_pos < F_2_6_0_4_3_7_1_5_neg ? F_2_6_0_4_3_7_1_5_pos : F_2_6_0_4_3_7_1_5_neg;
+  assign w22 = F_2_0_6_4_3_1_7_5_pos < F_2_0_6_4_3_1_7_5_neg ? F_2_0_6_4_3_1_7_5_pos : F_2_0_6_4_3_1_7_5_neg;
+  assign w23 = F_2_0_3_1_6_4_7_5_pos < F_2_0_3_1_6_4_7_5_neg ? F_2_0_3_1_6_4_7_5_pos : F_2_0_3_1_6_4_7_5_neg;
+  assign w24 = F_6_7_4_5_2_3_0_1_pos < F_6_7_4_5_2_3_0_1_neg ? F_6_7_4_5_2_3_0_1_pos : F_6_7_4_5_2_3_0_1_neg;
+  assign w25 = F_6_7_2_3_4_5_0_1_pos < F_6_7_2_3_4_5_0_1_neg ? F_6_7_2_3_4_5_0_1_pos : F_6_7_2_3_4_5_0_1_neg;
+  assign w26 = F_6_2_7_3_4_0_5_1_pos < F_6_2_7_3_4_0_5_1_neg ? F_6_2_7_3_4_0_5_1_pos : F_6_2_7_3_4_0_5_1_neg;
+  assign w27 = F_6_2_4_0_7_3_5_1_pos < F_6_2_4_0_7_3_5_1_neg ? F_6_2_4_0_7_3_5_1_pos : F_6_2_4_0_7_3_5_1_neg;
+  assign w28 = F_6_4_2_0_7_5_3_1_pos < F_6_4_2_0_7_5_3_1_neg ? F_6_4_2_0_7_5_3_1_pos : F_6_4_2_0_7_5_3_1_neg;
+  assign w29 = F_6_4_7_5_2_0_3_1_pos < F_6_4_7_5_2_0_3_1_neg ? F_6_4_7_5_2_0_3_1_pos : F_6_4_7_5_2_0_3_1_neg;
+  assign w30 = F_7_6_5_4_3_2_1_0_pos < F_7_6_5_4_3_2_1_0_neg ? F_7_6_5_4_3_2_1_0_pos : F_7_6_5_4_3_2_1_0_neg;
+  assign w31 = F_7_6_3_2_5_4_1_0_pos < F_7_6_3_2_5_4_1_0_neg ? F_7_6_3_2_5_4_1_0_pos : F_7_6_3_2_5_4_1_0_neg;
+  assign w32 = F_7_3_6_2_5_1_4_0_pos < F_7_3_6_2_5_1_4_0_neg ? F_7_3_6_2_5_1_4_0_pos : F_7_3_6_2_5_1_4_0_neg;
+  assign w33 = F_7_3_5_1_6_2_4_0_pos < F_7_3_5_1_6_2_4_0_neg ? F_7_3_5_1_6_2_4_0_pos : F_7_3_5_1_6_2_4_0_neg;
+  assign w34 = F_7_5_3_1_6_4_2_0_pos < F_7_5_3_1_6_4_2_0_neg ? F_7_5_3_1_6_4_2_0_pos : F_7_5_3_1_6_4_2_0_neg;
+  assign w35 = F_7_5_6_4_3_1_2_0_pos < F_7_5_6_4_3_1_2_0_neg ? F_7_5_6_4_3_1_2_0_pos : F_7_5_6_4_3_1_2_0_neg;
+  assign w36 = F_5_4_7_6_1_0_3_2_pos < F_5_4_7_6_1_0_3_2_neg ? F_5_4_7_6_1_0_3_2_pos : F_5_4_7_6_1_0_3_2_neg;
+  assign w37 = F_5_4_1_0_7_6_3_2_pos < F_5_4_1_0_7_6_3_2_neg ? F_5_4_1_0_7_6_3_2_pos : F_5_4_1_0_7_6_3_2_neg;
+  assign w38 = F_5_1_4_0_7_3_6_2_pos < F_5_1_4_0_7_3_6_2_neg ? F_5_1_4_0_7_3_6_2_pos : F_5_1_4_0_7_3_6_2_neg;
+  assign w39 = F_5_1_7_3_4_0_6_2_pos < F_5_1_7_3_4_0_6_2_neg ? F_5_1_7_3_4_0_6_2_pos : F_5_1_7_3_4_0_6_2_neg;
+  assign w40 = F_5_7_1_3_4_6_0_2_pos < F_5_7_1_3_4_6_0_2_neg ? F_5_7_1_3_4_6_0_2_pos : F_5_7_1_3_4_6_0_2_neg;
+  assign w41 = F_5_7_4_6_1_3_0_2_pos < F_5_7_4_6_1_3_0_2_neg ? F_5_7_4_6_1_3_0_2_pos : F_5_7_4_6_1_3_0_2_neg;
+  assign w42 = F_4_5_6_7_0_1_2_3_pos < F_4_5_6_7_0_1_2_3_neg ? F_4_5_6_7_0_1_2_3_pos : F_4_5_6_7_0_1_2_3_neg;
+  assign w43 = F_4_5_0_1_6_7_2_3_pos < F_4_5_0_1_6_7_2_3_neg ? F_4_5_0_1_6_7_2_3_pos : F_4_5_0_1_6_7_2_3_neg;
+  assign w44 = F_4_0_5_1_6_2_7_3_pos < F_4_0_5_1_6_2_7_3_neg ? F_4_0_5_1_6_2_7_3_pos : F_4_0_5_1_6_2_7_3_neg;
+  assign w45 = F_4_0_6_2_5_1_7_3_pos < F_4_0_6_2_5_1_7_3_neg ? F_4_0_6_2_5_1_7_3_pos : F_4_0_6_2_5_1_7_3_neg;
+  assign w46 = F_4_6_0_2_5_7_1_3_pos < F_4_6_0_2_5_7_1_3_neg ? F_4_6_0_2_5_7_1_3_pos : F_4_6_0_2_5_7_1_3_neg;
+  assign w47 = F_4_6_5_7_0_2_1_3_pos < F_4_6_5_7_0_2_1_3_neg ? F_4_6_5_7_0_2_1_3_pos : F_4_6_5_7_0_2_1_3_neg;
+  assign w48 = w0 < w1 ? w0 : w1;
+  assign w49 = w2 < w3 ? w2 : w3;
+  assign w50 = w4 < w5 ? w4 : w5;
+  assign w51 = w6 < w7 ? w6 : w7;
+  assign w52 = w8 < w9 ? w8 : w9;
+  assign w53 = w10 < w11 ? w10 : w11;
+  assign w54 = w12 < w13 ? w12 : w13;
+  assign w55 = w14 < w15 ? w14 : w15;
+  assign w56 = w16 < w17 ? w16 : w17;
+  assign w57 = w18 < w19 ? w18 : w19;
+  assign w58 = w20 < w21 ? w20 : w21;
+  assign w59 = w22 < w23 ? w22 : w23;
+  assign w60 = w24 < w25 ? w24 : w25;
+  assign w61 = w26 < w27 ? w26 : w27;
+  assign w62 = w28 < w29 ? w28 : w29;
+  assign w63 = w30 < w31 ? w30 : w31;
+  assign w64 = w32 < w33 ? w32 : w33;
+  assign w65 = w34 < w35 ? w34 : w35;
+  assign w66 = w36 < w37 ? w36 : w37;
+  assign w67 = w38 < w39 ? w38 : w39;
+  assign w68 = w40 < w41 ? w40 : w41;
+  assign w69 = w42 < w43 ? w42 : w43;
+  assign w70 = w44 < w45 ? w44 : w45;
+  assign w71 = w46 < w47 ? w46 : w47;
+  assign w72 = w48 < w49 ? w48 : w49;
+  assign w73 = w50 < w51 ? w50 : w51;
+  assign w74 = w52 < w53 ? w52 : w53;
+  assign w75 = w54 < w55 ? w54 : w55;
+  assign w76 = w56 < w57 ? w56 : w57;
+  assign w77 = w58 < w59 ? w58 : w59;
+  assign w78 = w60 < w61 ? w60 : w61;
+  assign w79 = w62 < w63 ? w62 : w63;
+  assign w80 = w64 < w65 ? w64 : w65;
+  assign w81 = w66 < w67 ? w66 : w67;
+  assign w82 = w68 < w69 ? w68 : w69;
+  assign w83 = w70 < w71 ? w70 : w71;
+  assign w84 = w72 < w73 ? w72 : w73;
+  assign w85 = w74 < w75 ? w74 : w75;
+  assign w86 = w76 < w77 ? w76 : w77;
+  assign w87 = w78 < w79 ? w78 : w79;
+  assign w88 = w80 < w81 ? w80 : w81;
+  assign w89 = w82 < w83 ? w82 : w83;
+  assign w90 = w84 < w85 ? w84 : w85;
+  assign w91 = w86 < w87 ? w86 : w87;
+  assign w92 = w88 < w89 ? w88 : w89;
+  assign w93 = w90 < w91 ? w90 : w91;
+  assign w94 = w92 < w93 ? w92 : w93;
+  assign Fr = w94;
+
+endmodule
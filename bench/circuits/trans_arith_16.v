@@ -0,0 +1,17 @@
+// this file has been generated with CirKit using the command:
+//   gen_trans_arith --seed 58 --bitwidth 16 --min_words 6 --max_words 12 --max_fanout 4 --max_rounds 6 --operators "+ - *" --mux_types MO --mux_prob 40 --new_ctrl_prob 30 --word_pattern "w%d" --control_pattern "c%d" --module_name "trans_arith_16"
+
+module trans_arith_16( w1, w2, w3, w4, w5, w6, c1, w13 );
+  input [15:0] w1, w2, w3, w4, w5, w6;
+  input c1;
+  output [15:0] w13;
+  wire [15:0] w7, w8, w9, w10, w11, w12;
+
+  assign w7 = w4 * w6;
+  assign w8 = w7;
+  assign w9 = c1 ? w1 : w2;
+  assign w10 = w5 + w3;
+  assign w11 = w10 + w7;
+  assign w12 = w9 * w8;
+  assign w13 = c1 ? w12 : w11;
+endmodule
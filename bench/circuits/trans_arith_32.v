@@ -0,0 +1,34 @@
+// this file has been generated with CirKit using the command:
+//   gen_trans_arith --seed 74 --bitwidth 32 --min_words 6 --max_words 12 --max_fanout 4 --max_rounds 6 --operators "+ - *" --mux_types MO --mux_prob 40 --new_ctrl_prob 30 --word_pattern "w%d" --control_pattern "c%d" --module_name "trans_arith_32"
+
+module trans_arith_32( w1, w2, w3, w4, w5, w6, c1, c2, c3, w25, w26, w27, w28, w29, w30 );
+  input [31:0] w1, w2, w3, w4, w5, w6;
+  input c1, c2, c3;
+  output [31:0] w25, w26, w27, w28, w29, w30;
+  wire [31:0] w7, w8, w9, w10, w11, w12, w13, w14, w15, w16, w17, w18, w19, w20, w21, w22, w23, w24;
+
+  assign w7 = w5 - w6;
+  assign w8 = c1 ? w1 : w2;
+  assign w9 = c1 ? w4 : w3;
+  assign w10 = w9;
+  assign w11 = w10 * w8;
+  assign w12 = w11;
+  assign w13 = w7 - w9;
+  assign w14 = w13;
+  assign w15 = w11 - w12;
+  assign w16 = w13 + w14;
+  assign w17 = w16;
+  assign w18 = c2 ? w16 : w17;
+  assign w20 = {c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1,c1};
+  assign w21 = {c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3,c3};
+  assign w22 = w20 & w18;
+  assign w23 = w21 & w15;
+  assign w19 = w22 | w23;
+  assign w24 = w19;
+  assign w25 = w19 - w22;
+  assign w26 = c1 ? w23 : w24;
+  assign w27 = w26;
+  assign w28 = w20 * w21;
+  assign w29 = w28;
+  assign w30 = w28;
+endmodule
@@ -0,0 +1,80 @@
+// this file has been generated with CirKit using the command:
+//   gen_trans_arith --seed 46 --bitwidth 4 --min_words 6 --max_words 12 --max_fanout 4 --max_rounds 6 --operators "+ - *" --mux_types MO --mux_prob 40 --new_ctrl_prob 30 --word_pattern "w%d" --control_pattern "c%d" --module_name "trans_arith_4"
+
+module trans_arith_4( w1, w2, w3, w4, w5, w6, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, w65, w66, w67, w68, w69, w70, w71, w72, w73, w74, w75, w76 );
+  input [3:0] w1, w2, w3, w4, w5, w6;
+  input c1, c2, c3, c4, c5, c6, c7, c8, c9, c10;
+  output [3:0] w65, w66, w67, w68, w69, w70, w71, w72, w73, w74, w75, w76;
+  wire [3:0] w7, w8, w9, w10, w11, w12, w13, w14, w15, w16, w17, w18, w19, w20, w21, w22, w23, w24, w25, w26, w27, w28, w29, w30, w31, w32, w33, w34, w35, w36, w37, w38, w39, w40, w41, w42, w43, w44, w45, w46, w47, w48, w49, w50, w51, w52, w53, w54, w55, w56, w57, w58, w59, w60, w61, w62, w63, w64;
+
+  assign w8 = {c1,c1,c1,c1};
+  assign w9 = {c2,c2,c2,c2};
+  assign w10 = w8 & w1;
+  assign w11 = w9 & w5;
+  assign w7 = w10 | w11;
+  assign w12 = w2 - w3;
+  assign w14 = {c1,c1,c1,c1};
+  assign w15 = {c3,c3,c3,c3};
+  assign w16 = w14 & w6;
+  assign w17 = w15 & w4;
+  assign w13 = w16 | w17;
+  assign w18 = w13 * w7;
+  assign w19 = c1 ? w8 : w10;
+  assign w20 = w19;
+  assign w21 = w16 - w14;
+  assign w23 = {c4,c4,c4,c4};
+  assign w24 = {c5,c5,c5,c5};
+  assign w25 = w23 & w15;
+  assign w26 = w24 & w17;
+  assign w22 = w25 | w26;
+  assign w27 = w9 - w12;
+  assign w28 = w27;
+  assign w29 = w26 + w25;
+  assign w30 = w29;
+  assign w31 = w19 - w18;
+  assign w32 = w31;
+  assign w33 = c6 ? w21 : w22;
+  assign w34 = w27 * w24;
+  assign w35 = w34;
+  assign w36 = w34;
+  assign w37 = w11 + w20;
+  assign w38 = w37;
+  assign w39 = w23 + w28;
+  assign w40 = w32 - w39;
+  assign w41 = w40;
+  assign w42 = w38 - w35;
+  assign w43 = w42;
+  assign w45 = {c7,c7,c7,c7};
+  assign w46 = {c8,c8,c8,c8};
+  assign w47 = w45 & w34;
+  assign w48 = w46 & w29;
+  assign w44 = w47 | w48;
+  assign w49 = w31 * w36;
+  assign w50 = w37 * w33;
+  assign w51 = w50;
+  assign w52 = w50;
+  assign w53 = w42 * w50;
+  assign w54 = w44 + w41;
+  assign w55 = w54;
+  assign w56 = w54;
+  assign w57 = w46 - w52;
+  assign w58 = w47 * w45;
+  assign w59 = w58;
+  assign w60 = w40 + w51;
+  assign w61 = w60;
+  assign w62 = w30 * w49;
+  assign w63 = w62;
+  assign w64 = w48 - w43;
+  assign w65 = c6 ? w62 : w54;
+  assign w66 = w65;
+  assign w67 = w61 + w59;
+  assign w68 = w55 * w58;
+  assign w69 = w53 + w64;
+  assign w70 = w69;
+  assign w72 = {c9,c9,c9,c9};
+  assign w73 = {c10,c10,c10,c10};
+  assign w74 = w72 & w60;
+  assign w75 = w73 & w57;
+  assign w71 = w74 | w75;
+  assign w76 = w56 * w63;
+endmodule
@@ -0,0 +1,15 @@
+// this file has been generated with CirKit using the command:
+//   gen_trans_arith --seed 50 --bitwidth 8 --min_words 6 --max_words 12 --max_fanout 4 --max_rounds 6 --operators "+ - *" --mux_types MO --mux_prob 40 --new_ctrl_prob 30 --word_pattern "w%d" --control_pattern "c%d" --module_name "trans_arith_8"
+
+module trans_arith_8( w1, w2, w3, w4, w5, w6, c1, w11 );
+  input [7:0] w1, w2, w3, w4, w5, w6;
+  input c1;
+  output [7:0] w11;
+  wire [7:0] w7, w8, w9, w10;
+
+  assign w7 = w4 - w5;
+  assign w8 = w6 + w3;
+  assign w9 = w2 - w1;
+  assign w10 = c1 ? w8 : w9;
+  assign w11 = w7 * w10;
+endmodule
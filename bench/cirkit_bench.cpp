@@ -0,0 +1,132 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @author Mathias Soeken
+ *
+ * Reproducible benchmark suite for the core algorithms.  Runs every
+ * benchmark case on the checked-in circuits, optionally writes the
+ * results as JSON, and compares them against a baseline file written
+ * by an earlier run.  The exit code is 1 if a case regressed.
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include <boost/format.hpp>
+
+#include <core/utils/program_options.hpp>
+#include <core/utils/string_utils.hpp>
+
+#include "bench.hpp"
+
+#ifndef CIRKIT_BENCH_CIRCUITS
+#define CIRKIT_BENCH_CIRCUITS "bench/circuits"
+#endif
+
+using namespace cirkit;
+
+int main( int argc, char ** argv )
+{
+  using boost::format;
+  using boost::program_options::bool_switch;
+  using boost::program_options::value;
+
+  bench_config config;
+  config.circuit_dir = CIRKIT_BENCH_CIRCUITS;
+
+  std::string threads = "1 2 4";
+  std::string output, baseline, regenerate;
+  double tolerance = 0.10;
+  double min_delta = 0.05;
+
+  program_options opts;
+  opts.add_options()
+    ( "circuit_dir", value_with_default( &config.circuit_dir ), "Directory with benchmark circuits" )
+    ( "filter",      value( &config.filter ),                   "Only run cases whose benchmark/circuit matches this regular expression" )
+    ( "threads",     value_with_default( &threads ),            "Thread counts for parallel algorithms" )
+    ( "repetitions", value_with_default( &config.repetitions ), "Timed runs per case (the median is reported)" )
+    ( "warmup",      value_with_default( &config.warmup ),      "Untimed runs per case" )
+    ( "seed",        value_with_default( &config.seed ),        "Seed for random inputs" )
+    ( "lhrs_cache",  bool_switch( &config.lhrs_cache ),         "Use the LUT circuit cache in LHRS (all but the first run are lookups)" )
+    ( "output,o",    value( &output ),                          "Write results as JSON to this file" )
+    ( "compare,c",   value( &baseline ),                        "Compare results against this JSON baseline" )
+    ( "tolerance",   value_with_default( &tolerance ),          "Relative slow-down that counts as a regression" )
+    ( "min_delta",   value_with_default( &min_delta ),          "Absolute slow-down in seconds below which a case is not a regression" )
+    ( "regenerate",  value( &regenerate ),                      "Write all benchmark circuits into this directory and exit" )
+    ;
+  opts.parse( argc, argv );
+
+  if ( !opts.good() )
+  {
+    std::cout << opts << std::endl;
+    return 1;
+  }
+
+  if ( opts.is_set( "regenerate" ) )
+  {
+    generate_bench_circuits( regenerate );
+    return 0;
+  }
+
+  config.threads.clear();
+  parse_string_list( config.threads, threads );
+
+  const auto circuits = read_bench_circuits( config );
+  for ( const auto& c : circuits )
+  {
+    std::cout << format( "[i] circuit %-16s inputs: %5d  gates: %7d" ) % c.name % c.num_inputs % c.num_gates << std::endl;
+  }
+
+  bench_suite suite;
+  add_classical_benchmarks( suite, circuits, config );
+#ifdef CIRKIT_BENCH_REVERSIBLE
+  add_reversible_benchmarks( suite, circuits, config );
+#endif
+
+  const auto results = suite.run( config );
+
+  if ( !output.empty() )
+  {
+    std::ofstream os( output.c_str(), std::ofstream::out );
+    write_bench_results( results, config, os );
+  }
+
+  if ( !baseline.empty() )
+  {
+    const auto regressions = compare_bench_results( results, read_bench_results( baseline ), tolerance, min_delta );
+    std::cout << format( "[i] %d regression(s)" ) % regressions << std::endl;
+    return regressions == 0u ? 0 : 1;
+  }
+
+  return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,154 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bench.hpp"
+
+#include <random>
+#include <unordered_map>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/properties.hpp>
+#include <core/utils/bitset_utils.hpp>
+#include <classical/abc/gia/gia.hpp>
+#include <classical/dd/aig_to_cirkit_bdd.hpp>
+#include <classical/dd/bdd.hpp>
+#include <classical/dd/size.hpp>
+#include <classical/functions/aig_to_mig.hpp>
+#include <classical/functions/cuts/paged.hpp>
+#include <classical/functions/simulate_aig.hpp>
+#include <classical/functions/strash.hpp>
+#include <classical/mig/mig_functional_hashing.hpp>
+#include <classical/optimization/exorcism_minimization.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/xmg/xmg_aig.hpp>
+#include <classical/xmg/xmg_cover.hpp>
+#include <classical/xmg/xmg_flow_map.hpp>
+
+#include <misc/vec/vecWec.h>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* inputs for which ESOP and BDD construction stay in the range of seconds */
+constexpr auto exorcism_max_inputs = 16u;
+constexpr auto bdd_max_inputs      = 40u;
+
+constexpr auto simulation_patterns = 4096u;
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void add_classical_benchmarks( bench_suite& suite, const std::vector<bench_circuit>& circuits, const bench_config& config )
+{
+  for ( const auto& c : circuits )
+  {
+    const auto* aig = &c.aig;
+
+    suite.add( "strash", c.name, 1u, [aig]() {
+        return [aig]() -> std::uint64_t { return boost::num_vertices( strash( *aig ) ); };
+      } );
+
+    suite.add( "simulate_aig", c.name, 1u, [aig, &config]() {
+        std::default_random_engine gen( config.seed );
+        auto assignment = std::make_shared<word_assignment_simulator::aig_name_value_map>();
+        for ( const auto& input : aig_info( *aig ).inputs )
+        {
+          ( *assignment )[aig_info( *aig ).node_names.at( input )] = random_bitset( simulation_patterns, gen );
+        }
+        return [aig, assignment]() -> std::uint64_t {
+          std::uint64_t ones = 0u;
+          for ( const auto& p : simulate_aig( *aig, word_assignment_simulator( *assignment ) ) )
+          {
+            ones += p.second.count();
+          }
+          return ones;
+        };
+      } );
+
+    for ( auto threads : config.threads )
+    {
+      suite.add( "paged_aig_cuts", c.name, threads, [aig, threads]() {
+          return [aig, threads]() -> std::uint64_t {
+            auto settings = std::make_shared<properties>();
+            settings->set( "num_threads", threads );
+            return paged_aig_cuts( *aig, 6u, threads > 1u, 8u, settings ).total_cut_count();
+          };
+        } );
+    }
+
+    suite.add( "xmg_flow_map", c.name, 1u, [aig]() {
+        auto xmg = std::make_shared<xmg_graph>( xmg_from_aig( *aig ) );
+        return [xmg]() -> std::uint64_t {
+          auto settings = std::make_shared<properties>();
+          settings->set( "cut_size", 6u );
+          xmg_flow_map( *xmg, settings );
+          return xmg->cover().lut_count();
+        };
+      } );
+
+    suite.add( "mig_functional_hashing", c.name, 1u, [aig]() {
+        auto mig = std::make_shared<mig_graph>( aig_to_mig( *aig ) );
+        return [mig]() -> std::uint64_t { return boost::num_vertices( mig_functional_hashing( *mig ) ); };
+      } );
+
+    if ( c.num_inputs <= exorcism_max_inputs )
+    {
+      suite.add( "exorcism", c.name, 1u, [aig]() {
+          auto gia = std::make_shared<gia_graph>( *aig );
+          return [gia]() -> std::uint64_t { return abc::Vec_WecSize( exorcism_minimization( *gia ).get() ); };
+        } );
+    }
+
+    if ( c.num_inputs <= bdd_max_inputs )
+    {
+      const auto num_inputs = c.num_inputs;
+      suite.add( "bdd", c.name, 1u, [aig, num_inputs]() {
+          return [aig, num_inputs]() -> std::uint64_t {
+            auto mgr = bdd_manager::create( num_inputs, 20u );
+            return dd_size( aig_to_bdd( *aig, mgr ) );
+          };
+        } );
+    }
+  }
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
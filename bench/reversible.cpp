@@ -0,0 +1,140 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bench.hpp"
+
+#include <random>
+
+#include <boost/format.hpp>
+
+#include <classical/xmg/xmg_aig.hpp>
+#include <classical/xmg/xmg_flow_map.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/truth_table.hpp>
+#include <reversible/functions/circuit_to_truth_table.hpp>
+#include <reversible/functions/random_circuit.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+#include <reversible/synthesis/lhrs/lhrs.hpp>
+#include <reversible/synthesis/transformation_based_synthesis.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* gates for which LHRS stays in the range of seconds */
+constexpr auto lhrs_max_gates = 2000u;
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void add_reversible_benchmarks( bench_suite& suite, const std::vector<bench_circuit>& circuits, const bench_config& config )
+{
+  for ( const auto& c : circuits )
+  {
+    if ( c.num_gates > lhrs_max_gates ) { continue; }
+
+    const auto* aig = &c.aig;
+    for ( auto threads : config.threads )
+    {
+      suite.add( "lhrs", c.name, threads, [aig, threads, &config]() {
+          auto xmg = std::make_shared<xmg_graph>( xmg_from_aig( *aig ) );
+          auto settings = std::make_shared<properties>();
+          settings->set( "cut_size", 4u );
+          xmg_flow_map( *xmg, settings );
+
+          return [xmg, threads, &config]() -> std::uint64_t {
+            lhrs_params params;
+            lhrs_stats stats;
+            params.num_threads = threads;
+            params.use_cache = config.lhrs_cache;
+
+            circuit circ;
+            lut_based_synthesis( circ, *xmg, params, stats );
+            return circ.num_gates();
+          };
+        } );
+    }
+  }
+
+  /* exhaustive bit-sliced simulation of random circuits */
+  for ( auto lines : {16u, 20u} )
+  {
+    for ( auto threads : config.threads )
+    {
+      suite.add( "revsim", boost::str( boost::format( "random_%d" ) % lines ), threads, [lines, threads, &config]() {
+          std::default_random_engine gen( config.seed + lines );
+          auto sim = std::make_shared<bitsliced_simulator>( random_circuit( lines, 10u * lines, true, gen ) );
+
+          return [sim, lines, threads]() -> std::uint64_t {
+            auto patterns = create_exhaustive_patterns( lines );
+            sim->simulate( patterns, threads );
+
+            std::uint64_t checksum = 0u;
+            for ( const auto& line : patterns )
+            {
+              for ( auto w : line )
+              {
+                checksum = checksum * 31u + w;
+              }
+            }
+            return checksum;
+          };
+        } );
+    }
+  }
+
+  /* TBS on permutations of random circuits */
+  for ( auto lines : {6u, 8u, 10u, 12u} )
+  {
+    suite.add( "tbs", boost::str( boost::format( "random_%d" ) % lines ), 1u, [lines, &config]() {
+        std::default_random_engine gen( config.seed + lines );
+        auto spec = std::make_shared<binary_truth_table>();
+        circuit_to_truth_table( random_circuit( lines, 4u * lines, true, gen ), *spec );
+
+        return [spec]() -> std::uint64_t {
+          circuit circ;
+          transformation_based_synthesis( circ, *spec );
+          return circ.num_gates();
+        };
+      } );
+  }
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
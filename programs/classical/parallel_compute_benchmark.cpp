@@ -0,0 +1,212 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @author Mathias Soeken
+ *
+ * Compares the levelized work-stealing scheduler in parallel_compute with
+ * the former implementation that started one thread per AIG node.
+ */
+
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/graph/topological_sort.hpp>
+
+#include <core/utils/program_options.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/aig.hpp>
+#include <classical/functions/parallel_compute.hpp>
+#include <classical/io/read_aiger.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+/* thread per node, one condition variable per node (reference implementation) */
+void simulate_thread_per_node( const aig_graph& aig, const boost::dynamic_bitset<>& pattern, std::vector<unsigned char>& computed_values )
+{
+  std::vector<aig_node> topsort( num_vertices( aig ) );
+  boost::topological_sort( aig, topsort.begin() );
+
+  const auto& info = aig_info( aig );
+
+  computed_values.assign( num_vertices( aig ), 0u );
+  boost::dynamic_bitset<>              computed( num_vertices( aig ) );
+  std::mutex                           vector_mutex;
+  std::vector<std::thread>             workers;
+  std::vector<std::condition_variable> guards( num_vertices( aig ) );
+  std::vector<std::mutex>              guard_locks( num_vertices( aig ) );
+  computed.set( 0u );
+
+  const auto finish = [&]( aig_node n, unsigned char v ) {
+    vector_mutex.lock();
+    computed_values[n] = v;
+    computed.set( n );
+    vector_mutex.unlock();
+
+    std::unique_lock<std::mutex> lck( guard_locks[n] );
+    guards[n].notify_all();
+  };
+
+  const auto wait_for = [&]( aig_node n ) {
+    std::unique_lock<std::mutex> lck( guard_locks[n] );
+    while ( true )
+    {
+      vector_mutex.lock();
+      const auto done = computed[n];
+      vector_mutex.unlock();
+      if ( done ) { break; }
+      guards[n].wait( lck );
+    }
+  };
+
+  for ( auto n : topsort )
+  {
+    if ( out_degree( n, aig ) == 0u )
+    {
+      if ( n == 0u ) { continue; }
+
+      const auto index = aig_input_index( info, n );
+      workers.emplace_back( [&finish, &pattern, n, index]() { finish( n, pattern[index] ); } );
+    }
+    else
+    {
+      const auto children = get_children( aig, n );
+
+      workers.emplace_back( [&finish, &wait_for, &computed_values, n, children]() {
+          wait_for( children[0].node );
+          wait_for( children[1].node );
+
+          finish( n, ( ( computed_values[children[0].node] != 0u ) != children[0].complemented ) &&
+                     ( ( computed_values[children[1].node] != 0u ) != children[1].complemented ) );
+        } );
+    }
+  }
+
+  for ( auto& worker : workers )
+  {
+    worker.join();
+  }
+}
+
+int main( int argc, char ** argv )
+{
+  using boost::format;
+  using boost::program_options::value;
+
+  std::string filename;
+  unsigned    max_threads = std::thread::hardware_concurrency();
+  unsigned    chunk_size = 256u;
+  unsigned    reference_limit = 20000u;
+
+  program_options opts;
+  opts.add_options()
+    ( "filename",        value( &filename ),                      "AIG filename (in AIGER format)" )
+    ( "max_threads",     value_with_default( &max_threads ),      "Maximum number of threads, runs 1, 2, 4, ... threads" )
+    ( "chunk_size",      value_with_default( &chunk_size ),       "Number of nodes processed by a thread at once" )
+    ( "reference_limit", value_with_default( &reference_limit ),  "Skip thread-per-node reference for AIGs with more nodes" )
+    ;
+  opts.parse( argc, argv );
+
+  if ( !opts.good() || !opts.is_set( "filename" ) )
+  {
+    std::cout << opts << std::endl;
+    return 1;
+  }
+
+  aig_graph aig;
+  try
+  {
+    read_aiger( aig, filename );
+  }
+  catch ( const char* msg )
+  {
+    std::cerr << msg << std::endl;
+    return 2;
+  }
+
+  const auto& info = aig_info( aig );
+  boost::dynamic_bitset<> pattern( info.inputs.size() );
+  for ( auto i = 0u; i < pattern.size(); i += 3u )
+  {
+    pattern.set( i );
+  }
+
+  std::cout << format( "[i] nodes: %d, inputs: %d, outputs: %d" ) % num_vertices( aig ) % info.inputs.size() % info.outputs.size() << std::endl;
+
+  std::vector<unsigned char> reference;
+  if ( num_vertices( aig ) <= reference_limit )
+  {
+    double runtime = 0.0;
+    {
+      reference_timer t( &runtime );
+      simulate_thread_per_node( aig, pattern, reference );
+    }
+    std::cout << format( "[i] thread per node:          %8.3f secs" ) % runtime << std::endl;
+  }
+  else
+  {
+    std::cout << "[i] thread per node:          skipped" << std::endl;
+  }
+
+  for ( auto threads = 1u; threads <= std::max( 1u, max_threads ); threads <<= 1u )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "num_threads", threads );
+    settings->set( "chunk_size", chunk_size );
+    auto statistics = std::make_shared<properties>();
+
+    std::vector<unsigned char> values;
+    parallel_compute<unsigned char>( aig, 0u,
+                                     [&pattern]( unsigned index ) { return pattern[index]; },
+                                     []( unsigned char v1, bool c1, unsigned char v2, bool c2 ) { return ( ( v1 != 0u ) != c1 ) && ( ( v2 != 0u ) != c2 ); },
+                                     values, settings, statistics );
+
+    std::cout << format( "[i] levelized (%2d threads):   %8.3f secs (levels: %d, chunks: %d, steals: %d)" )
+      % threads % statistics->get<double>( "runtime" ) % statistics->get<unsigned>( "num_levels" )
+      % statistics->get<unsigned long>( "num_chunks" ) % statistics->get<unsigned long>( "num_steals" ) << std::endl;
+
+    if ( !reference.empty() && values != reference )
+    {
+      std::cerr << "[e] simulation results differ from reference" << std::endl;
+      return 3;
+    }
+  }
+
+  return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,207 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @author Mathias Soeken
+ *
+ * Compares strash_table with the std::unordered_map and std::map based
+ * structural hashing tables formerly used by xmg_graph and mig_graph.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include <core/utils/hash_utils.hpp>
+#include <core/utils/program_options.hpp>
+#include <core/utils/strash_table.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/xmg/xmg.hpp>
+
+using namespace cirkit;
+
+using gate_key_t = std::tuple<xmg_function, xmg_function, xmg_function>;
+
+/* emulates the hashing pattern of a rewriting pass: a lookup for every
+   candidate gate, and an insertion for the misses */
+std::vector<gate_key_t> make_keys( unsigned num_keys, unsigned seed )
+{
+  std::mt19937 gen( seed );
+  std::vector<gate_key_t> keys;
+  keys.reserve( num_keys );
+
+  for ( auto i = 0u; i < num_keys; ++i )
+  {
+    const auto node = i + 100u;
+    std::uniform_int_distribution<unsigned> dist( node > 1000u ? node - 1000u : 0u, node - 1u );
+
+    xmg_function children[] = {xmg_function( dist( gen ), gen() & 1 ), xmg_function( dist( gen ), gen() & 1 ), xmg_function( dist( gen ), gen() & 1 )};
+    std::sort( children, children + 3 );
+    keys.push_back( std::make_tuple( children[0], children[1], children[2] ) );
+  }
+
+  /* every other lookup is repeated, so that half of the lookups hit */
+  for ( auto i = 0u; i < num_keys; i += 2u )
+  {
+    keys.push_back( keys[( i * 7919u ) % num_keys] );
+  }
+  std::shuffle( keys.begin() + num_keys, keys.end(), gen );
+
+  return keys;
+}
+
+template<typename Map>
+unsigned run_map( Map& map, const std::vector<gate_key_t>& keys )
+{
+  auto hits = 0u;
+  for ( auto i = 0u; i < keys.size(); ++i )
+  {
+    const auto it = map.find( keys[i] );
+    if ( it != map.end() )
+    {
+      ++hits;
+    }
+    else
+    {
+      map[keys[i]] = i;
+    }
+  }
+  return hits;
+}
+
+unsigned run_strash_table( strash_table<3u>& table, const std::vector<gate_key_t>& keys )
+{
+  auto hits = 0u;
+  for ( auto i = 0u; i < keys.size(); ++i )
+  {
+    const auto& k = keys[i];
+    const strash_table<3u>::key_t key = {{strash_table<3u>::make_literal( std::get<0>( k ).node, std::get<0>( k ).complemented ),
+                                         strash_table<3u>::make_literal( std::get<1>( k ).node, std::get<1>( k ).complemented ),
+                                         strash_table<3u>::make_literal( std::get<2>( k ).node, std::get<2>( k ).complemented )}};
+    if ( table.find( key ) != strash_table<3u>::empty )
+    {
+      ++hits;
+    }
+    else
+    {
+      table.insert( key, i );
+    }
+  }
+  return hits;
+}
+
+int main( int argc, char ** argv )
+{
+  using boost::format;
+  using boost::program_options::value;
+
+  unsigned num_keys = 1000000u;
+  unsigned seed     = 42u;
+
+  program_options opts;
+  opts.add_options()
+    ( "num_keys", value_with_default( &num_keys ), "Number of distinct gates to hash" )
+    ( "seed",     value_with_default( &seed ),     "Random seed" )
+    ;
+  opts.parse( argc, argv );
+
+  if ( !opts.good() )
+  {
+    std::cout << opts << std::endl;
+    return 1;
+  }
+
+  const auto keys = make_keys( num_keys, seed );
+  std::cout << format( "[i] operations: %d" ) % keys.size() << std::endl;
+
+  const auto report = []( const std::string& name, double runtime, unsigned hits ) {
+    std::cout << format( "[i] %-32s %8.3f secs (hits: %d)" ) % name % runtime % hits << std::endl;
+  };
+
+  {
+    std::map<gate_key_t, unsigned> map;
+    double runtime = 0.0; unsigned hits;
+    { reference_timer t( &runtime ); hits = run_map( map, keys ); }
+    report( "std::map", runtime, hits );
+  }
+
+  {
+    std::unordered_map<gate_key_t, unsigned, hash<gate_key_t>> map;
+    double runtime = 0.0; unsigned hits;
+    { reference_timer t( &runtime ); hits = run_map( map, keys ); }
+    report( "std::unordered_map", runtime, hits );
+  }
+
+  {
+    strash_table<3u> table;
+    double runtime = 0.0; unsigned hits;
+    { reference_timer t( &runtime ); hits = run_strash_table( table, keys ); }
+    report( "strash_table", runtime, hits );
+  }
+
+  {
+    strash_table<3u> table( num_keys );
+    double runtime = 0.0; unsigned hits;
+    { reference_timer t( &runtime ); hits = run_strash_table( table, keys ); }
+    report( "strash_table (reserved)", runtime, hits );
+  }
+
+  /* end-to-end: build an XMG of random majority gates */
+  {
+    std::mt19937 gen( seed );
+    xmg_graph xmg;
+    std::vector<xmg_function> fs;
+    for ( auto i = 0u; i < 100u; ++i )
+    {
+      fs.push_back( xmg.create_pi( str( format( "x%d" ) % i ) ) );
+    }
+
+    double runtime = 0.0;
+    {
+      reference_timer t( &runtime );
+      for ( auto i = 0u; i < num_keys; ++i )
+      {
+        const auto pick = [&]() { return fs[fs.size() - 1u - gen() % std::min<std::size_t>( fs.size(), 1000u )] ^ ( gen() & 1 ); };
+        fs.push_back( xmg.create_maj( pick(), pick(), pick() ) );
+      }
+    }
+    std::cout << format( "[i] xmg_graph::create_maj           %8.3f secs (gates: %d)" ) % runtime % xmg.num_gates() << std::endl;
+  }
+
+  return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -38,6 +38,7 @@
 #include <cli/commands/bdd.hpp>
 #include <cli/commands/blif_to_bench.hpp>
 #include <cli/commands/bool_complex.hpp>
+#include <cli/commands/cec.hpp>
 #include <cli/commands/comb_approx.hpp>
 #include <cli/commands/compress.hpp>
 #include <cli/commands/cone.hpp>
@@ -51,6 +52,7 @@
 #include <cli/commands/exorcism.hpp>
 #include <cli/commands/expr.hpp>
 #include <cli/commands/feather.hpp>
+#include <cli/commands/fraig.hpp>
 #include <cli/commands/gen_npn_circuit.hpp>
 #include <cli/commands/gen_trans_arith.hpp>
 #include <cli/commands/isop.hpp>
@@ -62,6 +64,7 @@
 #include <cli/commands/permmask.hpp>
 #include <cli/commands/plim.hpp>
 #include <cli/commands/print_io.hpp>
+#include <cli/commands/profile.hpp>
 #include <cli/commands/propagate.hpp>
 #include <cli/commands/read_sym.hpp>
 #include <cli/commands/rename.hpp>
@@ -130,6 +133,7 @@ ALICE_BEGIN(cirkit)
   cli.set_category( "Rewriting" );
   ADD_COMMAND( cone );
   ADD_COMMAND( feather );
+  ADD_COMMAND( fraig );
   ADD_COMMAND( mig_rewrite );
   ADD_COMMAND( migfh );
   ADD_COMMAND( propagate );
@@ -139,6 +143,7 @@ ALICE_BEGIN(cirkit)
   ADD_COMMAND( xmgmerge );
 
   cli.set_category( "Verification" );
+  ADD_COMMAND( cec );
   ADD_COMMAND( simulate );
   ADD_COMMAND( support );
   ADD_COMMAND( unate );
@@ -182,6 +187,7 @@ ALICE_BEGIN(cirkit)
   ADD_COMMAND( expr );
   ADD_COMMAND( output_noise );
   ADD_COMMAND( print_io );
+  ADD_COMMAND( profile );
   ADD_COMMAND( xmg_majdecomp );
 
 #include <addon_defines.hpp>
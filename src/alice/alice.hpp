@@ -65,6 +65,7 @@
 #include <alice/commands/ps.hpp>
 #include <alice/commands/quit.hpp>
 #include <alice/commands/read_io.hpp>
+#include <alice/commands/session.hpp>
 #include <alice/commands/set.hpp>
 #include <alice/commands/show.hpp>
 #include <alice/commands/store.hpp>
@@ -322,16 +323,18 @@ public:
      * see store.hpp for more details
      */
     set_category( "General" );
-    insert_command( "alias",   std::make_shared<alias_command>( env ) );
-    insert_command( "convert", std::make_shared<convert_command<S...>>( env ) );
-    insert_command( "current", std::make_shared<current_command<S...>>( env ) );
-    insert_command( "help",    std::make_shared<help_command>( env ) );
-    insert_command( "print",   std::make_shared<print_command<S...>>( env ) );
-    insert_command( "ps",      std::make_shared<ps_command<S...>>( env ) );
-    insert_command( "quit",    std::make_shared<quit_command>( env ) );
-    insert_command( "set",     std::make_shared<set_command>( env ) );
-    insert_command( "show",    std::make_shared<show_command<S...>>( env ) );
-    insert_command( "store",   std::make_shared<store_command<S...>>( env ) );
+    insert_command( "alias",        std::make_shared<alias_command>( env ) );
+    insert_command( "convert",      std::make_shared<convert_command<S...>>( env ) );
+    insert_command( "current",      std::make_shared<current_command<S...>>( env ) );
+    insert_command( "help",         std::make_shared<help_command>( env ) );
+    insert_command( "load_session", std::make_shared<load_session_command<S...>>( env ) );
+    insert_command( "print",        std::make_shared<print_command<S...>>( env ) );
+    insert_command( "ps",           std::make_shared<ps_command<S...>>( env ) );
+    insert_command( "quit",         std::make_shared<quit_command>( env ) );
+    insert_command( "save_session", std::make_shared<save_session_command<S...>>( env ) );
+    insert_command( "set",          std::make_shared<set_command>( env ) );
+    insert_command( "show",         std::make_shared<show_command<S...>>( env ) );
+    insert_command( "store",        std::make_shared<store_command<S...>>( env ) );
 
     opts.add_options()
       ( "command,c",     po::value( &command ), "process semicolon-separated list of commands" )
@@ -530,12 +533,23 @@ private:
     const auto it = env->commands.find( vline.front() );
     if ( it != env->commands.end() )
     {
+      if ( env->before_command )
+      {
+        env->before_command( vline.front() );
+      }
+
       const auto now = std::chrono::system_clock::now();
       const auto result = it->second->run( vline );
 
+      command::log_map_t instrumentation;
+      if ( env->after_command )
+      {
+        env->after_command( vline.front(), instrumentation );
+      }
+
       if ( result && env->log )
       {
-        env->log_command( it->second, line, now );
+        env->log_command( it->second, line, now, instrumentation );
       }
 
       return result;
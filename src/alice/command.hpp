@@ -306,6 +306,7 @@ public: /* logging */
   }
 
   void log_command( const std::shared_ptr<command>& cmd, const std::string& cmdstring, const std::chrono::system_clock::time_point& start );
+  void log_command( const std::shared_ptr<command>& cmd, const std::string& cmdstring, const std::chrono::system_clock::time_point& start, const detail::log_map_t& extra );
   void log_command( const detail::log_opt_t& cmdlog, const std::string& cmdstring, const std::chrono::system_clock::time_point& start )
   {
     using boost::format;
@@ -345,6 +346,13 @@ public: /* logging */
     logger << "]" << std::endl;
   }
 
+public: /* instrumentation */
+  /* optional hooks that are called around each command executed from the
+     shell, e.g., for profiling; entries added to the log map by the second
+     hook are written into the log together with the command's own log */
+  std::function<void( const std::string& )>                     before_command;
+  std::function<void( const std::string&, detail::log_map_t& )> after_command;
+
 public: /* variables */
   const std::string& variable_value( const std::string& key, const std::string& def ) const
   {
@@ -482,6 +490,20 @@ inline void environment::log_command( const std::shared_ptr<command>& cmd, const
   log_command( cmd->log(), cmdstring, start );
 }
 
+inline void environment::log_command( const std::shared_ptr<command>& cmd, const std::string& cmdstring, const std::chrono::system_clock::time_point& start, const detail::log_map_t& extra )
+{
+  auto cmdlog = cmd->log();
+  if ( !extra.empty() )
+  {
+    if ( cmdlog == boost::none )
+    {
+      cmdlog = detail::log_map_t();
+    }
+    cmdlog->insert( extra.begin(), extra.end() );
+  }
+  log_command( cmdlog, cmdstring, start );
+}
+
 /******************************************************************************
  * customize stores                                                           *
  ******************************************************************************/
@@ -565,6 +587,27 @@ T store_read_io_type( const std::string& filename, const command& cmd )
   return T();
 }
 
+/* session snapshots: an element is written to os starting at an 8-byte
+   aligned file offset, and read back from data, which is 8-byte aligned and
+   only valid during the call (e.g., it points into a memory mapped file) */
+template<typename T>
+bool store_can_save_session()
+{
+  return false;
+}
+
+template<typename T>
+void store_save_session( std::ostream& os, const T& element )
+{
+  assert( false );
+}
+
+template<typename T>
+void store_load_session( const char* data, std::size_t size, T& element )
+{
+  assert( false );
+}
+
 template<typename T>
 bool store_has_repr_html()
 {
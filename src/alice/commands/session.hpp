@@ -0,0 +1,391 @@
+/* alice: A C++ EDA command line interface API
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file session.hpp
+ *
+ * @brief Save and load binary snapshots of all stores
+ *
+ * A session file starts with an 8 byte magic, followed by one record per
+ * store: the store key, the current index, the number of entries, and each
+ * entry as its byte size and payload.  Records and payloads start at 8-byte
+ * aligned offsets, such that entries can be read in place from a memory
+ * mapping.  Stores of unknown keys are skipped when loading, stores that do
+ * not implement store_can_save_session are not saved.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <alice/command.hpp>
+
+namespace alice
+{
+
+namespace detail
+{
+
+constexpr char session_magic[8] = {'A', 'L', 'S', 'E', 'S', 'S', '0', '1'};
+
+inline void session_align( std::ostream& os )
+{
+  static const char zeros[8] = {};
+
+  const auto pos = static_cast<std::uint64_t>( os.tellp() );
+  if ( pos % 8u != 0u )
+  {
+    os.write( zeros, 8u - pos % 8u );
+  }
+}
+
+template<typename T>
+inline void session_write( std::ostream& os, const T& value )
+{
+  os.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+/* read-only mapping of a session file */
+class session_file
+{
+public:
+  explicit session_file( const std::string& filename )
+  {
+    const auto fd = open( filename.c_str(), O_RDONLY );
+    if ( fd == -1 ) { return; }
+
+    struct stat st;
+    if ( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    {
+      const auto addr = mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( addr != MAP_FAILED )
+      {
+        data = static_cast<const char*>( addr );
+        size = st.st_size;
+      }
+    }
+    close( fd );
+  }
+
+  ~session_file()
+  {
+    if ( data ) { munmap( const_cast<char*>( data ), size ); }
+  }
+
+  template<typename T>
+  T read()
+  {
+    T value;
+    std::memcpy( &value, advance( sizeof( T ) ), sizeof( T ) );
+    return value;
+  }
+
+  const char* advance( std::uint64_t bytes )
+  {
+    if ( bytes > size - pos ) { throw std::runtime_error( "session file is truncated" ); }
+    const auto* p = data + pos;
+    pos += bytes;
+    return p;
+  }
+
+  void align()
+  {
+    pos = std::min<std::uint64_t>( size, ( pos + 7u ) & ~UINT64_C( 7 ) );
+  }
+
+public:
+  const char*   data = nullptr;
+  std::uint64_t size = 0u;
+  std::uint64_t pos  = 0u;
+};
+
+}
+
+template<typename S>
+int save_session_helper( std::ostream& os, const environment::ptr& env, unsigned& num_entries )
+{
+  if ( !store_can_save_session<S>() )
+  {
+    if ( !env->store<S>().empty() )
+    {
+      constexpr auto name_plural = store_info<S>::name_plural;
+      std::cout << boost::format( "[w] %s are not saved" ) % name_plural << std::endl;
+    }
+    return 0;
+  }
+
+  const auto& store = env->store<S>();
+  const std::string key = store_info<S>::key;
+
+  detail::session_write<std::uint32_t>( os, key.size() );
+  os.write( key.data(), key.size() );
+  detail::session_align( os );
+  detail::session_write<std::int32_t>( os, store.current_index() );
+  detail::session_write<std::uint32_t>( os, store.size() );
+
+  for ( const auto& element : store.data() )
+  {
+    /* size is patched after the payload has been written */
+    const auto size_pos = os.tellp();
+    detail::session_write<std::uint64_t>( os, 0u );
+
+    const auto begin = os.tellp();
+    store_save_session<S>( os, element );
+    const auto end = os.tellp();
+    detail::session_align( os );
+
+    os.seekp( size_pos );
+    detail::session_write<std::uint64_t>( os, end - begin );
+    os.seekp( 0, std::ios_base::end );
+
+    ++num_entries;
+  }
+
+  return 0;
+}
+
+template<typename S>
+int load_session_helper( const std::string& key, detail::session_file& file, int current, std::uint32_t count,
+                         std::tuple<std::vector<S>, int, bool>& loaded, bool& found )
+{
+  if ( found || !store_can_save_session<S>() || key != store_info<S>::key ) { return 0; }
+  found = true;
+
+  auto& entries = std::get<0>( loaded );
+  entries.clear();
+  entries.resize( count );
+  for ( auto& element : entries )
+  {
+    const auto size = file.read<std::uint64_t>();
+    const auto* data = file.advance( size );
+    file.align();
+    store_load_session<S>( data, size, element );
+  }
+  std::get<1>( loaded ) = current;
+  std::get<2>( loaded ) = true;
+
+  return 0;
+}
+
+template<typename S>
+int commit_session_helper( const environment::ptr& env, std::tuple<std::vector<S>, int, bool>& loaded )
+{
+  if ( !std::get<2>( loaded ) ) { return 0; }
+
+  auto& store = env->store<S>();
+  store.clear();
+  for ( auto& element : std::get<0>( loaded ) )
+  {
+    store.extend();
+    store.current() = std::move( element );
+  }
+  if ( std::get<1>( loaded ) >= 0 && std::get<1>( loaded ) < static_cast<int>( store.size() ) )
+  {
+    store.set_current_index( std::get<1>( loaded ) );
+  }
+
+  return 0;
+}
+
+template<class... S>
+class save_session_command : public command
+{
+public:
+  save_session_command( const environment::ptr& env )
+    : command( env, "Saves all stores into a binary session file" )
+  {
+    add_positional_option( "filename" );
+    opts.add_options()
+      ( "filename", boost::program_options::value( &filename ), "filename" )
+      ;
+  }
+
+protected:
+  rules_t validity_rules() const
+  {
+    return {{[this]() { return is_set( "filename" ); }, "no filename specified"}};
+  }
+
+  bool execute()
+  {
+    num_entries = 0u;
+
+    /* write to a temporary file first, such that an existing session is never left partial */
+    const auto tmpname = filename + ".tmp";
+    std::string error;
+    {
+      std::ofstream os( tmpname.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc );
+      if ( !os )
+      {
+        std::cout << "[e] cannot write " << filename << std::endl;
+        return false;
+      }
+
+      try
+      {
+        os.write( detail::session_magic, sizeof( detail::session_magic ) );
+        [](...){}( save_session_helper<S>( os, env, num_entries )... );
+      }
+      catch ( const std::exception& e )
+      {
+        error = e.what();
+      }
+
+      if ( error.empty() && !os )
+      {
+        error = "write error";
+      }
+    }
+
+    if ( !error.empty() )
+    {
+      std::cout << boost::format( "[e] cannot save session to %s: %s" ) % filename % error << std::endl;
+      std::remove( tmpname.c_str() );
+      return false;
+    }
+    std::rename( tmpname.c_str(), filename.c_str() );
+
+    return true;
+  }
+
+public:
+  log_opt_t log() const
+  {
+    return log_opt_t({{"filename", filename}, {"entries", static_cast<int>( num_entries )}});
+  }
+
+private:
+  std::string filename;
+  unsigned    num_entries = 0u;
+};
+
+template<class... S>
+class load_session_command : public command
+{
+public:
+  load_session_command( const environment::ptr& env )
+    : command( env, "Loads all stores from a binary session file" )
+  {
+    add_positional_option( "filename" );
+    opts.add_options()
+      ( "filename", boost::program_options::value( &filename ), "filename" )
+      ;
+  }
+
+protected:
+  rules_t validity_rules() const
+  {
+    return {{[this]() { return is_set( "filename" ); }, "no filename specified"}};
+  }
+
+  bool execute()
+  {
+    detail::session_file file( filename );
+    if ( !file.data )
+    {
+      std::cout << "[e] cannot read " << filename << std::endl;
+      return false;
+    }
+
+    /* stores are only replaced once the whole file has been read successfully */
+    std::tuple<std::tuple<std::vector<S>, int, bool>...> loaded;
+
+    try
+    {
+      if ( std::memcmp( file.advance( sizeof( detail::session_magic ) ), detail::session_magic, sizeof( detail::session_magic ) ) != 0 )
+      {
+        throw std::runtime_error( "not a session file" );
+      }
+
+      while ( file.pos < file.size )
+      {
+        const auto key_size = file.read<std::uint32_t>();
+        const std::string key( file.advance( key_size ), key_size );
+        file.align();
+        const auto current = file.read<std::int32_t>();
+        const auto count = file.read<std::uint32_t>();
+
+        auto found = false;
+        [](...){}( load_session_helper<S>( key, file, current, count, std::get<std::tuple<std::vector<S>, int, bool>>( loaded ), found )... );
+
+        if ( !found )
+        {
+          std::cout << boost::format( "[w] skipping unknown store %s" ) % key << std::endl;
+          for ( auto i = 0u; i < count; ++i )
+          {
+            file.advance( file.read<std::uint64_t>() );
+            file.align();
+          }
+        }
+      }
+    }
+    catch ( const std::exception& e )
+    {
+      std::cout << boost::format( "[e] cannot load session from %s: %s" ) % filename % e.what() << std::endl;
+      return false;
+    }
+
+    [](...){}( commit_session_helper<S>( env, std::get<std::tuple<std::vector<S>, int, bool>>( loaded ) )... );
+
+    return true;
+  }
+
+public:
+  log_opt_t log() const
+  {
+    return log_opt_t({{"filename", filename}});
+  }
+
+private:
+  std::string filename;
+};
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
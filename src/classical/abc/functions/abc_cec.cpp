@@ -28,6 +28,7 @@
 
 #include <classical/abc/abc_api.hpp>
 #include <classical/abc/abc_manager.hpp>
+#include <classical/functions/fraig.hpp>
 #include <classical/functions/simulate_aig.hpp>
 #include <classical/utils/aig_utils.hpp>
 #include <core/utils/range_utils.hpp>
@@ -128,11 +129,20 @@ boost::optional< counterexample_t > abc_cec( const aig_graph& circuit, const aig
   assert( num_inputs == spec_info.inputs.size() );
   assert( num_outputs == spec_info.outputs.size() );
 
-  auto abc = abc_manager::get();
+  /* settings */
+  const auto fraig_prepass = get( settings, "fraig", false );
 
   /* Timer */
   properties_timer t( statistics );
 
+  /* most equivalences are proved by SAT sweeping, without the conversion to ABC */
+  if ( fraig_prepass && fraig_equivalence_check( circuit, spec, settings ) )
+  {
+    return boost::optional< counterexample_t >();
+  }
+
+  auto abc = abc_manager::get();
+
   auto cec_result = abc->cec( circuit, spec );
   assert( cec_result.first == 0 );
 
@@ -44,6 +44,7 @@
 namespace cirkit
 {
 
+/* setting fraig (false): try to prove equivalence with fraig_equivalence_check first */
 boost::optional< counterexample_t > abc_cec( const aig_graph& circuit, const aig_graph& spec,
                                              properties::ptr settings = properties::ptr(), properties::ptr statistics = properties::ptr() );
 
@@ -287,13 +287,16 @@ aig_function aig_create_and( aig_graph& aig, const aig_function& left, const aig
 
   /* structural hashing */
   const bool in_order = left.node < right.node;
-  const auto key = std::make_pair( in_order ? left : right, in_order ? right : left );
+  const auto& first  = in_order ? left : right;
+  const auto& second = in_order ? right : left;
+  const strash_table<2u>::key_t key = {{strash_table<2u>::make_literal( first.node, first.complemented ),
+                                       strash_table<2u>::make_literal( second.node, second.complemented )}};
   if ( info.enable_strashing )
   {
-    const auto it = info.strash.find( key );
-    if ( it != info.strash.end() )
+    const auto existing = info.strash.find( key );
+    if ( existing != strash_table<2u>::empty )
     {
-      return it->second;
+      return { static_cast<aig_node>( existing ), false };
     }
   }
 
@@ -309,12 +312,10 @@ aig_function aig_create_and( aig_graph& aig, const aig_function& left, const aig
 
   if ( info.enable_strashing )
   {
-    return info.strash[key] = { node, false };
-  }
-  else
-  {
-    return { node, false };
+    info.strash.insert( key, node );
   }
+
+  return { node, false };
 }
 
 aig_function aig_create_nand( aig_graph& aig, const aig_function& left, const aig_function& right )
@@ -47,6 +47,7 @@
 
 #include <core/properties.hpp>
 #include <core/utils/graph_utils.hpp>
+#include <core/utils/strash_table.hpp>
 #include <classical/traits.hpp>
 
 namespace cirkit
@@ -105,7 +106,7 @@ struct aig_graph_info
   std::vector<detail::traits_t::vertex_descriptor>               inputs;
   std::vector<aig_function>                                      cos;
   std::vector<detail::traits_t::vertex_descriptor>               cis;
-  std::map<std::pair<aig_function, aig_function>, aig_function>  strash;
+  strash_table<2u>                                               strash;
   std::map<aig_function, aig_function>                           latch;
   boost::dynamic_bitset<>                                        unateness;
   std::vector<detail::node_pair>                                 input_symmetries;
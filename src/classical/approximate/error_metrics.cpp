@@ -145,7 +145,8 @@ boost::multiprecision::uint256_t get_max_value_with_chi( const std::vector<bdd>&
 
   boost::dynamic_bitset<> bs( f.size() );
 
-  while ( chi.var() < f.size() )
+  /* the output variables 0, ..., m - 1 are on the top m levels of the new manager */
+  while ( chi.level() < f.size() )
   {
     if ( chi.high().is_bot() )
     {
@@ -179,7 +180,7 @@ boost::multiprecision::uint256_t get_weighted_sum( const std::vector<bdd>& f )
   {
     auto p = stack.top(); stack.pop();
 
-    if ( p.first.var() >= level )
+    if ( p.first.level() >= level )
     {
       sum += to_multiprecision<boost::multiprecision::uint256_t>( p.second ) * ( count_solutions( p.first ) / ( one << level ) );
     }
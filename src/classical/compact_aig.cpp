@@ -0,0 +1,233 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "compact_aig.hpp"
+
+#include <boost/graph/topological_sort.hpp>
+
+#include <classical/utils/aig_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+constexpr compact_aig::literal compact_aig::pi_marker;
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+void compact_aig::rehash( std::size_t capacity )
+{
+  table.assign( capacity, 0u );
+  const auto mask = capacity - 1u;
+
+  for ( auto n = 1u; n < nodes.size(); ++n )
+  {
+    if ( !is_and( n ) ) { continue; }
+
+    auto pos = hash( nodes[n].fanin0, nodes[n].fanin1 ) & mask;
+    while ( table[pos] ) { pos = ( pos + 1u ) & mask; }
+    table[pos] = n;
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+compact_aig::compact_aig( const std::string& model_name )
+  : _model_name( model_name ),
+    nodes( 1u, {0u, 0u} ),
+    table( 1024u, 0u )
+{
+}
+
+compact_aig::literal compact_aig::create_pi( const std::string& name )
+{
+  const auto n = static_cast<node>( nodes.size() );
+  nodes.push_back( {static_cast<literal>( inputs.size() ), pi_marker} );
+  inputs.push_back( n );
+  input_names.push_back( name );
+  return make_literal( n, false );
+}
+
+void compact_aig::create_po( literal f, const std::string& name )
+{
+  assert( get_node( f ) < nodes.size() );
+  outputs.push_back( f );
+  output_names.push_back( name );
+}
+
+compact_aig::literal compact_aig::create_and( literal a, literal b )
+{
+  /* constants and trivial cases */
+  if ( a > b )         { std::swap( a, b ); }
+  if ( a == 0u )       { return 0u; }
+  if ( a == 1u )       { return b; }
+  if ( a == b )        { return a; }
+  if ( ( a ^ b ) == 1u ) { return 0u; }
+
+  const auto mask = table.size() - 1u;
+  auto pos = hash( a, b ) & mask;
+  while ( const auto n = table[pos] )
+  {
+    if ( nodes[n].fanin0 == a && nodes[n].fanin1 == b )
+    {
+      return make_literal( n, false );
+    }
+    pos = ( pos + 1u ) & mask;
+  }
+
+  const auto n = static_cast<node>( nodes.size() );
+  nodes.push_back( {a, b} );
+  table[pos] = n;
+
+  /* keep the load factor below 1/2 */
+  if ( ++num_hashed * 2u > table.size() )
+  {
+    rehash( table.size() << 1u );
+  }
+
+  return make_literal( n, false );
+}
+
+compact_aig::literal compact_aig::create_or( literal a, literal b )
+{
+  return create_and( a ^ 1u, b ^ 1u ) ^ 1u;
+}
+
+compact_aig::literal compact_aig::create_xor( literal a, literal b )
+{
+  return create_or( create_and( a ^ 1u, b ), create_and( a, b ^ 1u ) );
+}
+
+compact_aig::literal compact_aig::create_ite( literal c, literal t, literal e )
+{
+  return create_or( create_and( c, t ), create_and( c ^ 1u, e ) );
+}
+
+void compact_aig::reserve( unsigned num_nodes )
+{
+  nodes.reserve( num_nodes );
+
+  auto capacity = table.size();
+  while ( capacity < 2u * num_nodes ) { capacity <<= 1u; }
+  if ( capacity != table.size() )
+  {
+    rehash( capacity );
+  }
+}
+
+std::size_t compact_aig::memory() const
+{
+  return nodes.capacity() * sizeof( node_data ) + table.size() * sizeof( node ) +
+         inputs.capacity() * sizeof( node ) + outputs.capacity() * sizeof( literal );
+}
+
+compact_aig aig_to_compact_aig( const aig_graph& aig )
+{
+  const auto& info = aig_info( aig );
+  assert( info.cis.empty() && "only combinational AIGs are supported" );
+
+  compact_aig dest( info.model_name );
+  dest.reserve( boost::num_vertices( aig ) );
+
+  std::vector<compact_aig::literal> map( boost::num_vertices( aig ), 0u );
+  for ( const auto& input : info.inputs )
+  {
+    const auto it = info.node_names.find( input );
+    map[input] = dest.create_pi( it == info.node_names.end() ? std::string() : it->second );
+  }
+
+  /* children appear before their parents in topsort */
+  std::vector<aig_node> topsort( boost::num_vertices( aig ) );
+  boost::topological_sort( aig, topsort.begin() );
+
+  for ( const auto& n : topsort )
+  {
+    if ( boost::out_degree( n, aig ) == 0u ) { continue; }
+
+    auto it = boost::out_edges( n, aig ).first;
+    const auto c1 = aig_to_function( aig, *it++ );
+    const auto c2 = aig_to_function( aig, *it );
+
+    map[n] = dest.create_and( map[c1.node] ^ static_cast<compact_aig::literal>( c1.complemented ),
+                              map[c2.node] ^ static_cast<compact_aig::literal>( c2.complemented ) );
+  }
+
+  for ( const auto& output : info.outputs )
+  {
+    dest.create_po( map[output.first.node] ^ static_cast<compact_aig::literal>( output.first.complemented ), output.second );
+  }
+
+  return dest;
+}
+
+aig_graph compact_aig_to_aig( const compact_aig& aig )
+{
+  aig_graph dest;
+  aig_initialize( dest, aig.model_name() );
+
+  std::vector<aig_function> map( aig.size() );
+  map[0u] = aig_get_constant( dest, false );
+
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( aig.is_pi( n ) )
+    {
+      const auto i = aig.input_index( n );
+      const auto& name = aig.input_name( i );
+      map[n] = aig_create_pi( dest, name.empty() ? "input" + std::to_string( i ) : name );
+    }
+    else
+    {
+      const auto f0 = aig.fanin0( n ), f1 = aig.fanin1( n );
+      map[n] = aig_create_and( dest, map[compact_aig::get_node( f0 )] ^ compact_aig::is_complemented( f0 ),
+                                     map[compact_aig::get_node( f1 )] ^ compact_aig::is_complemented( f1 ) );
+    }
+  }
+
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    const auto f = aig.output( o );
+    const auto& name = aig.output_name( o );
+    aig_create_po( dest, map[compact_aig::get_node( f )] ^ compact_aig::is_complemented( f ), name.empty() ? "output" + std::to_string( o ) : name );
+  }
+
+  return dest;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
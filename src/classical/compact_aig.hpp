@@ -0,0 +1,142 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file compact_aig.hpp
+ *
+ * @brief Packed array-based AIG
+ *
+ * Each node takes two 32-bit literals, structural hashing uses an open
+ * addressing table of node indexes, and names are kept in side tables for
+ * inputs and outputs only.  Fanins always have a smaller index than their
+ * node, hence the node order is a topological order.  Only combinational
+ * AIGs are supported.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef COMPACT_AIG_HPP
+#define COMPACT_AIG_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <classical/aig.hpp>
+
+namespace cirkit
+{
+
+class compact_aig
+{
+public:
+  using node    = std::uint32_t;
+  using literal = std::uint32_t; /* 2 * node + complement */
+
+  explicit compact_aig( const std::string& model_name = std::string() );
+
+  static inline literal make_literal( node n, bool complemented ) { return ( n << 1u ) | static_cast<literal>( complemented ); }
+  static inline node    get_node( literal f )                     { return f >> 1u; }
+  static inline bool    is_complemented( literal f )              { return f & 1u; }
+
+  inline literal get_constant( bool value ) const { return static_cast<literal>( value ); }
+
+  literal create_pi( const std::string& name = std::string() );
+  void create_po( literal f, const std::string& name = std::string() );
+  literal create_and( literal a, literal b );
+  literal create_or( literal a, literal b );
+  literal create_xor( literal a, literal b );
+  literal create_ite( literal c, literal t, literal e );
+
+  /* structural information */
+  inline unsigned size() const        { return nodes.size(); }
+  inline unsigned num_inputs() const  { return inputs.size(); }
+  inline unsigned num_outputs() const { return outputs.size(); }
+  inline unsigned num_gates() const   { return nodes.size() - inputs.size() - 1u; }
+
+  inline bool is_constant( node n ) const { return n == 0u; }
+  inline bool is_pi( node n ) const       { return nodes[n].fanin1 == pi_marker; }
+  inline bool is_and( node n ) const      { return n != 0u && nodes[n].fanin1 != pi_marker; }
+
+  inline literal fanin0( node n ) const   { assert( is_and( n ) ); return nodes[n].fanin0; }
+  inline literal fanin1( node n ) const   { assert( is_and( n ) ); return nodes[n].fanin1; }
+  inline unsigned input_index( node n ) const { assert( is_pi( n ) ); return nodes[n].fanin0; }
+
+  inline node input( unsigned i ) const    { return inputs[i]; }
+  inline literal output( unsigned o ) const { return outputs[o]; }
+
+  inline const std::string& input_name( unsigned i ) const  { return input_names[i]; }
+  inline const std::string& output_name( unsigned o ) const { return output_names[o]; }
+  inline const std::string& model_name() const              { return _model_name; }
+
+  void reserve( unsigned num_nodes );
+
+  /* bytes used by nodes and the hash table, without names */
+  std::size_t memory() const;
+
+private:
+  static constexpr literal pi_marker = 0xffffffffu;
+
+  struct node_data
+  {
+    literal fanin0; /* input index for PIs */
+    literal fanin1; /* pi_marker for PIs */
+  };
+
+  inline std::size_t hash( literal a, literal b ) const
+  {
+    return ( ( static_cast<std::uint64_t>( a ) * 0x9e3779b97f4a7c15ull ) ^ ( static_cast<std::uint64_t>( b ) * 0xc2b2ae3d27d4eb4full ) ) >> 32u;
+  }
+
+  void rehash( std::size_t capacity );
+
+private:
+  std::string              _model_name;
+  std::vector<node_data>   nodes;
+  std::vector<node>        inputs;
+  std::vector<literal>     outputs;
+  std::vector<std::string> input_names;
+  std::vector<std::string> output_names;
+
+  /* open addressing with linear probing, 0 marks an empty slot */
+  std::vector<node>        table;
+  std::size_t              num_hashed = 0u;
+};
+
+compact_aig aig_to_compact_aig( const aig_graph& aig );
+aig_graph compact_aig_to_aig( const compact_aig& aig );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -26,11 +26,14 @@
 
 #include "bdd.hpp"
 
+#include <chrono>
+#include <stack>
 #include <vector>
 
 #include <boost/assign/std/vector.hpp>
 #include <boost/format.hpp>
 #include <boost/range/algorithm.hpp>
+#include <boost/range/algorithm_ext/iota.hpp>
 #include <boost/range/counting_range.hpp>
 
 #include <core/utils/bitset_utils.hpp>
@@ -47,151 +50,182 @@ namespace cirkit
  ******************************************************************************/
 
 enum class bdd_operation {
-  _and, _or, _xor, _not, cof0, cof1, exists,
-  constrain, restrict, round_down, round_up, round
+  cof0, cof1, exists, constrain, restrict, round_down, round_up, round
 };
 
 /******************************************************************************
  * Private functions                                                          *
  ******************************************************************************/
 
+/* ITE shares the computed table with all other operations and uses all three
+   keys for its operands; other operations use an operation code as third key
+   that cannot be an edge */
+inline unsigned op_code( bdd_operation op )
+{
+  return -1u - static_cast<unsigned>( op );
+}
+
+inline unsigned op_code( unsigned op )
+{
+  return -1u - op;
+}
+
+inline unsigned regular( unsigned f )
+{
+  return f & ~1u;
+}
+
+inline bool is_complemented( unsigned f )
+{
+  return f & 1u;
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
 
 bdd_manager::bdd_manager( unsigned nvars, unsigned log_max_objs, bool verbose )
-  : dd_manager( nvars, log_max_objs, verbose ) {}
+  : dd_manager( nvars, log_max_objs, verbose ),
+    var2level( nvars + 1u ),
+    level2var( nvars + 1u )
+{
+  complement_edges = true;
+
+  /* the terminal variable nvars stays at the bottom */
+  boost::iota( var2level, 0u );
+  boost::iota( level2var, 0u );
+}
 
 bdd_manager::~bdd_manager() {}
 
-unsigned bdd_manager::bdd_and( unsigned f, unsigned g )
+unsigned bdd_manager::get_var( unsigned f ) const
 {
-  /* terminating cases */
-  if ( f == 0u ) { return 0u; }
-  if ( g == 0u ) { return 0u; }
-  if ( f == 1u ) { return g; }
-  if ( g == 1u ) { return f; }
-  if ( f == g )  { return f; }
+  return nodes.at( f >> 1u ).var;
+}
 
-  /* commutativity */
-  if ( f > g ) { return bdd_and( g, f ); }
+unsigned bdd_manager::get_high( unsigned f ) const
+{
+  return nodes.at( f >> 1u ).high ^ ( f & 1u );
+}
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::_and );
-  if ( r >= 0 ) { return r; }
+unsigned bdd_manager::get_low( unsigned f ) const
+{
+  return nodes.at( f >> 1u ).low ^ ( f & 1u );
+}
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
-  unsigned rlow, rhigh;
-  if ( node1.var < node2.var )
-  {
-    rlow = bdd_and( node1.low, g );
-    rhigh = bdd_and( node1.high, g );
-  }
-  else if ( node1.var > node2.var )
+void bdd_manager::cofactors( unsigned f, unsigned v, unsigned& high, unsigned& low ) const
+{
+  const auto node = nodes[f >> 1u];
+  if ( node.var == v )
   {
-    rlow = bdd_and( f, node2.low );
-    rhigh = bdd_and( f, node2.high );
+    high = node.high ^ ( f & 1u );
+    low  = node.low ^ ( f & 1u );
   }
   else
   {
-    rlow = bdd_and( node1.low, node2.low );
-    rhigh = bdd_and( node1.high, node2.high );
+    high = low = f;
   }
-
-  auto idx = unique_create( std::min( node1.var, node2.var ), rhigh, rlow );
-  return cache.insert( f, g, (unsigned)bdd_operation::_and, idx );
 }
 
-unsigned bdd_manager::bdd_or( unsigned f, unsigned g )
+unsigned bdd_manager::bdd_ite( unsigned f, unsigned g, unsigned h )
 {
   /* terminating cases */
-  if ( f == 0u ) { return g; }
-  if ( g == 0u ) { return f; }
-  if ( f == 1u ) { return 1u; }
-  if ( g == 1u ) { return 1u; }
-  if ( f == g )  { return f; }
+  if ( f == 1u ) { return g; }
+  if ( f == 0u ) { return h; }
 
-  /* commutativity */
-  if ( f > g ) { return bdd_or( g, f ); }
+  /* ite(f, f, h) = ite(f, 1, h) and similar */
+  if ( g == f )           { g = 1u; }
+  else if ( g == ( f ^ 1u ) ) { g = 0u; }
+  if ( h == f )           { h = 0u; }
+  else if ( h == ( f ^ 1u ) ) { h = 1u; }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::_or );
-  if ( r >= 0 ) { return r; }
+  if ( g == h )                { return g; }
+  if ( g == 1u && h == 0u )    { return f; }
+  if ( g == 0u && h == 1u )    { return f ^ 1u; }
+
+  /* standard triples: the first argument has the smallest top variable */
+  const auto before = [this]( unsigned a, unsigned b ) {
+    const auto la = get_level( a ), lb = get_level( b );
+    return la < lb || ( la == lb && a < b );
+  };
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
-  unsigned rlow, rhigh;
-  if ( node1.var < node2.var )
+  if ( g == 1u )
   {
-    rlow = bdd_or( node1.low, g );
-    rhigh = bdd_or( node1.high, g );
+    /* ite(f, 1, h) = ite(h, 1, f) */
+    if ( before( h, f ) ) { std::swap( f, h ); }
   }
-  else if ( node1.var > node2.var )
+  else if ( h == 0u )
   {
-    rlow = bdd_or( f, node2.low );
-    rhigh = bdd_or( f, node2.high );
+    /* ite(f, g, 0) = ite(g, f, 0) */
+    if ( before( g, f ) ) { std::swap( f, g ); }
   }
-  else
+  else if ( g == 0u )
   {
-    rlow = bdd_or( node1.low, node2.low );
-    rhigh = bdd_or( node1.high, node2.high );
+    /* ite(f, 0, h) = ite(!h, 0, !f) */
+    if ( before( h, f ) ) { const auto t = f; f = h ^ 1u; h = t ^ 1u; }
   }
-
-  auto idx = unique_create( std::min( node1.var, node2.var ), rhigh, rlow );
-  return cache.insert( f, g, (unsigned)bdd_operation::_or, idx );
-}
-
-unsigned bdd_manager::bdd_xor( unsigned f, unsigned g )
-{
-  /* terminating cases */
-  if ( f == 0u ) { return g; }
-  if ( g == 0u ) { return f; }
-  if ( f == g )  { return 0u; }
-
-  /* commutativity */
-  if ( f > g ) { return bdd_xor( g, f ); }
-
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::_xor );
-  if ( r >= 0 ) { return r; }
-
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
-  unsigned rlow, rhigh;
-  if ( node1.var < node2.var )
+  else if ( h == 1u )
   {
-    rlow = bdd_xor( node1.low, g );
-    rhigh = bdd_xor( node1.high, g );
+    /* ite(f, g, 1) = ite(!g, !f, 1) */
+    if ( before( g, f ) ) { const auto t = f; f = g ^ 1u; g = t ^ 1u; }
   }
-  else if ( node1.var > node2.var )
+  else if ( g == ( h ^ 1u ) )
   {
-    rlow = bdd_xor( f, node2.low );
-    rhigh = bdd_xor( f, node2.high );
+    /* ite(f, g, !g) = ite(g, f, !f) */
+    if ( before( g, f ) ) { const auto t = f; f = g; g = t; h = t ^ 1u; }
   }
-  else
+
+  /* first argument is regular: ite(!f, g, h) = ite(f, h, g) */
+  if ( is_complemented( f ) )
   {
-    rlow = bdd_xor( node1.low, node2.low );
-    rhigh = bdd_xor( node1.high, node2.high );
+    f ^= 1u;
+    std::swap( g, h );
   }
 
-  auto idx = unique_create( std::min( node1.var, node2.var ), rhigh, rlow );
-  return cache.insert( f, g, (unsigned)bdd_operation::_xor, idx );
+  /* second argument is regular: ite(f, !g, !h) = !ite(f, g, h) */
+  auto complement = 0u;
+  if ( is_complemented( g ) )
+  {
+    g ^= 1u;
+    h ^= 1u;
+    complement = 1u;
+  }
+
+  const auto r = cache.lookup( f, g, h );
+  if ( r >= 0 ) { return r ^ complement; }
+
+  const auto v = level2var[std::min( std::min( get_level( f ), get_level( g ) ), get_level( h ) )];
+
+  unsigned fh, fl, gh, gl, hh, hl;
+  cofactors( f, v, fh, fl );
+  cofactors( g, v, gh, gl );
+  cofactors( h, v, hh, hl );
+
+  const auto rhigh = bdd_ite( fh, gh, hh );
+  const auto rlow  = bdd_ite( fl, gl, hl );
+
+  const auto idx = unique_create( v, rhigh, rlow );
+  return cache.insert( f, g, h, idx ) ^ complement;
 }
 
-unsigned bdd_manager::bdd_not( unsigned f )
+unsigned bdd_manager::bdd_and( unsigned f, unsigned g )
 {
-  /* terminating cases */
-  if ( f == 0u ) { return 1u; }
-  if ( f == 1u ) { return 0u; }
-
-  const auto r = cache.lookup( f, f, (unsigned)bdd_operation::_not );
-  if ( r >= 0 ) { return r; }
+  return bdd_ite( f, g, 0u );
+}
 
-  const auto& node = nodes.at( f );
+unsigned bdd_manager::bdd_or( unsigned f, unsigned g )
+{
+  return bdd_ite( f, 1u, g );
+}
 
-  auto rlow = bdd_not( node.low );
-  auto rhigh = bdd_not( node.high );
+unsigned bdd_manager::bdd_xor( unsigned f, unsigned g )
+{
+  return bdd_ite( f, g ^ 1u, g );
+}
 
-  auto idx = unique_create( node.var, rhigh, rlow );
-  return cache.insert( f, f, (unsigned)bdd_operation::_not, idx );
+unsigned bdd_manager::bdd_not( unsigned f )
+{
+  return f ^ 1u;
 }
 
 unsigned bdd_manager::bdd_cof0( unsigned f, unsigned v )
@@ -199,14 +233,17 @@ unsigned bdd_manager::bdd_cof0( unsigned f, unsigned v )
   /* terminating cases */
   if ( f <= 1u ) { return f; }
 
-  const auto& node = nodes.at( f );
-  if ( node.var > v ) { return f; }
+  /* cof0(!f) = !cof0(f) */
+  if ( is_complemented( f ) ) { return bdd_cof0( f ^ 1u, v ) ^ 1u; }
 
-  const auto r = cache.lookup( f, v, (unsigned)bdd_operation::cof0 );
+  const auto node = nodes.at( f >> 1u );
+  if ( var2level[node.var] > var2level[v] ) { return f; }
+
+  const auto r = cache.lookup( f, v, op_code( bdd_operation::cof0 ) );
   if ( r >= 0 ) { return r; }
 
   unsigned idx;
-  if ( node.var < v )
+  if ( node.var != v )
   {
     const auto rlow  = bdd_cof0( node.low, v );
     const auto rhigh = bdd_cof0( node.high, v );
@@ -216,7 +253,7 @@ unsigned bdd_manager::bdd_cof0( unsigned f, unsigned v )
   {
     idx = node.low;
   }
-  return cache.insert( f, v, (unsigned)bdd_operation::cof0, idx );
+  return cache.insert( f, v, op_code( bdd_operation::cof0 ), idx );
 }
 
 unsigned bdd_manager::bdd_cof1( unsigned f, unsigned v )
@@ -224,14 +261,17 @@ unsigned bdd_manager::bdd_cof1( unsigned f, unsigned v )
   /* terminating cases */
   if ( f <= 1u ) { return f; }
 
-  const auto& node = nodes.at( f );
-  if ( node.var > v ) { return f; }
+  /* cof1(!f) = !cof1(f) */
+  if ( is_complemented( f ) ) { return bdd_cof1( f ^ 1u, v ) ^ 1u; }
+
+  const auto node = nodes.at( f >> 1u );
+  if ( var2level[node.var] > var2level[v] ) { return f; }
 
-  const auto r = cache.lookup( f, v, (unsigned)bdd_operation::cof1 );
+  const auto r = cache.lookup( f, v, op_code( bdd_operation::cof1 ) );
   if ( r >= 0 ) { return r; }
 
   unsigned idx;
-  if ( node.var < v )
+  if ( node.var != v )
   {
     const auto rlow  = bdd_cof1( node.low, v );
     const auto rhigh = bdd_cof1( node.high, v );
@@ -241,7 +281,7 @@ unsigned bdd_manager::bdd_cof1( unsigned f, unsigned v )
   {
     idx = node.high;
   }
-  return cache.insert( f, v, (unsigned)bdd_operation::cof1, idx );
+  return cache.insert( f, v, op_code( bdd_operation::cof1 ), idx );
 }
 
 unsigned bdd_manager::bdd_exists( unsigned f, unsigned g )
@@ -249,31 +289,32 @@ unsigned bdd_manager::bdd_exists( unsigned f, unsigned g )
   /* terminating cases */
   if ( g == 1u || f <= 1u ) { return f; }
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
+  const auto var1 = get_var( f );
+  const auto var2 = get_var( g );
 
-  if ( node1.var > node2.var )
+  if ( get_level( f ) > get_level( g ) )
   {
-    return bdd_exists( f, node2.high );
+    return bdd_exists( f, get_high( g ) );
   }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::exists );
+  const auto r = cache.lookup( f, g, op_code( bdd_operation::exists ) );
   if ( r >= 0 ) { return r; }
 
   unsigned idx;
-  auto rlow  = bdd_exists( node1.low, node1.var == node2.var ? node2.high : g );
+  const auto next = var1 == var2 ? get_high( g ) : g;
+  auto rlow  = bdd_exists( get_low( f ), next );
 
-  if ( rlow == 1 && node1.var == node2.var )
+  if ( rlow == 1u && var1 == var2 )
   {
-    idx = 1;
+    idx = 1u;
   }
   else
   {
-    auto rhigh = bdd_exists( node1.high, node1.var == node2.var ? node2.high : g );
+    auto rhigh = bdd_exists( get_high( f ), next );
 
-    if ( node1.var < node2.var )
+    if ( var1 != var2 )
     {
-      idx = unique_create( node1.var, rhigh, rlow );
+      idx = unique_create( var1, rhigh, rlow );
     }
     else
     {
@@ -281,7 +322,7 @@ unsigned bdd_manager::bdd_exists( unsigned f, unsigned g )
     }
   }
 
-  return cache.insert( f, g, (unsigned)bdd_operation::exists, idx );
+  return cache.insert( f, g, op_code( bdd_operation::exists ), idx );
 }
 
 unsigned bdd_manager::bdd_constrain( unsigned f, unsigned g )
@@ -290,43 +331,34 @@ unsigned bdd_manager::bdd_constrain( unsigned f, unsigned g )
   if ( g == 0u )            { return 0u; }
   if ( g == 1u || f <= 1u ) { return f;  }
   if ( f == g )             { return 1u; }
+  if ( f == ( g ^ 1u ) )    { return 0u; }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::constrain );
+  const auto r = cache.lookup( f, g, op_code( bdd_operation::constrain ) );
   if ( r >= 0 ) { return r; }
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
+  const auto v = level2var[std::min( get_level( f ), get_level( g ) )];
 
-  unsigned idx;
-
-  do {
-    unsigned v;
-
-    if ( node1.var < node2.var )
-    {
-      v = node1.var;
-    }
-    else
-    {
-      v = node2.var;
-      if ( node2.low == 0u )
-      {
-        idx = bdd_constrain( node1.var == v ? node1.high : f, node2.high );
-        break;
-      }
-      else if ( node2.high == 0u )
-      {
-        idx = bdd_constrain( node1.var == v ? node1.low : f, node2.low );
-        break;
-      }
-    }
+  unsigned fh, fl, gh, gl;
+  cofactors( f, v, fh, fl );
+  cofactors( g, v, gh, gl );
 
-    auto rlow = bdd_constrain( node1.var == v ? node1.low : f, node2.var == v ? node2.low : g );
-    auto rhigh = bdd_constrain( node1.var == v ? node1.high : f, node2.var == v ? node2.high : g );
+  unsigned idx;
+  if ( gl == 0u )
+  {
+    idx = bdd_constrain( fh, gh );
+  }
+  else if ( gh == 0u )
+  {
+    idx = bdd_constrain( fl, gl );
+  }
+  else
+  {
+    const auto rlow  = bdd_constrain( fl, gl );
+    const auto rhigh = bdd_constrain( fh, gh );
     idx = unique_create( v, rhigh, rlow );
-  } while ( false );
+  }
 
-  return cache.insert( f, g, (unsigned)bdd_operation::constrain, idx );
+  return cache.insert( f, g, op_code( bdd_operation::constrain ), idx );
 }
 
 unsigned bdd_manager::bdd_restrict( unsigned f, unsigned g )
@@ -335,50 +367,39 @@ unsigned bdd_manager::bdd_restrict( unsigned f, unsigned g )
   if ( g == 0u )            { return 0u; }
   if ( g == 1u || f <= 1u ) { return f;  }
   if ( f == g )             { return 1u; }
+  if ( f == ( g ^ 1u ) )    { return 0u; }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::restrict );
+  const auto r = cache.lookup( f, g, op_code( bdd_operation::restrict ) );
   if ( r >= 0 ) { return r; }
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
+  const auto v = level2var[std::min( get_level( f ), get_level( g ) )];
 
-  unsigned idx;
-
-  do {
-    unsigned v;
-
-    if ( node1.var < node2.var )
-    {
-      v = node1.var;
-    }
-    else
-    {
-      v = node2.var;
-      if ( node2.low == 0u )
-      {
-        idx = bdd_restrict( node1.var == v ? node1.high : f, node2.high );
-        break;
-      }
-      else if ( node2.high == 0u )
-      {
-        idx = bdd_restrict( node1.var == v ? node1.low : f, node2.low );
-        break;
-      }
-    }
-
-    /* special case in RESTRICT */
-    if ( node1.low == node1.high )
-    {
-      idx = bdd_restrict( f, bdd_exists( g, v + 2u ) );
-      break;
-    }
+  unsigned fh, fl, gh, gl;
+  cofactors( f, v, fh, fl );
+  cofactors( g, v, gh, gl );
 
-    auto rlow = bdd_restrict( node1.var == v ? node1.low : f, node2.var == v ? node2.low : g );
-    auto rhigh = bdd_restrict( node1.var == v ? node1.high : f, node2.var == v ? node2.high : g );
+  unsigned idx;
+  if ( gl == 0u )
+  {
+    idx = bdd_restrict( fh, gh );
+  }
+  else if ( gh == 0u )
+  {
+    idx = bdd_restrict( fl, gl );
+  }
+  /* special case in RESTRICT: f does not depend on v */
+  else if ( fl == fh )
+  {
+    idx = bdd_restrict( f, bdd_or( gl, gh ) );
+  }
+  else
+  {
+    const auto rlow  = bdd_restrict( fl, gl );
+    const auto rhigh = bdd_restrict( fh, gh );
     idx = unique_create( v, rhigh, rlow );
-  } while ( false );
+  }
 
-  return cache.insert( f, g, (unsigned)bdd_operation::restrict, idx );
+  return cache.insert( f, g, op_code( bdd_operation::restrict ), idx );
 }
 
 unsigned bdd_manager::bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to )
@@ -396,36 +417,38 @@ unsigned bdd_manager::bdd_round_to( unsigned f, unsigned level, unsigned cop, un
   /* terminating cases */
   if ( f <= 1u ) { return f; }
 
-  const auto r = cache.lookup( f, level, cop );
+  const auto r = cache.lookup( f, level, op_code( cop ) );
   if ( r >= 0 ) { return r; }
 
-  const auto& node = nodes.at( f );
+  const auto var  = get_var( f );
+  const auto high = get_high( f );
+  const auto low  = get_low( f );
 
   auto idx = 0u;
-  if ( node.var < level )
+  if ( get_level( f ) < level )
   {
-    auto rlow = bdd_round_to( node.low, level, cop, to, count_map );
-    auto rhigh = bdd_round_to( node.high, level, cop, to, count_map );
+    auto rlow = bdd_round_to( low, level, cop, to, count_map );
+    auto rhigh = bdd_round_to( high, level, cop, to, count_map );
 
-    idx = unique_create( node.var, rhigh, rlow );
+    idx = unique_create( var, rhigh, rlow );
   }
   else
   {
-    auto cl = count_map.at( node.low );
-    auto ch = count_map.at( node.high );
+    auto cl = count_map.at( low );
+    auto ch = count_map.at( high );
 
     if ( cl < ch )
     {
-      auto rhigh = bdd_round_to( node.high, level, cop, to, count_map );
-      idx = unique_create( node.var, rhigh, to );
+      auto rhigh = bdd_round_to( high, level, cop, to, count_map );
+      idx = unique_create( var, rhigh, to );
     }
     else
     {
-      auto rlow = bdd_round_to( node.low, level, cop, to, count_map );
-      idx = unique_create( node.var, to, rlow );
+      auto rlow = bdd_round_to( low, level, cop, to, count_map );
+      idx = unique_create( var, to, rlow );
     }
   }
-  return cache.insert( f, level, cop, idx );
+  return cache.insert( f, level, op_code( cop ), idx );
 }
 
 unsigned bdd_manager::bdd_round_down( unsigned f, unsigned level )
@@ -443,30 +466,260 @@ unsigned bdd_manager::bdd_round( unsigned f, unsigned level )
   /* terminating cases */
   if ( f <= 1u ) { return f; }
 
-  const auto r = cache.lookup( f, level, (unsigned)bdd_operation::round );
+  const auto r = cache.lookup( f, level, op_code( bdd_operation::round ) );
   if ( r >= 0 ) { return r; }
 
-  const auto& node = nodes.at( f );
+  const auto var = get_var( f );
+  const auto lvl = get_level( f );
 
   auto idx = 0u;
-  if ( node.var < level )
+  if ( lvl < level )
   {
-    auto rlow = bdd_round( node.low, level );
-    auto rhigh = bdd_round( node.high, level );
+    auto rlow = bdd_round( get_low( f ), level );
+    auto rhigh = bdd_round( get_high( f ), level );
 
-    idx = unique_create( node.var, rhigh, rlow );
+    idx = unique_create( var, rhigh, rlow );
   }
   else
   {
-    auto onset = count_solutions( bdd( this, f ) ) / ( 1ull << node.var );
-    auto all   = 1ull << ( nvars - node.var );
+    auto onset = count_solutions( bdd( this, f ) ) / ( 1ull << lvl );
+    auto all   = 1ull << ( nvars - lvl );
 
     if ( ( onset << 1u ) > all ) /* if onset / all > .5 */
     {
       idx = 1u;
     }
   }
-  return cache.insert( f, level, (unsigned)bdd_operation::round, idx );
+  return cache.insert( f, level, op_code( bdd_operation::round ), idx );
+}
+
+void bdd_manager::reorder()
+{
+  assert( !in_operation() );
+
+  if ( nvars < 2u ) { return; }
+
+  const auto begin = std::chrono::steady_clock::now();
+
+  /* only nodes reachable from external references survive */
+  collect();
+  const auto before = size();
+
+  rcount.assign( nodes.size(), 0u );
+  var_nodes.assign( nvars, std::vector<unsigned>() );
+  for ( auto z = 2u + nvars; z < nused; ++z )
+  {
+    const auto& n = nodes[z];
+    if ( n.var == -1u ) { continue; }
+
+    rcount[z] += refs[z];
+    ++rcount[n.high >> 1u];
+    ++rcount[n.low >> 1u];
+    var_nodes[n.var].push_back( z );
+  }
+
+  /* sift variables with many nodes first */
+  std::vector<unsigned> vars( nvars );
+  boost::iota( vars, 0u );
+  boost::stable_sort( vars, [this]( unsigned a, unsigned b ) { return var_nodes[a].size() > var_nodes[b].size(); } );
+
+  for ( auto v : vars )
+  {
+    sift( v );
+  }
+
+  for ( auto z : dead )
+  {
+    free_node( z );
+  }
+
+  dead.clear();
+  rcount.clear();
+  var_nodes.clear();
+  cache.clear();
+
+  next_reorder = std::max( reorder_threshold, 2u * size() );
+  ++num_reorders;
+  reorder_time += std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count();
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] bdd reordering from %d to %d nodes" ) % before % size() << std::endl;
+  }
+}
+
+void bdd_manager::set_reorder_enabled( bool enabled )
+{
+  reorder_enabled = enabled;
+}
+
+void bdd_manager::set_reorder_threshold( unsigned threshold )
+{
+  reorder_threshold = next_reorder = threshold;
+}
+
+void bdd_manager::set_max_growth( double max_growth )
+{
+  assert( max_growth >= 1.0 );
+  this->max_growth = max_growth;
+}
+
+void bdd_manager::dump_stats( std::ostream& stream ) const
+{
+  dd_manager::dump_stats( stream );
+
+  stream << boost::format ("-- Reorderings: %9d\n") % num_reorders;
+  stream << boost::format ("-- Swaps:       %9d\n") % num_swaps;
+  stream << boost::format ("-- Reorder time:%9.2f secs\n") % reorder_time;
+}
+
+void bdd_manager::maintain()
+{
+  dd_manager::maintain();
+
+  if ( reorder_enabled && size() > next_reorder )
+  {
+    reorder();
+  }
+}
+
+void bdd_manager::sift( unsigned var )
+{
+  const auto start = var2level[var];
+  auto best_size   = live_nodes();
+  auto best_level  = start;
+
+  const auto move = [&]( bool down, bool bounded ) {
+    while ( down ? var2level[var] + 1u < nvars : var2level[var] > 0u )
+    {
+      swap_levels( down ? var2level[var] : var2level[var] - 1u );
+
+      if ( live_nodes() < best_size )
+      {
+        best_size  = live_nodes();
+        best_level = var2level[var];
+      }
+      else if ( bounded && live_nodes() > max_growth * best_size )
+      {
+        break;
+      }
+    }
+  };
+
+  /* move towards the closer end first, then back and towards the other end */
+  const auto down_first = 2u * start + 1u >= nvars;
+  move( down_first, true );
+  while ( var2level[var] != start ) { swap_levels( down_first ? var2level[var] - 1u : var2level[var] ); }
+  move( !down_first, true );
+
+  while ( var2level[var] < best_level ) { swap_levels( var2level[var] ); }
+  while ( var2level[var] > best_level ) { swap_levels( var2level[var] - 1u ); }
+}
+
+void bdd_manager::swap_levels( unsigned level )
+{
+  assert( level + 1u < nvars );
+
+  const auto x = level2var[level];
+  const auto y = level2var[level + 1u];
+
+  std::vector<unsigned> xs;
+  xs.swap( var_nodes[x] );
+
+  for ( auto z : xs )
+  {
+    if ( nodes[z].var != x ) { continue; } /* dead */
+
+    const auto f1 = nodes[z].high;
+    const auto f0 = nodes[z].low;
+
+    /* nodes that do not depend on y stay labeled with x */
+    if ( get_var( f1 ) != y && get_var( f0 ) != y )
+    {
+      var_nodes[x].push_back( z );
+      continue;
+    }
+
+    unsigned f11, f10, f01, f00;
+    cofactors( f1, y, f11, f10 );
+    cofactors( f0, y, f01, f00 );
+
+    /* creation may resize the unique table, therefore z stays in the table
+       with its old content until the children are created */
+    const auto g1 = reorder_create( x, f11, f01 );
+    const auto g0 = reorder_create( x, f10, f00 );
+    ++rcount[g1 >> 1u];
+    ++rcount[g0 >> 1u];
+
+    /* the low edge stays regular, since f0 and f00 are regular */
+    assert( !( g0 & 1u ) );
+
+    unique_remove( z );
+    nodes[z] = {y, g1, g0};
+    unique_insert( z );
+    var_nodes[y].push_back( z );
+
+    reorder_deref( f1 );
+    reorder_deref( f0 );
+  }
+
+  std::swap( level2var[level], level2var[level + 1u] );
+  var2level[x] = level + 1u;
+  var2level[y] = level;
+
+  ++num_swaps;
+}
+
+unsigned bdd_manager::reorder_create( unsigned var, unsigned high, unsigned low )
+{
+  if ( high == low ) { return high; }
+
+  const auto complement = low & 1u;
+  high ^= complement;
+  low  ^= complement;
+
+  const auto before = nnodes;
+  const auto z = unique_lookup( var, high, low );
+
+  if ( rcount.size() < nodes.size() )
+  {
+    rcount.resize( nodes.size(), 0u );
+  }
+
+  if ( nnodes != before ) /* new node */
+  {
+    ++rcount[high >> 1u];
+    ++rcount[low >> 1u];
+    var_nodes[var].push_back( z );
+  }
+
+  return ( z << 1u ) | complement;
+}
+
+void bdd_manager::reorder_deref( unsigned f )
+{
+  std::stack<unsigned> stack;
+  stack.push( f >> 1u );
+
+  while ( !stack.empty() )
+  {
+    const auto z = stack.top();
+    stack.pop();
+
+    /* terminals and variable nodes are never freed */
+    if ( z < 2u + nvars ) { continue; }
+
+    assert( rcount[z] );
+    if ( --rcount[z] ) { continue; }
+
+    const auto n = nodes[z];
+    unique_remove( z );
+    nodes[z].var = -1u;
+    dead.push_back( z );
+
+    stack.push( n.high >> 1u );
+    stack.push( n.low >> 1u );
+  }
 }
 
 bdd_manager_ptr bdd_manager::create( unsigned nvars, unsigned log_max_objs, bool verbose )
@@ -476,44 +729,73 @@ bdd_manager_ptr bdd_manager::create( unsigned nvars, unsigned log_max_objs, bool
 
 unsigned bdd_manager::unique_create( unsigned var, unsigned high, unsigned low )
 {
-  if ( verbose )
-  {
-    //std::cout << boost::format( "[i] attempt to create (%d, %d, %d)" ) % var % high % low << std::endl;
-  }
   assert( var < nvars );
-  assert( var < nodes[high].var );
-  assert( var < nodes[low].var );
+  assert( var2level[var] < get_level( high ) );
+  assert( var2level[var] < get_level( low ) );
 
   if ( high == low ) { return high; }
 
-  return unique_lookup( var, high, low );
+  /* the low edge is regular */
+  if ( is_complemented( low ) )
+  {
+    return ( unique_lookup( var, high ^ 1u, low ^ 1u ) << 1u ) | 1u;
+  }
+
+  return unique_lookup( var, high, low ) << 1u;
 }
 
 std::ostream& operator<<( std::ostream& os, const bdd_manager& mgr )
 {
+  /* node indexes, children are edges */
   for ( auto i : boost::counting_range( 0u, mgr.nvars + 2u ) )
   {
     os << i << ": " << mgr.nodes[i] << std::endl;
   }
 
-  auto * q = mgr.unique;
-
-  while ( q != mgr.unique + mgr.nodes.size() )
+  for ( auto q : mgr.unique )
   {
-    if ( *q )
+    for ( ; q; q = mgr.nexts[q] )
     {
-      os << *q << ": " << mgr.nodes[*q] << std::endl;
+      os << q << ": " << mgr.nodes[q] << std::endl;
     }
-    ++q;
   }
 
   return os;
 }
 
+bdd::bdd( bdd_manager* manager, unsigned index )
+  : manager( manager ),
+    index( index )
+{
+  if ( manager ) { manager->ref( index >> 1u ); }
+}
+
+bdd::bdd( const bdd& other )
+  : manager( other.manager ),
+    index( other.index )
+{
+  if ( manager ) { manager->ref( index >> 1u ); }
+}
+
+bdd::bdd( bdd&& other )
+  : manager( other.manager ),
+    index( other.index )
+{
+  other.manager = nullptr;
+  other.index   = 0u;
+}
+
+bdd::~bdd()
+{
+  if ( manager ) { manager->deref( index >> 1u ); }
+}
+
 bdd& bdd::operator=( const bdd& other )
 {
   if ( this == &other ) { return *this; }
   assert( !manager || manager == other.manager );
+  if ( other.manager ) { other.manager->ref( other.index >> 1u ); }
+  if ( manager ) { manager->deref( index >> 1u ); }
   manager = other.manager;
   index   = other.index;
   return *this;
@@ -524,6 +806,11 @@ unsigned bdd::var() const
   return manager->get_var( index );
 }
 
+unsigned bdd::level() const
+{
+  return manager->get_level( index );
+}
+
 bdd bdd::high() const
 {
   return bdd( manager, manager->get_high( index ) );
@@ -537,18 +824,21 @@ bdd bdd::low() const
 bdd bdd::operator&&( const bdd& other ) const
 {
   assert( manager == other.manager );
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_and( index, other.index ) );
 }
 
 bdd bdd::operator||( const bdd& other ) const
 {
   assert( manager == other.manager );
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_or( index, other.index ) );
 }
 
 bdd bdd::operator^( const bdd& other ) const
 {
   assert( manager == other.manager );
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_xor( index, other.index ) );
 }
 
@@ -559,44 +849,52 @@ bdd bdd::operator!() const
 
 bdd bdd::cof0( unsigned v ) const
 {
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_cof0( index, v ) );
 }
 
 bdd bdd::cof1( unsigned v ) const
 {
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_cof1( index, v ) );
 }
 
 bdd bdd::exists( const bdd& other ) const
 {
   assert( manager == other.manager );
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_exists( index, other.index ) );
 }
 
 bdd bdd::constrain( const bdd& other ) const
 {
   assert( manager == other.manager );
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_constrain( index, other.index ) );
 }
 
 bdd bdd::restrict( const bdd& other ) const
 {
   assert( manager == other.manager );
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_restrict( index, other.index ) );
 }
 
 bdd bdd::round_down( unsigned level ) const
 {
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_round_down( index, level ) );
 }
 
 bdd bdd::round_up( unsigned level ) const
 {
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_round_up( index, level ) );
 }
 
 bdd bdd::round( unsigned level ) const
 {
+  dd_manager::operation_scope scope( manager );
   return bdd( manager, manager->bdd_round( index, level ) );
 }
 
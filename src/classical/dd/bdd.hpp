@@ -45,6 +45,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace cirkit
 {
@@ -55,15 +56,20 @@ struct bdd
 {
   using const_param_ref = boost::call_traits < bdd >::const_reference;
 
+  /* index is an edge, i.e., the node index shifted by one and the lowest bit
+     indicates complementation; the constant 0 is the only terminal node, such
+     that 0 is the edge to bot and 1 the edge to top.  A bdd references its
+     node, such that it survives garbage collection */
   bdd() : manager( nullptr ), index( 0u ) {}
-  bdd( bdd_manager* manager, unsigned index )
-    : manager( manager ),
-      index( index ) {}
-  bdd( const bdd& other ) : manager( other.manager ), index( other.index ) {}
+  bdd( bdd_manager* manager, unsigned index );
+  bdd( const bdd& other );
+  bdd( bdd&& other );
+  ~bdd();
 
   bdd& operator=( const bdd& other );
 
   unsigned var() const;
+  unsigned level() const;
   bdd high() const;
   bdd low() const;
 
@@ -102,9 +108,21 @@ public:
 
   inline bdd bdd_bot()                { return bdd( this, 0u );     }
   inline bdd bdd_top()                { return bdd( this, 1u );     }
-  inline bdd bdd_var( unsigned i )    { assert( i < nvars ); return bdd( this, i + 2u ); }
-  inline bdd operator[]( unsigned i ) { assert( i < nvars ); return bdd( this, i + 2u ); }
+  inline bdd bdd_var( unsigned i )    { assert( i < nvars ); return bdd( this, ( i + 2u ) << 1u ); }
+  inline bdd operator[]( unsigned i ) { assert( i < nvars ); return bdd( this, ( i + 2u ) << 1u ); }
 
+  /* edge accessors, high and low respect the complement of f */
+  unsigned get_var( unsigned f ) const;
+  unsigned get_high( unsigned f ) const;
+  unsigned get_low( unsigned f ) const;
+
+  /* the variable order may change by reordering, terminals are at level nvars */
+  inline unsigned get_level( unsigned f ) const      { return var2level[nodes[f >> 1u].var]; }
+  inline unsigned var_level( unsigned var ) const    { return var2level[var]; }
+  inline unsigned level_var( unsigned level ) const  { return level2var[level]; }
+
+  /* if-then-else, all binary operations are implemented in terms of it */
+  unsigned bdd_ite( unsigned f, unsigned g, unsigned h );
   unsigned bdd_and( unsigned f, unsigned g );
   unsigned bdd_or( unsigned f, unsigned g );
   unsigned bdd_xor( unsigned f, unsigned g );
@@ -118,14 +136,59 @@ public:
   unsigned bdd_round_up( unsigned f, unsigned level );
   unsigned bdd_round( unsigned f, unsigned level );
 
+  /* returns an edge, the low edge of stored nodes is never complemented */
   unsigned unique_create( unsigned var, unsigned high, unsigned low );
 
+  /* Rudell's sifting based on in-place swaps of adjacent levels; must not
+     be called during an operation.  If enabled, reordering is triggered at
+     the beginning of a top level operation when the number of live nodes
+     exceeds the threshold, which is then set to twice the number of live
+     nodes after reordering.  Sifting a variable in one direction stops
+     when the number of nodes exceeds max_growth times the best size. */
+  void reorder();
+  void set_reorder_enabled( bool enabled );
+  void set_reorder_threshold( unsigned threshold );
+  void set_max_growth( double max_growth );
+
+  void dump_stats( std::ostream& stream ) const;
+
   static bdd_manager_ptr create( unsigned nvars, unsigned log_max_objs, bool verbose = false );
 
+protected:
+  void maintain();
+
 private:
+  void cofactors( unsigned f, unsigned v, unsigned& high, unsigned& low ) const;
+
+  /* reordering */
+  void sift( unsigned var );
+  void swap_levels( unsigned level );
+  unsigned reorder_create( unsigned var, unsigned high, unsigned low );
+  void reorder_deref( unsigned f );
+  inline unsigned live_nodes() const { return nnodes - dead.size(); }
+
   unsigned bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to );
   unsigned bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to, const std::map<unsigned, boost::multiprecision::uint256_t>& count_map );
 
+private:
+  std::vector<unsigned>              var2level;
+  std::vector<unsigned>              level2var;
+
+  bool                               reorder_enabled = false;
+  unsigned                           reorder_threshold = 4096u;
+  unsigned                           next_reorder = 4096u;
+  double                             max_growth = 1.2;
+
+  /* only valid during reordering */
+  std::vector<unsigned>              rcount;    /* external references and parents */
+  std::vector<std::vector<unsigned>> var_nodes; /* nodes labeled with a variable */
+  std::vector<unsigned>              dead;      /* freed after reordering */
+
+  /* statistics */
+  unsigned                           num_reorders = 0u;
+  unsigned long                      num_swaps = 0u;
+  double                             reorder_time = 0.0;
+
 public:
   friend std::ostream& operator<<( std::ostream& os, const bdd_manager& mgr );
 };
@@ -58,20 +58,14 @@ bdd bdd_copy( const bdd& f, bdd_manager& to,
   /* timing */
   properties_timer t( statistics );
 
-  /* map "from" addresses -> "to" addresses */
+  /* map "from" edges -> "to" edges */
   std::unordered_map<unsigned, unsigned> address_map = { {0u, 0u}, {1u, 1u} };
-  for ( unsigned v = 2u; v < 2u + f.manager->num_vars(); ++v )
-  {
-    address_map.insert( { v, v + shift } );
-  }
 
+  /* the variable orders of both managers may differ */
   auto func = [&]( const bdd& n ) {
-    if ( n.index >= 2u + f.manager->num_vars() )
-    {
-      address_map[n.index] = to.unique_create( n.var() + shift,
-                                               address_map[n.high().index],
-                                               address_map[n.low().index] );
-    }
+    address_map[n.index] = to.bdd_ite( to[n.var() + shift].index,
+                                       address_map[n.high().index],
+                                       address_map[n.low().index] );
   };
   dd_depth_first( f, detail::node_func_t<bdd>( func ) );
 
@@ -55,14 +55,14 @@ boost::multiprecision::uint256_t count_solutions( const bdd& n,
   std::map<unsigned, boost::multiprecision::uint256_t> c = { { 0u, 0 }, { 1u, 1 } };
   const boost::multiprecision::uint256_t one = 1;
   auto f = [&]( const bdd& n ) {
-    c[n.index] = ( one << ( n.low().var() - n.var() - 1u ) ) * c[n.low().index] +
-                 ( one << ( n.high().var() - n.var() - 1u ) ) * c[n.high().index];
+    c[n.index] = ( one << ( n.low().level() - n.level() - 1u ) ) * c[n.low().index] +
+                 ( one << ( n.high().level() - n.level() - 1u ) ) * c[n.high().index];
   };
   dd_depth_first( n, detail::node_func_t<bdd>( f ) );
 
   set( statistics, "count_map", c );
 
-  return ( one << n.var() ) * c[n.index];
+  return ( one << n.level() ) * c[n.index];
 }
 
 }
@@ -26,12 +26,16 @@
 
 #include "dd_manager.hpp"
 
-#include <cstring>
+#include <algorithm>
 #include <iostream>
+#include <stack>
 #include <vector>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/format.hpp>
 
+#include <core/utils/profiler.hpp>
+
 namespace cirkit
 {
 
@@ -69,6 +73,17 @@ int hash_cache::insert( unsigned arg0, unsigned arg1, unsigned arg2, int res )
   return res;
 }
 
+void hash_cache::clear()
+{
+  std::fill( data.begin(), data.end(), value_type() );
+}
+
+void hash_cache::resize( size_type log_size )
+{
+  data.assign( 1 << log_size, value_type() );
+  mask = ( 1 << log_size ) - 1u;
+}
+
 std::size_t hash_cache::cache_size() const
 {
   return data.size();
@@ -93,23 +108,99 @@ std::ostream& operator<<( std::ostream& os, const dd_node& z )
  * Private functions                                                          *
  ******************************************************************************/
 
+unsigned dd_manager::allocate_node()
+{
+  if ( free_list )
+  {
+    const auto z = free_list;
+    free_list = nexts[z];
+    return z;
+  }
+
+  /* growing is safe during recursive operations, since indexes are stable */
+  if ( nused == nodes.size() )
+  {
+    grow();
+  }
+
+  return nused++;
+}
+
+void dd_manager::grow()
+{
+  const auto new_size = nodes.size() << 1u;
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] dd resize from %d to %d nodes" ) % nodes.size() % new_size << std::endl;
+  }
+
+  nodes.resize( new_size, {-1u, -1u, -1u} );
+  refs.resize( new_size, 0u );
+  nexts.resize( new_size, 0u );
+  mask = new_size - 1u;
+  rehash();
+
+  /* the cache grows with the unique table */
+  auto log_size = 0u;
+  while ( ( 1u << log_size ) < new_size ) { ++log_size; }
+  cache.resize( log_size );
+
+  ++num_grows;
+  peak_memory = std::max( peak_memory, memory() );
+}
+
+void dd_manager::rehash()
+{
+  unique.assign( nodes.size(), 0u );
+
+  for ( auto z = 2u + nvars; z < nused; ++z )
+  {
+    const auto& n = nodes[z];
+    if ( n.var == -1u ) { continue; } /* dead */
+
+    const auto index = hash( n.var, n.high, n.low );
+    nexts[z] = unique[index];
+    unique[index] = z;
+  }
+}
+
+void dd_manager::maintain()
+{
+  if ( !gc_enabled || nnodes <= load_factor * nodes.size() ) { return; }
+
+  garbage_collect();
+
+  if ( nnodes > 0.5 * load_factor * nodes.size() )
+  {
+    grow();
+  }
+}
+
+std::size_t dd_manager::memory() const
+{
+  return nodes.size() * ( sizeof( dd_node ) + 3u * sizeof( unsigned ) ) + cache.cache_size() * sizeof( hash_cache::value_type );
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
 
 dd_manager::dd_manager( unsigned nvars, unsigned log_max_objs, bool verbose )
-  : nvars( nvars ), cache( log_max_objs ), verbose( verbose )
+  : nvars( nvars ), cache( log_max_objs ), verbose( verbose ), start_time( std::chrono::steady_clock::now() )
 {
   assert( log_max_objs > 0u );
 
-  const auto _nobjs = 1 << log_max_objs;
+  auto _nobjs = 1u << log_max_objs;
+
+  /* terminals and variables must fit */
+  while ( _nobjs < 2u * ( 2u + nvars ) ) { _nobjs <<= 1u; }
+
   nodes.resize( _nobjs, {-1u, -1u, -1u } );
   mask   = _nobjs - 1u;
-  unique = new unsigned[_nobjs];
-  nexts  = new unsigned[_nobjs];
-
-  memset( unique, 0, sizeof( unsigned ) * _nobjs );
-  memset( nexts,  0, sizeof( unsigned ) * _nobjs );
+  unique.resize( _nobjs, 0u );
+  nexts.resize( _nobjs, 0u );
+  refs.resize( _nobjs, 0u );
 
   /* terminals, value is determined by index */
   nodes[0] = {nvars, -1u, -1u};
@@ -121,13 +212,13 @@ dd_manager::dd_manager( unsigned nvars, unsigned log_max_objs, bool verbose )
     nodes[i + 2u] = {i, 1u, 0u};
   }
 
-  nnodes = 2u + nvars;
+  nnodes = nused = peak_nodes = 2u + nvars;
+  peak_memory = memory();
 }
 
 dd_manager::~dd_manager()
 {
-  delete[] unique;
-  delete[] nexts;
+  report_profile();
 }
 
 unsigned dd_manager::size() const
@@ -135,6 +226,11 @@ unsigned dd_manager::size() const
   return nnodes;
 }
 
+unsigned dd_manager::capacity() const
+{
+  return nodes.size();
+}
+
 unsigned dd_manager::get_var( unsigned z ) const
 {
   return nodes.at( z ).var;
@@ -150,13 +246,145 @@ unsigned dd_manager::get_low( unsigned z ) const
   return nodes.at( z ).low;
 }
 
+void dd_manager::set_gc_enabled( bool enabled )
+{
+  gc_enabled = enabled;
+}
+
+void dd_manager::set_load_factor( double load_factor )
+{
+  assert( load_factor > 0.0 && load_factor <= 1.0 );
+  this->load_factor = load_factor;
+}
+
+unsigned dd_manager::garbage_collect()
+{
+  if ( !gc_enabled ) { return 0u; }
+
+  return collect();
+}
+
+unsigned dd_manager::collect()
+{
+  const auto begin = std::chrono::steady_clock::now();
+
+  /* mark */
+  boost::dynamic_bitset<> marked( nused );
+  std::stack<unsigned> stack;
+
+  for ( auto z = 2u + nvars; z < nused; ++z )
+  {
+    if ( refs[z] && !marked[z] )
+    {
+      marked.set( z );
+      stack.push( z );
+    }
+
+    while ( !stack.empty() )
+    {
+      const auto& n = nodes[stack.top()];
+      stack.pop();
+
+      for ( auto c : {n.high, n.low} )
+      {
+        if ( complement_edges ) { c >>= 1u; }
+        if ( c >= 2u + nvars && !marked[c] )
+        {
+          marked.set( c );
+          stack.push( c );
+        }
+      }
+    }
+  }
+
+  /* sweep */
+  auto reclaimed = 0u;
+  for ( auto z = 2u + nvars; z < nused; ++z )
+  {
+    if ( marked[z] || nodes[z].var == -1u ) { continue; }
+
+    nodes[z] = {-1u, -1u, -1u};
+    nexts[z] = free_list;
+    free_list = z;
+    ++reclaimed;
+  }
+
+  nnodes -= reclaimed;
+  rehash();
+  cache.clear();
+
+  ++num_gcs;
+  num_reclaimed += reclaimed;
+  gc_time += std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count();
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] dd garbage collection reclaimed %d nodes, %d nodes alive" ) % reclaimed % nnodes << std::endl;
+  }
+
+  return reclaimed;
+}
+
 void dd_manager::dump_stats(std::ostream &stream) const
 {
+  const auto runtime = std::chrono::duration<double>( std::chrono::steady_clock::now() - start_time ).count();
+  const auto lookups = cache.hit() + cache.miss();
+
   stream << boost::format ("-- Variables:   %9d\n") % nvars;
   stream << boost::format ("-- Nodes:       %9d\n") % nnodes;
+  stream << boost::format ("-- Peak nodes:  %9d\n") % peak_nodes;
+  stream << boost::format ("-- Capacity:    %9d\n") % nodes.size();
+  stream << boost::format ("-- Memory:      %9d KB\n") % ( memory() >> 10u );
+  stream << boost::format ("-- Peak memory: %9d KB\n") % ( peak_memory >> 10u );
+  stream << boost::format ("-- Resizes:     %9d\n") % num_grows;
+  stream << boost::format ("-- GC runs:     %9d\n") % num_gcs;
+  stream << boost::format ("-- GC reclaimed:%9d\n") % num_reclaimed;
+  stream << boost::format ("-- GC time:     %9.2f secs\n") % gc_time;
+  stream << boost::format ("-- Created:     %9d\n") % num_created;
+  stream << boost::format ("-- Throughput:  %9.0f nodes/sec\n") % ( runtime > 0.0 ? num_created / runtime : 0.0 );
   stream << boost::format ("-- Cache-size:  %9d\n") % cache.cache_size();
   stream << boost::format ("-- Cache-miss:  %9d\n") % cache.miss();
   stream << boost::format ("-- Cache-hit:   %9d\n") % cache.hit();
+  stream << boost::format ("-- Cache-rate:  %9.2f %%\n") % ( lookups ? ( 100.0 * cache.hit() ) / lookups : 0.0 );
+}
+
+void dd_manager::report_profile()
+{
+  static auto& profile_hit       = get_profile_counter( "dd.cache_hit" );
+  static auto& profile_miss      = get_profile_counter( "dd.cache_miss" );
+  static auto& profile_created   = get_profile_counter( "dd.created" );
+  static auto& profile_gcs       = get_profile_counter( "dd.gc_runs" );
+  static auto& profile_reclaimed = get_profile_counter( "dd.gc_reclaimed" );
+
+  profile_hit.add( cache.hit() - profiled_hit );
+  profile_miss.add( cache.miss() - profiled_miss );
+  profile_created.add( num_created - profiled_created );
+  profile_gcs.add( num_gcs - profiled_gcs );
+  profile_reclaimed.add( num_reclaimed - profiled_reclaimed );
+
+  profiled_hit       = cache.hit();
+  profiled_miss      = cache.miss();
+  profiled_created   = num_created;
+  profiled_gcs       = num_gcs;
+  profiled_reclaimed = num_reclaimed;
+}
+
+dd_manager::operation_scope::operation_scope( dd_manager* manager )
+  : manager( manager )
+{
+  if ( manager->depth == 0u )
+  {
+    manager->maintain();
+  }
+  ++manager->depth;
+}
+
+dd_manager::operation_scope::~operation_scope()
+{
+  if ( --manager->depth == 0u )
+  {
+    manager->report_profile();
+  }
 }
 
 unsigned dd_manager::unique_lookup( unsigned var, unsigned high, unsigned low )
@@ -167,36 +395,55 @@ unsigned dd_manager::unique_lookup( unsigned var, unsigned high, unsigned low )
     return var + 2u;
   }
 
-  const auto hash  = ( 12582917 * (int)var + 4256249 * (int)high + 741457 * (int)low );
-  const auto index = hash & mask;
-  auto*      q     = unique + index;
-
-  while ( *q )
+  for ( auto q = unique[hash( var, high, low )]; q; q = nexts[q] )
   {
-    if ( nodes.at( *q ).var == var && nodes.at( *q ).high == high && nodes.at( *q ).low == low )
+    const auto& n = nodes[q];
+    if ( n.var == var && n.high == high && n.low == low )
     {
-      return *q;
+      return q;
     }
-    q = nexts + *q;
   }
 
-  if ( nnodes == nodes.size() )
-  {
-    std::cerr << "[e] dd capacity exceeded" << std::endl;
-    assert( false );
-  }
+  /* allocation may resize the unique table */
+  const auto z = allocate_node();
+  nodes[z] = {var, high, low};
+  refs[z] = 0u;
+  unique_insert( z );
 
-  *q = nnodes++;
-  nodes[*q].var  = var;
-  nodes[*q].high = high;
-  nodes[*q].low  = low;
+  ++nnodes;
+  ++num_created;
+  peak_nodes = std::max( peak_nodes, nnodes );
 
-  if ( verbose )
+  return z;
+}
+
+void dd_manager::unique_insert( unsigned z )
+{
+  const auto& n = nodes[z];
+  const auto index = hash( n.var, n.high, n.low );
+  nexts[z] = unique[index];
+  unique[index] = z;
+}
+
+void dd_manager::unique_remove( unsigned z )
+{
+  const auto& n = nodes[z];
+  auto* q = &unique[hash( n.var, n.high, n.low )];
+  while ( *q != z )
   {
-    // std::cout << boost::format( "[i] created entry (%d, %d, %d) at index %d" ) % var % high % low % *q << std::endl;
+    assert( *q );
+    q = &nexts[*q];
   }
+  *q = nexts[z];
+}
 
-  return *q;
+void dd_manager::free_node( unsigned z )
+{
+  assert( z >= 2u + nvars );
+  nodes[z] = {-1u, -1u, -1u};
+  nexts[z] = free_list;
+  free_list = z;
+  --nnodes;
 }
 
 }
@@ -37,8 +37,11 @@
 #ifndef DD_MANAGER_HPP
 #define DD_MANAGER_HPP
 
+#include <cassert>
+#include <chrono>
 #include <memory>
 #include <ostream>
+#include <tuple>
 #include <vector>
 
 namespace cirkit
@@ -56,6 +59,11 @@ public:
   int lookup( unsigned arg0, unsigned arg1, unsigned arg2 );
   int insert( unsigned arg0, unsigned arg1, unsigned arg2, int res );
 
+  /* invalidates all entries */
+  void clear();
+  /* resizes and invalidates all entries */
+  void resize( size_type log_size );
+
   std::size_t cache_size() const;
 
   std::size_t hit () const;
@@ -63,7 +71,7 @@ public:
 private:
   inline container_type::reference entry( unsigned arg0, unsigned arg1, unsigned arg2 )
   {
-    return data[( 12582917 * (int)arg0 + 4256249 * (int)arg1 + 741457 * (int)arg2 ) & mask];
+    return data[( 12582917u * arg0 + 4256249u * arg1 + 741457u * arg2 ) & mask];
   }
 
 private:
@@ -88,6 +96,13 @@ struct dd_node
 
 std::ostream& operator<<( std::ostream& os, const dd_node& z );
 
+/* The node array and the unique table start with 2^log_max_objs entries and
+ * are doubled whenever they run full.  Nodes that are not reachable from an
+ * externally referenced node (see ref and deref) are reclaimed by a mark and
+ * sweep garbage collection, which is only invoked at the beginning of a top
+ * level operation (see operation_scope), since the recursive operations keep
+ * intermediate results as plain indexes.  Garbage collection flushes the
+ * computed table. */
 class dd_manager
 {
 public:
@@ -96,26 +111,110 @@ public:
 
   inline unsigned num_vars() const { return nvars; }
 
+  /* number of live nodes, including terminals and variables */
   unsigned size() const;
+  /* number of node slots */
+  unsigned capacity() const;
 
   unsigned get_var( unsigned z ) const;
   unsigned get_high( unsigned z ) const;
   unsigned get_low( unsigned z ) const;
 
-  void dump_stats ( std::ostream& stream ) const;
+  /* external references, nodes with references are roots for garbage collection */
+  inline void ref( unsigned z )   { if ( z >= 2u + nvars ) { ++refs[z]; } }
+  inline void deref( unsigned z ) { if ( z >= 2u + nvars ) { assert( refs[z] ); --refs[z]; } }
+
+  /* garbage collection is triggered when the number of live nodes exceeds
+     load_factor * capacity at the beginning of a top level operation; if
+     after collection still more than half of the threshold is used, the
+     tables are doubled; if disabled, the tables only grow */
+  void set_gc_enabled( bool enabled );
+  void set_load_factor( double load_factor );
+
+  /* returns number of reclaimed nodes */
+  unsigned garbage_collect();
+
+  virtual void dump_stats( std::ostream& stream ) const;
+
+  /* RAII guard for top level operations, collects garbage if necessary when
+     entering the outermost scope */
+  class operation_scope
+  {
+  public:
+    explicit operation_scope( dd_manager* manager );
+    ~operation_scope();
+
+  private:
+    dd_manager* manager;
+  };
 
 protected:
   unsigned unique_lookup( unsigned var, unsigned high, unsigned low );
 
+  /* in-place modification of nodes, e.g., for variable reordering; a node
+     must be removed from the unique table before its content is changed */
+  void unique_insert( unsigned z );
+  void unique_remove( unsigned z );
+  void free_node( unsigned z );
+
+  /* collects garbage, even if garbage collection is disabled */
+  unsigned collect();
+
+  /* called when entering a top level operation */
+  virtual void maintain();
+
+  inline bool in_operation() const { return depth > 0u; }
+
+private:
+  inline unsigned hash( unsigned var, unsigned high, unsigned low ) const
+  {
+    return ( 12582917u * var + 4256249u * high + 741457u * low ) & mask;
+  }
+
+  unsigned allocate_node();
+  void grow();
+  void rehash();
+  std::size_t memory() const;
+
+  /* adds statistics since the last call to the global profile counters, called
+     after each top level operation and on destruction */
+  void report_profile();
+
 protected:
-  unsigned             nvars;
-  unsigned             nnodes = 0u;
-  unsigned             mask = 0u;
-  hash_cache           cache;
-  std::vector<dd_node> nodes;
-  bool                 verbose;
-  unsigned *           unique;
-  unsigned *           nexts;
+  unsigned              nvars;
+  unsigned              nnodes = 0u;   /* live nodes */
+  unsigned              nused = 0u;    /* slots that have been used at least once */
+  unsigned              mask = 0u;
+  hash_cache            cache;
+  std::vector<dd_node>  nodes;
+  bool                  verbose;
+  std::vector<unsigned> unique;
+  std::vector<unsigned> nexts;         /* collision chains for live nodes, free list for dead nodes */
+  std::vector<unsigned> refs;
+  bool                  complement_edges = false; /* children are edges (node << 1 | complement) */
+
+private:
+  unsigned              free_list = 0u;
+  unsigned              depth = 0u;
+  bool                  gc_enabled = true;
+  double                load_factor = 0.75;
+
+  /* statistics */
+  unsigned              peak_nodes = 0u;
+  std::size_t           peak_memory = 0u;
+  unsigned long         num_created = 0u;
+  unsigned long         num_reclaimed = 0u;
+  unsigned              num_gcs = 0u;
+  unsigned              num_grows = 0u;
+  double                gc_time = 0.0;
+  std::chrono::time_point<std::chrono::steady_clock> start_time;
+
+  /* statistics already reported to the profiler */
+  std::size_t           profiled_hit = 0u;
+  std::size_t           profiled_miss = 0u;
+  unsigned long         profiled_created = 0u;
+  unsigned              profiled_gcs = 0u;
+  unsigned long         profiled_reclaimed = 0u;
 };
 
 }
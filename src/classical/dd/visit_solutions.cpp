@@ -54,7 +54,7 @@ struct less<std::vector<boost::tribool>>
       {
         if ( boost::indeterminate( t1 ) ) { return true; }
         if ( boost::indeterminate( t2 ) ) { return false; }
-        return !t1 && t2;
+        return static_cast<bool>( !t1 && t2 );
       }
 
       ++i;
@@ -80,16 +80,18 @@ using boost::tribool;
  * Private functions                                                          *
  ******************************************************************************/
 
+/* level is the current level in the variable order, x is indexed by variables */
 void visit_solutions_rec( unsigned level, const bdd& n, boost::dynamic_bitset<>& x, const visit_solutions_func& f )
 {
   if ( n.index == 0u )
   {
     return;
   }
-  if ( n.var() > level )
+  if ( n.level() > level )
   {
-    x.reset( level ); visit_solutions_rec( level + 1u, n, x, f );
-    x.set( level );   visit_solutions_rec( level + 1u, n, x, f );
+    const auto var = n.manager->level_var( level );
+    x.reset( var ); visit_solutions_rec( level + 1u, n, x, f );
+    x.set( var );   visit_solutions_rec( level + 1u, n, x, f );
   }
   else if ( n.index == 1u )
   {
@@ -97,13 +99,14 @@ void visit_solutions_rec( unsigned level, const bdd& n, boost::dynamic_bitset<>&
   }
   else
   {
+    const auto var = n.var();
     if ( n.low().index != 0u )
     {
-      x.reset( level ); visit_solutions_rec( level + 1u, n.low(), x, f );
+      x.reset( var ); visit_solutions_rec( level + 1u, n.low(), x, f );
     }
     if ( n.high().index != 0u )
     {
-      x.set( level );   visit_solutions_rec( level + 1u, n.high(), x, f );
+      x.set( var );   visit_solutions_rec( level + 1u, n.high(), x, f );
     }
   }
 }
@@ -119,7 +122,11 @@ void visit_paths_rec( const bdd& n, std::vector<tribool>& x, const visit_paths_f
     break;
   default:
     x[n.var()] = false; visit_paths_rec( n.low(), x, f );
-    std::fill( x.begin() + n.var(), x.end(), dontcare );
+    /* variables below n in the order may have been assigned on the low path */
+    for ( auto level = n.level(); level < x.size(); ++level )
+    {
+      x[n.manager->level_var( level )] = dontcare;
+    }
     x[n.var()] = true;  visit_paths_rec( n.high(), x, f );
   }
 }
@@ -0,0 +1,419 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bit_parallel_simulation.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include <boost/graph/topological_sort.hpp>
+
+#include <classical/utils/aig_utils.hpp>
+#include <classical/mig/mig_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace detail
+{
+
+inline unsigned bit_parallel_literal( const std::vector<unsigned>& index, unsigned node, bool complemented )
+{
+  assert( index[node] != -1u );
+  return ( index[node] << 1u ) | static_cast<unsigned>( complemented );
+}
+
+}
+
+void bit_parallel_simulator::allocate( unsigned num_words )
+{
+  const auto num_nodes = 1u + _num_inputs + gates.size();
+
+  /* about 64 MB of simulation values */
+  if ( num_words == 0u )
+  {
+    num_words = std::max( 1u, std::min( 64u, ( 1u << 23u ) / static_cast<unsigned>( num_nodes ) ) );
+  }
+
+  _num_words = num_words;
+  values.assign( num_nodes * num_words, 0u );
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bit_parallel_simulator::bit_parallel_simulator( const aig_graph& aig, unsigned num_words )
+{
+  const auto& info = aig_info( aig );
+  _num_inputs = info.inputs.size();
+
+  std::vector<unsigned> index( boost::num_vertices( aig ), -1u );
+  index[info.constant] = 0u;
+  for ( auto i = 0u; i < _num_inputs; ++i )
+  {
+    index[info.inputs[i]] = 1u + i;
+  }
+
+  /* children appear before their parents in topsort */
+  std::vector<aig_node> topsort( boost::num_vertices( aig ) );
+  boost::topological_sort( aig, topsort.begin() );
+
+  auto next = 1u + _num_inputs;
+  for ( const auto& n : topsort )
+  {
+    if ( boost::out_degree( n, aig ) == 0u ) { continue; }
+
+    auto it = boost::out_edges( n, aig ).first;
+    const auto c1 = aig_to_function( aig, *it++ );
+    const auto c2 = aig_to_function( aig, *it );
+
+    gates.push_back( {gate_type::and2, {detail::bit_parallel_literal( index, c1.node, c1.complemented ),
+                                        detail::bit_parallel_literal( index, c2.node, c2.complemented ), 0u}} );
+    index[n] = next++;
+  }
+
+  for ( const auto& o : info.outputs )
+  {
+    outputs.push_back( detail::bit_parallel_literal( index, o.first.node, o.first.complemented ) );
+  }
+
+  allocate( num_words );
+}
+
+bit_parallel_simulator::bit_parallel_simulator( const compact_aig& aig, unsigned num_words )
+{
+  _num_inputs = aig.num_inputs();
+
+  /* node order is topological already */
+  std::vector<unsigned> index( aig.size(), -1u );
+  index[0u] = 0u;
+  for ( auto i = 0u; i < _num_inputs; ++i )
+  {
+    index[aig.input( i )] = 1u + i;
+  }
+
+  gates.reserve( aig.num_gates() );
+  auto next = 1u + _num_inputs;
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( !aig.is_and( n ) ) { continue; }
+
+    const auto f0 = aig.fanin0( n ), f1 = aig.fanin1( n );
+    gates.push_back( {gate_type::and2, {detail::bit_parallel_literal( index, compact_aig::get_node( f0 ), compact_aig::is_complemented( f0 ) ),
+                                        detail::bit_parallel_literal( index, compact_aig::get_node( f1 ), compact_aig::is_complemented( f1 ) ), 0u}} );
+    index[n] = next++;
+  }
+
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    const auto f = aig.output( o );
+    outputs.push_back( detail::bit_parallel_literal( index, compact_aig::get_node( f ), compact_aig::is_complemented( f ) ) );
+  }
+
+  allocate( num_words );
+}
+
+bit_parallel_simulator::bit_parallel_simulator( const mig_graph& mig, unsigned num_words )
+{
+  const auto& info = mig_info( mig );
+  _num_inputs = info.inputs.size();
+
+  std::vector<unsigned> index( boost::num_vertices( mig ), -1u );
+  index[info.constant] = 0u;
+  for ( auto i = 0u; i < _num_inputs; ++i )
+  {
+    index[info.inputs[i]] = 1u + i;
+  }
+
+  std::vector<mig_node> topsort( boost::num_vertices( mig ) );
+  boost::topological_sort( mig, topsort.begin() );
+
+  auto next = 1u + _num_inputs;
+  for ( const auto& n : topsort )
+  {
+    if ( boost::out_degree( n, mig ) == 0u ) { continue; }
+
+    gate g{gate_type::maj3, {0u, 0u, 0u}};
+    auto i = 0u;
+    for ( const auto& e : boost::make_iterator_range( boost::out_edges( n, mig ) ) )
+    {
+      const auto f = mig_to_function( mig, e );
+      g.fanins[i++] = detail::bit_parallel_literal( index, f.node, f.complemented );
+    }
+    assert( i == 3u );
+
+    gates.push_back( g );
+    index[n] = next++;
+  }
+
+  for ( const auto& o : info.outputs )
+  {
+    outputs.push_back( detail::bit_parallel_literal( index, o.first.node, o.first.complemented ) );
+  }
+
+  allocate( num_words );
+}
+
+bit_parallel_simulator::bit_parallel_simulator( const xmg_graph& xmg, unsigned num_words )
+{
+  _num_inputs = xmg.inputs().size();
+
+  std::vector<unsigned> index( xmg.size(), -1u );
+  index[xmg.get_constant( false ).node] = 0u;
+  for ( auto i = 0u; i < _num_inputs; ++i )
+  {
+    index[xmg.inputs()[i].first] = 1u + i;
+  }
+
+  auto next = 1u + _num_inputs;
+  for ( const auto& n : xmg.topological_nodes() )
+  {
+    if ( xmg.is_input( n ) ) { continue; }
+
+    const auto children = xmg.children( n );
+    gate g{xmg.is_xor( n ) ? gate_type::xor2 : gate_type::maj3, {0u, 0u, 0u}};
+    for ( auto i = 0u; i < children.size(); ++i )
+    {
+      g.fanins[i] = detail::bit_parallel_literal( index, children[i].node, children[i].complemented );
+    }
+
+    gates.push_back( g );
+    index[n] = next++;
+  }
+
+  for ( const auto& o : xmg.outputs() )
+  {
+    outputs.push_back( detail::bit_parallel_literal( index, o.first.node, o.first.complemented ) );
+  }
+
+  allocate( num_words );
+}
+
+void bit_parallel_simulator::simulate()
+{
+  const auto nw = _num_words;
+  auto* r = &values[( 1u + _num_inputs ) * nw];
+
+  for ( const auto& g : gates )
+  {
+    const auto* a = &values[( g.fanins[0] >> 1u ) * nw];
+    const auto* b = &values[( g.fanins[1] >> 1u ) * nw];
+    const auto ma = -static_cast<std::uint64_t>( g.fanins[0] & 1u );
+    const auto mb = -static_cast<std::uint64_t>( g.fanins[1] & 1u );
+
+    switch ( g.type )
+    {
+    case gate_type::and2:
+      for ( auto w = 0u; w < nw; ++w )
+      {
+        r[w] = ( a[w] ^ ma ) & ( b[w] ^ mb );
+      }
+      break;
+
+    case gate_type::xor2:
+      for ( auto w = 0u; w < nw; ++w )
+      {
+        r[w] = a[w] ^ b[w] ^ ma ^ mb;
+      }
+      break;
+
+    case gate_type::maj3:
+      {
+        const auto* c = &values[( g.fanins[2] >> 1u ) * nw];
+        const auto mc = -static_cast<std::uint64_t>( g.fanins[2] & 1u );
+        for ( auto w = 0u; w < nw; ++w )
+        {
+          const auto x = a[w] ^ ma, y = b[w] ^ mb, z = c[w] ^ mc;
+          r[w] = ( x & y ) | ( x & z ) | ( y & z );
+        }
+      }
+      break;
+    }
+
+    r += nw;
+  }
+}
+
+unsigned bit_parallel_simulator::count_ones( unsigned o, unsigned num_patterns ) const
+{
+  assert( num_patterns <= block_size() );
+
+  auto count = 0u;
+  const auto full = num_patterns >> 6u;
+  for ( auto w = 0u; w < full; ++w )
+  {
+    count += __builtin_popcountll( output_word( o, w ) );
+  }
+  if ( num_patterns & 63u )
+  {
+    count += __builtin_popcountll( output_word( o, full ) & ( ( UINT64_C( 1 ) << ( num_patterns & 63u ) ) - 1u ) );
+  }
+  return count;
+}
+
+void bit_parallel_simulator::simulate_random( unsigned long num_patterns, unsigned seed, const block_func& on_block )
+{
+  std::mt19937_64 gen( seed );
+
+  for ( auto offset = 0ul; offset < num_patterns; offset += block_size() )
+  {
+    for ( auto i = 0u; i < _num_inputs; ++i )
+    {
+      std::generate( input( i ), input( i ) + _num_words, std::ref( gen ) );
+    }
+
+    simulate();
+    on_block( offset, static_cast<unsigned>( std::min<unsigned long>( block_size(), num_patterns - offset ) ) );
+  }
+}
+
+bool bit_parallel_simulator::simulate_stream( std::istream& is, const block_func& on_block, unsigned long& num_patterns )
+{
+  auto offset = 0ul;
+  auto pos    = 0u;
+  auto lineno = 0u;
+  std::string line;
+
+  const auto flush = [&]() {
+    simulate();
+    on_block( offset, pos );
+    offset += pos;
+    pos = 0u;
+  };
+
+  std::fill( input( 0u ), input( 0u ) + _num_inputs * _num_words, 0u );
+
+  while ( std::getline( is, line ) )
+  {
+    ++lineno;
+    if ( line.empty() || line[0] == '#' ) { continue; }
+
+    if ( line.size() < _num_inputs )
+    {
+      std::cerr << "[e] pattern in line " << lineno << " has too few values" << std::endl;
+      num_patterns = offset;
+      return false;
+    }
+
+    const auto w = pos >> 6u;
+    const auto bit = UINT64_C( 1 ) << ( pos & 63u );
+    for ( auto i = 0u; i < _num_inputs; ++i )
+    {
+      if ( line[i] == '1' )
+      {
+        input( i )[w] |= bit;
+      }
+      else if ( line[i] != '0' )
+      {
+        std::cerr << "[e] pattern in line " << lineno << " has invalid value '" << line[i] << "'" << std::endl;
+        num_patterns = offset;
+        return false;
+      }
+    }
+
+    if ( ++pos == block_size() )
+    {
+      flush();
+      std::fill( input( 0u ), input( 0u ) + _num_inputs * _num_words, 0u );
+    }
+  }
+
+  if ( pos )
+  {
+    flush();
+  }
+
+  num_patterns = offset;
+  return true;
+}
+
+std::vector<boost::dynamic_bitset<>> bit_parallel_simulate( const aig_graph& aig, const std::vector<boost::dynamic_bitset<>>& input_vectors )
+{
+  using block_t = boost::dynamic_bitset<>::block_type;
+  static_assert( sizeof( block_t ) == sizeof( std::uint64_t ), "expect 64-bit blocks" );
+
+  const auto num_patterns = input_vectors.empty() ? 0u : static_cast<unsigned>( input_vectors.front().size() );
+  const auto total_words  = ( num_patterns + 63u ) >> 6u;
+
+  bit_parallel_simulator sim( aig, std::max( 1u, std::min( total_words, 64u ) ) );
+  assert( input_vectors.size() == sim.num_inputs() );
+
+  /* unpack input vectors into words */
+  std::vector<std::vector<block_t>> inputs( sim.num_inputs() );
+  for ( auto i = 0u; i < sim.num_inputs(); ++i )
+  {
+    assert( input_vectors[i].size() == num_patterns );
+    inputs[i].reserve( total_words );
+    boost::to_block_range( input_vectors[i], std::back_inserter( inputs[i] ) );
+  }
+
+  std::vector<std::vector<block_t>> results( sim.num_outputs(), std::vector<block_t>( total_words ) );
+
+  for ( auto first = 0u; first < total_words; first += sim.num_words() )
+  {
+    const auto words = std::min( sim.num_words(), total_words - first );
+    for ( auto i = 0u; i < sim.num_inputs(); ++i )
+    {
+      std::copy( inputs[i].begin() + first, inputs[i].begin() + first + words, sim.input( i ) );
+    }
+
+    sim.simulate();
+
+    for ( auto o = 0u; o < sim.num_outputs(); ++o )
+    {
+      for ( auto w = 0u; w < words; ++w )
+      {
+        results[o][first + w] = sim.output_word( o, w );
+      }
+    }
+  }
+
+  std::vector<boost::dynamic_bitset<>> output_vectors( sim.num_outputs() );
+  for ( auto o = 0u; o < sim.num_outputs(); ++o )
+  {
+    output_vectors[o].append( results[o].begin(), results[o].end() );
+    output_vectors[o].resize( num_patterns );
+  }
+  return output_vectors;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,142 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file bit_parallel_simulation.hpp
+ *
+ * @brief Bit-parallel simulation of AIGs, MIGs, and XMGs
+ *
+ * The network is flattened into an array of gates in topological order, in
+ * which fanins are literals (node index and complement flag).  The simulation
+ * values of a node are stored as a contiguous block of 64-bit words, such
+ * that each gate is evaluated by a tight loop over all words of a block,
+ * which the compiler vectorizes for the available instruction set.  Node 0 is
+ * the constant, nodes 1 to num_inputs are the primary inputs.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef BIT_PARALLEL_SIMULATION_HPP
+#define BIT_PARALLEL_SIMULATION_HPP
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/compact_aig.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/xmg/xmg.hpp>
+
+namespace cirkit
+{
+
+class bit_parallel_simulator
+{
+public:
+  enum class gate_type : unsigned char { and2, xor2, maj3 };
+
+  struct gate
+  {
+    gate_type type;
+    unsigned  fanins[3]; /* literals */
+  };
+
+  /* called after a block has been simulated, offset is the index of the
+     first pattern in the block and num_patterns the number of valid patterns */
+  using block_func = std::function<void( unsigned long offset, unsigned num_patterns )>;
+
+  /* num_words = 0 chooses the block size based on the network size */
+  explicit bit_parallel_simulator( const aig_graph& aig, unsigned num_words = 0u );
+  explicit bit_parallel_simulator( const compact_aig& aig, unsigned num_words = 0u );
+  explicit bit_parallel_simulator( const mig_graph& mig, unsigned num_words = 0u );
+  explicit bit_parallel_simulator( const xmg_graph& xmg, unsigned num_words = 0u );
+
+  inline unsigned num_inputs() const  { return _num_inputs; }
+  inline unsigned num_outputs() const { return outputs.size(); }
+  inline unsigned num_gates() const   { return gates.size(); }
+  inline unsigned num_words() const   { return _num_words; }
+
+  /* number of patterns per block */
+  inline unsigned block_size() const  { return _num_words << 6u; }
+
+  /* words of input i of the current block */
+  inline std::uint64_t* input( unsigned i ) { return &values[( 1u + i ) * _num_words]; }
+
+  /* simulates the current block */
+  void simulate();
+
+  inline std::uint64_t output_word( unsigned o, unsigned w ) const
+  {
+    return values[( outputs[o] >> 1u ) * _num_words + w] ^ ( -static_cast<std::uint64_t>( outputs[o] & 1u ) );
+  }
+
+  inline bool output_bit( unsigned o, unsigned p ) const
+  {
+    return ( output_word( o, p >> 6u ) >> ( p & 63u ) ) & 1u;
+  }
+
+  /* number of ones of output o among the first num_patterns patterns of the block */
+  unsigned count_ones( unsigned o, unsigned num_patterns ) const;
+
+  /* streams num_patterns random patterns */
+  void simulate_random( unsigned long num_patterns, unsigned seed, const block_func& on_block );
+
+  /* streams patterns from a stream, one pattern per line, where the i-th
+     character is the value of input i; empty lines and lines starting with
+     # are skipped; returns false for a line with too few values or values
+     other than 0 and 1, num_patterns is the number of simulated patterns */
+  bool simulate_stream( std::istream& is, const block_func& on_block, unsigned long& num_patterns );
+
+private:
+  void allocate( unsigned num_words );
+
+private:
+  unsigned                   _num_inputs = 0u;
+  unsigned                   _num_words = 0u;
+  std::vector<gate>          gates;
+  std::vector<unsigned>      outputs; /* literals */
+  std::vector<std::uint64_t> values;  /* num_words words per node */
+};
+
+/* simulates the AIG for input vectors of equal size and returns the values
+   of all outputs, i.e., the i-th bit of the j-th result is the value of output
+   j for the assignment of the i-th bit of all input vectors */
+std::vector<boost::dynamic_bitset<>> bit_parallel_simulate( const aig_graph& aig, const std::vector<boost::dynamic_bitset<>>& input_vectors );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -26,10 +26,12 @@
 
 #include "compute_levels.hpp"
 
+#include <algorithm>
 #include <vector>
 
 #include <boost/graph/topological_sort.hpp>
 #include <boost/range/algorithm.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <core/utils/graph_utils.hpp>
 #include <core/utils/timer.hpp>
@@ -149,6 +151,44 @@ std::vector<std::vector<aig_node>> levelize_nodes( const aig_graph& aig,
   return result;
 }
 
+void levelize_nodes_flat( const aig_graph& aig, std::vector<aig_node>& order, std::vector<unsigned>& offsets )
+{
+  const auto n = boost::num_vertices( aig );
+
+  std::vector<aig_node> topsort( n );
+  boost::topological_sort( aig, topsort.begin() );
+
+  /* children appear before their parents in topsort */
+  std::vector<unsigned> levels( n, 0u );
+  auto max_level = 0u;
+  for ( const auto& v : topsort )
+  {
+    for ( const auto& w : boost::make_iterator_range( boost::adjacent_vertices( v, aig ) ) )
+    {
+      levels[v] = std::max( levels[v], levels[w] + 1u );
+    }
+    max_level = std::max( max_level, levels[v] );
+  }
+
+  /* counting sort */
+  offsets.assign( max_level + 2u, 0u );
+  for ( const auto& l : levels )
+  {
+    ++offsets[l + 1u];
+  }
+  for ( auto l = 0u; l <= max_level; ++l )
+  {
+    offsets[l + 1u] += offsets[l];
+  }
+
+  order.resize( n );
+  auto next = offsets;
+  for ( const auto& v : topsort )
+  {
+    order[next[levels[v]]++] = v;
+  }
+}
+
 }
 
 // Local Variables:
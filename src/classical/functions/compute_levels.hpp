@@ -61,6 +61,16 @@ std::vector<std::vector<aig_node>> levelize_nodes( const aig_graph& aig,
                                                    const properties::ptr& settings = properties::ptr(),
                                                    const properties::ptr& statistics = properties::ptr() );
 
+/**
+ * @brief Sorts all nodes by level into a flat vector
+ *
+ * The nodes of level l are order[offsets[l]], ..., order[offsets[l + 1] - 1].
+ * The constant and all inputs are on level 0.  In contrast to levelize_nodes
+ * this function does not use simulation and runs in linear time, which makes
+ * it suitable for scheduling on large AIGs.
+ */
+void levelize_nodes_flat( const aig_graph& aig, std::vector<aig_node>& order, std::vector<unsigned>& offsets );
+
 }
 
 #endif
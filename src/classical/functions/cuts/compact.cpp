@@ -0,0 +1,229 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "compact.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+#include <core/utils/timer.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+void compact_aig_cuts::load( compact_aig::node n, unsigned j, priority_cut& cut ) const
+{
+  const auto* s = slot( n, j );
+  cut.size = s[0];
+  std::copy( s + 1u, s + 1u + s[0], cut.leaves );
+  cut.signature = signatures[n * _slots + j];
+}
+
+unsigned compact_aig_cuts::cone_size( compact_aig::node n, const priority_cut& cut )
+{
+  ++stamp;
+  for ( auto leaf : cut )
+  {
+    visited[leaf] = stamp;
+  }
+
+  auto size = 0u;
+  std::vector<compact_aig::node> stack{n};
+  while ( !stack.empty() )
+  {
+    const auto m = stack.back();
+    stack.pop_back();
+
+    if ( visited[m] == stamp || !_aig.is_and( m ) ) { continue; }
+    visited[m] = stamp;
+    ++size;
+
+    stack.push_back( compact_aig::get_node( _aig.fanin0( m ) ) );
+    stack.push_back( compact_aig::get_node( _aig.fanin1( m ) ) );
+  }
+  return size;
+}
+
+void compact_aig_cuts::enumerate()
+{
+  reference_timer t( &_enumeration_time );
+
+  priority_cut_set local_cuts( _priority, _cost );
+  priority_cut cut_a, cut_b, new_cut;
+
+  const auto set_trivial = [this]( compact_aig::node n, unsigned j ) {
+    auto* s = slot( n, j );
+    s[0] = 1u;
+    s[1] = n;
+    signatures[n * _slots + j] = priority_cut::leaf_signature( n );
+    counts[n] = j + 1u;
+  };
+
+  /* constant has the empty cut */
+  counts[0] = 1u;
+  slot( 0u, 0u )[0] = 0u;
+  signatures[0u] = 0u;
+
+  for ( auto n = 1u; n < _aig.size(); ++n )
+  {
+    if ( !_aig.is_and( n ) )
+    {
+      set_trivial( n, 0u );
+      continue;
+    }
+
+    const auto a = compact_aig::get_node( _aig.fanin0( n ) );
+    const auto b = compact_aig::get_node( _aig.fanin1( n ) );
+
+    local_cuts.clear();
+    for ( auto ja = 0u; ja < counts[a]; ++ja )
+    {
+      load( a, ja, cut_a );
+
+      for ( auto jb = 0u; jb < counts[b]; ++jb )
+      {
+        load( b, jb, cut_b );
+        if ( !new_cut.merge( cut_a, cut_b, _k ) ) { continue; }
+
+        new_cut.depth = 0u;
+        new_cut.area_flow = 1.0f;
+        for ( auto leaf : new_cut )
+        {
+          new_cut.depth = std::max( new_cut.depth, depths[leaf] );
+          new_cut.area_flow += flows[leaf] / std::max( 1u, fanouts[leaf] );
+        }
+        ++new_cut.depth;
+
+        if ( _cost == cut_cost_t::cone_size )
+        {
+          new_cut.cone_size = cone_size( n, new_cut );
+        }
+
+        local_cuts.insert( new_cut );
+      }
+    }
+
+    auto j = 0u;
+    for ( const auto& cut : local_cuts )
+    {
+      auto* s = slot( n, j );
+      s[0] = cut.size;
+      std::copy( cut.begin(), cut.end(), s + 1u );
+      signatures[n * _slots + j] = cut.signature;
+      ++j;
+    }
+    set_trivial( n, j );
+
+    if ( !local_cuts.empty() )
+    {
+      depths[n] = local_cuts.best().depth;
+      flows[n] = local_cuts.best().area_flow;
+    }
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+compact_aig_cuts::compact_aig_cuts( const compact_aig& aig, unsigned k, unsigned priority, cut_cost_t cost )
+  : _aig( aig ),
+    _k( k ),
+    _priority( priority ),
+    _slots( priority + 1u ),
+    _cost( cost )
+{
+  if ( k > priority_cut::max_leaves )
+  {
+    throw std::invalid_argument( "cut size must not exceed " + std::to_string( priority_cut::max_leaves ) );
+  }
+  assert( priority < 255u );
+
+  data.resize( static_cast<std::size_t>( aig.size() ) * _slots * ( k + 1u ), 0u );
+  signatures.resize( static_cast<std::size_t>( aig.size() ) * _slots, 0u );
+  counts.resize( aig.size(), 0u );
+
+  fanouts.resize( aig.size(), 0u );
+  depths.resize( aig.size(), 0u );
+  flows.resize( aig.size(), 0.0f );
+  if ( cost == cut_cost_t::cone_size )
+  {
+    visited.resize( aig.size(), 0u );
+  }
+
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( aig.is_and( n ) )
+    {
+      ++fanouts[compact_aig::get_node( aig.fanin0( n ) )];
+      ++fanouts[compact_aig::get_node( aig.fanin1( n ) )];
+    }
+  }
+
+  enumerate();
+}
+
+unsigned compact_aig_cuts::total_cut_count() const
+{
+  auto total = 0u;
+  for ( auto c : counts ) { total += c; }
+  return total;
+}
+
+double compact_aig_cuts::enumeration_time() const
+{
+  return _enumeration_time;
+}
+
+std::size_t compact_aig_cuts::memory() const
+{
+  return data.size() * sizeof( std::uint32_t ) + signatures.size() * sizeof( std::uint64_t ) + counts.size();
+}
+
+compact_aig_cuts::leaf_range compact_aig_cuts::cut( compact_aig::node n, unsigned j ) const
+{
+  assert( j < counts[n] );
+  const auto* s = slot( n, j );
+  return leaf_range( s + 1u, s + 1u + s[0] );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
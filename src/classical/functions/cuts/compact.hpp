@@ -0,0 +1,118 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file compact.hpp
+ *
+ * @brief Cut enumeration for compact AIGs
+ *
+ * Each node has a fixed number of cut slots in one flat array, the cuts of a
+ * node are the priority many best non-dominated merged cuts of its fanins
+ * w.r.t. a cut cost (see priority.hpp) and the trivial cut.  Since the node
+ * order of a compact AIG is topological, no sorting or levelization is
+ * required.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef CUTS_COMPACT_HPP
+#define CUTS_COMPACT_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <classical/compact_aig.hpp>
+#include <classical/functions/cuts/priority.hpp>
+
+namespace cirkit
+{
+
+class compact_aig_cuts final
+{
+public:
+  using leaf_range = boost::iterator_range<const std::uint32_t*>;
+
+  /* throws std::invalid_argument if k exceeds priority_cut::max_leaves */
+  compact_aig_cuts( const compact_aig& aig, unsigned k, unsigned priority = 8u, cut_cost_t cost = cut_cost_t::depth );
+
+  unsigned total_cut_count() const;
+  double enumeration_time() const;
+  std::size_t memory() const;
+
+  inline unsigned count( compact_aig::node n ) const { return counts[n]; }
+
+  /* leaves of the j-th cut of node n, the last cut is the trivial one */
+  leaf_range cut( compact_aig::node n, unsigned j ) const;
+
+private:
+  void enumerate();
+  void load( compact_aig::node n, unsigned j, priority_cut& cut ) const;
+  unsigned cone_size( compact_aig::node n, const priority_cut& cut );
+
+  inline std::uint32_t* slot( compact_aig::node n, unsigned j )
+  {
+    return &data[( static_cast<std::size_t>( n ) * _slots + j ) * ( _k + 1u )];
+  }
+
+  inline const std::uint32_t* slot( compact_aig::node n, unsigned j ) const
+  {
+    return &data[( static_cast<std::size_t>( n ) * _slots + j ) * ( _k + 1u )];
+  }
+
+private:
+  const compact_aig&         _aig;
+  unsigned                   _k;
+  unsigned                   _priority;
+  unsigned                   _slots;
+  cut_cost_t                 _cost;
+
+  /* per slot: number of leaves followed by k leaves */
+  std::vector<std::uint32_t> data;
+  std::vector<std::uint64_t> signatures;
+  std::vector<unsigned char> counts;
+
+  /* costs of the best cut of each node */
+  std::vector<unsigned>      fanouts;
+  std::vector<unsigned>      depths;
+  std::vector<float>         flows;
+  std::vector<unsigned>      visited; /* stamps for cone_size */
+  unsigned                   stamp = 0u;
+
+  double                     _enumeration_time = 0.0;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -27,7 +27,6 @@
 #include "paged.hpp"
 
 #include <map>
-#include <mutex>
 
 #include <core/utils/bitset_utils.hpp>
 #include <core/utils/range_utils.hpp>
@@ -59,14 +58,30 @@ namespace cirkit
  * Public functions                                                           *
  ******************************************************************************/
 
-paged_aig_cuts::paged_aig_cuts( const aig_graph& aig, unsigned k, bool parallel, unsigned priority )
+paged_aig_cuts::paged_aig_cuts( const aig_graph& aig, unsigned k, bool parallel, unsigned priority, const properties::ptr& settings )
   : _aig( aig ),
     _k( k ),
     _priority( priority ),
-    data( num_vertices( _aig ) )
+    data( num_vertices( _aig ) ),
+    _settings( settings ),
+    _priority_cuts( get( settings, "priority_cuts", false ) && k <= priority_cut::max_leaves ),
+    _cut_cost( get( settings, "cut_cost", cut_cost_t::depth ) )
 {
   _levels = compute_levels( aig );
 
+  if ( _priority_cuts )
+  {
+    const auto size = num_vertices( aig );
+    _fanout.resize( size, 0u );
+    _node_depth.resize( size, 0u );
+    _node_flow.resize( size, 0.0f );
+
+    for ( const auto& e : boost::make_iterator_range( edges( aig ) ) )
+    {
+      ++_fanout[target( e, aig )];
+    }
+  }
+
   if ( parallel )
   {
     enumerate_parallel();
@@ -104,6 +119,16 @@ boost::iterator_range<paged_memory::iterator> paged_aig_cuts::cuts( aig_node nod
 
 tt paged_aig_cuts::simulate( aig_node node, const paged_aig_cuts::cut& c ) const
 {
+  switch ( c.size() )
+  {
+  case 0u: case 1u: case 2u: case 3u: case 4u: case 5u: case 6u:
+    return from_static_tt( simulate<6u>( node, c ) );
+  case 7u:
+    return from_static_tt( simulate<7u>( node, c ) );
+  case 8u:
+    return from_static_tt( simulate<8u>( node, c ) );
+  }
+
   std::map<aig_node, tt> inputs;
   auto i = 0u;
   for ( const auto& child : c )
@@ -117,6 +142,20 @@ tt paged_aig_cuts::simulate( aig_node node, const paged_aig_cuts::cut& c ) const
   return simulate_aig_node( _aig, node, sim );
 }
 
+template<unsigned NumVars>
+static_tt<NumVars> paged_aig_cuts::simulate( aig_node node, const paged_aig_cuts::cut& c ) const
+{
+  return simulate_aig_cut<NumVars>( _aig, node, c.begin(), c.end() );
+}
+
+template static_tt<2u> paged_aig_cuts::simulate<2u>( aig_node, const paged_aig_cuts::cut& ) const;
+template static_tt<3u> paged_aig_cuts::simulate<3u>( aig_node, const paged_aig_cuts::cut& ) const;
+template static_tt<4u> paged_aig_cuts::simulate<4u>( aig_node, const paged_aig_cuts::cut& ) const;
+template static_tt<5u> paged_aig_cuts::simulate<5u>( aig_node, const paged_aig_cuts::cut& ) const;
+template static_tt<6u> paged_aig_cuts::simulate<6u>( aig_node, const paged_aig_cuts::cut& ) const;
+template static_tt<7u> paged_aig_cuts::simulate<7u>( aig_node, const paged_aig_cuts::cut& ) const;
+template static_tt<8u> paged_aig_cuts::simulate<8u>( aig_node, const paged_aig_cuts::cut& ) const;
+
 unsigned paged_aig_cuts::depth( aig_node node, const paged_aig_cuts::cut& c ) const
 {
   std::map<aig_node, unsigned> inputs;
@@ -165,7 +204,19 @@ void paged_aig_cuts::enumerate()
       const auto n1 = *it++;
       const auto n2 = *it;
 
-      enumerate_node_with_bitsets( n, n1, n2 );
+      if ( _priority_cuts )
+      {
+        priority_cut_set local_cuts( _priority, _cut_cost );
+        enumerate_priority_cuts( n, n1, n2, local_cuts );
+        for ( const auto& cut : local_cuts )
+        {
+          data.append_set( n, cut.to_vector() );
+        }
+      }
+      else
+      {
+        enumerate_node_with_bitsets( n, n1, n2 );
+      }
 
       data.append_singleton( n, n );
     }
@@ -177,33 +228,71 @@ void paged_aig_cuts::enumerate()
 void paged_aig_cuts::enumerate_parallel()
 {
   reference_timer t( &_enumeration_time );
-  std::mutex mutex;
 
-  /* constant */
-  data.assign_empty( 0u );
+  /* Nodes of one level only read the cuts of lower levels.  Since appending to
+     the paged memory may reallocate it, the cuts of a level are first collected
+     concurrently and then written to the paged memory by a single thread once
+     the level is complete. */
+  const auto size = boost::num_vertices( _aig );
+  std::vector<std::vector<std::vector<unsigned>>> level_cuts( size );
 
-  auto on_input = [this, &mutex]( aig_node n ) {
-    mutex.lock();
-    this->data.assign_singleton( n, n );
-    mutex.unlock();
-  };
+  auto on_input = []( aig_node n ) {};
+
+  auto on_and = [this, &level_cuts, &size]( aig_node n, const aig_function& c1, const aig_function& c2 ) {
+    auto& cuts = level_cuts[n];
+
+    /* writes only to the depth and flow of n, which no other node of this level reads */
+    if ( this->_priority_cuts )
+    {
+      priority_cut_set local_cuts( this->_priority, this->_cut_cost );
+      this->enumerate_priority_cuts( n, c1.node, c2.node, local_cuts );
+
+      cuts.reserve( local_cuts.size() );
+      for ( const auto& cut : local_cuts )
+      {
+        cuts.push_back( cut.to_vector() );
+      }
+      return;
+    }
 
-  const auto size = boost::num_vertices( _aig );
-  auto on_and = [this, &mutex, &size]( aig_node n, const aig_function& c1, const aig_function& c2 ) {
     const auto local_cuts = this->enumerate_local_cuts( c1.node, c2.node, size );
 
-    mutex.lock();
-    this->data.append_begin( n );
+    cuts.reserve( local_cuts.size() );
     for ( const auto& cut : local_cuts )
     {
-      this->data.append_set( n, get_index_vector( cut.first ) );
+      cuts.push_back( get_index_vector( cut.first ) );
     }
+  };
+
+  auto on_level = [this, &level_cuts]( const aig_node_range& nodes ) {
+    for ( auto n : nodes )
+    {
+      if ( out_degree( n, this->_aig ) == 0u )
+      {
+        if ( n == 0u )
+        {
+          this->data.assign_empty( 0u );
+        }
+        else
+        {
+          this->data.assign_singleton( n, n );
+        }
+      }
+      else
+      {
+        this->data.append_begin( n );
+        for ( const auto& cut : level_cuts[n] )
+        {
+          this->data.append_set( n, cut );
+        }
+        this->data.append_singleton( n, n );
 
-    this->data.append_singleton( n, n );
-    mutex.unlock();
+        std::vector<std::vector<unsigned>>().swap( level_cuts[n] );
+      }
+    }
   };
 
-  parallel_process( _aig, on_input, on_and );
+  parallel_process( _aig, on_input, on_and, on_level, _settings );
 }
 
 std::vector<std::pair<boost::dynamic_bitset<>, unsigned>> paged_aig_cuts::enumerate_local_cuts( aig_node n1, aig_node n2, unsigned max_cut_size )
@@ -280,6 +369,79 @@ std::vector<std::pair<boost::dynamic_bitset<>, unsigned>> paged_aig_cuts::enumer
   return local_cuts;
 }
 
+void paged_aig_cuts::enumerate_priority_cuts( aig_node n, aig_node n1, aig_node n2, priority_cut_set& local_cuts )
+{
+  const auto to_priority_cut = []( const cut& c ) {
+    priority_cut pc;
+    for ( auto leaf : c )
+    {
+      pc.leaves[pc.size++] = leaf;
+      pc.signature |= priority_cut::leaf_signature( leaf );
+    }
+    return pc;
+  };
+
+  std::vector<priority_cut> cuts2;
+  for ( const auto& c2 : cuts( n2 ) )
+  {
+    cuts2.push_back( to_priority_cut( c2 ) );
+  }
+
+  priority_cut new_cut;
+  for ( const auto& c1 : cuts( n1 ) )
+  {
+    const auto pc1 = to_priority_cut( c1 );
+
+    for ( const auto& pc2 : cuts2 )
+    {
+      if ( !new_cut.merge( pc1, pc2, _k ) ) { continue; }
+
+      new_cut.depth = 0u;
+      new_cut.area_flow = 1.0f;
+      for ( auto leaf : new_cut )
+      {
+        new_cut.depth = std::max( new_cut.depth, _node_depth[leaf] );
+        new_cut.area_flow += _node_flow[leaf] / std::max( 1u, _fanout[leaf] );
+      }
+      ++new_cut.depth;
+
+      if ( _cut_cost == cut_cost_t::cone_size )
+      {
+        new_cut.cone_size = cone_size( n, new_cut );
+      }
+
+      local_cuts.insert( new_cut );
+    }
+  }
+
+  if ( !local_cuts.empty() )
+  {
+    _node_depth[n] = local_cuts.best().depth;
+    _node_flow[n] = local_cuts.best().area_flow;
+  }
+}
+
+unsigned paged_aig_cuts::cone_size( aig_node node, const priority_cut& cut ) const
+{
+  std::vector<aig_node> visited, stack{node};
+
+  while ( !stack.empty() )
+  {
+    const auto n = stack.back();
+    stack.pop_back();
+
+    if ( n == 0u || std::binary_search( cut.begin(), cut.end(), n ) || boost::find( visited, n ) != visited.end() ) { continue; }
+    visited.push_back( n );
+
+    for ( const auto& child : boost::make_iterator_range( adjacent_vertices( n, _aig ) ) )
+    {
+      stack.push_back( child );
+    }
+  }
+
+  return visited.size();
+}
+
 void paged_aig_cuts::enumerate_node_with_bitsets( aig_node n, aig_node n1, aig_node n2 )
 {
   for ( const auto& cut : enumerate_local_cuts( n1, n2, _top_index ) )
@@ -42,8 +42,11 @@
 #include <boost/dynamic_bitset.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include <core/properties.hpp>
 #include <core/utils/paged_memory.hpp>
 #include <classical/aig.hpp>
+#include <classical/functions/cuts/priority.hpp>
+#include <classical/utils/static_truth_table.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 namespace cirkit
@@ -54,7 +57,13 @@ class paged_aig_cuts final
 public:
   using cut = paged_memory::set;
 
-  paged_aig_cuts( const aig_graph& aig, unsigned k, bool parallel = true, unsigned priority = 8u );
+  /* settings are passed to parallel_process if parallel is true
+   *
+   * If the setting priority_cuts is true, each node keeps the priority many
+   * best cuts with respect to cut_cost (see priority.hpp) instead of the
+   * cuts with the latest leaves, and cuts are merged without bitsets.
+   * The setting is ignored for k > priority_cut::max_leaves. */
+  paged_aig_cuts( const aig_graph& aig, unsigned k, bool parallel = true, unsigned priority = 8u, const properties::ptr& settings = properties::ptr() );
 
   unsigned total_cut_count() const;
   double enumeration_time() const;
@@ -64,12 +73,17 @@ public:
   boost::iterator_range<paged_memory::iterator> cuts( aig_node node );
 
   tt simulate( aig_node node, const cut& c ) const;
+  /* allocation-free variant, requires c.size() <= NumVars (NumVars = 2, ..., 8) */
+  template<unsigned NumVars>
+  static_tt<NumVars> simulate( aig_node node, const cut& c ) const;
   unsigned depth( aig_node node, const cut& c ) const;
 
 private:
   void enumerate();
   void enumerate_node_with_bitsets( aig_node n, aig_node n1, aig_node n2 );
   std::vector<std::pair<boost::dynamic_bitset<>, unsigned>> enumerate_local_cuts( aig_node n1, aig_node n2, unsigned max_cut_size );
+  void enumerate_priority_cuts( aig_node n, aig_node n1, aig_node n2, priority_cut_set& local_cuts );
+  unsigned cone_size( aig_node node, const priority_cut& cut ) const;
 
   void enumerate_parallel();
 
@@ -84,6 +98,15 @@ private:
   unsigned                     _top_index = 0u; /* index when doing topo traversal */
 
   std::map<aig_node, unsigned> _levels;
+
+  properties::ptr              _settings;
+
+  /* priority cuts */
+  bool                         _priority_cuts = false;
+  cut_cost_t                   _cut_cost = cut_cost_t::depth;
+  std::vector<unsigned>        _fanout;
+  std::vector<unsigned>        _node_depth;
+  std::vector<float>           _node_flow;
 };
 
 }
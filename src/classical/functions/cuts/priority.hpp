@@ -0,0 +1,204 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file priority.hpp
+ *
+ * @brief Bounded priority cut sets
+ *
+ * A priority cut keeps its leaves in a fixed-size sorted array together with
+ * a 64-bit signature (bit leaf % 64 is set for each leaf), which rejects most
+ * oversized merges and dominance checks without looking at the leaves.  A
+ * priority cut set keeps at most a fixed number of non-dominated cuts, ordered
+ * by a cost function.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef CUTS_PRIORITY_HPP
+#define CUTS_PRIORITY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+namespace cirkit
+{
+
+enum class cut_cost_t { depth, area_flow, cone_size };
+
+boost::optional<cut_cost_t> cut_cost_from_string( const std::string& name );
+std::string cut_cost_to_string( cut_cost_t cost );
+
+struct priority_cut
+{
+  static constexpr unsigned max_leaves = 16u;
+
+  std::uint32_t size      = 0u;
+  std::uint32_t leaves[max_leaves];
+  std::uint64_t signature = 0u;
+
+  /* costs, filled in by the enumerator */
+  unsigned      depth     = 0u;
+  float         area_flow = 0.0f;
+  unsigned      cone_size = 0u; /* gates between leaves and root */
+
+  /* enumerator specific value that is carried along */
+  unsigned      data      = 0u;
+
+  inline const std::uint32_t* begin() const { return leaves; }
+  inline const std::uint32_t* end() const { return leaves + size; }
+
+  inline std::vector<unsigned> to_vector() const { return std::vector<unsigned>( begin(), end() ); }
+
+  inline static std::uint64_t leaf_signature( unsigned leaf ) { return UINT64_C( 1 ) << ( leaf & 63u ); }
+
+  /* true, if this is a subset of other */
+  inline bool dominates( const priority_cut& other ) const
+  {
+    if ( size > other.size || ( signature & other.signature ) != signature ) { return false; }
+    return std::includes( other.begin(), other.end(), begin(), end() );
+  }
+
+  /* sets leaves and signature to the union of c1 and c2, returns false if it has more than k leaves */
+  inline bool merge( const priority_cut& c1, const priority_cut& c2, unsigned k )
+  {
+    signature = c1.signature | c2.signature;
+    if ( static_cast<unsigned>( __builtin_popcountll( signature ) ) > k ) { return false; }
+
+    auto i1 = c1.begin(), i2 = c2.begin();
+    size = 0u;
+    while ( i1 != c1.end() || i2 != c2.end() )
+    {
+      if ( size == k ) { return false; }
+
+      if ( i2 == c2.end() || ( i1 != c1.end() && *i1 < *i2 ) )
+      {
+        leaves[size++] = *i1++;
+      }
+      else
+      {
+        if ( i1 != c1.end() && *i1 == *i2 ) { ++i1; }
+        leaves[size++] = *i2++;
+      }
+    }
+
+    return true;
+  }
+
+  inline void set_singleton( unsigned leaf )
+  {
+    size = 1u;
+    leaves[0] = leaf;
+    signature = leaf_signature( leaf );
+  }
+};
+
+class priority_cut_set
+{
+public:
+  using const_iterator = std::vector<priority_cut>::const_iterator;
+
+  priority_cut_set( unsigned limit, cut_cost_t cost )
+    : _limit( limit ), _cost( cost )
+  {
+    _cuts.reserve( limit + 1u );
+  }
+
+  inline void clear() { _cuts.clear(); }
+  inline bool empty() const { return _cuts.empty(); }
+  inline std::size_t size() const { return _cuts.size(); }
+  inline const_iterator begin() const { return _cuts.begin(); }
+  inline const_iterator end() const { return _cuts.end(); }
+  inline const priority_cut& best() const { return _cuts.front(); }
+
+  /* true, if c1 is preferred over c2 */
+  inline bool better( const priority_cut& c1, const priority_cut& c2 ) const
+  {
+    switch ( _cost )
+    {
+    case cut_cost_t::depth:
+      if ( c1.depth != c2.depth ) { return c1.depth < c2.depth; }
+      if ( c1.size != c2.size ) { return c1.size < c2.size; }
+      return c1.area_flow < c2.area_flow;
+    case cut_cost_t::area_flow:
+      if ( c1.area_flow != c2.area_flow ) { return c1.area_flow < c2.area_flow; }
+      if ( c1.size != c2.size ) { return c1.size < c2.size; }
+      return c1.depth < c2.depth;
+    case cut_cost_t::cone_size:
+      if ( c1.cone_size != c2.cone_size ) { return c1.cone_size < c2.cone_size; }
+      if ( c1.size != c2.size ) { return c1.size < c2.size; }
+      return c1.depth < c2.depth;
+    }
+    return false;
+  }
+
+  /* true, if a cut with this cost would still be kept (leaves are not considered) */
+  inline bool admissible( const priority_cut& cut ) const
+  {
+    return _cuts.size() < _limit || better( cut, _cuts.back() );
+  }
+
+  /* adds cut unless it is dominated or too expensive, returns true if it was added */
+  bool insert( const priority_cut& cut )
+  {
+    if ( !admissible( cut ) ) { return false; }
+
+    for ( const auto& c : _cuts )
+    {
+      if ( c.dominates( cut ) ) { return false; }
+    }
+    _cuts.erase( std::remove_if( _cuts.begin(), _cuts.end(), [&cut]( const priority_cut& c ) { return cut.dominates( c ); } ), _cuts.end() );
+
+    const auto pos = std::upper_bound( _cuts.begin(), _cuts.end(), cut, [this]( const priority_cut& c1, const priority_cut& c2 ) { return better( c1, c2 ); } );
+    _cuts.insert( pos, cut );
+    if ( _cuts.size() > _limit )
+    {
+      _cuts.pop_back();
+    }
+
+    return true;
+  }
+
+private:
+  unsigned                  _limit;
+  cut_cost_t                _cost;
+  std::vector<priority_cut> _cuts;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,585 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "fraig.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include <core/utils/timer.hpp>
+#include <classical/sat/minisat.hpp>
+#include <classical/sat/sat_solver.hpp>
+#include <classical/sat/operations/logic.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/* lazy Tseitin encoding of a compact AIG, only the fan-in cones of
+   requested literals are encoded */
+template<class S>
+class compact_aig_encoder
+{
+public:
+  compact_aig_encoder( S& solver, const compact_aig& aig )
+    : solver( solver ),
+      aig( aig ),
+      vars( aig.size(), 0 )
+  {
+  }
+
+  int literal( compact_aig::literal f )
+  {
+    encode( compact_aig::get_node( f ) );
+    return lit( f );
+  }
+
+  /* 0, if node is not encoded */
+  inline int var( compact_aig::node n ) const
+  {
+    return vars[n];
+  }
+
+private:
+  inline int lit( compact_aig::literal f ) const
+  {
+    const auto v = vars[compact_aig::get_node( f )];
+    return compact_aig::is_complemented( f ) ? -v : v;
+  }
+
+  void encode( compact_aig::node root )
+  {
+    stack.clear();
+    stack.push_back( root );
+
+    while ( !stack.empty() )
+    {
+      const auto n = stack.back();
+      if ( vars[n] ) { stack.pop_back(); continue; }
+
+      if ( !aig.is_and( n ) )
+      {
+        stack.pop_back();
+        vars[n] = sid++;
+        if ( aig.is_constant( n ) )
+        {
+          add_clause( solver )( {-vars[n]} );
+        }
+        continue;
+      }
+
+      const auto n0 = compact_aig::get_node( aig.fanin0( n ) );
+      const auto n1 = compact_aig::get_node( aig.fanin1( n ) );
+      if ( !vars[n0] || !vars[n1] )
+      {
+        if ( !vars[n0] ) { stack.push_back( n0 ); }
+        if ( !vars[n1] ) { stack.push_back( n1 ); }
+        continue;
+      }
+
+      stack.pop_back();
+      vars[n] = sid++;
+      logic_and( solver, lit( aig.fanin0( n ) ), lit( aig.fanin1( n ) ), vars[n] );
+    }
+  }
+
+private:
+  S&                             solver;
+  const compact_aig&             aig;
+  std::vector<int>               vars;
+  std::vector<compact_aig::node> stack;
+  int                            sid = 1;
+};
+
+class fraig_engine
+{
+public:
+  fraig_engine( const compact_aig& aig, unsigned sim_words, int conf_budget, unsigned seed )
+    : aig( aig ),
+      conf_budget( conf_budget ),
+      gen( seed ),
+      reachable( aig.size(), 0u ),
+      status( aig.size(), node_status::open ),
+      merged( aig.size(), 0u )
+  {
+    /* nodes in the transitive fan-in of the outputs, and the constant
+       as representative of constant nodes */
+    reachable[0u] = 1u;
+    for ( auto o = 0u; o < aig.num_outputs(); ++o )
+    {
+      reachable[compact_aig::get_node( aig.output( o ) )] = 1u;
+    }
+    for ( auto n = aig.size(); n-- > 1u; )
+    {
+      if ( reachable[n] && aig.is_and( n ) )
+      {
+        reachable[compact_aig::get_node( aig.fanin0( n ) )] = 1u;
+        reachable[compact_aig::get_node( aig.fanin1( n ) )] = 1u;
+      }
+    }
+
+    reference_timer t( &sim_runtime );
+    std::vector<std::uint64_t> inputs( aig.num_inputs() );
+    for ( auto w = 0u; w < std::max( sim_words, 1u ); ++w )
+    {
+      std::generate( inputs.begin(), inputs.end(), std::ref( gen ) );
+      simulate( inputs );
+    }
+  }
+
+  compact_aig run( unsigned num_threads, bool verbose )
+  {
+    while ( true )
+    {
+      ++rounds;
+
+      {
+        increment_timer t( &sim_runtime );
+        compute_classes();
+      }
+
+      next_class = 0u;
+      counterexamples.clear();
+      const auto proved_before = proved;
+
+      std::vector<std::thread> workers;
+      for ( auto t = 1u; t < num_threads; ++t )
+      {
+        workers.emplace_back( [this]() { work(); } );
+      }
+      work();
+      for ( auto& w : workers )
+      {
+        w.join();
+      }
+
+      if ( verbose )
+      {
+        std::cout << boost::format( "[i] round %d: %d classes, %d proved, %d disproved, %d words" ) % rounds % classes.size() % ( proved - proved_before ) % counterexamples.size() % blocks.size() << std::endl;
+      }
+
+      if ( counterexamples.empty() ) { break; }
+
+      /* refine the classes by simulating the counterexamples, 64 per word,
+         the remaining bits of the last word are random */
+      increment_timer t( &sim_runtime );
+      std::vector<std::uint64_t> inputs( aig.num_inputs() );
+      for ( auto k = 0u; k < counterexamples.size(); k += 64u )
+      {
+        std::generate( inputs.begin(), inputs.end(), std::ref( gen ) );
+        for ( auto b = 0u; b < 64u && k + b < counterexamples.size(); ++b )
+        {
+          const auto& cex = counterexamples[k + b];
+          for ( auto i = 0u; i < aig.num_inputs(); ++i )
+          {
+            inputs[i] = ( inputs[i] & ~( UINT64_C( 1 ) << b ) ) | ( static_cast<std::uint64_t>( cex[i] ) << b );
+          }
+        }
+        simulate( inputs );
+      }
+    }
+
+    return build();
+  }
+
+  double        sim_runtime = 0.0;
+  double        sat_runtime = 0.0;
+  unsigned      rounds = 0u;
+  unsigned long sat_calls = 0ul;
+  unsigned      proved = 0u;
+  unsigned      disproved = 0u;
+  unsigned      undecided = 0u;
+
+private:
+  enum class node_status : unsigned char { open, proved, undecided };
+
+  inline bool phase( compact_aig::node n ) const
+  {
+    return blocks.front()[n] & 1u;
+  }
+
+  /* adds one word of simulation values for all nodes */
+  void simulate( const std::vector<std::uint64_t>& inputs )
+  {
+    blocks.emplace_back( aig.size() );
+    auto& values = blocks.back();
+
+    const auto value = [&values]( compact_aig::literal f ) {
+      return values[compact_aig::get_node( f )] ^ ( -static_cast<std::uint64_t>( compact_aig::is_complemented( f ) ) );
+    };
+
+    values[0u] = 0u;
+    for ( auto n = 1u; n < aig.size(); ++n )
+    {
+      values[n] = aig.is_pi( n ) ? inputs[aig.input_index( n )] : ( value( aig.fanin0( n ) ) & value( aig.fanin1( n ) ) );
+    }
+  }
+
+  std::uint64_t signature_hash( compact_aig::node n ) const
+  {
+    const auto mask = -static_cast<std::uint64_t>( phase( n ) );
+    std::uint64_t h = 0u;
+    for ( const auto& values : blocks )
+    {
+      h = ( h ^ ( values[n] ^ mask ) ) * UINT64_C( 0x9e3779b97f4a7c15 );
+    }
+    return h ^ ( h >> 32u );
+  }
+
+  bool equal_signatures( compact_aig::node a, compact_aig::node b ) const
+  {
+    const auto mask = -static_cast<std::uint64_t>( phase( a ) != phase( b ) );
+    return std::all_of( blocks.begin(), blocks.end(), [a, b, mask]( const std::vector<std::uint64_t>& values ) { return ( values[a] ^ values[b] ) == mask; } );
+  }
+
+  /* members are in topological order, the first one is the representative */
+  void compute_classes()
+  {
+    classes.clear();
+
+    std::unordered_map<std::uint64_t, std::vector<unsigned>> buckets;
+    for ( auto n = 0u; n < aig.size(); ++n )
+    {
+      if ( !reachable[n] || status[n] == node_status::proved ) { continue; }
+
+      auto& bucket = buckets[signature_hash( n )];
+      const auto it = std::find_if( bucket.begin(), bucket.end(), [this, n]( unsigned c ) { return equal_signatures( classes[c].front(), n ); } );
+      if ( it == bucket.end() )
+      {
+        bucket.push_back( classes.size() );
+        classes.push_back( {n} );
+      }
+      else
+      {
+        classes[*it].push_back( n );
+      }
+    }
+
+    classes.erase( std::remove_if( classes.begin(), classes.end(), []( const std::vector<compact_aig::node>& c ) { return c.size() == 1u; } ), classes.end() );
+  }
+
+  void work()
+  {
+    /* per worker state */
+    auto settings = std::make_shared<properties>();
+    settings->set( "conf_budget", conf_budget > 0 ? conf_budget : -1 );
+    auto solver = make_solver<minisat_solver>( settings );
+    compact_aig_encoder<minisat_solver> encoder( solver, aig );
+
+    double        local_sat_runtime = 0.0;
+    unsigned long local_sat_calls = 0ul;
+    unsigned      local_proved = 0u, local_undecided = 0u;
+    std::vector<std::vector<unsigned char>> local_counterexamples;
+
+    std::vector<unsigned char> values( aig.size() ), pattern( aig.num_inputs() ), disproved_members;
+
+    solver_execution_statistics stats;
+    const auto query = [&]( int a, int b ) {
+      const auto result = solve( solver, stats, {a, b} );
+      local_sat_runtime += stats.runtime;
+      ++local_sat_calls;
+      return result;
+    };
+
+    for ( auto c = next_class++; c < classes.size(); c = next_class++ )
+    {
+      const auto& members = classes[c];
+      const auto repr = members.front();
+      disproved_members.assign( members.size(), 0u );
+
+      for ( auto i = 1u; i < members.size(); ++i )
+      {
+        const auto node = members[i];
+        if ( status[node] != node_status::open || disproved_members[i] ) { continue; }
+
+        const auto lit_repr = compact_aig::make_literal( repr, phase( repr ) != phase( node ) );
+        const auto a = encoder.literal( compact_aig::make_literal( node, false ) );
+        const auto b = encoder.literal( lit_repr );
+
+        /* node and representative can only differ in two ways */
+        auto result = query( a, -b );
+        if ( !result && !stats.undecided )
+        {
+          result = query( -a, b );
+        }
+
+        if ( stats.undecided )
+        {
+          status[node] = node_status::undecided;
+          ++local_undecided;
+        }
+        else if ( result )
+        {
+          const auto& model = result->first;
+          for ( auto k = 0u; k < aig.num_inputs(); ++k )
+          {
+            const auto var = encoder.var( aig.input( k ) );
+            pattern[k] = var != 0 && static_cast<unsigned>( var - 1 ) < model.size() && model[var - 1];
+          }
+          local_counterexamples.push_back( pattern );
+
+          /* the counterexample may also separate other members from the representative */
+          simulate_pattern( pattern, members.back(), values );
+          for ( auto j = i; j < members.size(); ++j )
+          {
+            if ( ( values[members[j]] ^ phase( members[j] ) ) != ( values[repr] ^ phase( repr ) ) )
+            {
+              disproved_members[j] = 1u;
+            }
+          }
+        }
+        else
+        {
+          status[node] = node_status::proved;
+          merged[node] = lit_repr;
+          ++local_proved;
+
+          /* helps later queries in this solver */
+          equals( solver, a, b );
+        }
+      }
+    }
+
+    std::lock_guard<std::mutex> lock( mutex );
+    sat_runtime += local_sat_runtime;
+    sat_calls   += local_sat_calls;
+    proved      += local_proved;
+    undecided   += local_undecided;
+    disproved   += local_counterexamples.size();
+    counterexamples.insert( counterexamples.end(), local_counterexamples.begin(), local_counterexamples.end() );
+  }
+
+  /* simulates a single pattern for nodes up to last */
+  void simulate_pattern( const std::vector<unsigned char>& pattern, compact_aig::node last, std::vector<unsigned char>& values ) const
+  {
+    const auto value = [&values]( compact_aig::literal f ) -> unsigned char {
+      return values[compact_aig::get_node( f )] ^ static_cast<unsigned char>( compact_aig::is_complemented( f ) );
+    };
+
+    values[0u] = 0u;
+    for ( auto n = 1u; n <= last; ++n )
+    {
+      values[n] = aig.is_pi( n ) ? pattern[aig.input_index( n )] : ( value( aig.fanin0( n ) ) & value( aig.fanin1( n ) ) );
+    }
+  }
+
+  /* merges proved nodes into their representatives and removes dangling nodes */
+  compact_aig build() const
+  {
+    std::vector<unsigned char> used( aig.size(), 0u );
+    for ( auto o = 0u; o < aig.num_outputs(); ++o )
+    {
+      used[compact_aig::get_node( aig.output( o ) )] = 1u;
+    }
+    for ( auto n = aig.size(); n-- > 1u; )
+    {
+      if ( !used[n] ) { continue; }
+
+      if ( status[n] == node_status::proved )
+      {
+        used[compact_aig::get_node( merged[n] )] = 1u;
+      }
+      else if ( aig.is_and( n ) )
+      {
+        used[compact_aig::get_node( aig.fanin0( n ) )] = 1u;
+        used[compact_aig::get_node( aig.fanin1( n ) )] = 1u;
+      }
+    }
+
+    compact_aig dest( aig.model_name() );
+    dest.reserve( aig.size() );
+
+    std::vector<compact_aig::literal> map( aig.size(), 0u );
+    for ( auto i = 0u; i < aig.num_inputs(); ++i )
+    {
+      map[aig.input( i )] = dest.create_pi( aig.input_name( i ) );
+    }
+
+    const auto lit = [&map]( compact_aig::literal f ) { return map[compact_aig::get_node( f )] ^ ( f & 1u ); };
+    for ( auto n = 1u; n < aig.size(); ++n )
+    {
+      if ( !used[n] || !aig.is_and( n ) ) { continue; }
+
+      map[n] = status[n] == node_status::proved ? lit( merged[n] ) : dest.create_and( lit( aig.fanin0( n ) ), lit( aig.fanin1( n ) ) );
+    }
+
+    for ( auto o = 0u; o < aig.num_outputs(); ++o )
+    {
+      dest.create_po( lit( aig.output( o ) ), aig.output_name( o ) );
+    }
+
+    return dest;
+  }
+
+private:
+  const compact_aig&                       aig;
+  const int                                conf_budget;
+  std::mt19937_64                          gen;
+
+  std::vector<unsigned char>               reachable;
+  std::vector<node_status>                 status;
+  std::vector<compact_aig::literal>        merged;      /* representative literal of proved nodes */
+  std::vector<std::vector<std::uint64_t>>  blocks;      /* one simulation word per node and block */
+
+  std::vector<std::vector<compact_aig::node>> classes;
+  std::atomic<unsigned>                    next_class{ 0u };
+
+  std::mutex                               mutex;
+  std::vector<std::vector<unsigned char>>  counterexamples;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* output o is the XOR of the outputs o of both AIGs */
+compact_aig create_miter( const compact_aig& circuit, const compact_aig& spec )
+{
+  assert( circuit.num_inputs() == spec.num_inputs() && circuit.num_outputs() == spec.num_outputs() );
+
+  compact_aig miter( circuit.model_name() + "_miter" );
+  miter.reserve( circuit.size() + spec.size() );
+
+  std::vector<compact_aig::literal> inputs( circuit.num_inputs() );
+  for ( auto i = 0u; i < circuit.num_inputs(); ++i )
+  {
+    inputs[i] = miter.create_pi( circuit.input_name( i ) );
+  }
+
+  const auto copy = [&]( const compact_aig& aig ) {
+    std::vector<compact_aig::literal> map( aig.size(), 0u );
+    for ( auto i = 0u; i < aig.num_inputs(); ++i )
+    {
+      map[aig.input( i )] = inputs[i];
+    }
+
+    const auto lit = [&map]( compact_aig::literal f ) { return map[compact_aig::get_node( f )] ^ ( f & 1u ); };
+    for ( auto n = 1u; n < aig.size(); ++n )
+    {
+      if ( aig.is_and( n ) )
+      {
+        map[n] = miter.create_and( lit( aig.fanin0( n ) ), lit( aig.fanin1( n ) ) );
+      }
+    }
+
+    std::vector<compact_aig::literal> outputs( aig.num_outputs() );
+    for ( auto o = 0u; o < aig.num_outputs(); ++o )
+    {
+      outputs[o] = lit( aig.output( o ) );
+    }
+    return outputs;
+  };
+
+  const auto outputs1 = copy( circuit );
+  const auto outputs2 = copy( spec );
+  for ( auto o = 0u; o < circuit.num_outputs(); ++o )
+  {
+    miter.create_po( miter.create_xor( outputs1[o], outputs2[o] ), circuit.output_name( o ) );
+  }
+
+  return miter;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+compact_aig fraig( const compact_aig& aig,
+                   const properties::ptr& settings,
+                   const properties::ptr& statistics )
+{
+  /* settings */
+  const auto sim_words   = get( settings, "sim_words",   8u );
+  const auto conf_budget = get( settings, "conf_budget", 1000 );
+  const auto num_threads = get( settings, "num_threads", 0u );
+  const auto seed        = get( settings, "seed",        0u );
+  const auto verbose     = get( settings, "verbose",     false );
+
+  /* timer */
+  properties_timer t( statistics );
+
+  fraig_engine engine( aig, sim_words, conf_budget, seed );
+  auto result = engine.run( num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads, verbose );
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] fraig: %d -> %d gates (%d proved, %d disproved, %d undecided)" ) % aig.num_gates() % result.num_gates() % engine.proved % engine.disproved % engine.undecided << std::endl;
+  }
+
+  set( statistics, "sim_runtime", engine.sim_runtime );
+  set( statistics, "sat_runtime", engine.sat_runtime );
+  set( statistics, "rounds",      engine.rounds );
+  set( statistics, "sat_calls",   engine.sat_calls );
+  set( statistics, "proved",      engine.proved );
+  set( statistics, "disproved",   engine.disproved );
+  set( statistics, "undecided",   engine.undecided );
+
+  return result;
+}
+
+aig_graph fraig( const aig_graph& aig,
+                 const properties::ptr& settings,
+                 const properties::ptr& statistics )
+{
+  return compact_aig_to_aig( fraig( aig_to_compact_aig( aig ), settings, statistics ) );
+}
+
+bool fraig_equivalence_check( const aig_graph& circuit, const aig_graph& spec,
+                              const properties::ptr& settings,
+                              const properties::ptr& statistics )
+{
+  const auto miter = fraig( create_miter( aig_to_compact_aig( circuit ), aig_to_compact_aig( spec ) ), settings, statistics );
+
+  for ( auto o = 0u; o < miter.num_outputs(); ++o )
+  {
+    if ( miter.output( o ) != miter.get_constant( false ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,95 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file fraig.hpp
+ *
+ * @brief Functionally reduced AIGs by SAT sweeping
+ *
+ * All nodes are simulated with bit-parallel random patterns and grouped
+ * into candidate equivalence classes by their (phase-normalized)
+ * signatures.  The members of each class are proven equivalent to the
+ * smallest node of the class with incremental SAT queries.
+ * Counterexamples are added as simulation patterns, which refines the
+ * classes for the next round.  Classes are independent and are proven
+ * in parallel, each thread with its own solver.  Proven nodes are
+ * merged into their representative in the result.
+ *
+ * Settings:
+ *   sim_words   (8u):    random 64-bit words per node in the first round
+ *   conf_budget (1000):  conflicts per SAT call, 0 is unlimited; pairs
+ *                        that exceed the budget are not merged
+ *   num_threads (0u):    threads to prove classes, 0u is hardware concurrency
+ *   seed        (0u):    seed for the random patterns
+ *   verbose     (false): print statistics of each round
+ *
+ * Statistics:
+ *   runtime, sim_runtime, sat_runtime, rounds, sat_calls, proved,
+ *   disproved, undecided
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef FRAIG_HPP
+#define FRAIG_HPP
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+#include <classical/compact_aig.hpp>
+
+namespace cirkit
+{
+
+compact_aig fraig( const compact_aig& aig,
+                   const properties::ptr& settings = properties::ptr(),
+                   const properties::ptr& statistics = properties::ptr() );
+
+aig_graph fraig( const aig_graph& aig,
+                 const properties::ptr& settings = properties::ptr(),
+                 const properties::ptr& statistics = properties::ptr() );
+
+/**
+ * @brief Equivalence check by fraiging the miter of two AIGs
+ *
+ * Inputs and outputs are matched by position.  Returns true, if all
+ * outputs of the fraiged miter are constant 0.  False means that the
+ * equivalence could not be proved, either since the AIGs differ or
+ * since some SAT calls exceeded the conflict budget.
+ */
+bool fraig_equivalence_check( const aig_graph& circuit, const aig_graph& spec,
+                              const properties::ptr& settings = properties::ptr(),
+                              const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -106,13 +106,6 @@ std::vector<unsigned> compute_flips( unsigned n )
   return flip_array;
 }
 
-inline void bitset_swap( boost::dynamic_bitset<>& bs, unsigned i, unsigned j )
-{
-  auto t = bs[i];
-  bs[i] = bs[j];
-  bs[j] = t;
-}
-
 void npn_canonization_sifting_loop( tt& npn, unsigned n, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
 {
   auto improvement = true;
@@ -183,98 +176,7 @@ void npn_canonization_sifting_loop( tt& npn, unsigned n, boost::dynamic_bitset<>
 
 tt exact_npn_canonization( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const properties::ptr& settings, const properties::ptr& statistics )
 {
-  properties_timer tim( statistics );
-
-  /* initialize */
-  auto n = tt_num_vars( t );
-  phase.resize( n + 1u );
-  phase.reset();
-  perm.resize( n );
-  boost::iota( perm, 0u );
-
-  assert( n <= 6u );
-
-  const auto& swap_array = tt_store::i().swaps( n );
-  const auto& flip_array = tt_store::i().flips( n );
-  const auto total_swaps = swap_array.size();
-  const auto total_flips = flip_array.size();
-
-  auto t1 = t;
-  auto t2 = ~t; /* inversion */
-  auto min = std::min( t1, t2 );
-
-  auto invo = ( min == t2 );
-
-  if ( false /* verbose */ )
-  {
-    std::cout << "[i] swaps: " << any_join( swap_array, " " ) << std::endl
-              << "[i] flips: " << any_join( flip_array, " " ) << std::endl;
-  }
-
-  int best_flip = total_flips;
-  int best_swap = total_swaps;
-
-  for ( int i = total_swaps - 1; i >= 0; --i )
-  {
-    const auto pos = swap_array[i];
-    t1 = tt_permute( t1, pos, pos + 1 );
-    t2 = tt_permute( t2, pos, pos + 1 );
-    tt_shrink( t1, n ); tt_shrink( t2, n );
-    if ( t1 < min || t2 < min )
-    {
-      best_swap = i;
-      min = std::min( std::min( t1, t2 ), min );
-      invo = ( min == t2 );
-    }
-  }
-
-  for ( int j = total_flips - 1; j >= 0; --j )
-  {
-    t1 = tt_flip( tt_permute( t1, 0u, 1u ), flip_array[j] );
-    t2 = tt_flip( tt_permute( t2, 0u, 1u ), flip_array[j] );
-    tt_shrink( t1, n ); tt_shrink( t2, n );
-    if ( t1 < min || t2 < min )
-    {
-      best_swap = total_swaps;
-      best_flip = j;
-      min = std::min( std::min( t1, t2 ), min );
-      invo = ( min == t2 );
-    }
-
-    for ( int i = total_swaps - 1; i >= 0; --i )
-    {
-      const auto pos = swap_array[i];
-      t1 = tt_permute( t1, pos, pos + 1 );
-      t2 = tt_permute( t2, pos, pos + 1 );
-      tt_shrink( t1, n ); tt_shrink( t2, n );
-      if ( t1 < min || t2 < min )
-      {
-        best_swap = i;
-        best_flip = j;
-        min = std::min( std::min( t1, t2 ), min );
-        invo = ( min == t2 );
-      }
-    }
-  }
-
-  for ( int i = total_swaps - 1; i >= best_swap; --i )
-  {
-    const auto pos = swap_array[i];
-    std::swap( perm[pos], perm[pos + 1] );
-  }
-
-  for ( int j = total_flips - 1; j >= best_flip; --j )
-  {
-    phase.flip( flip_array[j] );
-  }
-
-  /* output inverted? */
-  if ( invo )
-  {
-    phase.flip( n );
-  }
-
-  return min;
+  return detail::exact_npn_canonization( t, tt_num_vars( t ), phase, perm, statistics );
 }
 
 tt npn_canonization( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const properties::ptr& settings, const properties::ptr& statistics )
@@ -341,76 +243,7 @@ tt npn_canonization( const tt& t, boost::dynamic_bitset<>& phase, std::vector<un
 
 tt npn_canonization_flip_swap( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const properties::ptr& settings, const properties::ptr& statistics )
 {
-  properties_timer tim( statistics );
-
-  /* initialize */
-  auto n = tt_num_vars( t );
-  phase.resize( n + 1u );
-  phase.reset();
-  perm.resize( n );
-  boost::iota( perm, 0u );
-
-  tt npn = t;
-
-  auto improvement = true;
-
-  //auto round = 0u;
-
-  while ( improvement )
-  {
-    //std::cout << "[i] round " << ++round << std::endl;
-
-    improvement = false;
-
-    /* input inversion */
-    for ( auto i = 0u; i < n; ++i )
-    {
-      const auto flipped = tt_flip( npn, i );
-      if ( flipped < npn )
-      {
-        //std::cout << "[i]   flip input " << i << std::endl;
-        npn = flipped;
-        phase.flip( i );
-        improvement = true;
-      }
-    }
-
-    /* output inversion */
-    const auto flipped = ~npn;
-    if ( flipped < npn )
-    {
-      //std::cout << "[i]   flip output" << std::endl;
-      npn = flipped;
-      phase.flip( n );
-      improvement = true;
-    }
-
-    /* permute inputs */
-    for ( auto d = 1u; d < n - 1; ++d )
-    {
-      for ( auto i = 0u; i < n - d; ++i )
-      {
-        auto j = i + d;
-
-        const auto permuted = tt_permute( npn, i, j );
-        if ( permuted < npn )
-        {
-          //std::cout << "[i]   swap inputs " << i << " and " << j << std::endl;
-          npn = permuted;
-          std::swap( perm[i], perm[j] );
-          bitset_swap( phase, i, j );
-          improvement = true;
-        }
-      }
-    }
-  }
-
-  if ( tt_num_vars( npn ) > n )
-  {
-    tt_shrink( npn, n );
-  }
-
-  return npn;
+  return detail::npn_canonization_flip_swap( t, tt_num_vars( t ), phase, perm, statistics );
 }
 
 tt npn_canonization_sifting( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const properties::ptr& settings, const properties::ptr& statistics )
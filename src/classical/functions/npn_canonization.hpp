@@ -36,9 +36,16 @@
 #ifndef NPN_CANONIZATION_HPP
 #define NPN_CANONIZATION_HPP
 
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
+#include <boost/range/algorithm_ext/iota.hpp>
 
 #include <core/properties.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/utils/static_truth_table.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 namespace cirkit
@@ -69,6 +76,201 @@ tt tt_from_npn( const tt& npn, const boost::dynamic_bitset<>& phase, std::vector
 /* ABC methods */
 tt npn_canonization_lucky( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm );
 
+/******************************************************************************
+ * Implementations generic in the truth table type                            *
+ ******************************************************************************/
+
+namespace detail
+{
+
+/* TT is tt or static_tt<NumVars>; n is the number of variables of t */
+template<typename TT>
+TT exact_npn_canonization( const TT& t, unsigned n, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
+                           const properties::ptr& statistics )
+{
+  properties_timer tim( statistics );
+
+  /* initialize */
+  phase.resize( n + 1u );
+  phase.reset();
+  perm.resize( n );
+  boost::iota( perm, 0u );
+
+  assert( n <= 6u );
+
+  const auto& swap_array = tt_store::i().swaps( n );
+  const auto& flip_array = tt_store::i().flips( n );
+  const int total_swaps = swap_array.size();
+  const int total_flips = flip_array.size();
+
+  auto t1 = t;
+  auto t2 = ~t; /* inversion */
+  auto min = std::min( t1, t2 );
+
+  auto invo = ( min == t2 );
+
+  int best_flip = total_flips;
+  int best_swap = total_swaps;
+
+  for ( int i = total_swaps - 1; i >= 0; --i )
+  {
+    const auto pos = swap_array[i];
+    t1 = tt_permute( t1, pos, pos + 1 );
+    t2 = tt_permute( t2, pos, pos + 1 );
+    tt_shrink( t1, n ); tt_shrink( t2, n );
+    if ( t1 < min || t2 < min )
+    {
+      best_swap = i;
+      min = std::min( std::min( t1, t2 ), min );
+      invo = ( min == t2 );
+    }
+  }
+
+  for ( int j = total_flips - 1; j >= 0; --j )
+  {
+    t1 = tt_flip( tt_permute( t1, 0u, 1u ), flip_array[j] );
+    t2 = tt_flip( tt_permute( t2, 0u, 1u ), flip_array[j] );
+    tt_shrink( t1, n ); tt_shrink( t2, n );
+    if ( t1 < min || t2 < min )
+    {
+      best_swap = total_swaps;
+      best_flip = j;
+      min = std::min( std::min( t1, t2 ), min );
+      invo = ( min == t2 );
+    }
+
+    for ( int i = total_swaps - 1; i >= 0; --i )
+    {
+      const auto pos = swap_array[i];
+      t1 = tt_permute( t1, pos, pos + 1 );
+      t2 = tt_permute( t2, pos, pos + 1 );
+      tt_shrink( t1, n ); tt_shrink( t2, n );
+      if ( t1 < min || t2 < min )
+      {
+        best_swap = i;
+        best_flip = j;
+        min = std::min( std::min( t1, t2 ), min );
+        invo = ( min == t2 );
+      }
+    }
+  }
+
+  for ( int i = total_swaps - 1; i >= best_swap; --i )
+  {
+    const auto pos = swap_array[i];
+    std::swap( perm[pos], perm[pos + 1] );
+  }
+
+  for ( int j = total_flips - 1; j >= best_flip; --j )
+  {
+    phase.flip( flip_array[j] );
+  }
+
+  /* output inverted? */
+  if ( invo )
+  {
+    phase.flip( n );
+  }
+
+  return min;
+}
+
+template<typename TT>
+TT npn_canonization_flip_swap( const TT& t, unsigned n, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
+                               const properties::ptr& statistics )
+{
+  properties_timer tim( statistics );
+
+  /* initialize */
+  phase.resize( n + 1u );
+  phase.reset();
+  perm.resize( n );
+  boost::iota( perm, 0u );
+
+  auto npn = t;
+
+  auto improvement = true;
+
+  while ( improvement )
+  {
+    improvement = false;
+
+    /* input inversion */
+    for ( auto i = 0u; i < n; ++i )
+    {
+      const auto flipped = tt_flip( npn, i );
+      if ( flipped < npn )
+      {
+        npn = flipped;
+        phase.flip( i );
+        improvement = true;
+      }
+    }
+
+    /* output inversion */
+    const auto flipped = ~npn;
+    if ( flipped < npn )
+    {
+      npn = flipped;
+      phase.flip( n );
+      improvement = true;
+    }
+
+    /* permute inputs */
+    for ( auto d = 1u; d < n - 1; ++d )
+    {
+      for ( auto i = 0u; i < n - d; ++i )
+      {
+        auto j = i + d;
+
+        const auto permuted = tt_permute( npn, i, j );
+        if ( permuted < npn )
+        {
+          npn = permuted;
+          std::swap( perm[i], perm[j] );
+
+          const bool pi = phase[i];
+          phase[i] = phase[j];
+          phase[j] = pi;
+
+          improvement = true;
+        }
+      }
+    }
+  }
+
+  if ( tt_num_vars( npn ) > n )
+  {
+    tt_shrink( npn, n );
+  }
+
+  return npn;
+}
+
+}
+
+/******************************************************************************
+ * Versions for static truth tables                                           *
+ ******************************************************************************/
+
+template<unsigned NumVars>
+static_tt<NumVars> exact_npn_canonization( const static_tt<NumVars>& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
+                                           const properties::ptr& settings = properties::ptr(),
+                                           const properties::ptr& statistics = properties::ptr() )
+{
+  static_assert( NumVars >= 2u && NumVars <= 6u, "exact NPN canonization is implemented for 2 to 6 variables" );
+  return detail::exact_npn_canonization( t, NumVars, phase, perm, statistics );
+}
+
+template<unsigned NumVars>
+static_tt<NumVars> npn_canonization_flip_swap( const static_tt<NumVars>& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
+                                               const properties::ptr& settings = properties::ptr(),
+                                               const properties::ptr& statistics = properties::ptr() )
+{
+  static_assert( NumVars >= 2u, "flip-swap NPN canonization requires at least 2 variables" );
+  return detail::npn_canonization_flip_swap( t, NumVars, phase, perm, statistics );
+}
+
 }
 
 #endif
@@ -0,0 +1,372 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "npn_enumeration.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <core/utils/timer.hpp>
+#include <classical/utils/static_truth_table.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/* orbits only contain functions whose most significant bit is 0, since each
+   NPN class is closed under output negation, this halves the bitmap and the
+   work per orbit */
+template<unsigned NumVars>
+class npn_orbits
+{
+public:
+  using tt_t = static_tt<NumVars>;
+
+  /* n! * 2^n */
+  static constexpr unsigned num_transformations = ( NumVars == 2u ? 2u : NumVars == 3u ? 6u : NumVars == 4u ? 24u : NumVars == 5u ? 120u : 720u ) << NumVars;
+
+  npn_orbits()
+    : swap_array( tt_store::i().swaps( NumVars ) ),
+      flip_array( tt_store::i().flips( NumVars ) )
+  {
+  }
+
+  static inline uint64_t normalize( uint64_t w )
+  {
+    return ( w >> ( tt_t::num_bits - 1u ) ) ? ~w & tt_t::word_mask : w;
+  }
+
+  /* swaps x_i and x_{i+1} */
+  static inline uint64_t swap_adjacent( uint64_t w, unsigned i )
+  {
+    const auto m = static_tt_projections[i] & ~static_tt_projections[i + 1u] & tt_t::word_mask;
+    const auto s = 1u << i;
+    return ( w & ~( m | ( m << s ) ) ) | ( ( w & m ) << s ) | ( ( w >> s ) & m );
+  }
+
+  /* complements x_i */
+  static inline uint64_t flip( uint64_t w, unsigned i )
+  {
+    const auto m = static_tt_projections[i] & tt_t::word_mask;
+    const auto s = 1u << i;
+    return ( ( w & m ) >> s ) | ( ( w << s ) & m );
+  }
+
+  /* visits all n! * 2^n input transformations of func in the same order as exact_npn_canonization */
+  template<typename Fn>
+  void foreach_element( uint64_t func, Fn&& fn ) const
+  {
+    auto w = func;
+
+    fn( normalize( w ) );
+
+    for ( auto i = swap_array.size(); i-- > 0u; )
+    {
+      w = swap_adjacent( w, swap_array[i] );
+      fn( normalize( w ) );
+    }
+
+    for ( auto j = flip_array.size(); j-- > 0u; )
+    {
+      w = flip( swap_adjacent( w, 0u ), flip_array[j] );
+      fn( normalize( w ) );
+
+      for ( auto i = swap_array.size(); i-- > 0u; )
+      {
+        w = swap_adjacent( w, swap_array[i] );
+        fn( normalize( w ) );
+      }
+    }
+  }
+
+  uint64_t representative( uint64_t func ) const
+  {
+    auto min = func;
+    foreach_element( func, [&min]( uint64_t g ) { min = std::min( min, g ); } );
+    return min;
+  }
+
+private:
+  const std::vector<unsigned>& swap_array;
+  const std::vector<unsigned>& flip_array;
+};
+
+template<unsigned NumVars>
+class npn_orbit_enumerator
+{
+public:
+  static constexpr uint64_t num_functions     = UINT64_C( 1 ) << ( ( 1u << NumVars ) - 1u );
+  static constexpr uint64_t chunk_words       = 1024u;
+  static constexpr unsigned prefetch_distance = 16u;
+
+  npn_orbit_enumerator( const npn_class_callback_t& on_class )
+    : marks( std::max<uint64_t>( num_functions >> 6u, 1u ) ),
+      on_class( on_class )
+  {
+  }
+
+  uint64_t run( unsigned num_threads )
+  {
+    positions = std::vector<std::atomic<uint64_t>>( num_threads );
+
+    std::vector<std::thread> workers;
+    for ( auto i = 1u; i < num_threads; ++i )
+    {
+      workers.emplace_back( [this, i]() { work( i ); } );
+    }
+    work( 0u );
+    for ( auto& w : workers )
+    {
+      w.join();
+    }
+
+    return num_classes;
+  }
+
+private:
+  /* returns the previous value of the bit */
+  inline bool test_and_set( uint64_t func )
+  {
+    const auto bit = UINT64_C( 1 ) << ( func & 63u );
+    return marks[func >> 6u].fetch_or( bit, std::memory_order_relaxed ) & bit;
+  }
+
+  /* all words below the returned one have been scanned by all threads;
+     positions only grow, therefore a stale value is a safe lower bound */
+  uint64_t scanned_words() const
+  {
+    auto min = std::numeric_limits<uint64_t>::max();
+    for ( const auto& p : positions )
+    {
+      min = std::min( min, p.load( std::memory_order_relaxed ) );
+    }
+    return min;
+  }
+
+  void work( unsigned id )
+  {
+    const auto valid = num_functions >= 64u ? ~UINT64_C( 0 ) : ( UINT64_C( 1 ) << ( num_functions & 63u ) ) - 1u;
+    std::vector<uint64_t> orbit;
+
+    while ( true )
+    {
+      const auto begin = next_chunk.fetch_add( 1u ) * chunk_words;
+      if ( begin >= marks.size() ) { break; }
+      const auto end = std::min<uint64_t>( begin + chunk_words, marks.size() );
+
+      for ( auto w = begin; w < end; ++w )
+      {
+        positions[id].store( w, std::memory_order_relaxed );
+
+        auto todo = ~marks[w].load( std::memory_order_relaxed ) & valid;
+        while ( todo )
+        {
+          add_orbit( ( w << 6u ) | __builtin_ctzll( todo ), orbit );
+
+          /* the orbit may have covered other functions in this word */
+          todo &= todo - 1u;
+          todo &= ~marks[w].load( std::memory_order_relaxed );
+        }
+      }
+    }
+
+    positions[id].store( std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed );
+  }
+
+  /* the thread that marks the representative owns the class and marks its
+     remaining functions, other threads that reached the same orbit before it
+     was marked give up after computing the representative */
+  void add_orbit( uint64_t func, std::vector<uint64_t>& orbit )
+  {
+    orbit.clear();
+    auto repr = func;
+    auto stabilizer = 0u;
+    orbits.foreach_element( func, [&]( uint64_t g ) {
+        orbit.push_back( g );
+        repr = std::min( repr, g );
+        stabilizer += ( g == func );
+      } );
+
+    if ( test_and_set( repr ) ) { return; }
+
+    /* functions in words that all threads have passed are not visited again
+       and need no mark; the orbit is scattered over the bitmap, therefore
+       the marks are prefetched */
+    const auto scanned = scanned_words();
+    orbit.erase( std::remove_if( orbit.begin(), orbit.end(), [scanned, repr]( uint64_t g ) { return ( g >> 6u ) < scanned || g == repr; } ), orbit.end() );
+
+    for ( auto i = 0u; i < orbit.size(); ++i )
+    {
+      if ( i + prefetch_distance < orbit.size() )
+      {
+        __builtin_prefetch( &marks[orbit[i + prefetch_distance] >> 6u], 1 );
+      }
+
+      const auto bit = UINT64_C( 1 ) << ( orbit[i] & 63u );
+      auto& word = marks[orbit[i] >> 6u];
+      if ( !( word.load( std::memory_order_relaxed ) & bit ) )
+      {
+        word.fetch_or( bit, std::memory_order_relaxed );
+      }
+    }
+
+    /* each function of the orbit is reached by as many transformations as
+       func, the factor 2 accounts for the output complemented functions */
+    const auto size = ( static_cast<uint64_t>( orbit_steps ) / stabilizer ) << 1u;
+
+    std::lock_guard<std::mutex> lock( mutex );
+    ++num_classes;
+    on_class( repr, size );
+  }
+
+private:
+  npn_orbits<NumVars>                 orbits;
+  const unsigned                      orbit_steps = npn_orbits<NumVars>::num_transformations;
+  std::vector<std::atomic<uint64_t>>  marks;
+  std::vector<std::atomic<uint64_t>>  positions;
+  std::atomic<uint64_t>               next_chunk{ 0u };
+
+  const npn_class_callback_t&         on_class;
+  std::mutex                          mutex;
+  uint64_t                            num_classes = 0u;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+unsigned npn_enumeration_threads( const properties::ptr& settings )
+{
+  const auto num_threads = get( settings, "num_threads", 0u );
+  return num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads;
+}
+
+template<unsigned NumVars>
+uint64_t sample_npn_classes_static( uint64_t num_samples, const npn_class_callback_t& on_class, unsigned num_threads, unsigned seed )
+{
+  const npn_orbits<NumVars> orbits;
+  std::unordered_map<uint64_t, uint64_t> classes;
+  std::mutex mutex;
+
+  const auto worker = [&]( unsigned id ) {
+    std::mt19937_64 gen( seed + id );
+    std::unordered_map<uint64_t, uint64_t> local;
+
+    for ( auto s = id; s < num_samples; s += num_threads )
+    {
+      ++local[orbits.representative( gen() & static_tt<NumVars>::word_mask )];
+    }
+
+    std::lock_guard<std::mutex> lock( mutex );
+    for ( const auto& p : local )
+    {
+      classes[p.first] += p.second;
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for ( auto i = 1u; i < num_threads; ++i )
+  {
+    workers.emplace_back( worker, i );
+  }
+  worker( 0u );
+  for ( auto& w : workers )
+  {
+    w.join();
+  }
+
+  for ( const auto& p : classes )
+  {
+    on_class( p.first, p.second );
+  }
+
+  return classes.size();
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+uint64_t enumerate_npn_classes( unsigned num_vars, const npn_class_callback_t& on_class,
+                                const properties::ptr& settings,
+                                const properties::ptr& statistics )
+{
+  properties_timer t( statistics );
+
+  const auto num_threads = npn_enumeration_threads( settings );
+
+  switch ( num_vars )
+  {
+  case 2u: return npn_orbit_enumerator<2u>( on_class ).run( num_threads );
+  case 3u: return npn_orbit_enumerator<3u>( on_class ).run( num_threads );
+  case 4u: return npn_orbit_enumerator<4u>( on_class ).run( num_threads );
+  case 5u: return npn_orbit_enumerator<5u>( on_class ).run( num_threads );
+  default:
+    assert( false );
+    return 0u;
+  }
+}
+
+uint64_t sample_npn_classes( unsigned num_vars, uint64_t num_samples, const npn_class_callback_t& on_class,
+                             const properties::ptr& settings,
+                             const properties::ptr& statistics )
+{
+  properties_timer t( statistics );
+
+  const auto num_threads = npn_enumeration_threads( settings );
+  const auto seed        = get( settings, "seed", 0u );
+
+  switch ( num_vars )
+  {
+  case 2u: return sample_npn_classes_static<2u>( num_samples, on_class, num_threads, seed );
+  case 3u: return sample_npn_classes_static<3u>( num_samples, on_class, num_threads, seed );
+  case 4u: return sample_npn_classes_static<4u>( num_samples, on_class, num_threads, seed );
+  case 5u: return sample_npn_classes_static<5u>( num_samples, on_class, num_threads, seed );
+  case 6u: return sample_npn_classes_static<6u>( num_samples, on_class, num_threads, seed );
+  default:
+    assert( false );
+    return 0u;
+  }
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,95 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file npn_enumeration.hpp
+ *
+ * @brief Parallel enumeration of NPN classes
+ *
+ * All functions are enumerated by marking orbits in a bitmap over the
+ * function space, such that each class is visited only once, and the work is
+ * split into chunks that are processed by several threads.  Orbits are
+ * computed on single 64-bit words.  Class representatives are the same as
+ * computed by exact_npn_canonization.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef NPN_ENUMERATION_HPP
+#define NPN_ENUMERATION_HPP
+
+#include <cstdint>
+#include <functional>
+
+#include <core/properties.hpp>
+
+namespace cirkit
+{
+
+/* called with class representative and number of functions in the class
+   (number of samples for sample_npn_classes), calls are serialized */
+using npn_class_callback_t = std::function<void(uint64_t, uint64_t)>;
+
+/**
+ * Enumerates all NPN classes of functions with 2 to 5 variables, the callback
+ * is called as soon as a class is found.  Returns the number of classes.
+ *
+ * settings:
+ *   num_threads: number of threads (0: number of cores)
+ *
+ * statistics:
+ *   runtime:     run-time
+ */
+uint64_t enumerate_npn_classes( unsigned num_vars, const npn_class_callback_t& on_class,
+                                const properties::ptr& settings = properties::ptr(),
+                                const properties::ptr& statistics = properties::ptr() );
+
+/**
+ * Canonizes num_samples random functions with 2 to 6 variables and calls the
+ * callback for each class that was hit after all samples have been processed.
+ * Returns the number of classes.
+ *
+ * settings:
+ *   num_threads: number of threads (0: number of cores)
+ *   seed:        random seed
+ *
+ * statistics:
+ *   runtime:     run-time
+ */
+uint64_t sample_npn_classes( unsigned num_vars, uint64_t num_samples, const npn_class_callback_t& on_class,
+                             const properties::ptr& settings = properties::ptr(),
+                             const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -44,79 +44,43 @@ namespace cirkit
 void parallel_process(
     const aig_graph& aig,
     const std::function<void( aig_node )>& on_input,
-    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and )
+    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and,
+    const std::function<void( const aig_node_range& )>& on_level,
+    const properties::ptr& settings,
+    const properties::ptr& statistics )
 {
-  /* topological order */
-  std::vector<aig_node> topsort( num_vertices( aig ) );
-  boost::topological_sort( aig, topsort.begin() );
-
-  boost::dynamic_bitset<>              processed( num_vertices( aig ) );
-  std::mutex                           vector_mutex;
-  std::vector<std::thread>             workers;
-  std::vector<std::condition_variable> guards( num_vertices( aig ) );
-  std::vector<std::mutex>              guard_locks( num_vertices( aig ) );
-  processed.set( 0u );
-
-  for ( auto n : topsort )
-  {
-    /* primary input */
-    if ( out_degree( n, aig ) == 0u )
-    {
-      if ( n == 0u ) { continue; }
-
-      workers.emplace_back( [&vector_mutex, &processed, n, &on_input, &guards, &guard_locks]() {
-          on_input( n );
-          vector_mutex.lock();
-          processed.set( n );
-          vector_mutex.unlock();
-
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
-    }
-    else
-    {
-      const auto children = get_children( aig, n );
-
-      workers.emplace_back( [&vector_mutex, &processed, n, &on_and, children, &guards, &guard_locks]() {
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[0].node] );
-            while ( !processed[children[0].node] ) { guards[children[0].node].wait( lck ); }
-          }
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[1].node] );
-            while ( !processed[children[1].node] ) { guards[children[1].node].wait( lck ); }
-          }
-
-          on_and( n, children[0], children[1] );
-          vector_mutex.lock();
-          processed.set( n );
-          vector_mutex.unlock();
-
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
-    }
-  }
-
-  for ( auto& worker : workers )
-  {
-    worker.join();
-  }
+  detail::parallel_levelized_run( aig, [&aig, &on_input, &on_and]( aig_node n ) {
+      /* primary input */
+      if ( out_degree( n, aig ) == 0u )
+      {
+        if ( n == 0u ) { return; }
+        on_input( n );
+      }
+      else
+      {
+        auto it = out_edges( n, aig ).first;
+        const auto c1 = aig_to_function( aig, *it++ );
+        const auto c2 = aig_to_function( aig, *it );
+
+        on_and( n, c1, c2 );
+      }
+    }, on_level, settings, statistics );
 }
 
-void parallel_simulate( const aig_graph& aig, const boost::dynamic_bitset<>& pattern )
+void parallel_simulate( const aig_graph& aig, const boost::dynamic_bitset<>& pattern,
+                        const properties::ptr& settings,
+                        const properties::ptr& statistics )
 {
-  std::vector<bool> computed_values;
-  parallel_compute<bool>( aig,
-                          false,
-                          [&pattern]( unsigned index ) { return pattern[index]; },
-                          []( bool v1, bool c1, bool v2, bool c2 ) { return ( v1 != c1 ) && ( v2 != c2 ); },
-                          computed_values );
+  std::vector<unsigned char> computed_values;
+  parallel_compute<unsigned char>( aig,
+                                   0u,
+                                   [&pattern]( unsigned index ) { return pattern[index]; },
+                                   []( unsigned char v1, bool c1, unsigned char v2, bool c2 ) { return ( ( v1 != 0u ) != c1 ) && ( ( v2 != 0u ) != c2 ); },
+                                   computed_values, settings, statistics );
 
   for ( const auto& output : aig_info( aig ).outputs )
   {
-    std::cout << "[i] " << output.second << " : " << ( computed_values[output.first.node] != output.first.complemented ) << std::endl;
+    std::cout << "[i] " << output.second << " : " << ( ( computed_values[output.first.node] != 0u ) != output.first.complemented ) << std::endl;
   }
 }
 
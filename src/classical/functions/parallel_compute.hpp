@@ -36,103 +36,132 @@
 #ifndef PARALLEL_COMPUTE_HPP
 #define PARALLEL_COMPUTE_HPP
 
-#include <condition_variable>
 #include <functional>
 #include <iostream>
-#include <mutex>
-#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
-#include <boost/graph/topological_sort.hpp>
+#include <boost/range/iterator_range.hpp>
 
+#include <core/properties.hpp>
+#include <core/utils/level_scheduler.hpp>
+#include <core/utils/timer.hpp>
 #include <classical/aig.hpp>
+#include <classical/functions/compute_levels.hpp>
 #include <classical/utils/aig_utils.hpp>
 
 namespace cirkit
 {
 
+/* The AIG is levelized and all nodes of one level are processed concurrently
+ * by a bounded work-stealing pool (see level_scheduler).  The callbacks for a
+ * node are called after the callbacks of both its children have returned.
+ *
+ * settings:
+ *   num_threads: number of threads, 0 uses the number of cores (default: 0)
+ *   chunk_size:  number of nodes processed by a thread at once (default: 256)
+ *
+ * statistics:
+ *   runtime, num_levels, num_chunks, num_steals
+ */
+
+using aig_node_range = boost::iterator_range<std::vector<aig_node>::const_iterator>;
+
+namespace detail
+{
+
+template<typename Fn>
+void parallel_levelized_run( const aig_graph& aig, Fn&& on_node,
+                             const std::function<void( const aig_node_range& )>& on_level,
+                             const properties::ptr& settings,
+                             const properties::ptr& statistics )
+{
+  /* settings */
+  const auto num_threads = get( settings, "num_threads", 0u );
+  const auto chunk_size  = get( settings, "chunk_size",  256u );
+
+  /* timer */
+  properties_timer t( statistics );
+
+  std::vector<aig_node> order;
+  std::vector<unsigned> offsets;
+  levelize_nodes_flat( aig, order, offsets );
+
+  level_scheduler scheduler( num_threads, chunk_size );
+  scheduler.run( offsets,
+                 [&order, &on_node]( unsigned i ) { on_node( order[i] ); },
+                 [&order, &offsets, &on_level]( unsigned l ) {
+                   if ( on_level )
+                   {
+                     on_level( aig_node_range( order.begin() + offsets[l], order.begin() + offsets[l + 1u] ) );
+                   }
+                 } );
+
+  set( statistics, "num_levels", static_cast<unsigned>( offsets.size() - 1u ) );
+  set( statistics, "num_chunks", scheduler.num_chunks() );
+  set( statistics, "num_steals", scheduler.num_steals() );
+}
+
+}
+
 template<typename T>
 void parallel_compute(
     const aig_graph& aig, const T& constant_result,
     const std::function<T( unsigned )>& on_input,
     const std::function<T( const T&, bool, const T&, bool )>& on_and,
-    std::vector<T>& computed_values )
+    std::vector<T>& computed_values,
+    const properties::ptr& settings = properties::ptr(),
+    const properties::ptr& statistics = properties::ptr() )
 {
-  /* topological order */
-  std::vector<aig_node> topsort( num_vertices( aig ) );
-  boost::topological_sort( aig, topsort.begin() );
+  /* nodes of the same level write concurrently to computed_values */
+  static_assert( !std::is_same<T, bool>::value, "std::vector<bool> is not thread-safe, use unsigned char instead" );
 
   const auto& info = aig_info( aig );
 
-  computed_values.resize( num_vertices( aig ) );
-  boost::dynamic_bitset<>              computed( num_vertices( aig ) );
-  std::mutex                           vector_mutex;
-  std::vector<std::thread>             workers;
-  std::vector<std::condition_variable> guards( num_vertices( aig ) );
-  std::vector<std::mutex>              guard_locks( num_vertices( aig ) );
-  computed.set( 0u );
-  computed_values[0u] = constant_result;
-
-  for ( auto n : topsort )
+  /* aig_input_index does a linear search */
+  std::vector<unsigned> input_index( num_vertices( aig ), info.inputs.size() );
+  for ( auto i = 0u; i < info.inputs.size(); ++i )
   {
-    /* primary input */
-    if ( out_degree( n, aig ) == 0u )
-    {
-      if ( n == 0u ) { continue; }
-
-      const auto index = aig_input_index( info, n );
-      workers.emplace_back( [&vector_mutex, &computed_values, &computed, n, &on_input, index, &guards, &guard_locks]() {
-          const auto v = on_input( index );
-          vector_mutex.lock();
-          computed_values[n] = v;
-          computed.set( n );
-          vector_mutex.unlock();
-
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
-    }
-    else
-    {
-      const auto children = get_children( aig, n );
-
-      workers.emplace_back( [&vector_mutex, &computed_values, &computed, n, &on_and, children, &guards, &guard_locks]() {
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[0].node] );
-            while ( !computed[children[0].node] ) { guards[children[0].node].wait( lck ); }
-          }
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[1].node] );
-            while ( !computed[children[1].node] ) { guards[children[1].node].wait( lck ); }
-          }
-
-          const auto v = on_and( computed_values[children[0].node], children[0].complemented,
-                                 computed_values[children[1].node], children[1].complemented );
-          vector_mutex.lock();
-          computed_values[n] = v;
-          computed.set( n );
-          vector_mutex.unlock();
-
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
-    }
+    input_index[info.inputs[i]] = i;
   }
 
-  for ( auto& worker : workers )
-  {
-    worker.join();
-  }
+  computed_values.resize( num_vertices( aig ) );
+  computed_values[0u] = constant_result;
+
+  detail::parallel_levelized_run( aig, [&aig, &input_index, &on_input, &on_and, &computed_values]( aig_node n ) {
+      /* primary input */
+      if ( out_degree( n, aig ) == 0u )
+      {
+        if ( n == 0u ) { return; }
+        computed_values[n] = on_input( input_index[n] );
+      }
+      else
+      {
+        auto it = out_edges( n, aig ).first;
+        const auto c1 = aig_to_function( aig, *it++ );
+        const auto c2 = aig_to_function( aig, *it );
+
+        computed_values[n] = on_and( computed_values[c1.node], c1.complemented,
+                                     computed_values[c2.node], c2.complemented );
+      }
+    }, std::function<void( const aig_node_range& )>(), settings, statistics );
 }
 
+/* on_level is called by one thread after all nodes of a level have been
+   processed and before any node of the next level is processed */
 void parallel_process(
     const aig_graph& aig,
     const std::function<void( aig_node )>& on_input,
-    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and );
+    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and,
+    const std::function<void( const aig_node_range& )>& on_level = std::function<void( const aig_node_range& )>(),
+    const properties::ptr& settings = properties::ptr(),
+    const properties::ptr& statistics = properties::ptr() );
 
 /* this is a usage demo */
-void parallel_simulate( const aig_graph& aig, const boost::dynamic_bitset<>& pattern );
+void parallel_simulate( const aig_graph& aig, const boost::dynamic_bitset<>& pattern,
+                        const properties::ptr& settings = properties::ptr(),
+                        const properties::ptr& statistics = properties::ptr() );
 
 }
 
@@ -50,6 +50,7 @@
 #include <classical/aig.hpp>
 #include <classical/utils/aig_dfs.hpp>
 #include <classical/utils/aig_utils.hpp>
+#include <classical/utils/static_truth_table.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 #include <cuddObj.hh>
@@ -539,6 +540,65 @@ std::map<aig_function, T> simulate_aig( const aig_graph& aig, const aig_simulato
   return results;
 }
 
+/******************************************************************************
+ * Cut simulation with static truth tables                                    *
+ ******************************************************************************/
+
+namespace detail
+{
+
+template<unsigned NumVars, typename LeafIt>
+static_tt<NumVars> simulate_aig_cut_rec( const aig_graph& aig, const aig_node& node, LeafIt begin, LeafIt end,
+                                         static_tt_cache<NumVars>& cache )
+{
+  const auto it = std::find( begin, end, node );
+  if ( it != end )
+  {
+    return static_tt<NumVars>::nth_var( std::distance( begin, it ) );
+  }
+
+  /* constant or input outside the cut */
+  if ( boost::out_degree( node, aig ) == 0u )
+  {
+    return static_tt<NumVars>::const0();
+  }
+
+  if ( const auto* value = cache.find( node ) )
+  {
+    return *value;
+  }
+
+  const auto& complement = boost::get( boost::edge_complement, aig );
+
+  auto value = static_tt<NumVars>::const1();
+  for ( const auto& e : boost::make_iterator_range( boost::out_edges( node, aig ) ) )
+  {
+    const auto child = simulate_aig_cut_rec<NumVars>( aig, boost::target( e, aig ), begin, end, cache );
+    value &= complement[e] ? ~child : child;
+  }
+
+  cache.insert( node, value );
+  return value;
+}
+
+}
+
+/**
+ * @brief Simulates the cone of node wrt. the cut leafs [begin, end)
+ *
+ * The i-th leaf is assigned to x_i.  Unlike simulate_aig_node with an
+ * aig_partial_node_assignment_simulator this does not allocate memory for
+ * usual cut sizes.
+ */
+template<unsigned NumVars, typename LeafIt>
+static_tt<NumVars> simulate_aig_cut( const aig_graph& aig, const aig_node& node, LeafIt begin, LeafIt end )
+{
+  assert( static_cast<unsigned>( std::distance( begin, end ) ) <= NumVars );
+
+  static_tt_cache<NumVars> cache;
+  return detail::simulate_aig_cut_rec<NumVars>( aig, node, begin, end, cache );
+}
+
 }
 
 #endif
@@ -35,7 +35,6 @@
 #include <boost/range/algorithm.hpp>
 #include <boost/range/algorithm_ext/iota.hpp>
 #include <boost/range/algorithm_ext/push_back.hpp>
-#include <boost/range/combine.hpp>
 #include <boost/range/counting_range.hpp>
 #include <boost/range/iterator_range.hpp>
 
@@ -43,8 +42,9 @@
 #include <core/utils/combinations.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/string_utils.hpp>
-#include <classical/functions/simulate_aig.hpp>
+#include <core/utils/timer.hpp>
 #include <classical/functions/aig_support.hpp>
+#include <classical/functions/bit_parallel_simulation.hpp>
 #include <classical/utils/aig_utils.hpp>
 
 using namespace boost::assign;
@@ -108,14 +108,7 @@ simulation_graph create_simulation_graph( const aig_graph& aig, const std::vecto
   }
 
   /* simulate */
-  word_assignment_simulator::aig_name_value_map map( info.inputs.size() );
-  const auto sim_vectors_t = transpose( sim_vectors );
-  for ( const auto& p : boost::combine( info.inputs, sim_vectors_t ) )
-  {
-    map.insert( {info.node_names.at( boost::get<0>( p ) ), boost::get<1>( p )} );
-  }
-
-  auto results = simulate_aig( aig, word_assignment_simulator( map ) );
+  const auto results = bit_parallel_simulate( aig, transpose( sim_vectors ) );
 
   /* prepare annotation of simvectors */
   std::vector<boost::dynamic_bitset<>> results_t;
@@ -128,7 +121,7 @@ simulation_graph create_simulation_graph( const aig_graph& aig, const std::vecto
   /* create edges */
   for ( auto j = 0u; j < m; ++j )
   {
-    const auto& ovalue = results[info.outputs[j].first];
+    const auto& ovalue = results[j];
     for ( auto i = 0u; i < sim_vectors.size(); ++i )
     {
       if ( ovalue[i] )
@@ -375,7 +368,6 @@ std::vector<simulation_signature_t::value_type> compute_simulation_signatures( c
   std::vector<unsigned> types( num_types );
   boost::iota( types, 0u );
 
-  word_assignment_simulator::aig_name_value_map map( n );
   std::vector<unsigned> partition, offset( num_types );
   const auto all_sim_vectors   = create_simulation_vectors( n, types, &partition );
   const auto all_sim_vectors_t = transpose( all_sim_vectors );
@@ -387,16 +379,10 @@ std::vector<simulation_signature_t::value_type> compute_simulation_signatures( c
     offset[i] = offset[i - 1] + partition[i - 1];
   }
 
-  for ( const auto& p : boost::combine( info.inputs, all_sim_vectors_t ) )
-  {
-    map.insert( {info.node_names.at( boost::get<0>( p ) ), boost::get<1>( p )} );
-  }
-
-  const auto results = simulate_aig( aig, word_assignment_simulator( map ) );
+  const auto results = bit_parallel_simulate( aig, all_sim_vectors_t );
 
-  for ( const auto& output : info.outputs )
+  for ( const auto& ovalue : results )
   {
-    const auto& ovalue = results.at( output.first );
     std::vector<unsigned> signature( num_types );
     for ( auto i = 0u; i < partition.size(); ++i )
     {
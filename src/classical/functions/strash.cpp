@@ -26,6 +26,7 @@
 
 #include "strash.hpp"
 
+#include <core/utils/timer.hpp>
 #include <classical/functions/simulate_aig.hpp>
 #include <classical/utils/aig_utils.hpp>
 
@@ -128,6 +129,65 @@ void strash( const aig_graph& aig,
   }
 }
 
+compact_aig strash( const compact_aig& aig,
+                    const properties::ptr& settings,
+                    const properties::ptr& statistics )
+{
+  /* settings */
+  const auto reorder = get( settings, "reorder", std::map<unsigned, unsigned>() );
+  const auto invert  = get( settings, "invert",  boost::dynamic_bitset<>( aig.num_inputs() ) );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  /* mark nodes in the transitive fanin of the outputs */
+  std::vector<unsigned char> reachable( aig.size(), 0u );
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    reachable[compact_aig::get_node( aig.output( o ) )] = 1u;
+  }
+  for ( auto n = aig.size(); n-- > 1u; )
+  {
+    if ( reachable[n] && aig.is_and( n ) )
+    {
+      reachable[compact_aig::get_node( aig.fanin0( n ) )] = 1u;
+      reachable[compact_aig::get_node( aig.fanin1( n ) )] = 1u;
+    }
+  }
+
+  compact_aig dest( aig.model_name() );
+  dest.reserve( aig.size() );
+
+  std::vector<compact_aig::literal> inputs( aig.num_inputs() );
+  for ( auto i = 0u; i < aig.num_inputs(); ++i )
+  {
+    inputs[i] = dest.create_pi( aig.input_name( i ) );
+  }
+
+  std::vector<compact_aig::literal> map( aig.size(), 0u );
+  for ( auto i = 0u; i < aig.num_inputs(); ++i )
+  {
+    const auto it = reorder.find( i );
+    map[aig.input( i )] = inputs[it == reorder.end() ? i : it->second] ^ static_cast<compact_aig::literal>( invert[i] );
+  }
+
+  const auto lit = [&map]( compact_aig::literal f ) { return map[compact_aig::get_node( f )] ^ ( f & 1u ); };
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( reachable[n] && aig.is_and( n ) )
+    {
+      map[n] = dest.create_and( lit( aig.fanin0( n ) ), lit( aig.fanin1( n ) ) );
+    }
+  }
+
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    dest.create_po( lit( aig.output( o ) ), aig.output_name( o ) );
+  }
+
+  return dest;
+}
+
 }
 
 // Local Variables:
@@ -43,6 +43,7 @@
 
 #include <core/properties.hpp>
 #include <classical/aig.hpp>
+#include <classical/compact_aig.hpp>
 #include <classical/functions/simulate_aig.hpp>
 
 namespace cirkit
@@ -77,6 +78,11 @@ void strash( const aig_graph& aig,
              const properties::ptr& settings = properties::ptr(),
              const properties::ptr& statistics = properties::ptr() );
 
+/* fast path, removes dangling nodes; supports the settings reorder and invert */
+compact_aig strash( const compact_aig& aig,
+                    const properties::ptr& settings = properties::ptr(),
+                    const properties::ptr& statistics = properties::ptr() );
+
 }
 
 #endif
@@ -27,6 +27,7 @@
 #include "read_aiger.hpp"
 
 #include <classical/utils/aig_utils.hpp>
+#include <core/utils/mapped_file.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/string_utils.hpp>
 
@@ -38,6 +39,7 @@
 #include <boost/range/counting_range.hpp>
 
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 namespace cirkit
@@ -329,110 +331,231 @@ void read_aiger( aig_graph& aig, std::string& comment, std::istream& in )
   }
 }
 
-unsigned aiger_decode( std::istream& in )
+/******************************************************************************
+ * Binary AIGER                                                               *
+ ******************************************************************************/
+
+namespace
+{
+
+/* cursor over the file contents; the reader never copies out of it */
+class aiger_binary_parser
 {
-  auto i = 0u;
-  auto res = 0u;
+public:
+  aiger_binary_parser( const char* begin, const char* end ) : p( begin ), end( end ) {}
 
-  while ( true )
+  inline bool at_end() const { return p == end; }
+
+  inline void skip_spaces()
   {
-    auto c = in.get();
-    res |= ( ( c & 0x7F ) << ( 7 * i++ ) );
-    if ( !( c & 0x80 ) ) { break; }
+    while ( p != end && *p == ' ' ) { ++p; }
   }
 
-  return res;
-}
+  unsigned read_unsigned()
+  {
+    skip_spaces();
+    if ( p == end || *p < '0' || *p > '9' ) { throw "Error: expected number in binary AIGER file"; }
 
-void read_aiger_binary( aig_graph& aig, std::istream& in, bool noopt )
-{
-  std::string line;
+    auto res = 0u;
+    while ( p != end && *p >= '0' && *p <= '9' )
+    {
+      res = 10u * res + static_cast<unsigned>( *p++ - '0' );
+    }
+    return res;
+  }
 
-  /* read header */
-  std::getline( in, line );
-  if ( in.fail() ) { throw "Error: could not read input file (check path and permissions)"; }
+  void read_newline()
+  {
+    while ( p != end && ( *p == ' ' || *p == '\r' ) ) { ++p; }
+    if ( p == end || *p++ != '\n' ) { throw "Error: expected end of line in binary AIGER file"; }
+  }
 
-  std::vector<std::string> header;
-  split_string( header, line, " " );
+  /* 7-bit varint as in the AIGER specification */
+  inline unsigned decode()
+  {
+    auto res = 0u;
+    auto shift = 0u;
+    while ( true )
+    {
+      if ( p == end ) { throw "Error: unexpected end of binary AIGER file"; }
+      const auto c = static_cast<unsigned char>( *p++ );
+      res |= static_cast<unsigned>( c & 0x7f ) << shift;
+      if ( !( c & 0x80 ) ) { return res; }
+      shift += 7u;
+    }
+  }
+
+  /* returns false at the end of the file or at the comment section */
+  bool read_symbol( char& type, unsigned& pos, const char*& name_begin, const char*& name_end )
+  {
+    while ( p != end && *p == '\n' ) { ++p; }
+    if ( p == end || *p == 'c' ) { return false; }
+
+    type = *p++;
+    pos = read_unsigned();
+    skip_spaces();
+    name_begin = p;
+    while ( p != end && *p != '\n' && *p != '\r' ) { ++p; }
+    name_end = p;
+    while ( p != end && *p != '\n' ) { ++p; }
+    return true;
+  }
+
+private:
+  const char* p;
+  const char* end;
+};
 
-  if ( header.size() != 6u || header[0u] != "aig" ) { throw "Error: expect 'aig M I L O A' as header"; }
+void read_aiger_binary( aig_graph& aig, const char* begin, const char* end, bool noopt )
+{
+  /* read header */
+  if ( end - begin < 3 || std::string( begin, 3u ) != "aig" ) { throw "Error: expect 'aig M I L O A' as header"; }
+  aiger_binary_parser parser( begin + 3, end );
 
-  if ( header[3u] != "0" ) { throw "Error: latches are not supported yet"; }
+  parser.read_unsigned();
+  const auto num_inputs  = parser.read_unsigned();
+  const auto num_latches = parser.read_unsigned();
+  const auto num_outputs = parser.read_unsigned();
+  const auto num_ands    = parser.read_unsigned();
+  parser.read_newline();
 
-  const auto num_inputs  = boost::lexical_cast<unsigned>( header[2u] );
-  const auto num_outputs = boost::lexical_cast<unsigned>( header[4u] );
-  const auto num_ands    = boost::lexical_cast<unsigned>( header[5u] );
+  if ( num_latches != 0u ) { throw "Error: latches are not supported yet"; }
 
-  /* create AIG */
+  /* create AIG, pre-sized from the header */
   aig_initialize( aig );
   auto& info = aig_info( aig );
+  const auto constant = aig_get_constant( aig, false );
+
+  aig.m_vertices.reserve( 1u + num_inputs + num_ands );
+  info.inputs.reserve( num_inputs );
+  info.outputs.reserve( num_outputs );
 
   if ( noopt )
   {
     info.enable_strashing = info.enable_local_optimization = false;
   }
+  else
+  {
+    info.strash.reserve( num_ands );
+  }
 
-  /* store nodes */
-  std::vector<aig_function> fs = {aig_get_constant( aig, false )};
-
-  /* create PIs */
-  ntimes( num_inputs, [&]() { fs.push_back( aig_create_pi( aig, "" ) ); } );
+  /* create PIs, inputs get the node indexes 1, ..., I */
+  auto& names = info.node_names;
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    const auto node = add_vertex( aig );
+    boost::get( boost::vertex_name, aig )[node] = 2u * node;
+    info.inputs.push_back( node );
+    names.emplace_hint( names.end(), node, std::string() );
+  }
 
-  /* store output addresses */
-  std::vector<unsigned> oids;
-  ntimes( num_outputs, [&]() {
-      std::getline( in, line );
-      boost::trim( line );
-      oids += boost::lexical_cast<unsigned>( line );
-    } );
+  /* store output literals */
+  std::vector<unsigned> oids( num_outputs );
+  for ( auto& oid : oids )
+  {
+    oid = parser.read_unsigned();
+    parser.read_newline();
+  }
 
-  for ( auto i : boost::counting_range( num_inputs + 1u, num_inputs + num_ands + 1u ) )
+  if ( noopt )
   {
-    const auto g  = i << 1u;
-    const auto o1 = g - aiger_decode( in );
-    const auto o2 = o1 - aiger_decode( in );
+    /* binary AIGER is topologically ordered, variable i becomes node i */
+    const auto& indexmap = boost::get( boost::vertex_name, aig );
+    const auto& complement = boost::get( boost::edge_complement, aig );
 
-    const auto f = aig_create_and( aig, make_function( fs[o1 / 2u], o1 % 2u ), make_function( fs[o2 / 2u], o2 % 2u ) );
-    assert( fs.size() == i );
-    assert( !noopt || f.node == i );
+    for ( auto i = num_inputs + 1u; i <= num_inputs + num_ands; ++i )
+    {
+      const auto g  = i << 1u;
+      const auto o1 = g - parser.decode();
+      const auto o2 = o1 - parser.decode();
 
-    fs.push_back( f );
-  }
+      if ( o1 >= g || o2 > o1 ) { throw "Error: AND gate is not in topological order"; }
 
-  for ( const auto& oid : oids )
-  {
-    aig_create_po( aig, make_function( fs[oid / 2u], oid % 2u ), "" );
-  }
+      const auto node = add_vertex( aig );
+      indexmap[node] = g;
+      complement[add_edge( node, o1 >> 1u, aig ).first] = o1 & 1u;
+      complement[add_edge( node, o2 >> 1u, aig ).first] = o2 & 1u;
+    }
 
-  while ( std::getline( in, line ) )
+    for ( const auto& oid : oids )
+    {
+      if ( ( oid >> 1u ) > num_inputs + num_ands ) { throw "Error: output literal out of range"; }
+      info.outputs.push_back( {aig_function{oid >> 1u, ( oid & 1u ) == 1u}, std::string()} );
+    }
+  }
+  else
   {
-    if ( line.size() != 0u && line[0] == 'c' ) { break; }
-    if ( line.size() == 0u || ( line[0] != 'i' && line[0] != 'o' ) ) { continue; }
+    std::vector<aig_function> fs;
+    fs.reserve( 1u + num_inputs + num_ands );
+    fs.push_back( constant );
+    for ( auto i = 0u; i < num_inputs; ++i )
+    {
+      fs.push_back( {info.inputs[i], false} );
+    }
+
+    for ( auto i = num_inputs + 1u; i <= num_inputs + num_ands; ++i )
+    {
+      const auto g  = i << 1u;
+      const auto o1 = g - parser.decode();
+      const auto o2 = o1 - parser.decode();
+
+      if ( o1 >= g || o2 > o1 ) { throw "Error: AND gate is not in topological order"; }
+
+      fs.push_back( aig_create_and( aig, fs[o1 >> 1u] ^ ( o1 & 1u ), fs[o2 >> 1u] ^ ( o2 & 1u ) ) );
+    }
 
-    std::vector<std::string> list;
-    split_string( list, line, " " );
+    for ( const auto& oid : oids )
+    {
+      if ( ( oid >> 1u ) >= fs.size() ) { throw "Error: output literal out of range"; }
+      aig_create_po( aig, fs[oid >> 1u] ^ ( oid & 1u ), std::string() );
+    }
+  }
 
-    const auto pos = boost::lexical_cast<unsigned>( list[0u].substr( 1u ) );
-    std::string name = list.size() == 1u ? "unknown" : list[1u];
+  /* symbol table: only touched if present, stops at the comment section */
+  char type;
+  unsigned pos;
+  const char* name_begin;
+  const char* name_end;
+  while ( parser.read_symbol( type, pos, name_begin, name_end ) )
+  {
+    const auto name = name_begin == name_end ? std::string( "unknown" ) : std::string( name_begin, name_end );
 
-    if ( list[0][0] == 'i' )
+    if ( type == 'i' && pos < num_inputs )
     {
-      info.node_names[info.inputs[pos]] = name;
+      names[info.inputs[pos]] = name;
     }
-    else if ( list[0][0] == 'o' )
+    else if ( type == 'o' && pos < num_outputs )
     {
       info.outputs[pos].second = name;
     }
   }
 }
 
+}
+
+void read_aiger_binary( aig_graph& aig, std::istream& in, bool noopt )
+{
+  const std::string contents( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+  if ( contents.empty() ) { throw "Error: could not read input file (check path and permissions)"; }
+
+  read_aiger_binary( aig, contents.data(), contents.data() + contents.size(), noopt );
+}
+
 void read_aiger_binary( aig_graph& aig, const std::string& filename, bool noopt )
 {
-  std::ifstream in( filename.c_str(), std::ifstream::in );
-  read_aiger_binary( aig, in, noopt );
+  mapped_file file( filename );
+
+  if ( file.good() )
+  {
+    read_aiger_binary( aig, file.data, file.data + file.size, noopt );
+  }
+  else
+  {
+    std::ifstream in( filename.c_str(), std::ifstream::in | std::ifstream::binary );
+    read_aiger_binary( aig, in, noopt );
+  }
 
   aig_info( aig ).model_name = boost::filesystem::path( filename ).stem().string();
-  in.close();
 }
 
 }
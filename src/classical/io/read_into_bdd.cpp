@@ -58,6 +58,7 @@ std::pair<bdd_manager_ptr, std::vector<bdd>> read_into_bdd( const std::string& f
 {
   /* settings */
   auto log_max_objs = get( settings, "log_max_objs", 24u );
+  auto reorder      = get( settings, "reorder", false );
 
   /* timing */
   properties_timer t( statistics );
@@ -83,6 +84,7 @@ std::pair<bdd_manager_ptr, std::vector<bdd>> read_into_bdd( const std::string& f
 
     std::vector<bdd> fs;
     cirkit_bdd_simulator sim( aig, log_max_objs );
+    sim.mgr->set_reorder_enabled( reorder );
     auto map = simulate_aig( aig, sim );
 
     for ( const auto& m : map )
@@ -0,0 +1,492 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "snapshot.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* incremented whenever the layout of a snapshot changes */
+constexpr std::uint64_t snapshot_version = 1u;
+
+inline void write_header( binary_writer& writer )
+{
+  writer.write( snapshot_version );
+}
+
+inline void read_header( binary_reader& reader )
+{
+  if ( reader.read<std::uint64_t>() != snapshot_version )
+  {
+    throw std::runtime_error( "snapshot has unsupported version" );
+  }
+}
+
+template<typename Function>
+inline std::uint64_t function_to_literal( const Function& f )
+{
+  return ( static_cast<std::uint64_t>( f.node ) << 1u ) | static_cast<std::uint64_t>( f.complemented );
+}
+
+template<typename Function>
+inline Function literal_to_function( std::uint64_t literal, std::size_t num_nodes )
+{
+  if ( ( literal >> 1u ) >= num_nodes ) { throw std::runtime_error( "snapshot refers to non-existing node" ); }
+  Function f;
+  f.node = literal >> 1u;
+  f.complemented = literal & 1u;
+  return f;
+}
+
+inline void check_node( std::uint64_t node, std::size_t num_nodes )
+{
+  if ( node >= num_nodes ) { throw std::runtime_error( "snapshot refers to non-existing node" ); }
+}
+
+/* edges in CSR form: offsets[n + 1] and literals (target << 1 | complement) in fanin order */
+template<typename Graph>
+void write_edges( binary_writer& writer, const Graph& g )
+{
+  const auto n = num_vertices( g );
+  const auto complement = boost::get( boost::edge_complement, g );
+
+  std::vector<std::uint32_t> offsets( n + 1u );
+  std::vector<std::uint32_t> literals;
+  literals.reserve( num_edges( g ) );
+
+  for ( auto v = 0u; v < n; ++v )
+  {
+    offsets[v] = literals.size();
+    for ( const auto& e : boost::make_iterator_range( out_edges( v, g ) ) )
+    {
+      literals.push_back( ( static_cast<std::uint32_t>( target( e, g ) ) << 1u ) | static_cast<std::uint32_t>( complement[e] ) );
+    }
+  }
+  offsets[n] = literals.size();
+
+  writer.write_vector( offsets );
+  writer.write_vector( literals );
+}
+
+/* g is replaced by a graph with default graph properties */
+template<typename Graph>
+void read_edges( binary_reader& reader, Graph& g )
+{
+  const auto offsets  = reader.read_array<std::uint32_t>();
+  const auto literals = reader.read_array<std::uint32_t>();
+
+  if ( offsets.empty() || offsets.back() != literals.size() )
+  {
+    throw std::runtime_error( "snapshot has corrupt edges" );
+  }
+
+  const auto n = offsets.size() - 1u;
+  Graph tmp( n );
+  g.swap( tmp );
+
+  auto complement = boost::get( boost::edge_complement, g );
+  for ( auto v = 0u; v < n; ++v )
+  {
+    if ( offsets[v] > offsets[v + 1u] ) { throw std::runtime_error( "snapshot has corrupt edges" ); }
+
+    for ( auto i = offsets[v]; i < offsets[v + 1u]; ++i )
+    {
+      check_node( literals[i] >> 1u, n );
+      complement[add_edge( v, literals[i] >> 1u, g ).first] = literals[i] & 1u;
+    }
+  }
+}
+
+template<typename Node>
+void write_node_names( binary_writer& writer, const std::map<Node, std::string>& names )
+{
+  writer.write<std::uint64_t>( names.size() );
+  for ( const auto& p : names )
+  {
+    writer.write<std::uint64_t>( p.first );
+    writer.write_string( p.second );
+  }
+}
+
+template<typename Node>
+void read_node_names( binary_reader& reader, std::map<Node, std::string>& names, std::size_t num_nodes )
+{
+  const auto count = reader.read<std::uint64_t>();
+  for ( auto i = 0u; i < count; ++i )
+  {
+    const auto node = reader.read<std::uint64_t>();
+    check_node( node, num_nodes );
+    names.emplace_hint( names.end(), node, reader.read_string() );
+  }
+}
+
+template<typename Function>
+void write_outputs( binary_writer& writer, const std::vector<std::pair<Function, std::string>>& outputs )
+{
+  writer.write<std::uint64_t>( outputs.size() );
+  for ( const auto& o : outputs )
+  {
+    writer.write( function_to_literal( o.first ) );
+    writer.write_string( o.second );
+  }
+}
+
+template<typename Function>
+void read_outputs( binary_reader& reader, std::vector<std::pair<Function, std::string>>& outputs, std::size_t num_nodes )
+{
+  const auto count = reader.read<std::uint64_t>();
+  outputs.reserve( count );
+  for ( auto i = 0u; i < count; ++i )
+  {
+    const auto f = literal_to_function<Function>( reader.read<std::uint64_t>(), num_nodes );
+    outputs.emplace_back( f, reader.read_string() );
+  }
+}
+
+template<typename Function>
+void write_functions( binary_writer& writer, const std::vector<Function>& fs )
+{
+  std::vector<std::uint64_t> literals;
+  literals.reserve( fs.size() );
+  for ( const auto& f : fs )
+  {
+    literals.push_back( function_to_literal( f ) );
+  }
+  writer.write_vector( literals );
+}
+
+template<typename Function>
+std::vector<Function> read_functions( binary_reader& reader, std::size_t num_nodes )
+{
+  std::vector<Function> fs;
+  for ( auto l : reader.read_array<std::uint64_t>() )
+  {
+    fs.push_back( literal_to_function<Function>( l, num_nodes ) );
+  }
+  return fs;
+}
+
+template<unsigned N>
+void read_strash( binary_reader& reader, strash_table<N>& strash, std::size_t num_nodes )
+{
+  const auto slots = reader.read_array<typename strash_table<N>::entry>();
+  if ( slots.empty() || ( slots.size() & ( slots.size() - 1u ) ) != 0u )
+  {
+    throw std::runtime_error( "snapshot has corrupt structural hash table" );
+  }
+  for ( const auto& slot : slots )
+  {
+    if ( slot.value == strash_table<N>::empty ) { continue; }
+
+    check_node( slot.value, num_nodes );
+    for ( auto l : slot.key )
+    {
+      check_node( l >> 1u, num_nodes );
+    }
+  }
+  strash.restore( slots.begin(), slots.end() );
+}
+
+std::vector<std::size_t> read_nodes( binary_reader& reader, std::size_t num_nodes )
+{
+  auto nodes = reader.read_vector<std::size_t>();
+  for ( auto n : nodes )
+  {
+    check_node( n, num_nodes );
+  }
+  return nodes;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void write_snapshot( binary_writer& writer, const aig_graph& aig )
+{
+  const auto& info = boost::get_property( aig, boost::graph_name );
+
+  write_header( writer );
+  const auto n = num_vertices( aig );
+
+  write_edges( writer, aig );
+
+  /* vertex properties */
+  const auto names = boost::get( boost::vertex_name, aig );
+  const auto annotations = boost::get( boost::vertex_annotation, aig );
+
+  std::vector<unsigned> vertex_names( n );
+  std::vector<std::uint64_t> annotated;
+  for ( auto v = 0u; v < n; ++v )
+  {
+    vertex_names[v] = names[v];
+    if ( !annotations[v].empty() )
+    {
+      annotated.push_back( v );
+    }
+  }
+  writer.write_vector( vertex_names );
+  writer.write_vector( annotated );
+  for ( auto v : annotated )
+  {
+    writer.write<std::uint64_t>( annotations[v].size() );
+    for ( const auto& p : annotations[v] )
+    {
+      writer.write_string( p.first );
+      writer.write_string( p.second );
+    }
+  }
+
+  /* graph info */
+  writer.write_string( info.model_name );
+  writer.write<std::uint64_t>( info.constant );
+  writer.write<std::uint8_t>( info.constant_used );
+  writer.write<std::uint8_t>( info.enable_strashing );
+  writer.write<std::uint8_t>( info.enable_local_optimization );
+  write_node_names( writer, info.node_names );
+  write_outputs( writer, info.outputs );
+  writer.write_vector( info.inputs );
+  write_functions( writer, info.cos );
+  writer.write_vector( info.cis );
+  writer.write_vector( info.strash.slots() );
+
+  std::vector<aig_function> latch;
+  for ( const auto& p : info.latch )
+  {
+    latch.push_back( p.first );
+    latch.push_back( p.second );
+  }
+  write_functions( writer, latch );
+
+  writer.write_bitset( info.unateness );
+
+  std::vector<std::uint64_t> symmetries;
+  for ( const auto& p : info.input_symmetries )
+  {
+    symmetries.push_back( p.first );
+    symmetries.push_back( p.second );
+  }
+  writer.write_vector( symmetries );
+
+  writer.write<std::uint64_t>( info.trans_words.size() );
+  for ( const auto& w : info.trans_words )
+  {
+    writer.write_vector( w );
+  }
+}
+
+void read_snapshot( binary_reader& reader, aig_graph& aig )
+{
+  read_header( reader );
+  read_edges( reader, aig );
+  const auto n = num_vertices( aig );
+
+  /* vertex properties */
+  auto names = boost::get( boost::vertex_name, aig );
+  auto annotations = boost::get( boost::vertex_annotation, aig );
+
+  const auto vertex_names = reader.read_array<unsigned>();
+  if ( vertex_names.size() != n ) { throw std::runtime_error( "snapshot has corrupt vertex names" ); }
+  for ( auto v = 0u; v < n; ++v )
+  {
+    names[v] = vertex_names[v];
+  }
+  for ( auto v : read_nodes( reader, n ) )
+  {
+    const auto count = reader.read<std::uint64_t>();
+    for ( auto i = 0u; i < count; ++i )
+    {
+      const auto key = reader.read_string();
+      annotations[v][key] = reader.read_string();
+    }
+  }
+
+  /* graph info */
+  auto& info = boost::get_property( aig, boost::graph_name );
+  info.model_name = reader.read_string();
+  info.constant = reader.read<std::uint64_t>();
+  check_node( info.constant, n );
+  info.constant_used = reader.read<std::uint8_t>();
+  info.enable_strashing = reader.read<std::uint8_t>();
+  info.enable_local_optimization = reader.read<std::uint8_t>();
+  read_node_names( reader, info.node_names, n );
+  read_outputs( reader, info.outputs, n );
+  info.inputs = read_nodes( reader, n );
+  info.cos = read_functions<aig_function>( reader, n );
+  info.cis = read_nodes( reader, n );
+
+  read_strash( reader, info.strash, n );
+
+  const auto latch = read_functions<aig_function>( reader, n );
+  for ( auto i = 0u; i + 1u < latch.size(); i += 2u )
+  {
+    info.latch[latch[i]] = latch[i + 1u];
+  }
+
+  info.unateness = reader.read_bitset();
+
+  const auto symmetries = read_nodes( reader, n );
+  for ( auto i = 0u; i + 1u < symmetries.size(); i += 2u )
+  {
+    info.input_symmetries.emplace_back( symmetries[i], symmetries[i + 1u] );
+  }
+
+  const auto num_words = reader.read<std::uint64_t>();
+  for ( auto i = 0u; i < num_words; ++i )
+  {
+    info.trans_words.push_back( read_nodes( reader, n ) );
+  }
+}
+
+void write_snapshot( binary_writer& writer, const mig_graph& mig )
+{
+  const auto& info = boost::get_property( mig, boost::graph_name );
+
+  write_header( writer );
+
+  write_edges( writer, mig );
+
+  writer.write_string( info.model_name );
+  writer.write<std::uint64_t>( info.constant );
+  writer.write<std::uint8_t>( info.constant_used );
+  write_node_names( writer, info.node_names );
+  write_outputs( writer, info.outputs );
+  writer.write_vector( info.inputs );
+  writer.write_vector( info.strash.slots() );
+}
+
+void read_snapshot( binary_reader& reader, mig_graph& mig )
+{
+  read_header( reader );
+  read_edges( reader, mig );
+  const auto n = num_vertices( mig );
+
+  auto& info = boost::get_property( mig, boost::graph_name );
+  info.model_name = reader.read_string();
+  info.constant = reader.read<std::uint64_t>();
+  check_node( info.constant, n );
+  info.constant_used = reader.read<std::uint8_t>();
+  read_node_names( reader, info.node_names, n );
+  read_outputs( reader, info.outputs, n );
+  info.inputs = read_nodes( reader, n );
+
+  read_strash( reader, info.strash, n );
+}
+
+void write_snapshot( binary_writer& writer, const xmg_graph& xmg )
+{
+  write_header( writer );
+  write_edges( writer, xmg.g );
+
+  writer.write_string( xmg._name );
+
+  std::vector<std::uint64_t> inputs;
+  for ( const auto& p : xmg._inputs )
+  {
+    inputs.push_back( p.first );
+  }
+  writer.write_vector( inputs );
+  for ( const auto& p : xmg._inputs )
+  {
+    writer.write_string( p.second );
+  }
+  write_outputs( writer, xmg._outputs );
+
+  writer.write_vector( xmg.maj_strash.slots() );
+  writer.write_vector( xmg.xor_strash.slots() );
+
+  writer.write<std::uint8_t>( xmg._native_xor );
+  writer.write<std::uint8_t>( xmg._enable_structural_hashing );
+  writer.write<std::uint8_t>( xmg._enable_inverter_propagation );
+  writer.write<std::uint32_t>( xmg._num_maj );
+  writer.write<std::uint32_t>( xmg._num_xor );
+}
+
+void read_snapshot( binary_reader& reader, xmg_graph& xmg )
+{
+  read_header( reader );
+
+  xmg = xmg_graph();
+
+  read_edges( reader, xmg.g );
+  const auto n = num_vertices( xmg.g );
+  if ( n == 0u ) { throw std::runtime_error( "snapshot has no constant node" ); }
+  xmg._complement = boost::get( boost::edge_complement, xmg.g );
+
+  xmg._name = reader.read_string();
+
+  const auto inputs = read_nodes( reader, n );
+  for ( auto node : inputs )
+  {
+    xmg._input_to_id.insert( {node, xmg._inputs.size()} );
+    xmg._inputs.emplace_back( node, reader.read_string() );
+  }
+  read_outputs( reader, xmg._outputs, n );
+
+  read_strash( reader, xmg.maj_strash, n );
+  read_strash( reader, xmg.xor_strash, n );
+
+  xmg._native_xor = reader.read<std::uint8_t>();
+  xmg._enable_structural_hashing = reader.read<std::uint8_t>();
+  xmg._enable_inverter_propagation = reader.read<std::uint8_t>();
+  xmg._num_maj = reader.read<std::uint32_t>();
+  xmg._num_xor = reader.read<std::uint32_t>();
+
+  xmg.mark_as_modified();
+}
+
+void write_snapshot( binary_writer& writer, const tt& t )
+{
+  write_header( writer );
+  writer.write_bitset( t );
+}
+
+void read_snapshot( binary_reader& reader, tt& t )
+{
+  read_header( reader );
+  t = reader.read_bitset();
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
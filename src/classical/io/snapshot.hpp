@@ -0,0 +1,75 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file snapshot.hpp
+ *
+ * @brief Binary snapshots of logic networks
+ *
+ * Node and edge arrays as well as the structural hash tables are written
+ * raw, such that reading a snapshot neither parses nor strashes.  The format
+ * is meant for saving and restoring sessions of the same build.  Each
+ * snapshot starts with a version word, snapshots of other versions are
+ * rejected with std::runtime_error.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <core/utils/binary_io.hpp>
+#include <classical/aig.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg.hpp>
+
+namespace cirkit
+{
+
+void write_snapshot( binary_writer& writer, const aig_graph& aig );
+void read_snapshot( binary_reader& reader, aig_graph& aig );
+
+void write_snapshot( binary_writer& writer, const mig_graph& mig );
+void read_snapshot( binary_reader& reader, mig_graph& mig );
+
+/* the cover and reference counts are not part of the snapshot */
+void write_snapshot( binary_writer& writer, const xmg_graph& xmg );
+void read_snapshot( binary_reader& reader, xmg_graph& xmg );
+
+void write_snapshot( binary_writer& writer, const tt& t );
+void read_snapshot( binary_reader& reader, tt& t );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -27,13 +27,108 @@
 #include "write_aiger.hpp"
 
 #include <boost/format.hpp>
+#include <boost/graph/topological_sort.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include <algorithm>
 #include <fstream>
+#include <string>
+#include <vector>
 
 namespace cirkit
 {
 
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace
+{
+
+/* collects output in a fixed buffer and hands it to the stream in large blocks */
+class aiger_binary_writer
+{
+public:
+  explicit aiger_binary_writer( std::ostream& os, std::size_t buffer_size = 1u << 20u )
+    : os( os ), buffer( buffer_size ), pos( 0u )
+  {
+  }
+
+  ~aiger_binary_writer()
+  {
+    flush();
+  }
+
+  inline void put( char c )
+  {
+    if ( pos == buffer.size() ) { flush(); }
+    buffer[pos++] = c;
+  }
+
+  void put( const std::string& str )
+  {
+    for ( auto c : str ) { put( c ); }
+  }
+
+  void put_unsigned( unsigned value )
+  {
+    char digits[10];
+    auto n = 0u;
+    do
+    {
+      digits[n++] = '0' + ( value % 10u );
+      value /= 10u;
+    } while ( value );
+
+    while ( n ) { put( digits[--n] ); }
+  }
+
+  /* 7-bit varint as in the AIGER specification */
+  inline void encode( unsigned value )
+  {
+    while ( value & ~0x7fu )
+    {
+      put( static_cast<char>( ( value & 0x7fu ) | 0x80u ) );
+      value >>= 7u;
+    }
+    put( static_cast<char>( value ) );
+  }
+
+  void put_and( unsigned lhs, unsigned rhs0, unsigned rhs1 )
+  {
+    if ( rhs0 < rhs1 ) { std::swap( rhs0, rhs1 ); }
+    assert( lhs > rhs0 );
+    encode( lhs - rhs0 );
+    encode( rhs0 - rhs1 );
+  }
+
+  void put_symbol( char type, unsigned index, const std::string& name )
+  {
+    put( type );
+    put_unsigned( index );
+    put( ' ' );
+    put( name );
+    put( '\n' );
+  }
+
+  void flush()
+  {
+    os.write( buffer.data(), pos );
+    pos = 0u;
+  }
+
+private:
+  std::ostream&     os;
+  std::vector<char> buffer;
+  std::size_t       pos;
+};
+
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
 void write_aiger( const aig_graph& aig, std::ostream& os, const bool fill_sym_table )
 {
   assert( num_vertices( aig ) != 0u && "Uninitialized AIG" );
@@ -148,6 +243,270 @@ void write_aiger( const aig_graph& aig, const std::string& filename, const bool
   fb.close();
 }
 
+void write_aiger( const compact_aig& aig, std::ostream& os, const bool fill_sym_table )
+{
+  /* inputs are numbered first, AND gates keep their relative order */
+  std::vector<unsigned> index( aig.size(), 0u );
+  auto next = 1u;
+  for ( auto i = 0u; i < aig.num_inputs(); ++i )
+  {
+    index[aig.input( i )] = next++;
+  }
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( aig.is_and( n ) ) { index[n] = next++; }
+  }
+
+  const auto lit = [&index]( compact_aig::literal f ) {
+    return 2u * index[compact_aig::get_node( f )] + static_cast<unsigned>( compact_aig::is_complemented( f ) );
+  };
+
+  os << boost::format( "aag %d %d 0 %d %d" ) % ( next - 1u ) % aig.num_inputs() % aig.num_outputs() % aig.num_gates() << std::endl;
+
+  /* lines are formatted without boost::format */
+  std::string line;
+  for ( auto i = 0u; i < aig.num_inputs(); ++i )
+  {
+    os << 2u * ( i + 1u ) << '\n';
+  }
+
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    os << lit( aig.output( o ) ) << '\n';
+  }
+
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( !aig.is_and( n ) ) { continue; }
+
+    line = std::to_string( 2u * index[n] );
+    line += ' ';
+    line += std::to_string( lit( aig.fanin0( n ) ) );
+    line += ' ';
+    line += std::to_string( lit( aig.fanin1( n ) ) );
+    line += '\n';
+    os << line;
+  }
+
+  for ( auto i = 0u; i < aig.num_inputs(); ++i )
+  {
+    const auto& name = aig.input_name( i );
+    if ( !name.empty() )
+    {
+      os << "i" << i << " " << name << '\n';
+    }
+    else if ( fill_sym_table )
+    {
+      os << "i" << i << " input" << i << '\n';
+    }
+  }
+
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    const auto& name = aig.output_name( o );
+    if ( !name.empty() )
+    {
+      os << "o" << o << " " << name << '\n';
+    }
+    else if ( fill_sym_table )
+    {
+      os << "o" << o << " output" << o << '\n';
+    }
+  }
+
+  os.flush();
+}
+
+void write_aiger( const compact_aig& aig, const std::string& filename, const bool fill_sym_table )
+{
+  std::filebuf fb;
+  fb.open( filename.c_str(), std::ios::out );
+  std::ostream os( &fb );
+  write_aiger( aig, os, fill_sym_table );
+  fb.close();
+}
+
+void write_aiger_binary( const aig_graph& aig, std::ostream& os, const bool fill_sym_table )
+{
+  assert( num_vertices( aig ) != 0u && "Uninitialized AIG" );
+
+  const auto& info = boost::get_property( aig, boost::graph_name );
+  const auto& complementmap = boost::get( boost::edge_complement, aig );
+  assert( info.cis.empty() && "latches are not supported in binary AIGER writer" );
+
+  /* inputs first, then AND gates in topological order; vertex order is used
+     when it is topological, which is the case for AIGs built bottom-up */
+  std::vector<unsigned> index( num_vertices( aig ), 0u );
+  auto next = 1u;
+  for ( const auto& input : info.inputs )
+  {
+    index[input] = next++;
+  }
+
+  auto in_order = true;
+  for ( const auto& e : boost::make_iterator_range( edges( aig ) ) )
+  {
+    if ( target( e, aig ) >= source( e, aig ) ) { in_order = false; break; }
+  }
+
+  std::vector<aig_node> gates;
+  gates.reserve( num_vertices( aig ) - info.inputs.size() );
+  const auto add_gate = [&]( aig_node n ) {
+    if ( out_degree( n, aig ) == 0u ) { return; }
+    assert( out_degree( n, aig ) == 2u );
+    index[n] = next++;
+    gates.push_back( n );
+  };
+
+  if ( in_order )
+  {
+    for ( const auto& n : boost::make_iterator_range( vertices( aig ) ) ) { add_gate( n ); }
+  }
+  else
+  {
+    std::vector<aig_node> topsort( num_vertices( aig ) );
+    boost::topological_sort( aig, topsort.begin() );
+    for ( const auto& n : topsort ) { add_gate( n ); }
+  }
+
+  const auto lit = [&index]( const aig_function& f ) {
+    return 2u * index[f.node] + static_cast<unsigned>( f.complemented );
+  };
+
+  aiger_binary_writer writer( os );
+
+  writer.put( "aig " );
+  writer.put_unsigned( next - 1u ); writer.put( ' ' );
+  writer.put_unsigned( info.inputs.size() ); writer.put( " 0 " );
+  writer.put_unsigned( info.outputs.size() ); writer.put( ' ' );
+  writer.put_unsigned( gates.size() ); writer.put( '\n' );
+
+  for ( const auto& output : info.outputs )
+  {
+    writer.put_unsigned( lit( output.first ) );
+    writer.put( '\n' );
+  }
+
+  for ( const auto& n : gates )
+  {
+    auto it = out_edges( n, aig ).first;
+    const auto l0 = lit( {target( *it, aig ), complementmap[*it]} ); ++it;
+    const auto l1 = lit( {target( *it, aig ), complementmap[*it]} );
+    writer.put_and( 2u * index[n], l0, l1 );
+  }
+
+  for ( auto i = 0u; i < info.inputs.size(); ++i )
+  {
+    const auto it = info.node_names.find( info.inputs[i] );
+    if ( it != info.node_names.end() && !it->second.empty() )
+    {
+      writer.put_symbol( 'i', i, it->second );
+    }
+    else if ( fill_sym_table )
+    {
+      writer.put_symbol( 'i', i, "input" + std::to_string( i ) );
+    }
+  }
+
+  for ( auto o = 0u; o < info.outputs.size(); ++o )
+  {
+    const auto& name = info.outputs[o].second;
+    if ( !name.empty() )
+    {
+      writer.put_symbol( 'o', o, name );
+    }
+    else if ( fill_sym_table )
+    {
+      writer.put_symbol( 'o', o, "output" + std::to_string( o ) );
+    }
+  }
+}
+
+void write_aiger_binary( const aig_graph& aig, const std::string& filename, const bool fill_sym_table )
+{
+  std::filebuf fb;
+  fb.open( filename.c_str(), std::ios::out | std::ios::binary );
+  std::ostream os( &fb );
+  write_aiger_binary( aig, os, fill_sym_table );
+  os.flush();
+  fb.close();
+}
+
+void write_aiger_binary( const compact_aig& aig, std::ostream& os, const bool fill_sym_table )
+{
+  /* compact AIGs are topologically ordered, only inputs are moved to the front */
+  std::vector<unsigned> index( aig.size(), 0u );
+  auto next = 1u;
+  for ( auto i = 0u; i < aig.num_inputs(); ++i )
+  {
+    index[aig.input( i )] = next++;
+  }
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( aig.is_and( n ) ) { index[n] = next++; }
+  }
+
+  const auto lit = [&index]( compact_aig::literal f ) {
+    return 2u * index[compact_aig::get_node( f )] + static_cast<unsigned>( compact_aig::is_complemented( f ) );
+  };
+
+  aiger_binary_writer writer( os );
+
+  writer.put( "aig " );
+  writer.put_unsigned( next - 1u ); writer.put( ' ' );
+  writer.put_unsigned( aig.num_inputs() ); writer.put( " 0 " );
+  writer.put_unsigned( aig.num_outputs() ); writer.put( ' ' );
+  writer.put_unsigned( aig.num_gates() ); writer.put( '\n' );
+
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    writer.put_unsigned( lit( aig.output( o ) ) );
+    writer.put( '\n' );
+  }
+
+  for ( auto n = 1u; n < aig.size(); ++n )
+  {
+    if ( !aig.is_and( n ) ) { continue; }
+    writer.put_and( 2u * index[n], lit( aig.fanin0( n ) ), lit( aig.fanin1( n ) ) );
+  }
+
+  for ( auto i = 0u; i < aig.num_inputs(); ++i )
+  {
+    const auto& name = aig.input_name( i );
+    if ( !name.empty() )
+    {
+      writer.put_symbol( 'i', i, name );
+    }
+    else if ( fill_sym_table )
+    {
+      writer.put_symbol( 'i', i, "input" + std::to_string( i ) );
+    }
+  }
+
+  for ( auto o = 0u; o < aig.num_outputs(); ++o )
+  {
+    const auto& name = aig.output_name( o );
+    if ( !name.empty() )
+    {
+      writer.put_symbol( 'o', o, name );
+    }
+    else if ( fill_sym_table )
+    {
+      writer.put_symbol( 'o', o, "output" + std::to_string( o ) );
+    }
+  }
+}
+
+void write_aiger_binary( const compact_aig& aig, const std::string& filename, const bool fill_sym_table )
+{
+  std::filebuf fb;
+  fb.open( filename.c_str(), std::ios::out | std::ios::binary );
+  std::ostream os( &fb );
+  write_aiger_binary( aig, os, fill_sym_table );
+  os.flush();
+  fb.close();
+}
+
 }
 
 // Local Variables:
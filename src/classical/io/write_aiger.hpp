@@ -38,6 +38,7 @@
 #define WRITE_AIGER_HPP
 
 #include <classical/aig.hpp>
+#include <classical/compact_aig.hpp>
 
 #include <iostream>
 #include <string>
@@ -48,6 +49,16 @@ namespace cirkit
 void write_aiger( const aig_graph& aig, std::ostream& os, const bool fill_sym_table = false );
 void write_aiger( const aig_graph& aig, const std::string& filename, const bool fill_sym_table = false );
 
+void write_aiger( const compact_aig& aig, std::ostream& os, const bool fill_sym_table = false );
+void write_aiger( const compact_aig& aig, const std::string& filename, const bool fill_sym_table = false );
+
+/* binary AIGER, combinational AIGs only; output is buffered and flushed in large blocks */
+void write_aiger_binary( const aig_graph& aig, std::ostream& os, const bool fill_sym_table = false );
+void write_aiger_binary( const aig_graph& aig, const std::string& filename, const bool fill_sym_table = false );
+
+void write_aiger_binary( const compact_aig& aig, std::ostream& os, const bool fill_sym_table = false );
+void write_aiger_binary( const compact_aig& aig, const std::string& filename, const bool fill_sym_table = false );
+
 }
 
 #endif
@@ -147,6 +147,12 @@ void mig_initialize( mig_graph& mig, const std::string& model_name )
   assert( info.constant == 0u );
 }
 
+void mig_reserve( mig_graph& mig, std::size_t num_nodes )
+{
+  mig.m_vertices.reserve( num_nodes );
+  boost::get_property( mig, boost::graph_name ).strash.reserve( num_nodes );
+}
+
 mig_function mig_get_constant( mig_graph& mig, bool value )
 {
   assert( num_vertices( mig ) != 0u && "Uninitialized MIG" );
@@ -203,12 +209,14 @@ mig_function mig_create_maj( mig_graph& mig, const mig_function& a, const mig_fu
   mig_function children[] = {a, b, c};
   std::sort( children, children + 3 );
 
-  const auto key = std::make_tuple( children[0], children[1], children[2] );
+  const strash_table<3u>::key_t key = {{strash_table<3u>::make_literal( children[0].node, children[0].complemented ),
+                                         strash_table<3u>::make_literal( children[1].node, children[1].complemented ),
+                                         strash_table<3u>::make_literal( children[2].node, children[2].complemented )}};
 
-  const auto it = info.strash.find( key );
-  if ( it != info.strash.end() )
+  const auto existing = info.strash.find( key );
+  if ( existing != strash_table<3u>::empty )
   {
-    return it->second;
+    return { static_cast<mig_node>( existing ), false };
   }
 
   mig_node node = add_vertex( mig );
@@ -224,7 +232,8 @@ mig_function mig_create_maj( mig_graph& mig, const mig_function& a, const mig_fu
   complement[eb] = children[1].complemented;
   complement[ec] = children[2].complemented;
 
-  return info.strash[key] = { node, false };
+  info.strash.insert( key, node );
+  return { node, false };
 }
 
 mig_function mig_create_and( mig_graph& mig, const mig_function& a, const mig_function& b )
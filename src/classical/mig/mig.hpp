@@ -38,6 +38,7 @@
 
 #include <core/properties.hpp>
 #include <core/utils/graph_utils.hpp>
+#include <core/utils/strash_table.hpp>
 #include <classical/traits.hpp>
 
 namespace cirkit
@@ -82,7 +83,7 @@ struct mig_graph_info
   std::map<detail::mig_traits_t::vertex_descriptor, std::string>               node_names;
   std::vector<std::pair<mig_function, std::string> >                           outputs;
   std::vector<detail::mig_traits_t::vertex_descriptor>                         inputs;
-  std::map<std::tuple<mig_function, mig_function, mig_function>, mig_function> strash;
+  strash_table<3u>                                                             strash;
 };
 
 namespace detail
@@ -100,6 +101,7 @@ using mig_node = vertex_t<mig_graph>;
 using mig_edge = edge_t<mig_graph>;
 
 void mig_initialize( mig_graph& mig, const std::string& model_name = std::string() );
+void mig_reserve( mig_graph& mig, std::size_t num_nodes );
 mig_function mig_get_constant( mig_graph& mig, bool value );
 bool mig_is_constant_used( const mig_graph& mig );
 mig_function mig_create_pi( mig_graph& mig, const std::string& name );
@@ -51,6 +51,7 @@
 #include <classical/mig/mig_functional_hashing_constants.hpp>
 #include <classical/utils/cut_enumeration.hpp>
 #include <classical/utils/cut_enumeration_traits.hpp>
+#include <classical/utils/npn_cache.hpp>
 #include <classical/mig/mig_utils.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
@@ -161,24 +162,10 @@ void add_candidate( candidate_vec_t& vec, const candidate_t& c, unsigned max_siz
   }
 }
 
-struct npn_hash_table_entry_t
-{
-  npn_hash_table_entry_t() {}
-  npn_hash_table_entry_t( int tt, int npn, const std::vector<unsigned>& perm, const boost::dynamic_bitset<>& phase )
-    : tt( tt ), npn( npn ), perm( perm ), phase( phase ) {}
-
-  int                     tt  = -1;
-  int                     npn = -1;
-  std::vector<unsigned>   perm;
-  boost::dynamic_bitset<> phase;
-};
-
-using npn_hash_table_t = std::vector<npn_hash_table_entry_t>;
-
 class mig_functional_hashing_manager
 {
 public:
-  mig_functional_hashing_manager( const mig_graph& mig, bool use_ffrs, bool top_down, unsigned npn_hash_table_size, bool verbose );
+  mig_functional_hashing_manager( const mig_graph& mig, bool use_ffrs, bool top_down, unsigned npn_hash_table_size, bool shared_cache, bool verbose );
 
   void run();
 
@@ -221,7 +208,7 @@ public:
   std::map<mig_node, mig_edge_vec_t> ingoing;
   std::vector<unsigned>              depths;
   unsigned                           max_depth;
-  npn_hash_table_t                   npn_table;
+  npn_cache::ptr                     npn_classes;
   bool                               progress;
   bool                               depth_heuristic;
   unsigned                           max_candidates = 10u;
@@ -241,16 +228,18 @@ public:
  * Private functions                                                          *
  ******************************************************************************/
 
-mig_functional_hashing_manager::mig_functional_hashing_manager( const mig_graph& mig, bool use_ffrs, bool top_down, unsigned npn_hash_table_size, bool verbose )
+mig_functional_hashing_manager::mig_functional_hashing_manager( const mig_graph& mig, bool use_ffrs, bool top_down, unsigned npn_hash_table_size, bool shared_cache, bool verbose )
   : mig( mig ),
     info( mig_info( mig ) ),
     use_ffrs( use_ffrs ),
     top_down( top_down ),
     topsort( boost::num_vertices( mig ) ),
-    npn_table( npn_hash_table_size ),
+    npn_classes( shared_cache ? shared_npn_cache( "exact" ) :
+                 npn_hash_table_size > 0u ? std::make_shared<npn_cache>( npn_cache::log_capacity_for( npn_hash_table_size ) ) : npn_cache::ptr() ),
     verbose( verbose )
 {
   mig_initialize( mig_new, info.model_name );
+  mig_reserve( mig_new, boost::num_vertices( mig ) );
 
   auto& info_new = mig_info( mig_new );
   info_new.constant_used = info.constant_used;
@@ -543,36 +532,22 @@ tt mig_functional_hashing_manager::compute_npn( const tt& tt, boost::dynamic_bit
 {
   boost::dynamic_bitset<> npn;
 
-  /* compute NPN and use hash table if possible */
-  if ( !npn_table.empty() )
+  /* compute NPN and use cache if possible */
+  if ( npn_classes && npn_classes->lookup( tt, npn, phase, perm ) )
   {
-    const auto ttu      = tt.to_ulong();
-    const auto hash_key = ttu % npn_table.size();
-    auto& entry   = npn_table[hash_key];
-
-    if ( static_cast<unsigned long>( entry.tt ) == ttu )
-    {
-      ++cache_hit;
-      npn = boost::dynamic_bitset<>( 16u, entry.npn );
-      perm = std::vector<unsigned>( entry.perm );
-      phase = boost::dynamic_bitset<>( entry.phase );
-    }
-    else
-    {
-      ++cache_miss;
-      increment_timer t( &runtime_npn );
-      npn = exact_npn_canonization( tt, phase, perm );
-
-      entry.tt    = ttu;
-      entry.npn   = npn.to_ulong();
-      entry.perm  = perm;
-      entry.phase = phase;
-    }
+    ++cache_hit;
+    return npn;
   }
-  else
+
+  ++cache_miss;
   {
     increment_timer t( &runtime_npn );
-    npn = exact_npn_canonization( tt, phase, perm );
+    npn = from_static_tt( exact_npn_canonization( to_static_tt<4u>( tt ), phase, perm ) );
+  }
+
+  if ( npn_classes )
+  {
+    npn_classes->insert( tt, npn, phase, perm );
   }
 
   return npn;
@@ -864,6 +839,7 @@ mig_graph mig_functional_hashing( const mig_graph& mig,
   const auto use_ffrs            = get( settings, "use_ffrs",            true );
   const auto depth_heuristic     = get( settings, "depth_heuristic",     false );
   const auto npn_hash_table_size = get( settings, "npn_hash_table_size", 0u );
+  const auto use_npn_cache       = get( settings, "npn_cache",           false );
   const auto progress            = get( settings, "progress",            false );
   const auto max_candidates      = get( settings, "max_candidates",      10u );
   const auto allow_area_inc      = get( settings, "allow_area_inc",      false );
@@ -875,7 +851,7 @@ mig_graph mig_functional_hashing( const mig_graph& mig,
   properties_timer t( statistics );
 
   /* new graph */
-  mig_functional_hashing_manager mgr( mig, use_ffrs, top_down, npn_hash_table_size, verbose );
+  mig_functional_hashing_manager mgr( mig, use_ffrs, top_down, npn_hash_table_size, use_npn_cache, verbose );
   mgr.depth_heuristic = depth_heuristic;
   mgr.progress        = progress;
   mgr.max_candidates  = max_candidates;
@@ -885,6 +861,11 @@ mig_graph mig_functional_hashing( const mig_graph& mig,
 
   mgr.run();
 
+  if ( use_npn_cache )
+  {
+    mgr.npn_classes->persist();
+  }
+
   set( statistics, "runtime_ffr", mgr.runtime_ffr );
   set( statistics, "runtime_cut", mgr.runtime_cut );
   set( statistics, "runtime_npn", mgr.runtime_npn );
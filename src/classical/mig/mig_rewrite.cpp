@@ -99,6 +99,7 @@ mig_graph mig_rewrite_top_down( const mig_graph& mig,
 
   mig_graph mig_new;
   mig_initialize( mig_new, mig_info( mig ).model_name );
+  mig_reserve( mig_new, boost::num_vertices( mig ) );
 
   /* create constant and PIs */
   auto old_to_new = init_visited_table( mig, mig_new );
@@ -128,6 +129,7 @@ mig_graph mig_rewrite_bottom_up( const mig_graph& mig,
 
   mig_graph mig_new;
   mig_initialize( mig_new, mig_info( mig ).model_name );
+  mig_reserve( mig_new, boost::num_vertices( mig ) );
 
   /* create constant and PIs */
   auto old_to_new = init_visited_table( mig, mig_new );
@@ -32,6 +32,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
@@ -71,6 +72,10 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+/* EXORCISM keeps the cover in global variables, calls from several threads
+   must be serialized */
+static std::mutex exorcism_mutex;
+
 class exorcism_processor : public pla_processor
 {
 public:
@@ -497,6 +502,8 @@ gia_graph::esop_ptr exorcism_minimization( const gia_graph::esop_ptr& esop, unsi
 
   properties_timer t( statistics );
 
+  std::lock_guard<std::mutex> lock( exorcism_mutex );
+
   /* initialize */
   memset( &abc::g_CoverInfo, 0, sizeof( abc::cinfo ) );
   abc::g_CoverInfo.Quality = static_cast<int>( quality );
@@ -27,10 +27,11 @@
 #include "exorcismq.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <fstream>
-#include <queue>
+#include <memory>
 #include <random>
 #include <string>
 #include <vector>
@@ -38,6 +39,7 @@
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <core/packed_cover.hpp>
 #include <core/utils/string_utils.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/abc/abc_api.hpp>
@@ -59,106 +61,37 @@ namespace cirkit
 /******************************************************************************
  * exorcismq_cube                                                             *
  * -------------------------------------------------------------------------- *
- * contains one cube                                                          *
+ * a cube outside of the cover, e.g., an EXORLINK result                      *
  *                                                                            *
  * variables                                                                  *
- * - bits    : 32-bits to store literals                                      *
- * - mask    : 32-bits care set                                               *
+ * - bits    : polarity plane (points into a scratch buffer)                  *
+ * - mask    : care plane (points into a scratch buffer)                      *
  * - cost    : T-count cost of the cube                                       *
- * - invalid : if 1, cube is invalidated and not in cover                     *
- *                                                                            *
- * methods                                                                    *
- * - num_literals()                                                           *
- *     number of literals                                                     *
- * - positions( that )                                                        *
- *     number of different positions between this and that                    *
- * - exorlink( that, distance, pos, group )                                   *
- *     performs exorlink of this and that given distance and different        *
- *     positions pos in given group                                           *
- * - print( os, n )                                                           *
- *     prints cube to os assuming a width of n                                *
+ * - invalid : if 1, cube cancels with a cube in the cover                    *
  *                                                                            *
  * notes                                                                      *
- * - cube does not store its size, it has to be known from the algorithms     *
- *   that uses the cubes, e.g., the store in which they are stored.           *
- *   Typically all cubes have the same size and there is no need to store it  *
- *   in every cube.                                                           *
+ * - cubes in the cover are stored in a packed_cover and referred to by id;   *
+ *   planes have packed_cover::num_words() words, so the number of variables  *
+ *   is not restricted to a machine word.                                     *
  ******************************************************************************/
 
+using word_t = packed_cover::word_t;
+
 struct exorcismq_cube
 {
-  uint32_t bits = 0;
-  uint32_t mask = 0;
+  word_t*  bits = nullptr;
+  word_t*  mask = nullptr;
   uint64_t cost = 0;
   uint64_t invalid = 0;
-
-  inline uint32_t num_literals() const
-  {
-    return __builtin_popcount( mask );
-  }
-
-  inline uint32_t positions( const exorcismq_cube& that ) const
-  {
-    return ( bits ^ that.bits ) | ( mask ^ that.mask );
-  }
-
-  inline std::array<exorcismq_cube, 4> exorlink( const exorcismq_cube& that, int distance, uint32_t pos, unsigned* group ) const
-  {
-    uint32_t tbits, tmask;
-    uint32_t tpos;
-
-    std::array<exorcismq_cube, 4> res;
-
-    const auto cbits = ~bits & ~that.bits;
-    const auto cmask = mask ^ that.mask;
-
-    for ( int i = 0; i < distance; ++i )
-    {
-      tbits = bits;
-      tmask = mask;
-      tpos  = pos;
-
-      for ( int j = 0; j < distance; ++j )
-      {
-        /* compute position */
-        const uint64_t p = tpos & -tpos;
-        tpos &= tpos - 1;
-
-        switch ( *group++ )
-        {
-          case 0:
-            /* take from this */
-            break;
-          case 1:
-            /* take from that */
-            tbits ^= ( ( that.bits & p ) ^ tbits ) & p;
-            tmask ^= ( ( that.mask & p ) ^ tmask ) & p;
-            break;
-          case 2:
-            /* take other */
-            tbits ^= ( ( cbits & p ) ^ tbits ) & p;
-            tmask ^= ( ( cmask & p ) ^ tmask ) & p;
-            break;
-        }
-      }
-
-      res[i].bits = tbits;
-      res[i].mask = tmask;
-    }
-
-    return res;
-  }
-
-  std::ostream& print( std::ostream& os, unsigned n ) const
-  {
-    for ( auto i = 0u; i < n; ++i )
-    {
-      os << ( ( ( mask >> i ) & 1 ) ? ( ( ( bits >> i ) & 1 ) ? '1' : '0' ) : '-' );
-    }
-    return os;
-  }
 };
 
+/* sets position p of (bits, mask) to the XOR of the literals of c1 and c2 at p */
+inline void exorcismq_combine( word_t* bits, word_t* mask, const word_t* b1, const word_t* m1, const word_t* b2, const word_t* m2, unsigned p )
+{
+  packed_cover::set_bit( bits, p, !packed_cover::get_bit( b1, p ) && !packed_cover::get_bit( b2, p ) );
+  packed_cover::set_bit( mask, p, packed_cover::get_bit( m1, p ) != packed_cover::get_bit( m2, p ) );
+}
+
 unsigned tcount( unsigned c, unsigned n )
 {
   switch ( c )
@@ -196,18 +129,17 @@ unsigned tcount( unsigned c, unsigned n )
  * - invalidate_cube                                                          *
  * - shuffle_pairs                                                            *
  *                                                                            *
- *                                                                            *
- *                                                                            *
- *                                                                            *
- *                                                                            *
+ * notes                                                                      *
+ * - distance-0 and distance-1 lookups as well as pair candidates are found   *
+ *   through the segment buckets of packed_cover instead of linear scans      *
  ******************************************************************************/
 
 class exorcismq_cube_store
 {
 public:
-  using cube_vec_t = std::vector<exorcismq_cube>;
-  using size_type  = cube_vec_t::size_type;
-  using exorcismq_cube_pair = std::tuple<unsigned, unsigned, uint64_t, uint32_t>; /* index 1, index 2, cost of pair, pos of pair */
+  using size_type  = packed_cover::cube_id;
+  using positions_t = std::array<unsigned, 4u>;
+  using exorcismq_cube_pair = std::tuple<unsigned, unsigned, uint64_t, positions_t>; /* index 1, index 2, cost of pair, positions of pair */
 
   struct exorcismq_cube_pair_sort_by_first_id
   {
@@ -243,50 +175,66 @@ public:
     return n;
   }
 
+  inline unsigned numwords() const
+  {
+    return cover->num_words();
+  }
+
   inline void set_numvars( unsigned _n )
   {
     n = _n;
+    cover.reset( new packed_cover( n ) );
   }
 
-  void add_cube( exorcismq_cube& cube )
+  void add_cube( const std::string& scube )
   {
-    cube.cost = tcount( cube.num_literals(), n );
+    std::vector<word_t> planes( 2u * numwords(), 0u );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      if ( scube[i] != '-' )
+      {
+        packed_cover::set_bit( &planes[numwords()], i, true );
+        packed_cover::set_bit( &planes[0u], i, scube[i] == '1' );
+      }
+    }
+    add_cube( &planes[0u], &planes[numwords()] );
+  }
 
-    cube_vec_t::const_iterator it;
+  void add_cube( const word_t* bits, const word_t* mask )
+  {
+    size_type id;
     bool equal;
 
-    std::tie( it, equal ) = has_cube( cube );
-    if ( it != cubes.end() )
+    std::tie( id, equal ) = has_cube( bits, mask );
+    if ( id != packed_cover::npos )
     {
       if ( equal )
       {
-        invalidate_cube( std::distance<cube_vec_t::const_iterator>( cubes.begin(), it ) );
+        invalidate_cube( id );
       }
       else /* distance 1 cube */
       {
-        auto other = *it;
-        invalidate_cube( std::distance<cube_vec_t::const_iterator>( cubes.begin(), it ) );
+        const auto nw = numwords();
+        std::vector<word_t> other( cover->bits( id ), cover->bits( id ) + 2u * nw );
 
-        assert( !other.invalid );
-        const auto cbits = ~cube.bits & ~other.bits;
-        const auto cmask = cube.mask ^ other.mask;
-        const auto p = cube.positions( other );
+        unsigned p;
+        const auto d = distance_positions( bits, mask, cover->bits( id ), cover->mask( id ), &p, 1u );
+        assert( d == 1u ); (void)d;
 
-        other.bits ^= ( ( cbits & p ) ^ other.bits ) & p;
-        other.mask ^= ( ( cmask & p ) ^ other.mask ) & p;
+        exorcismq_combine( &other[0u], &other[nw], bits, mask, cover->bits( id ), cover->mask( id ), p );
+        invalidate_cube( id );
 
-        add_cube( other );
+        add_cube( &other[0u], &other[nw] );
       }
     }
-    else if ( !free_ids.empty() )
-    {
-      const auto id = free_ids.front();
-      free_ids.pop();
-      cubes[id] = cube;
-    }
     else
     {
-      cubes.push_back( cube );
+      const auto id = cover->add( bits, mask );
+      if ( id >= costs.size() )
+      {
+        costs.resize( id + 1u );
+      }
+      costs[id] = tcount( cover->num_literals( id ), n );
     }
   }
 
@@ -297,18 +245,14 @@ public:
     /* clear pair cubes */
     for ( auto& p : cube_pairs )
     {
-      p.clear(); // = exorcismq_cube_pair_queue();
+      p.clear();
     }
 
     /* generate pairs for each cube */
-    for ( size_type i = 0; i < cubes.size(); ++i )
-    {
-      if ( !cubes[i].invalid )
-      {
-        total += cubes[i].cost;
+    cover->foreach_cube( [this, &total]( size_type i ) {
+        total += costs[i];
         add_pairs( i );
-      }
-    }
+      } );
 
     sort_cubes();
     L( boost::format( "[i] total cost: %d" ) % total );
@@ -356,47 +300,49 @@ public:
     set_sorting_strategy( ( sorting_strategy + 1 ) % 3 );
   }
 
-  inline cube_vec_t::const_iterator begin() const
-  {
-    return cubes.begin();
-  }
-
-  inline cube_vec_t::const_iterator end() const
-  {
-    return cubes.end();
-  }
-
-  /* if second parameter is true, cube exactly matches, otherwise one bit is different */
-  std::pair<cube_vec_t::const_iterator, bool> has_cube( const exorcismq_cube& cube ) const
+  /* returns the cube with the smallest id within distance 1, npos if none; if
+     second parameter is true, cube exactly matches, otherwise one bit is different */
+  std::pair<size_type, bool> has_cube( const word_t* bits, const word_t* mask ) const
   {
-    assert( !cube.invalid );
-    auto d = 2u;
-
-    auto it = std::find_if( cubes.begin(), cubes.end(), [&cube, &d]( const exorcismq_cube& other ) {
-        if ( !other.invalid )
+    auto best = packed_cover::npos;
+    auto best_distance = 2u;
+    cover->foreach_neighbor( bits, mask, 1u, [&best, &best_distance]( size_type id, unsigned d ) {
+        if ( id < best )
         {
-          d = __builtin_popcount( cube.positions( other ) );
-          return d < 2;
+          best = id;
+          best_distance = d;
         }
-        return false;
       } );
+    return std::make_pair( best, best_distance == 0u );
+  }
 
-    assert( it == cubes.end() || d < 2 );
-    return std::make_pair( it, d == 0 );
+  /* exact match only */
+  inline size_type find_cube( const word_t* bits, const word_t* mask ) const
+  {
+    return cover->find( bits, mask );
   }
 
   void invalidate_cube( size_type index )
   {
-    auto& cube = cubes[index];
-    if ( cube.invalid ) return;
+    if ( !cover->is_valid( index ) ) return;
+    cover->remove( index );
+  }
 
-    cube.invalid = 1;
-    free_ids.push( index );
+  inline bool is_valid( size_type index ) const
+  {
+    return cover->is_valid( index );
   }
 
-  inline const exorcismq_cube& operator[]( size_type index ) const
+  inline const word_t* bits( size_type index ) const { return cover->bits( index ); }
+  inline const word_t* mask( size_type index ) const { return cover->mask( index ); }
+  inline unsigned num_literals( const word_t* mask ) const
   {
-    return cubes[index];
+    auto count = 0u;
+    for ( auto w = 0u; w < numwords(); ++w )
+    {
+      count += __builtin_popcountll( mask[w] );
+    }
+    return count;
   }
 
   inline exorcismq_cube_pair_queue& pairs( unsigned distance )
@@ -415,67 +361,61 @@ public:
   template<typename F>
   void foreach_cube( F&& f )
   {
-    for ( const auto& cube : cubes )
+    cover->foreach_cube( [this, &f]( size_type id ) {
+        f( cover->to_string( id ), costs[id] );
+      } );
+  }
+
+private:
+  unsigned distance_positions( const word_t* b1, const word_t* m1, const word_t* b2, const word_t* m2, unsigned* pos, unsigned max_count ) const
+  {
+    auto d = 0u;
+    for ( auto w = 0u; w < numwords(); ++w )
     {
-      if ( !cube.invalid )
+      auto diff = ( b1[w] ^ b2[w] ) | ( m1[w] ^ m2[w] );
+      for ( ; diff; diff &= diff - 1u, ++d )
       {
-        f( cube, n );
+        if ( d < max_count )
+        {
+          pos[d] = ( w << 6u ) + __builtin_ctzll( diff );
+        }
       }
     }
+    return d;
   }
 
-private:
-  void add_pairs( unsigned index )
+  void add_pairs( size_type index )
   {
-    auto& cube = cubes[index];
-    assert( !cube.invalid );
-
-    /* compute distances and positions to previous cubes */
-    std::vector<unsigned> distances;
-    std::vector<uint64_t> positions;
-    distances.reserve( index );
-    positions.reserve( index );
-
-    /* we use all_of to stop when we hit a distance of 1 or below */
-    auto other_id = -1;
-    std::all_of( cubes.begin(), cubes.begin() + index, [this, &cube, &distances, &positions, &other_id, index]( exorcismq_cube& other ) {
-        ++other_id;
-
-        /* don't combine with invalid cube */
-        if ( other.invalid )
+    /* pair with all cubes with a smaller id and distance 2 to 4, in the
+       order of their ids, independent of the bucket order */
+    neighbors.clear();
+    cover->foreach_neighbor( index, 4u, [this, index]( size_type other, unsigned d ) {
+        if ( other < index )
         {
-          distances.push_back( 65 );
-          positions.push_back( 0 );
-          return true;
-        } /* continue */
-
-        const auto p = cube.positions( other );
-        const auto d = __builtin_popcount( p );
-
-        assert( d > 1 );
-
-        distances.push_back( d );
-        positions.push_back( p );
-
-        return true;
+          neighbors.emplace_back( other, d );
+        }
       } );
+    std::sort( neighbors.begin(), neighbors.end() );
 
-    /* and add all pairs according to their distance */
-    for ( auto i = 0u; i < distances.size(); ++i )
+    for ( const auto& p : neighbors )
     {
-      const auto d = distances[i] - 2;
-      if ( d <= 2 )
-      {
-        cube_pairs[d].emplace_back( i, index, cube.cost + cubes[i].cost, positions[i] );
-      }
+      const auto other = p.first;
+      const auto d = p.second;
+
+      assert( d > 1 );
+
+      positions_t pos;
+      cover->positions( other, index, &pos[0u], 4u );
+      cube_pairs[d - 2].emplace_back( other, index, costs[index] + costs[other], pos );
     }
   }
 
 private:
   unsigned                               n;
-  cube_vec_t                             cubes;
-  std::queue<size_type>                  free_ids;
+  std::unique_ptr<packed_cover>          cover;
+  std::vector<uint64_t>                  costs;
   std::vector<exorcismq_cube_pair_queue> cube_pairs;
+  std::vector<std::pair<size_type, unsigned>> neighbors; /* scratch for add_pairs */
 
   unsigned sorting_strategy = 0;
 
@@ -489,9 +429,10 @@ private:
 class exorcismq_manager
 {
 public:
+  using group_t = std::array<exorcismq_cube, 4>;
+
   exorcismq_manager( const properties::ptr& settings )
-    : //cube_pairs( 3u ),
-      verbose( get( settings, "verbose", verbose ) )
+    : verbose( get( settings, "verbose", verbose ) )
   {
   }
 
@@ -500,31 +441,13 @@ public:
     line_parser( filename, {
         {std::regex( "^\\.i +(\\d+)$" ), [this]( const std::smatch& m ) {
             cubes.set_numvars( boost::lexical_cast<unsigned>( std::string( m[1u] ) ) );
-            //n = boost::lexical_cast<unsigned>( std::string( m[1u] ) );
+            init_scratch();
           }},
         {std::regex( "^([01-]+) +([01]+)$" ), [this]( const std::smatch& m ) {
             const auto scube = std::string( m[1u] );
             assert( scube.size() == cubes.numvars() );
 
-            exorcismq_cube cube;
-
-            for ( auto i = 0u; i < cubes.numvars(); ++i )
-            {
-              switch ( scube[i] )
-              {
-              case '0':
-                cube.mask |= 1 << i;
-                break;
-              case '1':
-                cube.bits |= 1 << i;
-                cube.mask |= 1 << i;
-                break;
-              case '-':
-                break;
-              }
-            }
-
-            cubes.add_cube( cube );
+            cubes.add_cube( scube );
           }}
       } );
 
@@ -542,24 +465,26 @@ public:
     using abc::Vec_IntEntry;
 
     cubes.set_numvars( num_inputs );
+    init_scratch();
 
+    std::vector<word_t> planes( 2u * cubes.numwords() );
     Vec_WecForEachLevel( esop, line, c )
     {
       /* single output (for now) */
       assert( abc::Vec_IntPop( line ) == -1 );
 
-      exorcismq_cube cube;
+      std::fill( planes.begin(), planes.end(), 0u );
       Vec_IntForEachEntry( line, lit, k )
       {
-        cube.mask |= 1 << abc::Abc_Lit2Var( lit );
+        packed_cover::set_bit( &planes[cubes.numwords()], abc::Abc_Lit2Var( lit ), true );
 
         if ( !abc::Abc_LitIsCompl( lit ) ) /* 0 */
         {
-          cube.bits |= 1 << abc::Abc_Lit2Var( lit );
+          packed_cover::set_bit( &planes[0u], abc::Abc_Lit2Var( lit ), true );
         }
       }
 
-      cubes.add_cube( cube );
+      cubes.add_cube( &planes[0u], &planes[cubes.numwords()] );
     }
 
     cubes.compute_pairs();
@@ -574,12 +499,10 @@ public:
 
     os << ".i " << cubes.numvars() << std::endl
        << ".o 1" << std::endl
-      //       << ".p " << cubes.size() << std::endl
        << ".type esop" << std::endl;
-    cubes.foreach_cube( [&total, &os]( const exorcismq_cube& cube, unsigned n ) {
-      total += cube.cost;
-      cube.print( os, n );
-      os << " 1" << std::endl;
+    cubes.foreach_cube( [&total, &os]( const std::string& cube, uint64_t cost ) {
+      total += cost;
+      os << cube << " 1" << std::endl;
       } );
     os << ".e" << std::endl;
 
@@ -604,17 +527,14 @@ public:
       pairs.pop_back();
 
       /* get cubes from pair */
-      const auto& c1 = cubes[std::get<0>( top )];
-      const auto& c2 = cubes[std::get<1>( top )];
-
-      if ( c1.invalid || c2.invalid ) continue;
+      if ( !cubes.is_valid( std::get<0>( top ) ) || !cubes.is_valid( std::get<1>( top ) ) ) continue;
 
       f_before();
 
       /* iterate through groups */
       for ( auto i = 0u; i < cube_group_count[distance - 2]; ++i )
       {
-        if ( !f( c1, c2, &cube_groups[offset + i * skip], std::get<0>( top ), std::get<1>( top ), std::get<2>( top ), std::get<3>( top ) ) ) break;
+        if ( !f( &cube_groups[offset + i * skip], std::get<0>( top ), std::get<1>( top ), std::get<2>( top ), std::get<3>( top ) ) ) break;
       }
 
       f_after();
@@ -623,23 +543,20 @@ public:
 
   bool optimize( unsigned max_distance, bool strict = true )
   {
-    std::vector<exorcismq_cube> new_cubes;
+    new_cubes.clear();
 
     for ( auto d = 2u; d <= max_distance; ++d )
     {
-      /* check d == 4 only if there has not been improvement yet */
-      //if ( d == 4u && !new_cubes.empty() ) { break; }
-
-      foreach_pair_and_group( d, [this, d, strict, &new_cubes]( const exorcismq_cube& c1, const exorcismq_cube& c2, unsigned* group, unsigned c1_id, unsigned c2_id, uint64_t pair_cost, uint32_t positions ) {
-          auto res = c1.exorlink( c2, d, positions, group );
+      foreach_pair_and_group( d, [this, d, strict]( unsigned* group, unsigned c1_id, unsigned c2_id, uint64_t pair_cost, const exorcismq_cube_store::positions_t& positions ) {
+          exorlink( c1_id, c2_id, d, positions, group, result, result_planes );
           std::vector<exorcismq_cube_store::size_type> invalids;
 
-          const auto cost = calculate_group_costs( res, d, invalids );
+          const auto cost = calculate_group_costs( result, d, invalids );
 
           /* cost improvement? */
           if ( cost < static_cast<int64_t>( pair_cost ) || ( !strict && ( cost == static_cast<int64_t>( pair_cost ) ) ) )
           {
-            accept_group( c1_id, c2_id, res, d, invalids, new_cubes );
+            accept_group( c1_id, c2_id, result, d, invalids );
             return false;
           }
 
@@ -647,28 +564,24 @@ public:
         }, []() {}, []() {} );
     }
 
-    return add_new_cubes( new_cubes );
+    return add_new_cubes();
   }
 
   bool optimize_with_best( unsigned max_distance )
   {
-    std::vector<exorcismq_cube> new_cubes;
+    new_cubes.clear();
 
     int64_t best_improvement = 0;
     unsigned best_c1_id = 0, best_c2_id = 0;
-    std::array<exorcismq_cube, 4> best_res;
     std::vector<exorcismq_cube_store::size_type> best_invalids;
 
     for ( auto d = 2u; d <= max_distance; ++d )
     {
-      /* check d == 4 only if there has not been improvement yet */
-      //if ( d == 4u && !new_cubes.empty() ) { break; }
-
-      foreach_pair_and_group( d, [this, d, &new_cubes, &best_improvement, &best_c1_id, &best_c2_id, &best_res, &best_invalids]( const exorcismq_cube& c1, const exorcismq_cube& c2, unsigned* group, unsigned c1_id, unsigned c2_id, uint64_t pair_cost, uint32_t positions ) {
-          auto res = c1.exorlink( c2, d, positions, group );
+      foreach_pair_and_group( d, [this, d, &best_improvement, &best_c1_id, &best_c2_id, &best_invalids]( unsigned* group, unsigned c1_id, unsigned c2_id, uint64_t pair_cost, const exorcismq_cube_store::positions_t& positions ) {
+          exorlink( c1_id, c2_id, d, positions, group, result, result_planes );
           std::vector<exorcismq_cube_store::size_type> invalids;
 
-          const auto cost = calculate_group_costs( res, d, invalids );
+          const auto cost = calculate_group_costs( result, d, invalids );
 
           /* cost improvement? */
           if ( cost < static_cast<int64_t>( pair_cost ) )
@@ -679,7 +592,7 @@ public:
               best_improvement = improvement;
               best_c1_id = c1_id;
               best_c2_id = c2_id;
-              best_res = res;
+              copy_result_to_best();
               best_invalids = invalids;
             }
           }
@@ -687,15 +600,15 @@ public:
           return true;
         }, [&best_improvement]() {
           best_improvement = -1;
-        }, [this, d, &new_cubes, &best_improvement, &best_c1_id, &best_c2_id, &best_res, &best_invalids]() {
+        }, [this, d, &best_improvement, &best_c1_id, &best_c2_id, &best_invalids]() {
           if ( best_improvement != -1 )
           {
-            accept_group( best_c1_id, best_c2_id, best_res, d, best_invalids, new_cubes );
+            accept_group( best_c1_id, best_c2_id, best_result, d, best_invalids );
           }
         } );
     }
 
-    return add_new_cubes( new_cubes );
+    return add_new_cubes();
   }
 
   void run()
@@ -746,23 +659,84 @@ public:
   }
 
 private:
-  int64_t calculate_group_costs( std::array<exorcismq_cube, 4>& res, unsigned distance, std::vector<exorcismq_cube_store::size_type>& invalids )
+  /* scratch planes for the current and the best EXORLINK group */
+  void init_scratch()
+  {
+    const auto nw = cubes.numwords();
+    result_planes.assign( 8u * nw, 0u );
+    best_planes.assign( 8u * nw, 0u );
+    for ( auto i = 0u; i < 4u; ++i )
+    {
+      result[i].bits = &result_planes[2u * nw * i];
+      result[i].mask = &result_planes[2u * nw * i + nw];
+      best_result[i].bits = &best_planes[2u * nw * i];
+      best_result[i].mask = &best_planes[2u * nw * i + nw];
+    }
+  }
+
+  void copy_result_to_best()
+  {
+    std::copy( result_planes.begin(), result_planes.end(), best_planes.begin() );
+    for ( auto i = 0u; i < 4u; ++i )
+    {
+      best_result[i].cost = result[i].cost;
+      best_result[i].invalid = result[i].invalid;
+    }
+  }
+
+  /* performs exorlink of c1 and c2 given distance and different positions pos in given group */
+  void exorlink( unsigned c1_id, unsigned c2_id, unsigned distance, const exorcismq_cube_store::positions_t& pos, unsigned* group, group_t& res, std::vector<word_t>& planes )
+  {
+    const auto nw = cubes.numwords();
+    const auto *b1 = cubes.bits( c1_id ), *m1 = cubes.mask( c1_id );
+    const auto *b2 = cubes.bits( c2_id ), *m2 = cubes.mask( c2_id );
+
+    for ( auto i = 0u; i < distance; ++i )
+    {
+      auto* tbits = &planes[2u * nw * i];
+      auto* tmask = tbits + nw;
+      std::copy( b1, b1 + nw, tbits );
+      std::copy( m1, m1 + nw, tmask );
+
+      for ( auto j = 0u; j < distance; ++j )
+      {
+        const auto p = pos[j];
+
+        switch ( *group++ )
+        {
+          case 0:
+            /* take from this */
+            break;
+          case 1:
+            /* take from that */
+            packed_cover::set_bit( tbits, p, packed_cover::get_bit( b2, p ) );
+            packed_cover::set_bit( tmask, p, packed_cover::get_bit( m2, p ) );
+            break;
+          case 2:
+            /* take other */
+            exorcismq_combine( tbits, tmask, b1, m1, b2, m2, p );
+            break;
+        }
+      }
+
+      res[i].invalid = 0;
+    }
+  }
+
+  int64_t calculate_group_costs( group_t& res, unsigned distance, std::vector<exorcismq_cube_store::size_type>& invalids )
   {
     int64_t cost = 0;
 
     for ( auto j = 0u; j < distance; ++j )
     {
-      res[j].cost = tcount( res[j].num_literals(), cubes.numvars() );
-      exorcismq_cube_store::cube_vec_t::const_iterator it;
-      bool equal;
-      std::tie( it, equal ) = cubes.has_cube( res[j] );
+      res[j].cost = tcount( cubes.num_literals( res[j].mask ), cubes.numvars() );
+      const auto id = cubes.find_cube( res[j].bits, res[j].mask );
 
-      if ( it != cubes.end() && equal )
+      if ( id != packed_cover::npos )
       {
         res[j].invalid = 1;
         cost -= res[j].cost;
-        invalids.push_back( std::distance<exorcismq_cube_store::cube_vec_t::const_iterator>( cubes.begin(), it ) );
-        //assert( !cubes[invalids.back()].invalid );
+        invalids.push_back( id );
       }
       else
       {
@@ -773,7 +747,7 @@ private:
     return cost;
   }
 
-  void accept_group( unsigned c1_id, unsigned c2_id, const std::array<exorcismq_cube, 4>& res, unsigned distance, const std::vector<exorcismq_cube_store::size_type>& invalids, std::vector<exorcismq_cube>& new_cubes )
+  void accept_group( unsigned c1_id, unsigned c2_id, const group_t& res, unsigned distance, const std::vector<exorcismq_cube_store::size_type>& invalids )
   {
     cubes.invalidate_cube( c1_id );
     cubes.invalidate_cube( c2_id );
@@ -785,75 +759,43 @@ private:
       cubes.invalidate_cube( j );
     }
 
+    const auto nw = cubes.numwords();
     for ( auto j = 0u; j < distance; ++j )
     {
       if ( !res[j].invalid )
       {
-        new_cubes.push_back( res[j] );
+        new_cubes.insert( new_cubes.end(), res[j].bits, res[j].bits + nw );
+        new_cubes.insert( new_cubes.end(), res[j].mask, res[j].mask + nw );
       }
     }
   }
 
-  bool add_new_cubes( std::vector<exorcismq_cube>& new_cubes )
+  bool add_new_cubes()
   {
-    if ( !new_cubes.empty() )
+    const auto nw = cubes.numwords();
+    const auto improved = !new_cubes.empty();
+
+    for ( auto i = 0u; i < new_cubes.size(); i += 2u * nw )
     {
-      for ( auto& cube : new_cubes )
-      {
-        cubes.add_cube( cube );
-      }
-      cubes.compute_pairs();
-      return true;
+      cubes.add_cube( &new_cubes[i], &new_cubes[i + nw] );
     }
+    new_cubes.clear();
 
     cubes.compute_pairs();
-    return false;
+    return improved;
   }
 
-  void check_exorlink_result( const exorcismq_cube_store::exorcismq_cube_pair& p,  const std::array<exorcismq_cube, 4>& res, unsigned distance )
-  {
-    const auto& c1 = cubes[std::get<0>( p )];
-    const auto& c2 = cubes[std::get<1>( p )];
-
-    assert( !c1.invalid );
-    assert( !c2.invalid );
-
-    //assert( c1.positions( c2 ) == std::get<3>( p ) );
-
-    for ( auto j = 0u; j < distance; ++j )
-    {
-      assert( !res[j].invalid );
-
-      if ( ( res[j].bits == c1.bits && res[j].mask == c1.mask ) ||
-           ( res[j].bits == c2.bits && res[j].mask == c2.mask ) )
-      {
-        std::cout << "pos: " << std::get<3>( p ) << " c1: ";
-        c1.print( std::cout, cubes.numvars() );
-        std::cout << " c2: ";
-        c2.print( std::cout, cubes.numvars() );
-
-        for ( auto jj = 0u; jj < distance; ++jj )
-        {
-          std::cout << " ";
-          if ( j == jj )
-            std::cout << "*";
-          std::cout << "res[" << jj << "]: ";
-          res[j].print( std::cout, cubes.numvars() );
-        }
-        std::cout << std::endl;
-
-        assert( false );
-      }
-    }
-  }
-
-
 private:
   exorcismq_cube_store                   cubes;
 
-  bool verbose = false;
+  /* EXORLINK scratch space */
+  group_t                                result, best_result;
+  std::vector<word_t>                    result_planes, best_planes;
 
-  //unsigned opt_rounds = 0u;
+  /* cubes to be added after a pass, planes of all cubes back to back */
+  std::vector<word_t>                    new_cubes;
+
+  bool verbose = false;
 
   static unsigned cube_groups[];
   static unsigned cube_group_count[];
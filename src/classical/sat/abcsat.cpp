@@ -26,6 +26,7 @@
 
 #include "abcsat.hpp"
 
+#include <core/utils/profiler.hpp>
 #include <core/utils/timer.hpp>
 
 namespace cirkit
@@ -74,8 +75,15 @@ solver_result_t solve<abc_solver>( abc_solver& solver, solver_execution_statisti
 {
   abc::lbool result = abc::l_Undef;
 
+  static auto& profile_calls     = get_profile_counter( "sat.calls" );
+  static auto& profile_conflicts = get_profile_counter( "sat.conflicts" );
+  static auto& profile_time      = get_profile_timer( "sat.solve" );
+
+  const std::uint64_t conflicts_before = abc::sat_solver_nconflicts( solver->solver );
+
   {
     reference_timer t( &statistics.runtime );
+    profile_scope pt( profile_time );
 
     if ( assumptions.empty() )
     {
@@ -105,6 +113,10 @@ solver_result_t solve<abc_solver>( abc_solver& solver, solver_execution_statisti
   statistics.num_vars      = abc::sat_solver_nvars( solver->solver );
   statistics.num_clauses   = abc::sat_solver_nclauses( solver->solver );
   statistics.num_conflicts = abc::sat_solver_nconflicts( solver->solver );
+  statistics.undecided     = ( result == abc::l_Undef );
+
+  profile_calls.add();
+  profile_conflicts.add( statistics.num_conflicts - conflicts_before );
 
   if ( result == abc::l_True && !solver->genmodel )
   {
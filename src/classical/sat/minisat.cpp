@@ -26,7 +26,7 @@
 
 #include "minisat.hpp"
 
-#include <core/utils/range_utils.hpp>
+#include <core/utils/profiler.hpp>
 #include <core/utils/timer.hpp>
 
 namespace cirkit
@@ -64,8 +64,15 @@ solver_result_t solve<minisat_solver>( minisat_solver& solver, solver_execution_
 {
   auto result = false;
 
+  static auto& profile_calls     = get_profile_counter( "sat.calls" );
+  static auto& profile_conflicts = get_profile_counter( "sat.conflicts" );
+  static auto& profile_time      = get_profile_timer( "sat.solve" );
+
+  const std::uint64_t conflicts_before = solver.solver->conflicts;
+
   {
     reference_timer t( &statistics.runtime );
+    profile_scope pt( profile_time );
 
     /* budget */
     auto limited = false;
@@ -79,31 +86,29 @@ solver_result_t solve<minisat_solver>( minisat_solver& solver, solver_execution_
       solver.solver->budgetOff();
     }
 
-    if ( assumptions.empty() )
+    /* variables that do not occur in any clause are unconstrained and
+       can be skipped in the assumptions */
+    const auto nvars = solver.solver->nVars();
+    int var;
+    Minisat::vec<Minisat::Lit> lits;
+
+    for ( auto parsed_lit : assumptions )
     {
-      if ( limited )
-      {
-        Minisat::vec<Minisat::Lit> dummy;
-        result = ( solver.solver->solveLimited( dummy ) == Minisat::lbool((uint8_t)0) );
-      }
-      else
-      {
-        result = solver.solver->solve();
-      }
+      var = abs( parsed_lit ) - 1;
+      if ( var >= nvars ) { continue; }
+      lits.push( ( parsed_lit > 0 ) ? Minisat::mkLit( var ) : ~Minisat::mkLit( var ) );
+    }
+
+    if ( limited )
+    {
+      const auto r = solver.solver->solveLimited( lits );
+      result = ( r == Minisat::lbool((uint8_t)0) );
+      statistics.undecided = ( r == Minisat::lbool((uint8_t)2) );
     }
     else
     {
-      const auto nvars = solver.solver->nVars();
-      int var;
-      Minisat::vec<Minisat::Lit> lits( assumptions.size() );
-
-      for ( auto parsed_lit : index( assumptions ) )
-      {
-        var = abs( parsed_lit.value ) - 1;
-        if ( var >= nvars ) { continue; }
-        lits[parsed_lit.index] = ( parsed_lit.value > 0 ) ? Minisat::mkLit( var ) : ~Minisat::mkLit( var );
-      }
-      result = limited ? ( solver.solver->solveLimited( lits ) == Minisat::lbool((uint8_t)0) ) : solver.solver->solve( lits );
+      result = solver.solver->solve( lits );
+      statistics.undecided = false;
     }
   }
 
@@ -111,6 +116,9 @@ solver_result_t solve<minisat_solver>( minisat_solver& solver, solver_execution_
   statistics.num_clauses   = solver.solver->nClauses();
   statistics.num_conflicts = solver.solver->conflicts;
 
+  profile_calls.add();
+  profile_conflicts.add( statistics.num_conflicts - conflicts_before );
+
   if ( result && !solver.genmodel )
   {
     return solver_result_t( {boost::dynamic_bitset<>(), boost::dynamic_bitset<>(), } );
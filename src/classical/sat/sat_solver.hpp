@@ -94,6 +94,7 @@ struct solver_execution_statistics
   double parse_time = 0.0;
   double runtime = 0.0;
   uint64_t num_conflicts = 0;
+  bool undecided = false; /* conflict budget exceeded, solve returned no model */
 };
 
 template<class S>
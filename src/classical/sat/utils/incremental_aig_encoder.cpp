@@ -0,0 +1,126 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "incremental_aig_encoder.hpp"
+
+#include <algorithm>
+
+#include <boost/graph/adjacency_list.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+incremental_aig_encoder_base::incremental_aig_encoder_base( const aig_graph& aig, int& sid )
+  : aig( aig ),
+    info( aig_info( aig ) ),
+    sid( sid )
+{
+  for ( const auto& input : info.inputs )
+  {
+    set_var( input, sid++, 0 );
+  }
+}
+
+std::vector<int> incremental_aig_encoder_base::input_literals() const
+{
+  std::vector<int> lits( info.inputs.size() );
+  for ( auto i = 0u; i < lits.size(); ++i )
+  {
+    lits[i] = input_literal( i );
+  }
+  return lits;
+}
+
+int incremental_aig_encoder_base::begin_group()
+{
+  assert( !current_group );
+  current_group = sid++;
+  groups.push_back( {current_group, std::vector<aig_node>()} );
+  return current_group;
+}
+
+void incremental_aig_encoder_base::end_group()
+{
+  current_group = 0;
+}
+
+unsigned incremental_aig_encoder_base::num_encoded() const
+{
+  return std::count_if( vars.begin(), vars.end(), []( int v ) { return v != 0; } );
+}
+
+void incremental_aig_encoder_base::set_var( aig_node node, int var, int group )
+{
+  if ( node >= vars.size() )
+  {
+    vars.resize( boost::num_vertices( aig ), 0 );
+    node_groups.resize( boost::num_vertices( aig ), 0 );
+  }
+  vars[node] = var;
+  node_groups[node] = group;
+
+  if ( group )
+  {
+    groups.back().second.push_back( node );
+  }
+}
+
+void incremental_aig_encoder_base::remove_group( int group )
+{
+  if ( group == current_group ) { end_group(); }
+
+  const auto it = std::find_if( groups.begin(), groups.end(), [group]( const std::pair<int, std::vector<aig_node>>& g ) { return g.first == group; } );
+  assert( it != groups.end() );
+
+  for ( const auto& node : it->second )
+  {
+    if ( node < node_groups.size() && node_groups[node] == group )
+    {
+      vars[node] = 0;
+    }
+  }
+  groups.erase( it );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
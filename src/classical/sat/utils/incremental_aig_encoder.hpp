@@ -0,0 +1,217 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file incremental_aig_encoder.hpp
+ *
+ * @brief Incremental Tseitin encoding of an AIG into a SAT solver
+ *
+ * In contrast to add_aig, which encodes all outputs at once, the encoder
+ * remembers the solver variable of each encoded node and only encodes the
+ * transitive fan-in cone of a function when its literal is requested for the
+ * first time.  Nodes can be encoded inside a group, whose clauses are guarded
+ * by an activation literal (cf. blocking_and) and can be retracted later.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef INCREMENTAL_AIG_ENCODER_HPP
+#define INCREMENTAL_AIG_ENCODER_HPP
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include <boost/graph/adjacency_list.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+#include <classical/sat/sat_solver.hpp>
+#include <classical/sat/operations/logic.hpp>
+
+namespace cirkit
+{
+
+/* bookkeeping of encoded nodes and groups, independent of the solver */
+class incremental_aig_encoder_base
+{
+public:
+  /* input variables are allocated at construction, all other variables on
+     demand; sid is shared with the caller such that several encoders (or
+     other encodings) can use the same solver */
+  incremental_aig_encoder_base( const aig_graph& aig, int& sid );
+
+  inline int input_literal( unsigned i ) const
+  {
+    return vars[info.inputs[i]];
+  }
+
+  std::vector<int> input_literals() const;
+
+  /* all nodes that are encoded until end_group are guarded by the returned
+     activation literal, which must be assumed in queries that use them */
+  int begin_group();
+  void end_group();
+
+  /* number of currently encoded nodes */
+  unsigned num_encoded() const;
+
+protected:
+  void set_var( aig_node node, int var, int group );
+
+  /* nodes of other groups are not reused, since their encoding may be retracted */
+  inline bool is_encoded( aig_node node ) const
+  {
+    return node < vars.size() && vars[node] != 0 && ( node_groups[node] == 0 || node_groups[node] == current_group );
+  }
+
+  /* forgets the nodes of group, such that they are encoded again when needed */
+  void remove_group( int group );
+
+protected:
+  const aig_graph&                                aig;
+  const aig_graph_info&                           info;
+  int&                                            sid;
+
+  std::vector<int>                                vars;        /* 0: not encoded */
+  std::vector<int>                                node_groups; /* 0: permanent */
+  std::vector<std::pair<aig_node, bool>>          stack;       /* node and whether children are visited */
+
+  int                                             current_group = 0;
+  std::vector<std::pair<int, std::vector<aig_node>>> groups;   /* activation literal and nodes */
+};
+
+template<class S>
+class incremental_aig_encoder : public incremental_aig_encoder_base
+{
+public:
+  incremental_aig_encoder( S& solver, const aig_graph& aig, int& sid )
+    : incremental_aig_encoder_base( aig, sid ),
+      solver( solver )
+  {
+  }
+
+  /* encodes the fan-in cone of f if necessary */
+  int literal( const aig_function& f )
+  {
+    const auto var = encode( f.node );
+    return f.complemented ? -var : var;
+  }
+
+  inline int output_literal( unsigned o )
+  {
+    return literal( info.outputs[o].first );
+  }
+
+  /* disables the clauses of the group permanently, its nodes are encoded
+     again when they are needed later */
+  void retract( int group )
+  {
+    remove_group( group );
+    add_clause( solver )( {-group} );
+  }
+
+private:
+  int encode( aig_node root )
+  {
+    if ( is_encoded( root ) ) { return vars[root]; }
+
+    /* iterative post-order traversal, AIGs can be too deep for recursion */
+    stack.clear();
+    stack.push_back( {root, false} );
+
+    while ( !stack.empty() )
+    {
+      const auto node = stack.back().first;
+      if ( is_encoded( node ) ) { stack.pop_back(); continue; }
+
+      if ( node == 0u ) /* constant */
+      {
+        stack.pop_back();
+        const auto var = sid++;
+        add_guarded( {-var} );
+        set_var( node, var, current_group );
+        continue;
+      }
+
+      const auto children = get_children( aig, node );
+      assert( children.size() == 2u );
+
+      if ( !stack.back().second )
+      {
+        stack.back().second = true;
+        for ( const auto& child : children )
+        {
+          if ( !is_encoded( child.node ) )
+          {
+            stack.push_back( {child.node, false} );
+          }
+        }
+        continue;
+      }
+
+      stack.pop_back();
+
+      const auto a = vars[children[0u].node] * ( children[0u].complemented ? -1 : 1 );
+      const auto b = vars[children[1u].node] * ( children[1u].complemented ? -1 : 1 );
+      const auto c = sid++;
+
+      if ( current_group )
+      {
+        blocking_and( solver, current_group, a, b, c );
+      }
+      else
+      {
+        logic_and( solver, a, b, c );
+      }
+      set_var( node, c, current_group );
+    }
+
+    return vars[root];
+  }
+
+  void add_guarded( std::initializer_list<int> clause )
+  {
+    std::vector<int> c( clause );
+    if ( current_group ) { c.push_back( -current_group ); }
+    add_clause( solver )( c );
+  }
+
+private:
+  S&                                              solver;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,344 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "npn_cache.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+#include <unistd.h>
+
+#include <boost/format.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/* snapshot files consist of this header followed by num_records records,
+   sorted by number of variables and truth table */
+struct npn_cache_snapshot_header_t
+{
+  char     magic[8];
+  uint64_t num_records;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace
+{
+
+constexpr char     npn_cache_magic[8] = {'C', 'K', 'N', 'P', 'N', '0', '0', '1'};
+
+/* slot states, ready slots store the number of variables as offset */
+constexpr uint32_t slot_empty   = 0u;
+constexpr uint32_t slot_writing = 1u;
+constexpr uint32_t slot_ready   = 2u;
+
+template<typename Record>
+inline std::tuple<uint64_t, uint64_t> record_key( const Record& r )
+{
+  return std::make_tuple( r.info & 0xf, r.func );
+}
+
+}
+
+bool npn_cache::encode( const tt& func, const tt& npn, const boost::dynamic_bitset<>& phase, const std::vector<unsigned>& perm, record_t& record )
+{
+  const auto num_vars = tt_num_vars( func );
+
+  if ( num_vars > 6u || func.size() != ( 1u << num_vars ) || npn.size() != func.size() ) { return false; }
+  if ( phase.size() != num_vars + 1u || perm.size() != num_vars ) { return false; }
+
+  record.func = func.to_ulong();
+  record.npn  = npn.to_ulong();
+  record.info = num_vars | ( static_cast<uint64_t>( phase.to_ulong() ) << 4u );
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    if ( perm[i] >= num_vars ) { return false; }
+    record.info |= static_cast<uint64_t>( perm[i] ) << ( 11u + 3u * i );
+  }
+
+  return true;
+}
+
+void npn_cache::decode( const record_t& record, tt& npn, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
+{
+  const unsigned num_vars = record.info & 0xf;
+
+  npn = tt( 1u << num_vars, record.npn );
+  phase = boost::dynamic_bitset<>( num_vars + 1u, ( record.info >> 4u ) & 0x7f );
+  perm.resize( num_vars );
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    perm[i] = ( record.info >> ( 11u + 3u * i ) ) & 7u;
+  }
+}
+
+std::size_t npn_cache::slot_index( uint64_t func, unsigned num_vars ) const
+{
+  return ( ( func ^ ( static_cast<uint64_t>( num_vars ) << 58u ) ) * UINT64_C( 0x9e3779b97f4a7c15 ) ) >> ( 64u - log_capacity );
+}
+
+const npn_cache::record_t* npn_cache::find( uint64_t func, unsigned num_vars ) const
+{
+  /* new entries */
+  const auto mask = ( std::size_t( 1 ) << log_capacity ) - 1u;
+  for ( std::size_t i = 0u, idx = slot_index( func, num_vars ); i <= mask; ++i, idx = ( idx + 1u ) & mask )
+  {
+    const auto& slot = slots[idx];
+    const auto state = slot.state.load( std::memory_order_acquire );
+
+    if ( state == slot_empty ) { break; }
+    if ( state == slot_ready + num_vars && slot.record.func == func ) { return &slot.record; }
+  }
+
+  /* snapshot */
+  record_t key{func, 0u, num_vars};
+  const auto it = std::lower_bound( snapshot_begin, snapshot_end, key, []( const record_t& a, const record_t& b ) {
+      return record_key( a ) < record_key( b );
+    } );
+  if ( it != snapshot_end && record_key( *it ) == record_key( key ) )
+  {
+    return it;
+  }
+
+  return nullptr;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+unsigned npn_cache::log_capacity_for( std::size_t num_entries )
+{
+  auto log_capacity = 2u;
+  while ( ( ( std::size_t( 3 ) << log_capacity ) >> 2u ) < num_entries ) { ++log_capacity; }
+  return log_capacity;
+}
+
+npn_cache::npn_cache( unsigned log_capacity, const std::string& filename )
+  : log_capacity( log_capacity ),
+    slots( new slot_t[std::size_t( 1 ) << log_capacity] ),
+    max_entries( ( std::size_t( 3 ) << log_capacity ) >> 2u ),
+    num_entries( 0u ),
+    filename( filename ),
+    cache_hit( 0u ),
+    cache_miss( 0u )
+{
+  assert( log_capacity >= 2u && log_capacity <= 32u );
+
+  for ( std::size_t i = 0u; i < capacity(); ++i )
+  {
+    slots[i].state.store( slot_empty, std::memory_order_relaxed );
+  }
+
+  if ( filename.empty() ) { return; }
+
+  snapshot.reset( new mapped_file( filename, false ) );
+  if ( !snapshot->good() ) { return; }
+
+  const auto* header = reinterpret_cast<const npn_cache_snapshot_header_t*>( snapshot->data );
+  if ( snapshot->size < sizeof( npn_cache_snapshot_header_t ) ||
+       std::memcmp( header->magic, npn_cache_magic, sizeof( npn_cache_magic ) ) != 0 ||
+       header->num_records > ( snapshot->size - sizeof( npn_cache_snapshot_header_t ) ) / sizeof( record_t ) ||
+       snapshot->size != sizeof( npn_cache_snapshot_header_t ) + header->num_records * sizeof( record_t ) )
+  {
+    std::cout << "[w] ignore invalid NPN cache snapshot " << filename << std::endl;
+    return;
+  }
+
+  snapshot_begin = reinterpret_cast<const record_t*>( snapshot->data + sizeof( npn_cache_snapshot_header_t ) );
+  snapshot_end   = snapshot_begin + header->num_records;
+}
+
+bool npn_cache::lookup( const tt& func, tt& npn, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm ) const
+{
+  const auto num_vars = tt_num_vars( func );
+  if ( num_vars > 6u || func.size() != ( 1u << num_vars ) ) { return false; }
+
+  if ( const auto* record = find( func.to_ulong(), num_vars ) )
+  {
+    cache_hit.fetch_add( 1u, std::memory_order_relaxed );
+    decode( *record, npn, phase, perm );
+    return true;
+  }
+
+  cache_miss.fetch_add( 1u, std::memory_order_relaxed );
+  return false;
+}
+
+bool npn_cache::insert( const tt& func, const tt& npn, const boost::dynamic_bitset<>& phase, const std::vector<unsigned>& perm )
+{
+  record_t record;
+  if ( !encode( func, npn, phase, perm, record ) ) { return false; }
+  if ( num_entries.load( std::memory_order_relaxed ) >= max_entries ) { return false; }
+
+  const uint32_t num_vars = record.info & 0xf;
+  const auto mask = ( std::size_t( 1 ) << log_capacity ) - 1u;
+  for ( std::size_t i = 0u, idx = slot_index( record.func, num_vars ); i <= mask; ++i, idx = ( idx + 1u ) & mask )
+  {
+    auto& slot = slots[idx];
+    auto state = slot.state.load( std::memory_order_acquire );
+
+    if ( state == slot_empty )
+    {
+      /* claim the slot, the record is published by the release store */
+      if ( slot.state.compare_exchange_strong( state, slot_writing, std::memory_order_acq_rel ) )
+      {
+        slot.record = record;
+        slot.state.store( slot_ready + num_vars, std::memory_order_release );
+        num_entries.fetch_add( 1u, std::memory_order_relaxed );
+        return true;
+      }
+    }
+
+    /* another thread was faster (slots that are being written are skipped) */
+    if ( state == slot_ready + num_vars && slot.record.func == record.func ) { return true; }
+  }
+
+  return false;
+}
+
+tt npn_cache::compute( const tt& func, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const npn_classifier_t& npn_func )
+{
+  tt npn;
+  if ( lookup( func, npn, phase, perm ) )
+  {
+    return npn;
+  }
+
+  npn = npn_func( func, phase, perm );
+  insert( func, npn, phase, perm );
+  return npn;
+}
+
+void npn_cache::save( const std::string& filename ) const
+{
+  std::vector<record_t> records( snapshot_begin, snapshot_end );
+  for ( std::size_t i = 0u; i < capacity(); ++i )
+  {
+    if ( slots[i].state.load( std::memory_order_acquire ) >= slot_ready )
+    {
+      records.push_back( slots[i].record );
+    }
+  }
+
+  std::sort( records.begin(), records.end(), []( const record_t& a, const record_t& b ) { return record_key( a ) < record_key( b ); } );
+  records.erase( std::unique( records.begin(), records.end(), []( const record_t& a, const record_t& b ) { return record_key( a ) == record_key( b ); } ), records.end() );
+
+  npn_cache_snapshot_header_t header;
+  std::memcpy( header.magic, npn_cache_magic, sizeof( npn_cache_magic ) );
+  header.num_records = records.size();
+
+  /* write to a temporary file first, such that concurrent runs never map a partial snapshot */
+  const auto tmpname = boost::str( boost::format( "%s.%d.tmp" ) % filename % getpid() );
+  {
+    std::ofstream os( tmpname.c_str(), std::ofstream::out | std::ofstream::binary );
+    os.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    os.write( reinterpret_cast<const char*>( records.data() ), records.size() * sizeof( record_t ) );
+
+    if ( !os )
+    {
+      std::cout << "[w] cannot write NPN cache snapshot " << filename << std::endl;
+      std::remove( tmpname.c_str() );
+      return;
+    }
+  }
+  std::rename( tmpname.c_str(), filename.c_str() );
+}
+
+bool npn_cache::persist() const
+{
+  if ( filename.empty() || num_entries.load() == 0u ) { return false; }
+
+  save( filename );
+  return true;
+}
+
+std::size_t npn_cache::size() const
+{
+  return ( snapshot_end - snapshot_begin ) + num_entries.load();
+}
+
+std::size_t npn_cache::capacity() const
+{
+  return std::size_t( 1 ) << log_capacity;
+}
+
+unsigned long npn_cache::hits() const
+{
+  return cache_hit.load();
+}
+
+unsigned long npn_cache::misses() const
+{
+  return cache_miss.load();
+}
+
+void npn_cache::print_statistics( std::ostream& os ) const
+{
+  os << boost::format( "[i] NPN cache: size = %d (%d from snapshot)   cache hits = %d   cache misses = %d" ) % size() % ( snapshot_end - snapshot_begin ) % hits() % misses() << std::endl;
+}
+
+npn_cache::ptr shared_npn_cache( const std::string& name )
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, npn_cache::ptr> caches;
+
+  std::lock_guard<std::mutex> lock( mutex );
+
+  auto& cache = caches[name];
+  if ( !cache )
+  {
+    std::string filename;
+    if ( const auto* path = std::getenv( "CIRKIT_HOME" ) )
+    {
+      filename = boost::str( boost::format( "%s/npn_%s.cache" ) % path % name );
+    }
+    cache = std::make_shared<npn_cache>( 18u, filename );
+  }
+  return cache;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
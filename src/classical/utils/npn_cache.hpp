@@ -0,0 +1,153 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file npn_cache.hpp
+ *
+ * @brief Concurrent cache for NPN canonization of small functions
+ *
+ * Functions with up to 6 inputs are keyed by their packed truth table.  New
+ * entries are stored in a fixed-size open addressing table which can be
+ * queried and extended by several threads without locks.  A cache can be
+ * backed by a sorted snapshot file that is memory-mapped when the cache is
+ * created and rewritten by persist(), such that later runs do not recompute
+ * the same classes.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef NPN_CACHE_HPP
+#define NPN_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/utils/mapped_file.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+namespace cirkit
+{
+
+class npn_cache
+{
+public:
+  using ptr              = std::shared_ptr<npn_cache>;
+  using npn_classifier_t = std::function<tt(const tt&, boost::dynamic_bitset<>&, std::vector<unsigned>&)>;
+
+  /* the table has 2^log_capacity slots and accepts new entries until it is 3/4 full,
+     if filename is given and exists, it is mapped as snapshot */
+  explicit npn_cache( unsigned log_capacity = 16u, const std::string& filename = std::string() );
+
+  /* smallest log_capacity whose table accepts num_entries entries */
+  static unsigned log_capacity_for( std::size_t num_entries );
+
+  npn_cache( const npn_cache& ) = delete;
+  npn_cache& operator=( const npn_cache& ) = delete;
+
+  /* returns false if func is not cached, functions with more than 6 inputs are never cached */
+  bool lookup( const tt& func, tt& npn, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm ) const;
+
+  /* returns false if the entry was not added, e.g., since the table is full */
+  bool insert( const tt& func, const tt& npn, const boost::dynamic_bitset<>& phase, const std::vector<unsigned>& perm );
+
+  /* looks up func and calls npn_func on a miss */
+  tt compute( const tt& func, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const npn_classifier_t& npn_func );
+
+  /* writes all entries (snapshot and new ones) as snapshot into filename */
+  void save( const std::string& filename ) const;
+
+  /* saves to the snapshot file given in the constructor if new entries were added */
+  bool persist() const;
+
+  std::size_t size() const;
+  std::size_t capacity() const;
+  unsigned long hits() const;
+  unsigned long misses() const;
+
+  void print_statistics( std::ostream& os = std::cout ) const;
+
+private:
+  struct record_t
+  {
+    uint64_t func;
+    uint64_t npn;
+    uint64_t info; /* number of variables (4 bits), phase (7 bits), and permutation (6 x 3 bits) */
+  };
+
+  struct slot_t
+  {
+    std::atomic<uint32_t> state;
+    record_t              record;
+  };
+
+  static bool encode( const tt& func, const tt& npn, const boost::dynamic_bitset<>& phase, const std::vector<unsigned>& perm, record_t& record );
+  static void decode( const record_t& record, tt& npn, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm );
+
+  std::size_t slot_index( uint64_t func, unsigned num_vars ) const;
+  const record_t* find( uint64_t func, unsigned num_vars ) const;
+
+private:
+  unsigned                     log_capacity;
+  std::unique_ptr<slot_t[]>    slots;
+  std::size_t                  max_entries;
+  std::atomic<std::size_t>     num_entries;
+
+  std::string                  filename;
+  std::unique_ptr<mapped_file> snapshot;
+  const record_t*              snapshot_begin = nullptr;
+  const record_t*              snapshot_end   = nullptr;
+
+  mutable std::atomic<unsigned long> cache_hit;
+  mutable std::atomic<unsigned long> cache_miss;
+};
+
+/**
+ * @brief Process-wide cache for the NPN classifier called `name'
+ *
+ * All calls with the same name return the same cache.  If CIRKIT_HOME is
+ * set, the cache is backed by the file $CIRKIT_HOME/npn_<name>.cache, which
+ * is rewritten when the owner calls persist(); callers only use it on request
+ * of the user (e.g., npn --cache).
+ */
+npn_cache::ptr shared_npn_cache( const std::string& name );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
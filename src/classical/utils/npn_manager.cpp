@@ -28,6 +28,7 @@
 
 #include <boost/format.hpp>
 
+#include <core/utils/profiler.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/npn_canonization.hpp>
 
@@ -46,54 +47,76 @@ namespace cirkit
  * Public functions                                                           *
  ******************************************************************************/
 
-npn_manager::npn_manager( unsigned hash_table_size, const npn_classifier_t& npn_func )
-  : table( hash_table_size ),
+npn_manager::npn_manager( unsigned hash_table_size, const npn_classifier_t& npn_func, const npn_cache::ptr& cache )
+  : _cache( cache ),
+    wide_table_size( hash_table_size ),
     npn_func( npn_func )
 {
+  if ( !_cache && hash_table_size > 0u )
+  {
+    _cache = std::make_shared<npn_cache>( npn_cache::log_capacity_for( hash_table_size ) );
+  }
 }
 
 tt npn_manager::compute( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
 {
+  static auto& profile_hit  = get_profile_counter( "npn.cache_hit" );
+  static auto& profile_miss = get_profile_counter( "npn.cache_miss" );
+  static auto& profile_time = get_profile_timer( "npn.canonization" );
+
   boost::dynamic_bitset<> npn;
 
-  /* compute NPN and use hash table if possible */
-  if ( !table.empty() )
-  {
-    const auto ttu      = tt.to_ulong();
-    const auto hash_key = ttu % table.size();
-    auto& entry         = table[hash_key];
+  /* npn_cache only holds functions with up to 6 inputs, wider ones go to wide_table */
+  const auto wide = tt.size() > 64u;
+  const auto key  = wide ? to_string( tt ) : std::string();
 
-    if ( entry.tt == to_string( tt ) )
+  /* compute NPN and use cache if possible */
+  if ( wide )
+  {
+    const auto it = wide_table.find( key );
+    if ( it != wide_table.end() )
     {
       ++cache_hit;
-      npn = boost::dynamic_bitset<>( entry.npn );
-      perm = std::vector<unsigned>( entry.perm );
-      phase = boost::dynamic_bitset<>( entry.phase );
-    }
-    else
-    {
-      ++cache_miss;
-      increment_timer t( &runtime );
-      npn = npn_func( tt, phase, perm );
-
-      entry.tt    = to_string( tt );
-      entry.npn   = to_string( npn );
-      entry.perm  = perm;
-      entry.phase = phase;
+      profile_hit.add();
+      npn   = it->second.npn;
+      phase = it->second.phase;
+      perm  = it->second.perm;
+      return npn;
     }
   }
-  else
+  else if ( _cache && _cache->lookup( tt, npn, phase, perm ) )
+  {
+    ++cache_hit;
+    profile_hit.add();
+    return npn;
+  }
+
+  ++cache_miss;
+  profile_miss.add();
   {
     increment_timer t( &runtime );
+    profile_scope pt( profile_time );
     npn = npn_func( tt, phase, perm );
   }
 
+  if ( wide )
+  {
+    if ( wide_table.size() < wide_table_size )
+    {
+      wide_table.emplace( key, wide_entry_t{npn, phase, perm} );
+    }
+  }
+  else if ( _cache )
+  {
+    _cache->insert( tt, npn, phase, perm );
+  }
+
   return npn;
 }
 
 void npn_manager::print_statistics( std::ostream& os ) const
 {
-  os << boost::format( "[i] NPN manager: size = %d   cache hits = %d   cache misses = %d   run-time = %.2f secs" ) % table.size() % cache_hit % cache_miss % runtime << std::endl;
+  os << boost::format( "[i] NPN manager: size = %d   cache hits = %d   cache misses = %d   run-time = %.2f secs" ) % ( ( _cache ? _cache->size() : 0u ) + wide_table.size() ) % cache_hit % cache_miss % runtime << std::endl;
 }
 
 }
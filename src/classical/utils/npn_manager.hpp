@@ -38,11 +38,14 @@
 
 #include <functional>
 #include <iostream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include <classical/functions/npn_canonization.hpp>
+#include <classical/utils/npn_cache.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 namespace cirkit
@@ -58,35 +61,37 @@ inline std::function<tt(const tt&, boost::dynamic_bitset<>&, std::vector<unsigne
 class npn_manager
 {
 public:
-  using npn_classifier_t = std::function<tt(const tt&, boost::dynamic_bitset<>&, std::vector<unsigned>&)>;
+  using npn_classifier_t = npn_cache::npn_classifier_t;
 
-  npn_manager( unsigned hash_table_size = 4096, const npn_classifier_t& npn_func = make_exact_npn_canonization_wrapper() );
+  /* uses a private cache of about hash_table_size entries (0 disables caching), unless
+     cache is given, which may be shared with other threads (e.g., shared_npn_cache);
+     functions with more than 6 inputs are kept in a separate map of at most
+     hash_table_size entries */
+  npn_manager( unsigned hash_table_size = 4096, const npn_classifier_t& npn_func = make_exact_npn_canonization_wrapper(),
+               const npn_cache::ptr& cache = npn_cache::ptr() );
 
   tt compute( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm );
   void print_statistics( std::ostream& os = std::cout ) const;
 
+  inline const npn_cache::ptr& cache() const { return _cache; }
+
 private:
-  struct table_entry_t
+  struct wide_entry_t
   {
-    table_entry_t() {}
-    table_entry_t( const std::string& tt, const std::string& npn, const std::vector<unsigned>& perm, const boost::dynamic_bitset<>& phase )
-      : tt( tt ), npn( npn ), perm( perm ), phase( phase ) {}
-
-    std::string             tt;
-    std::string             npn;
-    std::vector<unsigned>   perm;
+    tt                      npn;
     boost::dynamic_bitset<> phase;
+    std::vector<unsigned>   perm;
   };
 
-  using table_t = std::vector<table_entry_t>;
-
-  table_t          table;
+  npn_cache::ptr                                _cache;
+  std::unordered_map<std::string, wide_entry_t> wide_table;
+  unsigned                                      wide_table_size;
 
-  npn_classifier_t npn_func;
+  npn_classifier_t                              npn_func;
 
-  double           runtime    = 0.0;
-  unsigned long    cache_hit  = 0;
-  unsigned long    cache_miss = 0;
+  double                                        runtime    = 0.0;
+  unsigned long                                 cache_hit  = 0;
+  unsigned long                                 cache_miss = 0;
 };
 
 }
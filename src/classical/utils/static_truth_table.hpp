@@ -0,0 +1,463 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file static_truth_table.hpp
+ *
+ * @brief Fixed-width truth tables for small functions
+ *
+ * The truth tables are stored on the stack in an array of 64-bit words and
+ * are meant to replace `tt' in hot loops over small functions, e.g., when
+ * simulating cuts or computing NPN classes, where allocating a dynamic bitset
+ * per function dominates the run-time.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef STATIC_TRUTH_TABLE_HPP
+#define STATIC_TRUTH_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <classical/utils/truth_table_utils.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @brief Projection functions x_0, ..., x_5 within one word
+ */
+static constexpr uint64_t static_tt_projections[] = {
+  UINT64_C( 0xaaaaaaaaaaaaaaaa ),
+  UINT64_C( 0xcccccccccccccccc ),
+  UINT64_C( 0xf0f0f0f0f0f0f0f0 ),
+  UINT64_C( 0xff00ff00ff00ff00 ),
+  UINT64_C( 0xffff0000ffff0000 ),
+  UINT64_C( 0xffffffff00000000 )
+};
+
+/**
+ * @brief Truth table with a fixed number of variables
+ *
+ * Functions with less than 6 variables are stored in the lower bits of a
+ * single word, all other bits are kept 0.
+ */
+template<unsigned NumVars>
+class static_tt
+{
+  static_assert( NumVars <= 8u, "static_tt supports at most 8 variables" );
+
+public:
+  static constexpr unsigned num_vars  = NumVars;
+  static constexpr unsigned num_words = NumVars <= 6u ? 1u : 1u << ( NumVars - 6u );
+  static constexpr unsigned num_bits  = 1u << NumVars;
+  static constexpr uint64_t word_mask = NumVars >= 6u ? ~UINT64_C( 0 ) : ( UINT64_C( 1 ) << ( num_bits & 63u ) ) - 1u;
+
+  using words_t = std::array<uint64_t, num_words>;
+
+  static_tt() { _words.fill( 0u ); }
+
+  static inline static_tt const0() { return static_tt(); }
+  static inline static_tt const1() { return ~static_tt(); }
+
+  static static_tt nth_var( unsigned i )
+  {
+    assert( i < NumVars );
+
+    static_tt t;
+    if ( i < 6u )
+    {
+      t._words.fill( static_tt_projections[i] & word_mask );
+    }
+    else
+    {
+      const auto step = 1u << ( i - 6u );
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        if ( w & step ) { t._words[w] = ~UINT64_C( 0 ); }
+      }
+    }
+    return t;
+  }
+
+  inline const words_t& words() const { return _words; }
+  inline words_t& words()             { return _words; }
+
+  inline bool get_bit( unsigned pos ) const
+  {
+    return ( _words[pos >> 6u] >> ( pos & 63u ) ) & 1u;
+  }
+
+  inline void set_bit( unsigned pos, bool value = true )
+  {
+    const auto bit = UINT64_C( 1 ) << ( pos & 63u );
+    if ( value ) { _words[pos >> 6u] |= bit; } else { _words[pos >> 6u] &= ~bit; }
+  }
+
+  unsigned count() const
+  {
+    auto c = 0u;
+    for ( auto w : _words ) { c += __builtin_popcountll( w ); }
+    return c;
+  }
+
+  bool is_const0() const
+  {
+    return std::all_of( _words.begin(), _words.end(), []( uint64_t w ) { return w == 0u; } );
+  }
+
+  inline static_tt operator~() const
+  {
+    static_tt r;
+    for ( auto w = 0u; w < num_words; ++w ) { r._words[w] = ~_words[w] & word_mask; }
+    return r;
+  }
+
+  inline static_tt& operator&=( const static_tt& other ) { for ( auto w = 0u; w < num_words; ++w ) { _words[w] &= other._words[w]; } return *this; }
+  inline static_tt& operator|=( const static_tt& other ) { for ( auto w = 0u; w < num_words; ++w ) { _words[w] |= other._words[w]; } return *this; }
+  inline static_tt& operator^=( const static_tt& other ) { for ( auto w = 0u; w < num_words; ++w ) { _words[w] ^= other._words[w]; } return *this; }
+
+  inline static_tt operator&( const static_tt& other ) const { auto r = *this; return r &= other; }
+  inline static_tt operator|( const static_tt& other ) const { auto r = *this; return r |= other; }
+  inline static_tt operator^( const static_tt& other ) const { auto r = *this; return r ^= other; }
+
+  inline bool operator==( const static_tt& other ) const { return _words == other._words; }
+  inline bool operator!=( const static_tt& other ) const { return _words != other._words; }
+
+  /* same order as for tt, i.e., the most significant bit is compared first */
+  inline bool operator<( const static_tt& other ) const
+  {
+    for ( auto w = num_words; w-- > 0u; )
+    {
+      if ( _words[w] != other._words[w] ) { return _words[w] < other._words[w]; }
+    }
+    return false;
+  }
+
+private:
+  words_t _words;
+};
+
+template<unsigned NumVars>
+inline static_tt<NumVars> tt_maj( const static_tt<NumVars>& a, const static_tt<NumVars>& b, const static_tt<NumVars>& c )
+{
+  return ( a & b ) | ( a & c ) | ( b & c );
+}
+
+template<unsigned NumVars>
+inline unsigned tt_num_vars( const static_tt<NumVars>& t )
+{
+  return NumVars;
+}
+
+/* a static truth table always has NumVars variables, nothing to shrink */
+template<unsigned NumVars>
+inline void tt_shrink( static_tt<NumVars>& t, unsigned to )
+{
+  assert( to == NumVars );
+}
+
+/**
+ * @brief Computes the 0 cofactor (keeps the number of variables)
+ */
+template<unsigned NumVars>
+static_tt<NumVars> tt_cof0( const static_tt<NumVars>& t, unsigned i )
+{
+  assert( i < NumVars );
+
+  auto r = t;
+  auto& w = r.words();
+  if ( i < 6u )
+  {
+    const auto m = ~static_tt_projections[i];
+    const auto s = 1u << i;
+    for ( auto& word : w ) { word = ( word & m ) | ( ( word & m ) << s ); }
+  }
+  else
+  {
+    const auto step = 1u << ( i - 6u );
+    for ( auto k = 0u; k < static_tt<NumVars>::num_words; k += 2u * step )
+    {
+      std::copy( w.begin() + k, w.begin() + k + step, w.begin() + k + step );
+    }
+  }
+  return r;
+}
+
+/**
+ * @brief Computes the 1 cofactor (keeps the number of variables)
+ */
+template<unsigned NumVars>
+static_tt<NumVars> tt_cof1( const static_tt<NumVars>& t, unsigned i )
+{
+  assert( i < NumVars );
+
+  auto r = t;
+  auto& w = r.words();
+  if ( i < 6u )
+  {
+    const auto m = static_tt_projections[i];
+    const auto s = 1u << i;
+    for ( auto& word : w ) { word = ( word & m ) | ( ( word & m ) >> s ); }
+  }
+  else
+  {
+    const auto step = 1u << ( i - 6u );
+    for ( auto k = 0u; k < static_tt<NumVars>::num_words; k += 2u * step )
+    {
+      std::copy( w.begin() + k + step, w.begin() + k + 2u * step, w.begin() + k );
+    }
+  }
+  return r;
+}
+
+template<unsigned NumVars>
+bool tt_has_var( const static_tt<NumVars>& t, unsigned i )
+{
+  assert( i < NumVars );
+
+  const auto& w = t.words();
+  if ( i < 6u )
+  {
+    const auto m = ~static_tt_projections[i];
+    const auto s = 1u << i;
+    return std::any_of( w.begin(), w.end(), [m, s]( uint64_t word ) { return ( ( word >> s ) & m ) != ( word & m ); } );
+  }
+  else
+  {
+    const auto step = 1u << ( i - 6u );
+    for ( auto k = 0u; k < static_tt<NumVars>::num_words; k += 2u * step )
+    {
+      if ( !std::equal( w.begin() + k, w.begin() + k + step, w.begin() + k + step ) ) { return true; }
+    }
+    return false;
+  }
+}
+
+/**
+ * @brief Flips variable i
+ */
+template<unsigned NumVars>
+static_tt<NumVars> tt_flip( const static_tt<NumVars>& t, unsigned i )
+{
+  assert( i < NumVars );
+
+  auto r = t;
+  auto& w = r.words();
+  if ( i < 6u )
+  {
+    const auto m = static_tt_projections[i];
+    const auto s = 1u << i;
+    for ( auto& word : w ) { word = ( ( word & m ) >> s ) | ( ( word << s ) & m ); }
+  }
+  else
+  {
+    const auto step = 1u << ( i - 6u );
+    for ( auto k = 0u; k < static_tt<NumVars>::num_words; k += 2u * step )
+    {
+      std::swap_ranges( w.begin() + k, w.begin() + k + step, w.begin() + k + step );
+    }
+  }
+  return r;
+}
+
+/**
+ * @brief Permutes variables i and j
+ */
+template<unsigned NumVars>
+static_tt<NumVars> tt_permute( const static_tt<NumVars>& t, unsigned i, unsigned j )
+{
+  assert( i < NumVars && j < NumVars );
+
+  if ( i == j ) { return t; }
+  if ( i > j ) { std::swap( i, j ); }
+
+  auto r = t;
+  auto& w = r.words();
+
+  if ( j < 6u )
+  {
+    /* delta swap of the bits in which x_i = 1 and x_j = 0 */
+    const auto m = static_tt_projections[i] & ~static_tt_projections[j];
+    const auto s = ( 1u << j ) - ( 1u << i );
+    for ( auto& word : w )
+    {
+      word = ( word & ~( m | ( m << s ) ) ) | ( ( word & m ) << s ) | ( ( word >> s ) & m );
+    }
+  }
+  else if ( i < 6u )
+  {
+    /* x_j selects between word blocks, x_i between bits in a word */
+    const auto m = static_tt_projections[i];
+    const auto s = 1u << i;
+    const auto step = 1u << ( j - 6u );
+    for ( auto k = 0u; k < static_tt<NumVars>::num_words; k += 2u * step )
+    {
+      for ( auto l = k; l < k + step; ++l )
+      {
+        const auto lo = w[l], hi = w[l + step];
+        w[l]        = ( lo & ~m ) | ( ( hi & ~m ) << s );
+        w[l + step] = ( ( lo & m ) >> s ) | ( hi & m );
+      }
+    }
+  }
+  else
+  {
+    const auto si = 1u << ( i - 6u );
+    const auto sj = 1u << ( j - 6u );
+    for ( auto k = 0u; k < static_tt<NumVars>::num_words; ++k )
+    {
+      if ( ( k & si ) && !( k & sj ) )
+      {
+        std::swap( w[k], w[k - si + sj] );
+      }
+    }
+  }
+
+  return r;
+}
+
+/**
+ * @brief Converts a truth table into a static truth table
+ *
+ * Smaller truth tables are extended (cf. tt_extend), larger ones are cut off
+ * (cf. tt_shrink).
+ */
+template<unsigned NumVars>
+static_tt<NumVars> to_static_tt( const tt& t )
+{
+  using stt = static_tt<NumVars>;
+
+  assert( t.size() > 0u );
+
+  stt r;
+  auto& w = r.words();
+
+  const auto num_blocks = t.num_blocks();
+  if ( num_blocks <= stt::num_words )
+  {
+    boost::to_block_range( t, w.begin() );
+  }
+  else
+  {
+    auto tc = t;
+    tc.resize( stt::num_bits );
+    boost::to_block_range( tc, w.begin() );
+  }
+
+  /* extend */
+  for ( auto s = t.size(); s < 64u && s < stt::num_bits; s <<= 1u )
+  {
+    w[0u] |= w[0u] << s;
+  }
+  for ( auto k = num_blocks; k < stt::num_words; ++k )
+  {
+    w[k] = w[k % num_blocks];
+  }
+  w[0u] &= stt::word_mask;
+
+  return r;
+}
+
+/**
+ * @brief Converts a static truth table into a truth table with 2^NumVars bits
+ */
+template<unsigned NumVars>
+tt from_static_tt( const static_tt<NumVars>& t )
+{
+  tt res( static_tt<NumVars>::num_bits );
+  boost::from_block_range( t.words().begin(), t.words().end(), res );
+  return res;
+}
+
+template<unsigned NumVars>
+inline std::string tt_to_hex( const static_tt<NumVars>& t )
+{
+  return tt_to_hex( from_static_tt( t ) );
+}
+
+/**
+ * @brief Small node to truth table map for cut simulation
+ *
+ * The first Capacity entries are kept on the stack, only large cones spill to
+ * the heap.
+ */
+template<unsigned NumVars, unsigned Capacity = 32u>
+class static_tt_cache
+{
+public:
+  const static_tt<NumVars>* find( std::size_t node ) const
+  {
+    const auto n = std::min( _size, Capacity );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      if ( _nodes[i] == node ) { return &_values[i]; }
+    }
+    for ( const auto& p : _spill )
+    {
+      if ( p.first == node ) { return &p.second; }
+    }
+    return nullptr;
+  }
+
+  void insert( std::size_t node, const static_tt<NumVars>& value )
+  {
+    if ( _size < Capacity )
+    {
+      _nodes[_size] = node;
+      _values[_size] = value;
+    }
+    else
+    {
+      _spill.emplace_back( node, value );
+    }
+    ++_size;
+  }
+
+private:
+  unsigned                                              _size = 0u;
+  std::array<std::size_t, Capacity>                     _nodes;
+  std::array<static_tt<NumVars>, Capacity>              _values;
+  std::vector<std::pair<std::size_t, static_tt<NumVars>>> _spill;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -26,16 +26,22 @@
 
 #include "unate.hpp"
 
+#include <atomic>
 #include <mutex>
+#include <random>
+#include <thread>
 
 #include <boost/assign/std/vector.hpp>
 #include <boost/range/algorithm.hpp>
 
+#include <core/utils/bitset_utils.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/terminal.hpp>
 #include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/aig_cone.hpp>
+#include <classical/functions/aig_support.hpp>
+#include <classical/functions/bit_parallel_simulation.hpp>
 #include <classical/functions/simulate_aig.hpp>
 #include <classical/functions/strash.hpp>
 #include <classical/io/write_aiger.hpp>
@@ -48,6 +54,7 @@
 #include <classical/sat/utils/add_aig.hpp>
 #include <classical/sat/utils/add_aig_with_gia.hpp>
 #include <classical/sat/utils/add_dimacs.hpp>
+#include <classical/sat/utils/incremental_aig_encoder.hpp>
 
 #define timer timer_class
 #include <boost/progress.hpp>
@@ -64,6 +71,41 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+/* records clauses such that a CNF can be generated once and copied into
+   several solvers */
+struct clause_list
+{
+  std::vector<clause_t> clauses;
+};
+
+struct clause_list_adder
+{
+  explicit clause_list_adder( clause_list& list ) : list( list ) {}
+
+  template<typename C>
+  bool add( const C& clause )
+  {
+    list.clauses.emplace_back( clause.begin(), clause.end() );
+    return true;
+  }
+
+private:
+  clause_list& list;
+};
+
+template<>
+class solver_traits<clause_list>
+{
+public:
+  using clause_adder = base_clause_adder<clause_list_adder>;
+};
+
+template<>
+solver_traits<clause_list>::clause_adder add_clause( clause_list& list )
+{
+  return solver_traits<clause_list>::clause_adder( list );
+}
+
 /******************************************************************************
  * Private functions                                                          *
  ******************************************************************************/
@@ -292,6 +334,220 @@ reset_assumptions:
   return result;
 }
 
+/* outputs 2j and 2j + 1 are the dependency and unateness miters of output j,
+   the remaining outputs are the equality constraints for the inputs */
+aig_graph create_unateness_miter( const aig_graph& aig )
+{
+  auto miter = strash( aig );
+  strash( aig, miter );
+  auto& info = aig_info( miter );
+
+  /* connect outputs */
+  std::vector<std::pair<aig_function, std::string>> miter_outputs;
+  const auto m = info.outputs.size() >> 1u;
+  for ( auto i = 0u; i < m; ++i )
+  {
+    auto o1 = info.outputs[i].first;
+    auto o2 = info.outputs[m + i].first;
+    const auto& name = info.outputs[i].second;
+
+    miter_outputs.push_back( {aig_create_xor( miter, o1, o2 ), name + "_dep"} );
+    miter_outputs.push_back( {aig_create_or( miter, !o1, o2 ), name + "_unate"} );
+  }
+  info.outputs = miter_outputs;
+
+  /* connect inputs */
+  const auto n = info.inputs.size() >> 1u;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    const auto& i1 = info.inputs[i];
+    const auto& i2 = info.inputs[n + i];
+
+    info.node_names[i2] = info.node_names[i1] + "_copy";
+
+    aig_create_po( miter, !aig_create_xor( miter, {i1, false}, {i2, false} ), info.node_names[i1] + "_eq" );
+  }
+
+  return miter;
+}
+
+class unateness_engine
+{
+public:
+  unateness_engine( const aig_graph& aig, unsigned sim_words, unsigned seed )
+    : n( aig_info( aig ).inputs.size() ),
+      m( aig_info( aig ).outputs.size() ),
+      sim_words( sim_words ),
+      seed( seed ),
+      simulator( aig, sim_words ),
+      support( n, boost::dynamic_bitset<>( m ) ),
+      result( ( m * n ) << 1u )
+  {
+    /* outputs in the structural support of each input */
+    const auto& info = aig_info( aig );
+    const auto supports = aig_structural_support( aig );
+    for ( auto j = 0u; j < m; ++j )
+    {
+      const auto& s = supports.at( info.outputs[j].first );
+      foreach_bit( s, [&]( unsigned i ) { support[i].set( j ); } );
+    }
+
+    /* the miter is encoded only once */
+    add_aig_with_gia( cnf, create_unateness_miter( aig ), 1, piids, poids );
+  }
+
+  boost::dynamic_bitset<> run( unsigned num_threads )
+  {
+    std::vector<std::thread> workers;
+    for ( auto t = 1u; t < num_threads; ++t )
+    {
+      workers.emplace_back( [this, t]() { work( t ); } );
+    }
+    work( 0u );
+    for ( auto& w : workers )
+    {
+      w.join();
+    }
+
+    return result;
+  }
+
+  double        sat_runtime = 0.0;
+  unsigned long sat_calls = 0ul;
+  unsigned long sim_decided = 0ul;
+
+private:
+  enum class pair_kind { binate = 0u, unate_pos = 1u, unate_neg = 2u, independent = 3u };
+
+  void work( unsigned id )
+  {
+    /* per worker state */
+    auto solver = make_solver<minisat_solver>();
+    solver_gen_model( solver, false );
+    for ( const auto& clause : cnf.clauses )
+    {
+      add_clause( solver )( clause );
+    }
+
+    auto sim = simulator;
+    std::mt19937_64 gen( seed + id );
+    std::vector<uint64_t> cof0( m * sim_words );
+    boost::dynamic_bitset<> rise( m ), fall( m );
+    std::vector<pair_kind> kinds( m );
+
+    double        local_sat_runtime = 0.0;
+    unsigned long local_sat_calls = 0ul, local_sim_decided = 0ul;
+
+    solver_execution_statistics stats;
+    std::vector<int> assumptions( poids.begin() + ( m << 1u ), poids.end() );
+    const auto query = [&]( std::initializer_list<int> lits ) {
+      assumptions.insert( assumptions.end(), lits );
+      const auto sat = solve( solver, stats, assumptions ) != boost::none;
+      assumptions.resize( n );
+      local_sat_runtime += stats.runtime;
+      ++local_sat_calls;
+      return sat;
+    };
+
+    for ( auto i = next_input++; i < n; i = next_input++ )
+    {
+      std::fill( kinds.begin(), kinds.end(), pair_kind::independent );
+
+      if ( support[i].any() )
+      {
+        /* simulate both cofactors with respect to input i */
+        for ( auto k = 0u; k < n; ++k )
+        {
+          std::generate( sim.input( k ), sim.input( k ) + sim_words, std::ref( gen ) );
+        }
+        std::fill( sim.input( i ), sim.input( i ) + sim_words, UINT64_C( 0 ) );
+        sim.simulate();
+        for ( auto j = 0u; j < m; ++j )
+        {
+          for ( auto w = 0u; w < sim_words; ++w )
+          {
+            cof0[j * sim_words + w] = sim.output_word( j, w );
+          }
+        }
+        std::fill( sim.input( i ), sim.input( i ) + sim_words, ~UINT64_C( 0 ) );
+        sim.simulate();
+
+        rise.reset();
+        fall.reset();
+        for ( auto j = 0u; j < m; ++j )
+        {
+          for ( auto w = 0u; w < sim_words; ++w )
+          {
+            const auto c0 = cof0[j * sim_words + w], c1 = sim.output_word( j, w );
+            if ( ~c0 & c1 ) { rise.set( j ); }
+            if ( c0 & ~c1 ) { fall.set( j ); }
+          }
+        }
+
+        /* SAT queries for the remaining pairs */
+        assumptions[i] *= -1;                                          /* input i should be different */
+        foreach_bit( support[i], [&]( unsigned j ) {
+            if ( rise[j] && fall[j] )
+            {
+              kinds[j] = pair_kind::binate;
+              ++local_sim_decided;
+              return;
+            }
+
+            if ( !rise[j] && !fall[j] && !query( {poids[j << 1u]} ) ) /* force XOR gate to be 1 */
+            {
+              return;
+            }
+
+            if ( !rise[j] && !query( {-poids[( j << 1u ) + 1u], piids[i], -piids[n + i]} ) ) /* can output rise? */
+            {
+              kinds[j] = pair_kind::unate_neg;
+              return;
+            }
+
+            if ( !fall[j] && !query( {-poids[( j << 1u ) + 1u], -piids[i], piids[n + i]} ) ) /* can output fall? */
+            {
+              kinds[j] = pair_kind::unate_pos;
+              return;
+            }
+
+            kinds[j] = pair_kind::binate;
+          } );
+        assumptions[i] *= -1;
+      }
+
+      std::lock_guard<std::mutex> lock( mutex );
+      for ( auto j = 0u; j < m; ++j )
+      {
+        const auto pos = ( j * n + i ) << 1u;
+        result[pos]      = static_cast<unsigned>( kinds[j] ) & 2u; /* unate_neg or independent */
+        result[pos + 1u] = static_cast<unsigned>( kinds[j] ) & 1u; /* unate_pos or independent */
+      }
+    }
+
+    std::lock_guard<std::mutex> lock( mutex );
+    sat_runtime += local_sat_runtime;
+    sat_calls   += local_sat_calls;
+    sim_decided += local_sim_decided;
+  }
+
+private:
+  const unsigned                       n;
+  const unsigned                       m;
+  const unsigned                       sim_words;
+  const unsigned                       seed;
+
+  bit_parallel_simulator               simulator;
+  std::vector<boost::dynamic_bitset<>> support;
+
+  clause_list                          cnf;
+  std::vector<int>                     piids, poids;
+
+  std::atomic<unsigned>                next_input{ 0u };
+  std::mutex                           mutex;
+  boost::dynamic_bitset<>              result;
+};
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -315,10 +571,10 @@ boost::dynamic_bitset<> unateness_naive( const aig_graph& aig,
   solver_execution_statistics stats;
   auto sid = 1;
 
-  /* build miter */
-  std::vector<int> piids1, piids2, poids1, poids2;
-  sid = add_aig( solver, aig, sid, piids1, poids1 );
-  sid = add_aig( solver, aig, sid, piids2, poids2 );
+  /* build miter, output cones are encoded when they are queried */
+  incremental_aig_encoder<minisat_solver> copy1( solver, aig, sid ), copy2( solver, aig, sid );
+  const auto piids1 = copy1.input_literals();
+  const auto piids2 = copy2.input_literals();
 
   /* connect inputs */
   const auto n = info.inputs.size();
@@ -329,17 +585,7 @@ boost::dynamic_bitset<> unateness_naive( const aig_graph& aig,
     input_xnors[i] = sid++;
   }
 
-  /* connect outputs */
   const auto m = info.outputs.size();
-  std::vector<int> output_xors( n ), output_ors( n );
-  for ( auto j = 0u; j < m; ++j )
-  {
-    logic_xor( solver, poids1[j], poids2[j], sid );
-    output_xors[j] = sid++;
-
-    logic_or( solver, -poids1[j], poids2[j], sid );
-    output_ors[j] = sid++;
-  }
 
   /* iterate over output/input pairs */
   null_stream ns;
@@ -350,6 +596,16 @@ boost::dynamic_bitset<> unateness_naive( const aig_graph& aig,
   auto pos = 0u;
   for ( auto j = 0u; j < m; ++j )
   {
+    /* connect outputs */
+    const auto o1 = copy1.output_literal( j );
+    const auto o2 = copy2.output_literal( j );
+
+    logic_xor( solver, o1, o2, sid );
+    const auto output_xor = sid++;
+
+    logic_or( solver, -o1, o2, sid );
+    const auto output_or = sid++;
+
     for ( auto i = 0u; i < n; ++i )
     {
       ++show_progress;
@@ -362,7 +618,7 @@ boost::dynamic_bitset<> unateness_naive( const aig_graph& aig,
       assumptions += piids1[i],-piids2[i];
 
       /* check for support */
-      assumptions += output_xors[j];
+      assumptions += output_xor;
 
       if ( solve( solver, stats, assumptions ) == boost::none ) /* unsat */
       {
@@ -371,7 +627,7 @@ boost::dynamic_bitset<> unateness_naive( const aig_graph& aig,
       }
 
       /* check for negative unate */
-      assumptions.back() = -output_ors[j];
+      assumptions.back() = -output_or;
 
       if ( solve( solver, stats, assumptions ) == boost::none ) /* unsat */
       {
@@ -522,35 +778,9 @@ boost::dynamic_bitset<> unateness( const aig_graph& aig,
   auto sat_runtime = 0.0;
 
   /* create miter */
-  auto miter = strash( aig );
-  strash( aig, miter );
-  auto& info = aig_info( miter );
-
-  /* connect outputs */
-  std::vector<std::pair<aig_function, std::string>> miter_outputs;
-  const auto m = info.outputs.size() >> 1u;
-  for ( auto i = 0u; i < m; ++i )
-  {
-    auto o1 = info.outputs[i].first;
-    auto o2 = info.outputs[m + i].first;
-    const auto& name = info.outputs[i].second;
-
-    miter_outputs.push_back( {aig_create_xor( miter, o1, o2 ), name + "_dep"} );
-    miter_outputs.push_back( {aig_create_or( miter, !o1, o2 ), name + "_unate"} );
-  }
-  info.outputs = miter_outputs;
-
-  /* connect inputs */
-  const auto n = info.inputs.size() >> 1u;
-  for ( auto i = 0u; i < n; ++i )
-  {
-    const auto& i1 = info.inputs[i];
-    const auto& i2 = info.inputs[n + i];
-
-    info.node_names[i2] = info.node_names[i1] + "_copy";
-
-    aig_create_po( miter, !aig_create_xor( miter, {i1, false}, {i2, false} ), info.node_names[i1] + "_eq" );
-  }
+  const auto miter = create_unateness_miter( aig );
+  const auto m = aig_info( aig ).outputs.size();
+  const auto n = aig_info( aig ).inputs.size();
 
   /* create solver */
   auto solver = make_solver<minisat_solver>();
@@ -650,6 +880,28 @@ reset_assumptions:
   return result;
 }
 
+boost::dynamic_bitset<> unateness_concurrent( const aig_graph& aig,
+                                              const properties::ptr& settings,
+                                              const properties::ptr& statistics )
+{
+  /* settings */
+  const auto num_threads = get( settings, "num_threads", 0u );
+  const auto sim_words   = get( settings, "sim_words", 4u );
+  const auto seed        = get( settings, "seed", 0u );
+
+  /* timer */
+  properties_timer t( statistics );
+
+  unateness_engine engine( aig, sim_words, seed );
+  const auto result = engine.run( num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads );
+
+  set( statistics, "sat_runtime", engine.sat_runtime );
+  set( statistics, "sat_calls", engine.sat_calls );
+  set( statistics, "sim_decided", engine.sim_decided );
+
+  return result;
+}
+
 }
 
 // Local Variables:
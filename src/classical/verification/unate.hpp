@@ -75,6 +75,28 @@ boost::dynamic_bitset<> unateness( const aig_graph& aig,
                                    const properties::ptr& settings = properties::ptr(),
                                    const properties::ptr& statistics = properties::ptr() );
 
+/**
+ * The miter is encoded once and copied into one incremental solver per
+ * worker thread.  Workers take inputs from a shared queue and answer all
+ * queries for that input in one batch.  Random simulation of both cofactors
+ * decides binate pairs and skips SAT calls that cannot be UNSAT, pairs
+ * outside the structural support are independent without any SAT call.
+ *
+ * settings:
+ *   num_threads: number of workers (0: number of cores)
+ *   sim_words:   number of 64-bit words of random patterns per input
+ *   seed:        random seed for simulation
+ *
+ * statistics:
+ *   runtime:     run-time
+ *   sat_runtime: accumulated SAT run-time over all workers
+ *   sat_calls:   number of SAT calls
+ *   sim_decided: number of pairs decided by simulation
+ */
+boost::dynamic_bitset<> unateness_concurrent( const aig_graph& aig,
+                                              const properties::ptr& settings = properties::ptr(),
+                                              const properties::ptr& statistics = properties::ptr() );
+
 }
 
 #endif
@@ -76,6 +76,16 @@ void xmg_graph::compute_levels()
   levels.update( [this]() { return xmg_compute_levels( *this ); } );
 }
 
+void xmg_graph::reserve( std::size_t num_nodes )
+{
+  g.m_vertices.reserve( num_nodes );
+  maj_strash.reserve( num_nodes );
+  if ( _native_xor )
+  {
+    xor_strash.reserve( num_nodes / 4u );
+  }
+}
+
 xmg_function xmg_graph::get_constant( bool value ) const
 {
   return xmg_function( constant, value );
@@ -126,12 +136,17 @@ xmg_function xmg_graph::create_maj( const xmg_function& a, const xmg_function& b
     children[2].complemented = !children[2].complemented;
   }
 
-  auto key = std::make_tuple( children[0], children[1], children[2] );
+  const strash_table<3u>::key_t key = {{strash_table<3u>::make_literal( children[0].node, children[0].complemented ),
+                                         strash_table<3u>::make_literal( children[1].node, children[1].complemented ),
+                                         strash_table<3u>::make_literal( children[2].node, children[2].complemented )}};
 
-  const auto it = maj_strash.find( key );
-  if ( _enable_structural_hashing && it != maj_strash.end() )
+  if ( _enable_structural_hashing )
   {
-    return xmg_function( it->second, node_complement );
+    const auto existing = maj_strash.find( key );
+    if ( existing != strash_table<3u>::empty )
+    {
+      return xmg_function( existing, node_complement );
+    }
   }
 
   /* insert node */
@@ -148,7 +163,8 @@ xmg_function xmg_graph::create_maj( const xmg_function& a, const xmg_function& b
 
   mark_as_modified();
 
-  maj_strash[key] = node;
+  /* always recorded, so that re-enabling structural hashing finds nodes created in between */
+  maj_strash.insert_or_assign( key, node );
   return xmg_function( node, node_complement );
 }
 
@@ -174,10 +190,16 @@ xmg_function xmg_graph::create_xor( const xmg_function& a, const xmg_function& b
       key.first.complemented = key.second.complemented = false;
     }
 
-    const auto it = xor_strash.find( key );
-    if ( _enable_structural_hashing && it != xor_strash.end() )
+    const strash_table<2u>::key_t skey = {{strash_table<2u>::make_literal( key.first.node, key.first.complemented ),
+                                           strash_table<2u>::make_literal( key.second.node, key.second.complemented )}};
+
+    if ( _enable_structural_hashing )
     {
-      return xmg_function( it->second, node_complement );
+      const auto existing = xor_strash.find( skey );
+      if ( existing != strash_table<2u>::empty )
+      {
+        return xmg_function( existing, node_complement );
+      }
     }
 
     /* insert node */
@@ -192,7 +214,8 @@ xmg_function xmg_graph::create_xor( const xmg_function& a, const xmg_function& b
 
     mark_as_modified();
 
-    xor_strash[key] = node;
+    /* always recorded, so that re-enabling structural hashing finds nodes created in between */
+    xor_strash.insert_or_assign( skey, node );
     return xmg_function( node, node_complement );
   }
   else
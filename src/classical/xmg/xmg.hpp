@@ -48,6 +48,7 @@
 #include <core/utils/dirty.hpp>
 #include <core/utils/graph_utils.hpp>
 #include <core/utils/hash_utils.hpp>
+#include <core/utils/strash_table.hpp>
 
 namespace cirkit
 {
@@ -95,6 +96,8 @@ namespace cirkit
 
 class xmg_cover;
 class xmg_bitmarks;
+class binary_writer;
+class binary_reader;
 
 class xmg_graph
 {
@@ -117,6 +120,9 @@ public:
   void compute_parents();
   void compute_levels();
 
+  /* reserve room for about num_nodes nodes, e.g., the size of the source network when rewriting */
+  void reserve( std::size_t num_nodes );
+
   xmg_function get_constant( bool value ) const;
   xmg_function create_pi( const std::string& name );
   void create_po( const xmg_function& f, const std::string& name );
@@ -188,6 +194,9 @@ public: /* properties */
   inline bool has_inverter_propagation() const         { return _enable_inverter_propagation; }
 
 private:
+  friend void write_snapshot( binary_writer& writer, const xmg_graph& xmg );
+  friend void read_snapshot( binary_reader& reader, xmg_graph& xmg );
+
   graph_t g;
   node_t  constant;
 
@@ -196,10 +205,8 @@ private:
   output_vec_t _outputs;
   std::unordered_map<xmg_node, unsigned> _input_to_id;
 
-  using maj_strash_key_t = std::tuple<xmg_function, xmg_function, xmg_function>;
-  using xor_strash_key_t = std::pair<xmg_function, xmg_function>;
-  std::unordered_map<maj_strash_key_t, node_t, hash<maj_strash_key_t>> maj_strash;
-  std::unordered_map<xor_strash_key_t, node_t, hash<xor_strash_key_t>> xor_strash;
+  strash_table<3u> maj_strash;
+  strash_table<2u> xor_strash;
 
   complement_property_map_t               _complement;
 
@@ -157,6 +157,7 @@ xmg_graph xmg_from_aig( const aig_graph& aig )
   const auto& info = aig_info( aig );
 
   xmg_graph xmg( info.model_name );
+  xmg.reserve( boost::num_vertices( aig ) );
 
   std::unordered_map<aig_node, xmg_function> node_to_function;
   node_to_function.insert( {0, xmg.get_constant( false )} );
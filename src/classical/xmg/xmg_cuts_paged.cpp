@@ -114,12 +114,15 @@ xmg_cuts_paged::xmg_cuts_paged( xmg_graph& xmg, unsigned k, const properties::pt
     _priority( get( settings, "priority", 8u ) ),
     _extra( get( settings, "extra", 0u ) ),
     _progress( get( settings, "progress", false ) ),
+    _priority_cuts( get( settings, "priority_cuts", false ) && k <= priority_cut::max_leaves ),
+    _cut_cost( get( settings, "cut_cost", cut_cost_t::depth ) ),
     data( _xmg.size(), 2u + _extra ),
     cones( _xmg.size() )
 {
   unsigned max_level;
   _levels = compute_level_ranges( xmg, max_level );
 
+  init_priority_cuts();
   enumerate();
 }
 
@@ -130,10 +133,13 @@ xmg_cuts_paged::xmg_cuts_paged( xmg_graph& xmg, unsigned k, const std::vector<xm
     _priority( get( settings, "priority", 8u ) ),
     _extra( get( settings, "extra", 0u ) ),
     _progress( get( settings, "progress", false ) ),
+    _priority_cuts( get( settings, "priority_cuts", false ) && k <= priority_cut::max_leaves ),
+    _cut_cost( get( settings, "cut_cost", cut_cost_t::depth ) ),
     data( _xmg.size(), 2u + _extra ),
     cones( _xmg.size() ),
     _levels( levels )
 {
+  init_priority_cuts();
   enumerate_partial( start, boundary );
 }
 
@@ -174,6 +180,23 @@ boost::iterator_range<paged_memory::iterator> xmg_cuts_paged::cut_cones( xmg_nod
 
 tt xmg_cuts_paged::simulate( xmg_node node, const xmg_cuts_paged::cut& c ) const
 {
+  switch ( c.size() )
+  {
+  case 0u: case 1u: case 2u: case 3u: case 4u: case 5u: case 6u:
+    {
+      auto tt = from_static_tt( simulate<6u>( node, c ) );
+      if ( c.size() < 6u )
+      {
+        tt_shrink( tt, c.size() );
+      }
+      return tt;
+    }
+  case 7u:
+    return from_static_tt( simulate<7u>( node, c ) );
+  case 8u:
+    return from_static_tt( simulate<8u>( node, c ) );
+  }
+
   std::vector<xmg_node> leafs;
   for ( auto child : c )
   {
@@ -182,6 +205,20 @@ tt xmg_cuts_paged::simulate( xmg_node node, const xmg_cuts_paged::cut& c ) const
   return xmg_simulate_cut( _xmg, node, leafs );
 }
 
+template<unsigned NumVars>
+static_tt<NumVars> xmg_cuts_paged::simulate( xmg_node node, const xmg_cuts_paged::cut& c ) const
+{
+  return xmg_simulate_cut<NumVars>( _xmg, node, c.begin(), c.end() );
+}
+
+template static_tt<2u> xmg_cuts_paged::simulate<2u>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template static_tt<3u> xmg_cuts_paged::simulate<3u>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template static_tt<4u> xmg_cuts_paged::simulate<4u>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template static_tt<5u> xmg_cuts_paged::simulate<5u>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template static_tt<6u> xmg_cuts_paged::simulate<6u>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template static_tt<7u> xmg_cuts_paged::simulate<7u>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template static_tt<8u> xmg_cuts_paged::simulate<8u>( xmg_node, const xmg_cuts_paged::cut& ) const;
+
 unsigned xmg_cuts_paged::depth( xmg_node node, const xmg_cuts_paged::cut& c ) const
 {
   return c.extra( 0u );
@@ -256,7 +293,7 @@ void xmg_cuts_paged::enumerate()
         cns.push_back( c.node );
       }
 
-      enumerate_node_with_bitsets( n, cns );
+      enumerate_node( n, cns );
 
       data.append_singleton( n, n, get_extra( 0u, 1u ) );
       cones.append_singleton( n, n );
@@ -362,7 +399,7 @@ void xmg_cuts_paged::enumerate_with_xor_blocks( const std::unordered_map<xmg_nod
         cns.push_back( c.node );
       }
 
-      enumerate_node_with_bitsets( n, cns );
+      enumerate_node( n, cns );
 
       data.append_singleton( n, n, get_extra( 0u, 1u ) );
       cones.append_singleton( n, n );
@@ -440,7 +477,7 @@ void xmg_cuts_paged::enumerate_partial( const std::vector<xmg_node>& start, cons
     }
 
     _top_index = _xmg.size();
-    enumerate_node_with_bitsets( n, cns );
+    enumerate_node( n, cns );
 
     data.append_singleton( n, n, get_extra( 0u, 1u ) );
     cones.append_singleton( n, n );
@@ -587,6 +624,18 @@ xmg_cuts_paged::local_cut_vec_t xmg_cuts_paged::enumerate_local_cuts( const std:
   return local_cuts;
 }
 
+void xmg_cuts_paged::enumerate_node( xmg_node n, const std::vector<xmg_node>& ns )
+{
+  if ( _priority_cuts )
+  {
+    enumerate_node_with_priority_cuts( n, ns );
+  }
+  else
+  {
+    enumerate_node_with_bitsets( n, ns );
+  }
+}
+
 void xmg_cuts_paged::enumerate_node_with_bitsets( xmg_node n, const std::vector<xmg_node>& ns )
 {
   for ( const auto& cut : enumerate_local_cuts( ns, _top_index ) )
@@ -600,6 +649,126 @@ void xmg_cuts_paged::enumerate_node_with_bitsets( xmg_node n, const std::vector<
   }
 }
 
+void xmg_cuts_paged::enumerate_node_with_priority_cuts( xmg_node n, const std::vector<xmg_node>& ns )
+{
+  assert( ns.size() == 2u || ns.size() == 3u );
+
+  /* cuts of the children, cuts from XOR blocks may be too large */
+  std::vector<std::vector<priority_cut>> child_cuts( ns.size() );
+  for ( auto i = 0u; i < ns.size(); ++i )
+  {
+    for ( const auto& c : cuts( ns[i] ) )
+    {
+      if ( c.size() > _k ) { continue; }
+
+      priority_cut pc;
+      for ( auto leaf : c )
+      {
+        pc.leaves[pc.size++] = leaf;
+        pc.signature |= priority_cut::leaf_signature( leaf );
+      }
+      child_cuts[i].push_back( pc );
+    }
+  }
+
+  priority_cut_set local_cuts( _priority, _cut_cost );
+
+  const auto add = [this, n, &local_cuts]( priority_cut& cut ) {
+    cut.depth = 0u;
+    cut.area_flow = 1.0f;
+    cut.data = std::numeric_limits<unsigned>::max(); /* min level */
+    for ( auto leaf : cut )
+    {
+      cut.depth = std::max( cut.depth, _node_depth[leaf] );
+      cut.area_flow += _node_flow[leaf] / std::max( 1u, _fanout[leaf] );
+      cut.data = std::min( cut.data, _levels[leaf].second );
+    }
+    ++cut.depth;
+
+    if ( _cut_cost == cut_cost_t::cone_size )
+    {
+      cut.cone_size = compute_cone( n, cut ).size() - cut.size;
+    }
+
+    local_cuts.insert( cut );
+  };
+
+  priority_cut partial_cut, new_cut;
+  for ( const auto& c1 : child_cuts[0u] )
+  {
+    for ( const auto& c2 : child_cuts[1u] )
+    {
+      if ( ns.size() == 2u )
+      {
+        if ( new_cut.merge( c1, c2, _k ) ) { add( new_cut ); }
+        continue;
+      }
+
+      if ( !partial_cut.merge( c1, c2, _k ) ) { continue; }
+      for ( const auto& c3 : child_cuts[2u] )
+      {
+        if ( new_cut.merge( partial_cut, c3, _k ) ) { add( new_cut ); }
+      }
+    }
+  }
+
+  for ( const auto& cut : local_cuts )
+  {
+    const auto cone = compute_cone( n, cut );
+    data.append_set( n, cut.to_vector(), get_extra( _levels[n].first - cut.data, cone.size() ) );
+    cones.append_set( n, cone );
+  }
+
+  if ( !local_cuts.empty() )
+  {
+    _node_depth[n] = local_cuts.best().depth;
+    _node_flow[n] = local_cuts.best().area_flow;
+  }
+}
+
+/* all nodes between the root and the leaves, including both, without the constant */
+std::vector<unsigned> xmg_cuts_paged::compute_cone( xmg_node node, const priority_cut& cut ) const
+{
+  std::vector<unsigned> cone;
+  std::vector<xmg_node> stack{node};
+
+  while ( !stack.empty() )
+  {
+    const auto n = stack.back();
+    stack.pop_back();
+
+    if ( n == 0u || boost::find( cone, n ) != cone.end() ) { continue; }
+    cone.push_back( n );
+
+    if ( std::binary_search( cut.begin(), cut.end(), n ) ) { continue; }
+    for ( const auto& c : _xmg.children( n ) )
+    {
+      stack.push_back( c.node );
+    }
+  }
+
+  boost::sort( cone );
+  return cone;
+}
+
+void xmg_cuts_paged::init_priority_cuts()
+{
+  if ( !_priority_cuts ) { return; }
+
+  _fanout.resize( _xmg.size(), 0u );
+  _node_depth.resize( _xmg.size(), 0u );
+  _node_flow.resize( _xmg.size(), 0.0f );
+
+  for ( const auto& n : _xmg.nodes() )
+  {
+    if ( _xmg.is_input( n ) ) { continue; }
+    for ( const auto& c : _xmg.children( n ) )
+    {
+      ++_fanout[c.node];
+    }
+  }
+}
+
 std::vector<unsigned> xmg_cuts_paged::get_extra( unsigned depth, unsigned size ) const
 {
   std::vector<unsigned> v( 2u + _extra, 0u );
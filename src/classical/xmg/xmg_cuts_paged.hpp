@@ -45,8 +45,10 @@
 
 #include <core/properties.hpp>
 #include <core/utils/paged_memory.hpp>
+#include <classical/functions/cuts/priority.hpp>
 #include <classical/xmg/xmg.hpp>
 #include <classical/xmg/xmg_xor_blocks.hpp>
+#include <classical/utils/static_truth_table.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 namespace cirkit
@@ -61,6 +63,10 @@ public:
   using cut = paged_memory::set;
   using cone = paged_memory::set;
 
+  /* If the setting priority_cuts is true, each node keeps the priority many
+   * best cuts with respect to cut_cost (see priority.hpp), cones are computed
+   * only for these cuts.  The setting is ignored for
+   * k > priority_cut::max_leaves. */
   xmg_cuts_paged( xmg_graph& xmg, unsigned k, const properties::ptr& settings = properties::ptr() );
   xmg_cuts_paged( xmg_graph& xmg, unsigned k,
                   const std::vector<xmg_node>& start,
@@ -79,6 +85,9 @@ public:
   boost::iterator_range<paged_memory::iterator> cut_cones( xmg_node node );
 
   tt simulate( xmg_node node, const cut& c ) const;
+  /* allocation-free variant, requires c.size() <= NumVars (NumVars = 2, ..., 8) */
+  template<unsigned NumVars>
+  static_tt<NumVars> simulate( xmg_node node, const cut& c ) const;
   unsigned depth( xmg_node node, const cut& c ) const;
   unsigned size( xmg_node node, const cut& c ) const;
 
@@ -92,7 +101,11 @@ private:
   void enumerate_with_xor_blocks( const std::unordered_map<xmg_node, xmg_xor_block_t>& blocks );
   void enumerate_partial( const std::vector<xmg_node>& start, const std::vector<xmg_node>& boundary );
 
+  void enumerate_node( xmg_node n, const std::vector<xmg_node>& ns );
   void enumerate_node_with_bitsets( xmg_node n, const std::vector<xmg_node>& ns );
+  void enumerate_node_with_priority_cuts( xmg_node n, const std::vector<xmg_node>& ns );
+  std::vector<unsigned> compute_cone( xmg_node node, const priority_cut& cut ) const;
+  void init_priority_cuts();
 
   using local_cut_vec_t = std::vector<std::tuple<boost::dynamic_bitset<>, unsigned, boost::dynamic_bitset<>>>;
   local_cut_vec_t enumerate_local_cuts( xmg_node n1, xmg_node n2, unsigned max_cut_size );
@@ -108,6 +121,8 @@ private:
   unsigned         _priority = 8u;
   unsigned         _extra    = 0u;
   bool             _progress = false;
+  bool             _priority_cuts = false;
+  cut_cost_t       _cut_cost = cut_cost_t::depth;
   paged_memory     data;
   paged_memory     cones;
 
@@ -116,6 +131,11 @@ private:
   unsigned         _top_index = 0u; /* index when doing topo traversal */
 
   std::vector<std::pair<unsigned, unsigned>> _levels;
+
+  /* priority cuts */
+  std::vector<unsigned> _fanout;
+  std::vector<unsigned> _node_depth;
+  std::vector<float>    _node_flow;
 };
 
 }
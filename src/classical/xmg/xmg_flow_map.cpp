@@ -70,9 +70,12 @@ private:
   std::shared_ptr<xmg_cuts_paged> cuts;
 
   /* settings */
-  unsigned cut_size;
-  bool     progress;
-  bool     verbose;
+  unsigned   cut_size;
+  bool       priority_cuts;
+  unsigned   cut_limit;
+  cut_cost_t cut_cost;
+  bool       progress;
+  bool       verbose;
 };
 
 xmg_flow_map_manager::xmg_flow_map_manager( xmg_graph& xmg, const properties::ptr& settings )
@@ -80,9 +83,12 @@ xmg_flow_map_manager::xmg_flow_map_manager( xmg_graph& xmg, const properties::pt
     node_to_cut( xmg.size() ),
     node_to_level( xmg.size() )
 {
-  cut_size = get( settings, "cut_size", 4u );
-  progress = get( settings, "progress", false );
-  verbose  = get( settings, "verbose",  false );
+  cut_size      = get( settings, "cut_size",      4u );
+  priority_cuts = get( settings, "priority_cuts", true );
+  cut_limit     = get( settings, "cut_limit",     8u );
+  cut_cost      = get( settings, "cut_cost",      cut_cost_t::depth );
+  progress      = get( settings, "progress",      false );
+  verbose       = get( settings, "verbose",       false );
 }
 
 void xmg_flow_map_manager::run()
@@ -90,6 +96,9 @@ void xmg_flow_map_manager::run()
   /* compute cuts */
   auto cuts_settings = std::make_shared<properties>();
   cuts_settings->set( "progress", progress );
+  cuts_settings->set( "priority", cut_limit );
+  cuts_settings->set( "priority_cuts", priority_cuts && cut_size <= priority_cut::max_leaves );
+  cuts_settings->set( "cut_cost", cut_cost );
 
   cuts = std::make_shared<xmg_cuts_paged>( xmg, cut_size, cuts_settings );
   LN( boost::format( "[i] enumerated %d cuts in %.2f secs" ) % cuts->total_cut_count() % cuts->enumeration_time() );
@@ -461,6 +461,8 @@ xmg_graph read_verilog( const std::string& filename, bool native_xor, bool enabl
   std::vector<unsigned> top( num_vertices( instructions ) );
   boost::topological_sort( instructions, top.begin() );
 
+  xmg.reserve( xmg.size() + num_vertices( instructions ) );
+
   for ( const auto v : top )
   {
     const auto& inst = instructions[v];
@@ -164,6 +164,7 @@ xmg_graph xmg_rewrite_top_down( const xmg_graph& xmg,
   properties_timer t( statistics );
 
   xmg_graph xmg_new( xmg.name() );
+  xmg_new.reserve( xmg.size() );
 
   /* init */
   if ( init )
@@ -252,6 +253,7 @@ xmg_graph xmg_rewrite_bottom_up( const xmg_graph& xmg,
   properties_timer t( statistics );
 
   xmg_graph xmg_new( xmg.name() );
+  xmg_new.reserve( xmg.size() );
 
   /* init */
   if ( init )
@@ -177,6 +177,24 @@ std::deque<xmg_node> xmg_output_deque( const xmg_graph& xmg )
 
 tt xmg_simulate_cut( const xmg_graph& xmg, xmg_node root, const std::vector<xmg_node>& leafs )
 {
+  if ( leafs.size() <= 6u )
+  {
+    auto tt = from_static_tt( xmg_simulate_cut<6u>( xmg, root, leafs ) );
+    if ( leafs.size() < 6u )
+    {
+      tt_shrink( tt, leafs.size() );
+    }
+    return tt;
+  }
+  else if ( leafs.size() == 7u )
+  {
+    return from_static_tt( xmg_simulate_cut<7u>( xmg, root, leafs ) );
+  }
+  else if ( leafs.size() == 8u )
+  {
+    return from_static_tt( xmg_simulate_cut<8u>( xmg, root, leafs ) );
+  }
+
   std::map<xmg_node, tt> inputs;
   auto i = 0u;
   for ( auto child : leafs )
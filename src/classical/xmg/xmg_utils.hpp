@@ -42,7 +42,9 @@
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
+#include <boost/range/iterator_range.hpp>
 
+#include <classical/utils/static_truth_table.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 #include <classical/xmg/xmg.hpp>
 
@@ -65,6 +67,67 @@ std::deque<xmg_node> xmg_output_deque( const xmg_graph& xmg );
 
 tt xmg_simulate_cut( const xmg_graph& xmg, xmg_node root, const std::vector<xmg_node>& leafs );
 
+namespace detail
+{
+
+template<unsigned NumVars, typename LeafIt>
+static_tt<NumVars> xmg_simulate_cut_rec( const xmg_graph& xmg, xmg_node node, LeafIt begin, LeafIt end,
+                                         static_tt_cache<NumVars>& cache )
+{
+  const auto it = std::find( begin, end, node );
+  if ( it != end )
+  {
+    return static_tt<NumVars>::nth_var( std::distance( begin, it ) );
+  }
+
+  const auto& g = xmg.graph();
+
+  /* constant or input outside the cut */
+  if ( boost::out_degree( node, g ) == 0u )
+  {
+    return static_tt<NumVars>::const0();
+  }
+
+  if ( const auto* value = cache.find( node ) )
+  {
+    return *value;
+  }
+
+  const auto& complement = boost::get( boost::edge_complement, g );
+
+  std::array<static_tt<NumVars>, 3u> children;
+  auto i = 0u;
+  for ( const auto& e : boost::make_iterator_range( boost::out_edges( node, g ) ) )
+  {
+    children[i] = xmg_simulate_cut_rec<NumVars>( xmg, boost::target( e, g ), begin, end, cache );
+    if ( complement[e] ) { children[i] = ~children[i]; }
+    ++i;
+  }
+
+  const auto value = i == 3u ? tt_maj( children[0u], children[1u], children[2u] ) : children[0u] ^ children[1u];
+  cache.insert( node, value );
+  return value;
+}
+
+}
+
+/* allocation-free variant of xmg_simulate_cut for at most NumVars leafs, the
+   result is not shrunk */
+template<unsigned NumVars, typename LeafIt>
+static_tt<NumVars> xmg_simulate_cut( const xmg_graph& xmg, xmg_node root, LeafIt begin, LeafIt end )
+{
+  assert( static_cast<unsigned>( std::distance( begin, end ) ) <= NumVars );
+
+  static_tt_cache<NumVars> cache;
+  return detail::xmg_simulate_cut_rec<NumVars>( xmg, root, begin, end, cache );
+}
+
+template<unsigned NumVars>
+inline static_tt<NumVars> xmg_simulate_cut( const xmg_graph& xmg, xmg_node root, const std::vector<xmg_node>& leafs )
+{
+  return xmg_simulate_cut<NumVars>( xmg, root, leafs.begin(), leafs.end() );
+}
+
 boost::dynamic_bitset<> xmg_output_mask( const xmg_graph& xmg );
 
 /* returns the edge in between parent and child and fails if no such edge exists */
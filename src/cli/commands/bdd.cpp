@@ -36,8 +36,13 @@
 #include <alice/rules.hpp>
 
 #include <cli/stores.hpp>
+#include <core/utils/program_options.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/string_utils.hpp>
+#include <classical/aig.hpp>
+#include <classical/dd/aig_to_cirkit_bdd.hpp>
+#include <classical/dd/bdd.hpp>
+#include <classical/dd/size.hpp>
 
 using namespace boost::program_options;
 
@@ -51,12 +56,19 @@ bdd_command::bdd_command( const environment::ptr& env )
     ( "characteristic,c", value( &characteristic ), "Compute characteristic function (x: inputs first, y: outputs first)" )
     ( "clique",           value( &clique ),         "Computes clique(n,k) function, give n,k as string" )
     ( "new,n",                                      "Add a new entry to the store; if not set, the current entry is overriden" )
+    ( "native",                                     "Build BDDs of the current AIG with the native BDD package and print statistics" )
+    ( "reorder,r",                                  "Enable dynamic variable reordering (sifting) for native BDDs" )
+    ( "reorder_threshold", value_with_default( &reorder_threshold ), "Number of nodes that triggers the first reordering" )
     ;
+  be_verbose();
 }
 
 command::rules_t bdd_command::validity_rules() const
 {
-  return { has_store_element_if_set<bdd_function_t>( *this, env, "characteristic" ) };
+  return {
+    has_store_element_if_set<bdd_function_t>( *this, env, "characteristic" ),
+    has_store_element_if_set<aig_graph>( *this, env, "native" )
+  };
 }
 
 bool bdd_command::execute()
@@ -102,6 +114,36 @@ bool bdd_command::execute()
     bdds.current() = {mgr, {func}};
   }
 
+  else if ( is_set( "native" ) )
+  {
+    const auto& aig = env->store<aig_graph>().current();
+
+    auto mgr = bdd_manager::create( aig_info( aig ).inputs.size(), 20u, is_verbose() );
+    if ( is_set( "reorder" ) )
+    {
+      mgr->set_reorder_enabled( true );
+      mgr->set_reorder_threshold( reorder_threshold );
+    }
+
+    const auto fs = aig_to_bdd( aig, mgr );
+
+    std::cout << "[i] shared size: " << dd_size( fs ) << std::endl;
+    if ( is_set( "reorder" ) )
+    {
+      std::cout << "[i] order:      ";
+      for ( auto l = 0u; l < mgr->num_vars(); ++l )
+      {
+        std::cout << " " << mgr->level_var( l );
+      }
+      std::cout << std::endl;
+    }
+
+    if ( is_verbose() )
+    {
+      mgr->dump_stats( std::cout );
+    }
+  }
+
   return true;
 }
 
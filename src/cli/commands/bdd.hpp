@@ -54,6 +54,7 @@ protected:
 private:
   std::string characteristic;
   std::string clique;
+  unsigned    reorder_threshold = 4096u;
 };
 
 }
@@ -0,0 +1,119 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "cec.hpp"
+
+#include <iostream>
+
+#include <boost/format.hpp>
+
+#include <core/utils/program_options.hpp>
+#include <classical/abc/functions/abc_cec.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <cli/stores.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+cec_command::cec_command( const environment::ptr& env )
+  : cirkit_command( env, "Combinational equivalence checking of two AIGs" )
+{
+  opts.add_options()
+    ( "id1",      value_with_default( &id1 ),     "id of first circuit" )
+    ( "id2",      value_with_default( &id2 ),     "id of second circuit" )
+    ( "fraig,f",                                  "Try to prove equivalence by fraiging the miter before calling ABC" )
+    ( "threads",  value_with_default( &threads ), "Number of threads for fraiging (0: number of cores)" )
+    ;
+  be_verbose();
+}
+
+command::rules_t cec_command::validity_rules() const
+{
+  const auto& aigs = env->store<aig_graph>();
+
+  return {
+    {[this, &aigs]() { return id1 < aigs.size() && id2 < aigs.size(); }, "invalid circuit ids"},
+    {[this, &aigs]() { return aig_info( aigs[id1] ).inputs.size() == aig_info( aigs[id2] ).inputs.size() &&
+                              aig_info( aigs[id1] ).outputs.size() == aig_info( aigs[id2] ).outputs.size(); }, "circuits have different interfaces"}
+  };
+}
+
+bool cec_command::execute()
+{
+  const auto& aigs = env->store<aig_graph>();
+
+  auto settings = make_settings();
+  settings->set( "fraig", is_set( "fraig" ) );
+  settings->set( "num_threads", threads );
+
+  const auto cex = abc_cec( aigs[id1], aigs[id2], settings, statistics );
+  equivalent = !cex;
+
+  if ( equivalent )
+  {
+    std::cout << "[i] circuits are equivalent" << std::endl;
+  }
+  else
+  {
+    std::cout << "[i] circuits are not equivalent" << std::endl
+              << "[i] counterexample: " << *cex << std::endl;
+  }
+
+  print_runtime();
+
+  return true;
+}
+
+command::log_opt_t cec_command::log() const
+{
+  return log_opt_t({
+      {"id1", static_cast<int>( id1 )},
+      {"id2", static_cast<int>( id2 )},
+      {"fraig", is_set( "fraig" )},
+      {"equivalent", equivalent},
+      {"runtime", statistics->get<double>( "runtime" )}
+    });
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
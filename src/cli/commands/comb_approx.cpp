@@ -221,6 +221,12 @@ bool comb_approx_command::execute()
   std::cout << format( "[i] run-time (wc):   %.2f" ) % wc_statistics->get<double>( "runtime" ) << std::endl;
   std::cout << format( "[i] run-time (ac):   %.2f" ) % ac_statistics->get<double>( "runtime" ) << std::endl;
 
+  if ( is_set( "verbose" ) )
+  {
+    std::cout << "[i] BDD manager statistics:" << std::endl;
+    manager->dump_stats( std::cout );
+  }
+
   return true;
 }
 
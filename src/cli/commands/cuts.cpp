@@ -35,6 +35,7 @@
 #include <core/utils/program_options.hpp>
 #include <core/utils/range_utils.hpp>
 #include <classical/functions/cuts/paged.hpp>
+#include <classical/functions/cuts/priority.hpp>
 #include <classical/mig/mig_cuts_paged.hpp>
 #include <classical/functions/cuts/traits.hpp>
 #include <classical/utils/cut_enumeration.hpp>
@@ -66,13 +67,30 @@ cuts_command::cuts_command( const environment::ptr& env ) : aig_mig_command( env
     ( "cone_count,c",                                    "Prints nodes in cut cone when verbose" )
     ( "depth,d",                                         "Prints depth of cut when verbose " )
     ( "parallel",                                        "Parallel cut enumeration for AIGs" )
+    ( "threads",      value_with_default( &threads ),    "Number of threads for parallel enumeration (0: number of cores)" )
+    ( "priority_cuts,p",                                 "Keep the cut_limit best cuts per node w.r.t. cut_cost for AIGs" )
+    ( "cut_limit,C",  value_with_default( &cut_limit ),  "Maximum number of cuts per node (besides the trivial cut) for AIGs" )
+    ( "cut_cost",     value_with_default( &cut_cost ),   "Cost to rank priority cuts: depth, area_flow, cone_size" )
     ;
   be_verbose();
 }
 
+command::rules_t cuts_command::validity_rules() const
+{
+  auto rules = aig_mig_command::validity_rules();
+  rules.push_back( {[this]() { return cut_cost_from_string( cut_cost ) != boost::none; }, "unknown cut cost" } );
+  rules.push_back( {[this]() { return !is_set( "priority_cuts" ) || node_count <= priority_cut::max_leaves; },
+                    boost::str( format( "node count must not exceed %d for priority cuts" ) % priority_cut::max_leaves ) } );
+  return rules;
+}
+
 bool cuts_command::execute_aig()
 {
-  paged_aig_cuts cuts( aig(), node_count, is_set( "parallel" ) );
+  auto settings = std::make_shared<properties>();
+  settings->set( "num_threads", threads );
+  settings->set( "priority_cuts", is_set( "priority_cuts" ) );
+  settings->set( "cut_cost", *cut_cost_from_string( cut_cost ) );
+  paged_aig_cuts cuts( aig(), node_count, is_set( "parallel" ), cut_limit, settings );
   std::cout << boost::format( "[i] found %d cuts in %.2f secs (%d KB)" ) % cuts.total_cut_count() % cuts.enumeration_time() % ( cuts.memory() >> 10u ) << std::endl;
 
   if ( is_verbose() )
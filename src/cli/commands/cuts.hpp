@@ -49,11 +49,16 @@ public:
   cuts_command( const environment::ptr& env );
 
 protected:
+  rules_t validity_rules() const;
+
   bool execute_aig();
   bool execute_mig();
 
 private:
-  unsigned node_count = 6u;
+  unsigned    node_count = 6u;
+  unsigned    threads    = 0u;
+  unsigned    cut_limit  = 8u;
+  std::string cut_cost   = "depth";
 };
 
 }
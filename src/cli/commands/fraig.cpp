@@ -0,0 +1,119 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "fraig.hpp"
+
+#include <iostream>
+
+#include <boost/format.hpp>
+
+#include <core/utils/program_options.hpp>
+#include <classical/functions/fraig.hpp>
+
+using namespace boost::program_options;
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+unsigned aig_gate_count( const aig_graph& aig )
+{
+  return boost::num_vertices( aig ) - aig_info( aig ).inputs.size() - 1u;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+fraig_command::fraig_command( const environment::ptr& env )
+  : aig_base_command( env, "Functionally reduces an AIG by SAT sweeping" )
+{
+  opts.add_options()
+    ( "new,n",                                           "Stores result in a new AIG" )
+    ( "sim_words",   value_with_default( &sim_words ),   "Random 64-bit simulation words per node" )
+    ( "conf_budget", value_with_default( &conf_budget ), "Conflict budget per SAT call (0: unlimited)" )
+    ( "threads",     value_with_default( &threads ),     "Number of threads (0: number of cores)" )
+    ( "seed",        value_with_default( &seed ),        "Random seed for simulation" )
+    ;
+  be_verbose();
+}
+
+bool fraig_command::execute()
+{
+  const auto settings = make_settings();
+  settings->set( "sim_words",   sim_words );
+  settings->set( "conf_budget", conf_budget );
+  settings->set( "num_threads", threads );
+  settings->set( "seed",        seed );
+
+  gates_before = aig_gate_count( aig() );
+  auto result = fraig( aig(), settings, statistics );
+  gates_after = aig_gate_count( result );
+
+  if ( is_set( "new" ) )
+  {
+    store.extend();
+  }
+  aig() = result;
+
+  std::cout << boost::format( "[i] gates:            %d -> %d" ) % gates_before % gates_after << std::endl
+            << boost::format( "[i] merged:           %d (%d disproved, %d undecided)" ) % statistics->get<unsigned>( "proved" ) % statistics->get<unsigned>( "disproved" ) % statistics->get<unsigned>( "undecided" ) << std::endl
+            << boost::format( "[i] rounds:           %d" ) % statistics->get<unsigned>( "rounds" ) << std::endl
+            << boost::format( "[i] run-time:         %.2f secs" ) % statistics->get<double>( "runtime" ) << std::endl
+            << boost::format( "[i] run-time (sim.):  %.2f secs" ) % statistics->get<double>( "sim_runtime" ) << std::endl
+            << boost::format( "[i] run-time (SAT):   %.2f secs" ) % statistics->get<double>( "sat_runtime" ) << std::endl;
+
+  return true;
+}
+
+command::log_opt_t fraig_command::log() const
+{
+  return log_opt_t({
+      {"gates_before", static_cast<int>( gates_before )},
+      {"gates_after", static_cast<int>( gates_after )},
+      {"proved", static_cast<int>( statistics->get<unsigned>( "proved" ) )},
+      {"disproved", static_cast<int>( statistics->get<unsigned>( "disproved" ) )},
+      {"undecided", static_cast<int>( statistics->get<unsigned>( "undecided" ) )},
+      {"rounds", static_cast<int>( statistics->get<unsigned>( "rounds" ) )},
+      {"runtime", statistics->get<double>( "runtime" )},
+      {"sat_runtime", statistics->get<double>( "sat_runtime" )}
+    });
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
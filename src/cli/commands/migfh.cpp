@@ -55,6 +55,7 @@ migfh_command::migfh_command( const environment::ptr& env ) : mig_base_command(
     ( "ffrs,f",                                                  "only optimize inside FFRs" )
     ( "depth_heuristic",                                         "preserve depth locally" )
     ( "hash",            value_with_default( &hash ),            "hash table size for NPN caching" )
+    ( "cache,c",                                                 "use the shared exact NPN cache (persisted in $CIRKIT_HOME)" )
     ( "progress,p",                                              "show progress" )
     ( "max_candidates",  value_with_default( &max_candidates ),  "max candidates (only bottom-up)" )
     ( "allow_area_inc",                                          "allow area increase for candidates (only bottom-up)" )
@@ -71,6 +72,7 @@ bool migfh_command::execute()
   settings->set( "use_ffrs",            is_set( "ffrs" ) );
   settings->set( "depth_heuristic",     is_set( "depth_heuristic" ) );
   settings->set( "npn_hash_table_size", hash );
+  settings->set( "npn_cache",           is_set( "cache" ) );
   settings->set( "progress",            is_set( "progress" ) );
   settings->set( "max_candidates",      max_candidates );
   settings->set( "allow_area_inc",      is_set( "allow_area_inc" ) );
@@ -39,6 +39,8 @@
 #include <core/utils/timer.hpp>
 #include <cli/stores.hpp>
 #include <classical/functions/npn_canonization.hpp>
+#include <classical/functions/npn_enumeration.hpp>
+#include <classical/utils/npn_cache.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 using namespace boost::program_options;
@@ -51,7 +53,7 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
-using npn_func_t = std::function<tt(const tt&, boost::dynamic_bitset<>&, std::vector<unsigned>&, const properties::ptr&, const properties::ptr&)>;
+using npn_func_t = tt(*)(const tt&, boost::dynamic_bitset<>&, std::vector<unsigned>&, const properties::ptr&, const properties::ptr&);
 
 /******************************************************************************
  * Private functions                                                          *
@@ -69,7 +71,10 @@ npn_command::npn_command( const environment::ptr& env )
     ( "enumerate,m",  value( &enumerate ),  "Computes NPN classes for all functions with given number of variables" )
     ( "truthtable,t",                       "Computes NPN class for the current truth table in the store" )
     ( "logname,l",    value( &logname ),    "If enumerate is set, write all classes to this file" )
+    ( "samples,s",    value( &samples ),    "If enumerate is set, only canonize this number of random functions (exact approach only)" )
+    ( "threads",      value_with_default( &threads ), "Number of threads for enumeration with exact approach (0: number of cores)" )
     ( "store,n",                            "Copy the result to the store (only for truth tables)" )
+    ( "cache,c",                            "Use the shared NPN cache of the approach (persisted in $CIRKIT_HOME)" )
     ;
 }
 
@@ -81,7 +86,13 @@ command::rules_t npn_command::validity_rules() const
     {[&]() { return !is_set( "truthtable" ) || env->store<tt>().current_index() >= 0; },
         "no current truth table available" },
     {[&]() { return approach <= 3u; },
-        "approach must be value from 0 to 3" }
+        "approach must be value from 0 to 3" },
+    {[&]() { return !is_set( "enumerate" ) || enumerate <= 6u; },
+        "enumeration is supported for up to 6 variables" },
+    {[&]() { return !is_set( "samples" ) || ( is_set( "enumerate" ) && approach == 0u && enumerate >= 2u ); },
+        "sampling requires enumeration with exact approach and at least 2 variables" },
+    {[&]() { return !is_set( "enumerate" ) || enumerate < 6u || is_set( "samples" ); },
+        "enumeration for 6 variables requires sampling" }
   };
 }
 
@@ -90,7 +101,51 @@ bool npn_command::execute()
   std::vector<npn_func_t> approaches{ &exact_npn_canonization, &npn_canonization, &npn_canonization_flip_swap, &npn_canonization_sifting };
   const auto& func = approaches[approach];
 
-  if ( is_set( "enumerate" ) )
+  const std::vector<std::string> cache_names{ "exact", "ones", "flip_swap", "sifting" };
+  const auto cache = is_set( "cache" ) ? shared_npn_cache( cache_names[approach] ) : npn_cache::ptr();
+  const auto classify = [&]( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm ) {
+    if ( !cache )
+    {
+      return func( t, phase, perm, properties::ptr(), properties::ptr() );
+    }
+
+    return cache->compute( t, phase, perm, [&]( const tt& f, boost::dynamic_bitset<>& p, std::vector<unsigned>& q ) {
+        return func( f, p, q, properties::ptr(), properties::ptr() );
+      } );
+  };
+
+  if ( is_set( "enumerate" ) && approach == 0u && enumerate >= 2u )
+  {
+    std::ofstream out;
+    if ( is_set( "logname" ) )
+    {
+      out.open( logname.c_str(), std::ofstream::out );
+    }
+
+    /* classes are streamed to the log as they are found */
+    const auto on_class = [&]( uint64_t repr, uint64_t count ) {
+      if ( out.is_open() )
+      {
+        boost::dynamic_bitset<> tt( 1u << enumerate, repr );
+        out << tt_to_hex( tt ) << " " << tt << " " << count << std::endl;
+      }
+    };
+
+    auto settings = std::make_shared<properties>();
+    settings->set( "num_threads", threads );
+
+    if ( is_set( "samples" ) )
+    {
+      const auto num_classes = sample_npn_classes( enumerate, samples, on_class, settings, statistics );
+      std::cout << format( "[i] found %d classes in %d samples in %.2f secs" ) % num_classes % samples % statistics->get<double>( "runtime" ) << std::endl;
+    }
+    else
+    {
+      const auto num_classes = enumerate_npn_classes( enumerate, on_class, settings, statistics );
+      std::cout << format( "[i] found %d classes in %.2f secs" ) % num_classes % statistics->get<double>( "runtime" ) << std::endl;
+    }
+  }
+  else if ( is_set( "enumerate" ) )
   {
     double runtime;
     std::unordered_map<unsigned, unsigned> classes;
@@ -108,7 +163,7 @@ bool npn_command::execute()
         phase.clear();
         perm.clear();
 
-        const auto key = func( bs, phase, perm, properties::ptr(), properties::ptr() ).to_ulong();
+        const auto key = classify( bs, phase, perm ).to_ulong();
         auto it = classes.find( key );
         if ( it == classes.end() )
         {
@@ -140,9 +195,12 @@ bool npn_command::execute()
   {
     auto& tts = env->store<tt>();
 
-    npn = func( tts.current(), phase, perm, properties::ptr(), statistics );
+    {
+      reference_timer t( &runtime );
+      npn = classify( tts.current(), phase, perm );
+    }
 
-    std::cout << boost::format( "[i] run-time: %.2f secs" ) % statistics->get<double>( "runtime" ) << std::endl;
+    std::cout << boost::format( "[i] run-time: %.2f secs" ) % runtime << std::endl;
     std::cout << "[i] NPN class for " << tts.current() << " is " << npn << std::endl;
     std::cout << "[i] - phase: " << phase << " perm: " << any_join( perm, " " ) << std::endl;
 
@@ -153,6 +211,12 @@ bool npn_command::execute()
     }
   }
 
+  if ( cache )
+  {
+    cache->print_statistics();
+    cache->persist();
+  }
+
   return true;
 }
 
@@ -161,7 +225,7 @@ command::log_opt_t npn_command::log() const
   if ( is_set( "truthtable" ) )
   {
     return log_opt_t({
-        {"runtime", statistics->get<double>( "runtime" )},
+        {"runtime", runtime},
         {"phase", to_string( phase )},
         {"perm", any_join( perm, " " )},
         {"npn", to_string( npn )}
@@ -36,6 +36,7 @@
 #ifndef CLI_NPN_COMMAND_HPP
 #define CLI_NPN_COMMAND_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -61,12 +62,15 @@ public:
 
 private:
   unsigned                approach = 1u;
-  unsigned                enumerate;
+  unsigned                enumerate = 0u;
+  uint64_t                samples = 0u;
+  unsigned                threads = 0u;
   std::string             logname;
 
   boost::dynamic_bitset<> phase;
   std::vector<unsigned>   perm;
   tt                      npn;
+  double                  runtime = 0.0;
 };
 
 }
@@ -0,0 +1,248 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "profile.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include <boost/format.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* counters X.cache_hit and X.cache_miss yield cache rate of X */
+template<typename Fn>
+void foreach_cache_rate( const profile_snapshot& snapshot, Fn&& fn )
+{
+  const std::string suffix = ".cache_hit";
+
+  for ( const auto& p : snapshot.counters )
+  {
+    if ( p.first.size() <= suffix.size() || p.first.compare( p.first.size() - suffix.size(), suffix.size(), suffix ) != 0 ) { continue; }
+
+    const auto prefix = p.first.substr( 0u, p.first.size() - suffix.size() );
+    const auto it = snapshot.counters.find( prefix + ".cache_miss" );
+    const auto misses = it == snapshot.counters.end() ? 0u : it->second;
+
+    if ( p.second + misses > 0u )
+    {
+      fn( prefix, p.second, misses, ( 100.0 * p.second ) / ( p.second + misses ) );
+    }
+  }
+}
+
+void add_profile_to_log( command::log_map_t& map, const profile_snapshot& snapshot, double runtime )
+{
+  map["profile.runtime"] = runtime;
+  map["profile.peak_rss"] = snapshot.peak_rss;
+#ifdef CIRKIT_COUNT_ALLOCATIONS
+  map["profile.allocations"] = snapshot.allocations;
+  map["profile.allocated_bytes"] = snapshot.allocated_bytes;
+#endif
+
+  for ( const auto& p : snapshot.counters )
+  {
+    if ( p.second == 0u ) { continue; }
+    map["profile." + p.first] = p.second;
+  }
+
+  for ( const auto& p : snapshot.timers )
+  {
+    if ( p.second.calls == 0u ) { continue; }
+    map["profile." + p.first + ".calls"] = p.second.calls;
+    map["profile." + p.first + ".time"] = p.second.seconds;
+  }
+
+  foreach_cache_rate( snapshot, [&map]( const std::string& prefix, std::uint64_t, std::uint64_t, double rate ) {
+      map["profile." + prefix + ".cache_rate"] = rate;
+    } );
+}
+
+void print_profile( const profile_snapshot& snapshot, double runtime )
+{
+  std::cout << boost::format( "    run-time:    %10.2f secs" ) % runtime << std::endl
+            << boost::format( "    peak RSS:    %10d KB" ) % snapshot.peak_rss << std::endl;
+#ifdef CIRKIT_COUNT_ALLOCATIONS
+  std::cout << boost::format( "    allocations: %10d (%d KB)" ) % snapshot.allocations % ( snapshot.allocated_bytes >> 10u ) << std::endl;
+#endif
+
+  foreach_cache_rate( snapshot, []( const std::string& prefix, std::uint64_t hits, std::uint64_t misses, double rate ) {
+      std::cout << boost::format( "    cache %-20s %6.2f %% (%d hits, %d misses)" ) % prefix % rate % hits % misses << std::endl;
+    } );
+
+  for ( const auto& p : snapshot.counters )
+  {
+    if ( p.second == 0u ) { continue; }
+    std::cout << boost::format( "    counter %-30s %12d" ) % p.first % p.second << std::endl;
+  }
+
+  for ( const auto& p : snapshot.timers )
+  {
+    if ( p.second.calls == 0u ) { continue; }
+    std::cout << boost::format( "    timer %-32s %12d calls %10.2f secs" ) % p.first % p.second.calls % p.second.seconds << std::endl;
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+profile_command::profile_command( const environment::ptr& env )
+  : cirkit_command( env, "Profile of executed commands" )
+{
+  opts.add_options()
+    ( "enable,e",  "enable profiling (resets the accumulated profile)" )
+    ( "disable,d", "disable profiling" )
+    ( "reset,r",   "reset all counters and timers" )
+    ( "total,t",   "show profile accumulated since enabling or resetting instead of the last command" )
+    ;
+
+  env->before_command = [this]( const std::string& name ) { before_command( name ); };
+  env->after_command = [this]( const std::string& name, log_map_t& map ) { after_command( name, map ); };
+}
+
+command::rules_t profile_command::validity_rules() const
+{
+  return {
+    {[this]() { return !is_set( "enable" ) || !is_set( "disable" ); }, "cannot enable and disable profiling at the same time"}
+  };
+}
+
+bool profile_command::execute()
+{
+  show_total = is_set( "total" );
+
+  if ( is_set( "enable" ) || is_set( "reset" ) )
+  {
+    if ( is_set( "reset" ) )
+    {
+      reset_profile();
+      last_command.clear();
+    }
+
+    total_start = take_profile_snapshot();
+    total_runtime = 0.0;
+    total_peak_rss = 0u;
+    total_commands = 0u;
+  }
+
+  if ( is_set( "enable" ) )
+  {
+    set_profiling_enabled( true );
+    std::cout << "[i] profiling enabled" << std::endl;
+  }
+  else if ( is_set( "disable" ) )
+  {
+    set_profiling_enabled( false );
+    std::cout << "[i] profiling disabled" << std::endl;
+  }
+
+  if ( is_set( "enable" ) || is_set( "disable" ) || ( is_set( "reset" ) && !show_total ) )
+  {
+    return true;
+  }
+
+  if ( show_total )
+  {
+    auto total = take_profile_snapshot() - total_start;
+    total.peak_rss = total_peak_rss;
+
+    std::cout << boost::format( "[i] profile of %d command(s)%s" ) % total_commands % ( profiling_enabled() ? "" : " (profiling disabled)" ) << std::endl;
+    print_profile( total, total_runtime );
+  }
+  else if ( last_command.empty() )
+  {
+    std::cout << "[i] no command has been profiled, use profile --enable" << std::endl;
+  }
+  else
+  {
+    std::cout << boost::format( "[i] profile of %s" ) % last_command << std::endl;
+    print_profile( last, last_runtime );
+  }
+
+  return true;
+}
+
+command::log_opt_t profile_command::log() const
+{
+  log_map_t map;
+
+  if ( show_total )
+  {
+    auto total = take_profile_snapshot() - total_start;
+    total.peak_rss = total_peak_rss;
+    add_profile_to_log( map, total, total_runtime );
+    map["commands"] = total_commands;
+  }
+  else if ( !last_command.empty() )
+  {
+    add_profile_to_log( map, last, last_runtime );
+    map["last_command"] = last_command;
+  }
+
+  return map;
+}
+
+void profile_command::before_command( const std::string& name )
+{
+  if ( !profiling_enabled() || name == "profile" ) { return; }
+
+  reset_peak_rss();
+  start = take_profile_snapshot();
+  start_time = std::chrono::steady_clock::now();
+}
+
+void profile_command::after_command( const std::string& name, log_map_t& map )
+{
+  if ( !profiling_enabled() || name == "profile" ) { return; }
+
+  last_runtime = std::chrono::duration<double>( std::chrono::steady_clock::now() - start_time ).count();
+  last = take_profile_snapshot() - start;
+  last_command = name;
+
+  total_runtime += last_runtime;
+  total_peak_rss = std::max( total_peak_rss, last.peak_rss );
+  ++total_commands;
+
+  add_profile_to_log( map, last, last_runtime );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
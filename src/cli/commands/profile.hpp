@@ -0,0 +1,96 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file profile.hpp
+ *
+ * @brief Profile of executed commands
+ *
+ * The command installs hooks into the environment that take a profile
+ * snapshot (see core/utils/profiler.hpp) around every other command.  While
+ * profiling is enabled, the profile of each command is also written into the
+ * log.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef CLI_PROFILE_COMMAND_HPP
+#define CLI_PROFILE_COMMAND_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <cli/cirkit_command.hpp>
+#include <core/utils/profiler.hpp>
+
+namespace cirkit
+{
+
+class profile_command : public cirkit_command
+{
+public:
+  profile_command( const environment::ptr& env );
+
+protected:
+  rules_t validity_rules() const;
+  bool execute();
+
+public:
+  log_opt_t log() const;
+
+private:
+  void before_command( const std::string& name );
+  void after_command( const std::string& name, log_map_t& map );
+
+private:
+  /* profile of the last command */
+  std::string                           last_command;
+  profile_snapshot                      last;
+  double                                last_runtime = 0.0;
+
+  /* accumulated since enabling or resetting */
+  profile_snapshot                      total_start;
+  double                                total_runtime = 0.0;
+  std::uint64_t                         total_peak_rss = 0u;
+  unsigned                              total_commands = 0u;
+
+  profile_snapshot                      start;
+  std::chrono::steady_clock::time_point start_time;
+
+  bool                                  show_total = false;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
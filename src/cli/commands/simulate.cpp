@@ -26,6 +26,7 @@
 
 #include "simulate.hpp"
 
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -37,6 +38,7 @@
 #include <cli/stores.hpp>
 #include <core/utils/program_options.hpp>
 #include <cli/stores.hpp>
+#include <classical/functions/bit_parallel_simulation.hpp>
 #include <classical/functions/simulate_aig.hpp>
 #include <classical/mig/mig_simulate.hpp>
 
@@ -53,6 +55,62 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+/* counts the ones per output over all streamed patterns */
+template<typename Network>
+bool simulate_bit_parallel( const Network& ntk, const std::vector<std::string>& output_names,
+                            const std::string& patterns_file, unsigned long random_patterns, unsigned seed,
+                            std::vector<unsigned long>& ones, unsigned long& num_patterns,
+                            bool quiet, const properties::ptr& statistics )
+{
+  bit_parallel_simulator sim( ntk );
+
+  ones.assign( sim.num_outputs(), 0ul );
+  const auto on_block = [&]( unsigned long offset, unsigned num ) {
+    for ( auto o = 0u; o < sim.num_outputs(); ++o )
+    {
+      ones[o] += sim.count_ones( o, num );
+    }
+  };
+
+  {
+    properties_timer t( statistics );
+
+    if ( !patterns_file.empty() )
+    {
+      std::ifstream is( patterns_file.c_str(), std::ifstream::in );
+      if ( !is.good() )
+      {
+        std::cerr << "[e] cannot open " << patterns_file << std::endl;
+        return false;
+      }
+      if ( !sim.simulate_stream( is, on_block, num_patterns ) )
+      {
+        std::cerr << "[e] cannot parse " << patterns_file << std::endl;
+        return false;
+      }
+    }
+    else
+    {
+      sim.simulate_random( random_patterns, seed, on_block );
+      num_patterns = random_patterns;
+    }
+  }
+
+  if ( !quiet )
+  {
+    for ( auto o = 0u; o < sim.num_outputs(); ++o )
+    {
+      std::cout << boost::format( "[i] %s : %d / %d" ) % output_names[o] % ones[o] % num_patterns << std::endl;
+    }
+  }
+
+  const auto runtime = statistics->get<double>( "runtime" );
+  std::cout << boost::format( "[i] simulated %d patterns (%d words per block), %.2f Mpatterns/s" )
+    % num_patterns % sim.num_words() % ( runtime > 0.0 ? num_patterns / runtime / 1e6 : 0.0 ) << std::endl;
+
+  return true;
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -65,6 +123,9 @@ simulate_command::simulate_command( const environment::ptr& env )
     ( "assignment,s",    value( &assignment ), "Simulates an input assignment, e.g. \"x1=0 x2=1 x3=1 y=1010 z=01\"" )
     ( "tt,t",                                  "Simulates a truth table" )
     ( "bdd,b",                                 "Simulates a BDD" )
+    ( "patterns_file",   value( &patterns_file ), "Bit-parallel simulation of patterns from file (one pattern per line)" )
+    ( "random",          value( &random_patterns ), "Bit-parallel simulation of a number of random patterns" )
+    ( "seed",            value_with_default( &seed ), "Random seed for random patterns" )
     ( "little_endian,l",                       "Change bit endianness to little-endian in assignment method (default: big-endian)" )
     ( "quiet,q",                               "Don't print simulation results" )
     ;
@@ -84,7 +145,7 @@ command::rule_t simulate_command::one_simulation_method() const
   const auto assertion = [&]() {
     auto total = 0u;
 
-    for ( const auto& o : {"pattern","assignment","tt","bdd"} )
+    for ( const auto& o : {"pattern","assignment","tt","bdd","patterns_file","random"} )
     {
       if ( is_set( o ) ) { ++total; }
     }
@@ -236,6 +297,17 @@ bool simulate_command::execute_aig()
 
     store<bdd_function_t>( {mgr, bdds} );
   }
+  else if ( is_set( "patterns_file" ) || is_set( "random" ) )
+  {
+    std::vector<std::string> names;
+    for ( const auto& o : aig_info().outputs )
+    {
+      names.push_back( o.second );
+    }
+
+    return simulate_bit_parallel( aig(), names, is_set( "patterns_file" ) ? patterns_file : std::string(), random_patterns, seed,
+                                  ones, num_patterns, is_set( "quiet" ), statistics );
+  }
 
   if ( statistics->has_key( "runtime" ) )
   {
@@ -285,6 +357,17 @@ bool simulate_command::execute_mig()
       tts.push_back( to_string( tt ) );
     }
   }
+  else if ( is_set( "patterns_file" ) || is_set( "random" ) )
+  {
+    std::vector<std::string> names;
+    for ( const auto& o : mig_info().outputs )
+    {
+      names.push_back( o.second );
+    }
+
+    return simulate_bit_parallel( mig(), names, is_set( "patterns_file" ) ? patterns_file : std::string(), random_patterns, seed,
+                                  ones, num_patterns, is_set( "quiet" ), statistics );
+  }
 
   return true;
 }
@@ -298,6 +381,12 @@ command::log_opt_t simulate_command::log() const
     m["tts"] = tts;
   }
 
+  if ( is_set( "patterns_file" ) || is_set( "random" ) )
+  {
+    m["num_patterns"] = static_cast<uint64_t>( num_patterns );
+    m["ones"] = std::vector<uint64_t>( ones.begin(), ones.end() );
+  }
+
   if ( statistics->has_key( "runtime" ) )
   {
     m["runtime"] = statistics->get<double>( "runtime" );
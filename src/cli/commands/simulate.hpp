@@ -80,6 +80,12 @@ private:
   std::string assignment;
 
   std::vector<std::string> tts;
+
+  std::string                patterns_file;
+  unsigned long              random_patterns = 0ul;
+  unsigned                   seed = 0u;
+  std::vector<unsigned long> ones;
+  unsigned long              num_patterns = 0ul;
 };
 
 }
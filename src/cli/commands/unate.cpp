@@ -87,7 +87,9 @@ unate_command::unate_command( const environment::ptr& env )
                                                                            "1: via mapped based CNFization\n"
                                                                            "2: Split outputs first\n"
                                                                            "3: Split outputs first (parallel)\n"
-                                                                           "4: Split inputs first (parallel)\n" )
+                                                                           "4: Split inputs first (parallel)\n"
+                                                                           "5: Concurrent engine with per-thread incremental solvers\n" )
+    ( "threads",    value_with_default( &threads ),                        "Number of threads for approach 5 (0: number of cores)" )
     ( "skiplist,s",                                                        "Compute skip list to skip functional support checks (only with approach 1)" )
     ( "matrix,m",   value( &matrixname )->implicit_value( std::string() ), "Prints unateness matrix:\n"
                                                                            "  rows: POs, columns: PIs\n"
@@ -105,6 +107,7 @@ bool unate_command::execute()
   const auto settings = make_settings();
   settings->set( "progress", is_set( "progress" ) );
   settings->set( "skiplist", is_set( "skiplist" ) );
+  settings->set( "num_threads", threads );
 
   if ( is_set( "print" ) )
   {
@@ -138,6 +141,9 @@ bool unate_command::execute()
   case 4u:
     u = unateness_split_inputs_parallel( aig(), settings, statistics );
     break;
+  case 5u:
+    u = unateness_concurrent( aig(), settings, statistics );
+    break;
   }
 
   info().unateness = u;
@@ -162,13 +168,19 @@ bool unate_command::execute()
   }
 
   std::cout << boost::format( "[i] run-time (total): %.2f secs" ) % statistics->get<double>( "runtime" ) << std::endl
-            << boost::format( "[i] run-time (wall): %.2f secs" ) % statistics->get<double>( "runtime_wall" ) << std::endl;
+            << boost::format( "[i] run-time (wall): %.2f secs" ) % statistics->get<double>( "runtime_wall", statistics->get<double>( "runtime" ) ) << std::endl;
 
-  if ( approach == 1u )
+  if ( approach == 1u || approach == 5u )
   {
     std::cout << boost::format( "[i] run-time (SAT):   %.2f secs" ) % statistics->get<double>( "sat_runtime" ) << std::endl;
   }
 
+  if ( approach == 5u )
+  {
+    std::cout << boost::format( "[i] SAT calls:        %d" ) % statistics->get<unsigned long>( "sat_calls" ) << std::endl
+              << boost::format( "[i] sim. decided:     %d" ) % statistics->get<unsigned long>( "sim_decided" ) << std::endl;
+  }
+
   return true;
 }
 
@@ -183,7 +195,7 @@ command::log_opt_t unate_command::log() const
     return log_opt_t({
         {"approach", approach},
         {"runtime", statistics->get<double>( "runtime" )},
-        {"runtime_wall", statistics->get<double>( "runtime_wall" )}
+        {"runtime_wall", statistics->get<double>( "runtime_wall", statistics->get<double>( "runtime" ) )}
       });
   }
 }
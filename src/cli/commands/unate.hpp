@@ -54,6 +54,7 @@ public:
 
 private:
   unsigned    approach = 4u;
+  unsigned    threads  = 0u;
   std::string matrixname;
 };
 
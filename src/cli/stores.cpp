@@ -43,6 +43,7 @@
 #include <core/graph/depth.hpp>
 #include <core/io/read_pla.hpp>
 #include <core/io/write_pla.hpp>
+#include <core/utils/binary_io.hpp>
 #include <core/utils/bitset_utils.hpp>
 #include <core/utils/range_utils.hpp>
 
@@ -56,6 +57,7 @@
 #include <classical/io/read_symmetries.hpp>
 #include <classical/io/read_unateness.hpp>
 #include <classical/io/read_verilog.hpp>
+#include <classical/io/snapshot.hpp>
 #include <classical/io/write_aiger.hpp>
 #include <classical/io/write_bench.hpp>
 #include <classical/io/write_verilog.hpp>
@@ -361,6 +363,10 @@ void store_write_io_type<aig_graph, io_aiger_tag_t>( const aig_graph& aig, const
   {
     write_aiger( aig, filename );
   }
+  else if ( aig_info( aig ).cis.empty() )
+  {
+    write_aiger_binary( aig, filename );
+  }
   else
   {
     abc_run_command_no_output( aig, boost::str( boost::format( "&w %s") % filename ) );
@@ -390,6 +396,20 @@ void store_write_io_type<aig_graph, io_edgelist_tag_t>( const aig_graph& aig, co
   }
 }
 
+template<>
+void store_save_session<aig_graph>( std::ostream& os, const aig_graph& aig )
+{
+  binary_writer writer( os );
+  write_snapshot( writer, aig );
+}
+
+template<>
+void store_load_session<aig_graph>( const char* data, std::size_t size, aig_graph& aig )
+{
+  binary_reader reader( data, size );
+  read_snapshot( reader, aig );
+}
+
 /******************************************************************************
  * mig_graph                                                                  *
  ******************************************************************************/
@@ -488,6 +508,20 @@ mig_graph store_read_io_type<mig_graph, io_verilog_tag_t>( const std::string& fi
   return read_mighty_verilog( filename );
 }
 
+template<>
+void store_save_session<mig_graph>( std::ostream& os, const mig_graph& mig )
+{
+  binary_writer writer( os );
+  write_snapshot( writer, mig );
+}
+
+template<>
+void store_load_session<mig_graph>( const char* data, std::size_t size, mig_graph& mig )
+{
+  binary_reader reader( data, size );
+  read_snapshot( reader, mig );
+}
+
 /******************************************************************************
  * counterexample_t                                                           *
  ******************************************************************************/
@@ -570,6 +604,20 @@ void store_write_io_type<tt, io_pla_tag_t>( const tt& t, const std::string& file
   out << ".e" << std::endl;
 }
 
+template<>
+void store_save_session<tt>( std::ostream& os, const tt& t )
+{
+  binary_writer writer( os );
+  write_snapshot( writer, t );
+}
+
+template<>
+void store_load_session<tt>( const char* data, std::size_t size, tt& t )
+{
+  binary_reader reader( data, size );
+  read_snapshot( reader, t );
+}
+
 /******************************************************************************
  * expression_t::ptr                                                          *
  ******************************************************************************/
@@ -616,6 +664,20 @@ bdd_function_t store_convert<expression_t::ptr, bdd_function_t>( const expressio
   return bdd_from_expression( manager, expr );
 }
 
+template<>
+void store_save_session<expression_t::ptr>( std::ostream& os, const expression_t::ptr& expr )
+{
+  binary_writer writer( os );
+  writer.write_string( expression_to_string( expr ) );
+}
+
+template<>
+void store_load_session<expression_t::ptr>( const char* data, std::size_t size, expression_t::ptr& expr )
+{
+  binary_reader reader( data, size );
+  expr = parse_expression( reader.read_string() );
+}
+
 /******************************************************************************
  * xmg_graph                                                                  *
  ******************************************************************************/
@@ -831,6 +893,20 @@ void store_write_io_type<xmg_graph, io_smt_tag_t>( const xmg_graph& xmg, const s
   write_smtlib2( xmg, filename, settings );
 }
 
+template<>
+void store_save_session<xmg_graph>( std::ostream& os, const xmg_graph& xmg )
+{
+  binary_writer writer( os );
+  write_snapshot( writer, xmg );
+}
+
+template<>
+void store_load_session<xmg_graph>( const char* data, std::size_t size, xmg_graph& xmg )
+{
+  binary_reader reader( data, size );
+  read_snapshot( reader, xmg );
+}
+
 }
 
 // Local Variables:
@@ -194,6 +194,15 @@ inline bool store_can_write_io_type<aig_graph, io_edgelist_tag_t>( command& cmd
 template<>
 void store_write_io_type<aig_graph, io_edgelist_tag_t>( const aig_graph& aig, const std::string& filename, const command& cmd );
 
+template<>
+inline bool store_can_save_session<aig_graph>() { return true; }
+
+template<>
+void store_save_session<aig_graph>( std::ostream& os, const aig_graph& aig );
+
+template<>
+void store_load_session<aig_graph>( const char* data, std::size_t size, aig_graph& aig );
+
 /******************************************************************************
  * mig_graph                                                                  *
  ******************************************************************************/
@@ -266,6 +275,15 @@ inline bool store_can_read_io_type<mig_graph, io_verilog_tag_t>( command& cmd )
 template<>
 mig_graph store_read_io_type<mig_graph, io_verilog_tag_t>( const std::string& filename, const command& cmd );
 
+template<>
+inline bool store_can_save_session<mig_graph>() { return true; }
+
+template<>
+void store_save_session<mig_graph>( std::ostream& os, const mig_graph& mig );
+
+template<>
+void store_load_session<mig_graph>( const char* data, std::size_t size, mig_graph& mig );
+
 /******************************************************************************
  * counterexample_t                                                           *
  ******************************************************************************/
@@ -346,6 +364,15 @@ inline bool store_can_write_io_type<tt, io_pla_tag_t>( command& cmd ) { return t
 template<>
 void store_write_io_type<tt, io_pla_tag_t>( const tt& t, const std::string& filename, const command& cmd );
 
+template<>
+inline bool store_can_save_session<tt>() { return true; }
+
+template<>
+void store_save_session<tt>( std::ostream& os, const tt& t );
+
+template<>
+void store_load_session<tt>( const char* data, std::size_t size, tt& t );
+
 /******************************************************************************
  * expression_t::ptr                                                          *
  ******************************************************************************/
@@ -384,6 +411,15 @@ inline bool store_can_convert<expression_t::ptr, bdd_function_t>() { return true
 template<>
 bdd_function_t store_convert<expression_t::ptr, bdd_function_t>( const expression_t::ptr& expr );
 
+template<>
+inline bool store_can_save_session<expression_t::ptr>() { return true; }
+
+template<>
+void store_save_session<expression_t::ptr>( std::ostream& os, const expression_t::ptr& expr );
+
+template<>
+void store_load_session<expression_t::ptr>( const char* data, std::size_t size, expression_t::ptr& expr );
+
 /******************************************************************************
  * xmg_graph                                                                  *
  ******************************************************************************/
@@ -483,6 +519,15 @@ bool store_can_write_io_type<xmg_graph, io_smt_tag_t>( command& cmd );
 template<>
 void store_write_io_type<xmg_graph, io_smt_tag_t>( const xmg_graph& xmg, const std::string& filename, const command& cmd );
 
+template<>
+inline bool store_can_save_session<xmg_graph>() { return true; }
+
+template<>
+void store_save_session<xmg_graph>( std::ostream& os, const xmg_graph& xmg );
+
+template<>
+void store_load_session<xmg_graph>( const char* data, std::size_t size, xmg_graph& xmg );
+
 }
 
 #endif
@@ -0,0 +1,287 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "packed_cover.hpp"
+
+#include <algorithm>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+constexpr packed_cover::cube_id packed_cover::npos;
+constexpr unsigned packed_cover::max_segments;
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace
+{
+
+inline std::uint64_t mix( std::uint64_t h )
+{
+  h ^= h >> 33u;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33u;
+  return h;
+}
+
+}
+
+std::uint64_t packed_cover::segment_key( unsigned s, const word_t* bits, const word_t* mask ) const
+{
+  std::uint64_t h = s;
+  const auto* m = &segment_masks[s * _num_words];
+  for ( auto w = 0u; w < _num_words; ++w )
+  {
+    if ( !m[w] ) { continue; }
+    h = mix( h ^ ( bits[w] & m[w] ) ) + 0x9e3779b97f4a7c15ull;
+    h = mix( h ^ ( mask[w] & m[w] ) );
+  }
+  return h;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+packed_cover::packed_cover( unsigned num_vars, unsigned num_segments )
+  : _num_vars( num_vars ),
+    _num_words( std::max( 1u, ( num_vars + 63u ) >> 6u ) ),
+    num_segments( std::min( std::max( num_segments, 1u ), max_segments ) )
+{
+  if ( _num_vars < this->num_segments )
+  {
+    /* one empty segment: every cube is a candidate */
+    this->num_segments = 1u;
+    single_bucket = true;
+  }
+
+  segment_masks.assign( this->num_segments * _num_words, 0u );
+  if ( !single_bucket )
+  {
+    for ( auto s = 0u; s < this->num_segments; ++s )
+    {
+      const auto first = s * _num_vars / this->num_segments;
+      const auto last  = ( s + 1u ) * _num_vars / this->num_segments;
+      for ( auto v = first; v < last; ++v )
+      {
+        set_bit( &segment_masks[s * _num_words], v, true );
+      }
+    }
+  }
+
+  buckets.resize( this->num_segments );
+}
+
+packed_cover::cube_id packed_cover::add( const word_t* bits, const word_t* mask )
+{
+  cube_id id;
+  if ( !free_ids.empty() )
+  {
+    id = free_ids.front();
+    free_ids.pop_front();
+  }
+  else
+  {
+    id = valid.size();
+    valid.push_back( 0 );
+    storage.resize( storage.size() + 2u * _num_words );
+  }
+
+  auto* dest = &storage[2u * _num_words * id];
+  std::copy( bits, bits + _num_words, dest );
+  std::copy( mask, mask + _num_words, dest + _num_words );
+  valid[id] = 1;
+  ++_size;
+
+  for ( auto s = 0u; s < num_segments; ++s )
+  {
+    buckets[s][segment_key( s, bits, mask )].push_back( id );
+  }
+
+  return id;
+}
+
+packed_cover::cube_id packed_cover::add( const cube& c )
+{
+  assert( c.length() == _num_vars );
+
+  std::vector<word_t> planes( 2u * _num_words, 0u );
+  const auto b = c.bits();
+  const auto m = c.care();
+  for ( auto v = 0u; v < _num_vars; ++v )
+  {
+    if ( m[v] )
+    {
+      set_bit( &planes[_num_words], v, true );
+      set_bit( &planes[0u], v, b[v] );
+    }
+  }
+  return add( &planes[0u], &planes[_num_words] );
+}
+
+packed_cover::cube_id packed_cover::add( const std::string& s )
+{
+  assert( s.size() == _num_vars );
+
+  std::vector<word_t> planes( 2u * _num_words, 0u );
+  for ( auto v = 0u; v < _num_vars; ++v )
+  {
+    if ( s[v] != '-' )
+    {
+      set_bit( &planes[_num_words], v, true );
+      set_bit( &planes[0u], v, s[v] == '1' );
+    }
+  }
+  return add( &planes[0u], &planes[_num_words] );
+}
+
+void packed_cover::remove( cube_id id )
+{
+  assert( is_valid( id ) );
+
+  for ( auto s = 0u; s < num_segments; ++s )
+  {
+    const auto it = buckets[s].find( segment_key( s, bits( id ), mask( id ) ) );
+    assert( it != buckets[s].end() );
+
+    auto& bucket = it->second;
+    const auto pos = std::find( bucket.begin(), bucket.end(), id );
+    assert( pos != bucket.end() );
+    *pos = bucket.back();
+    bucket.pop_back();
+
+    if ( bucket.empty() )
+    {
+      buckets[s].erase( it );
+    }
+  }
+
+  valid[id] = 0;
+  free_ids.push_back( id );
+  --_size;
+}
+
+unsigned packed_cover::num_literals( cube_id id ) const
+{
+  const auto* m = mask( id );
+  auto count = 0u;
+  for ( auto w = 0u; w < _num_words; ++w )
+  {
+    count += __builtin_popcountll( m[w] );
+  }
+  return count;
+}
+
+cube packed_cover::to_cube( cube_id id ) const
+{
+  return cube( to_string( id ) );
+}
+
+std::string packed_cover::to_string( cube_id id ) const
+{
+  std::string s( _num_vars, '-' );
+  for ( auto v = 0u; v < _num_vars; ++v )
+  {
+    if ( get_bit( mask( id ), v ) )
+    {
+      s[v] = get_bit( bits( id ), v ) ? '1' : '0';
+    }
+  }
+  return s;
+}
+
+unsigned packed_cover::distance( const word_t* bits1, const word_t* mask1, const word_t* bits2, const word_t* mask2 ) const
+{
+  auto d = 0u;
+  for ( auto w = 0u; w < _num_words; ++w )
+  {
+    d += __builtin_popcountll( ( bits1[w] ^ bits2[w] ) | ( mask1[w] ^ mask2[w] ) );
+  }
+  return d;
+}
+
+unsigned packed_cover::positions( cube_id a, cube_id b, unsigned* pos, unsigned max_count ) const
+{
+  const auto *b1 = bits( a ), *m1 = mask( a ), *b2 = bits( b ), *m2 = mask( b );
+
+  auto d = 0u;
+  for ( auto w = 0u; w < _num_words; ++w )
+  {
+    auto diff = ( b1[w] ^ b2[w] ) | ( m1[w] ^ m2[w] );
+    while ( diff )
+    {
+      if ( d < max_count )
+      {
+        pos[d] = ( w << 6u ) + __builtin_ctzll( diff );
+      }
+      ++d;
+      diff &= diff - 1u;
+    }
+  }
+  return d;
+}
+
+packed_cover::cube_id packed_cover::find( const word_t* bits, const word_t* mask ) const
+{
+  const auto it = buckets[0u].find( segment_key( 0u, bits, mask ) );
+  if ( it == buckets[0u].end() ) { return npos; }
+
+  for ( auto id : it->second )
+  {
+    if ( std::equal( bits, bits + _num_words, this->bits( id ) ) && std::equal( mask, mask + _num_words, this->mask( id ) ) )
+    {
+      return id;
+    }
+  }
+  return npos;
+}
+
+std::size_t packed_cover::memory() const
+{
+  auto bytes = storage.capacity() * sizeof( word_t ) + valid.capacity() + free_ids.size() * sizeof( cube_id );
+  for ( const auto& b : buckets )
+  {
+    for ( const auto& p : b )
+    {
+      bytes += sizeof( p ) + p.second.capacity() * sizeof( cube_id );
+    }
+  }
+  return bytes;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,204 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file packed_cover.hpp
+ *
+ * @brief Bit-sliced cube cover for EXORLINK based ESOP minimization
+ *
+ * All cubes of a cover live in one arena.  A cube over n variables is stored
+ * as two bit-planes of ceil(n/64) words each: the polarity plane and the care
+ * plane (a literal is '-' if its care bit is 0, in which case its polarity
+ * bit is 0 as well).  The distance of two cubes is the population count of
+ * the XOR of both planes.
+ *
+ * Cubes are indexed by segments: the variables are split into S contiguous
+ * segments and every cube is put into one bucket per segment, keyed by the
+ * contents of that segment.  Two cubes with distance d < S agree on at least
+ * one segment, hence all cubes within distance S - 1 of a query are found in
+ * the query's S buckets.  This replaces the linear scans for distance-0,
+ * distance-1, and EXORLINK pair candidates.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef PACKED_COVER_HPP
+#define PACKED_COVER_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <core/cube.hpp>
+
+namespace cirkit
+{
+
+class packed_cover
+{
+public:
+  using word_t  = std::uint64_t;
+  using cube_id = std::uint32_t;
+
+  static constexpr cube_id npos = std::numeric_limits<cube_id>::max();
+
+public:
+  /* neighbors can be searched up to distance num_segments - 1 */
+  explicit packed_cover( unsigned num_vars, unsigned num_segments = 5u );
+
+  inline unsigned num_vars() const  { return _num_vars; }
+  inline unsigned num_words() const { return _num_words; }
+
+  /* number of cubes in the cover */
+  inline std::size_t size() const { return _size; }
+
+  /* ids are in [0, id_bound()), removed ids are reused in removal order */
+  inline cube_id id_bound() const { return valid.size(); }
+  inline bool is_valid( cube_id id ) const { return id < valid.size() && valid[id]; }
+
+  cube_id add( const word_t* bits, const word_t* mask );
+  cube_id add( const cube& c );
+  cube_id add( const std::string& s );
+  void remove( cube_id id );
+
+  inline const word_t* bits( cube_id id ) const { return &storage[2u * _num_words * id]; }
+  inline const word_t* mask( cube_id id ) const { return &storage[2u * _num_words * id + _num_words]; }
+
+  unsigned num_literals( cube_id id ) const;
+  cube to_cube( cube_id id ) const;
+  std::string to_string( cube_id id ) const;
+
+  /* number of positions in which two cubes differ */
+  unsigned distance( const word_t* bits1, const word_t* mask1, const word_t* bits2, const word_t* mask2 ) const;
+  inline unsigned distance( cube_id a, cube_id b ) const { return distance( bits( a ), mask( a ), bits( b ), mask( b ) ); }
+
+  /* writes the first (at most max_count) differing positions to pos, returns the distance */
+  unsigned positions( cube_id a, cube_id b, unsigned* pos, unsigned max_count ) const;
+
+  /* exact match or npos */
+  cube_id find( const word_t* bits, const word_t* mask ) const;
+
+  /* calls f( id, distance ) once for each cube with distance <= max_distance < num_segments */
+  template<typename Fn>
+  void foreach_neighbor( const word_t* bits, const word_t* mask, unsigned max_distance, Fn&& f ) const
+  {
+    assert( single_bucket || max_distance < num_segments );
+
+    std::uint64_t keys[max_segments];
+    for ( auto s = 0u; s < num_segments; ++s )
+    {
+      keys[s] = segment_key( s, bits, mask );
+    }
+
+    for ( auto s = 0u; s < num_segments; ++s )
+    {
+      const auto it = buckets[s].find( keys[s] );
+      if ( it == buckets[s].end() ) { continue; }
+
+      for ( auto id : it->second )
+      {
+        /* visited through an earlier segment? */
+        auto seen = false;
+        for ( auto t = 0u; t < s && !seen; ++t )
+        {
+          seen = segment_key( t, this->bits( id ), this->mask( id ) ) == keys[t];
+        }
+        if ( seen ) { continue; }
+
+        const auto d = distance( bits, mask, this->bits( id ), this->mask( id ) );
+        if ( d <= max_distance )
+        {
+          f( id, d );
+        }
+      }
+    }
+  }
+
+  template<typename Fn>
+  inline void foreach_neighbor( cube_id id, unsigned max_distance, Fn&& f ) const
+  {
+    foreach_neighbor( bits( id ), mask( id ), max_distance, f );
+  }
+
+  template<typename Fn>
+  void foreach_cube( Fn&& f ) const
+  {
+    for ( cube_id id = 0u; id < valid.size(); ++id )
+    {
+      if ( valid[id] ) { f( id ); }
+    }
+  }
+
+  /* single literal access and update on plain planes, e.g., scratch cubes */
+  static inline bool get_bit( const word_t* plane, unsigned var )
+  {
+    return ( plane[var >> 6u] >> ( var & 63u ) ) & 1u;
+  }
+
+  static inline void set_bit( word_t* plane, unsigned var, bool value )
+  {
+    const auto m = word_t( 1 ) << ( var & 63u );
+    plane[var >> 6u] = value ? ( plane[var >> 6u] | m ) : ( plane[var >> 6u] & ~m );
+  }
+
+  /* memory of cube storage and index in bytes */
+  std::size_t memory() const;
+
+private:
+  std::uint64_t segment_key( unsigned s, const word_t* bits, const word_t* mask ) const;
+
+private:
+  static constexpr unsigned max_segments = 16u;
+
+  unsigned                 _num_vars;
+  unsigned                 _num_words;
+  unsigned                 num_segments;
+  bool                     single_bucket = false; /* too few variables, all cubes in one bucket */
+  std::size_t              _size = 0u;
+
+  std::vector<word_t>      storage;
+  std::vector<char>        valid;
+  std::deque<cube_id>      free_ids;
+
+  /* per segment and word, the variables of the segment */
+  std::vector<word_t>      segment_masks;
+  std::vector<std::unordered_map<std::uint64_t, std::vector<cube_id>>> buckets;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
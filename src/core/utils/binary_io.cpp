@@ -0,0 +1,119 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "binary_io.hpp"
+
+#include <algorithm>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+binary_writer::binary_writer( std::ostream& os )
+  : os( os ),
+    start( os.tellp() )
+{
+}
+
+void binary_writer::write_string( const std::string& s )
+{
+  write_array( s.data(), s.size() );
+}
+
+void binary_writer::write_bitset( const boost::dynamic_bitset<>& b )
+{
+  std::vector<boost::dynamic_bitset<>::block_type> blocks( b.num_blocks() );
+  boost::to_block_range( b, blocks.begin() );
+
+  write<std::uint64_t>( b.size() );
+  write_vector( blocks );
+}
+
+void binary_writer::align()
+{
+  static const char zeros[8] = {};
+
+  const auto offset = static_cast<std::size_t>( os.tellp() - start );
+  if ( offset % 8u != 0u )
+  {
+    os.write( zeros, 8u - offset % 8u );
+  }
+}
+
+binary_reader::binary_reader( const char* data, std::size_t size )
+  : data( data ),
+    size( size )
+{
+}
+
+std::string binary_reader::read_string()
+{
+  const auto r = read_array<char>();
+  return std::string( r.begin(), r.end() );
+}
+
+boost::dynamic_bitset<> binary_reader::read_bitset()
+{
+  const auto num_bits = read<std::uint64_t>();
+  const auto blocks = read_array<boost::dynamic_bitset<>::block_type>();
+
+  boost::dynamic_bitset<> b( blocks.begin(), blocks.end() );
+  if ( num_bits > b.size() ) { throw std::runtime_error( "binary data is corrupt" ); }
+  b.resize( num_bits );
+  return b;
+}
+
+void binary_reader::align()
+{
+  pos = std::min( size, ( pos + 7u ) & ~static_cast<std::size_t>( 7u ) );
+}
+
+const char* binary_reader::advance( std::size_t bytes )
+{
+  if ( bytes > size - pos ) { throw std::runtime_error( "binary data is truncated" ); }
+  const auto* p = data + pos;
+  pos += bytes;
+  return p;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,157 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file binary_io.hpp
+ *
+ * @brief Raw binary writer and zero-copy reader for snapshots
+ *
+ * Arrays are written as their element count followed by the raw elements,
+ * padded to 8 bytes relative to the position at which the writer was
+ * created.  If the reader sees the data at an 8-byte aligned address, e.g.,
+ * from a memory-mapped file, arrays can be used in place.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef BINARY_IO_HPP
+#define BINARY_IO_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/range/iterator_range.hpp>
+
+namespace cirkit
+{
+
+class binary_writer
+{
+public:
+  explicit binary_writer( std::ostream& os );
+
+  template<typename T>
+  void write( const T& value )
+  {
+    static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable values can be written" );
+    os.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+  }
+
+  template<typename T>
+  void write_array( const T* data, std::size_t count )
+  {
+    static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable values can be written" );
+    write<std::uint64_t>( count );
+    align();
+    os.write( reinterpret_cast<const char*>( data ), count * sizeof( T ) );
+    align();
+  }
+
+  template<typename T>
+  void write_vector( const std::vector<T>& v )
+  {
+    write_array( v.data(), v.size() );
+  }
+
+  void write_string( const std::string& s );
+  void write_bitset( const boost::dynamic_bitset<>& b );
+
+  /* pads with zeros to the next multiple of 8 */
+  void align();
+
+private:
+  std::ostream&  os;
+  std::streamoff start;
+};
+
+/* all read functions throw std::runtime_error if data is exceeded */
+class binary_reader
+{
+public:
+  binary_reader( const char* data, std::size_t size );
+
+  template<typename T>
+  T read()
+  {
+    static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable values can be read" );
+    T value;
+    std::memcpy( &value, advance( sizeof( T ) ), sizeof( T ) );
+    return value;
+  }
+
+  /* points into the data, valid as long as the data is */
+  template<typename T>
+  boost::iterator_range<const T*> read_array()
+  {
+    static_assert( std::is_trivially_copyable<T>::value, "only trivially copyable values can be read" );
+    const auto count = read<std::uint64_t>();
+    align();
+    if ( count > ( size - pos ) / sizeof( T ) ) { throw std::runtime_error( "binary data is truncated" ); }
+    const auto* begin = reinterpret_cast<const T*>( advance( count * sizeof( T ) ) );
+    align();
+    return boost::make_iterator_range( begin, begin + count );
+  }
+
+  template<typename T>
+  std::vector<T> read_vector()
+  {
+    const auto r = read_array<T>();
+    return std::vector<T>( r.begin(), r.end() );
+  }
+
+  std::string read_string();
+  boost::dynamic_bitset<> read_bitset();
+
+  void align();
+
+  inline std::size_t position() const { return pos; }
+  inline bool at_end() const { return pos == size; }
+
+private:
+  const char* advance( std::size_t bytes );
+
+private:
+  const char* data;
+  std::size_t size;
+  std::size_t pos = 0u;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,248 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "level_scheduler.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+inline uint64_t pack_queue_state( unsigned level, unsigned chunk )
+{
+  /* level is shifted by one, such that 0 means uninitialized */
+  return ( static_cast<uint64_t>( level + 1u ) << 32u ) | chunk;
+}
+
+void level_scheduler::work( unsigned id )
+{
+  const auto num_levels = _offsets->size() - 1u;
+
+  for ( auto l = 0u; l < num_levels; ++l )
+  {
+    while ( _released.load( std::memory_order_acquire ) < l )
+    {
+      std::this_thread::yield();
+    }
+
+    /* empty levels are released by the first thread */
+    if ( _chunk_offsets[l] == _chunk_offsets[l + 1u] )
+    {
+      if ( id == 0u )
+      {
+        if ( *_on_level ) { ( *_on_level )( l ); }
+        _released.store( l + 1u, std::memory_order_release );
+      }
+      continue;
+    }
+
+    unsigned chunk;
+
+    /* own chunks first */
+    while ( claim( id, l, chunk ) )
+    {
+      process_chunk( l, chunk );
+    }
+
+    /* then steal from the others */
+    for ( auto i = 1u; i < _num_threads; ++i )
+    {
+      const auto victim = ( id + i ) % _num_threads;
+      while ( claim( victim, l, chunk ) )
+      {
+        _steals.fetch_add( 1u, std::memory_order_relaxed );
+        process_chunk( l, chunk );
+      }
+    }
+  }
+}
+
+bool level_scheduler::claim( unsigned owner, unsigned level, unsigned& chunk )
+{
+  auto& state = _queues[owner].state;
+  const auto end = range_end( level, owner );
+  const auto tag = static_cast<uint64_t>( level + 1u );
+
+  auto current = state.load( std::memory_order_acquire );
+  while ( true )
+  {
+    const auto current_tag = current >> 32u;
+
+    /* the queue has already moved on to another level */
+    if ( current_tag > tag ) { return false; }
+
+    /* the first thread that accesses the queue in this level resets it */
+    const auto next = ( current_tag < tag ) ? range_begin( level, owner ) : static_cast<unsigned>( current & 0xffffffff );
+    if ( next >= end ) { return false; }
+
+    if ( state.compare_exchange_weak( current, pack_queue_state( level, next + 1u ), std::memory_order_acq_rel, std::memory_order_acquire ) )
+    {
+      chunk = next;
+      return true;
+    }
+  }
+}
+
+void level_scheduler::process_chunk( unsigned level, unsigned chunk )
+{
+  const auto& offsets = *_offsets;
+  const auto first = offsets[level] + ( chunk - _chunk_offsets[level] ) * _chunk_size;
+  const auto last = std::min( first + _chunk_size, offsets[level + 1u] );
+
+  for ( auto i = first; i < last; ++i )
+  {
+    ( *_on_element )( i );
+  }
+
+  /* the thread that completes the last chunk of a level releases the next one */
+  if ( _completed.fetch_add( 1u, std::memory_order_acq_rel ) + 1u == _chunk_offsets[level + 1u] )
+  {
+    if ( *_on_level ) { ( *_on_level )( level ); }
+    _released.store( level + 1u, std::memory_order_release );
+  }
+}
+
+unsigned level_scheduler::range_begin( unsigned level, unsigned owner ) const
+{
+  const auto count = static_cast<uint64_t>( _chunk_offsets[level + 1u] - _chunk_offsets[level] );
+  return _chunk_offsets[level] + static_cast<unsigned>( ( count * owner ) / _num_threads );
+}
+
+unsigned level_scheduler::range_end( unsigned level, unsigned owner ) const
+{
+  return range_begin( level, owner + 1u );
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+level_scheduler::level_scheduler( unsigned num_threads, unsigned chunk_size )
+  : _num_threads( num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : num_threads ),
+    _chunk_size( std::max( 1u, chunk_size ) ),
+    _completed( 0u ),
+    _released( 0u ),
+    _steals( 0u )
+{
+}
+
+void level_scheduler::run( const std::vector<unsigned>& offsets, const element_func& on_element, const level_func& on_level )
+{
+  _chunk_offsets.clear();
+  _steals = 0u;
+
+  if ( offsets.size() < 2u ) { return; }
+
+  const auto num_levels = offsets.size() - 1u;
+
+  _chunk_offsets.resize( num_levels + 1u, 0u );
+  for ( auto l = 0u; l < num_levels; ++l )
+  {
+    const auto size = offsets[l + 1u] - offsets[l];
+    _chunk_offsets[l + 1u] = _chunk_offsets[l] + ( size + _chunk_size - 1u ) / _chunk_size;
+  }
+
+  /* no need to spawn threads if all work fits into one chunk */
+  if ( _num_threads == 1u || offsets.back() - offsets.front() <= _chunk_size )
+  {
+    for ( auto l = 0u; l < num_levels; ++l )
+    {
+      for ( auto i = offsets[l]; i < offsets[l + 1u]; ++i )
+      {
+        on_element( i );
+      }
+      if ( on_level ) { on_level( l ); }
+    }
+    return;
+  }
+
+  _offsets    = &offsets;
+  _on_element = &on_element;
+  _on_level   = &on_level;
+  _queues.reset( new chunk_queue[_num_threads] );
+  for ( auto i = 0u; i < _num_threads; ++i )
+  {
+    _queues[i].state.store( 0u, std::memory_order_relaxed );
+  }
+  _completed.store( 0u, std::memory_order_relaxed );
+  _released.store( 0u, std::memory_order_release );
+
+  /* the calling thread is worker 0 */
+  std::vector<std::thread> workers;
+  workers.reserve( _num_threads - 1u );
+  for ( auto i = 1u; i < _num_threads; ++i )
+  {
+    workers.emplace_back( [this, i]() { this->work( i ); } );
+  }
+  work( 0u );
+
+  for ( auto& worker : workers )
+  {
+    worker.join();
+  }
+
+  _offsets    = nullptr;
+  _on_element = nullptr;
+  _on_level   = nullptr;
+}
+
+unsigned level_scheduler::num_threads() const
+{
+  return _num_threads;
+}
+
+unsigned level_scheduler::chunk_size() const
+{
+  return _chunk_size;
+}
+
+unsigned long level_scheduler::num_chunks() const
+{
+  return _chunk_offsets.empty() ? 0u : _chunk_offsets.back();
+}
+
+unsigned long level_scheduler::num_steals() const
+{
+  return _steals.load( std::memory_order_relaxed );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
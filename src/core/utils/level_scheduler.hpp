@@ -0,0 +1,122 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file level_scheduler.hpp
+ *
+ * @brief Work-stealing scheduler for levelized computations
+ *
+ * The elements of a levelized structure (e.g., the nodes of a logic network
+ * grouped by their level) are processed by a bounded number of threads.  All
+ * elements of one level are independent and split into fixed-size chunks.
+ * Each thread owns a contiguous range of chunks per level and steals chunks
+ * from other threads once its own range is exhausted.  Threads synchronize
+ * only through atomic counters, a level is released after all of its chunks
+ * have been processed.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef LEVEL_SCHEDULER_HPP
+#define LEVEL_SCHEDULER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace cirkit
+{
+
+class level_scheduler
+{
+public:
+  using element_func = std::function<void( unsigned )>;
+  using level_func   = std::function<void( unsigned )>;
+
+  /* num_threads = 0 uses the number of cores */
+  explicit level_scheduler( unsigned num_threads = 0u, unsigned chunk_size = 256u );
+
+  /* The elements of level l are the indexes offsets[l], ..., offsets[l + 1] - 1,
+     i.e., offsets has one more entry than there are levels.  on_element is called
+     exactly once for each index, possibly from different threads.  on_level is
+     called by exactly one thread after all elements of a level have been processed
+     and before any element of the next level is processed. */
+  void run( const std::vector<unsigned>& offsets, const element_func& on_element, const level_func& on_level = level_func() );
+
+  unsigned num_threads() const;
+  unsigned chunk_size() const;
+
+  /* statistics of last run */
+  unsigned long num_chunks() const;
+  unsigned long num_steals() const;
+
+private:
+  /* padded to a cache line to avoid false sharing between threads */
+  struct chunk_queue
+  {
+    /* upper 32 bits: level, lower 32 bits: next chunk */
+    std::atomic<uint64_t> state;
+    char                  padding[64u - sizeof( std::atomic<uint64_t> )];
+  };
+
+  void work( unsigned id );
+  bool claim( unsigned owner, unsigned level, unsigned& chunk );
+  void process_chunk( unsigned level, unsigned chunk );
+
+  unsigned range_begin( unsigned level, unsigned owner ) const;
+  unsigned range_end( unsigned level, unsigned owner ) const;
+
+private:
+  unsigned                       _num_threads;
+  unsigned                       _chunk_size;
+
+  /* state of current run */
+  const std::vector<unsigned>*   _offsets = nullptr;
+  const element_func*            _on_element = nullptr;
+  const level_func*              _on_level = nullptr;
+  std::vector<unsigned>          _chunk_offsets;
+  std::unique_ptr<chunk_queue[]> _queues;
+
+  std::atomic<unsigned long>     _completed;
+  char                           _padding1[64u];
+  std::atomic<unsigned>          _released;
+  char                           _padding2[64u];
+  std::atomic<unsigned long>     _steals;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,321 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include <sys/resource.h>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+namespace detail
+{
+std::atomic<bool> profiling_flag{false};
+
+std::atomic<std::uint64_t> profile_allocations{0u};
+std::atomic<std::uint64_t> profile_allocated_bytes{0u};
+}
+
+struct profile_registry
+{
+  std::mutex                                               mutex;
+  std::map<std::string, std::unique_ptr<profile_counter>> counters;
+  std::map<std::string, std::unique_ptr<profile_timer>>   timers;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace
+{
+
+profile_registry& registry()
+{
+  static profile_registry r;
+  return r;
+}
+
+template<typename T>
+T& get_or_create( std::map<std::string, std::unique_ptr<T>>& map, const std::string& name )
+{
+  std::lock_guard<std::mutex> lock( registry().mutex );
+
+  auto& entry = map[name];
+  if ( !entry )
+  {
+    entry.reset( new T() );
+  }
+  return *entry;
+}
+
+std::uint64_t read_peak_rss()
+{
+  /* VmHWM respects resets through clear_refs, ru_maxrss does not */
+  std::ifstream is( "/proc/self/status" );
+  std::string line;
+  while ( std::getline( is, line ) )
+  {
+    if ( line.compare( 0u, 6u, "VmHWM:" ) == 0 )
+    {
+      return std::strtoull( line.c_str() + 6u, nullptr, 10 );
+    }
+  }
+
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss;
+}
+
+#ifdef CIRKIT_COUNT_ALLOCATIONS
+inline void count_allocation( std::size_t size )
+{
+  if ( profiling_enabled() )
+  {
+    detail::profile_allocations.fetch_add( 1u, std::memory_order_relaxed );
+    detail::profile_allocated_bytes.fetch_add( size, std::memory_order_relaxed );
+  }
+}
+#endif
+
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void set_profiling_enabled( bool enabled )
+{
+  detail::profiling_flag = enabled;
+}
+
+profile_counter& get_profile_counter( const std::string& name )
+{
+  return get_or_create( registry().counters, name );
+}
+
+profile_timer& get_profile_timer( const std::string& name )
+{
+  return get_or_create( registry().timers, name );
+}
+
+profile_scope::profile_scope( profile_timer& timer )
+  : timer( timer ),
+    start( std::chrono::steady_clock::now() )
+{
+}
+
+profile_scope::profile_scope( const std::string& name )
+  : profile_scope( get_profile_timer( name ) )
+{
+}
+
+profile_scope::~profile_scope()
+{
+  timer.add( std::chrono::steady_clock::now() - start );
+}
+
+profile_snapshot take_profile_snapshot()
+{
+  profile_snapshot snapshot;
+
+  {
+    std::lock_guard<std::mutex> lock( registry().mutex );
+    for ( const auto& p : registry().counters )
+    {
+      snapshot.counters[p.first] = p.second->value.load();
+    }
+    for ( const auto& p : registry().timers )
+    {
+      auto& value = snapshot.timers[p.first];
+      value.calls = p.second->calls.load();
+      value.seconds = p.second->nanoseconds.load() * 1e-9;
+    }
+  }
+
+  snapshot.allocations = detail::profile_allocations.load();
+  snapshot.allocated_bytes = detail::profile_allocated_bytes.load();
+  snapshot.peak_rss = read_peak_rss();
+
+  return snapshot;
+}
+
+profile_snapshot operator-( const profile_snapshot& after, const profile_snapshot& before )
+{
+  profile_snapshot diff = after;
+
+  for ( auto& p : diff.counters )
+  {
+    const auto it = before.counters.find( p.first );
+    if ( it != before.counters.end() )
+    {
+      p.second -= std::min( p.second, it->second );
+    }
+  }
+  for ( auto& p : diff.timers )
+  {
+    const auto it = before.timers.find( p.first );
+    if ( it != before.timers.end() )
+    {
+      p.second.calls -= std::min( p.second.calls, it->second.calls );
+      p.second.seconds = std::max( 0.0, p.second.seconds - it->second.seconds );
+    }
+  }
+
+  diff.allocations -= std::min( diff.allocations, before.allocations );
+  diff.allocated_bytes -= std::min( diff.allocated_bytes, before.allocated_bytes );
+
+  return diff;
+}
+
+void reset_profile()
+{
+  std::lock_guard<std::mutex> lock( registry().mutex );
+  for ( auto& p : registry().counters )
+  {
+    p.second->value = 0u;
+  }
+  for ( auto& p : registry().timers )
+  {
+    p.second->calls = 0u;
+    p.second->nanoseconds = 0u;
+  }
+  detail::profile_allocations = 0u;
+  detail::profile_allocated_bytes = 0u;
+}
+
+bool reset_peak_rss()
+{
+  std::ofstream os( "/proc/self/clear_refs" );
+  os << "5";
+  os.close();
+  return static_cast<bool>( os );
+}
+
+}
+
+/******************************************************************************
+ * Allocation counting                                                        *
+ ******************************************************************************/
+
+/* replacing the global allocation functions affects every program that links
+   this library, therefore it is only done on request (cirkit_ENABLE_ALLOCATION_COUNTING) */
+#ifdef CIRKIT_COUNT_ALLOCATIONS
+
+void* operator new( std::size_t size )
+{
+  cirkit::count_allocation( size );
+
+  if ( size == 0u )
+  {
+    size = 1u;
+  }
+
+  while ( true )
+  {
+    if ( auto p = std::malloc( size ) )
+    {
+      return p;
+    }
+
+    const auto handler = std::get_new_handler();
+    if ( !handler )
+    {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void* operator new[]( std::size_t size )
+{
+  return ::operator new( size );
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+  try
+  {
+    return ::operator new( size );
+  }
+  catch ( ... )
+  {
+    return nullptr;
+  }
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+  return ::operator new( size, std::nothrow );
+}
+
+void operator delete( void* p ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete[]( void* p ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete( void* p, std::size_t ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete[]( void* p, std::size_t ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete( void* p, const std::nothrow_t& ) noexcept
+{
+  std::free( p );
+}
+
+void operator delete[]( void* p, const std::nothrow_t& ) noexcept
+{
+  std::free( p );
+}
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
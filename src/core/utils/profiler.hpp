@@ -0,0 +1,170 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file profiler.hpp
+ *
+ * @brief Named counters and timers for hot-path instrumentation
+ *
+ * Counters and timers are registered by name in a global registry and live
+ * for the whole program, such that a reference can be kept in a function
+ * local static:
+ *
+ * @code
+ * static auto& hits = get_profile_counter( "npn.cache_hit" );
+ * hits.add();
+ * @endcode
+ *
+ * Updates are relaxed atomic increments that are skipped when profiling is
+ * disabled.  If cirkit is configured with cirkit_ENABLE_ALLOCATION_COUNTING,
+ * all allocations through operator new are counted as well while profiling
+ * is enabled, otherwise the allocation counts stay zero.
+ * take_profile_snapshot collects the current
+ * values together with the peak resident set size; differences of two
+ * snapshots give the profile of the code executed in between.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace cirkit
+{
+
+namespace detail
+{
+extern std::atomic<bool> profiling_flag;
+}
+
+inline bool profiling_enabled()
+{
+  return detail::profiling_flag.load( std::memory_order_relaxed );
+}
+
+void set_profiling_enabled( bool enabled );
+
+class profile_counter
+{
+public:
+  inline void add( std::uint64_t n = 1u )
+  {
+    if ( profiling_enabled() )
+    {
+      value.fetch_add( n, std::memory_order_relaxed );
+    }
+  }
+
+  inline profile_counter& operator++()
+  {
+    add();
+    return *this;
+  }
+
+  std::atomic<std::uint64_t> value{0u};
+};
+
+class profile_timer
+{
+public:
+  inline void add( std::chrono::steady_clock::duration d )
+  {
+    if ( profiling_enabled() )
+    {
+      calls.fetch_add( 1u, std::memory_order_relaxed );
+      nanoseconds.fetch_add( std::chrono::duration_cast<std::chrono::nanoseconds>( d ).count(), std::memory_order_relaxed );
+    }
+  }
+
+  std::atomic<std::uint64_t> calls{0u};
+  std::atomic<std::uint64_t> nanoseconds{0u};
+};
+
+/* references stay valid for the lifetime of the program */
+profile_counter& get_profile_counter( const std::string& name );
+profile_timer& get_profile_timer( const std::string& name );
+
+/* adds the elapsed time to a timer when leaving the scope */
+class profile_scope
+{
+public:
+  explicit profile_scope( profile_timer& timer );
+  explicit profile_scope( const std::string& name );
+  ~profile_scope();
+
+private:
+  profile_timer&                        timer;
+  std::chrono::steady_clock::time_point start;
+};
+
+struct profile_timer_value
+{
+  std::uint64_t calls = 0u;
+  double        seconds = 0.0;
+};
+
+struct profile_snapshot
+{
+  std::map<std::string, std::uint64_t>       counters;
+  std::map<std::string, profile_timer_value> timers;
+
+  std::uint64_t allocations = 0u;
+  std::uint64_t allocated_bytes = 0u;
+
+  /* peak resident set size in KB since the last reset_peak_rss */
+  std::uint64_t peak_rss = 0u;
+};
+
+profile_snapshot take_profile_snapshot();
+
+/* differences of all counters, timers, and allocations; the peak resident
+   set size is taken from after */
+profile_snapshot operator-( const profile_snapshot& after, const profile_snapshot& before );
+
+/* sets all counters and timers to 0 */
+void reset_profile();
+
+/* resets the peak resident set size to the current one, if supported by the
+   operating system (Linux >= 4.0), otherwise the peak is for the whole
+   process lifetime; returns true on success */
+bool reset_peak_rss();
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
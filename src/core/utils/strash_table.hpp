@@ -0,0 +1,215 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file strash_table.hpp
+ *
+ * @brief Open addressing table for structural hashing
+ *
+ * Keys are N literals packed as (node << 1) | complement, values are node
+ * indexes.  Entries are stored inline in one power-of-two array and looked
+ * up with linear probing, which keeps a lookup within one or two cache lines
+ * instead of following the bucket lists of std::unordered_map or the tree
+ * nodes of std::map.  The table never shrinks and entries are never removed,
+ * which matches how the graph classes use it.
+ *
+ * @author Mathias Soeken
+ * @since  2.4
+ */
+
+#ifndef STRASH_TABLE_HPP
+#define STRASH_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cirkit
+{
+
+template<unsigned N>
+class strash_table
+{
+public:
+  using literal_t = std::uint64_t;
+  using key_t     = std::array<literal_t, N>;
+  using value_t   = std::uint64_t;
+
+  static constexpr value_t empty = std::numeric_limits<value_t>::max();
+
+  struct entry
+  {
+    key_t   key;
+    value_t value = empty;
+  };
+
+  static inline literal_t make_literal( std::uint64_t node, bool complemented )
+  {
+    return ( node << 1u ) | static_cast<literal_t>( complemented );
+  }
+
+public:
+  explicit strash_table( std::size_t expected_size = 0u )
+  {
+    reserve( expected_size );
+  }
+
+  /* make room for expected_size entries without rehashing */
+  void reserve( std::size_t expected_size )
+  {
+    auto capacity = std::max<std::size_t>( entries.size(), 64u );
+    while ( capacity < 2u * expected_size )
+    {
+      capacity <<= 1u;
+    }
+    if ( capacity != entries.size() )
+    {
+      rehash( capacity );
+    }
+  }
+
+  /* returns empty if key is not in the table */
+  value_t find( const key_t& key ) const
+  {
+    const auto mask = entries.size() - 1u;
+    for ( auto pos = hash( key ) & mask; ; pos = ( pos + 1u ) & mask )
+    {
+      const auto& e = entries[pos];
+      if ( e.value == empty )  { return empty; }
+      if ( e.key == key )      { return e.value; }
+    }
+  }
+
+  /* key must not be in the table */
+  void insert( const key_t& key, value_t value )
+  {
+    assert( value != empty );
+
+    if ( 2u * ( num_entries + 1u ) > entries.size() )
+    {
+      rehash( entries.size() << 1u );
+    }
+
+    place( key, value );
+    ++num_entries;
+  }
+
+  /* inserts key or, if it is already in the table, replaces its value */
+  void insert_or_assign( const key_t& key, value_t value )
+  {
+    assert( value != empty );
+
+    const auto mask = entries.size() - 1u;
+    for ( auto pos = hash( key ) & mask; entries[pos].value != empty; pos = ( pos + 1u ) & mask )
+    {
+      if ( entries[pos].key == key )
+      {
+        entries[pos].value = value;
+        return;
+      }
+    }
+
+    insert( key, value );
+  }
+
+  void clear()
+  {
+    entries.assign( entries.size(), entry() );
+    num_entries = 0u;
+  }
+
+  inline std::size_t size() const     { return num_entries; }
+  inline std::size_t capacity() const { return entries.size(); }
+  inline std::size_t memory() const   { return entries.size() * sizeof( entry ); }
+
+  /* raw slots, e.g., for binary snapshots; restore expects slots as returned by slots() */
+  inline const std::vector<entry>& slots() const { return entries; }
+
+  template<typename Iterator>
+  void restore( Iterator begin, Iterator end )
+  {
+    entries.assign( begin, end );
+    assert( !entries.empty() && ( entries.size() & ( entries.size() - 1u ) ) == 0u );
+    num_entries = std::count_if( entries.begin(), entries.end(), []( const entry& e ) { return e.value != empty; } );
+  }
+
+private:
+  static inline std::size_t hash( const key_t& key )
+  {
+    std::uint64_t h = 0u;
+    for ( auto l : key )
+    {
+      h = ( h ^ l ) * 0x9e3779b97f4a7c15ull;
+    }
+    return static_cast<std::size_t>( h ^ ( h >> 29u ) );
+  }
+
+  void place( const key_t& key, value_t value )
+  {
+    const auto mask = entries.size() - 1u;
+    auto pos = hash( key ) & mask;
+    while ( entries[pos].value != empty )
+    {
+      pos = ( pos + 1u ) & mask;
+    }
+    entries[pos].key   = key;
+    entries[pos].value = value;
+  }
+
+  void rehash( std::size_t capacity )
+  {
+    std::vector<entry> old( capacity );
+    old.swap( entries );
+
+    for ( const auto& e : old )
+    {
+      if ( e.value != empty )
+      {
+        place( e.key, e.value );
+      }
+    }
+  }
+
+private:
+  std::vector<entry> entries;
+  std::size_t        num_entries = 0u;
+};
+
+template<unsigned N>
+constexpr typename strash_table<N>::value_t strash_table<N>::empty;
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,238 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE aiger
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/compact_aig.hpp>
+#include <classical/functions/bit_parallel_simulation.hpp>
+#include <classical/io/read_aiger.hpp>
+#include <classical/io/write_aiger.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+aig_graph random_aig( unsigned num_inputs, unsigned num_gates, unsigned num_outputs, std::mt19937& gen )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> fs;
+  fs.push_back( aig_get_constant( aig, false ) );
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+
+  for ( auto k = 0u; k < num_gates; ++k )
+  {
+    auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+    if ( gen() & 1u ) { a = !a; }
+    if ( gen() & 1u ) { b = !b; }
+    fs.push_back( aig_create_and( aig, a, b ) );
+  }
+
+  /* besides gates, outputs may be constants, (complemented) inputs, or repeat another output */
+  aig_create_po( aig, fs[0u], "zero" );
+  aig_create_po( aig, !fs[0u], "one" );
+  aig_create_po( aig, !fs[1u], "not_x0" );
+  for ( auto o = 0u; o < num_outputs; ++o )
+  {
+    auto f = fs[fs.size() - 1u - gen() % ( fs.size() / 2u )];
+    aig_create_po( aig, ( gen() & 1u ) ? !f : f, "y" + std::to_string( o ) );
+  }
+  aig_create_po( aig, aig_info( aig ).outputs.back().first, "" );
+
+  return aig;
+}
+
+std::vector<boost::dynamic_bitset<>> random_patterns( unsigned n, unsigned num, std::mt19937& gen )
+{
+  std::vector<boost::dynamic_bitset<>> patterns( n, boost::dynamic_bitset<>( num ) );
+  for ( auto& p : patterns )
+  {
+    for ( auto j = 0u; j < num; ++j )
+    {
+      p[j] = gen() & 1u;
+    }
+  }
+  return patterns;
+}
+
+aig_graph read_from_string( const std::string& contents, bool noopt = false )
+{
+  aig_graph aig;
+  std::istringstream is( contents );
+  read_aiger_binary( aig, is, noopt );
+  return aig;
+}
+
+/* the AIGER varint encoding of a single value */
+std::string encode( unsigned value )
+{
+  std::string s;
+  while ( value & ~0x7fu )
+  {
+    s += static_cast<char>( ( value & 0x7fu ) | 0x80u );
+    value >>= 7u;
+  }
+  s += static_cast<char>( value );
+  return s;
+}
+
+void check_same_interface( const aig_graph& aig, const aig_graph& back )
+{
+  const auto& info = aig_info( aig );
+  const auto& info_back = aig_info( back );
+
+  BOOST_REQUIRE_EQUAL( info_back.inputs.size(), info.inputs.size() );
+  BOOST_REQUIRE_EQUAL( info_back.outputs.size(), info.outputs.size() );
+
+  for ( auto i = 0u; i < info.inputs.size(); ++i )
+  {
+    BOOST_CHECK_EQUAL( info_back.node_names.at( info_back.inputs[i] ), info.node_names.at( info.inputs[i] ) );
+  }
+  for ( auto o = 0u; o < info.outputs.size(); ++o )
+  {
+    BOOST_CHECK_EQUAL( info_back.outputs[o].second, info.outputs[o].second );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+  std::mt19937 gen( 23u );
+
+  for ( auto round = 0u; round < 10u; ++round )
+  {
+    const auto aig = random_aig( 12u, 50u + 40u * round, 6u, gen );
+
+    std::ostringstream os;
+    write_aiger_binary( aig, os );
+
+    const auto patterns = random_patterns( 12u, 500u, gen );
+    const auto expected = bit_parallel_simulate( aig, patterns );
+
+    for ( auto noopt : {false, true} )
+    {
+      const auto back = read_from_string( os.str(), noopt );
+      check_same_interface( aig, back );
+      BOOST_CHECK( bit_parallel_simulate( back, patterns ) == expected );
+
+      /* writing the read AIG again gives the same file */
+      std::ostringstream os2;
+      write_aiger_binary( back, os2 );
+      BOOST_CHECK( os2.str() == os.str() );
+    }
+
+    /* compact AIGs write the same functions */
+    std::ostringstream os_compact;
+    write_aiger_binary( aig_to_compact_aig( aig ), os_compact );
+    const auto back = read_from_string( os_compact.str() );
+    check_same_interface( aig, back );
+    BOOST_CHECK( bit_parallel_simulate( back, patterns ) == expected );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(delta_coding)
+{
+  /* AND gate with both fanins equal: the second delta is 0 */
+  const std::string same_fanins = std::string( "aig 3 2 0 1 1\n6\n" ) + encode( 2u ) + encode( 0u ) + "i0 a\ni1 b\no0 f\n";
+
+  const auto strashed = read_from_string( same_fanins );
+  BOOST_CHECK_EQUAL( aig_info( strashed ).outputs.front().first.node, aig_info( strashed ).inputs[1u] );
+  BOOST_CHECK_EQUAL( aig_info( strashed ).outputs.front().second, "f" );
+
+  const auto raw = read_from_string( same_fanins, true );
+  BOOST_CHECK_EQUAL( num_vertices( raw ), 4u );
+  BOOST_CHECK_EQUAL( num_edges( raw ), 2u );
+
+  /* wide AIG: gates far from their fanins need two- and three-byte deltas */
+  const auto num_inputs = 20000u;
+  aig_graph aig;
+  aig_initialize( aig );
+  std::vector<aig_function> xs;
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    xs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+  const auto f = aig_create_and( aig, xs[0u], !xs[1u] );              /* deltas 39997 and 3 */
+  const auto g = aig_create_and( aig, f, xs[num_inputs - 100u] );      /* deltas 2 and 200 */
+  const auto h = aig_create_and( aig, !g, xs[num_inputs - 20000u] );   /* deltas 1 and 40003 */
+  aig_create_po( aig, h, "h" );
+
+  std::ostringstream os;
+  write_aiger_binary( aig, os );
+  const auto header = "aig 20003 20000 0 1 3\n" + std::to_string( 2u * ( num_inputs + 3u ) ) + "\n";
+  const auto gates = encode( 39997u ) + encode( 3u ) + encode( 2u ) + encode( 200u ) + encode( 1u ) + encode( 40003u );
+  BOOST_CHECK( os.str().compare( 0u, header.size() + gates.size(), header + gates ) == 0 );
+  BOOST_CHECK_EQUAL( encode( 39997u ).size(), 3u );
+  BOOST_CHECK_EQUAL( encode( 200u ).size(), 2u );
+
+  for ( auto noopt : {false, true} )
+  {
+    const auto back = read_from_string( os.str(), noopt );
+    check_same_interface( aig, back );
+    BOOST_CHECK_EQUAL( num_vertices( back ), num_vertices( aig ) );
+
+    std::ostringstream os2;
+    write_aiger_binary( back, os2 );
+    BOOST_CHECK( os2.str() == os.str() );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_files)
+{
+  /* latches are not supported by the binary reader */
+  BOOST_CHECK_THROW( read_from_string( "aig 2 1 1 1 0\n4 2\n4\n" ), const char* );
+
+  /* truncated AND section */
+  BOOST_CHECK_THROW( read_from_string( "aig 4 2 0 1 2\n8\n" + encode( 2u ) + encode( 2u ) + encode( 2u ) ), const char* );
+
+  /* fanin is not smaller than the gate */
+  BOOST_CHECK_THROW( read_from_string( "aig 3 2 0 1 1\n6\n" + encode( 0u ) + encode( 2u ) ), const char* );
+  BOOST_CHECK_THROW( read_from_string( "aig 3 2 0 1 1\n6\n" + encode( 0u ) + encode( 2u ), true ), const char* );
+
+  /* output literal out of range */
+  BOOST_CHECK_THROW( read_from_string( "aig 3 2 0 1 1\n8\n" + encode( 2u ) + encode( 2u ) ), const char* );
+  BOOST_CHECK_THROW( read_from_string( "aig 3 2 0 1 1\n8\n" + encode( 2u ) + encode( 2u ), true ), const char* );
+
+  /* not a binary AIGER file */
+  BOOST_CHECK_THROW( read_from_string( "aag 0 0 0 0 0\n" ), const char* );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,339 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE bdd_package
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/approximate/error_metrics.hpp>
+#include <classical/dd/bdd.hpp>
+#include <classical/dd/count_solutions.hpp>
+#include <classical/dd/visit_solutions.hpp>
+
+using namespace cirkit;
+
+/* truth table of a BDD over at most 6 variables */
+std::uint64_t bdd_to_word( const bdd& f, unsigned n )
+{
+  std::uint64_t word = 0u;
+  for ( auto m = 0u; m < ( 1u << n ); ++m )
+  {
+    auto g = f;
+    while ( !g.is_bot() && !g.is_top() )
+    {
+      g = ( ( m >> g.var() ) & 1u ) ? g.high() : g.low();
+    }
+    if ( g.is_top() )
+    {
+      word |= UINT64_C( 1 ) << m;
+    }
+  }
+  return word;
+}
+
+std::uint64_t var_word( unsigned i, unsigned n )
+{
+  std::uint64_t word = 0u;
+  for ( auto m = 0u; m < ( 1u << n ); ++m )
+  {
+    if ( ( m >> i ) & 1u )
+    {
+      word |= UINT64_C( 1 ) << m;
+    }
+  }
+  return word;
+}
+
+/* random functions with their truth tables, built with ITE, AND, OR, XOR and NOT */
+void random_functions( bdd_manager& mgr, unsigned n, unsigned count, std::mt19937& gen,
+                       std::vector<bdd>& fs, std::vector<std::uint64_t>& ts )
+{
+  const auto all = n == 6u ? ~UINT64_C( 0 ) : ( UINT64_C( 1 ) << ( 1u << n ) ) - 1u;
+
+  for ( auto i = 0u; i < n; ++i )
+  {
+    fs.push_back( mgr[i] );
+    ts.push_back( var_word( i, n ) );
+  }
+
+  for ( auto k = 0u; k < count; ++k )
+  {
+    const auto a = gen() % fs.size(), b = gen() % fs.size(), c = gen() % fs.size();
+    switch ( gen() % 5u )
+    {
+    case 0u:
+      fs.push_back( fs[a] && fs[b] );
+      ts.push_back( ts[a] & ts[b] );
+      break;
+    case 1u:
+      fs.push_back( fs[a] || fs[b] );
+      ts.push_back( ts[a] | ts[b] );
+      break;
+    case 2u:
+      fs.push_back( fs[a] ^ fs[b] );
+      ts.push_back( ts[a] ^ ts[b] );
+      break;
+    case 3u:
+      fs.push_back( !fs[a] );
+      ts.push_back( ~ts[a] & all );
+      break;
+    default:
+      fs.push_back( bdd( &mgr, mgr.bdd_ite( fs[a].index, fs[b].index, fs[c].index ) ) );
+      ts.push_back( ( ts[a] & ts[b] ) | ( ~ts[a] & ts[c] ) );
+      break;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(complement_edges)
+{
+  const auto n = 6u;
+  std::mt19937 gen( 1u );
+
+  bdd_manager mgr( n, 10u );
+  std::vector<bdd> fs;
+  std::vector<std::uint64_t> ts;
+  random_functions( mgr, n, 500u, gen, fs, ts );
+
+  for ( auto j = 0u; j < fs.size(); ++j )
+  {
+    BOOST_CHECK_EQUAL( bdd_to_word( fs[j], n ), ts[j] );
+    BOOST_CHECK_EQUAL( count_solutions( fs[j] ), __builtin_popcountll( ts[j] ) );
+
+    /* negation only flips the complement bit */
+    BOOST_CHECK_EQUAL( ( !fs[j] ).index, fs[j].index ^ 1u );
+
+    /* canonicity */
+    for ( auto i = 0u; i < j; ++i )
+    {
+      BOOST_CHECK_EQUAL( ts[i] == ts[j], fs[i].index == fs[j].index );
+    }
+  }
+
+  BOOST_CHECK( ( mgr[0u] ^ mgr[0u] ).is_bot() );
+  BOOST_CHECK( ( mgr[0u] || !mgr[0u] ).is_top() );
+}
+
+BOOST_AUTO_TEST_CASE(garbage_collection)
+{
+  const auto n = 16u;
+
+  /* small initial tables such that they have to grow */
+  bdd_manager mgr( n, 4u );
+  const auto initial_capacity = mgr.capacity();
+
+  /* f is live during the whole loop, all intermediate results become garbage */
+  auto f = mgr.bdd_bot();
+  auto live = mgr[0u] && mgr[1u];
+  for ( auto rep = 0u; rep < 200u; ++rep )
+  {
+    auto g = mgr.bdd_top();
+    for ( auto i = 0u; i < n; i += 2u )
+    {
+      g = g && ( mgr[i] ^ mgr[( i + 1u + rep ) % n] );
+    }
+    f = f ^ g;
+  }
+  BOOST_CHECK( mgr.capacity() > initial_capacity );
+
+  const auto count = count_solutions( f );
+  const auto reclaimed = mgr.garbage_collect();
+  BOOST_CHECK( reclaimed > 0u );
+  BOOST_CHECK( count_solutions( f ) == count );
+  BOOST_CHECK( count_solutions( live ) == 1u << ( n - 2u ) );
+
+  /* same computation without garbage collection */
+  bdd_manager mgr2( n, 20u );
+  mgr2.set_gc_enabled( false );
+  auto f2 = mgr2.bdd_bot();
+  for ( auto rep = 0u; rep < 200u; ++rep )
+  {
+    auto g = mgr2.bdd_top();
+    for ( auto i = 0u; i < n; i += 2u )
+    {
+      g = g && ( mgr2[i] ^ mgr2[( i + 1u + rep ) % n] );
+    }
+    f2 = f2 ^ g;
+  }
+  BOOST_CHECK( count_solutions( f2 ) == count );
+  BOOST_CHECK( mgr.size() < mgr2.size() );
+
+  /* dropping the last reference makes f collectable */
+  const auto size = mgr.size();
+  f = mgr.bdd_bot();
+  mgr.garbage_collect();
+  BOOST_CHECK( mgr.size() < size );
+  BOOST_CHECK( count_solutions( live ) == 1u << ( n - 2u ) );
+}
+
+BOOST_AUTO_TEST_CASE(sifting)
+{
+  const auto n = 6u;
+
+  /* x0 x3 + x1 x4 + x2 x5 has a bad initial order */
+  {
+    bdd_manager mgr( n, 4u );
+    auto f = ( mgr[0u] && mgr[3u] ) || ( mgr[1u] && mgr[4u] ) || ( mgr[2u] && mgr[5u] );
+    const auto word = bdd_to_word( f, n );
+    mgr.garbage_collect();
+    const auto size = mgr.size();
+
+    mgr.reorder();
+    BOOST_CHECK( mgr.size() < size );
+    BOOST_CHECK_EQUAL( bdd_to_word( f, n ), word );
+  }
+
+  /* many functions at once */
+  std::mt19937 gen( 2u );
+  for ( auto round = 0u; round < 10u; ++round )
+  {
+    bdd_manager mgr( n, 4u );
+    std::vector<bdd> fs;
+    std::vector<std::uint64_t> ts;
+    random_functions( mgr, n, 100u, gen, fs, ts );
+
+    mgr.garbage_collect();
+    const auto size = mgr.size();
+    mgr.reorder();
+    BOOST_CHECK( mgr.size() <= size );
+
+    for ( auto j = 0u; j < fs.size(); ++j )
+    {
+      BOOST_CHECK_EQUAL( bdd_to_word( fs[j], n ), ts[j] );
+    }
+
+    /* operations after reordering */
+    for ( auto j = 1u; j < fs.size(); ++j )
+    {
+      BOOST_CHECK_EQUAL( bdd_to_word( fs[j - 1u] && fs[j], n ), ts[j - 1u] & ts[j] );
+    }
+  }
+
+  /* statistics are reported through the base class */
+  bdd_manager mgr( n, 4u );
+  mgr.reorder();
+  std::stringstream s;
+  static_cast<const dd_manager&>( mgr ).dump_stats( s );
+  BOOST_CHECK( s.str().find( "Reorderings" ) != std::string::npos );
+}
+
+/* functions whose BDDs are large in the initial order x0 < x1 < ... < x7 */
+std::vector<bdd> order_dependent_functions( bdd_manager& mgr, bool approximate )
+{
+  const auto g0 = ( mgr[0u] && mgr[4u] ) || ( mgr[1u] && mgr[5u] ) || ( mgr[2u] && mgr[6u] ) || ( mgr[3u] && mgr[7u] );
+  const auto g1 = mgr[0u] ^ mgr[5u] ^ ( mgr[2u] && mgr[7u] );
+  const auto g2 = ( mgr[1u] || mgr[6u] ) && !mgr[3u];
+  const auto g3 = ( mgr[4u] && g1 ) || ( !mgr[4u] && g2 );
+
+  if ( approximate )
+  {
+    return {g0 ^ ( mgr[0u] && mgr[1u] && mgr[2u] ), g1, g2 || mgr[7u], !g3 && mgr[5u]};
+  }
+  return {g0, g1, g2, g3};
+}
+
+std::set<unsigned long> solutions( const bdd& f )
+{
+  std::set<unsigned long> s;
+  visit_solutions( f, [&s]( const boost::dynamic_bitset<>& x ) { s.insert( x.to_ulong() ); } );
+  return s;
+}
+
+/* minterms of all paths, each minterm is covered by at most one path */
+std::multiset<unsigned long> path_minterms( const bdd& f )
+{
+  std::multiset<unsigned long> s;
+  visit_paths( f, [&s]( const std::vector<boost::tribool>& cube ) {
+      for ( auto m = 0ul; m < ( 1ul << cube.size() ); ++m )
+      {
+        auto covered = true;
+        for ( auto i = 0u; i < cube.size(); ++i )
+        {
+          if ( !indeterminate( cube[i] ) && static_cast<bool>( cube[i] ) != static_cast<bool>( ( m >> i ) & 1u ) )
+          {
+            covered = false;
+            break;
+          }
+        }
+        if ( covered ) { s.insert( m ); }
+      }
+    } );
+  return s;
+}
+
+BOOST_AUTO_TEST_CASE(walkers_after_sifting)
+{
+  const auto n = 8u;
+
+  bdd_manager mgr( n, 10u ), sifted( n, 10u );
+  const auto f = order_dependent_functions( mgr, false ), fhat = order_dependent_functions( mgr, true );
+  const auto sf = order_dependent_functions( sifted, false ), sfhat = order_dependent_functions( sifted, true );
+
+  sifted.garbage_collect();
+  sifted.reorder();
+
+  auto identity = true;
+  for ( auto v = 0u; v < n; ++v )
+  {
+    identity = identity && sifted.var_level( v ) == v;
+  }
+  BOOST_REQUIRE( !identity );
+
+  for ( auto i = 0u; i < f.size(); ++i )
+  {
+    for ( const auto& p : {std::make_pair( f[i], sf[i] ), std::make_pair( fhat[i], sfhat[i] )} )
+    {
+      const auto expected = solutions( p.first );
+      BOOST_CHECK( solutions( p.second ) == expected );
+      BOOST_CHECK( path_minterms( p.second ) == std::multiset<unsigned long>( expected.begin(), expected.end() ) );
+      BOOST_CHECK( path_minterms( p.first ) == std::multiset<unsigned long>( expected.begin(), expected.end() ) );
+      BOOST_CHECK_EQUAL( count_solutions( p.second ), expected.size() );
+    }
+  }
+
+  BOOST_CHECK_EQUAL( error_rate( sf, sfhat ), error_rate( f, fhat ) );
+  BOOST_CHECK_EQUAL( worst_case( sf, sfhat ), worst_case( f, fhat ) );
+  BOOST_CHECK( average_case( sf, sfhat ) == average_case( f, fhat ) );
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "maximum_method", worst_case_maximum_method::chi );
+  BOOST_CHECK_EQUAL( worst_case( sf, sfhat, settings ), worst_case( f, fhat, settings ) );
+  BOOST_CHECK_EQUAL( worst_case( f, fhat, settings ), worst_case( f, fhat ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
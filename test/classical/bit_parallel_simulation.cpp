@@ -0,0 +1,164 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE bit_parallel_simulation
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/functions/bit_parallel_simulation.hpp>
+#include <classical/functions/simulate_aig.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+using namespace cirkit;
+
+aig_graph random_aig( unsigned num_inputs, unsigned num_gates, unsigned num_outputs, std::mt19937& gen )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> fs;
+  fs.push_back( aig_get_constant( aig, false ) );
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+
+  for ( auto k = 0u; k < num_gates; ++k )
+  {
+    auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+    if ( gen() & 1u ) { a = !a; }
+    if ( gen() & 1u ) { b = !b; }
+    fs.push_back( aig_create_and( aig, a, b ) );
+  }
+
+  for ( auto o = 0u; o < num_outputs; ++o )
+  {
+    auto f = fs[fs.size() - 1u - gen() % ( fs.size() / 2u )];
+    aig_create_po( aig, ( gen() & 1u ) ? !f : f, "y" + std::to_string( o ) );
+  }
+
+  return aig;
+}
+
+BOOST_AUTO_TEST_CASE(compare_with_simulate_aig)
+{
+  const auto n = 8u;
+  std::mt19937 gen( 5u );
+
+  for ( auto round = 0u; round < 10u; ++round )
+  {
+    const auto aig = random_aig( n, 50u + 20u * round, 5u, gen );
+    const auto values = simulate_aig( aig, tt_simulator() );
+
+    /* four words hold all 2^8 patterns */
+    bit_parallel_simulator sim( aig, 4u );
+    BOOST_CHECK_EQUAL( sim.num_inputs(), n );
+    BOOST_CHECK_EQUAL( sim.num_outputs(), 5u );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      for ( auto w = 0u; w < 4u; ++w )
+      {
+        auto word = UINT64_C( 0 );
+        for ( auto b = 0u; b < 64u; ++b )
+        {
+          word |= static_cast<std::uint64_t>( ( ( ( w << 6u ) | b ) >> i ) & 1u ) << b;
+        }
+        sim.input( i )[w] = word;
+      }
+    }
+    sim.simulate();
+
+    const auto& outputs = aig_info( aig ).outputs;
+    for ( auto o = 0u; o < outputs.size(); ++o )
+    {
+      auto func = values.at( outputs[o].first );
+      tt_extend( func, n );
+      for ( auto p = 0u; p < ( 1u << n ); ++p )
+      {
+        BOOST_CHECK_EQUAL( sim.output_bit( o, p ), static_cast<bool>( func[p] ) );
+      }
+      BOOST_CHECK_EQUAL( sim.count_ones( o, 1u << n ), func.count() );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(patterns_from_stream)
+{
+  std::mt19937 gen( 7u );
+  const auto aig = random_aig( 4u, 30u, 2u, gen );
+  const auto values = simulate_aig( aig, tt_simulator() );
+  const auto& outputs = aig_info( aig ).outputs;
+
+  /* every pattern three times, a single word per block */
+  std::stringstream s;
+  s << "# comment" << std::endl << std::endl;
+  std::vector<unsigned long> expected( outputs.size(), 0ul );
+  for ( auto r = 0u; r < 3u; ++r )
+  {
+    for ( auto p = 0u; p < 16u; ++p )
+    {
+      for ( auto i = 0u; i < 4u; ++i )
+      {
+        s << ( ( p >> i ) & 1u );
+      }
+      s << std::endl;
+      for ( auto o = 0u; o < outputs.size(); ++o )
+      {
+        expected[o] += values.at( outputs[o].first )[p];
+      }
+    }
+  }
+
+  bit_parallel_simulator sim( aig, 1u );
+  std::vector<unsigned long> ones( outputs.size(), 0ul );
+  auto num_patterns = 0ul;
+  BOOST_CHECK( sim.simulate_stream( s, [&]( unsigned long offset, unsigned num ) {
+        for ( auto o = 0u; o < outputs.size(); ++o ) { ones[o] += sim.count_ones( o, num ); }
+      }, num_patterns ) );
+  BOOST_CHECK_EQUAL( num_patterns, 48ul );
+  BOOST_CHECK( ones == expected );
+
+  /* invalid patterns */
+  for ( const auto& invalid : {"0101\n01\n", "0101\n01x1\n"} )
+  {
+    std::stringstream is( invalid );
+    BOOST_CHECK( !sim.simulate_stream( is, []( unsigned long, unsigned ) {}, num_patterns ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,211 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE compact_aig
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/compact_aig.hpp>
+#include <classical/functions/bit_parallel_simulation.hpp>
+#include <classical/functions/cuts/compact.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+aig_graph random_aig( unsigned num_inputs, unsigned num_gates, unsigned num_outputs, std::mt19937& gen )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> fs;
+  fs.push_back( aig_get_constant( aig, false ) );
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+
+  for ( auto k = 0u; k < num_gates; ++k )
+  {
+    auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+    if ( gen() & 1u ) { a = !a; }
+    if ( gen() & 1u ) { b = !b; }
+    fs.push_back( aig_create_and( aig, a, b ) );
+  }
+
+  for ( auto o = 0u; o < num_outputs; ++o )
+  {
+    auto f = fs[fs.size() - 1u - gen() % ( fs.size() / 2u )];
+    aig_create_po( aig, ( gen() & 1u ) ? !f : f, "y" + std::to_string( o ) );
+  }
+
+  return aig;
+}
+
+std::vector<boost::dynamic_bitset<>> random_patterns( unsigned n, unsigned num, std::mt19937& gen )
+{
+  std::vector<boost::dynamic_bitset<>> patterns( n, boost::dynamic_bitset<>( num ) );
+  for ( auto& p : patterns )
+  {
+    for ( auto j = 0u; j < num; ++j )
+    {
+      p[j] = gen() & 1u;
+    }
+  }
+  return patterns;
+}
+
+/* every path from n to an input passes through a leaf */
+bool is_cut( const compact_aig& aig, compact_aig::node n, const std::vector<std::uint32_t>& leaves )
+{
+  if ( std::find( leaves.begin(), leaves.end(), n ) != leaves.end() ) { return true; }
+  if ( aig.is_constant( n ) ) { return true; }
+  if ( aig.is_pi( n ) ) { return false; }
+  return is_cut( aig, compact_aig::get_node( aig.fanin0( n ) ), leaves ) &&
+         is_cut( aig, compact_aig::get_node( aig.fanin1( n ) ), leaves );
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+  std::mt19937 gen( 11u );
+
+  for ( auto round = 0u; round < 10u; ++round )
+  {
+    const auto aig = random_aig( 10u, 100u + 30u * round, 8u, gen );
+    const auto caig = aig_to_compact_aig( aig );
+
+    BOOST_CHECK_EQUAL( caig.num_inputs(), aig_info( aig ).inputs.size() );
+    BOOST_CHECK_EQUAL( caig.num_outputs(), aig_info( aig ).outputs.size() );
+    for ( auto o = 0u; o < caig.num_outputs(); ++o )
+    {
+      BOOST_CHECK_EQUAL( caig.output_name( o ), aig_info( aig ).outputs[o].second );
+    }
+
+    const auto back = compact_aig_to_aig( caig );
+    BOOST_CHECK_EQUAL( aig_info( back ).inputs.size(), aig_info( aig ).inputs.size() );
+    BOOST_CHECK_EQUAL( aig_info( back ).outputs.size(), aig_info( aig ).outputs.size() );
+
+    const auto patterns = random_patterns( 10u, 1000u, gen );
+    const auto expected = bit_parallel_simulate( aig, patterns );
+    BOOST_CHECK( bit_parallel_simulate( back, patterns ) == expected );
+
+    /* simulate the compact AIG directly */
+    bit_parallel_simulator sim( caig, 1u );
+    for ( auto i = 0u; i < caig.num_inputs(); ++i )
+    {
+      auto word = UINT64_C( 0 );
+      for ( auto j = 0u; j < 64u; ++j )
+      {
+        word |= static_cast<std::uint64_t>( patterns[i][j] ) << j;
+      }
+      sim.input( i )[0u] = word;
+    }
+    sim.simulate();
+    for ( auto o = 0u; o < caig.num_outputs(); ++o )
+    {
+      for ( auto j = 0u; j < 64u; ++j )
+      {
+        BOOST_CHECK_EQUAL( sim.output_bit( o, j ), static_cast<bool>( expected[o][j] ) );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(strashing)
+{
+  compact_aig aig;
+  const auto a = aig.create_pi( "a" ), b = aig.create_pi( "b" );
+
+  BOOST_CHECK_EQUAL( aig.create_and( a, b ), aig.create_and( b, a ) );
+  BOOST_CHECK_EQUAL( aig.create_and( a, a ), a );
+  BOOST_CHECK_EQUAL( aig.create_and( a, a ^ 1u ), aig.get_constant( false ) );
+  BOOST_CHECK_EQUAL( aig.create_and( a, aig.get_constant( true ) ), a );
+  BOOST_CHECK_EQUAL( aig.num_gates(), 1u );
+
+  /* existing gates are found after the table has grown several times */
+  std::vector<compact_aig::literal> fs = {a, b}, gates;
+  for ( auto i = 0u; i < 5000u; ++i )
+  {
+    gates.push_back( aig.create_and( fs[i], fs[i + 1u] ^ ( i & 1u ) ) );
+    fs.push_back( gates.back() );
+  }
+  const auto num_gates = aig.num_gates();
+  for ( auto i = 0u; i < 5000u; ++i )
+  {
+    BOOST_CHECK_EQUAL( aig.create_and( fs[i + 1u] ^ ( i & 1u ), fs[i] ), gates[i] );
+  }
+  BOOST_CHECK_EQUAL( aig.num_gates(), num_gates );
+}
+
+BOOST_AUTO_TEST_CASE(cuts)
+{
+  std::mt19937 gen( 13u );
+  const auto caig = aig_to_compact_aig( random_aig( 8u, 200u, 4u, gen ) );
+
+  for ( auto k : {2u, 4u, 6u} )
+  {
+    compact_aig_cuts cuts( caig, k, 8u );
+
+    /* the constant only has the empty cut */
+    BOOST_CHECK_EQUAL( cuts.count( 0u ), 1u );
+    BOOST_CHECK( cuts.cut( 0u, 0u ).empty() );
+
+    auto total = cuts.count( 0u );
+    for ( auto n = 1u; n < caig.size(); ++n )
+    {
+      BOOST_CHECK( cuts.count( n ) >= 1u );
+      BOOST_CHECK( cuts.count( n ) <= 9u );
+      total += cuts.count( n );
+
+      for ( auto j = 0u; j < cuts.count( n ); ++j )
+      {
+        const auto range = cuts.cut( n, j );
+        std::vector<std::uint32_t> leaves( range.begin(), range.end() );
+        BOOST_CHECK( !leaves.empty() && leaves.size() <= k );
+        BOOST_CHECK( std::is_sorted( leaves.begin(), leaves.end() ) );
+        BOOST_CHECK( is_cut( caig, n, leaves ) );
+      }
+
+      /* the last cut is the trivial one */
+      const auto trivial = cuts.cut( n, cuts.count( n ) - 1u );
+      BOOST_CHECK( trivial.size() == 1u && trivial.front() == n );
+    }
+    BOOST_CHECK_EQUAL( cuts.total_cut_count(), total );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,163 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE exorcismq
+
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/optimization/exorcismq.hpp>
+
+using namespace cirkit;
+
+std::string temp_filename( const std::string& model )
+{
+  return ( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( model ) ).string();
+}
+
+/* random single-output ESOP, each literal is positive or negative with
+   probability 0.3 */
+std::vector<std::string> random_esop( unsigned num_vars, unsigned num_cubes, unsigned seed )
+{
+  std::mt19937 gen( seed );
+  std::vector<std::string> cubes;
+
+  for ( auto k = 0u; k < num_cubes; ++k )
+  {
+    std::string cube( num_vars, '-' );
+    for ( auto& c : cube )
+    {
+      const auto r = gen() % 10u;
+      c = r < 3u ? '0' : ( r < 6u ? '1' : '-' );
+    }
+    cubes.push_back( cube );
+  }
+
+  return cubes;
+}
+
+void write_esop( const std::string& filename, unsigned num_vars, const std::vector<std::string>& cubes )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out );
+  os << ".i " << num_vars << std::endl << ".o 1" << std::endl << ".type esop" << std::endl;
+  for ( const auto& c : cubes )
+  {
+    os << c << " 1" << std::endl;
+  }
+  os << ".e" << std::endl;
+}
+
+std::vector<std::string> read_esop( const std::string& filename )
+{
+  std::ifstream is( filename.c_str(), std::ifstream::in );
+  std::vector<std::string> cubes;
+  std::string line;
+
+  while ( std::getline( is, line ) )
+  {
+    if ( line.empty() || line[0] == '.' ) { continue; }
+    cubes.push_back( line.substr( 0u, line.find( ' ' ) ) );
+  }
+
+  return cubes;
+}
+
+std::vector<bool> truth_table( unsigned num_vars, const std::vector<std::string>& cubes )
+{
+  std::vector<bool> table( 1u << num_vars, false );
+
+  for ( const auto& c : cubes )
+  {
+    for ( auto x = 0u; x < table.size(); ++x )
+    {
+      auto value = true;
+      for ( auto i = 0u; i < num_vars && value; ++i )
+      {
+        value = c[i] == '-' || ( c[i] == '1' ) == ( ( x >> i ) & 1u );
+      }
+      if ( value )
+      {
+        table[x] = !table[x];
+      }
+    }
+  }
+
+  return table;
+}
+
+unsigned literal_count( const std::vector<std::string>& cubes )
+{
+  auto count = 0u;
+  for ( const auto& c : cubes )
+  {
+    for ( auto ch : c )
+    {
+      count += ch != '-';
+    }
+  }
+  return count;
+}
+
+BOOST_AUTO_TEST_CASE(random_covers)
+{
+  /* number of variables, number of cubes, and cube and literal counts of the
+     result before exorcismq was moved to packed_cover */
+  const std::vector<std::vector<unsigned>> instances = {{8u, 100u, 51u, 222u}, {10u, 200u, 172u, 970u}};
+
+  for ( const auto& inst : instances )
+  {
+    const auto num_vars = inst[0u];
+    const auto input = random_esop( num_vars, inst[1u], 7u );
+
+    const auto inname = temp_filename( "exorcismq_%%%%%%%%.esop" );
+    const auto outname = temp_filename( "exorcismq_%%%%%%%%.esop" );
+    write_esop( inname, num_vars, input );
+
+    auto settings = std::make_shared<properties>();
+    settings->set( "verbose", false );
+    settings->set( "esopname", outname );
+    exorcismq_minimization_from_esop( inname, settings );
+
+    const auto output = read_esop( outname );
+    BOOST_CHECK( truth_table( num_vars, output ) == truth_table( num_vars, input ) );
+    BOOST_CHECK_LE( output.size(), inst[2u] );
+    BOOST_CHECK_LE( literal_count( output ), inst[3u] );
+
+    boost::filesystem::remove( inname );
+    boost::filesystem::remove( outname );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,126 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE fraig
+
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/functions/bit_parallel_simulation.hpp>
+#include <classical/functions/fraig.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+std::vector<boost::dynamic_bitset<>> exhaustive_patterns( unsigned n )
+{
+  std::vector<boost::dynamic_bitset<>> patterns( n, boost::dynamic_bitset<>( 1u << n ) );
+  for ( auto p = 0u; p < ( 1u << n ); ++p )
+  {
+    for ( auto i = 0u; i < n; ++i )
+    {
+      patterns[i][p] = ( p >> i ) & 1;
+    }
+  }
+  return patterns;
+}
+
+BOOST_AUTO_TEST_CASE(merge_adders)
+{
+  const auto w = 4u;
+
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> a, b;
+  for ( auto i = 0u; i < w; ++i ) { a.push_back( aig_create_pi( aig, "a" + std::to_string( i ) ) ); }
+  for ( auto i = 0u; i < w; ++i ) { b.push_back( aig_create_pi( aig, "b" + std::to_string( i ) ) ); }
+
+  /* two structurally different ripple carry adders */
+  auto c1 = aig_get_constant( aig, false ), c2 = c1;
+  for ( auto i = 0u; i < w; ++i )
+  {
+    const auto s1 = aig_create_xor( aig, aig_create_xor( aig, a[i], b[i] ), c1 );
+    c1 = aig_create_maj( aig, a[i], b[i], c1 );
+
+    const auto x = !aig_create_and( aig, !aig_create_and( aig, a[i], !b[i] ), !aig_create_and( aig, !a[i], b[i] ) );
+    const auto s2 = aig_create_or( aig, aig_create_and( aig, x, !c2 ), aig_create_and( aig, !x, c2 ) );
+    c2 = aig_create_or( aig, aig_create_and( aig, a[i], b[i] ), aig_create_and( aig, c2, aig_create_or( aig, a[i], b[i] ) ) );
+
+    aig_create_po( aig, s1, "s1_" + std::to_string( i ) );
+    aig_create_po( aig, s2, "s2_" + std::to_string( i ) );
+  }
+
+  for ( auto threads : {1u, 2u} )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "num_threads", threads );
+    settings->set( "sim_words", 1u );
+
+    const auto result = fraig( aig, settings );
+    const auto& info = aig_info( result );
+
+    for ( auto i = 0u; i < w; ++i )
+    {
+      BOOST_CHECK( info.outputs[2u * i].first == info.outputs[2u * i + 1u].first );
+    }
+    BOOST_CHECK( aig_to_compact_aig( result ).num_gates() < aig_to_compact_aig( aig ).num_gates() );
+    BOOST_CHECK( bit_parallel_simulate( aig, exhaustive_patterns( 2u * w ) ) == bit_parallel_simulate( result, exhaustive_patterns( 2u * w ) ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(equivalence_check)
+{
+  aig_graph spec, impl;
+  aig_initialize( spec );
+  aig_initialize( impl );
+
+  const auto x1 = aig_create_pi( spec, "x1" ), y1 = aig_create_pi( spec, "y1" );
+  aig_create_po( spec, aig_create_xor( spec, x1, y1 ), "f" );
+
+  const auto x2 = aig_create_pi( impl, "x1" ), y2 = aig_create_pi( impl, "y1" );
+  aig_create_po( impl, aig_create_or( impl, aig_create_and( impl, x2, !y2 ), aig_create_and( impl, !x2, y2 ) ), "f" );
+
+  BOOST_CHECK( fraig_equivalence_check( impl, spec ) );
+
+  aig_graph wrong;
+  aig_initialize( wrong );
+  const auto x3 = aig_create_pi( wrong, "x1" ), y3 = aig_create_pi( wrong, "y1" );
+  aig_create_po( wrong, aig_create_or( wrong, x3, y3 ), "f" );
+
+  BOOST_CHECK( !fraig_equivalence_check( wrong, spec ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
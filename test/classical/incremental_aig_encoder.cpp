@@ -0,0 +1,180 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE incremental_aig_encoder
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/sat/minisat.hpp>
+#include <classical/sat/sat_solver.hpp>
+#include <classical/sat/utils/incremental_aig_encoder.hpp>
+
+using namespace cirkit;
+
+bool is_sat( minisat_solver& solver, const std::vector<int>& assumptions )
+{
+  solver_execution_statistics stats;
+  return solve( solver, stats, assumptions ) != boost::none;
+}
+
+/* satisfiability of the conjunction of the outputs (negative index for complemented outputs) */
+bool fresh_sat( const aig_graph& aig, const std::vector<int>& outputs )
+{
+  auto solver = make_solver<minisat_solver>();
+  auto sid = 1;
+  incremental_aig_encoder<minisat_solver> encoder( solver, aig, sid );
+
+  std::vector<int> assumptions;
+  for ( auto o : outputs )
+  {
+    const auto lit = encoder.output_literal( std::abs( o ) - 1 );
+    assumptions.push_back( o < 0 ? -lit : lit );
+  }
+  return is_sat( solver, assumptions );
+}
+
+BOOST_AUTO_TEST_CASE( overlapping_cones )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  const auto c = aig_create_pi( aig, "c" );
+  const auto d = aig_create_pi( aig, "d" );
+
+  const auto g = aig_create_and( aig, a, b );               /* shared by both cones */
+  aig_create_po( aig, aig_create_and( aig, g, c ), "f1" );  /* a b c */
+  aig_create_po( aig, aig_create_and( aig, !g, d ), "f2" ); /* !(a b) d */
+
+  auto solver = make_solver<minisat_solver>();
+  solver_gen_model( solver, false );
+  auto sid = 1;
+  incremental_aig_encoder<minisat_solver> encoder( solver, aig, sid );
+
+  BOOST_CHECK_EQUAL( encoder.num_encoded(), 4u );
+
+  /* permanent cone of f1 */
+  const auto f1 = encoder.output_literal( 0u );
+  BOOST_CHECK_EQUAL( encoder.num_encoded(), 6u );
+  BOOST_CHECK_EQUAL( encoder.output_literal( 0u ), f1 );
+  BOOST_CHECK_EQUAL( encoder.num_encoded(), 6u );
+
+  /* cone of f2 in a group, reuses the permanent node g */
+  const auto group = encoder.begin_group();
+  const auto f2 = encoder.output_literal( 1u );
+  encoder.end_group();
+  BOOST_CHECK_EQUAL( encoder.num_encoded(), 7u );
+
+  BOOST_CHECK_EQUAL( is_sat( solver, {group, f1} ), fresh_sat( aig, {1} ) );
+  BOOST_CHECK_EQUAL( is_sat( solver, {group, f2} ), fresh_sat( aig, {2} ) );
+  BOOST_CHECK_EQUAL( is_sat( solver, {group, f1, f2} ), fresh_sat( aig, {1, 2} ) );
+  BOOST_CHECK_EQUAL( is_sat( solver, {group, -f1, -f2} ), fresh_sat( aig, {-1, -2} ) );
+  BOOST_CHECK( !is_sat( solver, {group, f1, f2} ) );
+
+  /* after retracting, the old literal of f2 is unconstrained and f1 is still encoded */
+  encoder.retract( group );
+  BOOST_CHECK_EQUAL( encoder.num_encoded(), 6u );
+  BOOST_CHECK( is_sat( solver, {f1, f2} ) );
+  BOOST_CHECK( !is_sat( solver, {f1, -encoder.input_literal( 2u )} ) );
+
+  /* encoding f2 again creates a new literal */
+  const auto group2 = encoder.begin_group();
+  const auto f2_new = encoder.output_literal( 1u );
+  encoder.end_group();
+  BOOST_CHECK( f2_new != f2 );
+  BOOST_CHECK_EQUAL( encoder.num_encoded(), 7u );
+
+  BOOST_CHECK_EQUAL( is_sat( solver, {group2, f1, f2_new} ), fresh_sat( aig, {1, 2} ) );
+  BOOST_CHECK_EQUAL( is_sat( solver, {group2, -f1, f2_new} ), fresh_sat( aig, {-1, 2} ) );
+  BOOST_CHECK_EQUAL( is_sat( solver, {group2, f1, -f2_new} ), fresh_sat( aig, {1, -2} ) );
+}
+
+BOOST_AUTO_TEST_CASE( random_groups )
+{
+  std::mt19937 gen( 42 );
+
+  for ( auto round = 0u; round < 10u; ++round )
+  {
+    aig_graph aig;
+    aig_initialize( aig );
+
+    std::vector<aig_function> fs;
+    for ( auto i = 0u; i < 6u; ++i )
+    {
+      fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+    }
+    for ( auto k = 0u; k < 30u; ++k )
+    {
+      auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+      if ( gen() & 1u ) { a = !a; }
+      if ( gen() & 1u ) { b = !b; }
+      fs.push_back( aig_create_and( aig, a, b ) );
+    }
+    const auto m = 6u;
+    for ( auto o = 0u; o < m; ++o )
+    {
+      aig_create_po( aig, fs[fs.size() - 1u - gen() % 15u], "y" + std::to_string( o ) );
+    }
+
+    auto solver = make_solver<minisat_solver>();
+    solver_gen_model( solver, false );
+    auto sid = 1;
+    incremental_aig_encoder<minisat_solver> encoder( solver, aig, sid );
+
+    /* first output is permanent, all other ones are encoded in a group and retracted */
+    const auto f = encoder.output_literal( 0u );
+    const auto permanent = encoder.num_encoded();
+
+    for ( auto j = 1u; j < m; ++j )
+    {
+      const auto group = encoder.begin_group();
+      const auto g = encoder.output_literal( j );
+      encoder.end_group();
+
+      for ( auto p = 0u; p < 4u; ++p )
+      {
+        const int s1 = ( p & 1u ) ? -1 : 1, s2 = ( p & 2u ) ? -1 : 1;
+        BOOST_CHECK_EQUAL( is_sat( solver, {group, s1 * f, s2 * g} ), fresh_sat( aig, {s1 * 1, s2 * static_cast<int>( j + 1u )} ) );
+      }
+
+      encoder.retract( group );
+      BOOST_CHECK_EQUAL( encoder.num_encoded(), permanent );
+    }
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,302 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE npn_cache
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/utils/npn_cache.hpp>
+#include <classical/utils/npn_manager.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+using namespace cirkit;
+
+/* the cache does not interpret entries, so any consistent entry can be stored */
+struct entry_t
+{
+  tt                      func;
+  tt                      npn;
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned>   perm;
+};
+
+entry_t make_entry( unsigned num_vars, std::uint64_t f )
+{
+  const auto bits = 1u << num_vars;
+  entry_t e{tt( bits, f ), tt( bits, ~f ), boost::dynamic_bitset<>( num_vars + 1u, f ), std::vector<unsigned>( num_vars )};
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    e.perm[i] = ( i + f ) % num_vars;
+  }
+  return e;
+}
+
+bool has_entry( const npn_cache& cache, const entry_t& e )
+{
+  tt npn;
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  return cache.lookup( e.func, npn, phase, perm ) && npn == e.npn && phase == e.phase && perm == e.perm;
+}
+
+std::string temp_filename()
+{
+  return ( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path( "npn_cache_%%%%%%%%.cache" ) ).string();
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_insert_and_lookup)
+{
+  npn_cache cache( 16u );
+
+  std::vector<entry_t> entries;
+  for ( auto f = 0u; f < 20000u; ++f )
+  {
+    entries.push_back( make_entry( 5u, f * 2654435761u ) );
+  }
+  for ( auto f = 0u; f < 256u; ++f )
+  {
+    /* same truth table bits as some 5-input entries, but a different number of variables */
+    entries.push_back( make_entry( 3u, f ) );
+  }
+
+  /* all threads insert all entries, in different orders, and look them up again */
+  const auto num_threads = 4u;
+  std::atomic<unsigned> failures( 0u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+        for ( auto k = 0u; k < entries.size(); ++k )
+        {
+          const auto& e = entries[( k * ( 2u * t + 1u ) + t * 997u ) % entries.size()];
+          if ( !cache.insert( e.func, e.npn, e.phase, e.perm ) || !has_entry( cache, e ) )
+          {
+            ++failures;
+          }
+        }
+      } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL( failures.load(), 0u );
+  BOOST_CHECK_EQUAL( cache.size(), entries.size() );
+  for ( const auto& e : entries )
+  {
+    BOOST_CHECK( has_entry( cache, e ) );
+  }
+
+  /* functions with more than 6 inputs are not cached */
+  const auto wide = make_entry( 7u, 42u );
+  BOOST_CHECK( !cache.insert( wide.func, wide.npn, wide.phase, wide.perm ) );
+  BOOST_CHECK( !has_entry( cache, wide ) );
+}
+
+BOOST_AUTO_TEST_CASE(full_table)
+{
+  npn_cache cache( 4u );
+  BOOST_CHECK_EQUAL( cache.capacity(), 16u );
+
+  /* accepts entries until it is 3/4 full */
+  std::vector<entry_t> entries;
+  for ( auto f = 0u; f < 20u; ++f )
+  {
+    entries.push_back( make_entry( 4u, f ) );
+  }
+
+  for ( auto f = 0u; f < 12u; ++f )
+  {
+    BOOST_CHECK( cache.insert( entries[f].func, entries[f].npn, entries[f].phase, entries[f].perm ) );
+  }
+  for ( auto f = 12u; f < 20u; ++f )
+  {
+    BOOST_CHECK( !cache.insert( entries[f].func, entries[f].npn, entries[f].phase, entries[f].perm ) );
+  }
+
+  BOOST_CHECK_EQUAL( cache.size(), 12u );
+  for ( auto f = 0u; f < 20u; ++f )
+  {
+    BOOST_CHECK_EQUAL( has_entry( cache, entries[f] ), f < 12u );
+  }
+
+  /* misses are still computed */
+  auto calls = 0u;
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  const auto& e = entries[15u];
+  const auto npn = cache.compute( e.func, phase, perm, [&]( const tt&, boost::dynamic_bitset<>& p, std::vector<unsigned>& q ) {
+      ++calls;
+      p = e.phase;
+      q = e.perm;
+      return e.npn;
+    } );
+  BOOST_CHECK_EQUAL( calls, 1u );
+  BOOST_CHECK( npn == e.npn && phase == e.phase && perm == e.perm );
+
+  BOOST_CHECK_EQUAL( npn_cache::log_capacity_for( 12u ), 4u );
+  BOOST_CHECK_EQUAL( npn_cache::log_capacity_for( 13u ), 5u );
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_round_trip)
+{
+  const auto filename = temp_filename();
+
+  std::vector<entry_t> entries;
+  for ( auto f = 0u; f < 500u; ++f )
+  {
+    entries.push_back( make_entry( 5u + f % 2u, f * 40503u ) );
+  }
+
+  {
+    npn_cache cache( 10u, filename );
+    BOOST_CHECK_EQUAL( cache.size(), 0u );
+    BOOST_CHECK( !cache.persist() ); /* nothing to write */
+
+    for ( auto f = 0u; f < 300u; ++f )
+    {
+      BOOST_CHECK( cache.insert( entries[f].func, entries[f].npn, entries[f].phase, entries[f].perm ) );
+    }
+    BOOST_CHECK( cache.persist() );
+  }
+
+  {
+    /* entries from the snapshot and new entries are written together */
+    npn_cache cache( 10u, filename );
+    BOOST_CHECK_EQUAL( cache.size(), 300u );
+    for ( auto f = 0u; f < 500u; ++f )
+    {
+      BOOST_CHECK_EQUAL( has_entry( cache, entries[f] ), f < 300u );
+    }
+
+    for ( auto f = 200u; f < 500u; ++f )
+    {
+      BOOST_CHECK( cache.insert( entries[f].func, entries[f].npn, entries[f].phase, entries[f].perm ) );
+    }
+    BOOST_CHECK( cache.persist() );
+  }
+
+  npn_cache cache( 4u, filename );
+  BOOST_CHECK_EQUAL( cache.size(), 500u );
+  for ( const auto& e : entries )
+  {
+    BOOST_CHECK( has_entry( cache, e ) );
+  }
+
+  boost::filesystem::remove( filename );
+}
+
+BOOST_AUTO_TEST_CASE(invalid_snapshot)
+{
+  const auto filename = temp_filename();
+
+  npn_cache cache( 6u );
+  for ( auto f = 0u; f < 40u; ++f )
+  {
+    const auto e = make_entry( 4u, f );
+    cache.insert( e.func, e.npn, e.phase, e.perm );
+  }
+  cache.save( filename );
+
+  std::string contents;
+  {
+    std::ifstream in( filename.c_str(), std::ifstream::binary );
+    contents.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+  }
+  BOOST_CHECK_EQUAL( npn_cache( 6u, filename ).size(), 40u );
+
+  const auto write_and_load = [&filename]( const std::string& data ) {
+    std::ofstream os( filename.c_str(), std::ofstream::binary );
+    os.write( data.data(), data.size() );
+    os.close();
+    return npn_cache( 6u, filename ).size();
+  };
+
+  /* truncated */
+  BOOST_CHECK_EQUAL( write_and_load( contents.substr( 0u, contents.size() - 5u ) ), 0u );
+  BOOST_CHECK_EQUAL( write_and_load( contents.substr( 0u, 10u ) ), 0u );
+
+  /* wrong magic */
+  auto bad_magic = contents;
+  bad_magic[0u] = 'X';
+  BOOST_CHECK_EQUAL( write_and_load( bad_magic ), 0u );
+
+  /* record count that overflows the file size computation */
+  auto bad_count = contents;
+  const auto huge = UINT64_C( 0x1000000000000001 );
+  bad_count.replace( 8u, sizeof( huge ), reinterpret_cast<const char*>( &huge ), sizeof( huge ) );
+  BOOST_CHECK_EQUAL( write_and_load( bad_count ), 0u );
+
+  /* a rejected snapshot does not prevent caching */
+  npn_cache rejected( 6u, filename );
+  const auto e = make_entry( 3u, 7u );
+  BOOST_CHECK( rejected.insert( e.func, e.npn, e.phase, e.perm ) );
+  BOOST_CHECK( has_entry( rejected, e ) );
+
+  boost::filesystem::remove( filename );
+}
+
+BOOST_AUTO_TEST_CASE(npn_manager_wide_functions)
+{
+  auto calls = 0u;
+  npn_manager mgr( 16u, [&calls]( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm ) {
+      ++calls;
+      phase.resize( tt_num_vars( t ) + 1u );
+      perm.resize( tt_num_vars( t ) );
+      return t;
+    } );
+
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  for ( auto num_vars : {4u, 7u, 8u} )
+  {
+    auto a = tt_nth_var( 0u );
+    auto b = tt_nth_var( num_vars - 1u );
+    tt_align( a, b );
+    const auto f = a ^ b;
+
+    const auto before = calls;
+    mgr.compute( f, phase, perm );
+    mgr.compute( f, phase, perm );
+    BOOST_CHECK_EQUAL( calls, before + 1u );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
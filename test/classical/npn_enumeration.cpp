@@ -0,0 +1,83 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE npn_enumeration
+
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/functions/npn_canonization.hpp>
+#include <classical/functions/npn_enumeration.hpp>
+#include <classical/utils/static_truth_table.hpp>
+
+using namespace cirkit;
+
+template<unsigned NumVars>
+void check_enumeration( unsigned num_classes )
+{
+  std::map<uint64_t, uint64_t> expected, classes, samples;
+
+  for ( auto f = UINT64_C( 0 ); f < ( UINT64_C( 1 ) << ( 1u << NumVars ) ); ++f )
+  {
+    static_tt<NumVars> t;
+    t.words()[0u] = f;
+
+    boost::dynamic_bitset<> phase;
+    std::vector<unsigned>   perm;
+    expected[exact_npn_canonization( t, phase, perm ).words()[0u]]++;
+  }
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "num_threads", 3u );
+
+  BOOST_CHECK_EQUAL( enumerate_npn_classes( NumVars, [&]( uint64_t repr, uint64_t count ) { classes[repr] += count; }, settings ), num_classes );
+  BOOST_CHECK( classes == expected );
+
+  sample_npn_classes( NumVars, 1000u, [&]( uint64_t repr, uint64_t count ) { samples[repr] += count; }, settings );
+  auto total = 0u;
+  for ( const auto& p : samples )
+  {
+    BOOST_CHECK( expected.find( p.first ) != expected.end() );
+    total += p.second;
+  }
+  BOOST_CHECK_EQUAL( total, 1000u );
+}
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  check_enumeration<2u>( 4u );
+  check_enumeration<3u>( 14u );
+  check_enumeration<4u>( 222u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,195 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE priority_cuts
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/compact_aig.hpp>
+#include <classical/functions/cuts/compact.hpp>
+#include <classical/functions/cuts/paged.hpp>
+#include <classical/functions/cuts/priority.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+priority_cut make_cut( const std::vector<unsigned>& leaves )
+{
+  priority_cut cut;
+  for ( auto leaf : leaves )
+  {
+    cut.leaves[cut.size++] = leaf;
+    cut.signature |= priority_cut::leaf_signature( leaf );
+  }
+  return cut;
+}
+
+aig_graph random_aig( unsigned num_inputs, unsigned num_gates, std::mt19937& gen )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> fs;
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+
+  for ( auto k = 0u; k < num_gates; ++k )
+  {
+    auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+    if ( gen() & 1u ) { a = !a; }
+    if ( gen() & 1u ) { b = !b; }
+    fs.push_back( aig_create_and( aig, a, b ) );
+  }
+
+  /* paged_aig_cuts requires all nodes to be in the cone of an output */
+  for ( auto k = num_inputs; k < fs.size(); ++k )
+  {
+    aig_create_po( aig, fs[k], "y" + std::to_string( k ) );
+  }
+
+  return aig;
+}
+
+/* every path from n to an input passes through a leaf */
+bool is_cut( const aig_graph& aig, aig_node n, const std::vector<unsigned>& leaves )
+{
+  if ( std::find( leaves.begin(), leaves.end(), n ) != leaves.end() || n == 0u ) { return true; }
+  if ( out_degree( n, aig ) == 0u ) { return false; }
+  for ( const auto& child : boost::make_iterator_range( adjacent_vertices( n, aig ) ) )
+  {
+    if ( !is_cut( aig, child, leaves ) ) { return false; }
+  }
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(merge_and_dominance)
+{
+  priority_cut cut;
+  BOOST_CHECK( cut.merge( make_cut( {1u, 3u, 5u} ), make_cut( {2u, 3u} ), 4u ) );
+  BOOST_CHECK( cut.to_vector() == std::vector<unsigned>( {1u, 2u, 3u, 5u} ) );
+  BOOST_CHECK_EQUAL( cut.signature, make_cut( {1u, 2u, 3u, 5u} ).signature );
+
+  /* too many leaves, also when the signatures collide */
+  BOOST_CHECK( !cut.merge( make_cut( {1u, 3u, 5u} ), make_cut( {2u, 4u} ), 4u ) );
+  BOOST_CHECK( !cut.merge( make_cut( {1u, 65u, 129u} ), make_cut( {193u, 257u} ), 4u ) );
+
+  /* 16 leaves each, signatures collide, union does not fit */
+  std::vector<unsigned> l1, l2;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    l1.push_back( 64u * i );
+    l2.push_back( 64u * i + 1024u );
+  }
+  BOOST_CHECK( !cut.merge( make_cut( l1 ), make_cut( l2 ), 16u ) );
+
+  BOOST_CHECK( make_cut( {1u, 3u} ).dominates( make_cut( {1u, 2u, 3u} ) ) );
+  BOOST_CHECK( !make_cut( {1u, 4u} ).dominates( make_cut( {1u, 2u, 3u} ) ) );
+}
+
+BOOST_AUTO_TEST_CASE(bounded_set)
+{
+  priority_cut_set set( 2u, cut_cost_t::depth );
+
+  auto c1 = make_cut( {1u, 2u, 3u} ); c1.depth = 3u;
+  auto c2 = make_cut( {4u, 5u} );     c2.depth = 2u;
+  auto c3 = make_cut( {1u, 2u} );     c3.depth = 4u;
+  auto c4 = make_cut( {6u, 7u} );     c4.depth = 1u;
+
+  BOOST_CHECK( set.insert( c1 ) );
+  BOOST_CHECK( set.insert( c2 ) );
+  BOOST_CHECK_EQUAL( set.best().depth, 2u );
+
+  /* dominates c1 but is too expensive */
+  BOOST_CHECK( !set.insert( c3 ) );
+
+  /* better than both, drops c1 */
+  BOOST_CHECK( set.insert( c4 ) );
+  BOOST_CHECK_EQUAL( set.size(), 2u );
+  BOOST_CHECK_EQUAL( set.best().depth, 1u );
+  BOOST_CHECK( !set.insert( c2 ) );
+}
+
+BOOST_AUTO_TEST_CASE(enumerators)
+{
+  std::mt19937 gen( 3u );
+  const auto aig = random_aig( 10u, 300u, gen );
+  const auto caig = aig_to_compact_aig( aig );
+
+  for ( auto cost : {cut_cost_t::depth, cut_cost_t::area_flow, cut_cost_t::cone_size} )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "priority_cuts", true );
+    settings->set( "cut_cost", cost );
+
+    for ( auto parallel : {false, true} )
+    {
+      paged_aig_cuts cuts( aig, 6u, parallel, 5u, settings );
+      for ( const auto& n : boost::make_iterator_range( vertices( aig ) ) )
+      {
+        if ( out_degree( n, aig ) == 0u ) { continue; }
+        BOOST_CHECK( cuts.count( n ) <= 6u );
+        for ( const auto& cut : cuts.cuts( n ) )
+        {
+          const std::vector<unsigned> leaves( cut.range().begin(), cut.range().end() );
+          BOOST_CHECK( leaves.size() <= 6u );
+          BOOST_CHECK( is_cut( aig, n, leaves ) );
+        }
+      }
+    }
+
+    /* the compact enumerator uses the same bounded cut sets */
+    compact_aig_cuts ccuts( caig, 6u, 5u, cost );
+    for ( auto n = 1u; n < caig.size(); ++n )
+    {
+      BOOST_CHECK( ccuts.count( n ) <= 6u );
+    }
+  }
+
+  /* priority cuts are limited to 16 leaves */
+  BOOST_CHECK_THROW( compact_aig_cuts( caig, priority_cut::max_leaves + 1u ), std::invalid_argument );
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "priority_cuts", true );
+  paged_aig_cuts cuts( aig, priority_cut::max_leaves + 1u, false, 5u, settings );
+  BOOST_CHECK( cuts.total_cut_count() > 0u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,140 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE snapshot
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/utils/binary_io.hpp>
+#include <classical/io/snapshot.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(aig_roundtrip)
+{
+  aig_graph aig;
+  aig_initialize( aig, "top" );
+
+  std::vector<aig_function> fs;
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    fs.push_back( aig_create_and( aig, fs[( 3u * i ) % fs.size()], !fs[( 7u * i + 1u ) % fs.size()] ) );
+  }
+  aig_create_po( aig, fs.back(), "f" );
+
+  std::stringstream ss;
+  binary_writer writer( ss );
+  write_snapshot( writer, aig );
+
+  const auto data = ss.str();
+  std::vector<std::uint64_t> buffer( data.size() / sizeof( std::uint64_t ) + 1u );
+  std::copy( data.begin(), data.end(), reinterpret_cast<char*>( buffer.data() ) );
+
+  aig_graph aig2;
+  binary_reader reader( reinterpret_cast<const char*>( buffer.data() ), data.size() );
+  read_snapshot( reader, aig2 );
+
+  BOOST_CHECK( reader.at_end() );
+  BOOST_CHECK_EQUAL( num_vertices( aig2 ), num_vertices( aig ) );
+  BOOST_CHECK_EQUAL( num_edges( aig2 ), num_edges( aig ) );
+  BOOST_CHECK( aig_info( aig2 ).inputs == aig_info( aig ).inputs );
+  BOOST_CHECK_EQUAL( aig_info( aig2 ).model_name, "top" );
+
+  /* structural hashing works on the restored graph */
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    const auto f = aig_create_and( aig2, fs[( 3u * i ) % ( i + 4u )], !fs[( 7u * i + 1u ) % ( i + 4u )] );
+    BOOST_CHECK( f == fs[4u + i] );
+  }
+  BOOST_CHECK_EQUAL( num_vertices( aig2 ), num_vertices( aig ) );
+
+  /* truncated input throws */
+  binary_reader truncated( reinterpret_cast<const char*>( buffer.data() ), data.size() / 2u );
+  aig_graph aig3;
+  BOOST_CHECK_THROW( read_snapshot( truncated, aig3 ), std::runtime_error );
+}
+
+std::string snapshot_of( const aig_graph& aig )
+{
+  std::stringstream ss;
+  binary_writer writer( ss );
+  write_snapshot( writer, aig );
+  return ss.str();
+}
+
+void read_snapshot_from( const std::string& data )
+{
+  std::vector<std::uint64_t> buffer( data.size() / sizeof( std::uint64_t ) + 1u );
+  std::copy( data.begin(), data.end(), reinterpret_cast<char*>( buffer.data() ) );
+
+  aig_graph aig;
+  binary_reader reader( reinterpret_cast<const char*>( buffer.data() ), data.size() );
+  read_snapshot( reader, aig );
+}
+
+BOOST_AUTO_TEST_CASE(invalid_snapshots)
+{
+  aig_graph aig;
+  aig_initialize( aig );
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  aig_create_po( aig, aig_create_and( aig, a, b ), "f" );
+
+  const auto data = snapshot_of( aig );
+  BOOST_CHECK_NO_THROW( read_snapshot_from( data ) );
+
+  /* unknown version */
+  auto other_version = data;
+  other_version[0] ^= 0x40;
+  BOOST_CHECK_THROW( read_snapshot_from( other_version ), std::runtime_error );
+
+  /* structural hash table refers to non-existing nodes in its value and in its key */
+  auto aig2 = aig;
+  aig_info( aig2 ).strash.insert( {{a.node << 1u, ( b.node << 1u ) | 1u}}, 1000u );
+  BOOST_CHECK_THROW( read_snapshot_from( snapshot_of( aig2 ) ), std::runtime_error );
+
+  auto aig3 = aig;
+  aig_info( aig3 ).strash.insert( {{a.node << 1u, 1000u << 1u}}, 3u );
+  BOOST_CHECK_THROW( read_snapshot_from( snapshot_of( aig3 ) ), std::runtime_error );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
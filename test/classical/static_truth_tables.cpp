@@ -0,0 +1,159 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE static_truth_tables
+
+#include <cstdint>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/functions/npn_canonization.hpp>
+#include <classical/utils/static_truth_table.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+using namespace cirkit;
+
+template<unsigned NumVars>
+static_tt<NumVars> random_static_tt( std::mt19937_64& gen )
+{
+  static_tt<NumVars> t;
+  for ( auto& w : t.words() ) { w = gen(); }
+  t.words()[0u] &= static_tt<NumVars>::word_mask;
+  return t;
+}
+
+template<unsigned NumVars>
+void check_against_tt( std::mt19937_64& gen )
+{
+  for ( auto r = 0u; r < 100u; ++r )
+  {
+    const auto s = random_static_tt<NumVars>( gen );
+    const auto t = from_static_tt( s );
+
+    BOOST_CHECK( to_static_tt<NumVars>( t ) == s );
+    BOOST_CHECK( from_static_tt( ~s ) == ~t );
+    BOOST_CHECK_EQUAL( s.count(), t.count() );
+
+    for ( auto i = 0u; i < NumVars; ++i )
+    {
+      auto c0 = tt_cof0( t, i ); tt_shrink( c0, NumVars );
+      auto c1 = tt_cof1( t, i ); tt_shrink( c1, NumVars );
+
+      BOOST_CHECK( from_static_tt( tt_cof0( s, i ) ) == c0 );
+      BOOST_CHECK( from_static_tt( tt_cof1( s, i ) ) == c1 );
+      BOOST_CHECK( from_static_tt( tt_flip( s, i ) ) == tt_flip( t, i ) );
+      BOOST_CHECK_EQUAL( tt_has_var( s, i ), tt_has_var( t, i ) );
+
+      for ( auto j = 0u; j < NumVars; ++j )
+      {
+        auto p = tt_permute( t, i, j ); tt_shrink( p, NumVars );
+        BOOST_CHECK( from_static_tt( tt_permute( s, i, j ) ) == p );
+      }
+    }
+
+    const auto s2 = random_static_tt<NumVars>( gen );
+    BOOST_CHECK_EQUAL( s < s2, t < from_static_tt( s2 ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(kernels)
+{
+  std::mt19937_64 gen( 42u );
+
+  check_against_tt<2u>( gen );
+  check_against_tt<4u>( gen );
+  check_against_tt<6u>( gen );
+  check_against_tt<7u>( gen );
+  check_against_tt<8u>( gen );
+
+  /* smaller truth tables are extended */
+  auto t = tt_from_hex( "6" );
+  tt_extend( t, 8u );
+  BOOST_CHECK( from_static_tt( to_static_tt<8u>( tt_from_hex( "6" ) ) ) == t );
+}
+
+BOOST_AUTO_TEST_CASE(npn)
+{
+  std::mt19937_64 gen( 42u );
+
+  for ( auto r = 0u; r < 100u; ++r )
+  {
+    const auto s = random_static_tt<4u>( gen );
+
+    boost::dynamic_bitset<> phase;
+    std::vector<unsigned> perm;
+    const auto npn = exact_npn_canonization( s, phase, perm );
+
+    /* all functions in the class have the same representative */
+    for ( auto i = 0u; i < 4u; ++i )
+    {
+      BOOST_CHECK( exact_npn_canonization( tt_flip( s, i ), phase, perm ) == npn );
+      BOOST_CHECK( exact_npn_canonization( tt_permute( s, i, 3u - i ), phase, perm ) == npn );
+    }
+    BOOST_CHECK( exact_npn_canonization( ~s, phase, perm ) == npn );
+    BOOST_CHECK( exact_npn_canonization( npn_canonization_flip_swap( s, phase, perm ), phase, perm ) == npn );
+  }
+}
+
+template<unsigned NumVars>
+void check_npn_against_tt( std::uint64_t f )
+{
+  static_tt<NumVars> s;
+  s.words()[0u] = f;
+  const auto t = from_static_tt( s );
+
+  boost::dynamic_bitset<> phase, phase_s;
+  std::vector<unsigned> perm, perm_s;
+
+  BOOST_CHECK( from_static_tt( exact_npn_canonization( s, phase_s, perm_s ) ) == exact_npn_canonization( t, phase, perm ) );
+  BOOST_CHECK( phase_s == phase );
+  BOOST_CHECK( perm_s == perm );
+
+  BOOST_CHECK( from_static_tt( npn_canonization_flip_swap( s, phase_s, perm_s ) ) == npn_canonization_flip_swap( t, phase, perm ) );
+  BOOST_CHECK( phase_s == phase );
+  BOOST_CHECK( perm_s == perm );
+}
+
+BOOST_AUTO_TEST_CASE(npn_static_and_dynamic)
+{
+  for ( auto f = 0u; f < 16u; ++f )  { check_npn_against_tt<2u>( f ); }
+  for ( auto f = 0u; f < 256u; ++f ) { check_npn_against_tt<3u>( f ); }
+
+  /* exact canonization of dynamic truth tables takes milliseconds, sample 4-variable functions */
+  std::mt19937_64 gen( 4u );
+  for ( auto r = 0u; r < 500u; ++r )
+  {
+    check_npn_against_tt<4u>( gen() & 0xffff );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
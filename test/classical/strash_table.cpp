@@ -0,0 +1,136 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE strash_table
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/utils/strash_table.hpp>
+#include <classical/xmg/xmg.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(lookup_and_growth)
+{
+  using table_t = strash_table<3u>;
+
+  table_t table;
+  const auto initial_capacity = table.capacity();
+  BOOST_CHECK_EQUAL( table.size(), 0u );
+
+  std::mt19937 gen( 42u );
+  std::uniform_int_distribution<std::uint64_t> dist( 0u, 1u << 20u );
+
+  std::map<table_t::key_t, table_t::value_t> reference;
+  while ( reference.size() < 10000u )
+  {
+    const table_t::key_t key = {{dist( gen ), dist( gen ), dist( gen )}};
+    if ( reference.find( key ) != reference.end() ) { continue; }
+
+    reference[key] = reference.size();
+    table.insert( key, reference[key] );
+  }
+
+  BOOST_CHECK_EQUAL( table.size(), reference.size() );
+  BOOST_CHECK( table.capacity() > initial_capacity );
+  BOOST_CHECK( table.capacity() >= 2u * table.size() );
+
+  for ( const auto& p : reference )
+  {
+    BOOST_CHECK_EQUAL( table.find( p.first ), p.second );
+  }
+
+  /* keys differing in a single literal (e.g., only in complement) are distinct */
+  const table_t::key_t missing = {{table_t::make_literal( 1u << 21u, false ), 0u, 0u}};
+  BOOST_CHECK_EQUAL( table.find( missing ), table_t::empty );
+
+  const auto some_key = reference.begin()->first;
+  table.insert_or_assign( some_key, 123456u );
+  BOOST_CHECK_EQUAL( table.find( some_key ), 123456u );
+  BOOST_CHECK_EQUAL( table.size(), reference.size() );
+
+  table.clear();
+  BOOST_CHECK_EQUAL( table.size(), 0u );
+  BOOST_CHECK_EQUAL( table.find( some_key ), table_t::empty );
+}
+
+BOOST_AUTO_TEST_CASE(reserve)
+{
+  strash_table<2u> table( 1000u );
+  const auto capacity = table.capacity();
+  BOOST_CHECK( capacity >= 2000u );
+
+  for ( auto i = 0u; i < 1000u; ++i )
+  {
+    table.insert( {{strash_table<2u>::make_literal( i, false ), strash_table<2u>::make_literal( i + 1u, true )}}, i );
+  }
+  BOOST_CHECK_EQUAL( table.capacity(), capacity );
+
+  for ( auto i = 0u; i < 1000u; ++i )
+  {
+    BOOST_CHECK_EQUAL( table.find( {{strash_table<2u>::make_literal( i, false ), strash_table<2u>::make_literal( i + 1u, true )}} ), i );
+    BOOST_CHECK_EQUAL( table.find( {{strash_table<2u>::make_literal( i, true ), strash_table<2u>::make_literal( i + 1u, true )}} ), strash_table<2u>::empty );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(xmg_toggle_hashing)
+{
+  xmg_graph xmg;
+  const auto a = xmg.create_pi( "a" );
+  const auto b = xmg.create_pi( "b" );
+  const auto c = xmg.create_pi( "c" );
+
+  const auto f = xmg.create_maj( a, b, c );
+  BOOST_CHECK( xmg.create_maj( c, b, a ) == f );
+  const auto g = xmg.create_xor( a, b );
+  BOOST_CHECK( xmg.create_xor( b, a ) == g );
+
+  /* nodes created without hashing are found once hashing is enabled again */
+  xmg.set_structural_hashing( false );
+  const auto f2 = xmg.create_maj( a, b, !c );
+  const auto g2 = xmg.create_xor( a, c );
+  BOOST_CHECK( xmg.create_maj( a, b, !c ) != f2 );
+  BOOST_CHECK( xmg.create_xor( a, c ) != g2 );
+
+  xmg.set_structural_hashing( true );
+  const auto gates = xmg.num_gates();
+  BOOST_CHECK( xmg.create_maj( a, b, c ) == f );
+  BOOST_CHECK( xmg.create_maj( a, b, !c ).node != f.node );
+  BOOST_CHECK( xmg.create_xor( a, c ).node != g.node );
+  BOOST_CHECK( xmg.create_xor( a, b ) == g );
+  BOOST_CHECK_EQUAL( xmg.num_gates(), gates );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,134 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE unate
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/verification/unate.hpp>
+
+using namespace cirkit;
+
+aig_graph random_aig( unsigned num_inputs, unsigned num_gates, unsigned num_outputs, std::mt19937& gen )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> fs;
+  for ( auto i = 0u; i < num_inputs; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+
+  for ( auto k = 0u; k < num_gates; ++k )
+  {
+    auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+    if ( gen() & 1u ) { a = !a; }
+    if ( gen() & 1u ) { b = !b; }
+    fs.push_back( aig_create_and( aig, a, b ) );
+  }
+
+  for ( auto o = 0u; o < num_outputs; ++o )
+  {
+    auto f = fs[fs.size() - 1u - gen() % ( fs.size() / 2u )];
+    aig_create_po( aig, ( gen() & 1u ) ? !f : f, "y" + std::to_string( o ) );
+  }
+
+  return aig;
+}
+
+/* outputs that are unate, binate, and independent in different inputs */
+aig_graph mixed_aig()
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  const auto c = aig_create_pi( aig, "c" );
+  const auto d = aig_create_pi( aig, "d" );
+
+  aig_create_po( aig, aig_create_and( aig, a, b ), "and" );
+  aig_create_po( aig, aig_create_xor( aig, a, c ), "xor" );
+  aig_create_po( aig, aig_create_or( aig, !a, d ), "or" );
+  aig_create_po( aig, aig_create_maj( aig, a, !b, c ), "maj" );
+  aig_create_po( aig, aig_create_ite( aig, d, b, !c ), "ite" );
+
+  return aig;
+}
+
+void check_concurrent( const aig_graph& aig )
+{
+  const auto expected = unateness( aig );
+
+  for ( auto num_threads : {1u, 4u} )
+  {
+    const auto settings = std::make_shared<properties>();
+    settings->set( "num_threads", num_threads );
+    BOOST_CHECK( unateness_concurrent( aig, settings ) == expected );
+
+    /* with fewer patterns, more pairs are decided by SAT */
+    settings->set( "sim_words", 1u );
+    settings->set( "seed", 7u );
+    BOOST_CHECK( unateness_concurrent( aig, settings ) == expected );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_mixed)
+{
+  const auto aig = mixed_aig();
+  check_concurrent( aig );
+
+  /* and(a, b) does not depend on c and d */
+  const auto result = unateness_concurrent( aig );
+  BOOST_CHECK( result[4u] && result[5u] );
+  BOOST_CHECK( result[6u] && result[7u] );
+  BOOST_CHECK( !( result[0u] && result[1u] ) );
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_random)
+{
+  std::mt19937 gen( 13u );
+
+  for ( auto round = 0u; round < 5u; ++round )
+  {
+    check_concurrent( random_aig( 6u + round, 30u + 10u * round, 4u, gen ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
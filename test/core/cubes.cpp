@@ -30,6 +30,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <core/cube.hpp>
+#include <core/packed_cover.hpp>
 
 using namespace cirkit;
 
@@ -64,6 +65,42 @@ BOOST_AUTO_TEST_CASE(simple)
   BOOST_CHECK( result2.empty() );
 }
 
+BOOST_AUTO_TEST_CASE(packed)
+{
+  packed_cover cover( 70u );
+
+  const std::string s1 = "10100100" + std::string( 60u, '-' ) + "01";
+  const std::string s2 = "-0100100" + std::string( 60u, '-' ) + "11";
+  const std::string s3 = "01011011" + std::string( 60u, '1' ) + "10";
+
+  const auto c1 = cover.add( s1 );
+  const auto c2 = cover.add( cube( s2 ) );
+  const auto c3 = cover.add( s3 );
+
+  BOOST_CHECK( cover.num_words() == 2u );
+  BOOST_CHECK( cover.size() == 3u );
+  BOOST_CHECK( cover.to_string( c1 ) == s1 );
+  BOOST_CHECK( cover.to_cube( c2 ).to_string() == s2 );
+  BOOST_CHECK( cover.num_literals( c1 ) == 10u );
+  BOOST_CHECK( cover.distance( c1, c2 ) == 2u );
+
+  unsigned pos[4u];
+  BOOST_CHECK( cover.positions( c1, c2, pos, 4u ) == 2u );
+  BOOST_CHECK( pos[0u] == 0u && pos[1u] == 68u );
+
+  BOOST_CHECK( cover.find( cover.bits( c3 ), cover.mask( c3 ) ) == c3 );
+
+  std::vector<packed_cover::cube_id> neighbors;
+  cover.foreach_neighbor( c1, 4u, [&neighbors]( packed_cover::cube_id id, unsigned ) { neighbors.push_back( id ); } );
+  std::sort( neighbors.begin(), neighbors.end() );
+  BOOST_CHECK( ( neighbors == std::vector<packed_cover::cube_id>{c1, c2} ) );
+
+  cover.remove( c2 );
+  BOOST_CHECK( !cover.is_valid( c2 ) );
+  BOOST_CHECK( cover.size() == 2u );
+  BOOST_CHECK( cover.add( s2 ) == c2 );
+}
+
 // Local Variables:
 // c-basic-offset: 2
 // eval: (c-set-offset 'substatement-open 0)
@@ -0,0 +1,85 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE level_scheduler
+
+#include <atomic>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/utils/level_scheduler.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  /* levels of sizes 1000, 1, 0, 3000, 17 */
+  const std::vector<unsigned> offsets = {0u, 1000u, 1001u, 1001u, 4001u, 4018u};
+
+  std::vector<unsigned> level_of( offsets.back() );
+  for ( auto l = 0u; l + 1u < offsets.size(); ++l )
+  {
+    for ( auto i = offsets[l]; i < offsets[l + 1u]; ++i )
+    {
+      level_of[i] = l;
+    }
+  }
+
+  for ( auto threads : {1u, 2u, 4u, 7u} )
+  {
+    std::vector<std::atomic<unsigned>> visited( offsets.back() );
+    for ( auto& v : visited ) { v = 0u; }
+    std::atomic<unsigned> current_level( 0u ), wrong_level( 0u );
+    std::vector<unsigned> level_calls;
+
+    level_scheduler scheduler( threads, 64u );
+    scheduler.run( offsets,
+                   [&]( unsigned i ) {
+                     if ( level_of[i] != current_level ) { ++wrong_level; }
+                     ++visited[i];
+                   },
+                   [&]( unsigned l ) {
+                     level_calls.push_back( l );
+                     current_level = l + 1u;
+                   } );
+
+    for ( const auto& v : visited )
+    {
+      BOOST_CHECK_EQUAL( v, 1u );
+    }
+    BOOST_CHECK_EQUAL( wrong_level, 0u );
+    BOOST_CHECK_EQUAL( level_calls.size(), offsets.size() - 1u );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
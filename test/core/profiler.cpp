@@ -0,0 +1,97 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE profiler
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/utils/profiler.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(counters_and_timers)
+{
+  auto& counter = get_profile_counter( "test.counter" );
+  auto& timer = get_profile_timer( "test.timer" );
+  BOOST_CHECK( &counter == &get_profile_counter( "test.counter" ) );
+
+  /* nothing is recorded while profiling is disabled */
+  set_profiling_enabled( false );
+  const auto before = take_profile_snapshot();
+  counter.add( 5u );
+  { profile_scope s( timer ); }
+  std::unique_ptr<int> p( new int( 1 ) );
+  auto diff = take_profile_snapshot() - before;
+  BOOST_CHECK_EQUAL( diff.counters["test.counter"], 0u );
+  BOOST_CHECK_EQUAL( diff.timers["test.timer"].calls, 0u );
+  BOOST_CHECK_EQUAL( diff.allocations, 0u );
+
+  set_profiling_enabled( true );
+  const auto start = take_profile_snapshot();
+
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < 4u; ++t )
+  {
+    threads.emplace_back( [&counter]() { for ( auto i = 0u; i < 1000u; ++i ) { ++counter; } } );
+  }
+  for ( auto& t : threads ) { t.join(); }
+
+  {
+    profile_scope s( "test.timer" );
+    std::vector<std::unique_ptr<int>> v;
+    for ( auto i = 0; i < 100; ++i )
+    {
+      v.emplace_back( new int( i ) );
+    }
+  }
+
+  diff = take_profile_snapshot() - start;
+  set_profiling_enabled( false );
+
+  BOOST_CHECK_EQUAL( diff.counters["test.counter"], 4000u );
+  BOOST_CHECK_EQUAL( diff.timers["test.timer"].calls, 1u );
+#ifdef CIRKIT_COUNT_ALLOCATIONS
+  BOOST_CHECK_GE( diff.allocations, 100u );
+  BOOST_CHECK_GE( diff.allocated_bytes, 100u * sizeof( int ) );
+#else
+  BOOST_CHECK_EQUAL( diff.allocations, 0u );
+#endif
+  BOOST_CHECK_GT( diff.peak_rss, 0u );
+
+  reset_profile();
+  BOOST_CHECK_EQUAL( take_profile_snapshot().counters["test.counter"], 0u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End: